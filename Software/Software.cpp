@@ -16,14 +16,18 @@
 #include "src/communication/precharge_control/precharge_control.h"
 #include "src/communication/rs485/comm_rs485.h"
 #include "src/datalayer/datalayer.h"
+#include "src/datalayer/datalayer_snapshot.h"
+#include "src/datalayer/telemetry_history.h"
 #include "src/devboard/display/display.h"
 #include "src/devboard/espnow/espnow.h"
 #include "src/devboard/mqtt/mqtt.h"
 #include "src/devboard/safety/parallel_safety.h"
 #include "src/devboard/sdcard/sdcard.h"
+#include "src/devboard/utils/event_journal.h"
 #include "src/devboard/utils/events.h"
 #include "src/devboard/utils/led_handler.h"
 #include "src/devboard/utils/logging.h"
+#include "src/devboard/utils/millis64.h"
 #include "src/devboard/utils/time_meas.h"
 #include "src/devboard/utils/timer.h"
 #include "src/devboard/utils/types.h"
@@ -111,7 +115,7 @@ void connectivity_loop(void*) {
 
     ota_monitor();
 
-    END_TIME_MEASUREMENT_MAX(wifi, datalayer.system.status.wifi_task_10s_max_us);
+    END_TIME_MEASUREMENT_MAX_HISTOGRAM(wifi, datalayer.system.status.wifi_task_10s_max_us, LATENCY_CONNECTIVITY_LOOP);
 
     mqtt_loop_watchdog.panic_if_exceeded_ms(60000, "MQTT task watchdog reset triggered!");
 
@@ -230,6 +234,15 @@ void update_calculated_values(unsigned long currentMillis) {
     }
   }
 
+  /* Cell min/max/average/balancing for the safety checks, webserver and MQTT, one pass over each battery*/
+  update_cell_statistics(datalayer.battery);
+  if (battery2) {
+    update_cell_statistics(datalayer.battery2);
+  }
+  if (battery3) {
+    update_cell_statistics(datalayer.battery3);
+  }
+
   /* Calculate sum of all currents from all batteries. 0 if they are not used*/
   datalayer.battery.status.reported_current_dA =
       (datalayer.battery.status.current_dA + datalayer.battery2.status.current_dA +
@@ -440,16 +453,24 @@ void core_loop(void*) {
   TickType_t xLastWakeTime = xTaskGetTickCount();
   const TickType_t xFrequency = pdMS_TO_TICKS(1);  // Convert 1ms to ticks
   int loopPhase = 0;
+  int64_t previous_loop_start_us = 0;
 
   while (true) {
     START_TIME_MEASUREMENT(all);
+    // How far vTaskDelayUntil let the loop period drift from 1 ms
+    if (previous_loop_start_us != 0) {
+      int64_t period_us = start_time_all - previous_loop_start_us;
+      latency_histogram_record(latency_histograms[LATENCY_CORE_PERIOD_JITTER],
+                               period_us > 1000 ? period_us - 1000 : 1000 - period_us);
+    }
+    previous_loop_start_us = start_time_all;
     START_TIME_MEASUREMENT(comm);
 
     // Input, Runs as fast as possible
     receive_can();    // Receive CAN messages
     receive_rs485();  // Process serial2 RS485 interface
 
-    END_TIME_MEASUREMENT_MAX(comm, datalayer.system.status.time_comm_us);
+    END_TIME_MEASUREMENT_MAX_HISTOGRAM(comm, datalayer.system.status.time_comm_us, LATENCY_CORE_COMM);
 
     // Process
     currentMillis = millis();
@@ -468,7 +489,7 @@ void core_loop(void*) {
         if (precharge_control_enabled) {
           handle_precharge_control(currentMillis);  //Drive the hia4v1 via PWM
         }
-        END_TIME_MEASUREMENT_MAX(10ms, datalayer.system.status.time_10ms_us);
+        END_TIME_MEASUREMENT_MAX_HISTOGRAM(10ms, datalayer.system.status.time_10ms_us, LATENCY_CORE_10MS);
       } else {  //Run 10ms tasks without timing it
         monitor_equipment_stop_button();
         led_exe();
@@ -507,26 +528,38 @@ void core_loop(void*) {
         inverter->update_values();
       }
 
+      // Hand the values of this update to the tasks on the other core in one piece
+      publish_datalayer_snapshot(currentMillis);
+      telemetry_history.record(datalayer.battery, millis64() / 1000);
+
       if (datalayer.system.info.performance_measurement_active) {
-        END_TIME_MEASUREMENT_MAX(values, datalayer.system.status.time_values_us);
+        END_TIME_MEASUREMENT_MAX_HISTOGRAM(values, datalayer.system.status.time_values_us, LATENCY_CORE_VALUES);
       }
     }
     if (datalayer.system.info.performance_measurement_active) {
       START_TIME_MEASUREMENT(cantx);
 
       for (auto& transmitter : transmitters) {
-        transmitter->transmit(currentMillis);
+        if (!transmitter->scheduled()) {
+          transmitter->transmit(currentMillis);
+        }
       }
+      tx_scheduler.run(currentMillis);
+      drain_can_tx_queues();
 
-      END_TIME_MEASUREMENT_MAX(cantx, datalayer.system.status.time_cantx_us);
+      END_TIME_MEASUREMENT_MAX_HISTOGRAM(cantx, datalayer.system.status.time_cantx_us, LATENCY_CORE_CANTX);
     } else {
       for (auto& transmitter : transmitters) {
-        transmitter->transmit(currentMillis);
+        if (!transmitter->scheduled()) {
+          transmitter->transmit(currentMillis);
+        }
       }
+      tx_scheduler.run(currentMillis);
+      drain_can_tx_queues();
     }
 
     if (datalayer.system.info.performance_measurement_active) {
-      END_TIME_MEASUREMENT_MAX(all, datalayer.system.status.core_task_10s_max_us);
+      END_TIME_MEASUREMENT_MAX_HISTOGRAM(all, datalayer.system.status.core_task_10s_max_us, LATENCY_CORE_TOTAL);
       if (datalayer.system.status.core_task_10s_max_us > datalayer.system.status.core_task_max_us) {
         // Update worst case total time
         datalayer.system.status.core_task_max_us = datalayer.system.status.core_task_10s_max_us;
@@ -560,7 +593,7 @@ void mqtt_loop(void*) {
 
     START_TIME_MEASUREMENT(mqtt);
     mqtt_client_loop();
-    END_TIME_MEASUREMENT_MAX(mqtt, datalayer.system.status.mqtt_task_10s_max_us);
+    END_TIME_MEASUREMENT_MAX_HISTOGRAM(mqtt, datalayer.system.status.mqtt_task_10s_max_us, LATENCY_MQTT_LOOP);
     delay(100);
   }
 }
@@ -574,10 +607,14 @@ void setup() {
   // We print this after setting up serial, so that is also printed if configured to do so
   DEBUG_PRINTF("Battery emulator %s build " __DATE__ " " __TIME__ "\n", version_number);
 
+  init_event_journal();
+
   init_events();
 
   init_stored_settings();
 
+  init_telemetry_history();
+
   if (wifi_enabled) {
     xTaskCreatePinnedToCore((TaskFunction_t)&connectivity_loop, "connectivity_loop", 4096, NULL, TASK_CONNECTIVITY_PRIO,
                             &connectivity_loop_task, esp32hal->WIFICORE());
@@ -649,5 +686,10 @@ void setup() {
   DEBUG_PRINTF("Setup complete!\n");
 }
 
-// Loop empty, all functionality runs in tasks
-void loop() {}
+// Loop only moves event changes into the journal in flash, all other functionality runs in tasks. Doing the writes
+// here keeps set_event() from waiting on flash. A sector erase still stalls the core task while it runs, so the
+// journal only erases at boot and while the system is idle or the contactors are open.
+void loop() {
+  flush_event_journal();
+  delay(EVENT_JOURNAL_FLUSH_INTERVAL_MS);
+}
@@ -273,6 +273,89 @@ Battery* create_battery(BatteryType type) {
   }
 }
 
+// Allocates the extended values that the battery type reports, at boot and before any task uses them. The
+// remaining battery types never take memory for theirs.
+void allocate_datalayer_extended(DataLayerExtended& extended, BatteryType type, bool second_battery) {
+  switch (type) {
+    case BatteryType::BmwIX:
+      extended.bmwix.allocate();
+      break;
+    case BatteryType::BmwPhev:
+      extended.bmwphev.allocate();
+      extended.bmwix.allocate();
+      break;
+    case BatteryType::BoltAmpera:
+      extended.boltampera.allocate();
+      if (second_battery) {
+        extended.boltampera_2.allocate();
+      }
+      break;
+    case BatteryType::BydAtto3:
+      extended.bydAtto3.allocate();
+      if (second_battery) {
+        extended.bydAtto3_2.allocate();
+      }
+      break;
+    case BatteryType::CellPowerBms:
+      extended.cellpower.allocate();
+      break;
+    case BatteryType::Chademo:
+      extended.chademo.allocate();
+      break;
+    case BatteryType::CmfaEv:
+      extended.CMFAEV.allocate();
+      break;
+    case BatteryType::CmpSmartCar:
+      extended.stellantisCMPsmart.allocate();
+      break;
+    case BatteryType::StellantisEcmp:
+      extended.stellantisECMP.allocate();
+      break;
+    case BatteryType::FordMachE:
+      extended.fordMachE.allocate();
+      break;
+    case BatteryType::GeelyGeometryC:
+      extended.geometryC.allocate();
+      break;
+    case BatteryType::GeelySea:
+      extended.GeelySEA.allocate();
+      break;
+    case BatteryType::KiaHyundai64:
+      extended.KiaHyundai64.allocate();
+      if (second_battery) {
+        extended.KiaHyundai64_2.allocate();
+      }
+      break;
+    case BatteryType::Meb:
+      extended.meb.allocate();
+      break;
+    case BatteryType::NissanLeaf:
+      extended.nissanleaf.allocate();
+      break;
+    case BatteryType::RenaultZoe1:
+      extended.zoe.allocate();
+      break;
+    case BatteryType::RenaultZoe2:
+      extended.zoePH2.allocate();
+      break;
+    case BatteryType::RivianBattery:
+      extended.rivian.allocate();
+      break;
+    case BatteryType::TeslaModel3Y:
+    case BatteryType::TeslaModelSX:
+      extended.tesla.allocate();
+      break;
+    case BatteryType::VolvoSpa:
+      extended.VolvoPolestar.allocate();
+      break;
+    case BatteryType::VolvoSpaHybrid:
+      extended.VolvoHybrid.allocate();
+      break;
+    default:
+      break;
+  }
+}
+
 void setup_battery() {
   if (battery) {
     // Let's not create the battery again.
@@ -284,6 +367,8 @@ void setup_battery() {
   datalayer.battery2.info.chemistry = user_selected_battery_chemistry;
   datalayer.battery3.info.chemistry = user_selected_battery_chemistry;
 
+  allocate_datalayer_extended(datalayer_extended, user_selected_battery_type, user_selected_second_battery);
+  DEBUG_PRINTF("Extended battery values use %u bytes\n", (unsigned)datalayer_extended_allocated_bytes.load());
   battery = create_battery(user_selected_battery_type);
 
   if (battery) {
@@ -293,11 +378,12 @@ void setup_battery() {
   if (user_selected_second_battery && !battery2) {
     switch (user_selected_battery_type) {
       case BatteryType::BoltAmpera:
-        battery2 =
-            new BoltAmperaBattery(&datalayer.battery2, &datalayer_extended.boltampera_2, can_config.battery_double);
+        battery2 = new BoltAmperaBattery(&datalayer.battery2, datalayer_extended.boltampera_2.get(),
+                                         can_config.battery_double);
         break;
       case BatteryType::BydAtto3:
-        battery2 = new BydAttoBattery(&datalayer.battery2, &datalayer_extended.bydAtto3_2, can_config.battery_double);
+        battery2 =
+            new BydAttoBattery(&datalayer.battery2, datalayer_extended.bydAtto3_2.get(), can_config.battery_double);
         break;
       case BatteryType::NissanLeaf:
         battery2 = new NissanLeafBattery(&datalayer.battery2, nullptr, can_config.battery_double);
@@ -310,13 +396,14 @@ void setup_battery() {
         battery2 = new CmfaEvBattery(&datalayer.battery2, nullptr, can_config.battery_double);
         break;
       case BatteryType::CmpSmartCar:
-        battery2 = new CmpSmartCarBattery(&datalayer.battery2, nullptr, can_config.battery_double);
+        battery2 = new CmpSmartCarBattery(&datalayer.battery2, datalayer_extended.stellantisCMPsmart.get(),
+                                          can_config.battery_double);
         break;
       case BatteryType::StellantisEcmp:
         battery2 = new EcmpBattery(&datalayer.battery2, can_config.battery_double);
         break;
       case BatteryType::KiaHyundai64:
-        battery2 = new KiaHyundai64Battery(&datalayer.battery2, &datalayer_extended.KiaHyundai64_2,
+        battery2 = new KiaHyundai64Battery(&datalayer.battery2, datalayer_extended.KiaHyundai64_2.get(),
                                            &datalayer.system.status.battery2_allowed_contactor_closing,
                                            can_config.battery_double);
         break;
@@ -337,7 +424,8 @@ void setup_battery() {
         battery2 = new RenaultZoeGen1Battery(&datalayer.battery2, nullptr, can_config.battery_double);
         break;
       case BatteryType::RenaultZoe2:
-        battery2 = new RenaultZoeGen2Battery(&datalayer.battery2, nullptr, can_config.battery_double);
+        battery2 =
+            new RenaultZoeGen2Battery(&datalayer.battery2, datalayer_extended.zoePH2.get(), can_config.battery_double);
         break;
       case BatteryType::TestFake:
         battery2 = new TestFakeBattery(&datalayer.battery2, can_config.battery_double);
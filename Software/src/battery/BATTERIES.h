@@ -3,6 +3,7 @@
 #include "Shunt.h"
 
 class Battery;
+class DataLayerExtended;
 
 // Currently initialized objects for primary/secondary/tertiary battery.
 // Null value indicates that battery is not configured/initialized
@@ -68,6 +69,7 @@ void setup_shunt();
 
 void setup_battery(void);
 Battery* create_battery(BatteryType type);
+void allocate_datalayer_extended(DataLayerExtended& extended, BatteryType type, bool second_battery);
 
 extern uint16_t user_selected_max_pack_voltage_dV;
 extern uint16_t user_selected_min_pack_voltage_dV;
@@ -8,7 +8,7 @@
 
 /* Do not change code below unless you are sure what you are doing */
 
-static uint8_t calculateCRC(CAN_frame rx_frame, uint8_t length, uint8_t initial_value) {
+static uint8_t calculateCRC(const CAN_frame& rx_frame, uint8_t length, uint8_t initial_value) {
   uint8_t crc = initial_value;
   for (uint8_t j = 1; j < length; j++) {  //start at 1, since 0 is the CRC
     crc = crc8_table_SAE_J1850_ZER0[(crc ^ static_cast<uint8_t>(rx_frame.data.u8[j])) % 256];
@@ -120,7 +120,7 @@ void BmwI3Battery::update_values() {  //This function maps all the values fetche
   }
 }
 
-void BmwI3Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void BmwI3Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x112:  //BMS [10ms] Status Of High-Voltage Battery - 2
       // Set to true unless balancing is going on and battery is supposed to go to sleep
@@ -168,15 +168,15 @@ void BmwIXBattery::parseDTCResponse() {
     logging.print("DTC request rejected by battery. Reason code: 0x");
     logging.print(gUDSContext.UDS_buffer[2], HEX);
     logging.println();
-    datalayer_extended.bmwix.dtc_read_failed = true;
-    datalayer_extended.bmwix.dtc_read_in_progress = false;
+    datalayer_bmwix->dtc_read_failed = true;
+    datalayer_bmwix->dtc_read_in_progress = false;
     return;
   }
 
   if (gUDSContext.UDS_buffer[0] != 0x59 || gUDSContext.UDS_buffer[1] != 0x02) {
     logging.println("Invalid DTC response header");
-    datalayer_extended.bmwix.dtc_read_failed = true;
-    datalayer_extended.bmwix.dtc_read_in_progress = false;
+    datalayer_bmwix->dtc_read_failed = true;
+    datalayer_bmwix->dtc_read_in_progress = false;
     return;
   }
 
@@ -219,8 +219,8 @@ void BmwIXBattery::parseDTCResponse() {
     }
 
     // Store valid DTC
-    datalayer_extended.bmwix.dtc_codes[validDtcCount] = dtcCode;
-    datalayer_extended.bmwix.dtc_status[validDtcCount] = dtcStatus;
+    datalayer_bmwix->dtc_codes[validDtcCount] = dtcCode;
+    datalayer_bmwix->dtc_status[validDtcCount] = dtcStatus;
 
     // Log each DTC for debugging
     logging.print("  DTC #");
@@ -246,17 +246,17 @@ void BmwIXBattery::parseDTCResponse() {
     validDtcCount++;  // Increment only for valid DTCs
   }
 
-  datalayer_extended.bmwix.dtc_count = validDtcCount;  // Store actual count
+  datalayer_bmwix->dtc_count = validDtcCount;  // Store actual count
 
   logging.print("Total valid DTCs: ");
   logging.println(validDtcCount);
 
-  datalayer_extended.bmwix.dtc_last_read_millis = millis();
-  datalayer_extended.bmwix.dtc_read_failed = false;
-  datalayer_extended.bmwix.dtc_read_in_progress = false;
+  datalayer_bmwix->dtc_last_read_millis = millis();
+  datalayer_bmwix->dtc_read_failed = false;
+  datalayer_bmwix->dtc_read_in_progress = false;
 }
 
-void BmwIXBattery::handleISOTPFrame(CAN_frame& rx_frame) {
+void BmwIXBattery::handleISOTPFrame(const CAN_frame& rx_frame) {
   uint8_t pciByte = rx_frame.data.u8[1];  // e.g., 0x10, 0x21, etc.
   uint8_t pciType = pciByte >> 4;         // top nibble => 0=SF,1=FF,2=CF,3=FC
 
@@ -580,7 +580,7 @@ void BmwIXBattery::update_values() {  //This function maps all the values fetche
   }
 }
 
-void BmwIXBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void BmwIXBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   battery_awake = true;
   switch (rx_frame.ID) {
     case 0x12B8D087:
@@ -930,8 +930,8 @@ void BmwIXBattery::transmit_can(unsigned long currentMillis) {
     UserRequestDTCRead = false;
 
     // Set flags in datalayer for HTML renderer
-    datalayer_extended.bmwix.dtc_read_in_progress = true;
-    datalayer_extended.bmwix.dtc_read_failed = false;
+    datalayer_bmwix->dtc_read_in_progress = true;
+    datalayer_bmwix->dtc_read_failed = false;
   }
 
   // Handle user DTC reset request
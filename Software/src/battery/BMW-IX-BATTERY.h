@@ -18,10 +18,10 @@ struct UDS_CONTEXT {
 
 class BmwIXBattery : public CanBattery {
  public:
-  BmwIXBattery() : renderer(*this) {}
+  BmwIXBattery() : renderer(*this, datalayer_extended.bmwix.get()) { datalayer_bmwix = datalayer_extended.bmwix.get(); }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
@@ -67,6 +67,7 @@ class BmwIXBattery : public CanBattery {
   bool UserRequestEnergySavingModeReset = false;
   bool startup_reset_complete = false;  // Track if startup BMS reset is done
   BmwIXHtmlRenderer renderer;
+  DATALAYER_INFO_BMWIX* datalayer_bmwix;
   static const int MAX_PACK_VOLTAGE_78S_DV = 3354;   // 4.3V per cell | SE12 battery, BMW iX1, 66.45kWh 286.3Vnom
   static const int MIN_PACK_VOLTAGE_78S_DV = 2184;   // 2.8V per cell
   static const int MAX_PACK_VOLTAGE_90S_DV = 3870;   // 4.3V per cell | SE11 | SE 50
@@ -668,7 +669,7 @@ CAN_frame BMWiX_49C = {.FD = true,
   bool storeUDSPayload(const uint8_t* payload, uint8_t length);
   bool isUDSMessageComplete();
   void parseDTCResponse();
-  void handleISOTPFrame(CAN_frame& rx_frame);
+  void handleISOTPFrame(const CAN_frame& rx_frame);
   void processCompletedUDSResponse();
   CAN_frame generate_433_datetime_message();
   CAN_frame generate_442_time_counter_message();
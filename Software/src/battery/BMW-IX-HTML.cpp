@@ -3,7 +3,23 @@
 
 String BmwIXHtmlRenderer::get_status_html() {
   String content;
+  render_power_and_cells(content);
+  render_battery_status(content);
+  render_safety_systems(content);
+  render_isolation_and_diagnostics(content);
+  render_dtcs(content);
+  return content;
+}
 
+void BmwIXHtmlRenderer::status_sections(HtmlChunkedPage& page) {
+  page.section([this](String& content) { render_power_and_cells(content); });
+  page.section([this](String& content) { render_battery_status(content); });
+  page.section([this](String& content) { render_safety_systems(content); });
+  page.section([this](String& content) { render_isolation_and_diagnostics(content); });
+  page.section([this](String& content) { render_dtcs(content); });
+}
+
+void BmwIXHtmlRenderer::render_power_and_cells(String& content) {
   // Power & Voltage Section
   content +=
       "<h3 style='color: #1e88e5; border-bottom: 2px solid #1e88e5; padding-bottom: 5px;'>⚡ Power & Voltage</h3>";
@@ -29,7 +45,9 @@ String BmwIXHtmlRenderer::get_status_html() {
   content += "<h4>Min Cell Voltage Data Age: " + String(batt.get_min_cell_voltage_data_age()) + " ms</h4>";
   content += "<h4>Max Cell Voltage Data Age: " + String(batt.get_max_cell_voltage_data_age()) + " ms</h4>";
   content += "</div>";
+}
 
+void BmwIXHtmlRenderer::render_battery_status(String& content) {
   // Battery Status Section
   content += "<h3 style='color: #35b1ab; border-bottom: 2px solid #35b1ab; padding-bottom: 5px;'>⚖️ Battery Status</h3>";
   content += "<div style='margin-left: 15px;'>";
@@ -82,7 +100,9 @@ String BmwIXHtmlRenderer::get_status_html() {
       break;
   }
   content += "</div>";
+}
 
+void BmwIXHtmlRenderer::render_safety_systems(String& content) {
   // Safety Systems Section
   content += "<h3 style='color: #e53935; border-bottom: 2px solid #e53935; padding-bottom: 5px;'>🛡️ Safety Systems</h3>";
   content += "<div style='margin-left: 15px;'>";
@@ -158,7 +178,9 @@ String BmwIXHtmlRenderer::get_status_html() {
       content += "Unknown</h4>";
   }
   content += "</div>";
+}
 
+void BmwIXHtmlRenderer::render_isolation_and_diagnostics(String& content) {
   // Isolation Monitoring Section
   content +=
       "<h3 style='color: #fb8c00; border-bottom: 2px solid #fb8c00; padding-bottom: 5px;'>🔋 Isolation "
@@ -186,26 +208,28 @@ String BmwIXHtmlRenderer::get_status_html() {
   content += "<h4>BMS Uptime: " + String(days) + "d " + String(hours) + "h " + String(minutes) + "m " +
              String(seconds) + "s</h4>";
   content += "</div>";
+}
 
+void BmwIXHtmlRenderer::render_dtcs(String& content) {
   // Diagnostic Trouble Codes Section
   content +=
       "<h3 style='color: #27b06c; border-bottom: 2px solid #27b06c; padding-bottom: 5px;'>🔧 Diagnostic Trouble "
       "Codes</h3>";
   content += "<div style='margin-left: 15px; margin-right: 15px;'>";
 
-  if (datalayer_extended.bmwix.dtc_last_read_millis == 0) {
+  if (bmwix_dl->dtc_last_read_millis == 0) {
     // No DTC read has been performed yet
     content +=
         "<p style='color: #ff9800;'>ℹ DTCs have not been read yet. Click 'Read DTC' to scan for fault codes.</p>";
-  } else if (datalayer_extended.bmwix.dtc_read_failed) {
+  } else if (bmwix_dl->dtc_read_failed) {
     content += "<p style='color: #d32f2f;'>⚠ Last DTC read failed or not supported</p>";
-  } else if (datalayer_extended.bmwix.dtc_count == 0) {
+  } else if (bmwix_dl->dtc_count == 0) {
     content += "<p style='color: #4CAF50;'>✓ No DTCs present</p>";
   } else {
-    content += "<p><strong>DTC Count:</strong> " + String(datalayer_extended.bmwix.dtc_count) + "</p>";
+    content += "<p><strong>DTC Count:</strong> " + String(bmwix_dl->dtc_count) + "</p>";
 
     // Convert last read time to days:hours:minutes:seconds format
-    unsigned long last_read_seconds = (millis() - datalayer_extended.bmwix.dtc_last_read_millis) / 1000;
+    unsigned long last_read_seconds = (millis() - bmwix_dl->dtc_last_read_millis) / 1000;
     unsigned long read_days = last_read_seconds / 86400;
     unsigned long read_hours = (last_read_seconds % 86400) / 3600;
     unsigned long read_minutes = (last_read_seconds % 3600) / 60;
@@ -235,9 +259,9 @@ String BmwIXHtmlRenderer::get_status_html() {
 
     content += "<tbody>";
 
-    for (int i = 0; i < datalayer_extended.bmwix.dtc_count; i++) {
-      uint32_t code = datalayer_extended.bmwix.dtc_codes[i];
-      uint8_t status = datalayer_extended.bmwix.dtc_status[i];
+    for (int i = 0; i < bmwix_dl->dtc_count; i++) {
+      uint32_t code = bmwix_dl->dtc_codes[i];
+      uint8_t status = bmwix_dl->dtc_status[i];
 
       char dtcStr[12];
       sprintf(dtcStr, "%06lX", code);
@@ -276,6 +300,4 @@ String BmwIXHtmlRenderer::get_status_html() {
   }
 
   content += "</div>";
-
-  return content;
 }
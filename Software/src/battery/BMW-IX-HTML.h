@@ -11,11 +11,22 @@ class BmwIXBattery;
 class BmwIXHtmlRenderer : public BatteryHtmlRenderer {
  private:
   BmwIXBattery& batt;
+  DATALAYER_INFO_BMWIX* bmwix_dl;
 
  public:
-  BmwIXHtmlRenderer(BmwIXBattery& b) : batt(b) {}
+  BmwIXHtmlRenderer(BmwIXBattery& b, DATALAYER_INFO_BMWIX* dl) : batt(b), bmwix_dl(dl) {}
 
   String get_status_html();
+
+  // Each block is a section of its own, so only one is held in memory at a time
+  void status_sections(HtmlChunkedPage& page);
+
+ private:
+  void render_power_and_cells(String& content);
+  void render_battery_status(String& content);
+  void render_safety_systems(String& content);
+  void render_isolation_and_diagnostics(String& content);
+  void render_dtcs(String& content);
 };
 
 #endif
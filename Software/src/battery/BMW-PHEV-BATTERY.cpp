@@ -200,7 +200,7 @@ bool BmwPhevBattery::isStale(int16_t currentValue, uint16_t& lastValue, unsigned
   return (currentTime - lastChangeTime >= STALE_PERIOD_CONFIG);
 }
 
-static uint8_t calculateCRC(CAN_frame rx_frame, uint8_t length, uint8_t initial_value) {
+static uint8_t calculateCRC(const CAN_frame& rx_frame, uint8_t length, uint8_t initial_value) {
   uint8_t crc = initial_value;
   for (uint8_t j = 1; j < length; j++) {  //start at 1, since 0 is the CRC
     crc = crc8_table_SAE_J1850_ZER0[(crc ^ static_cast<uint8_t>(rx_frame.data.u8[j])) % 256];
@@ -347,13 +347,13 @@ void BmwPhevBattery::parseDTCResponse() {
     logging.print("DTC request rejected by battery. Reason code: 0x");
     logging.print(gUDSContext.UDS_buffer[2], HEX);
     logging.println();
-    datalayer_extended.bmwphev.dtc_read_failed = true;
+    datalayer_bmwphev->dtc_read_failed = true;
     return;
   }
 
   if (gUDSContext.UDS_buffer[0] != 0x59 || gUDSContext.UDS_buffer[1] != 0x02) {
     logging.println("Invalid DTC response header");
-    datalayer_extended.bmwphev.dtc_read_failed = true;
+    datalayer_bmwphev->dtc_read_failed = true;
     return;
   }
 
@@ -395,8 +395,8 @@ void BmwPhevBattery::parseDTCResponse() {
     }
 
     // Store valid DTC
-    datalayer_extended.bmwix.dtc_codes[validDtcCount] = dtcCode;
-    datalayer_extended.bmwix.dtc_status[validDtcCount] = dtcStatus;
+    datalayer_bmwix->dtc_codes[validDtcCount] = dtcCode;
+    datalayer_bmwix->dtc_status[validDtcCount] = dtcStatus;
 
     // Log each DTC for debugging
     logging.print("  DTC #");
@@ -421,13 +421,13 @@ void BmwPhevBattery::parseDTCResponse() {
     validDtcCount++;  //  Increment only for valid DTCs
   }
 
-  datalayer_extended.bmwphev.dtc_count = validDtcCount;  //  Store actual count
+  datalayer_bmwphev->dtc_count = validDtcCount;  //  Store actual count
 
   logging.print("Total valid DTCs: ");
   logging.println(validDtcCount);
 
-  datalayer_extended.bmwix.dtc_last_read_millis = millis();  //Note we re-use ix struct to save memory
-  datalayer_extended.bmwphev.dtc_read_failed = false;
+  datalayer_bmwix->dtc_last_read_millis = millis();  //Note we re-use ix struct to save memory
+  datalayer_bmwphev->dtc_read_failed = false;
 }
 void BmwPhevBattery::processCellVoltages() {
   const int startByte = 3;     // Start reading at byte 3
@@ -530,17 +530,17 @@ void BmwPhevBattery::update_values() {  //This function maps all the values fetc
 
   datalayer.battery.info.min_design_voltage_dV = min_design_voltage;
 
-  datalayer_extended.bmwphev.min_cell_voltage_data_age = (millis() - min_cell_voltage_lastchanged);
+  datalayer_bmwphev->min_cell_voltage_data_age = (millis() - min_cell_voltage_lastchanged);
 
-  datalayer_extended.bmwphev.max_cell_voltage_data_age = (millis() - max_cell_voltage_lastchanged);
+  datalayer_bmwphev->max_cell_voltage_data_age = (millis() - max_cell_voltage_lastchanged);
 
   //datalayer_extended.bmwphev.hvil_status = hvil_status; //TODO, not implemented
 
-  datalayer_extended.bmwphev.allowable_charge_amps = allowable_charge_amps;
+  datalayer_bmwphev->allowable_charge_amps = allowable_charge_amps;
 
-  datalayer_extended.bmwphev.allowable_discharge_amps = allowable_discharge_amps;
+  datalayer_bmwphev->allowable_discharge_amps = allowable_discharge_amps;
 
-  datalayer_extended.bmwphev.balancing_status = balancing_status;
+  datalayer_bmwphev->balancing_status = balancing_status;
 
   // Map PHEV balancing_status raw value to the shared datalayer enum so MQTT picks it up.
   // PHEV values (from BMW-PHEV-HTML.h): 0=inactive not needed, 1=active, 2=not resting,
@@ -564,31 +564,31 @@ void BmwPhevBattery::update_values() {  //This function maps all the values fetc
       break;
   }
 
-  datalayer_extended.bmwphev.battery_voltage_after_contactor = battery_voltage_after_contactor;
+  datalayer_bmwphev->battery_voltage_after_contactor = battery_voltage_after_contactor;
 
   // Update webserver datalayer
 
-  datalayer_extended.bmwphev.ST_iso_ext = battery_status_error_isolation_external_Bordnetz;
-  datalayer_extended.bmwphev.ST_iso_int = battery_status_error_isolation_internal_Bordnetz;
-  datalayer_extended.bmwphev.ST_valve_cooling = battery_status_valve_cooling;
-  datalayer_extended.bmwphev.ST_interlock = battery_status_error_locking;
-  datalayer_extended.bmwphev.ST_precharge = battery_status_precharge_locked;
-  datalayer_extended.bmwphev.ST_DCSW = battery_status_disconnecting_switch;
-  datalayer_extended.bmwphev.ST_EMG = battery_status_emergency_mode;
-  datalayer_extended.bmwphev.ST_WELD = battery_status_error_disconnecting_switch;
-  datalayer_extended.bmwphev.ST_isolation = battery_status_warning_isolation;
-  datalayer_extended.bmwphev.ST_cold_shutoff_valve = battery_status_cold_shutoff_valve;
-  datalayer_extended.bmwphev.iso_safety_int_kohm = iso_safety_int_kohm;
-  datalayer_extended.bmwphev.iso_safety_ext_kohm = iso_safety_ext_kohm;
-  datalayer_extended.bmwphev.iso_safety_trg_kohm = iso_safety_trg_kohm;
-  datalayer_extended.bmwphev.iso_safety_ext_plausible = iso_safety_ext_plausible;
-  datalayer_extended.bmwphev.iso_safety_int_plausible = iso_safety_int_plausible;
-  datalayer_extended.bmwphev.iso_safety_kohm = iso_safety_kohm;
-  datalayer_extended.bmwphev.iso_safety_kohm_quality = iso_safety_kohm_quality;
-  datalayer_extended.bmwphev.battery_request_open_contactors = battery_request_open_contactors;
-  datalayer_extended.bmwphev.battery_request_open_contactors_instantly = battery_request_open_contactors_instantly;
-  datalayer_extended.bmwphev.battery_request_open_contactors_fast = battery_request_open_contactors_fast;
-  datalayer_extended.bmwphev.battery_charging_condition_delta = battery_charging_condition_delta;
+  datalayer_bmwphev->ST_iso_ext = battery_status_error_isolation_external_Bordnetz;
+  datalayer_bmwphev->ST_iso_int = battery_status_error_isolation_internal_Bordnetz;
+  datalayer_bmwphev->ST_valve_cooling = battery_status_valve_cooling;
+  datalayer_bmwphev->ST_interlock = battery_status_error_locking;
+  datalayer_bmwphev->ST_precharge = battery_status_precharge_locked;
+  datalayer_bmwphev->ST_DCSW = battery_status_disconnecting_switch;
+  datalayer_bmwphev->ST_EMG = battery_status_emergency_mode;
+  datalayer_bmwphev->ST_WELD = battery_status_error_disconnecting_switch;
+  datalayer_bmwphev->ST_isolation = battery_status_warning_isolation;
+  datalayer_bmwphev->ST_cold_shutoff_valve = battery_status_cold_shutoff_valve;
+  datalayer_bmwphev->iso_safety_int_kohm = iso_safety_int_kohm;
+  datalayer_bmwphev->iso_safety_ext_kohm = iso_safety_ext_kohm;
+  datalayer_bmwphev->iso_safety_trg_kohm = iso_safety_trg_kohm;
+  datalayer_bmwphev->iso_safety_ext_plausible = iso_safety_ext_plausible;
+  datalayer_bmwphev->iso_safety_int_plausible = iso_safety_int_plausible;
+  datalayer_bmwphev->iso_safety_kohm = iso_safety_kohm;
+  datalayer_bmwphev->iso_safety_kohm_quality = iso_safety_kohm_quality;
+  datalayer_bmwphev->battery_request_open_contactors = battery_request_open_contactors;
+  datalayer_bmwphev->battery_request_open_contactors_instantly = battery_request_open_contactors_instantly;
+  datalayer_bmwphev->battery_request_open_contactors_fast = battery_request_open_contactors_fast;
+  datalayer_bmwphev->battery_charging_condition_delta = battery_charging_condition_delta;
 
   if (pack_limit_info_available) {
     // If we have pack limit data from battery - override the defaults to suit
@@ -596,7 +596,7 @@ void BmwPhevBattery::update_values() {  //This function maps all the values fetc
     datalayer.battery.info.min_design_voltage_dV = min_design_voltage;
   }
 }
-void BmwPhevBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void BmwPhevBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
 
   //battery_awake = true; //look for specific messages
   switch (rx_frame.ID) {
@@ -981,22 +981,22 @@ void BmwPhevBattery::transmit_can(unsigned long currentMillis) {
   }
   if (battery_awake) {
     // Update requests from webserver datalayer
-    if (datalayer_extended.bmwphev.UserRequestDTCreset) {
+    if (datalayer_bmwphev->UserRequestDTCreset) {
       logging.println("User requested DTC reset");
       transmit_can_frame(&BMWPHEV_6F1_REQUEST_CLEAR_DTC);  // Send DTC erase command
-      datalayer_extended.bmwphev.UserRequestDTCreset = false;
+      datalayer_bmwphev->UserRequestDTCreset = false;
       uds_one_shot_sent_ms = currentMillis;  // Silence polls for UDS_ONE_SHOT_SILENCE_MS
     }
-    if (datalayer_extended.bmwphev.UserRequestBMSReset) {
+    if (datalayer_bmwphev->UserRequestBMSReset) {
       logging.println("User requested SME reset");
       transmit_can_frame(&BMW_6F1_REQUEST_HARD_RESET);  // Send SME reset command
-      datalayer_extended.bmwphev.UserRequestBMSReset = false;
+      datalayer_bmwphev->UserRequestBMSReset = false;
       uds_one_shot_sent_ms = currentMillis;  // Silence polls for UDS_ONE_SHOT_SILENCE_MS
     }
-    if (datalayer_extended.bmwphev.UserRequestIsolationTest) {
+    if (datalayer_bmwphev->UserRequestIsolationTest) {
       logging.println("User requested isolation test");
       transmit_can_frame(&BMWPHEV_6F1_REQUEST_ISOLATION_TEST);  // Start isolation test routine (0xAD61)
-      datalayer_extended.bmwphev.UserRequestIsolationTest = false;
+      datalayer_bmwphev->UserRequestIsolationTest = false;
       uds_one_shot_sent_ms = currentMillis;  // Silence polls for UDS_ONE_SHOT_SILENCE_MS
     }
 
@@ -1089,7 +1089,7 @@ void BmwPhevBattery::transmit_can(unsigned long currentMillis) {
       //}  //If battery is not in Fault mode, allow contactor to close by sending 10B
       //else {
 
-      transmit_can_frame(&BMW_10B);
+      transmit_can_frame(&BMW_10B, CAN_TX_SAFETY);
       //}
     }
 
@@ -5,18 +5,23 @@
 
 class BmwPhevBattery : public CanBattery {
  public:
+  BmwPhevBattery() : renderer(datalayer_extended.bmwphev.get(), datalayer_extended.bmwix.get()) {
+    datalayer_bmwphev = datalayer_extended.bmwphev.get();
+    datalayer_bmwix = datalayer_extended.bmwix.get();
+  }
+
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
   static constexpr const char* Name = "BMW PHEV Battery";
 
   bool supports_reset_DTC() { return true; }
-  void reset_DTC() { datalayer_extended.bmwphev.UserRequestDTCreset = true; }
+  void reset_DTC() { datalayer_bmwphev->UserRequestDTCreset = true; }
 
   bool supports_reset_BMS() { return true; }
-  void reset_BMS() { datalayer_extended.bmwphev.UserRequestBMSReset = true; }
+  void reset_BMS() { datalayer_bmwphev->UserRequestBMSReset = true; }
 
   // Beta CAN-based contactor close support via 0x53A (see INFO section in .cpp)
   bool supports_contactor_close() { return true; }
@@ -39,12 +44,14 @@ class BmwPhevBattery : public CanBattery {
 
   // Isolation test - one-shot UDS startRoutine (0xAD61). Same one-shot pattern as DTC/BMS reset.
   bool supports_isolation_test() { return true; }
-  void request_isolation_test() { datalayer_extended.bmwphev.UserRequestIsolationTest = true; }
+  void request_isolation_test() { datalayer_bmwphev->UserRequestIsolationTest = true; }
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
 
  private:
   BmwPhevHtmlRenderer renderer;
+  DATALAYER_INFO_BMWPHEV* datalayer_bmwphev;
+  DATALAYER_INFO_BMWIX* datalayer_bmwix;  // DTCs are kept in the iX values
 
   static const int MAX_PACK_VOLTAGE_DV = 4650;  //4650 = 465.0V
   static const int MIN_PACK_VOLTAGE_DV = 3000;
@@ -153,7 +153,7 @@ void BoltAmperaBattery::update_values() {  //This function maps all the values f
   }
 }
 
-void BoltAmperaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void BoltAmperaBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   uint8_t cellbank_mux = 0;
   uint8_t cellblock_index = 0;
   switch (rx_frame.ID) {
@@ -412,18 +412,24 @@ void BoltAmperaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void BoltAmperaBattery::transmit_can(unsigned long currentMillis) {
-
-  //Send 20ms message
-  if (currentMillis - previousMillis20ms >= INTERVAL_20_MS) {
-    previousMillis20ms = currentMillis;
-    transmit_can_frame(&BOLT_778);
+void BoltAmperaBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer_battery->info.number_of_cells = 96;
+  datalayer_battery->info.total_capacity_Wh = 64000;
+  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
+  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
+  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  if (allows_contactor_closing) {
+    *allows_contactor_closing = true;
   }
 
+  //Send 20ms message
+  transmit_every(INTERVAL_20_MS, 1, [this](unsigned long currentMillis) { transmit_can_frame(&BOLT_778); });
   //Send 100ms message
-  if (currentMillis - previousMillis100ms >= INTERVAL_100_MS) {
-    previousMillis100ms = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 1, [this](unsigned long currentMillis) {
     // Update current poll from the 7E7 array
     currentpoll_7E7 = poll_commands_7E7[poll_index_7E7];
     poll_index_7E7 = (poll_index_7E7 + 1) % 108;
@@ -437,12 +443,9 @@ void BoltAmperaBattery::transmit_can(unsigned long currentMillis) {
     } else {  //Normal poll
       transmit_can_frame(&BOLT_POLL_7E7);
     }
-  }
-
+  });
   //Send 120ms message
-  if (currentMillis - previousMillis120ms >= 120) {
-    previousMillis120ms = currentMillis;
-
+  transmit_every(120, 1, [this](unsigned long currentMillis) {
     // Update current poll from the 7E4 array
     currentpoll_7E4 = poll_commands_7E4[poll_index_7E4];
     poll_index_7E4 = (poll_index_7E4 + 1) % 19;
@@ -451,20 +454,5 @@ void BoltAmperaBattery::transmit_can(unsigned long currentMillis) {
     BOLT_POLL_7E4.data.u8[3] = (uint8_t)(currentpoll_7E4 & 0x00FF);
 
     //transmit_can_frame(&BOLT_POLL_7E4); //TODO: Battery does not seem to reply on this poll
-  }
-}
-
-void BoltAmperaBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer_battery->info.number_of_cells = 96;
-  datalayer_battery->info.total_capacity_Wh = 64000;
-  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
-  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
-  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
-  if (allows_contactor_closing) {
-    *allows_contactor_closing = true;
-  }
+  });
 }
@@ -8,10 +8,10 @@
 class BoltAmperaBattery : public CanBattery {
  public:
   // Default constructor - first or single battery
-  BoltAmperaBattery() : renderer(&datalayer_extended.boltampera) {
+  BoltAmperaBattery() : renderer(datalayer_extended.boltampera.get()) {
     datalayer_battery = &datalayer.battery;
     allows_contactor_closing = &datalayer.system.status.battery_allows_contactor_closing;
-    datalayer_boltampera = &datalayer_extended.boltampera;
+    datalayer_boltampera = datalayer_extended.boltampera.get();
   }
 
   // Second battery constructor
@@ -23,9 +23,10 @@ class BoltAmperaBattery : public CanBattery {
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
 
   static constexpr const char* Name = "Chevrolet Bolt EV/Opel Ampera-e";
 
@@ -187,10 +188,6 @@ class BoltAmperaBattery : public CanBattery {
   static const int POLL_7E7_CELL_95 = 0x423F;
   static const int POLL_7E7_CELL_96 = 0x4240;
 
-  unsigned long previousMillis20ms = 0;   // will store last time a 20ms CAN Message was send
-  unsigned long previousMillis100ms = 0;  // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis120ms = 0;  // will store last time a 120ms CAN Message was send
-
   CAN_frame BOLT_778 = {.FD = false,  // Unsure of what this message is, added only as example
                         .ext_ID = false,
                         .DLC = 7,
@@ -356,7 +356,7 @@ void BydAttoBattery::handle_auto_soc_calibration(bool crit_taper, uint32_t dt_ms
   }
 }
 
-void BydAttoBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void BydAttoBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x244:
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -732,11 +732,18 @@ void BydAttoBattery::handle_contactor_control(unsigned long currentMillis) {
   }
 }
 
-void BydAttoBattery::transmit_can(unsigned long currentMillis) {
-  //Send 50ms message
-  if (currentMillis - previousMillis50 >= INTERVAL_50_MS) {
-    previousMillis50 = currentMillis;
+void BydAttoBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer_battery->info.chemistry = battery_chemistry_enum::LFP;
+  datalayer_battery->info.max_design_voltage_dV = 6500;  //Startup in extremes
+  datalayer_battery->info.min_design_voltage_dV = 2000;  //We later determine range based on amount of cells
+  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
 
+  //Send 50ms message
+  transmit_every(INTERVAL_50_MS, 1, [this](unsigned long currentMillis) {
     // Set close contactors to allowed (Useful for crashed packs, started via contactor control thru GPIO)
     if (allows_contactor_closing) {
       if (datalayer.system.status.system_status == ACTIVE) {
@@ -753,12 +760,10 @@ void BydAttoBattery::transmit_can(unsigned long currentMillis) {
     ATTO_3_12D.data.u8[6] = (0x0F | (frame6_counter << 4));
     ATTO_3_12D.data.u8[7] = computeBydChecksum(ATTO_3_12D.data.u8);
 
-    transmit_can_frame(&ATTO_3_12D);
-  }
+    transmit_can_frame(&ATTO_3_12D, CAN_TX_SAFETY);
+  });
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 2, [this](unsigned long currentMillis) {
     if (counter_100ms < 100) {
       counter_100ms++;
     }
@@ -851,11 +856,9 @@ void BydAttoBattery::transmit_can(unsigned long currentMillis) {
       default:
         break;
     }
-  }
+  });
   // Send 200ms CAN Message
-  if (currentMillis - previousMillis200 >= INTERVAL_200_MS) {
-    previousMillis200 = currentMillis;
-
+  transmit_every(INTERVAL_200_MS, 1, [this](unsigned long currentMillis) {
     switch (poll_state) {
       case POLL_FOR_BATTERY_SOC:
         ATTO_3_7E7_POLL.data.u8[2] = (uint8_t)((POLL_FOR_BATTERY_SOC & 0xFF00) >> 8);
@@ -976,16 +979,5 @@ void BydAttoBattery::transmit_can(unsigned long currentMillis) {
         (stateMachineCalibrateSOC == NOT_RUNNING)) {  //Don't poll battery for data if any diag ongoing
       transmit_can_frame(&ATTO_3_7E7_POLL);
     }
-  }
-}
-
-void BydAttoBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer_battery->info.chemistry = battery_chemistry_enum::LFP;
-  datalayer_battery->info.max_design_voltage_dV = 6500;  //Startup in extremes
-  datalayer_battery->info.min_design_voltage_dV = 2000;  //We later determine range based on amount of cells
-  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  });
 }
@@ -18,20 +18,22 @@ class BydAttoBattery : public CanBattery {
   }
 
   // Use the default constructor to create the first or single battery.
-  BydAttoBattery() : renderer(&datalayer_extended.bydAtto3) {
+  BydAttoBattery() : renderer(datalayer_extended.bydAtto3.get()) {
     datalayer_battery = &datalayer.battery;
     allows_contactor_closing = &datalayer.system.status.battery_allows_contactor_closing;
-    datalayer_bydatto = &datalayer_extended.bydAtto3;
+    datalayer_bydatto = datalayer_extended.bydAtto3.get();
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
 
   static constexpr const char* Name = "BYD Atto 3/Seal/Dolphin";
 
   bool supports_charged_energy() { return true; }
+  const DATALAYER_INFO_BYDATTO3* byd_atto3_info() { return datalayer_bydatto; }
   bool supports_reset_crash() { return true; }
   void reset_crash() { datalayer_bydatto->UserRequestCrashReset = true; }
   bool supports_calibrate_SOC() { return true; }
@@ -53,9 +55,6 @@ class BydAttoBattery : public CanBattery {
   static const int RAMPDOWN_POWER_ALLOWED =
       10000;  // Power to start ramp down from, set a lower value to limit the power even further as SOC decreases
 
-  unsigned long previousMillis50 = 0;   // will store last time a 50ms CAN Message was send
-  unsigned long previousMillis100 = 0;  // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis200 = 0;  // will store last time a 200ms CAN Message was send
   uint64_t last_auto_calibrate_ms = 0;  // Cooldown timer for auto-calibration
   uint32_t autocal_dwell_ms = 0;        // Valid low-current/full time
   uint32_t autocal_grace_start_ms = 0;  // When current left the valid window
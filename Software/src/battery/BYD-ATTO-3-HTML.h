@@ -11,7 +11,23 @@ class BydAtto3HtmlRenderer : public BatteryHtmlRenderer {
 
   String get_status_html() {
     String content;
+    render_contactor_status(content);
+    render_measurements(content);
+    render_auto_calibration(content);
+    render_scripts(content);
+    return content;
+  }
+
+  // Each block is a section of its own, so only one is held in memory at a time
+  void status_sections(HtmlChunkedPage& page) {
+    page.section([this](String& content) { render_contactor_status(content); });
+    page.section([this](String& content) { render_measurements(content); });
+    page.section([this](String& content) { render_auto_calibration(content); });
+    page.section([this](String& content) { render_scripts(content); });
+  }
 
+ private:
+  void render_contactor_status(String& content) {
     const auto& dl_bat = s.length() ? datalayer.battery2 : datalayer.battery;
     content += "<h4>Detected cells: " + String(dl_bat.info.number_of_cells) + "</h4>";
     content += "<h4>BE contactor state: ";
@@ -111,7 +127,9 @@ class BydAtto3HtmlRenderer : public BatteryHtmlRenderer {
     // idle/drive/discharge alike). byte0 is the real charge/drive truth, so show this raw.
     content += String(byd_datalayer->discharge_status);
     content += "</h4>";
+  }
 
+  void render_measurements(String& content) {
     float soc_measured = static_cast<float>(byd_datalayer->SOC_highprec) * 0.1f;
     float BMS_maxChargePower = static_cast<float>(byd_datalayer->chargePower) * 0.1f;
     float BMS_maxDischargePower = static_cast<float>(byd_datalayer->dischargePower) * 0.1f;
@@ -183,7 +201,9 @@ class BydAtto3HtmlRenderer : public BatteryHtmlRenderer {
     content += "<h4>Capacity current: " + String((byd_datalayer->BMS_capacity_current_calibration) / 100) + "AH</h4>";
     content += "<h4>SOC original: " + String(byd_datalayer->BMC_SOC_original_calibration) + "&percnt;</h4>";
     content += "<h4>SOC current: " + String(byd_datalayer->BMC_SOC_current_calibration) + "&percnt;</h4>";
+  }
 
+  void render_auto_calibration(String& content) {
     content += "<h4>Auto-calibrate SOC to 100&percnt; when full: <input type='checkbox' id='autoCalEnabled" + s + "' ";
     content += (byd_datalayer->auto_calibrate_soc_enabled ? "checked" : "");
     content += " onchange='toggleAutoCalSOCEnabled" + s + "()'> (default ON)</h4>";
@@ -285,7 +305,9 @@ class BydAtto3HtmlRenderer : public BatteryHtmlRenderer {
                "&percnt; <button onclick='editCalTargetSOC" + s + "()'>Edit</button></h4>";
     content += "<h4>Calibration target capacity: " + String(byd_datalayer->calibrationTargetAH) +
                " AH <button onclick='editCalTargetAH" + s + "()'>Edit</button></h4>";
+  }
 
+  void render_scripts(String& content) {
     content += "<script>";
     content += "function editComplete() {";
     content += "  alert('Update successful!');";
@@ -341,11 +363,8 @@ class BydAtto3HtmlRenderer : public BatteryHtmlRenderer {
     content += "  xhr.send();";
     content += "}";
     content += "</script>";
-
-    return content;
   }
 
- private:
   DATALAYER_INFO_BYDATTO3* byd_datalayer;
   String s;
 };
@@ -5,6 +5,9 @@
 #include "../../src/devboard/utils/types.h"
 #include "../../src/devboard/webserver/BatteryHtmlRenderer.h"
 
+struct DATALAYER_INFO_BYDATTO3;
+struct DATALAYER_INFO_TESLA;
+
 enum class BatteryType {
   None = 0,
   BmwI3 = 2,
@@ -76,6 +79,9 @@ extern battery_chemistry_enum user_selected_battery_chemistry;
 // Defines the interface to call battery specific functionality.
 class Battery {
  public:
+  // Deleting through this base has to reach the destructors of the subclasses, e.g. to drop scheduled transmit jobs
+  virtual ~Battery() = default;
+
   virtual void setup(void) = 0;
   virtual void update_values() = 0;
 
@@ -144,6 +150,10 @@ class Battery {
   // Battery reports total_charged_battery_Wh and total_discharged_battery_Wh
   virtual bool supports_charged_energy() { return false; }
 
+  // Extended datalayer block of this battery instance, nullptr for other battery types
+  virtual const DATALAYER_INFO_TESLA* tesla_info() { return nullptr; }
+  virtual const DATALAYER_INFO_BYDATTO3* byd_atto3_info() { return nullptr; }
+
   virtual BatteryHtmlRenderer& get_status_renderer() { return defaultRenderer; }
 
  private:
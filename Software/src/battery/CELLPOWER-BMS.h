@@ -5,10 +5,12 @@
 
 class CellPowerBms : public CanBattery {
  public:
-  CellPowerBms() : CanBattery(CAN_Speed::CAN_SPEED_250KBPS) {}
+  CellPowerBms() : CanBattery(CAN_Speed::CAN_SPEED_250KBPS), renderer(datalayer_extended.cellpower.get()) {
+    datalayer_cellpower = datalayer_extended.cellpower.get();
+  }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
@@ -18,6 +20,7 @@ class CellPowerBms : public CanBattery {
 
  private:
   CellpowerHtmlRenderer renderer;
+  DATALAYER_INFO_CELLPOWER* datalayer_cellpower;
 
   unsigned long previousMillis1s = 0;  // will store last time a 1s CAN Message was sent
 
@@ -7,10 +7,12 @@
 
 class ChademoBatteryHtmlRenderer : public BatteryHtmlRenderer {
  public:
+  ChademoBatteryHtmlRenderer(DATALAYER_INFO_CHADEMO* dl) : chademo_dl(dl) {}
+
   String get_status_html() {
     String content;
     content += "<h4>Chademo state: ";
-    switch (datalayer_extended.chademo.CHADEMO_Status) {
+    switch (chademo_dl->CHADEMO_Status) {
       case 0:
         content += String("FAULT</h4>");
         break;
@@ -48,22 +50,22 @@ class ChademoBatteryHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Unknown</h4>");
         break;
     }
-    if (datalayer_extended.chademo.FaultBatteryCurrentDeviation) {
+    if (chademo_dl->FaultBatteryCurrentDeviation) {
       content += "<h4>FAULT: Battery Current Deviation</h4>";
     }
-    if (datalayer_extended.chademo.FaultBatteryOverVoltage) {
+    if (chademo_dl->FaultBatteryOverVoltage) {
       content += "<h4>FAULT: Battery Overvoltage</h4>";
     }
-    if (datalayer_extended.chademo.FaultBatteryUnderVoltage) {
+    if (chademo_dl->FaultBatteryUnderVoltage) {
       content += "<h4>FAULT: Battery Undervoltage</h4>";
     }
-    if (datalayer_extended.chademo.FaultBatteryVoltageDeviation) {
+    if (chademo_dl->FaultBatteryVoltageDeviation) {
       content += "<h4>FAULT: Battery Voltage Deviation</h4>";
     }
-    if (datalayer_extended.chademo.FaultHighBatteryTemperature) {
+    if (chademo_dl->FaultHighBatteryTemperature) {
       content += "<h4>FAULT: Battery Temperature</h4>";
     }
-    content += "<h4>Protocol: " + String(datalayer_extended.chademo.ControlProtocolNumberEV) + "</h4>";
+    content += "<h4>Protocol: " + String(chademo_dl->ControlProtocolNumberEV) + "</h4>";
 
     //Script for refreshing page
     content += "<script>";
@@ -72,6 +74,9 @@ class ChademoBatteryHtmlRenderer : public BatteryHtmlRenderer {
 
     return content;
   }
+
+ private:
+  DATALAYER_INFO_CHADEMO* chademo_dl;
 };
 
 #endif
@@ -9,7 +9,8 @@
 
 class ChademoBattery : public CanBattery {
  public:
-  ChademoBattery() {
+  ChademoBattery() : renderer(datalayer_extended.chademo.get()) {
+    datalayer_chademo = datalayer_extended.chademo.get();
     pin2 = esp32hal->CHADEMO_PIN_2();
     pin10 = esp32hal->CHADEMO_PIN_10();
     pin4 = esp32hal->CHADEMO_PIN_4();
@@ -22,15 +23,15 @@ class ChademoBattery : public CanBattery {
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
   bool supports_chademo_restart() { return true; }
   bool supports_chademo_stop() { return true; }
 
-  void chademo_restart() { datalayer_extended.chademo.UserRequestRestart = true; }
-  void chademo_stop() { datalayer_extended.chademo.UserRequestStop = true; }
+  void chademo_restart() { datalayer_chademo->UserRequestRestart = true; }
+  void chademo_stop() { datalayer_chademo->UserRequestStop = true; }
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
   static constexpr const char* Name = "Chademo V2X mode";
@@ -38,14 +39,15 @@ class ChademoBattery : public CanBattery {
  private:
   gpio_num_t pin2, pin10, pin4, pin7, pin_lock, precharge, positive_contactor;
   ChademoBatteryHtmlRenderer renderer;
-
-  void process_vehicle_charging_minimums(CAN_frame rx_frame);
-  void process_vehicle_charging_maximums(CAN_frame rx_frame);
-  void process_vehicle_charging_session(CAN_frame rx_frame);
-  void process_vehicle_charging_limits(CAN_frame rx_frame);
-  void process_vehicle_discharge_estimate(CAN_frame rx_frame);
-  void process_vehicle_dynamic_control(CAN_frame rx_frame);
-  void process_vehicle_vendor_ID(CAN_frame rx_frame);
+  DATALAYER_INFO_CHADEMO* datalayer_chademo;
+
+  void process_vehicle_charging_minimums(const CAN_frame& rx_frame);
+  void process_vehicle_charging_maximums(const CAN_frame& rx_frame);
+  void process_vehicle_charging_session(const CAN_frame& rx_frame);
+  void process_vehicle_charging_limits(const CAN_frame& rx_frame);
+  void process_vehicle_discharge_estimate(const CAN_frame& rx_frame);
+  void process_vehicle_dynamic_control(const CAN_frame& rx_frame);
+  void process_vehicle_vendor_ID(const CAN_frame& rx_frame);
   void evse_init();
   void update_evse_capabilities(CAN_frame& f);
   void update_evse_status(CAN_frame& f);
@@ -74,7 +74,7 @@ float get_measured_current() {
 }
 
 //This is our CAN interrupt service routine to catch inbound frames
-void ISA_handleFrame(CAN_frame* frame) {
+void ISA_handleFrame(const CAN_frame* frame) {
 
   if (frame->ID < 0x510 || frame->ID > 0x528) {
     return;
@@ -124,7 +124,7 @@ void ISA_handleFrame(CAN_frame* frame) {
 }
 
 //handle frame for Amperes
-inline void ISA_handle521(CAN_frame* frame) {
+inline void ISA_handle521(const CAN_frame* frame) {
   long current = 0;
   current =
       (long)((frame->data.u8[2] << 24) | (frame->data.u8[3] << 16) | (frame->data.u8[4] << 8) | (frame->data.u8[5]));
@@ -134,7 +134,7 @@ inline void ISA_handle521(CAN_frame* frame) {
 }
 
 //handle frame for Voltage
-inline void ISA_handle522(CAN_frame* frame) {
+inline void ISA_handle522(const CAN_frame* frame) {
   long volt =
       (long)((frame->data.u8[2] << 24) | (frame->data.u8[3] << 16) | (frame->data.u8[4] << 8) | (frame->data.u8[5]));
 
@@ -157,7 +157,7 @@ inline void ISA_handle522(CAN_frame* frame) {
 }
 
 //handle frame for Voltage 2
-inline void ISA_handle523(CAN_frame* frame) {
+inline void ISA_handle523(const CAN_frame* frame) {
   long volt =
       (long)((frame->data.u8[2] << 24) | (frame->data.u8[3] << 16) | (frame->data.u8[4] << 8) | (frame->data.u8[5]));
 
@@ -176,7 +176,7 @@ inline void ISA_handle523(CAN_frame* frame) {
 }
 
 //handle frame for Voltage3
-inline void ISA_handle524(CAN_frame* frame) {
+inline void ISA_handle524(const CAN_frame* frame) {
   long volt =
       (long)((frame->data.u8[2] << 24) | (frame->data.u8[3] << 16) | (frame->data.u8[4] << 8) | (frame->data.u8[5]));
 
@@ -193,7 +193,7 @@ inline void ISA_handle524(CAN_frame* frame) {
 }
 
 //handle frame for Temperature
-inline void ISA_handle525(CAN_frame* frame) {
+inline void ISA_handle525(const CAN_frame* frame) {
   long temp = 0;
   temp = (long)((frame->data.u8[2] << 24) | (frame->data.u8[3] << 16) | (frame->data.u8[4] << 8) | (frame->data.u8[5]));
 
@@ -201,7 +201,7 @@ inline void ISA_handle525(CAN_frame* frame) {
 }
 
 //handle frame for Kilowatts
-inline void ISA_handle526(CAN_frame* frame) {
+inline void ISA_handle526(const CAN_frame* frame) {
   watt = 0;
   watt = (long)((frame->data.u8[2] << 24) | (frame->data.u8[3] << 16) | (frame->data.u8[4] << 8) | (frame->data.u8[5]));
 
@@ -209,7 +209,7 @@ inline void ISA_handle526(CAN_frame* frame) {
 }
 
 //handle frame for Ampere-Hours
-inline void ISA_handle527(CAN_frame* frame) {
+inline void ISA_handle527(const CAN_frame* frame) {
   As = 0;
   As = (long)(frame->data.u8[2] << 24) | (frame->data.u8[3] << 16) | (frame->data.u8[4] << 8) | (frame->data.u8[5]);
 
@@ -218,7 +218,7 @@ inline void ISA_handle527(CAN_frame* frame) {
 }
 
 //handle frame for kiloWatt-hours
-inline void ISA_handle528(CAN_frame* frame) {
+inline void ISA_handle528(const CAN_frame* frame) {
   wh = (long)((frame->data.u8[2] << 24) | (frame->data.u8[3] << 16) | (frame->data.u8[4] << 8) | (frame->data.u8[5]));
   KWH += (wh - lastWh) / 1000.0f;
   lastWh = wh;
@@ -7,15 +7,15 @@
 float get_measured_voltage();
 float get_measured_current();
 
-void ISA_handleFrame(CAN_frame* frame);
-inline void ISA_handle521(CAN_frame* frame);
-inline void ISA_handle522(CAN_frame* frame);
-inline void ISA_handle523(CAN_frame* frame);
-inline void ISA_handle524(CAN_frame* frame);
-inline void ISA_handle525(CAN_frame* frame);
-inline void ISA_handle526(CAN_frame* frame);
-inline void ISA_handle527(CAN_frame* frame);
-inline void ISA_handle528(CAN_frame* frame);
+void ISA_handleFrame(const CAN_frame* frame);
+inline void ISA_handle521(const CAN_frame* frame);
+inline void ISA_handle522(const CAN_frame* frame);
+inline void ISA_handle523(const CAN_frame* frame);
+inline void ISA_handle524(const CAN_frame* frame);
+inline void ISA_handle525(const CAN_frame* frame);
+inline void ISA_handle526(const CAN_frame* frame);
+inline void ISA_handle527(const CAN_frame* frame);
+inline void ISA_handle528(const CAN_frame* frame);
 void ISA_initialize();
 void ISA_STOP();
 void ISA_sendSTORE();
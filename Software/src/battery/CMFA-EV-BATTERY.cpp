@@ -101,7 +101,7 @@ void CmfaEvBattery::
   }
 }
 
-void CmfaEvBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void CmfaEvBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {  //These frames are transmitted by the battery
     case 0x127:           //10ms , Same structure as old Zoe 0x155 message!
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -263,10 +263,19 @@ void CmfaEvBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void CmfaEvBattery::transmit_can(unsigned long currentMillis) {
+void CmfaEvBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.system.status.battery_allows_contactor_closing = true;
+  datalayer_battery->info.number_of_cells = 72;
+  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
+  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
+  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+
   // Send 10ms CAN Message
-  if (currentMillis - previousMillis10ms >= INTERVAL_10_MS) {
-    previousMillis10ms = currentMillis;
+  transmit_every(INTERVAL_10_MS, 4, [this](unsigned long currentMillis) {
     transmit_can_frame(&CMFA_1EA);
     transmit_can_frame(&CMFA_135);
     transmit_can_frame(&CMFA_134);
@@ -275,18 +284,14 @@ void CmfaEvBattery::transmit_can(unsigned long currentMillis) {
     CMFA_135.data.u8[1] = content_135[counter_10ms];
     CMFA_125.data.u8[3] = content_125[counter_10ms];
     counter_10ms = (counter_10ms + 1) % 16;  // counter_10ms cycles between 0-1-2-3..15-0-1...
-  }
+  });
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100ms >= INTERVAL_100_MS) {
-    previousMillis100ms = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 2, [this](unsigned long currentMillis) {
     transmit_can_frame(&CMFA_59B);
     transmit_can_frame(&CMFA_3D3);
-  }
+  });
   //Send 200ms message
-  if (currentMillis - previousMillis200ms >= INTERVAL_200_MS) {
-    previousMillis200ms = currentMillis;
-
+  transmit_every(INTERVAL_200_MS, 1, [this](unsigned long currentMillis) {
     switch (poll_pid) {
       case PID_POLL_SOH_AVERAGE:
         CMFA_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_POLL_SOH_AVERAGE >> 8);
@@ -768,17 +773,5 @@ void CmfaEvBattery::transmit_can(unsigned long currentMillis) {
     } else {  //Normal PID polling
       transmit_can_frame(&CMFA_POLLING_FRAME);
     }
-  }
-}
-
-void CmfaEvBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.system.status.battery_allows_contactor_closing = true;
-  datalayer_battery->info.number_of_cells = 72;
-  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
-  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
-  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  });
 }
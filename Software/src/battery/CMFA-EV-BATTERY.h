@@ -10,7 +10,7 @@ class CmfaEvBattery : public CanBattery {
  public:
   // Use this constructor for the second battery.
   CmfaEvBattery(DATALAYER_BATTERY_TYPE* datalayer_ptr, DATALAYER_INFO_CMFAEV* extended, CAN_Interface targetCan)
-      : CanBattery(targetCan) {
+      : CanBattery(targetCan), renderer(datalayer_extended.CMFAEV.get()) {
     datalayer_battery = datalayer_ptr;
     allows_contactor_closing = nullptr;
     datalayer_cmfa = extended;
@@ -19,19 +19,20 @@ class CmfaEvBattery : public CanBattery {
   }
 
   // Use the default constructor to create the first or single battery.
-  CmfaEvBattery() {
+  CmfaEvBattery() : renderer(datalayer_extended.CMFAEV.get()) {
     datalayer_battery = &datalayer.battery;
     allows_contactor_closing = &datalayer.system.status.battery_allows_contactor_closing;
-    datalayer_cmfa = &datalayer_extended.CMFAEV;
+    datalayer_cmfa = datalayer_extended.CMFAEV.get();
   }
 
   bool supports_reset_DTC() { return true; }
   void reset_DTC() { UserRequestDTCclear = true; }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "CMFA platform, 27 kWh battery";
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
@@ -226,9 +227,6 @@ class CmfaEvBattery : public CanBattery {
                              0x0F, 0x04, 0x09, 0x0E, 0x03, 0x08, 0x0D, 0x02};
   uint8_t content_135[16] = {0x85, 0xD5, 0x25, 0x75, 0xC5, 0x15, 0x65, 0xB5,
                              0x05, 0x55, 0xA5, 0xF5, 0x45, 0x95, 0xE5, 0x35};
-  unsigned long previousMillis200ms = 0;
-  unsigned long previousMillis100ms = 0;
-  unsigned long previousMillis10ms = 0;
 
   static const int MAXSOC = 9000;  //90.00 Raw SOC displays this value when battery is at 100%
   static const int MINSOC = 500;   //5.00 Raw SOC displays this value when battery is at 0%
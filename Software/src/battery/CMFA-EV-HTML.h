@@ -7,34 +7,35 @@
 
 class CmfaEvHtmlRenderer : public BatteryHtmlRenderer {
  public:
+  CmfaEvHtmlRenderer(DATALAYER_INFO_CMFAEV* dl) : cmfa_dl(dl) {}
+
   String get_status_html() {
     String content;
 
-    content += "<h4>SOC U: " + String(datalayer_extended.CMFAEV.soc_u) + "percent</h4>";
-    content += "<h4>SOC Z: " + String(datalayer_extended.CMFAEV.soc_z) + "percent</h4>";
-    content += "<h4>SOH Average: " + String(datalayer_extended.CMFAEV.soh_average) + "pptt</h4>";
-    content += "<h4>12V voltage: " + String(datalayer_extended.CMFAEV.lead_acid_voltage) + "mV</h4>";
-    content += "<h4>Highest cell number: " + String(datalayer_extended.CMFAEV.highest_cell_voltage_number) + "</h4>";
-    content += "<h4>Lowest cell number: " + String(datalayer_extended.CMFAEV.lowest_cell_voltage_number) + "</h4>";
-    content += "<h4>Sum of cellvoltages: " + String(datalayer_extended.CMFAEV.average_voltage_of_cells) + "</h4>";
-    content += "<h4>Max regen power: " + String(datalayer_extended.CMFAEV.max_regen_power) + "</h4>";
-    content += "<h4>Max discharge power: " + String(datalayer_extended.CMFAEV.max_discharge_power) + "</h4>";
-    content += "<h4>Max charge power: " + String(datalayer_extended.CMFAEV.maximum_charge_power) + "</h4>";
-    content += "<h4>SOH available power: " + String(datalayer_extended.CMFAEV.SOH_available_power) + "</h4>";
-    content += "<h4>SOH generated power: " + String(datalayer_extended.CMFAEV.SOH_generated_power) + "</h4>";
-    content += "<h4>Average temperature: " + String(datalayer_extended.CMFAEV.average_temperature) + "dC</h4>";
-    content += "<h4>Maximum temperature: " + String(datalayer_extended.CMFAEV.maximum_temperature) + "dC</h4>";
-    content += "<h4>Minimum temperature: " + String(datalayer_extended.CMFAEV.minimum_temperature) + "dC</h4>";
-    content +=
-        "<h4>Cumulative energy discharged: " + String(datalayer_extended.CMFAEV.cumulative_energy_when_discharging) +
-        "Wh</h4>";
-    content += "<h4>Cumulative energy charged: " + String(datalayer_extended.CMFAEV.cumulative_energy_when_charging) +
-               "Wh</h4>";
-    content +=
-        "<h4>Cumulative energy regen: " + String(datalayer_extended.CMFAEV.cumulative_energy_in_regen) + "Wh</h4>";
+    content += "<h4>SOC U: " + String(cmfa_dl->soc_u) + "percent</h4>";
+    content += "<h4>SOC Z: " + String(cmfa_dl->soc_z) + "percent</h4>";
+    content += "<h4>SOH Average: " + String(cmfa_dl->soh_average) + "pptt</h4>";
+    content += "<h4>12V voltage: " + String(cmfa_dl->lead_acid_voltage) + "mV</h4>";
+    content += "<h4>Highest cell number: " + String(cmfa_dl->highest_cell_voltage_number) + "</h4>";
+    content += "<h4>Lowest cell number: " + String(cmfa_dl->lowest_cell_voltage_number) + "</h4>";
+    content += "<h4>Sum of cellvoltages: " + String(cmfa_dl->average_voltage_of_cells) + "</h4>";
+    content += "<h4>Max regen power: " + String(cmfa_dl->max_regen_power) + "</h4>";
+    content += "<h4>Max discharge power: " + String(cmfa_dl->max_discharge_power) + "</h4>";
+    content += "<h4>Max charge power: " + String(cmfa_dl->maximum_charge_power) + "</h4>";
+    content += "<h4>SOH available power: " + String(cmfa_dl->SOH_available_power) + "</h4>";
+    content += "<h4>SOH generated power: " + String(cmfa_dl->SOH_generated_power) + "</h4>";
+    content += "<h4>Average temperature: " + String(cmfa_dl->average_temperature) + "dC</h4>";
+    content += "<h4>Maximum temperature: " + String(cmfa_dl->maximum_temperature) + "dC</h4>";
+    content += "<h4>Minimum temperature: " + String(cmfa_dl->minimum_temperature) + "dC</h4>";
+    content += "<h4>Cumulative energy discharged: " + String(cmfa_dl->cumulative_energy_when_discharging) + "Wh</h4>";
+    content += "<h4>Cumulative energy charged: " + String(cmfa_dl->cumulative_energy_when_charging) + "Wh</h4>";
+    content += "<h4>Cumulative energy regen: " + String(cmfa_dl->cumulative_energy_in_regen) + "Wh</h4>";
 
     return content;
   }
+
+ private:
+  DATALAYER_INFO_CMFAEV* cmfa_dl;
 };
 
 #endif
@@ -55,30 +55,30 @@ void CmpSmartCarBattery::update_values() {
     set_event(EVENT_THERMAL_RUNAWAY, 0);
   }
 
-  datalayer_extended.stellantisCMPsmart.battery_negative_contactor_state = battery_negative_contactor_state;
-  datalayer_extended.stellantisCMPsmart.battery_precharge_contactor_state = battery_precharge_contactor_state;
-  datalayer_extended.stellantisCMPsmart.battery_positive_contactor_state = battery_positive_contactor_state;
-  datalayer_extended.stellantisCMPsmart.battery_balancing_active = battery_balancing_active;
-  datalayer_extended.stellantisCMPsmart.eplug_status = eplug_status;
-  datalayer_extended.stellantisCMPsmart.HVIL_status = HVIL_status;
-  datalayer_extended.stellantisCMPsmart.ev_warning = ev_warning;
-  datalayer_extended.stellantisCMPsmart.power_auth = power_auth;
-  datalayer_extended.stellantisCMPsmart.insulation_fault = insulation_fault;
-  datalayer_extended.stellantisCMPsmart.insulation_circuit_status = insulation_circuit_status;
-  datalayer_extended.stellantisCMPsmart.battery_state = battery_state;
-  datalayer_extended.stellantisCMPsmart.alert_frame3 = alert_frame3;
-  datalayer_extended.stellantisCMPsmart.alert_frame4 = alert_frame4;
-  datalayer_extended.stellantisCMPsmart.hardware_fault_status = hardware_fault_status;
-  datalayer_extended.stellantisCMPsmart.l3_fault = l3_fault;
-  datalayer_extended.stellantisCMPsmart.plausibility_error = plausibility_error;
-  datalayer_extended.stellantisCMPsmart.battery_charging_status = battery_charging_status;
-  datalayer_extended.stellantisCMPsmart.battery_fault = battery_fault;
-  datalayer_extended.stellantisCMPsmart.hvbat_wakeup_state = hvbat_wakeup_state;
-  datalayer_extended.stellantisCMPsmart.active_DTC_code = active_DTC_code;
-  datalayer_extended.stellantisCMPsmart.rcd_line_active = rcd_line_active;
+  datalayer_cmpsmart->battery_negative_contactor_state = battery_negative_contactor_state;
+  datalayer_cmpsmart->battery_precharge_contactor_state = battery_precharge_contactor_state;
+  datalayer_cmpsmart->battery_positive_contactor_state = battery_positive_contactor_state;
+  datalayer_cmpsmart->battery_balancing_active = battery_balancing_active;
+  datalayer_cmpsmart->eplug_status = eplug_status;
+  datalayer_cmpsmart->HVIL_status = HVIL_status;
+  datalayer_cmpsmart->ev_warning = ev_warning;
+  datalayer_cmpsmart->power_auth = power_auth;
+  datalayer_cmpsmart->insulation_fault = insulation_fault;
+  datalayer_cmpsmart->insulation_circuit_status = insulation_circuit_status;
+  datalayer_cmpsmart->battery_state = battery_state;
+  datalayer_cmpsmart->alert_frame3 = alert_frame3;
+  datalayer_cmpsmart->alert_frame4 = alert_frame4;
+  datalayer_cmpsmart->hardware_fault_status = hardware_fault_status;
+  datalayer_cmpsmart->l3_fault = l3_fault;
+  datalayer_cmpsmart->plausibility_error = plausibility_error;
+  datalayer_cmpsmart->battery_charging_status = battery_charging_status;
+  datalayer_cmpsmart->battery_fault = battery_fault;
+  datalayer_cmpsmart->hvbat_wakeup_state = hvbat_wakeup_state;
+  datalayer_cmpsmart->active_DTC_code = active_DTC_code;
+  datalayer_cmpsmart->rcd_line_active = rcd_line_active;
 }
 
-bool checksum_OK(CAN_frame& rx_frame, uint8_t magic_byte) {
+bool checksum_OK(const CAN_frame& rx_frame, uint8_t magic_byte) {
   // Sum all data nibbles from bytes 0-6 (excluding last byte)
   uint8_t sum = 0;
 
@@ -102,7 +102,7 @@ bool checksum_OK(CAN_frame& rx_frame, uint8_t magic_byte) {
   return (checksum == expected);
 }
 
-uint8_t calculate_checksum(CAN_frame& rx_frame, uint8_t magic_byte) {
+uint8_t calculate_checksum(const CAN_frame& rx_frame, uint8_t magic_byte) {
   // Sum all data nibbles from bytes 0-6 (excluding last byte)
   uint8_t sum = 0;
 
@@ -123,7 +123,7 @@ uint8_t calculate_checksum(CAN_frame& rx_frame, uint8_t magic_byte) {
   return calculated_checksum;
 }
 
-uint8_t calculate_checksum432(CAN_frame& rx_frame) {
+uint8_t calculate_checksum432(const CAN_frame& rx_frame) {
   // Sum all data nibbles from bytes 0-6 (excluding last byte)
   uint8_t sum = 0;
   uint8_t magic_byte = 6;
@@ -149,7 +149,7 @@ uint8_t calculate_checksum432(CAN_frame& rx_frame) {
   return calculated_checksum;
 }
 
-void CmpSmartCarBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void CmpSmartCarBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x205:  //10ms
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -397,13 +397,34 @@ void CmpSmartCarBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void CmpSmartCarBattery::transmit_can(unsigned long currentMillis) {
+void CmpSmartCarBattery::setup(void) {  // Performs one time setup at startup
+  static bool pins_allocated = false;
+
+  // Only allocate pins once, double-battery uses same WUP pin
+  if (!pins_allocated) {
+    if (!esp32hal->alloc_pins(Name, esp32hal->WUP_PIN1())) {
+      return;  // Pin allocation failed
+    }
+    pinMode(esp32hal->WUP_PIN1(), OUTPUT);
+    digitalWrite(esp32hal->WUP_PIN1(), LOW);  // Set pin to low
+    pins_allocated = true;
+  }
+
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer_battery->info.number_of_cells = 100;
+  datalayer_battery->info.chemistry = battery_chemistry_enum::LFP;
+  datalayer_battery->info.total_capacity_Wh = 41400;
+  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_100S_DV;
+  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_100S_DV;
+  datalayer.system.status.battery_allows_contactor_closing = true;
 
   // Send periodic CAN Messages simulating the car still being attached
   // Send 10ms messages
-  if (currentMillis - previousMillis10 >= INTERVAL_10_MS) {
-    previousMillis10 = currentMillis;
-
+  transmit_every(INTERVAL_10_MS, 1, [this](unsigned long currentMillis) {
     if (startup_increment < 250) {
       startup_increment++;
     }
@@ -432,11 +453,9 @@ void CmpSmartCarBattery::transmit_can(unsigned long currentMillis) {
     //transmit_can_frame(&CMP_241);
     //transmit_can_frame(&CMP_262);
     */
-  }
-
+  });
   // Send 50ms messages
-  if (currentMillis - previousMillis50 >= INTERVAL_50_MS) {
-    previousMillis50 = currentMillis;
+  transmit_every(INTERVAL_50_MS, 1, [this](unsigned long currentMillis) {
     counter_50ms = (counter_50ms + 1) % 16;  // counter_50ms repeats after 16 messages. 0-1..15-0
 
     /*
@@ -466,11 +485,9 @@ void CmpSmartCarBattery::transmit_can(unsigned long currentMillis) {
 
     transmit_can_frame(&CMP_432);  //Main wakeup
     //transmit_can_frame(&CMP_421);  //Post wakeup (Apparently not needed for contactor closing?)
-  }
-
+  });
   // Send 60ms messages
-  if (currentMillis - previousMillis60 >= INTERVAL_60_MS) {
-    previousMillis60 = currentMillis;
+  transmit_every(INTERVAL_60_MS, 1, [this](unsigned long currentMillis) {
     counter_60ms = (counter_60ms + 1) % 16;  // counter_60ms repeats after 16 messages. 0-1..15-0
 
     if (startup_increment < 200) {  //During startup we request open contactors
@@ -494,11 +511,9 @@ void CmpSmartCarBattery::transmit_can(unsigned long currentMillis) {
     CMP_351.data.u8[7] = (calculate_checksum(CMP_351, 0x06) << 4) | counter_60ms;
 
     transmit_can_frame(&CMP_351);  //Airbag
-  }
-
+  });
   // Send 100ms messages
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
+  transmit_every(INTERVAL_100_MS, 1, [this](unsigned long currentMillis) {
     counter_100ms = (counter_100ms + 1) % 16;  // counter_100ms repeats after 16 messages. 0-1..15-0
 
     CMP_211.data.u8[2] = 0x00;  //00 QC contactor OFF, 81, QC contactor ON
@@ -524,12 +539,9 @@ void CmpSmartCarBattery::transmit_can(unsigned long currentMillis) {
     //transmit_can_frame(&CMP_231);  // Battery Preconditioning (Apparently not needed for contactor closing?)
     //transmit_can_frame(&CMP_422);  // (Apparently not needed for contactor closing?)
     //transmit_can_frame(&CMP_4A2);  //Should we send plugged in, or unplugged? (Apparently not needed for contactor closing?)
-  }
-
+  });
   // Send 1s messages
-  if (currentMillis - previousMillis1000 >= INTERVAL_1_S) {
-    previousMillis1000 = currentMillis;
-
+  transmit_every(INTERVAL_1_S, 2, [this](unsigned long currentMillis) {
     /*
     vehicle_time_counter = (vehicle_time_counter + 10);
 
@@ -541,35 +553,9 @@ void CmpSmartCarBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&CMP_552);
     //This message is odd. Non periodic, but increments 10 per cycle. Might be enough to send it once every second
     */
-    if (datalayer_extended.stellantisCMPsmart.UserRequestDTCreset) {
+    if (datalayer_cmpsmart->UserRequestDTCreset) {
       transmit_can_frame(&CMP_CLEAR_ALL_DTC);
-      datalayer_extended.stellantisCMPsmart.UserRequestDTCreset = false;
+      datalayer_cmpsmart->UserRequestDTCreset = false;
     }
-  }
-}
-
-void CmpSmartCarBattery::setup(void) {  // Performs one time setup at startup
-  static bool pins_allocated = false;
-
-  // Only allocate pins once, double-battery uses same WUP pin
-  if (!pins_allocated) {
-    if (!esp32hal->alloc_pins(Name, esp32hal->WUP_PIN1())) {
-      return;  // Pin allocation failed
-    }
-    pinMode(esp32hal->WUP_PIN1(), OUTPUT);
-    digitalWrite(esp32hal->WUP_PIN1(), LOW);  // Set pin to low
-    pins_allocated = true;
-  }
-
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer_battery->info.number_of_cells = 100;
-  datalayer_battery->info.chemistry = battery_chemistry_enum::LFP;
-  datalayer_battery->info.total_capacity_Wh = 41400;
-  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
-  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_100S_DV;
-  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_100S_DV;
-  datalayer.system.status.battery_allows_contactor_closing = true;
+  });
 }
@@ -9,27 +9,28 @@ class CmpSmartCarBattery : public CanBattery {
  public:
   // Use this constructor for the second battery.
   CmpSmartCarBattery(DATALAYER_BATTERY_TYPE* datalayer_ptr, DATALAYER_INFO_CMPSMART* extended, CAN_Interface targetCan)
-      : CanBattery(targetCan) {
+      : CanBattery(targetCan), renderer(extended) {
     datalayer_battery = datalayer_ptr;
     datalayer_cmpsmart = extended;
   }
 
   // Use the default constructor to create the first or single battery.
-  CmpSmartCarBattery() {
+  CmpSmartCarBattery() : renderer(datalayer_extended.stellantisCMPsmart.get()) {
     datalayer_battery = &datalayer.battery;
-    datalayer_cmpsmart = &datalayer_extended.stellantisCMPsmart;
+    datalayer_cmpsmart = datalayer_extended.stellantisCMPsmart.get();
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Stellantis CMP Smart Car Battery";
 
   bool supports_charged_energy() { return true; }
 
   bool supports_reset_DTC() { return true; }
-  void reset_DTC() { datalayer_extended.stellantisCMPsmart.UserRequestDTCreset = true; }
+  void reset_DTC() { datalayer_cmpsmart->UserRequestDTCreset = true; }
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
 
@@ -44,12 +45,6 @@ class CmpSmartCarBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 3650;
   static const int MIN_CELL_VOLTAGE_MV = 2800;
 
-  unsigned long previousMillis10 = 0;    // will store last time a 10ms CAN Message was sent
-  unsigned long previousMillis50 = 0;    // will store last time a 50ms CAN Message was sent
-  unsigned long previousMillis60 = 0;    // will store last time a 60ms CAN Message was sent
-  unsigned long previousMillis100 = 0;   // will store last time a 100ms CAN Message was sent
-  unsigned long previousMillis1000 = 0;  // will store last time a 1000ms CAN Message was sent
-
   uint8_t precalculated432[16] = {0x12, 0x11, 0x10, 0x1F, 0x1E, 0x1D, 0x1C, 0x1B,
                                   0x1A, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13};
 
@@ -1,12 +1,12 @@
 #include "CanBattery.h"
 
-CanBattery::CanBattery(CAN_Speed speed) : CanBattery(can_config.battery, speed) {}
+CanBattery::CanBattery(CAN_Speed speed, const CAN_ID_Filter& filter) : CanBattery(can_config.battery, speed, filter) {}
 
-CanBattery::CanBattery(CAN_Interface interface, CAN_Speed speed) {
+CanBattery::CanBattery(CAN_Interface interface, CAN_Speed speed, const CAN_ID_Filter& filter) {
   can_interface = interface;
   initial_speed = speed;
   register_transmitter(this);
-  register_can_receiver(this, can_interface, speed);
+  register_can_receiver(this, can_interface, speed, filter);
 }
 
 bool CanBattery::change_can_speed(CAN_Speed speed) {
@@ -12,26 +12,41 @@
 // Abstract base class for batteries using the CAN bus
 class CanBattery : public Battery, Transmitter, CanReceiver {
  public:
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame) = 0;
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame) = 0;
+  // Polled every ms until the battery schedules its frames with transmit_every(). Batteries that schedule all of
+  // their frames still implement it, empty, so a battery that forgets to send does not compile.
   virtual void transmit_can(unsigned long currentMillis) = 0;
 
   const char* interface_name() { return getCANInterfaceName(can_interface); }
 
   void transmit(unsigned long currentMillis) { transmit_can(currentMillis); }
 
-  void receive_can_frame(CAN_frame* frame) { handle_incoming_can_frame(*frame); }
+  void receive_can_frame(const CAN_frame& frame) { handle_incoming_can_frame(frame); }
 
  protected:
   CAN_Interface can_interface;
   CAN_Speed initial_speed;
 
-  CanBattery(CAN_Speed speed = CAN_Speed::CAN_SPEED_500KBPS);
-  CanBattery(CAN_Interface interface, CAN_Speed speed = CAN_Speed::CAN_SPEED_500KBPS);
+  // Frames the filter rejects never reach handle_incoming_can_frame, see register_can_receiver
+  CanBattery(CAN_Speed speed = CAN_Speed::CAN_SPEED_500KBPS, const CAN_ID_Filter& filter = {});
+  CanBattery(CAN_Interface interface, CAN_Speed speed = CAN_Speed::CAN_SPEED_500KBPS,
+             const CAN_ID_Filter& filter = {});
 
   bool change_can_speed(CAN_Speed speed);
   void reset_can_speed();
 
-  void transmit_can_frame(const CAN_frame* frame) { transmit_can_frame_to_interface(frame, can_interface); }
+  // Battery frames are keep-alive unless the caller marks them, e.g. CAN_TX_SAFETY for contactor commands
+  void transmit_can_frame(const CAN_frame* frame, CAN_Tx_Priority priority = CAN_TX_PRIORITY_AUTO) {
+    transmit_can_frame_to_interface(
+        frame, can_interface,
+        priority == CAN_TX_PRIORITY_AUTO ? can_tx_priority_for(*frame, CAN_TX_KEEPALIVE) : priority);
+  }
+
+  using Transmitter::transmit_every;
+  // Send frame as it is every period_ms
+  void transmit_every(uint16_t period_ms, const CAN_frame* frame) {
+    transmit_every(period_ms, 1, [this, frame](unsigned long currentMillis) { transmit_can_frame(frame); });
+  }
 
   // Overload these in subclasses that also inherit IsoTp to receive ISO-TP events.
   virtual void on_isotp_can_tx(uint32_t /*can_id*/, uint8_t* /*can_data*/, uint8_t /*can_dlc*/) {}
@@ -59,25 +59,17 @@ void EcmpBattery::update_values() {
 
     datalayer_battery->status.temperature_max_dC = battery_highestTemperature * 10;
 
-    // Initialize min and max, lets find which cells are min and max!
-    uint16_t min_cell_mv_value = std::numeric_limits<uint16_t>::max();
-    uint16_t max_cell_mv_value = 0;
-    // Loop to find the min and max while ignoring zero values
-    for (uint8_t i = 0; i < datalayer_battery->info.number_of_cells; ++i) {
-      uint16_t voltage_mV = datalayer_battery->status.cell_voltages_mV[i];
-      if (voltage_mV != 0) {  // Skip unread values (0)
-        min_cell_mv_value = std::min(min_cell_mv_value, voltage_mV);
-        max_cell_mv_value = std::max(max_cell_mv_value, voltage_mV);
-      }
-    }
+    // Find which cells are min and max, skipping unread values (0)
+    Cell_Statistics cells = compute_cell_statistics(datalayer_battery->status.cell_voltages_mV,
+                                                    datalayer_battery->info.number_of_cells, 1);
     // If all array values are 0, reset min/max to 3700
-    if (min_cell_mv_value == std::numeric_limits<uint16_t>::max()) {
-      min_cell_mv_value = 3700;
-      max_cell_mv_value = 3700;
+    if (cells.valid_cells == 0) {
+      cells.min_mV = 3700;
+      cells.max_mV = 3700;
     }
 
-    datalayer_battery->status.cell_min_voltage_mV = min_cell_mv_value;
-    datalayer_battery->status.cell_max_voltage_mV = max_cell_mv_value;
+    datalayer_battery->status.cell_min_voltage_mV = cells.min_mV;
+    datalayer_battery->status.cell_max_voltage_mV = cells.max_mV;
   } else {  //Some variant of the 50/75kWh battery that is not using the eCMP CAN mappings.
     // For these batteries we need to use the OBD2 PID polled values
 
@@ -232,7 +224,7 @@ void EcmpBattery::update_values() {
   }
 }
 
-void EcmpBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void EcmpBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x2D4:  //MysteryVan 50/75kWh platform (TBMU 100ms periodic)
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -1168,7 +1160,7 @@ void EcmpBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-uint8_t checksum_calc(uint8_t counter, CAN_frame rx_frame) {
+uint8_t checksum_calc(uint8_t counter, const CAN_frame& rx_frame) {
   // Confirmed working on IDs 0F0,0F2,17B,31B,31D,31E,3A2(special),3A3,112,351
   // Sum of frame ID nibbles + Sum all nibbles of data bytes (frames 0–6 and high nibble of frame7)
   int sum = ((rx_frame.ID >> 8) & 0xF) + ((rx_frame.ID >> 4) & 0xF) + (rx_frame.ID & 0xF);
@@ -1185,12 +1177,19 @@ uint8_t checksum_calc(uint8_t counter, CAN_frame rx_frame) {
   return (0xF - sum) & 0xF;  // Masking with & 0xF ensures modulo 16
 }
 
-void EcmpBattery::transmit_can(unsigned long currentMillis) {
+void EcmpBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer_battery->info.number_of_cells = 108;
+  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
+  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
+  datalayer.system.status.battery_allows_contactor_closing = true;
 
   // Send 250ms diagnostic CAN Messages
-  if (currentMillis - previousMillis250 >= INTERVAL_250_MS) {
-    previousMillis250 = currentMillis;
-
+  transmit_every(INTERVAL_250_MS, 1, [this](unsigned long currentMillis) {
     //To be able to use the battery, isolation monitoring needs to be disabled
     //Failure to do this results in the contactors opening after 30 seconds with load
     if (UserRequestDisableIsoMonitoring) {
@@ -1658,12 +1657,9 @@ void EcmpBattery::transmit_can(unsigned long currentMillis) {
         }
       }
     }
-  }
-
+  });
   // Send 10ms periodic CAN Message simulating the car still being attached
-  if (currentMillis - previousMillis10 >= INTERVAL_10_MS) {
-    previousMillis10 = currentMillis;
-
+  transmit_every(INTERVAL_10_MS, 7, [this](unsigned long currentMillis) {
     counter_10ms = (counter_10ms + 1) % 16;
 
     if (datalayer.system.status.system_status == FAULT) {
@@ -1693,12 +1689,9 @@ void EcmpBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&ECMP_110);
     transmit_can_frame(&ECMP_114);
 #endif
-  }
-
+  });
   // Send 20ms periodic CAN Message simulating the car still being attached
-  if (currentMillis - previousMillis20 >= INTERVAL_20_MS) {
-    previousMillis20 = currentMillis;
-
+  transmit_every(INTERVAL_20_MS, 1, [this](unsigned long currentMillis) {
     if (datalayer.system.status.system_status == FAULT) {
       //Open contactors!
       ECMP_0F0.data.u8[1] = 0x00;
@@ -1711,11 +1704,9 @@ void EcmpBattery::transmit_can(unsigned long currentMillis) {
     ECMP_0F0.data.u8[7] = counter_20ms << 4 | checksum_calc(counter_20ms, ECMP_0F0);
 
     transmit_can_frame(&ECMP_0F0);  //VCU2_0F0
-  }
+  });
   // Send 50ms periodic CAN Message simulating the car still being attached
-  if (currentMillis - previousMillis50 >= INTERVAL_50_MS) {
-    previousMillis50 = currentMillis;
-
+  transmit_every(INTERVAL_50_MS, 2, [this](unsigned long currentMillis) {
     if (datalayer.system.status.system_status == FAULT) {
       //Make vehicle appear as in idle HV state. Useful for clearing DTCs
       ECMP_27A.data = {0x4F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
@@ -1725,11 +1716,9 @@ void EcmpBattery::transmit_can(unsigned long currentMillis) {
     }
     transmit_can_frame(&ECMP_230);  //OBC3_230
     transmit_can_frame(&ECMP_27A);  //VCU_BSI_Wakeup_27A
-  }
+  });
   // Send 100ms periodic CAN Message simulating the car still being attached
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 13, [this](unsigned long currentMillis) {
     counter_100ms = (counter_100ms + 1) % 16;
     counter_010 = (counter_010 + 1) % 8;
 
@@ -1846,18 +1835,15 @@ void EcmpBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&ECMP_351);
     transmit_can_frame(&ECMP_31D);
 #endif
-  }
+  });
   // Send 500ms periodic CAN Message simulating the car still being attached
-  if (currentMillis - previousMillis500 >= INTERVAL_500_MS) {
-    previousMillis500 = currentMillis;
+  transmit_every(INTERVAL_500_MS, 1, [this](unsigned long currentMillis) {
 #ifdef SIMULATE_ENTIRE_VEHICLE_ECMP
     transmit_can_frame(&ECMP_0AE);
 #endif
-  }
+  });
   // Send 1s CAN Message
-  if (currentMillis - previousMillis1000 >= INTERVAL_1_S) {
-    previousMillis1000 = currentMillis;
-
+  transmit_every(INTERVAL_1_S, 7, [this](unsigned long currentMillis) {
     //552 seems to be tracking time in byte 0-3 , distance in km in byte 4-6, temporal reset counter in byte 7
     ticks_552 = (ticks_552 + 10);
     ECMP_552.data.u8[0] = ((ticks_552 & 0xFF000000) >> 24);
@@ -1883,24 +1869,11 @@ void EcmpBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&ECMP_591);  //Not in all logs
     transmit_can_frame(&ECMP_794);  //Not in all logs
 #endif
-  }
+  });
   // Send 5s periodic CAN Message simulating the car still being attached
-  if (currentMillis - previousMillis5000 >= INTERVAL_5_S) {
-    previousMillis5000 = currentMillis;
+  transmit_every(INTERVAL_5_S, 1, [this](unsigned long currentMillis) {
 #ifdef SIMULATE_ENTIRE_VEHICLE_ECMP
     transmit_can_frame(&ECMP_55F);
 #endif
-  }
-}
-
-void EcmpBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer_battery->info.number_of_cells = 108;
-  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
-  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
-  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
-  datalayer.system.status.battery_allows_contactor_closing = true;
+  });
 }
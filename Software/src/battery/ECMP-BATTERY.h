@@ -10,21 +10,23 @@
 class EcmpBattery : public CanBattery {
  public:
   // Use this constructor for the second battery.
-  EcmpBattery(DATALAYER_BATTERY_TYPE* datalayer_ptr, CAN_Interface targetCan) : CanBattery(targetCan) {
+  EcmpBattery(DATALAYER_BATTERY_TYPE* datalayer_ptr, CAN_Interface targetCan)
+      : CanBattery(targetCan), renderer(datalayer_extended.stellantisECMP.get()) {
     datalayer_battery = datalayer_ptr;
     datalayer_ecmp = NULL;
   }
 
   // Use the default constructor to create the first or single battery.
-  EcmpBattery() {
+  EcmpBattery() : renderer(datalayer_extended.stellantisECMP.get()) {
     datalayer_battery = &datalayer.battery;
-    datalayer_ecmp = &datalayer_extended.stellantisECMP;
+    datalayer_ecmp = datalayer_extended.stellantisECMP.get();
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Stellantis ECMP battery";
 
   bool supports_clear_isolation() { return true; }
@@ -54,14 +56,6 @@ class EcmpBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 4250;
   static const int MIN_CELL_VOLTAGE_MV = 3280;
 
-  unsigned long previousMillis10 = 0;    //- will store last time a 10ms CAN Message was sent
-  unsigned long previousMillis20 = 0;    // will store last time a 20ms CAN Message was sent
-  unsigned long previousMillis50 = 0;    // will store last time a 50ms CAN Message was sent
-  unsigned long previousMillis100 = 0;   // will store last time a 100ms CAN Message was sent
-  unsigned long previousMillis250 = 0;   // will store last time a 250ms CAN Message was sent
-  unsigned long previousMillis500 = 0;   // will store last time a 500ms CAN Message was sent
-  unsigned long previousMillis1000 = 0;  // will store last time a 1000ms CAN Message was sent
-  unsigned long previousMillis5000 = 0;  // will store last time a 1000ms CAN Message was sent
   CAN_frame ECMP_010 = {.FD = false, .ext_ID = false, .DLC = 1, .ID = 0x010, .data = {0xB4}};  //VCU_BCM_Crash 100ms
   CAN_frame ECMP_0F0 = {.FD = false,  //VCU2_0F0 (Common) 20ms periodic (Perfectly emulated in Battery-Emulator)
                         .ext_ID = false,
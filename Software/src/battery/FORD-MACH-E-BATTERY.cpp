@@ -38,27 +38,12 @@ void FordMachEBattery::update_values() {
     datalayer.battery.status.max_charge_power_W = datalayer.battery.status.override_charge_power_W;
   }
 
-  maximum_cellvoltage_mV = datalayer.battery.status.cell_voltages_mV[0];
-  minimum_cellvoltage_mV = datalayer.battery.status.cell_voltages_mV[0];
-
-  // Loop through the array to find min and max cellvoltages, ignoring 0 values
-  for (uint8_t i = 0; i < datalayer.battery.info.number_of_cells; i++) {
-    if (datalayer.battery.status.cell_voltages_mV[i] > 1000) {  // Ignore unavailable values
-      if (datalayer.battery.status.cell_voltages_mV[i] < minimum_cellvoltage_mV) {
-        minimum_cellvoltage_mV = datalayer.battery.status.cell_voltages_mV[i];
-      }
-      if (datalayer.battery.status.cell_voltages_mV[i] > maximum_cellvoltage_mV) {
-        maximum_cellvoltage_mV = datalayer.battery.status.cell_voltages_mV[i];
-      }
-    }
-  }
-
-  if (maximum_cellvoltage_mV > 0) {
-    datalayer.battery.status.cell_max_voltage_mV = maximum_cellvoltage_mV;
-  }
-
-  if (minimum_cellvoltage_mV > 0) {
-    datalayer.battery.status.cell_min_voltage_mV = minimum_cellvoltage_mV;
+  // Find min and max cellvoltages, ignoring unavailable values at or below 1000mV
+  Cell_Statistics cells =
+      compute_cell_statistics(datalayer.battery.status.cell_voltages_mV, datalayer.battery.info.number_of_cells, 1001);
+  if (cells.valid_cells > 0) {
+    datalayer.battery.status.cell_max_voltage_mV = cells.max_mV;
+    datalayer.battery.status.cell_min_voltage_mV = cells.min_mV;
   }
 
   // Initialize highest and lowest to the first element
@@ -112,27 +97,25 @@ void FordMachEBattery::update_values() {
   }
 
   //Update More Battery Info page
-  datalayer_extended.fordMachE.pid_hvb_temp = pid_hvb_temp;
-  datalayer_extended.fordMachE.pid_hvb_voltage = pid_hvb_voltage;
-  datalayer_extended.fordMachE.pid_hvb_soc = pid_hvb_soc;
-  datalayer_extended.fordMachE.pid_hvb_soh = pid_hvb_soh;
-  datalayer_extended.fordMachE.pid_hvb_contactor_status = pid_hvb_contactor_status;
-  datalayer_extended.fordMachE.pid_hvb_contactor_positive_leak_voltage = pid_hvb_contactor_positive_leak_voltage;
-  datalayer_extended.fordMachE.pid_hvb_contactor_negative_leak_voltage = pid_hvb_contactor_negative_leak_voltage;
-  datalayer_extended.fordMachE.pid_hvb_contactor_positive_voltage = pid_hvb_contactor_positive_voltage;
-  datalayer_extended.fordMachE.pid_hvb_contactor_negative_voltage = pid_hvb_contactor_negative_voltage;
-  datalayer_extended.fordMachE.pid_hvb_contactor_positive_bus_leak_resistance =
-      pid_hvb_contactor_positive_bus_leak_resistance;
-  datalayer_extended.fordMachE.pid_hvb_contactor_negative_bus_leak_resistance =
-      pid_hvb_contactor_negative_bus_leak_resistance;
-  datalayer_extended.fordMachE.pid_hvb_contactor_overall_leak_resistance = pid_hvb_contactor_overall_leak_resistance;
-  datalayer_extended.fordMachE.pid_hvb_contactor_open_leak_resistance = pid_hvb_contactor_open_leak_resistance;
-  datalayer_extended.fordMachE.pid_hvb_calendar_age_months = pid_hvb_calendar_age_months;
-  datalayer_extended.fordMachE.pid_battery_capacity_ah = pid_battery_capacity_ah;
-  datalayer_extended.fordMachE.pid_maintenance_rebalance_status = pid_maintenance_rebalance_status;
+  datalayer_fordmache->pid_hvb_temp = pid_hvb_temp;
+  datalayer_fordmache->pid_hvb_voltage = pid_hvb_voltage;
+  datalayer_fordmache->pid_hvb_soc = pid_hvb_soc;
+  datalayer_fordmache->pid_hvb_soh = pid_hvb_soh;
+  datalayer_fordmache->pid_hvb_contactor_status = pid_hvb_contactor_status;
+  datalayer_fordmache->pid_hvb_contactor_positive_leak_voltage = pid_hvb_contactor_positive_leak_voltage;
+  datalayer_fordmache->pid_hvb_contactor_negative_leak_voltage = pid_hvb_contactor_negative_leak_voltage;
+  datalayer_fordmache->pid_hvb_contactor_positive_voltage = pid_hvb_contactor_positive_voltage;
+  datalayer_fordmache->pid_hvb_contactor_negative_voltage = pid_hvb_contactor_negative_voltage;
+  datalayer_fordmache->pid_hvb_contactor_positive_bus_leak_resistance = pid_hvb_contactor_positive_bus_leak_resistance;
+  datalayer_fordmache->pid_hvb_contactor_negative_bus_leak_resistance = pid_hvb_contactor_negative_bus_leak_resistance;
+  datalayer_fordmache->pid_hvb_contactor_overall_leak_resistance = pid_hvb_contactor_overall_leak_resistance;
+  datalayer_fordmache->pid_hvb_contactor_open_leak_resistance = pid_hvb_contactor_open_leak_resistance;
+  datalayer_fordmache->pid_hvb_calendar_age_months = pid_hvb_calendar_age_months;
+  datalayer_fordmache->pid_battery_capacity_ah = pid_battery_capacity_ah;
+  datalayer_fordmache->pid_maintenance_rebalance_status = pid_maintenance_rebalance_status;
 }
 
-void FordMachEBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void FordMachEBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {  //These frames are transmitted by the battery
     case 0x07a:           //10ms
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -408,11 +391,19 @@ void FordMachEBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void FordMachEBattery::transmit_can(unsigned long currentMillis) {
-  // Send 20ms CAN Message
-  if (currentMillis - previousMillis20 >= INTERVAL_20_MS) {
-    previousMillis20 = currentMillis;
+void FordMachEBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.battery.info.total_capacity_Wh = 88000;  //Start in 88kWh mode, update later
+  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_96S_DV;  //Startup in extreme ends
+  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_90S_DV;
+  datalayer.system.status.battery_allows_contactor_closing = true;
 
+  // Send 20ms CAN Message
+  transmit_every(INTERVAL_20_MS, 1, [this](unsigned long currentMillis) {
     if (datalayer.system.status.system_status == FAULT) {
       FORD_25B.data.u8[2] = 0x01;
     } else {
@@ -426,12 +417,9 @@ void FordMachEBattery::transmit_can(unsigned long currentMillis) {
     //transmit_can_frame(&FORD_217); Not needed for contactor closing
     //transmit_can_frame(&FORD_442); Not needed for contactor closing
     */
-  }
-
+  });
   // Send 30ms CAN Message
-  if (currentMillis - previousMillis30 >= INTERVAL_30_MS) {
-    previousMillis30 = currentMillis;
-
+  transmit_every(INTERVAL_30_MS, 1, [this](unsigned long currentMillis) {
     //Full vehicle emulation, not required
     /*
 
@@ -483,19 +471,15 @@ void FordMachEBattery::transmit_can(unsigned long currentMillis) {
     //transmit_can_frame(&FORD_7F); Not needed for contactor closing
     transmit_can_frame(&FORD_200);
     */
-  }
+  });
   // Send 50ms CAN Message
-  if (currentMillis - previousMillis50 >= INTERVAL_50_MS) {
-    previousMillis50 = currentMillis;
+  transmit_every(INTERVAL_50_MS, 1, [this](unsigned long currentMillis) {
     //transmit_can_frame(&FORD_42C); Not needed for contactor closing
     //transmit_can_frame(&FORD_42F); Not needed for contactor closing
     //transmit_can_frame(&FORD_43D);
-  }
-
+  });
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 13, [this](unsigned long currentMillis) {
     transmit_can_frame(&FORD_185);  // Required to close contactors
 
     //Full vehicle emulation, not required
@@ -516,12 +500,9 @@ void FordMachEBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(
         &FORD_176);  //This message actually has checksum/counter, but it seems to close contactors without those
 */
-  }
-
+  });
   // Send 250ms CAN Message
-  if (currentMillis - previousMillis250 >= INTERVAL_250_MS) {
-    previousMillis250 = currentMillis;
-
+  transmit_every(INTERVAL_250_MS, 1, [this](unsigned long currentMillis) {
     //transmit_can_frame(&FORD_PID_REQUEST_7DF); 12V battery voltage request
 
     // Update current poll from the array
@@ -532,11 +513,9 @@ void FordMachEBattery::transmit_can(unsigned long currentMillis) {
     FORD_PID_REQUEST_7E4.data.u8[3] = (uint8_t)(currentpoll & 0x00FF);
 
     transmit_can_frame(&FORD_PID_REQUEST_7E4);
-  }
-
+  });
   // Send 1s CAN Message
-  if (currentMillis - previousMillis1000 >= INTERVAL_1_S) {
-    previousMillis1000 = currentMillis;
+  transmit_every(INTERVAL_1_S, 3, [this](unsigned long currentMillis) {
     //Full vehicle emulation, not required
     /*
     transmit_can_frame(&FORD_3C3);
@@ -547,17 +526,5 @@ void FordMachEBattery::transmit_can(unsigned long currentMillis) {
       transmit_can_frame(&FORD_DTC_RESET);
       UserRequestDTCreset = false;  //Reset the flag after sending the DTC reset command
     }
-  }
-}
-
-void FordMachEBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.battery.info.total_capacity_Wh = 88000;  //Start in 88kWh mode, update later
-  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
-  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_96S_DV;  //Startup in extreme ends
-  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_90S_DV;
-  datalayer.system.status.battery_allows_contactor_closing = true;
+  });
 }
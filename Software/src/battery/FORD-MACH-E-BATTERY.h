@@ -6,10 +6,15 @@
 
 class FordMachEBattery : public CanBattery {
  public:
+  FordMachEBattery() : renderer(datalayer_extended.fordMachE.get()) {
+    datalayer_fordmache = datalayer_extended.fordMachE.get();
+  }
+
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Ford Mustang Mach-E battery";
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
 
@@ -18,6 +23,7 @@ class FordMachEBattery : public CanBattery {
 
  private:
   FordMachEHtmlRenderer renderer;
+  DATALAYER_INFO_FORD_MACH_E* datalayer_fordmache;
   bool UserRequestDTCreset = false;
   //90S NMC
   static const int MAX_PACK_VOLTAGE_90S_DV = 3902;
@@ -48,14 +54,6 @@ class FordMachEBattery : public CanBattery {
   static const int MAX_CHARGE_POWER_WHEN_TOPBALANCING_W = 200;  // W, what power to allow for top balancing battery
   static const int FLOAT_START_MV = 20;  // mV, how many mV under overvoltage to start float charging
 
-  unsigned long previousMillis20 = 0;    // will store last time a 20ms CAN Message was send
-  unsigned long previousMillis30 = 0;    // will store last time a 10ms CAN Message was send
-  unsigned long previousMillis50 = 0;    // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis100 = 0;   // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis250 = 0;   // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis1000 = 0;  // will store last time a 1s CAN Message was send
-  unsigned long previousMillis10s = 0;   // will store last time a 10s CAN Message was send
-
   int16_t cell_temperature[6] = {0};
   int16_t maximum_temperature = 0;
   int16_t minimum_temperature = 0;
@@ -63,8 +61,6 @@ class FordMachEBattery : public CanBattery {
   uint16_t battery_soh = 99;
   uint16_t battery_voltage = 370;
   int16_t battery_current = 0;
-  uint16_t maximum_cellvoltage_mV = 3700;
-  uint16_t minimum_cellvoltage_mV = 3700;
 
   uint8_t counter_30ms = 0;
   uint8_t counter_8_30ms = 0;
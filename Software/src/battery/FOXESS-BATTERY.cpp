@@ -70,7 +70,7 @@ void FoxessBattery::
   }
 }
 
-void FoxessBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void FoxessBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x1872:  //BMS_Limits
       datalayer.battery.info.max_design_voltage_dV = (uint16_t)(rx_frame.data.u8[1] << 8 | rx_frame.data.u8[0]);
@@ -399,11 +399,20 @@ void FoxessBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void FoxessBattery::transmit_can(unsigned long currentMillis) {
-  // Send 500ms CAN Message
-  if (currentMillis - previousMillis500 >= INTERVAL_500_MS) {
-    previousMillis500 = currentMillis;
+void FoxessBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.battery.info.number_of_cells = 0;  //Startup with no cells, populates later when we know packsize
+  datalayer.battery.info.chemistry = LFP;
+  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
+  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
+  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  datalayer.system.status.battery_allows_contactor_closing = true;
 
+  // Send 500ms CAN Message
+  transmit_every(INTERVAL_500_MS, 1, [this](unsigned long currentMillis) {
     switch (statemachine_polling) {
       case 0:  //0.5s
         FOX_1871.data.u8[0] = 0x01;
@@ -565,18 +574,5 @@ void FoxessBattery::transmit_can(unsigned long currentMillis) {
     }
 
     statemachine_polling = (statemachine_polling + 1) % 12;
-  }
-}
-
-void FoxessBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.battery.info.number_of_cells = 0;  //Startup with no cells, populates later when we know packsize
-  datalayer.battery.info.chemistry = LFP;
-  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
-  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
-  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
-  datalayer.system.status.battery_allows_contactor_closing = true;
+  });
 }
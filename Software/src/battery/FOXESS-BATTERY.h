@@ -5,9 +5,10 @@
 class FoxessBattery : public CanBattery {
  public:
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "FoxESS HV2600/ECS4100 OEM battery";
 
  private:
@@ -17,8 +18,6 @@ class FoxessBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 3800;  //LiFePO4 Prismaticc Cell
   static const int MIN_CELL_VOLTAGE_MV = 2700;  //LiFePO4 Prismatic Cell
 
-  unsigned long previousMillis500 = 0;  // will store last time a 500ms CAN Message was send
-
   CAN_frame FOX_1871 = {.FD = false,  //Inverter request data from battery. Content varies depending on state
                         .ext_ID = true,
                         .DLC = 8,
@@ -126,7 +126,7 @@ void GeelyGeometryCBattery::update_values() {
   datalayer_geometryc->unknown8 = poll_unknown8;
 }
 
-bool is_message_corrupt(CAN_frame* rx_frame) {
+bool is_message_corrupt(const CAN_frame* rx_frame) {
   uint8_t crc = 0xFF;  // Initial value
   for (uint8_t j = 0; j < 7; j++) {
     crc = crctable_geely_geometryC[crc ^ rx_frame->data.u8[j]];
@@ -135,7 +135,7 @@ bool is_message_corrupt(CAN_frame* rx_frame) {
   return crc != rx_frame->data.u8[7];
 }
 
-void GeelyGeometryCBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void GeelyGeometryCBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x0B0:  //10ms
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -439,7 +439,7 @@ void GeelyGeometryCBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-uint8_t calc_crc8_geely(CAN_frame* rx_frame) {
+uint8_t calc_crc8_geely(const CAN_frame* rx_frame) {
   uint8_t crc = 0xFF;  // Initial value
 
   for (uint8_t j = 0; j < 7; j++) {
@@ -449,11 +449,19 @@ uint8_t calc_crc8_geely(CAN_frame* rx_frame) {
   return crc ^ 0xFF;  // Final XOR
 }
 
-void GeelyGeometryCBattery::transmit_can(unsigned long currentMillis) {
-  // Send 10ms CAN Message
-  if (currentMillis - previousMillis10 >= INTERVAL_10_MS) {
-    previousMillis10 = currentMillis;
+void GeelyGeometryCBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.system.status.battery_allows_contactor_closing = true;
+  datalayer_battery->info.number_of_cells = 102;                           //70kWh pack has 102S, startup in this mode
+  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_70_DV;  //Startup in extreme ends
+  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_53_DV;  //Before pack size determined
+  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
 
+  // Send 10ms CAN Message
+  transmit_every(INTERVAL_10_MS, 9, [this](unsigned long currentMillis) {
     GEELY_191.data.u8[6] = ((GEELY_191.data.u8[6] & 0xF0) | counter_10ms);
     GEELY_191.data.u8[7] = calc_crc8_geely(&GEELY_191);
     GEELY_0A6.data.u8[6] = ((GEELY_0A6.data.u8[6] & 0xF0) | counter_10ms);
@@ -482,10 +490,8 @@ void GeelyGeometryCBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&GEELY_1A5);
     transmit_can_frame(&GEELY_220);  //CONFIRMED MANDATORY! OBC message
     transmit_can_frame(&GEELY_0E0);
-  }
-  if (currentMillis - previousMillis20 >= INTERVAL_20_MS) {
-    previousMillis20 = currentMillis;
-
+  });
+  transmit_every(INTERVAL_20_MS, 5, [this](unsigned long currentMillis) {
     GEELY_145.data.u8[6] = ((GEELY_145.data.u8[6] & 0xF0) | counter_10ms);
     GEELY_145.data.u8[7] = calc_crc8_geely(&GEELY_145);
     GEELY_150.data.u8[6] = ((GEELY_150.data.u8[6] & 0xF0) | counter_10ms);
@@ -498,10 +504,8 @@ void GeelyGeometryCBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&GEELY_0FA);  //Might be unnecessary, not in workshop manual
     transmit_can_frame(&GEELY_197);  //Might be unnecessary, not in workshop manual
     transmit_can_frame(&GEELY_150);
-  }
-  if (currentMillis - previousMillis50 >= INTERVAL_50_MS) {
-    previousMillis50 = currentMillis;
-
+  });
+  transmit_every(INTERVAL_50_MS, 6, [this](unsigned long currentMillis) {
     GEELY_1A3.data.u8[6] = ((GEELY_1A3.data.u8[6] & 0xF0) | counter_10ms);
     GEELY_1A3.data.u8[7] = calc_crc8_geely(&GEELY_1A3);
     GEELY_0A8.data.u8[6] = ((GEELY_0A8.data.u8[6] & 0xF0) | counter_10ms);
@@ -516,11 +520,9 @@ void GeelyGeometryCBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&GEELY_0A8);  //CONFIRMED MANDATORY! IPU message
     transmit_can_frame(&GEELY_1F2);  //Might be unnecessary, not in manual
     transmit_can_frame(&GEELY_1A6);  //Might be unnecessary, not in manual
-  }
+  });
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 2, [this](unsigned long currentMillis) {
     GEELY_0A8.data.u8[6] = ((GEELY_0A8.data.u8[6] & 0x0F) | (counter_10ms << 4));  //unique bitshift
     GEELY_0A8.data.u8[7] = calc_crc8_geely(&GEELY_0A8);
 
@@ -529,11 +531,9 @@ void GeelyGeometryCBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&GEELY_222);  //CONFIRMED MANDATORY! OBC message
     //transmit_can_frame(&GEELY_2D2);  //Might be unnecessary, seat info
     transmit_can_frame(&GEELY_292);  //CONFIRMED MANDATORY! T-BOX
-  }
+  });
   // Send 200ms CAN Message
-  if (currentMillis - previousMillis200 >= INTERVAL_200_MS) {
-    previousMillis200 = currentMillis;
-
+  transmit_every(INTERVAL_200_MS, 1, [this](unsigned long currentMillis) {
     switch (poll_pid) {
       case POLL_SOC:
         GEELY_POLL.data.u8[2] = (uint8_t)(POLL_SOC >> 8);
@@ -646,17 +646,5 @@ void GeelyGeometryCBattery::transmit_can(unsigned long currentMillis) {
     } else {
       transmit_can_frame(&GEELY_POLL);
     }
-  }
-}
-
-void GeelyGeometryCBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.system.status.battery_allows_contactor_closing = true;
-  datalayer_battery->info.number_of_cells = 102;                           //70kWh pack has 102S, startup in this mode
-  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_70_DV;  //Startup in extreme ends
-  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_53_DV;  //Before pack size determined
-  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  });
 }
@@ -9,21 +9,22 @@ class GeelyGeometryCBattery : public CanBattery {
   // Use this constructor for the second battery.
   GeelyGeometryCBattery(DATALAYER_BATTERY_TYPE* datalayer_ptr, DATALAYER_INFO_GEELY_GEOMETRY_C* extended,
                         CAN_Interface targetCan)
-      : CanBattery(targetCan) {
+      : CanBattery(targetCan), renderer(datalayer_extended.geometryC.get()) {
     datalayer_battery = datalayer_ptr;
 
     battery_voltage = 0;
   }
   // Use the default constructor to create the first or single battery.
-  GeelyGeometryCBattery() {
+  GeelyGeometryCBattery() : renderer(datalayer_extended.geometryC.get()) {
     datalayer_battery = &datalayer.battery;
-    datalayer_geometryc = &datalayer_extended.geometryC;
+    datalayer_geometryc = datalayer_extended.geometryC.get();
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Geely Geometry C";
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
@@ -209,11 +210,6 @@ class GeelyGeometryCBattery : public CanBattery {
   uint8_t counter_20ms = 0;
   uint8_t counter_50ms = 0;
   uint8_t counter_100ms = 0;
-  unsigned long previousMillis10 = 0;   // will store last time a 10ms CAN Message was sent
-  unsigned long previousMillis20 = 0;   // will store last time a 20ms CAN Message was sent
-  unsigned long previousMillis50 = 0;   // will store last time a 50ms CAN Message was sent
-  unsigned long previousMillis100 = 0;  // will store last time a 100ms CAN Message was sent
-  unsigned long previousMillis200 = 0;  // will store last time a 200ms CAN Message was sent
   uint8_t mux = 0;
   uint16_t battery_voltage = 3700;
   int16_t maximum_temperature = 0;
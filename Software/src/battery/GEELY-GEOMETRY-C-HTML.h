@@ -7,51 +7,47 @@
 
 class GeelyGeometryCHtmlRenderer : public BatteryHtmlRenderer {
  public:
+  GeelyGeometryCHtmlRenderer(DATALAYER_INFO_GEELY_GEOMETRY_C* dl) : geometryc_dl(dl) {}
+
   String get_status_html() {
     String content;
     char readableSerialNumber[29];  // One extra space for null terminator
-    memcpy(readableSerialNumber, datalayer_extended.geometryC.BatterySerialNumber,
-           sizeof(datalayer_extended.geometryC.BatterySerialNumber));
+    memcpy(readableSerialNumber, geometryc_dl->BatterySerialNumber, sizeof(geometryc_dl->BatterySerialNumber));
     readableSerialNumber[28] = '\0';   // Null terminate the string
     char readableSoftwareVersion[17];  // One extra space for null terminator
-    memcpy(readableSoftwareVersion, datalayer_extended.geometryC.BatterySoftwareVersion,
-           sizeof(datalayer_extended.geometryC.BatterySoftwareVersion));
+    memcpy(readableSoftwareVersion, geometryc_dl->BatterySoftwareVersion, sizeof(geometryc_dl->BatterySoftwareVersion));
     readableSoftwareVersion[16] = '\0';  // Null terminate the string
     char readableHardwareVersion[17];    // One extra space for null terminator
-    memcpy(readableHardwareVersion, datalayer_extended.geometryC.BatteryHardwareVersion,
-           sizeof(datalayer_extended.geometryC.BatteryHardwareVersion));
+    memcpy(readableHardwareVersion, geometryc_dl->BatteryHardwareVersion, sizeof(geometryc_dl->BatteryHardwareVersion));
     readableHardwareVersion[16] = '\0';  // Null terminate the string
     content += "<h4>Serial number: " + String(readableSoftwareVersion) + "</h4>";
     content += "<h4>Software version: " + String(readableSerialNumber) + "</h4>";
     content += "<h4>Hardware version: " + String(readableHardwareVersion) + "</h4>";
-    content += "<h4>SOC display: " + String(datalayer_extended.geometryC.soc) + "ppt</h4>";
-    content += "<h4>CC2 voltage: " + String(datalayer_extended.geometryC.CC2voltage) + "mV</h4>";
-    content += "<h4>Cell max voltage number: " + String(datalayer_extended.geometryC.cellMaxVoltageNumber) + "</h4>";
-    content += "<h4>Cell min voltage number: " + String(datalayer_extended.geometryC.cellMinVoltageNumber) + "</h4>";
-    content += "<h4>Cell total amount: " + String(datalayer_extended.geometryC.cellTotalAmount) + "S</h4>";
-    content += "<h4>Specificial Voltage: " + String(datalayer_extended.geometryC.specificialVoltage) + "dV</h4>";
-    content += "<h4>Unknown1: " + String(datalayer_extended.geometryC.unknown1) + "</h4>";
-    content += "<h4>Raw SOC max: " + String(datalayer_extended.geometryC.rawSOCmax) + "</h4>";
-    content += "<h4>Raw SOC min: " + String(datalayer_extended.geometryC.rawSOCmin) + "</h4>";
-    content += "<h4>Unknown4: " + String(datalayer_extended.geometryC.unknown4) + "</h4>";
-    content += "<h4>Capacity module max: " + String((datalayer_extended.geometryC.capModMax / 10)) + "Ah</h4>";
-    content += "<h4>Capacity module min: " + String((datalayer_extended.geometryC.capModMin / 10)) + "Ah</h4>";
-    content += "<h4>Unknown7: " + String(datalayer_extended.geometryC.unknown7) + "</h4>";
-    content += "<h4>Unknown8: " + String(datalayer_extended.geometryC.unknown8) + "</h4>";
-    content +=
-        "<h4>Module 1 temperature: " + String(datalayer_extended.geometryC.ModuleTemperatures[0]) + " &deg;C</h4>";
-    content +=
-        "<h4>Module 2 temperature: " + String(datalayer_extended.geometryC.ModuleTemperatures[1]) + " &deg;C</h4>";
-    content +=
-        "<h4>Module 3 temperature: " + String(datalayer_extended.geometryC.ModuleTemperatures[2]) + " &deg;C</h4>";
-    content +=
-        "<h4>Module 4 temperature: " + String(datalayer_extended.geometryC.ModuleTemperatures[3]) + " &deg;C</h4>";
-    content +=
-        "<h4>Module 5 temperature: " + String(datalayer_extended.geometryC.ModuleTemperatures[4]) + " &deg;C</h4>";
-    content +=
-        "<h4>Module 6 temperature: " + String(datalayer_extended.geometryC.ModuleTemperatures[5]) + " &deg;C</h4>";
+    content += "<h4>SOC display: " + String(geometryc_dl->soc) + "ppt</h4>";
+    content += "<h4>CC2 voltage: " + String(geometryc_dl->CC2voltage) + "mV</h4>";
+    content += "<h4>Cell max voltage number: " + String(geometryc_dl->cellMaxVoltageNumber) + "</h4>";
+    content += "<h4>Cell min voltage number: " + String(geometryc_dl->cellMinVoltageNumber) + "</h4>";
+    content += "<h4>Cell total amount: " + String(geometryc_dl->cellTotalAmount) + "S</h4>";
+    content += "<h4>Specificial Voltage: " + String(geometryc_dl->specificialVoltage) + "dV</h4>";
+    content += "<h4>Unknown1: " + String(geometryc_dl->unknown1) + "</h4>";
+    content += "<h4>Raw SOC max: " + String(geometryc_dl->rawSOCmax) + "</h4>";
+    content += "<h4>Raw SOC min: " + String(geometryc_dl->rawSOCmin) + "</h4>";
+    content += "<h4>Unknown4: " + String(geometryc_dl->unknown4) + "</h4>";
+    content += "<h4>Capacity module max: " + String((geometryc_dl->capModMax / 10)) + "Ah</h4>";
+    content += "<h4>Capacity module min: " + String((geometryc_dl->capModMin / 10)) + "Ah</h4>";
+    content += "<h4>Unknown7: " + String(geometryc_dl->unknown7) + "</h4>";
+    content += "<h4>Unknown8: " + String(geometryc_dl->unknown8) + "</h4>";
+    content += "<h4>Module 1 temperature: " + String(geometryc_dl->ModuleTemperatures[0]) + " &deg;C</h4>";
+    content += "<h4>Module 2 temperature: " + String(geometryc_dl->ModuleTemperatures[1]) + " &deg;C</h4>";
+    content += "<h4>Module 3 temperature: " + String(geometryc_dl->ModuleTemperatures[2]) + " &deg;C</h4>";
+    content += "<h4>Module 4 temperature: " + String(geometryc_dl->ModuleTemperatures[3]) + " &deg;C</h4>";
+    content += "<h4>Module 5 temperature: " + String(geometryc_dl->ModuleTemperatures[4]) + " &deg;C</h4>";
+    content += "<h4>Module 6 temperature: " + String(geometryc_dl->ModuleTemperatures[5]) + " &deg;C</h4>";
     return content;
   }
+
+ private:
+  DATALAYER_INFO_GEELY_GEOMETRY_C* geometryc_dl;
 };
 
 #endif
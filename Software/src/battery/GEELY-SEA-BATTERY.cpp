@@ -13,47 +13,47 @@ void GeelySeaBattery::
     update_values() {  //This function maps all the values fetched via CAN to the correct parameters used for the inverter
 
   // Update requests from webserver datalayer
-  if (datalayer_extended.GeelySEA.UserRequestDTCreset) {
+  if (datalayer_geelysea->UserRequestDTCreset) {
     pause_polling_seconds = 10;
     transmit_can_frame(&SEA_DTC_Erase);  //Send global DTC erase command
-    datalayer_extended.GeelySEA.UserRequestDTCreset = false;
+    datalayer_geelysea->UserRequestDTCreset = false;
   }
-  if (datalayer_extended.GeelySEA.UserRequestBECMecuReset) {
+  if (datalayer_geelysea->UserRequestBECMecuReset) {
     pause_polling_seconds = 10;
     transmit_can_frame(&SEA_BECM_ECUreset);  //Send BECM ecu reset command
-    datalayer_extended.GeelySEA.UserRequestBECMecuReset = false;
+    datalayer_geelysea->UserRequestBECMecuReset = false;
   }
-  if (datalayer_extended.GeelySEA.UserRequestDTCreadout) {
+  if (datalayer_geelysea->UserRequestDTCreadout) {
     pause_polling_seconds = 10;
     DTC_readout_in_progress = true;
     transmit_can_frame(&SEA_DTC_Req);  //Send DTC readout command
-    datalayer_extended.GeelySEA.DTCcount = 0;
-    datalayer_extended.GeelySEA.UserRequestDTCreadout = false;
+    datalayer_geelysea->DTCcount = 0;
+    datalayer_geelysea->UserRequestDTCreadout = false;
   }
-  if (datalayer_extended.GeelySEA.UserRequestCrashReset) {
+  if (datalayer_geelysea->UserRequestCrashReset) {
     pause_polling_seconds = 10;
     transmit_can_frame(&SEA_StartDiag);  //Start sequene to reset crash status
-    datalayer_extended.GeelySEA.UserRequestCrashReset = false;
+    datalayer_geelysea->UserRequestCrashReset = false;
   }
 
   datalayer.battery.status.voltage_dV = pack_voltage_dV;
 
   datalayer.battery.status.current_dA = -pack_current_dA;
 
-  if (datalayer_extended.GeelySEA.soc_bms > 0) {
-    datalayer.battery.status.real_soc = datalayer_extended.GeelySEA.soc_bms;
+  if (datalayer_geelysea->soc_bms > 0) {
+    datalayer.battery.status.real_soc = datalayer_geelysea->soc_bms;
   }
 
-  if (datalayer_extended.GeelySEA.soh_bms > 0) {
-    datalayer.battery.status.soh_pptt = datalayer_extended.GeelySEA.soh_bms;
+  if (datalayer_geelysea->soh_bms > 0) {
+    datalayer.battery.status.soh_pptt = datalayer_geelysea->soh_bms;
   }
 
-  if (datalayer_extended.GeelySEA.CellTempHighest > 0) {
-    datalayer.battery.status.temperature_max_dC = ((datalayer_extended.GeelySEA.CellTempHighest / 100.0) - 50.0) * 10;
+  if (datalayer_geelysea->CellTempHighest > 0) {
+    datalayer.battery.status.temperature_max_dC = ((datalayer_geelysea->CellTempHighest / 100.0) - 50.0) * 10;
   }
 
-  if (datalayer_extended.GeelySEA.CellTempLowest > 0) {
-    datalayer.battery.status.temperature_min_dC = ((datalayer_extended.GeelySEA.CellTempLowest / 100.0) - 50.0) * 10;
+  if (datalayer_geelysea->CellTempLowest > 0) {
+    datalayer.battery.status.temperature_min_dC = ((datalayer_geelysea->CellTempLowest / 100.0) - 50.0) * 10;
   }
 
   datalayer.battery.status.remaining_capacity_Wh = static_cast<uint32_t>(
@@ -92,16 +92,16 @@ void GeelySeaBattery::
   }
 
   /* Check safeties */
-  if (datalayer_extended.GeelySEA.BECMsupplyVoltage > 0) {
-    if (datalayer_extended.GeelySEA.BECMsupplyVoltage < 11800) {  // 11.8 V
-      set_event(EVENT_12V_LOW, (datalayer_extended.GeelySEA.BECMsupplyVoltage / 10));
+  if (datalayer_geelysea->BECMsupplyVoltage > 0) {
+    if (datalayer_geelysea->BECMsupplyVoltage < 11800) {  // 11.8 V
+      set_event(EVENT_12V_LOW, (datalayer_geelysea->BECMsupplyVoltage / 10));
     } else {
       clear_event(EVENT_12V_LOW);
     }
   }
 }
 
-void GeelySeaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void GeelySeaBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x53:  //100ms
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -225,7 +225,7 @@ void GeelySeaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       if (DTC_readout_in_progress) {
 
         if ((rx_frame.data.u8[0] == 0x10) && (rx_frame.data.u8[2] == 0x59) && (rx_frame.data.u8[3] == 0x03)) {
-          datalayer_extended.GeelySEA.DTCcount = ((rx_frame.data.u8[1] - 2) / 4);
+          datalayer_geelysea->DTCcount = ((rx_frame.data.u8[1] - 2) / 4);
           transmit_can_frame(&SEA_Flowcontrol);
           //DTC #1 will be in byte 4-5-6-7 (last byte is if it is permanent or intermittent)
           DTC_readout_in_progress = false;
@@ -234,9 +234,9 @@ void GeelySeaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
         if ((rx_frame.data.u8[1] == 0x59) &&
             (rx_frame.data.u8[2] == 0x03)) {  // Response frame for DTC with 0 or 1 code
           if (rx_frame.data.u8[0] != 0x02) {
-            datalayer_extended.GeelySEA.DTCcount = 1;
+            datalayer_geelysea->DTCcount = 1;
           } else {
-            datalayer_extended.GeelySEA.DTCcount = 0;
+            datalayer_geelysea->DTCcount = 0;
           }
           DTC_readout_in_progress = false;
         }
@@ -260,40 +260,40 @@ void GeelySeaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
         if (pause_polling_seconds == 0) {  //Do not update values if DTC action is ongoing
           switch (reply_poll) {
             case POLL_BECMsupplyVoltage:
-              datalayer_extended.GeelySEA.BECMsupplyVoltage = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
+              datalayer_geelysea->BECMsupplyVoltage = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
               break;
             case POLL_HV_Voltage:
-              datalayer_extended.GeelySEA.BECMBatteryVoltage = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
+              datalayer_geelysea->BECMBatteryVoltage = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
               break;
             case POLL_CrashStatus:
-              datalayer_extended.GeelySEA.CrashStatus = rx_frame.data.u8[4];
+              datalayer_geelysea->CrashStatus = rx_frame.data.u8[4];
               break;
             case POLL_SOC:
-              datalayer_extended.GeelySEA.soc_bms = ((rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5]) / 5;
+              datalayer_geelysea->soc_bms = ((rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5]) / 5;
               break;
             case POLL_SOH:
-              datalayer_extended.GeelySEA.soh_bms = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
+              datalayer_geelysea->soh_bms = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
               break;
             case POLL_HighestCellTemp:
-              datalayer_extended.GeelySEA.CellTempHighest = (rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6];
+              datalayer_geelysea->CellTempHighest = (rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6];
               break;
             case POLL_AverageCellTemp:
-              datalayer_extended.GeelySEA.CellTempAverage = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
+              datalayer_geelysea->CellTempAverage = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
               break;
             case POLL_LowestCellTemp:
-              datalayer_extended.GeelySEA.CellTempLowest = (rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6];
+              datalayer_geelysea->CellTempLowest = (rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6];
               break;
             case POLL_Interlock:
-              datalayer_extended.GeelySEA.Interlock = rx_frame.data.u8[4];
+              datalayer_geelysea->Interlock = rx_frame.data.u8[4];
               break;
             case POLL_HighestCellVolt:
-              datalayer_extended.GeelySEA.CellVoltHighest = (rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6];
+              datalayer_geelysea->CellVoltHighest = (rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6];
               break;
             case POLL_LowestCellVolt:
-              datalayer_extended.GeelySEA.CellVoltLowest = (rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6];
+              datalayer_geelysea->CellVoltLowest = (rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6];
               break;
             case POLL_BatteryCurrent:
-              datalayer_extended.GeelySEA.BatteryCurrent = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
+              datalayer_geelysea->BatteryCurrent = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
               break;
             default:  //Not a PID reply, or unknown. Do nothing
               break;
@@ -322,39 +322,6 @@ void GeelySeaBattery::readDiagData() {
   }
 }
 
-void GeelySeaBattery::transmit_can(unsigned long currentMillis) {
-
-  if (!battery_alive) {
-    // Send 1000ms CAN Message
-    if (currentMillis - previousMillisWakeup >= INTERVAL_1_S) {
-      previousMillisWakeup = currentMillis;
-      transmit_can_frame(&SEA_536);  //Send 0x536 Network managing frame to wake up BMS
-    }
-    return;  //Break, do not send more messages until battery is woken up
-  }
-
-  // Send 20ms CAN Message
-  if (currentMillis - previousMillis20 >= INTERVAL_20_MS) {
-    previousMillis20 = currentMillis;
-    transmit_can_frame(&SEA_060);  //Send 0x060 Motor B info // 20ms
-    transmit_can_frame(&SEA_156);  //Send 0x156 Motor A info //20ms? No good log
-    transmit_can_frame(&SEA_171);  //Send 0x171 //50ms
-    transmit_can_frame(&SEA_103);  //Send 0x103 //20ms
-  }
-  // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
-    transmit_can_frame(&SEA_218);  //Send 0x218 //100ms
-  }
-  // Send 1000ms CAN Message
-  if (currentMillis - previousMillis1000 >= INTERVAL_1_S) {
-    previousMillis1000 = currentMillis;
-    transmit_can_frame(&SEA_536);  //Send 0x536 Network managing frame to keep BMS alive
-    transmit_can_frame(&SEA_490);  //Send 0x490 // 1sek
-    readDiagData();
-  }
-}
-
 void GeelySeaBattery::setup(void) {  // Performs one time setup at startup
   strncpy(datalayer.system.info.battery_protocol, Name, 63);
   datalayer.system.info.battery_protocol[63] = '\0';
@@ -364,4 +331,26 @@ void GeelySeaBattery::setup(void) {  // Performs one time setup at startup
   datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
   datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
   datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+
+  // Until the battery is woken up, only the network managing frame is sent
+  transmit_every(INTERVAL_20_MS, 4, [this](unsigned long currentMillis) {
+    if (battery_alive) {
+      transmit_can_frame(&SEA_060);  //Send 0x060 Motor B info // 20ms
+      transmit_can_frame(&SEA_156);  //Send 0x156 Motor A info //20ms? No good log
+      transmit_can_frame(&SEA_171);  //Send 0x171 //50ms
+      transmit_can_frame(&SEA_103);  //Send 0x103 //20ms
+    }
+  });
+  transmit_every(INTERVAL_100_MS, 1, [this](unsigned long currentMillis) {
+    if (battery_alive) {
+      transmit_can_frame(&SEA_218);  //Send 0x218 //100ms
+    }
+  });
+  transmit_every(INTERVAL_1_S, 2, [this](unsigned long currentMillis) {
+    transmit_can_frame(&SEA_536);  //Send 0x536 Network managing frame to wake up / keep BMS alive
+    if (battery_alive) {
+      transmit_can_frame(&SEA_490);  //Send 0x490 // 1sek
+      readDiagData();
+    }
+  });
 }
@@ -6,28 +6,34 @@
 
 class GeelySeaBattery : public CanBattery {
  public:
+  GeelySeaBattery() : renderer(datalayer_extended.GeelySEA.get()) {
+    datalayer_geelysea = datalayer_extended.GeelySEA.get();
+  }
+
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Volvo/Zeekr/Geely SEA battery";
 
   bool supports_reset_DTC() { return true; }
-  void reset_DTC() { datalayer_extended.GeelySEA.UserRequestDTCreset = true; }
+  void reset_DTC() { datalayer_geelysea->UserRequestDTCreset = true; }
 
   bool supports_read_DTC() { return true; }
-  void read_DTC() { datalayer_extended.GeelySEA.UserRequestDTCreadout = true; }
+  void read_DTC() { datalayer_geelysea->UserRequestDTCreadout = true; }
 
   bool supports_reset_BECM() { return true; }
-  void reset_BECM() { datalayer_extended.GeelySEA.UserRequestBECMecuReset = true; }
+  void reset_BECM() { datalayer_geelysea->UserRequestBECMecuReset = true; }
 
   bool supports_reset_crash() { return true; }
-  void reset_crash() { datalayer_extended.GeelySEA.UserRequestCrashReset = true; }
+  void reset_crash() { datalayer_geelysea->UserRequestCrashReset = true; }
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
 
  private:
   GeelySeaHtmlRenderer renderer;
+  DATALAYER_INFO_GEELY_SEA* datalayer_geelysea;
 
   void readDiagData();
 
@@ -44,10 +50,6 @@ class GeelySeaBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 4260;  // Charging is halted if one cell goes above this
   static const int MIN_CELL_VOLTAGE_MV = 2900;  // Charging is halted if one cell goes below this
 
-  unsigned long previousMillis20 = 0;    // will store last time a 20ms CAN Message was send
-  unsigned long previousMillis100 = 0;   // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis1000 = 0;  // will store last time a 1s CAN Message was send
-  unsigned long previousMillisWakeup = 0;
 
   static const uint16_t POLL_BECMsupplyVoltage = 0xEE02;
   static const uint16_t POLL_HV_Voltage = 0x4803;
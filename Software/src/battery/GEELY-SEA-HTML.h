@@ -7,26 +7,25 @@
 
 class GeelySeaHtmlRenderer : public BatteryHtmlRenderer {
  public:
+  GeelySeaHtmlRenderer(DATALAYER_INFO_GEELY_SEA* dl) : geelysea_dl(dl) {}
+
   String get_status_html() {
     String content;
-    content += "</h4><h4>BECM reported number of DTCs: " + String(datalayer_extended.GeelySEA.DTCcount) + "</h4>";
-    content += "</h4><h4>Inhibition status (crash): " + String(datalayer_extended.GeelySEA.CrashStatus) + "</h4>";
-    content += "<h4>BECM reported SOC: " + String(datalayer_extended.GeelySEA.soc_bms / 100.0) + " %</h4>";
-    content += "<h4>BECM reported SOH: " + String(datalayer_extended.GeelySEA.soh_bms / 100.0) + " %</h4>";
-    content += "<h4>HV voltage: " + String(datalayer_extended.GeelySEA.BECMBatteryVoltage / 100.0) + " V</h4>";
-    //content += "<h4>Battery current: " + String((datalayer_extended.GeelySEA.BatteryCurrent / 10.0) - 1638) + " A</h4>";
-    content += "<h4>Highest cell voltage: " + String(datalayer_extended.GeelySEA.CellVoltHighest / 1000.00) + " V</h4>";
-    content += "<h4>Lowest cell voltage: " + String(datalayer_extended.GeelySEA.CellVoltLowest / 1000.00) + " V</h4>";
-    content += "<h4>BECM supply voltage: " + String(datalayer_extended.GeelySEA.BECMsupplyVoltage / 1000.0) + " V</h4>";
+    content += "</h4><h4>BECM reported number of DTCs: " + String(geelysea_dl->DTCcount) + "</h4>";
+    content += "</h4><h4>Inhibition status (crash): " + String(geelysea_dl->CrashStatus) + "</h4>";
+    content += "<h4>BECM reported SOC: " + String(geelysea_dl->soc_bms / 100.0) + " %</h4>";
+    content += "<h4>BECM reported SOH: " + String(geelysea_dl->soh_bms / 100.0) + " %</h4>";
+    content += "<h4>HV voltage: " + String(geelysea_dl->BECMBatteryVoltage / 100.0) + " V</h4>";
+    //content += "<h4>Battery current: " + String((geelysea_dl->BatteryCurrent / 10.0) - 1638) + " A</h4>";
+    content += "<h4>Highest cell voltage: " + String(geelysea_dl->CellVoltHighest / 1000.00) + " V</h4>";
+    content += "<h4>Lowest cell voltage: " + String(geelysea_dl->CellVoltLowest / 1000.00) + " V</h4>";
+    content += "<h4>BECM supply voltage: " + String(geelysea_dl->BECMsupplyVoltage / 1000.0) + " V</h4>";
     content += "<h4>Cell count: " + String(datalayer.battery.info.number_of_cells) + "</h4>";
-    content +=
-        "<h4>Highest cell temp: " + String((datalayer_extended.GeelySEA.CellTempHighest / 100.0) - 50.0) + " ºC</h4>";
-    content +=
-        "<h4>Average cell temp: " + String((datalayer_extended.GeelySEA.CellTempAverage / 100.0) - 50.0) + " ºC</h4>";
-    content +=
-        "<h4>Lowest cell temp: " + String((datalayer_extended.GeelySEA.CellTempLowest / 100.0) - 50.0) + " ºC</h4>";
+    content += "<h4>Highest cell temp: " + String((geelysea_dl->CellTempHighest / 100.0) - 50.0) + " ºC</h4>";
+    content += "<h4>Average cell temp: " + String((geelysea_dl->CellTempAverage / 100.0) - 50.0) + " ºC</h4>";
+    content += "<h4>Lowest cell temp: " + String((geelysea_dl->CellTempLowest / 100.0) - 50.0) + " ºC</h4>";
     content += "<h4>HVIL Circuit 1 (M1+M2+FC connectors) status : ";
-    switch (datalayer_extended.GeelySEA.Interlock & 0x80) {
+    switch (geelysea_dl->Interlock & 0x80) {
       case 0x80:
         content += String("Open");
         break;
@@ -34,7 +33,7 @@ class GeelySeaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>HVIL Circuit 2 (LV connector pin 9-10) status: ";
-    switch (datalayer_extended.GeelySEA.Interlock & 0x40) {
+    switch (geelysea_dl->Interlock & 0x40) {
       case 0x40:
         content += String("Open");
         break;
@@ -42,7 +41,7 @@ class GeelySeaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>HVIL Circuit 3 (LV connector pin 8-12) status: ";
-    switch (datalayer_extended.GeelySEA.Interlock & 0x04) {
+    switch (geelysea_dl->Interlock & 0x04) {
       case 0x04:
         content += String("Open");
         break;
@@ -50,7 +49,7 @@ class GeelySeaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>Unknow Contactor Status 1 (Negative FC?): ";
-    switch (datalayer_extended.GeelySEA.Interlock & 0x01) {
+    switch (geelysea_dl->Interlock & 0x01) {
       case 0x01:
         content += String("Open");
         break;
@@ -58,7 +57,7 @@ class GeelySeaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>Unknown Contactor Status 2 (Positive FC?): ";
-    switch (datalayer_extended.GeelySEA.Interlock & 0x02) {
+    switch (geelysea_dl->Interlock & 0x02) {
       case 0x02:
         content += String("Open");
         break;
@@ -66,7 +65,7 @@ class GeelySeaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>Negative Contactor Status: ";
-    switch (datalayer_extended.GeelySEA.Interlock & 0x08) {
+    switch (geelysea_dl->Interlock & 0x08) {
       case 0x08:
         content += String("Open");
         break;
@@ -74,7 +73,7 @@ class GeelySeaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>Precharge Contactor Status: ";
-    switch (datalayer_extended.GeelySEA.Interlock & 0x10) {
+    switch (geelysea_dl->Interlock & 0x10) {
       case 0x10:
         content += String("Open");
         break;
@@ -82,7 +81,7 @@ class GeelySeaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>Positive Contactor Status: ";
-    switch (datalayer_extended.GeelySEA.Interlock & 0x20) {
+    switch (geelysea_dl->Interlock & 0x20) {
       case 0x20:
         content += String("Open");
         break;
@@ -92,6 +91,9 @@ class GeelySeaHtmlRenderer : public BatteryHtmlRenderer {
     content += "<h4>";
     return content;
   }
+
+ private:
+  DATALAYER_INFO_GEELY_SEA* geelysea_dl;
 };
 
 #endif
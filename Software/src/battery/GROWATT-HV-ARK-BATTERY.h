@@ -22,7 +22,7 @@ class GrowattHvArkBattery : public CanBattery {
   ~GrowattHvArkBattery() {}
 
   void setup(void) override;
-  void handle_incoming_can_frame(CAN_frame rx_frame) override;
+  void handle_incoming_can_frame(const CAN_frame& rx_frame) override;
   void update_values() override;
   void transmit_can(unsigned long currentMillis) override;
 
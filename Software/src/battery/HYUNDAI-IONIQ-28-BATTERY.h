@@ -14,7 +14,7 @@ class HyundaiIoniq28Battery : public CanBattery {
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
@@ -83,7 +83,7 @@ void ImievCZeroIonBattery::
   }
 }
 
-void ImievCZeroIonBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void ImievCZeroIonBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x374:  //BMU message, 10ms - SOC
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -161,16 +161,6 @@ void ImievCZeroIonBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void ImievCZeroIonBattery::transmit_can(unsigned long currentMillis) {
-
-  // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
-
-    // Send CAN goes here...
-  }
-}
-
 void ImievCZeroIonBattery::setup(void) {  // Performs one time setup at startup
   strncpy(datalayer.system.info.battery_protocol, Name, 63);
   datalayer.system.info.battery_protocol[63] = '\0';
@@ -180,4 +170,9 @@ void ImievCZeroIonBattery::setup(void) {  // Performs one time setup at startup
   datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
   datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
   datalayer.system.status.battery_allows_contactor_closing = true;
+
+  // Send 100ms CAN Message
+  transmit_every(INTERVAL_100_MS, 1, [this](unsigned long currentMillis) {
+    // Send CAN goes here...
+  });
 }
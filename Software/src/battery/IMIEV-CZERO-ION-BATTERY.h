@@ -5,9 +5,10 @@
 class ImievCZeroIonBattery : public CanBattery {
  public:
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "I-Miev / C-Zero / Ion Triplet";
 
  private:
@@ -21,9 +22,6 @@ class ImievCZeroIonBattery : public CanBattery {
   uint8_t BMU_Detected = 0;
   uint8_t CMU_Detected = 0;
 
-  unsigned long previousMillis10 = 0;   // will store last time a 10ms CAN Message was sent
-  unsigned long previousMillis100 = 0;  // will store last time a 100ms CAN Message was sent
-
   int pid_index = 0;
   int cmu_id = 0;
   int voltage_index = 0;
@@ -6,7 +6,6 @@
 #include "../devboard/utils/logging.h"
 
 /* Do not change code below unless you are sure what you are doing */
-static unsigned long previousMillisKeepAlive = 0;
 
 static uint8_t HVBattAvgSOC = 0;
 static uint8_t HVBattFastChgCounter = 0;
@@ -99,7 +98,7 @@ void JaguarIpaceBattery::update_values() {
   }
 }
 
-void JaguarIpaceBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void JaguarIpaceBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
 
   switch (rx_frame.ID) {  // These messages are periodically transmitted by the battery
     case 0x080:
@@ -197,14 +196,6 @@ void JaguarIpaceBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void JaguarIpaceBattery::transmit_can(unsigned long currentMillis) {
-  /* Send keep-alive every 200ms */
-  if (currentMillis - previousMillisKeepAlive >= INTERVAL_200_MS) {
-    previousMillisKeepAlive = currentMillis;
-    transmit_can_frame(&ipace_keep_alive);
-  }
-}
-
 void JaguarIpaceBattery::setup(void) {  // Performs one time setup at startup
   strncpy(datalayer.system.info.battery_protocol, Name, 63);
   datalayer.system.info.battery_protocol[63] = '\0';
@@ -215,4 +206,6 @@ void JaguarIpaceBattery::setup(void) {  // Performs one time setup at startup
   datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
   datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
   datalayer.system.status.battery_allows_contactor_closing = true;
+
+  transmit_every(INTERVAL_200_MS, &ipace_keep_alive);  // Keep-alive
 }
@@ -8,7 +8,7 @@
 class Kia64FDBattery : public CanBattery {
  public:
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
   static constexpr const char* Name = "Kia 64kWh FD battery";
@@ -20,7 +20,7 @@ class Kia64FDBattery : public CanBattery {
   bool UserRequestDTCreset = false;
   uint16_t estimateSOC(uint16_t packVoltage, uint16_t cellCount, int16_t currentAmps);
   uint16_t estimateSOCFromCell(uint16_t cellVoltage);
-  uint8_t calculateCRC(CAN_frame rx_frame, uint8_t length, uint8_t initial_value);
+  uint8_t calculateCRC(const CAN_frame& rx_frame, uint8_t length, uint8_t initial_value);
   uint16_t selectSOC(uint16_t SOC_low, uint16_t SOC_high);
 
   static const int MAX_PACK_VOLTAGE_DV = 4032;  //5000 = 500.0V
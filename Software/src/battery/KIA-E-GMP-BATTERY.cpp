@@ -72,7 +72,7 @@ uint16_t KiaEGmpBattery::selectSOC(uint16_t SOC_low, uint16_t SOC_high) {
   return (SOC_low < SOC_high) ? SOC_low : SOC_high;  // Otherwise, return the lowest value
 }
 
-void KiaEGmpBattery::set_cell_voltages(CAN_frame rx_frame, int start, int length, int startCell) {
+void KiaEGmpBattery::set_cell_voltages(const CAN_frame& rx_frame, int start, int length, int startCell) {
   for (size_t i = 0; i < length; i++) {
     if ((rx_frame.data.u8[start + i] * 20) > 2600) {
       datalayer.battery.status.cell_voltages_mV[startCell + i] = (rx_frame.data.u8[start + i] * 20);
@@ -106,7 +106,7 @@ void KiaEGmpBattery::set_voltage_minmax_limits() {
   }
 }
 
-uint8_t KiaEGmpBattery::calculateCRC(CAN_frame rx_frame, uint8_t length, uint8_t initial_value) {
+uint8_t KiaEGmpBattery::calculateCRC(const CAN_frame& rx_frame, uint8_t length, uint8_t initial_value) {
   uint8_t crc = initial_value;
   for (uint8_t j = 1; j < length; j++) {  //start at 1, since 0 is the CRC
     crc = crc8_table_SAE_J1850_ZER0[(crc ^ static_cast<uint8_t>(rx_frame.data.u8[j])) % 256];
@@ -199,7 +199,7 @@ int KiaEGmpBattery::get_batRelay() const {
   return batteryRelay;
 }
 
-void KiaEGmpBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void KiaEGmpBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   startedUp = true;
   switch (rx_frame.ID) {
     case 0x055:
@@ -9,7 +9,7 @@ class KiaEGmpBattery : public CanBattery {
  public:
   KiaEGmpBattery() : renderer(*this) {}
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
   static constexpr const char* Name = "Kia/Hyundai EGMP platform";
@@ -32,8 +32,8 @@ class KiaEGmpBattery : public CanBattery {
   uint16_t estimateSOC(uint16_t packVoltage, uint16_t cellCount, int16_t currentAmps);
   uint16_t selectSOC(uint16_t SOC_low, uint16_t SOC_high);
   uint16_t estimateSOCFromCell(uint16_t cellVoltage);
-  uint8_t calculateCRC(CAN_frame rx_frame, uint8_t length, uint8_t initial_value);
-  void set_cell_voltages(CAN_frame rx_frame, int start, int length, int startCell);
+  uint8_t calculateCRC(const CAN_frame& rx_frame, uint8_t length, uint8_t initial_value);
+  void set_cell_voltages(const CAN_frame& rx_frame, int start, int length, int startCell);
   void set_voltage_minmax_limits();
 
   static const int MAX_PACK_VOLTAGE_DV = 8064;  //5000 = 500.0V
@@ -80,7 +80,7 @@ void KiaHyundai64Battery::update_number_of_cells() {
   }
 }
 
-void KiaHyundai64Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void KiaHyundai64Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x4DE:
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -184,7 +184,7 @@ void KiaHyundai64Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
             KIA64_7E4_OPEN_CONTACTOR_SEQUENCE.data.u8[3] = 0x31;
             open_state = 0;
           }
-          transmit_can_frame(&KIA64_7E4_OPEN_CONTACTOR_SEQUENCE);
+          transmit_can_frame(&KIA64_7E4_OPEN_CONTACTOR_SEQUENCE, CAN_TX_SAFETY);
           set_event(EVENT_CONTACTOR_OPEN, 0);
         } else {
           //Normal operation, keep polling battery via UDS
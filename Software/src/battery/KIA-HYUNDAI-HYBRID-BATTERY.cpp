@@ -75,7 +75,7 @@ void KiaHyundaiHybridBattery::
   }
 }
 
-void KiaHyundaiHybridBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void KiaHyundaiHybridBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x5F1:
       break;
@@ -268,12 +268,18 @@ void KiaHyundaiHybridBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void KiaHyundaiHybridBattery::transmit_can(unsigned long currentMillis) {
+void KiaHyundaiHybridBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.system.status.battery_allows_contactor_closing = true;
+  datalayer.battery.info.number_of_cells = 56;                              // Startup in 56S mode, switch later
+  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_PHEV_DV;  //Startup with widest range
+  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_HEV_DV;   //Autodetect later
+  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
 
   //Send 10ms CAN message
-  if (currentMillis - previousMillis10 >= INTERVAL_10_MS) {
-    previousMillis10 = currentMillis;
-
+  transmit_every(INTERVAL_10_MS, 3, [this](unsigned long currentMillis) {
     KIA_200.data.u8[6] = (counter_200 & 0x0F) << 1;
 
     // CRC8 – Santa Fe style (byte 7)
@@ -292,24 +298,18 @@ void KiaHyundaiHybridBattery::transmit_can(unsigned long currentMillis) {
 
     KIA_2F0.data.u8[0] = 0x0B;
     transmit_can_frame(&KIA_2F0);
-  }
-
+  });
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 2, [this](unsigned long currentMillis) {
     transmit_can_frame(&KIA_523);
 
     if (UserRequestDTCreset) {
       UserRequestDTCreset = false;
       transmit_can_frame(&KIA_CLEAR_DTC);
     }
-  }
-
+  });
   // Send 1000ms CAN Message
-  if (currentMillis - previousMillis1000 >= INTERVAL_1_S) {
-    previousMillis1000 = currentMillis;
-
+  transmit_every(INTERVAL_1_S, 1, [this](unsigned long currentMillis) {
     //PID data is polled after last message sent from battery:
     if (poll_data_pid >= 5) {  //polling one of 5 PIDs at 100ms, resolution = 500ms
       poll_data_pid = 0;
@@ -333,16 +333,5 @@ void KiaHyundaiHybridBattery::transmit_can(unsigned long currentMillis) {
       KIA_7E4.data.u8[3] = 0x04;
       transmit_can_frame(&KIA_7E4);
     }
-  }
-}
-
-void KiaHyundaiHybridBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.system.status.battery_allows_contactor_closing = true;
-  datalayer.battery.info.number_of_cells = 56;                              // Startup in 56S mode, switch later
-  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_PHEV_DV;  //Startup with widest range
-  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_HEV_DV;   //Autodetect later
-  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  });
 }
@@ -5,9 +5,10 @@
 class KiaHyundaiHybridBattery : public CanBattery {
  public:
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Kia/Hyundai Hybrid";
 
   bool supports_reset_DTC() { return true; }
@@ -23,10 +24,6 @@ class KiaHyundaiHybridBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 4250;  //Battery is put into emergency stop if one cell goes over this value
   static const int MIN_CELL_VOLTAGE_MV = 2700;  //Battery is put into emergency stop if one cell goes below this value
 
-  unsigned long previousMillis10 = 0;    // will store last time a 10ms CAN Message was send
-  unsigned long previousMillis100 = 0;   // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis1000 = 0;  // will store last time a 1000ms CAN Message was send
-
   uint8_t counter_200 = 0;
   uint16_t SOC = 0;
   uint16_t SOC_display = 0;
@@ -263,61 +263,61 @@ void MebBattery::
   }
 
   // Update webserver datalayer for "More battery info" page
-  datalayer_extended.meb.SDSW = service_disconnect_switch_missing;
-  datalayer_extended.meb.pilotline = pilotline_open;
-  datalayer_extended.meb.transportmode = transportation_mode_active;
-  datalayer_extended.meb.componentprotection = component_protection_active;
-  datalayer_extended.meb.shutdown_active = shutdown_active;
-  datalayer_extended.meb.HVIL = BMS_HVIL_status;
-  datalayer_extended.meb.BMS_mode = BMS_mode;
-  datalayer_extended.meb.battery_diagnostic = battery_diagnostic;
-  datalayer_extended.meb.status_HV_line = status_HV_line;
-  datalayer_extended.meb.BMS_fault_performance = BMS_fault_performance;
-  datalayer_extended.meb.BMS_fault_emergency_shutdown_crash = BMS_fault_emergency_shutdown_crash;
-  datalayer_extended.meb.BMS_error_shutdown_request = BMS_error_shutdown_request;
-  datalayer_extended.meb.BMS_error_shutdown = BMS_error_shutdown;
-  datalayer_extended.meb.BMS_welded_contactors_status = BMS_welded_contactors_status;
-
-  datalayer_extended.meb.warning_support = warning_support;
-  datalayer_extended.meb.BMS_status_voltage_free = BMS_status_voltage_free;
-  datalayer_extended.meb.BMS_OBD_MIL = BMS_OBD_MIL;
-  datalayer_extended.meb.BMS_error_status = BMS_error_status;
-  datalayer_extended.meb.BMS_error_lamp_req = BMS_error_lamp_req;
-  datalayer_extended.meb.BMS_warning_lamp_req = BMS_warning_lamp_req;
-  datalayer_extended.meb.BMS_Kl30c_Status = BMS_Kl30c_Status;
-  datalayer_extended.meb.BMS_voltage_intermediate_dV = (BMS_voltage_intermediate - 2000) * 10 / 2;
-  datalayer_extended.meb.BMS_voltage_dV = BMS_voltage * 10 / 4;
-  datalayer_extended.meb.isolation_resistance = isolation_resistance_kOhm * 5;
-  datalayer_extended.meb.battery_heating = battery_heating_active;
-  datalayer_extended.meb.rt_overcurrent = realtime_overcurrent_monitor;
-  datalayer_extended.meb.rt_CAN_fault = realtime_CAN_communication_fault;
-  datalayer_extended.meb.rt_overcharge = realtime_overcharge_warning;
-  datalayer_extended.meb.rt_SOC_high = realtime_SOC_too_high;
-  datalayer_extended.meb.rt_SOC_low = realtime_SOC_too_low;
-  datalayer_extended.meb.rt_SOC_jumping = realtime_SOC_jumping_warning;
-  datalayer_extended.meb.rt_temp_difference = realtime_temperature_difference_warning;
-  datalayer_extended.meb.rt_cell_overtemp = realtime_cell_overtemperature_warning;
-  datalayer_extended.meb.rt_cell_undertemp = realtime_cell_undertemperature_warning;
-  datalayer_extended.meb.rt_battery_overvolt = realtime_battery_overvoltage_warning;
-  datalayer_extended.meb.rt_battery_undervol = realtime_battery_undervoltage_warning;
-  datalayer_extended.meb.rt_cell_overvolt = realtime_cell_overvoltage_warning;
-  datalayer_extended.meb.rt_cell_undervol = realtime_cell_undervoltage_warning;
-  datalayer_extended.meb.rt_cell_imbalance = realtime_cell_imbalance_warning;
-  datalayer_extended.meb.rt_battery_unathorized = realtime_warning_battery_unathorized;
-  if (balancing_active == 1 && datalayer_extended.meb.balancing_active != 1) {
+  datalayer_meb->SDSW = service_disconnect_switch_missing;
+  datalayer_meb->pilotline = pilotline_open;
+  datalayer_meb->transportmode = transportation_mode_active;
+  datalayer_meb->componentprotection = component_protection_active;
+  datalayer_meb->shutdown_active = shutdown_active;
+  datalayer_meb->HVIL = BMS_HVIL_status;
+  datalayer_meb->BMS_mode = BMS_mode;
+  datalayer_meb->battery_diagnostic = battery_diagnostic;
+  datalayer_meb->status_HV_line = status_HV_line;
+  datalayer_meb->BMS_fault_performance = BMS_fault_performance;
+  datalayer_meb->BMS_fault_emergency_shutdown_crash = BMS_fault_emergency_shutdown_crash;
+  datalayer_meb->BMS_error_shutdown_request = BMS_error_shutdown_request;
+  datalayer_meb->BMS_error_shutdown = BMS_error_shutdown;
+  datalayer_meb->BMS_welded_contactors_status = BMS_welded_contactors_status;
+
+  datalayer_meb->warning_support = warning_support;
+  datalayer_meb->BMS_status_voltage_free = BMS_status_voltage_free;
+  datalayer_meb->BMS_OBD_MIL = BMS_OBD_MIL;
+  datalayer_meb->BMS_error_status = BMS_error_status;
+  datalayer_meb->BMS_error_lamp_req = BMS_error_lamp_req;
+  datalayer_meb->BMS_warning_lamp_req = BMS_warning_lamp_req;
+  datalayer_meb->BMS_Kl30c_Status = BMS_Kl30c_Status;
+  datalayer_meb->BMS_voltage_intermediate_dV = (BMS_voltage_intermediate - 2000) * 10 / 2;
+  datalayer_meb->BMS_voltage_dV = BMS_voltage * 10 / 4;
+  datalayer_meb->isolation_resistance = isolation_resistance_kOhm * 5;
+  datalayer_meb->battery_heating = battery_heating_active;
+  datalayer_meb->rt_overcurrent = realtime_overcurrent_monitor;
+  datalayer_meb->rt_CAN_fault = realtime_CAN_communication_fault;
+  datalayer_meb->rt_overcharge = realtime_overcharge_warning;
+  datalayer_meb->rt_SOC_high = realtime_SOC_too_high;
+  datalayer_meb->rt_SOC_low = realtime_SOC_too_low;
+  datalayer_meb->rt_SOC_jumping = realtime_SOC_jumping_warning;
+  datalayer_meb->rt_temp_difference = realtime_temperature_difference_warning;
+  datalayer_meb->rt_cell_overtemp = realtime_cell_overtemperature_warning;
+  datalayer_meb->rt_cell_undertemp = realtime_cell_undertemperature_warning;
+  datalayer_meb->rt_battery_overvolt = realtime_battery_overvoltage_warning;
+  datalayer_meb->rt_battery_undervol = realtime_battery_undervoltage_warning;
+  datalayer_meb->rt_cell_overvolt = realtime_cell_overvoltage_warning;
+  datalayer_meb->rt_cell_undervol = realtime_cell_undervoltage_warning;
+  datalayer_meb->rt_cell_imbalance = realtime_cell_imbalance_warning;
+  datalayer_meb->rt_battery_unathorized = realtime_warning_battery_unathorized;
+  if (balancing_active == 1 && datalayer_meb->balancing_active != 1) {
     datalayer_battery->status.balancing_status = BALANCING_STATUS_ACTIVE;
     set_event_latched(EVENT_BALANCING_START, 0);
   }
-  if (balancing_active == 2 && datalayer_extended.meb.balancing_active == 1) {
+  if (balancing_active == 2 && datalayer_meb->balancing_active == 1) {
     datalayer_battery->status.balancing_status = BALANCING_STATUS_READY;
     set_event(EVENT_BALANCING_END, 0);
   }
-  datalayer_extended.meb.balancing_active = balancing_active;
-  datalayer_extended.meb.balancing_request = balancing_request;
-  datalayer_extended.meb.charging_active = charging_active;
+  datalayer_meb->balancing_active = balancing_active;
+  datalayer_meb->balancing_request = balancing_request;
+  datalayer_meb->charging_active = charging_active;
 }
 
-void MebBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void MebBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   last_can_msg_timestamp = millis();
   if (first_can_msg_timestamp == 0) {
     logging.printf("MEB: First CAN msg received\n");
@@ -415,7 +415,7 @@ void MebBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       status_valve_1 = (rx_frame.data.u8[3] & 0x1C) >> 2;
       status_valve_2 = (rx_frame.data.u8[3] & 0xE0) >> 5;
       temperature_request = (((rx_frame.data.u8[2] & 0x03) << 1) | rx_frame.data.u8[1] >> 7);
-      datalayer_extended.meb.battery_temperature_dC = rx_frame.data.u8[5] * 5 - 400;  //*0,5 -40
+      datalayer_meb->battery_temperature_dC = rx_frame.data.u8[5] * 5 - 400;          //*0,5 -40
       target_flow_temperature_C = rx_frame.data.u8[6];                                //*0,5 -40
       return_temperature_C = rx_frame.data.u8[7];                                     //*0,5 -40
       break;
@@ -455,7 +455,7 @@ void MebBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       switch (mux) {
         case 0:  // Temperatures 1-56. Value is 0xFD if sensor not present
           for (uint8_t i = 0; i < 56; i++) {
-            datalayer_extended.meb.celltemperature_dC[i] = ((int16_t)rx_frame.data.u8[i + 1] * 5) - 400;
+            datalayer_meb->celltemperature_dC[i] = ((int16_t)rx_frame.data.u8[i + 1] * 5) - 400;
           }
           break;
         /*
@@ -856,7 +856,7 @@ void MebBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
           break;
         default:
           if (pid_reply >= PID_TEMP_POINT_1 && pid_reply <= PID_TEMP_POINT_18) {
-            datalayer_extended.meb.temp_points[pid_reply - PID_TEMP_POINT_1] =
+            datalayer_meb->temp_points[pid_reply - PID_TEMP_POINT_1] =
                 (((rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5]) / 8.f) - 40;
           } else if (pid_reply >= PID_CELLVOLTAGE_CELL_1 && pid_reply <= PID_CELLVOLTAGE_CELL_108) {
             // The general case for cell voltages (some specific cases handled above)
@@ -882,29 +882,37 @@ void MebBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void MebBattery::transmit_can(unsigned long currentMillis) {
-
-  if (currentMillis - last_can_msg_timestamp > 500) {
-    if (first_can_msg_timestamp)
-      logging.printf("MEB: No CAN msg received for 500ms\n");
-    can_msg_received = RX_DEFAULT;
-    first_can_msg_timestamp = 0;
-    if (datalayer.battery.status.real_bms_status != BMS_FAULT) {
-      datalayer.battery.status.real_bms_status = BMS_DISCONNECTED;
-      datalayer.system.status.battery_allows_contactor_closing = false;
-
-      // Set the link voltage back to 0, so that when the BMS comes back, it
-      // doesn't immediately skip the precharge.
-      BMS_voltage_intermediate = 0;
-      datalayer_extended.meb.BMS_voltage_intermediate_dV = 0;
+void MebBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.battery.info.number_of_cells = 108;  //Startup in 108S mode. We figure out the actual count later.
+  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_108S_DV;  //Defined later to correct pack size
+  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_84S_DV;   //Defined later to correct pack size
+  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  memset(cellvoltages_polled, 0, sizeof(cellvoltages_polled));
 
-      // Reset the HV requested state so that we don't skip the precharge.
-      hv_requested = false;
+  // Send 10ms CAN Message. The BMS timeout and the log of state changes are checked along with it.
+  transmit_every(INTERVAL_10_MS, 1, [this](unsigned long currentMillis) {
+    if (currentMillis - last_can_msg_timestamp > 500) {
+      if (first_can_msg_timestamp)
+        logging.printf("MEB: No CAN msg received for 500ms\n");
+      can_msg_received = RX_DEFAULT;
+      first_can_msg_timestamp = 0;
+      if (datalayer.battery.status.real_bms_status != BMS_FAULT) {
+        datalayer.battery.status.real_bms_status = BMS_DISCONNECTED;
+        datalayer.system.status.battery_allows_contactor_closing = false;
+
+        // Set the link voltage back to 0, so that when the BMS comes back, it
+        // doesn't immediately skip the precharge.
+        BMS_voltage_intermediate = 0;
+        datalayer_meb->BMS_voltage_intermediate_dV = 0;
+
+        // Reset the HV requested state so that we don't skip the precharge.
+        hv_requested = false;
+      }
     }
-  }
-  // Send 10ms CAN Message
-  if (currentMillis - previousMillis10ms >= INTERVAL_10_MS) {
-    previousMillis10ms = currentMillis;
 
     ESC_51_Auth_frame.data.u8[1] = ((ESC_51_Auth_frame.data.u8[1] & 0xF0) | counter_10ms);
     ESC_51_Auth_frame.data.u8[0] = vw_crc_calc(ESC_51_Auth_frame.data.u8, ESC_51_Auth_frame.DLC, ESC_51_Auth_frame.ID);
@@ -912,22 +920,57 @@ void MebBattery::transmit_can(unsigned long currentMillis) {
     counter_10ms = (counter_10ms + 1) % 16;  //Goes from 0-1-2-3...15-0-1-2-3..
 
     transmit_can_frame(&ESC_51_Auth_frame);  // Required for contactor closing
-  }
-  // Send 20ms CAN Message
-  if (currentMillis - previousMillis20ms >= INTERVAL_20_MS) {
-    previousMillis20ms = currentMillis;
 
+    static auto last_real_bms_status = datalayer.battery.status.real_bms_status;
+    static auto last_start_precharging = datalayer.system.info.start_precharging;
+    static auto last_hv_requested = hv_requested;
+    static auto last_voltage_dV = datalayer.battery.status.voltage_dV;
+    static auto last_BMS_voltage_intermediate_dV = datalayer_meb->BMS_voltage_intermediate_dV;
+    static auto BMS_mode = datalayer_meb->BMS_mode;
+
+    if (last_real_bms_status != datalayer.battery.status.real_bms_status) {
+      logging.printf("MEB: BMS status %d -> %d\n", last_real_bms_status, datalayer.battery.status.real_bms_status);
+      last_real_bms_status = datalayer.battery.status.real_bms_status;
+    }
+
+    if (last_start_precharging != datalayer.system.info.start_precharging) {
+      logging.printf("MEB: Start precharging %d -> %d\n", last_start_precharging,
+                     datalayer.system.info.start_precharging);
+      last_start_precharging = datalayer.system.info.start_precharging;
+    }
+
+    if (last_hv_requested != hv_requested) {
+      logging.printf("MEB: HV requested %d -> %d\n", last_hv_requested, hv_requested);
+      last_hv_requested = hv_requested;
+    }
+
+    if (last_voltage_dV != datalayer.battery.status.voltage_dV) {
+      logging.printf("MEB: Voltage dV %d -> %d\n", last_voltage_dV, datalayer.battery.status.voltage_dV);
+      last_voltage_dV = datalayer.battery.status.voltage_dV;
+    }
+
+    if (last_BMS_voltage_intermediate_dV != datalayer_meb->BMS_voltage_intermediate_dV) {
+      logging.printf("MEB: BMS Voltage intermediate dV %d -> %d\n", last_BMS_voltage_intermediate_dV,
+                     datalayer_meb->BMS_voltage_intermediate_dV);
+      last_BMS_voltage_intermediate_dV = datalayer_meb->BMS_voltage_intermediate_dV;
+    }
+
+    if (BMS_mode != datalayer_meb->BMS_mode) {
+      logging.printf("MEB: BMS mode %d -> %d\n", BMS_mode, datalayer_meb->BMS_mode);
+      BMS_mode = datalayer_meb->BMS_mode;
+    }
+  });
+  // Send 20ms CAN Message
+  transmit_every(INTERVAL_20_MS, 1, [this](unsigned long currentMillis) {
     ESP_21_frame.data.u8[1] = ((ESP_21_frame.data.u8[1] & 0xF0) | counter_20ms);
     ESP_21_frame.data.u8[0] = vw_crc_calc(ESP_21_frame.data.u8, ESP_21_frame.DLC, ESP_21_frame.ID);
 
     counter_20ms = (counter_20ms + 1) % 16;  //Goes from 0-1-2-3...15-0-1-2-3..
 
     transmit_can_frame(&ESP_21_frame);  // Required for contactor closing
-  }
+  });
   // Send 40ms CAN Message
-  if (currentMillis - previousMillis40ms >= INTERVAL_40_MS) {
-    previousMillis40ms = currentMillis;
-
+  transmit_every(INTERVAL_40_MS, 1, [this](unsigned long currentMillis) {
     /* Handle content for 0x040 message */
     /* Airbag message, needed for BMS to function */
     Airbag_01_frame.data.u8[7] = counter_040;
@@ -940,11 +983,9 @@ void MebBattery::transmit_can(unsigned long currentMillis) {
     toggle = !toggle;  // Flip the toggle each time the code block is executed
 
     transmit_can_frame(&Airbag_01_frame);  // Airbag message - Needed for contactor closing
-  }
+  });
   // Send 50ms CAN Message
-  if (currentMillis - previousMillis50ms >= INTERVAL_50_MS) {
-    previousMillis50ms = currentMillis;
-
+  transmit_every(INTERVAL_50_MS, 1, [this](unsigned long currentMillis) {
     /* Handle content for 0x0C0 message */
     /* BMS needs to see this EM1 message. Content located in frame5&6 especially (can be static?)*/
     /* Also the voltage seen externally to battery is in frame 7&8. At least for the 62kWh ID3 version does not seem to matter, but we send it anyway. */
@@ -956,20 +997,18 @@ void MebBattery::transmit_can(unsigned long currentMillis) {
     counter_50ms = (counter_50ms + 1) % 16;  //Goes from 0-1-2-3...15-0-1-2-3..
 
     transmit_can_frame(&EM1_01_frame);  //  Needed for contactor closing
-  }
+  });
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100ms >= INTERVAL_100_MS) {
-    previousMillis100ms = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 5, [this](unsigned long currentMillis) {
     //HV request and DC/DC control lies in 0x503
 
     if ((!datalayer.system.info.equipment_stop_active) && datalayer.battery.status.real_bms_status != BMS_FAULT &&
         (datalayer.battery.status.real_bms_status == BMS_ACTIVE ||
          (datalayer.battery.status.real_bms_status == BMS_STANDBY &&
           (hv_requested ||
-           (datalayer.battery.status.voltage_dV > 200 && datalayer_extended.meb.BMS_voltage_intermediate_dV > 0 &&
+           (datalayer.battery.status.voltage_dV > 200 && datalayer_meb->BMS_voltage_intermediate_dV > 0 &&
             labs(((int32_t)datalayer.battery.status.voltage_dV) -
-                 ((int32_t)datalayer_extended.meb.BMS_voltage_intermediate_dV)) < 200))))) {
+                 ((int32_t)datalayer_meb->BMS_voltage_intermediate_dV)) < 200))))) {
       // We are either:
       //  - in BMS_ACTIVE state (contactors closed, normal operation)
       //  - or in BMS_STANDBY state, ready to request HV from the battery (our precharge is within 20V)
@@ -1058,11 +1097,9 @@ void MebBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&Klemmen_Status_01_frame);
     transmit_can_frame(&Motor_14_frame);
     transmit_can_frame(&Motor_54_frame);
-  }
+  });
   //Send 200ms message
-  if (currentMillis - previousMillis200ms >= INTERVAL_200_MS) {
-    previousMillis200ms = currentMillis;
-
+  transmit_every(INTERVAL_200_MS, 6, [this](unsigned long currentMillis) {
     // MSG_HYB_30_frame does not need CRC even though it has it. Empty in some logs as well.
 
     //TODO: NMH_DCDC_NV_frame & NMH_Gateway_frame & NMH_Klima_frame has CAN sleep commands. May be removed?
@@ -1200,23 +1237,17 @@ void MebBattery::transmit_can(unsigned long currentMillis) {
       // if no CAN traffic then don't move to the next PID.
       poll_pid = current_pid;
     }
-  }
-
+  });
   // Send 500ms CAN Message
-  if (currentMillis - previousMillis500ms >= INTERVAL_500_MS) {
-    previousMillis500ms = currentMillis;
-
+  transmit_every(INTERVAL_500_MS, 5, [this](unsigned long currentMillis) {
     transmit_can_frame(&eTM_01_frame);         //eTM, Cooling valves and pumps for BMS
     transmit_can_frame(&HVEM_04_frame);        // Battery heating requests
     transmit_can_frame(&Klima_EV_06_frame);    //Climate, heatpump and priorities
     transmit_can_frame(&ORU_01_frame);         //ORU, OTA update message for reserving battery
     transmit_can_frame(&Standklima_01_frame);  //Climate, request to BMS for starting preconditioning
-  }
-
+  });
   //Send 1s CANFD message
-  if (currentMillis - previousMillis1s >= INTERVAL_1_S) {
-    previousMillis1s = currentMillis;
-
+  transmit_every(INTERVAL_1_S, 6, [this](unsigned long currentMillis) {
     Motor_Code_01_frame.data.u8[1] = ((Motor_Code_01_frame.data.u8[1] & 0xF0) | counter_1000ms);
     Motor_Code_01_frame.data.u8[0] =
         vw_crc_calc(Motor_Code_01_frame.data.u8, Motor_Code_01_frame.DLC, Motor_Code_01_frame.ID);
@@ -1240,56 +1271,5 @@ void MebBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&Temperaturen_01_frame);  // Temperature QBit
 
     transmit_obd_can_frame(OBD_Hybrid_01_Req, can_config.battery, true);
-  }
-
-  static auto last_real_bms_status = datalayer.battery.status.real_bms_status;
-  static auto last_start_precharging = datalayer.system.info.start_precharging;
-  static auto last_hv_requested = hv_requested;
-  static auto last_voltage_dV = datalayer.battery.status.voltage_dV;
-  static auto last_BMS_voltage_intermediate_dV = datalayer_extended.meb.BMS_voltage_intermediate_dV;
-  static auto BMS_mode = datalayer_extended.meb.BMS_mode;
-
-  if (last_real_bms_status != datalayer.battery.status.real_bms_status) {
-    logging.printf("MEB: BMS status %d -> %d\n", last_real_bms_status, datalayer.battery.status.real_bms_status);
-    last_real_bms_status = datalayer.battery.status.real_bms_status;
-  }
-
-  if (last_start_precharging != datalayer.system.info.start_precharging) {
-    logging.printf("MEB: Start precharging %d -> %d\n", last_start_precharging,
-                   datalayer.system.info.start_precharging);
-    last_start_precharging = datalayer.system.info.start_precharging;
-  }
-
-  if (last_hv_requested != hv_requested) {
-    logging.printf("MEB: HV requested %d -> %d\n", last_hv_requested, hv_requested);
-    last_hv_requested = hv_requested;
-  }
-
-  if (last_voltage_dV != datalayer.battery.status.voltage_dV) {
-    logging.printf("MEB: Voltage dV %d -> %d\n", last_voltage_dV, datalayer.battery.status.voltage_dV);
-    last_voltage_dV = datalayer.battery.status.voltage_dV;
-  }
-
-  if (last_BMS_voltage_intermediate_dV != datalayer_extended.meb.BMS_voltage_intermediate_dV) {
-    logging.printf("MEB: BMS Voltage intermediate dV %d -> %d\n", last_BMS_voltage_intermediate_dV,
-                   datalayer_extended.meb.BMS_voltage_intermediate_dV);
-    last_BMS_voltage_intermediate_dV = datalayer_extended.meb.BMS_voltage_intermediate_dV;
-  }
-
-  if (BMS_mode != datalayer_extended.meb.BMS_mode) {
-    logging.printf("MEB: BMS mode %d -> %d\n", BMS_mode, datalayer_extended.meb.BMS_mode);
-    BMS_mode = datalayer_extended.meb.BMS_mode;
-  }
-}
-
-void MebBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.battery.info.number_of_cells = 108;  //Startup in 108S mode. We figure out the actual count later.
-  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_108S_DV;  //Defined later to correct pack size
-  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_84S_DV;   //Defined later to correct pack size
-  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
-  memset(cellvoltages_polled, 0, sizeof(cellvoltages_polled));
+  });
 }
@@ -7,21 +7,23 @@ class MebBattery : public CanBattery {
  public:
   // Use this constructor for the second battery.
   MebBattery(DATALAYER_BATTERY_TYPE* datalayer_ptr, DATALAYER_INFO_MEB* extended, CAN_Interface targetCan)
-      : CanBattery(targetCan) {
+      : CanBattery(targetCan), renderer(extended) {
     datalayer_battery = datalayer_ptr;
+    datalayer_meb = extended;
 
     BMS_voltage = 0;
   }
   // Use the default constructor to create the first or single battery.
-  MebBattery() {
+  MebBattery() : renderer(datalayer_extended.meb.get()) {
     datalayer_battery = &datalayer.battery;
-    datalayer_meb = &datalayer_extended.meb;
+    datalayer_meb = datalayer_extended.meb.get();
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   bool supports_real_BMS_status() { return true; }
   bool supports_charged_energy() { return true; }
   static constexpr const char* Name = "Volkswagen Group MEB platform via CAN-FD";
@@ -244,15 +246,6 @@ class MebBattery : public CanBattery {
   static const int KN_Hybrid_01 = 0x17F0007B;
   static const int Kombi_02 = 0x6B7;
 
-  unsigned long previousMillis10ms = 0;   // will store last time a 10ms CAN Message was send
-  unsigned long previousMillis20ms = 0;   // will store last time a 20ms CAN Message was send
-  unsigned long previousMillis40ms = 0;   // will store last time a 40ms CAN Message was send
-  unsigned long previousMillis50ms = 0;   // will store last time a 50ms CAN Message was send
-  unsigned long previousMillis100ms = 0;  // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis200ms = 0;  // will store last time a 200ms CAN Message was send
-  unsigned long previousMillis500ms = 0;  // will store last time a 500ms CAN Message was send
-  unsigned long previousMillis1s = 0;     // will store last time a 1s CAN Message was send
-
   bool toggle = false;
   uint8_t counter_1000ms = 0;
   uint8_t counter_200ms = 0;
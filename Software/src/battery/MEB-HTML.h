@@ -7,18 +7,33 @@
 
 class MebHtmlRenderer : public BatteryHtmlRenderer {
  public:
+  MebHtmlRenderer(DATALAYER_INFO_MEB* dl) : meb_dl(dl) {}
+
   String get_status_html() {
     String content;
+    render_states(content);
+    render_faults(content);
+    render_temperatures(content);
+    return content;
+  }
+
+  // Each block is a section of its own, so only one is held in memory at a time
+  void status_sections(HtmlChunkedPage& page) {
+    page.section([this](String& content) { render_states(content); });
+    page.section([this](String& content) { render_faults(content); });
+    page.section([this](String& content) { render_temperatures(content); });
+  }
 
-    content += datalayer_extended.meb.SDSW ? "<h4>Service disconnect switch: Missing!</h4>"
-                                           : "<h4>Service disconnect switch: OK</h4>";
-    content += datalayer_extended.meb.pilotline ? "<h4>Pilotline: Open!</h4>" : "<h4>Pilotline: OK</h4>";
-    content += datalayer_extended.meb.transportmode ? "<h4>Transportmode: Locked!</h4>" : "<h4>Transportmode: OK</h4>";
-    content += datalayer_extended.meb.shutdown_active ? "<h4>Shutdown: Active!</h4>" : "<h4>Shutdown: No</h4>";
-    content += datalayer_extended.meb.componentprotection ? "<h4>Component protection: Active!</h4>"
-                                                          : "<h4>Component protection: No</h4>";
+ private:
+  void render_states(String& content) {
+    content += meb_dl->SDSW ? "<h4>Service disconnect switch: Missing!</h4>" : "<h4>Service disconnect switch: OK</h4>";
+    content += meb_dl->pilotline ? "<h4>Pilotline: Open!</h4>" : "<h4>Pilotline: OK</h4>";
+    content += meb_dl->transportmode ? "<h4>Transportmode: Locked!</h4>" : "<h4>Transportmode: OK</h4>";
+    content += meb_dl->shutdown_active ? "<h4>Shutdown: Active!</h4>" : "<h4>Shutdown: No</h4>";
+    content +=
+        meb_dl->componentprotection ? "<h4>Component protection: Active!</h4>" : "<h4>Component protection: No</h4>";
     content += "<h4>HVIL status: ";
-    switch (datalayer_extended.meb.HVIL) {
+    switch (meb_dl->HVIL) {
       case 0:
         content += "Init";
         break;
@@ -35,7 +50,7 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
         content += "?";
     }
     content += "</h4><h4>KL30C status: ";
-    switch (datalayer_extended.meb.BMS_Kl30c_Status) {
+    switch (meb_dl->BMS_Kl30c_Status) {
       case 0:
         content += "Init";
         break;
@@ -52,7 +67,7 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
         content += "?";
     }
     content += "</h4><h4>BMS mode: ";
-    switch (datalayer_extended.meb.BMS_mode) {
+    switch (meb_dl->BMS_mode) {
       case 0:
         content += "HV inactive";
         break;
@@ -80,9 +95,9 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
       default:
         content += "?";
     }
-    content += String("</h4><h4>Charging: ") + (datalayer_extended.meb.charging_active ? "active" : "not active");
+    content += String("</h4><h4>Charging: ") + (meb_dl->charging_active ? "active" : "not active");
     content += String("</h4><h4>Balancing: ");
-    switch (datalayer_extended.meb.balancing_active) {
+    switch (meb_dl->balancing_active) {
       case 0:
         content += "init";
         break;
@@ -95,10 +110,9 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
       default:
         content += "?";
     }
-    content +=
-        String("</h4><h4>Slow charging: ") + (datalayer_extended.meb.balancing_request ? "requested" : "not requested");
+    content += String("</h4><h4>Slow charging: ") + (meb_dl->balancing_request ? "requested" : "not requested");
     content += "</h4><h4>Diagnostic: ";
-    switch (datalayer_extended.meb.battery_diagnostic) {
+    switch (meb_dl->battery_diagnostic) {
       case 0:
         content += "Init";
         break;
@@ -118,7 +132,7 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
         content += "?";
     }
     content += "</h4><h4>HV line status: ";
-    switch (datalayer_extended.meb.status_HV_line) {
+    switch (meb_dl->status_HV_line) {
       case 0:
         content += "Init";
         break;
@@ -132,20 +146,18 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
         content += "Fault";
         break;
       default:
-        content += "? " + String(datalayer_extended.meb.status_HV_line);
+        content += "? " + String(meb_dl->status_HV_line);
     }
     content += "</h4>";
-    content += datalayer_extended.meb.BMS_fault_performance ? "<h4>BMS fault performance: Active!</h4>"
-                                                            : "<h4>BMS fault performance: Off</h4>";
-    content += datalayer_extended.meb.BMS_fault_emergency_shutdown_crash
-                   ? "<h4>BMS fault emergency shutdown crash: Active!</h4>"
-                   : "<h4>BMS fault emergency shutdown crash: Off</h4>";
-    content += datalayer_extended.meb.BMS_error_shutdown_request ? "<h4>BMS error shutdown request: Active!</h4>"
-                                                                 : "<h4>BMS error shutdown request: Inactive</h4>";
-    content += datalayer_extended.meb.BMS_error_shutdown ? "<h4>BMS error shutdown: Active!</h4>"
-                                                         : "<h4>BMS error shutdown: Off</h4>";
+    content += meb_dl->BMS_fault_performance ? "<h4>BMS fault performance: Active!</h4>"
+                                             : "<h4>BMS fault performance: Off</h4>";
+    content += meb_dl->BMS_fault_emergency_shutdown_crash ? "<h4>BMS fault emergency shutdown crash: Active!</h4>"
+                                                          : "<h4>BMS fault emergency shutdown crash: Off</h4>";
+    content += meb_dl->BMS_error_shutdown_request ? "<h4>BMS error shutdown request: Active!</h4>"
+                                                  : "<h4>BMS error shutdown request: Inactive</h4>";
+    content += meb_dl->BMS_error_shutdown ? "<h4>BMS error shutdown: Active!</h4>" : "<h4>BMS error shutdown: Off</h4>";
     content += "<h4>Welded contactors: ";
-    switch (datalayer_extended.meb.BMS_welded_contactors_status) {
+    switch (meb_dl->BMS_welded_contactors_status) {
       case 0:
         content += "Init";
         break;
@@ -162,7 +174,7 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
         content += "?";
     }
     content += "</h4><h4>Warning support: ";
-    switch (datalayer_extended.meb.warning_support) {
+    switch (meb_dl->warning_support) {
       case 0:
         content += "OK";
         break;
@@ -178,9 +190,8 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
       default:
         content += "?";
     }
-    content += "</h4><h4>Interm. Voltage (" + String(datalayer_extended.meb.BMS_voltage_intermediate_dV / 10.0f, 1) +
-               "V) status: ";
-    switch (datalayer_extended.meb.BMS_status_voltage_free) {
+    content += "</h4><h4>Interm. Voltage (" + String(meb_dl->BMS_voltage_intermediate_dV / 10.0f, 1) + "V) status: ";
+    switch (meb_dl->BMS_status_voltage_free) {
       case 0:
         content += "Init";
         break;
@@ -197,7 +208,7 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
         content += "?";
     }
     content += "</h4><h4>BMS error status: ";
-    switch (datalayer_extended.meb.BMS_error_status) {
+    switch (meb_dl->BMS_error_status) {
       case 0:
         content += "Component IO";
         break;
@@ -225,58 +236,58 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
       default:
         content += "?";
     }
-    content += "</h4><h4>BMS voltage: " + String(datalayer_extended.meb.BMS_voltage_dV / 10.0f, 1) + "</h4>";
-    content += datalayer_extended.meb.BMS_OBD_MIL ? "<h4>OBD MIL: ON!</h4>" : "<h4>OBD MIL: Off</h4>";
-    content +=
-        datalayer_extended.meb.BMS_error_lamp_req ? "<h4>Red error lamp: ON!</h4>" : "<h4>Red error lamp: Off</h4>";
-    content += datalayer_extended.meb.BMS_warning_lamp_req ? "<h4>Yellow warning lamp: ON!</h4>"
-                                                           : "<h4>Yellow warning lamp: Off</h4>";
-    content += "<h4>Isolation resistance: " + String(datalayer_extended.meb.isolation_resistance) + " kOhm</h4>";
-    content +=
-        datalayer_extended.meb.battery_heating ? "<h4>Battery heating: Active!</h4>" : "<h4>Battery heating: Off</h4>";
+    content += "</h4><h4>BMS voltage: " + String(meb_dl->BMS_voltage_dV / 10.0f, 1) + "</h4>";
+  }
+
+  void render_faults(String& content) {
+    content += meb_dl->BMS_OBD_MIL ? "<h4>OBD MIL: ON!</h4>" : "<h4>OBD MIL: Off</h4>";
+    content += meb_dl->BMS_error_lamp_req ? "<h4>Red error lamp: ON!</h4>" : "<h4>Red error lamp: Off</h4>";
+    content += meb_dl->BMS_warning_lamp_req ? "<h4>Yellow warning lamp: ON!</h4>" : "<h4>Yellow warning lamp: Off</h4>";
+    content += "<h4>Isolation resistance: " + String(meb_dl->isolation_resistance) + " kOhm</h4>";
+    content += meb_dl->battery_heating ? "<h4>Battery heating: Active!</h4>" : "<h4>Battery heating: Off</h4>";
     const char* rt_enum[] = {"No", "Error level 1", "Error level 2", "Error level 3"};
-    content += "<h4>Overcurrent: " + String(rt_enum[datalayer_extended.meb.rt_overcurrent & 0x03]) + "</h4>";
-    content += "<h4>CAN fault: " + String(rt_enum[datalayer_extended.meb.rt_CAN_fault & 0x03]) + "</h4>";
-    content += "<h4>Overcharged: " + String(rt_enum[datalayer_extended.meb.rt_overcharge & 0x03]) + "</h4>";
-    content += "<h4>SOC too high: " + String(rt_enum[datalayer_extended.meb.rt_SOC_high & 0x03]) + "</h4>";
-    content += "<h4>SOC too low: " + String(rt_enum[datalayer_extended.meb.rt_SOC_low & 0x03]) + "</h4>";
-    content += "<h4>SOC jumping: " + String(rt_enum[datalayer_extended.meb.rt_SOC_jumping & 0x03]) + "</h4>";
-    content += "<h4>Temp difference: " + String(rt_enum[datalayer_extended.meb.rt_temp_difference & 0x03]) + "</h4>";
-    content += "<h4>Cell overtemp: " + String(rt_enum[datalayer_extended.meb.rt_cell_overtemp & 0x03]) + "</h4>";
-    content += "<h4>Cell undertemp: " + String(rt_enum[datalayer_extended.meb.rt_cell_undertemp & 0x03]) + "</h4>";
-    content +=
-        "<h4>Battery overvoltage: " + String(rt_enum[datalayer_extended.meb.rt_battery_overvolt & 0x03]) + "</h4>";
-    content +=
-        "<h4>Battery undervoltage: " + String(rt_enum[datalayer_extended.meb.rt_battery_undervol & 0x03]) + "</h4>";
-    content += "<h4>Cell overvoltage: " + String(rt_enum[datalayer_extended.meb.rt_cell_overvolt & 0x03]) + "</h4>";
-    content += "<h4>Cell undervoltage: " + String(rt_enum[datalayer_extended.meb.rt_cell_undervol & 0x03]) + "</h4>";
-    content += "<h4>Cell imbalance: " + String(rt_enum[datalayer_extended.meb.rt_cell_imbalance & 0x03]) + "</h4>";
-    content +=
-        "<h4>Battery unathorized: " + String(rt_enum[datalayer_extended.meb.rt_battery_unathorized & 0x03]) + "</h4>";
+    content += "<h4>Overcurrent: " + String(rt_enum[meb_dl->rt_overcurrent & 0x03]) + "</h4>";
+    content += "<h4>CAN fault: " + String(rt_enum[meb_dl->rt_CAN_fault & 0x03]) + "</h4>";
+    content += "<h4>Overcharged: " + String(rt_enum[meb_dl->rt_overcharge & 0x03]) + "</h4>";
+    content += "<h4>SOC too high: " + String(rt_enum[meb_dl->rt_SOC_high & 0x03]) + "</h4>";
+    content += "<h4>SOC too low: " + String(rt_enum[meb_dl->rt_SOC_low & 0x03]) + "</h4>";
+    content += "<h4>SOC jumping: " + String(rt_enum[meb_dl->rt_SOC_jumping & 0x03]) + "</h4>";
+    content += "<h4>Temp difference: " + String(rt_enum[meb_dl->rt_temp_difference & 0x03]) + "</h4>";
+    content += "<h4>Cell overtemp: " + String(rt_enum[meb_dl->rt_cell_overtemp & 0x03]) + "</h4>";
+    content += "<h4>Cell undertemp: " + String(rt_enum[meb_dl->rt_cell_undertemp & 0x03]) + "</h4>";
+    content += "<h4>Battery overvoltage: " + String(rt_enum[meb_dl->rt_battery_overvolt & 0x03]) + "</h4>";
+    content += "<h4>Battery undervoltage: " + String(rt_enum[meb_dl->rt_battery_undervol & 0x03]) + "</h4>";
+    content += "<h4>Cell overvoltage: " + String(rt_enum[meb_dl->rt_cell_overvolt & 0x03]) + "</h4>";
+    content += "<h4>Cell undervoltage: " + String(rt_enum[meb_dl->rt_cell_undervol & 0x03]) + "</h4>";
+    content += "<h4>Cell imbalance: " + String(rt_enum[meb_dl->rt_cell_imbalance & 0x03]) + "</h4>";
+    content += "<h4>Battery unathorized: " + String(rt_enum[meb_dl->rt_battery_unathorized & 0x03]) + "</h4>";
+  }
+
+  void render_temperatures(String& content) {
     content += "<h4>Battery temperature: ";
-    if (datalayer_extended.meb.battery_temperature_dC == 875) {  //Raw value 255
+    if (meb_dl->battery_temperature_dC == 875) {  //Raw value 255
       content += "ERROR</h4>";
-    } else if (datalayer_extended.meb.battery_temperature_dC == 870) {  //Raw value 254
+    } else if (meb_dl->battery_temperature_dC == 870) {  //Raw value 254
       content += "INIT</h4>";
     } else {
-      content += String(datalayer_extended.meb.battery_temperature_dC / 10.f, 1) + " &deg;C</h4>";
+      content += String(meb_dl->battery_temperature_dC / 10.f, 1) + " &deg;C</h4>";
     }
 
     for (int i = 0; i < 3; i++) {
       content += "<h4>Temperature points " + String(i * 6 + 1) + "-" + String(i * 6 + 6) + " :";
       for (int j = 0; j < 6; j++)
-        content += " &nbsp;" + String(datalayer_extended.meb.temp_points[i * 6 + j], 1);
+        content += " &nbsp;" + String(meb_dl->temp_points[i * 6 + j], 1);
       content += " &deg;C</h4>";
     }
     bool temps_done = false;
     for (int i = 0; i < 7 && !temps_done; i++) {
       content += "<h4>Cell temperatures " + String(i * 8 + 1) + "-" + String(i * 8 + 8) + " :";
       for (int j = 0; j < 8; j++) {
-        if (datalayer_extended.meb.celltemperature_dC[i * 8 + j] == 865) {
+        if (meb_dl->celltemperature_dC[i * 8 + j] == 865) {
           temps_done = true;
           break;
         } else {
-          content += " &nbsp;" + String(datalayer_extended.meb.celltemperature_dC[i * 8 + j] / 10.f, 1);
+          content += " &nbsp;" + String(meb_dl->celltemperature_dC[i * 8 + j] / 10.f, 1);
         }
       }
       content += " &deg;C</h4>";
@@ -285,9 +296,9 @@ class MebHtmlRenderer : public BatteryHtmlRenderer {
         "<h4>Total charged: " + String(datalayer.battery.status.total_charged_battery_Wh / 1000.0, 1) + " kWh</h4>";
     content += "<h4>Total discharged: " + String(datalayer.battery.status.total_discharged_battery_Wh / 1000.0, 1) +
                " kWh</h4>";
-
-    return content;
   }
+
+  DATALAYER_INFO_MEB* meb_dl;
 };
 
 #endif
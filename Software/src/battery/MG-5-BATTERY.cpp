@@ -212,7 +212,7 @@ void Mg5Battery::
   }
 }
 
-void Mg5Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void Mg5Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   // We start polling with UDS ID 0x7DF, the generic broadcast one. Our first
   // reply will indicate what the BMS-specific one is, which we switch to.
   if (uds_address == 0x7DF && rx_frame.ID == 0x789) {
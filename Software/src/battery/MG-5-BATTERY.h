@@ -8,7 +8,7 @@
 class Mg5Battery : public CanBattery {
  public:
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void update_soc(uint16_t soc_times_ten);
   virtual void transmit_can(unsigned long currentMillis);
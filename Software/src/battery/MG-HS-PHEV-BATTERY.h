@@ -15,7 +15,7 @@ class MgHsPHEVBattery : public CanBattery {
   MgHsPHEVBattery() { datalayer_battery = &datalayer.battery; }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
@@ -223,7 +223,7 @@ void NissanLeafBattery::
   }
 }
 
-void NissanLeafBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void NissanLeafBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x1DB:
       if (is_message_corrupt(rx_frame)) {
@@ -392,17 +392,9 @@ void NissanLeafBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
           memcpy(datalayer_battery->status.cell_voltages_mV, battery_cell_voltages, 96 * sizeof(uint16_t));
 
           //calculate min/max voltages
-          battery_min_max_voltage[0] = 9999;
-          battery_min_max_voltage[1] = 0;
-          for (battery_cellcounter = 0; battery_cellcounter < 96; battery_cellcounter++) {
-            if (battery_min_max_voltage[0] > battery_cell_voltages[battery_cellcounter])
-              battery_min_max_voltage[0] = battery_cell_voltages[battery_cellcounter];
-            if (battery_min_max_voltage[1] < battery_cell_voltages[battery_cellcounter])
-              battery_min_max_voltage[1] = battery_cell_voltages[battery_cellcounter];
-          }
-
-          datalayer_battery->status.cell_max_voltage_mV = battery_min_max_voltage[1];
-          datalayer_battery->status.cell_min_voltage_mV = battery_min_max_voltage[0];
+          Cell_Statistics cells = compute_cell_statistics(battery_cell_voltages, 96, 0);
+          datalayer_battery->status.cell_max_voltage_mV = cells.max_mV;
+          datalayer_battery->status.cell_min_voltage_mV = cells.min_mV;
 
           break;
         }
@@ -810,7 +802,7 @@ void NissanLeafBattery::transmit_can(unsigned long currentMillis) {
   }
 }
 
-uint8_t NissanLeafBattery::calculate_crc(CAN_frame& rx_frame) {
+uint8_t NissanLeafBattery::calculate_crc(const CAN_frame& rx_frame) {
   uint8_t crc = 0;
   for (uint8_t j = 0; j < 7; j++) {
     crc = crctable_nissan_leaf[(crc ^ static_cast<uint8_t>(rx_frame.data.u8[j])) % 256];
@@ -818,7 +810,7 @@ uint8_t NissanLeafBattery::calculate_crc(CAN_frame& rx_frame) {
   return crc;
 }
 
-bool NissanLeafBattery::is_message_corrupt(CAN_frame rx_frame) {
+bool NissanLeafBattery::is_message_corrupt(const CAN_frame& rx_frame) {
   uint8_t crc = calculate_crc(rx_frame);
   return crc != rx_frame.data.u8[7];
 }
@@ -11,15 +11,15 @@ extern bool user_selected_LEAF_interlock_mandatory;
 class NissanLeafBattery : public CanBattery {
  public:
   // Use the default constructor to create the first or single battery.battery_Total_Voltage2
-  NissanLeafBattery() {
+  NissanLeafBattery() : renderer(datalayer_extended.nissanleaf.get()) {
     datalayer_battery = &datalayer.battery;
     allows_contactor_closing = &datalayer.system.status.battery_allows_contactor_closing;
-    datalayer_nissan = &datalayer_extended.nissanleaf;
+    datalayer_nissan = datalayer_extended.nissanleaf.get();
   }
   // Use this constructor for the second battery.
   NissanLeafBattery(DATALAYER_BATTERY_TYPE* datalayer_ptr, DATALAYER_INFO_NISSAN_LEAF* extended,
                     CAN_Interface targetCan)
-      : CanBattery(targetCan) {
+      : CanBattery(targetCan), renderer(datalayer_extended.nissanleaf.get()) {
     datalayer_battery = datalayer_ptr;
     allows_contactor_closing = nullptr;
     datalayer_nissan = extended;
@@ -28,7 +28,7 @@ class NissanLeafBattery : public CanBattery {
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
@@ -46,7 +46,7 @@ class NissanLeafBattery : public CanBattery {
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
   static constexpr const char* Name = "Nissan LEAF battery";
 
-  uint8_t calculate_crc(CAN_frame& frame);
+  uint8_t calculate_crc(const CAN_frame& frame);
 
  private:
   bool UserRequestDTCreset = false;
@@ -59,7 +59,7 @@ class NissanLeafBattery : public CanBattery {
 
   NissanLeafHtmlRenderer renderer;
 
-  bool is_message_corrupt(CAN_frame rx_frame);
+  bool is_message_corrupt(const CAN_frame& rx_frame);
   void clearSOH(void);
 
   DATALAYER_BATTERY_TYPE* datalayer_battery;
@@ -186,8 +186,6 @@ class NissanLeafBattery : public CanBattery {
   uint8_t hold_off_with_polling_10seconds = 2;  //Paused for 20 seconds on startup
   uint16_t battery_cell_voltages[96];           //array with all the cellvoltages
   bool battery_balancing_shunts[96];            //array with all the balancing resistors
-  uint8_t battery_cellcounter = 0;
-  uint16_t battery_min_max_voltage[2];  //contains cell min[0] and max[1] values in mV
   uint16_t battery_HX = 0;              //Internal resistance
   uint16_t battery_insulation = 0;      //Insulation resistance
   uint16_t battery_temp_raw_1 = 718;
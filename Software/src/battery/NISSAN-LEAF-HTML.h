@@ -8,11 +8,13 @@
 
 class NissanLeafHtmlRenderer : public BatteryHtmlRenderer {
  public:
+  NissanLeafHtmlRenderer(DATALAYER_INFO_NISSAN_LEAF* dl) : nissan_dl(dl) {}
+
   String get_status_html() {
     String content;
 
     content += "<h4>LEAF generation: ";
-    switch (datalayer_extended.nissanleaf.LEAF_gen) {
+    switch (nissan_dl->LEAF_gen) {
       case 0:
         content += String("ZE0</h4>");
         break;
@@ -26,47 +28,48 @@ class NissanLeafHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Unknown</h4>");
     }
     char readableSerialNumber[16];  // One extra space for null terminator
-    memcpy(readableSerialNumber, datalayer_extended.nissanleaf.BatterySerialNumber,
-           sizeof(datalayer_extended.nissanleaf.BatterySerialNumber));
+    memcpy(readableSerialNumber, nissan_dl->BatterySerialNumber, sizeof(nissan_dl->BatterySerialNumber));
     readableSerialNumber[15] = '\0';  // Null terminate the string
     content += "<h4>Serial number: " + String(readableSerialNumber) + "</h4>";
     char readablePartNumber[8];  // One extra space for null terminator
-    memcpy(readablePartNumber, datalayer_extended.nissanleaf.BatteryPartNumber,
-           sizeof(datalayer_extended.nissanleaf.BatteryPartNumber));
+    memcpy(readablePartNumber, nissan_dl->BatteryPartNumber, sizeof(nissan_dl->BatteryPartNumber));
     readablePartNumber[7] = '\0';  // Null terminate the string
     content += "<h4>Part number: " + String(readablePartNumber) + "</h4>";
     char readableBMSID[9];  // One extra space for null terminator
-    memcpy(readableBMSID, datalayer_extended.nissanleaf.BMSIDcode, sizeof(datalayer_extended.nissanleaf.BMSIDcode));
+    memcpy(readableBMSID, nissan_dl->BMSIDcode, sizeof(nissan_dl->BMSIDcode));
     readableBMSID[8] = '\0';  // Null terminate the string
     content += "<h4>BMS ID: " + String(readableBMSID) + "</h4>";
-    content += "<h4>GIDS: " + String(datalayer_extended.nissanleaf.GIDS) + "</h4>";
-    content += "<h4>HX: " + String(datalayer_extended.nissanleaf.battery_HX) + "</h4>";
-    content += "<h4>Regen kW: " + String(datalayer_extended.nissanleaf.ChargePowerLimit) + "</h4>";
-    content += "<h4>Charge kW: " + String(datalayer_extended.nissanleaf.MaxPowerForCharger) + "</h4>";
-    content += "<h4>Interlock: " + String(datalayer_extended.nissanleaf.Interlock) + "</h4>";
-    content += "<h4>Insulation: " + String(datalayer_extended.nissanleaf.Insulation) + "</h4>";
-    content += "<h4>Relay cut request: " + String(datalayer_extended.nissanleaf.RelayCutRequest) + "</h4>";
-    content += "<h4>Failsafe status: " + String(datalayer_extended.nissanleaf.FailsafeStatus) + "</h4>";
-    content += "<h4>Fully charged: " + String(datalayer_extended.nissanleaf.Full) + "</h4>";
-    content += "<h4>Battery empty: " + String(datalayer_extended.nissanleaf.Empty) + "</h4>";
-    content += "<h4>Main relay ON: " + String(datalayer_extended.nissanleaf.MainRelayOn) + "</h4>";
-    content += "<h4>Heater present: " + String(datalayer_extended.nissanleaf.HeatExist) + "</h4>";
-    content += "<h4>Heating stopped: " + String(datalayer_extended.nissanleaf.HeatingStop) + "</h4>";
-    content += "<h4>Heating started: " + String(datalayer_extended.nissanleaf.HeatingStart) + "</h4>";
-    content += "<h4>Heating requested: " + String(datalayer_extended.nissanleaf.HeaterSendRequest) + "</h4>";
-    content += "<h4>Temperature 1: " + String(datalayer_extended.nissanleaf.temperature1 / 10.0) + " &deg;C</h4>";
-    content += "<h4>Temperature 2: " + String(datalayer_extended.nissanleaf.temperature2 / 10.0) + " &deg;C</h4>";
-    if (datalayer_extended.nissanleaf.LEAF_gen == 0) {
-      content += "<h4>Temperature 3: " + String(datalayer_extended.nissanleaf.temperature3 / 10.0) + " &deg;C</h4>";
+    content += "<h4>GIDS: " + String(nissan_dl->GIDS) + "</h4>";
+    content += "<h4>HX: " + String(nissan_dl->battery_HX) + "</h4>";
+    content += "<h4>Regen kW: " + String(nissan_dl->ChargePowerLimit) + "</h4>";
+    content += "<h4>Charge kW: " + String(nissan_dl->MaxPowerForCharger) + "</h4>";
+    content += "<h4>Interlock: " + String(nissan_dl->Interlock) + "</h4>";
+    content += "<h4>Insulation: " + String(nissan_dl->Insulation) + "</h4>";
+    content += "<h4>Relay cut request: " + String(nissan_dl->RelayCutRequest) + "</h4>";
+    content += "<h4>Failsafe status: " + String(nissan_dl->FailsafeStatus) + "</h4>";
+    content += "<h4>Fully charged: " + String(nissan_dl->Full) + "</h4>";
+    content += "<h4>Battery empty: " + String(nissan_dl->Empty) + "</h4>";
+    content += "<h4>Main relay ON: " + String(nissan_dl->MainRelayOn) + "</h4>";
+    content += "<h4>Heater present: " + String(nissan_dl->HeatExist) + "</h4>";
+    content += "<h4>Heating stopped: " + String(nissan_dl->HeatingStop) + "</h4>";
+    content += "<h4>Heating started: " + String(nissan_dl->HeatingStart) + "</h4>";
+    content += "<h4>Heating requested: " + String(nissan_dl->HeaterSendRequest) + "</h4>";
+    content += "<h4>Temperature 1: " + String(nissan_dl->temperature1 / 10.0) + " &deg;C</h4>";
+    content += "<h4>Temperature 2: " + String(nissan_dl->temperature2 / 10.0) + " &deg;C</h4>";
+    if (nissan_dl->LEAF_gen == 0) {
+      content += "<h4>Temperature 3: " + String(nissan_dl->temperature3 / 10.0) + " &deg;C</h4>";
     }
-    content += "<h4>Temperature 4: " + String(datalayer_extended.nissanleaf.temperature4 / 10.0) + " &deg;C</h4>";
-    content += "<h4>CryptoChallenge: " + String(datalayer_extended.nissanleaf.CryptoChallenge) + "</h4>";
-    content += "<h4>SolvedChallenge: " + String(datalayer_extended.nissanleaf.SolvedChallengeMSB) +
-               String(datalayer_extended.nissanleaf.SolvedChallengeLSB) + "</h4>";
-    content += "<h4>Challenge failed: " + String(datalayer_extended.nissanleaf.challengeFailed) + "</h4>";
+    content += "<h4>Temperature 4: " + String(nissan_dl->temperature4 / 10.0) + " &deg;C</h4>";
+    content += "<h4>CryptoChallenge: " + String(nissan_dl->CryptoChallenge) + "</h4>";
+    content += "<h4>SolvedChallenge: " + String(nissan_dl->SolvedChallengeMSB) + String(nissan_dl->SolvedChallengeLSB) +
+               "</h4>";
+    content += "<h4>Challenge failed: " + String(nissan_dl->challengeFailed) + "</h4>";
 
     return content;
   }
+
+ private:
+  DATALAYER_INFO_NISSAN_LEAF* nissan_dl;
 };
 
 #endif
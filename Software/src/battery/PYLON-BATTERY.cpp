@@ -57,7 +57,7 @@ void PylonBattery::update_values() {
   datalayer_battery->info.min_design_voltage_dV = discharge_cutoff_voltage;
 }
 
-void PylonBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void PylonBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
 
   switch (rx_frame.ID) {
     case EMUS_BASE_ID: {
@@ -231,11 +231,30 @@ void PylonBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void PylonBattery::transmit_can(unsigned long currentMillis) {
-  // Send 1s CAN Message
-  if (currentMillis - previousMillis1000 >= INTERVAL_1_S) {
-    previousMillis1000 = currentMillis;
+void PylonBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, "Pylon / Dyness compatible battery", 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer_battery->info.number_of_cells = 2;
+  if (user_selected_max_pack_voltage_dV > 0) {
+    datalayer_battery->info.max_design_voltage_dV = user_selected_max_pack_voltage_dV;
+  }
+  if (user_selected_min_pack_voltage_dV > 0) {
+    datalayer_battery->info.min_design_voltage_dV = user_selected_min_pack_voltage_dV;
+  }
+  if (user_selected_max_cell_voltage_mV > 0) {
+    datalayer_battery->info.max_cell_voltage_mV = user_selected_max_cell_voltage_mV;
+  }
+  if (user_selected_min_cell_voltage_mV > 0) {
+    datalayer_battery->info.min_cell_voltage_mV = user_selected_min_cell_voltage_mV;
+  }
+  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+
+  if (allows_contactor_closing) {
+    *allows_contactor_closing = true;
+  }
 
+  // Send 1s CAN Message
+  transmit_every(INTERVAL_1_S, 4, [this](unsigned long currentMillis) {
     PYLON_8200.data.u8[0] = 0xAA;  //AA = Quit sleep, 55 = Goto sleep
 
     PYLON_8210.data.u8[0] = 0xAA;  //TODO: how should we control this?
@@ -261,38 +280,12 @@ void PylonBattery::transmit_can(unsigned long currentMillis) {
     /*00 Request Ensamble Information (Battery will respond 0x42XX messages)
     01 Request Cellvoltages (Battery will respond 0x5XXX messages)
     02 Request System equipment info (Battery will respond 0x73XX messages)*/
-  }
-
+  });
   // Poll for individual cell voltages every 5 seconds
-  if (currentMillis - previousMillis5000 >= INTERVAL_5_S) {
-    previousMillis5000 = currentMillis;
-
+  transmit_every(INTERVAL_5_S, 2, [this](unsigned long currentMillis) {
     // Request cell voltage data from EMUS BMS
     transmit_can_frame(&EMUS_CELL_VOLTAGE_REQUEST);
     // Request cell balancing status from EMUS BMS
     transmit_can_frame(&EMUS_CELL_BALANCING_REQUEST);
-  }
-}
-
-void PylonBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, "Pylon / Dyness compatible battery", 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer_battery->info.number_of_cells = 2;
-  if (user_selected_max_pack_voltage_dV > 0) {
-    datalayer_battery->info.max_design_voltage_dV = user_selected_max_pack_voltage_dV;
-  }
-  if (user_selected_min_pack_voltage_dV > 0) {
-    datalayer_battery->info.min_design_voltage_dV = user_selected_min_pack_voltage_dV;
-  }
-  if (user_selected_max_cell_voltage_mV > 0) {
-    datalayer_battery->info.max_cell_voltage_mV = user_selected_max_cell_voltage_mV;
-  }
-  if (user_selected_min_cell_voltage_mV > 0) {
-    datalayer_battery->info.min_cell_voltage_mV = user_selected_min_cell_voltage_mV;
-  }
-  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
-
-  if (allows_contactor_closing) {
-    *allows_contactor_closing = true;
-  }
+  });
 }
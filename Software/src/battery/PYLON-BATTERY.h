@@ -27,9 +27,10 @@ class PylonBattery : public CanBattery {
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Pylon /Dyness compatible battery";
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
@@ -51,9 +52,6 @@ class PylonBattery : public CanBattery {
   // If not null, this battery listens to this boolean to determine whether contactor closing is allowed
   bool* contactor_closing_allowed;
 
-  unsigned long previousMillis1000 = 0;  // will store last time a 1s CAN Message was sent
-  unsigned long previousMillis5000 = 0;  // will store last time a 5s CAN Message was sent
-
   //Actual content messages
   CAN_frame PYLON_3010 = {.FD = false,
                           .ext_ID = true,
@@ -76,7 +76,7 @@ void RangeRoverPhevBattery::update_values() {
   datalayer.battery.info.min_design_voltage_dV = DischargeVoltageLimit * 10;
 }
 
-void RangeRoverPhevBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void RangeRoverPhevBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x080:  // 15ms
       StatusCAT5BPOChg = (rx_frame.data.u8[0] & 0x01);
@@ -197,15 +197,6 @@ void RangeRoverPhevBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void RangeRoverPhevBattery::transmit_can(unsigned long currentMillis) {
-  // Send 50ms CAN Message
-  if (currentMillis - previousMillis50ms >= INTERVAL_50_MS) {
-    previousMillis50ms = currentMillis;
-
-    transmit_can_frame(&RANGE_ROVER_18B);
-  }
-}
-
 void RangeRoverPhevBattery::setup(void) {  // Performs one time setup at startup
   strncpy(datalayer.system.info.battery_protocol, Name, 63);
   datalayer.system.info.battery_protocol[63] = '\0';
@@ -214,4 +205,6 @@ void RangeRoverPhevBattery::setup(void) {  // Performs one time setup at startup
   datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
   datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
   datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+
+  transmit_every(INTERVAL_50_MS, &RANGE_ROVER_18B);
 }
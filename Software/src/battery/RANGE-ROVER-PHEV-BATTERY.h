@@ -6,9 +6,10 @@
 class RangeRoverPhevBattery : public CanBattery {
  public:
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Range Rover 13kWh PHEV battery (L494/L405)";
 
  private:
@@ -19,7 +20,6 @@ class RangeRoverPhevBattery : public CanBattery {
   static const int MIN_CELL_VOLTAGE_MV = 2700;  //Battery is put into emergency stop if one cell goes below this value
   static const int MAX_CELL_DEVIATION_MV = 150;
 
-  unsigned long previousMillis50ms = 0;  // will store last time a 50ms CAN Message was sent
 
   //CAN content from battery
   bool StatusCAT5BPOChg = false;
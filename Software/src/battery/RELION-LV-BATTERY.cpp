@@ -111,7 +111,7 @@ void RelionBattery::update_values() {
   datalayer_battery->status.cell_min_voltage_mV = min_cell_voltage;
 }
 
-void RelionBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void RelionBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x02018100:  //ID1 (Example frame 10 08 01 F0 00 00 00 00)
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -214,22 +214,6 @@ void RelionBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void RelionBattery::transmit_can(unsigned long currentMillis) {
-
-  // Send 500ms CAN Message
-  if (currentMillis - previousMillis500ms >= INTERVAL_500_MS) {
-    previousMillis500ms = currentMillis;
-
-    if ((datalayer.system.status.system_status == FAULT) || !(*allows_contactor_closing)) {
-      RELION_CONTACTOR_MESSAGE.data.u8[0] = 0x02;  // Open contactors in case of fault
-    } else {
-      RELION_CONTACTOR_MESSAGE.data.u8[0] = 0x01;  // Close contactors if no fault
-    }
-
-    transmit_can_frame(&RELION_CONTACTOR_MESSAGE);
-  }
-}
-
 void RelionBattery::setup(void) {  // Performs one time setup at startup
   strncpy(datalayer.system.info.battery_protocol, Name, 63);
   datalayer.system.info.battery_protocol[63] = '\0';
@@ -260,4 +244,14 @@ void RelionBattery::setup(void) {  // Performs one time setup at startup
   }
 
   datalayer.system.status.battery_allows_contactor_closing = true;
+
+  transmit_every(INTERVAL_500_MS, 1, [this](unsigned long currentMillis) {
+    if ((datalayer.system.status.system_status == FAULT) || !(*allows_contactor_closing)) {
+      RELION_CONTACTOR_MESSAGE.data.u8[0] = 0x02;  // Open contactors in case of fault
+    } else {
+      RELION_CONTACTOR_MESSAGE.data.u8[0] = 0x01;  // Close contactors if no fault
+    }
+
+    transmit_can_frame(&RELION_CONTACTOR_MESSAGE, CAN_TX_SAFETY);
+  });
 }
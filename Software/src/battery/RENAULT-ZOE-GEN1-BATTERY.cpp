@@ -74,7 +74,7 @@ void RenaultZoeGen1Battery::
   }
 }
 
-void RenaultZoeGen1Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void RenaultZoeGen1Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x155:  //10ms - Charging power, current and SOC - Confirmed sent by: Fluence ZE40, Zoe 22/41kWh, Kangoo 33kWh
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -564,11 +564,19 @@ void RenaultZoeGen1Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void RenaultZoeGen1Battery::transmit_can(unsigned long currentMillis) {
+void RenaultZoeGen1Battery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.system.status.battery_allows_contactor_closing = true;
+  datalayer_battery->info.number_of_cells = 96;
+  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
+  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
+  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
 
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
+  transmit_every(INTERVAL_100_MS, 1, [this](unsigned long currentMillis) {
     transmit_can_frame(&ZOE_423);
 
     if ((counter_423 / 5) % 2 == 0) {  // Alternate every 5 messages between these two
@@ -579,11 +587,9 @@ void RenaultZoeGen1Battery::transmit_can(unsigned long currentMillis) {
       ZOE_423.data.u8[6] = 0x5D;
     }
     counter_423 = (counter_423 + 1) % 10;
-  }
+  });
   // 250ms CAN handling
-  if (currentMillis - previousMillis250 >= INTERVAL_250_MS) {
-    previousMillis250 = currentMillis;
-
+  transmit_every(INTERVAL_250_MS, 1, [this](unsigned long currentMillis) {
     switch (group) {
       case 0:
         current_poll = GROUP1_CELLVOLTAGES_1_POLL;
@@ -617,17 +623,5 @@ void RenaultZoeGen1Battery::transmit_can(unsigned long currentMillis) {
     } else {
       transmit_can_frame(&ZOE_POLL_79B);
     }
-  }
-}
-
-void RenaultZoeGen1Battery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.system.status.battery_allows_contactor_closing = true;
-  datalayer_battery->info.number_of_cells = 96;
-  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
-  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
-  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  });
 }
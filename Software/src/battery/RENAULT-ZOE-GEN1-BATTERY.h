@@ -10,7 +10,7 @@ class RenaultZoeGen1Battery : public CanBattery {
  public:
   // Use this constructor for the second battery.
   RenaultZoeGen1Battery(DATALAYER_BATTERY_TYPE* datalayer_ptr, DATALAYER_INFO_ZOE* extended, CAN_Interface targetCan)
-      : CanBattery(targetCan) {
+      : CanBattery(targetCan), renderer(datalayer_extended.zoe.get()) {
     datalayer_battery = datalayer_ptr;
     allows_contactor_closing = nullptr;
     datalayer_zoe = extended;
@@ -19,16 +19,17 @@ class RenaultZoeGen1Battery : public CanBattery {
   }
 
   // Use the default constructor to create the first or single battery.
-  RenaultZoeGen1Battery() {
+  RenaultZoeGen1Battery() : renderer(datalayer_extended.zoe.get()) {
     datalayer_battery = &datalayer.battery;
     allows_contactor_closing = &datalayer.system.status.battery_allows_contactor_closing;
-    datalayer_zoe = &datalayer_extended.zoe;
+    datalayer_zoe = datalayer_extended.zoe.get();
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Renault Zoe Gen1 22/40kWh";
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
@@ -53,8 +54,6 @@ class RenaultZoeGen1Battery : public CanBattery {
   // If not null, this battery decides when the contactor can be closed and writes the value here.
   bool* allows_contactor_closing;
 
-  unsigned long previousMillis100 = 0;  // will store last time a 100ms CAN Message was sent
-  unsigned long previousMillis250 = 0;  // will store last time a 250ms CAN Message was sent
   uint8_t counter_423 = 0;
 
   CAN_frame ZOE_423 = {.FD = false,
@@ -7,21 +7,26 @@
 
 class RenaultZoeGen1HtmlRenderer : public BatteryHtmlRenderer {
  public:
+  RenaultZoeGen1HtmlRenderer(DATALAYER_INFO_ZOE* dl) : zoe_dl(dl) {}
+
   String get_status_html() {
     String content;
 
-    content += "<h4>CUV " + String(datalayer_extended.zoe.CUV) + "</h4>";
-    content += "<h4>HVBIR " + String(datalayer_extended.zoe.HVBIR) + "</h4>";
-    content += "<h4>HVBUV " + String(datalayer_extended.zoe.HVBUV) + "</h4>";
-    content += "<h4>EOCR " + String(datalayer_extended.zoe.EOCR) + "</h4>";
-    content += "<h4>HVBOC " + String(datalayer_extended.zoe.HVBOC) + "</h4>";
-    content += "<h4>HVBOT " + String(datalayer_extended.zoe.HVBOT) + "</h4>";
-    content += "<h4>HVBOV " + String(datalayer_extended.zoe.HVBOV) + "</h4>";
-    content += "<h4>COV " + String(datalayer_extended.zoe.COV) + "</h4>";
-    content += "<h4>Battery mileage " + String(datalayer_extended.zoe.mileage_km) + " km</h4>";
-    content += "<h4>Alltime energy " + String(datalayer_extended.zoe.alltime_kWh) + " kWh</h4>";
+    content += "<h4>CUV " + String(zoe_dl->CUV) + "</h4>";
+    content += "<h4>HVBIR " + String(zoe_dl->HVBIR) + "</h4>";
+    content += "<h4>HVBUV " + String(zoe_dl->HVBUV) + "</h4>";
+    content += "<h4>EOCR " + String(zoe_dl->EOCR) + "</h4>";
+    content += "<h4>HVBOC " + String(zoe_dl->HVBOC) + "</h4>";
+    content += "<h4>HVBOT " + String(zoe_dl->HVBOT) + "</h4>";
+    content += "<h4>HVBOV " + String(zoe_dl->HVBOV) + "</h4>";
+    content += "<h4>COV " + String(zoe_dl->COV) + "</h4>";
+    content += "<h4>Battery mileage " + String(zoe_dl->mileage_km) + " km</h4>";
+    content += "<h4>Alltime energy " + String(zoe_dl->alltime_kWh) + " kWh</h4>";
     return content;
   }
+
+ private:
+  DATALAYER_INFO_ZOE* zoe_dl;
 };
 
 #endif
@@ -23,7 +23,7 @@ https://github.com/ljames28/Renault-Zoe-PH2-ZE50-Canbus-LBC-Information?tab=read
 https://github.com/fesch/CanZE/tree/master/app/src/main/assets/ZOE_Ph2
 */
 
-uint8_t RenaultZoeGen2Battery::calculate_crc_zoe(CAN_frame& rx_frame, uint8_t crc_xor) {
+uint8_t RenaultZoeGen2Battery::calculate_crc_zoe(const CAN_frame& rx_frame, uint8_t crc_xor) {
   uint8_t crc = 0;  //init value 0x00
   for (uint8_t j = 0; j < 7; j++) {
     crc = crc8_table_SAE_J1850_ZER0[(crc ^ static_cast<uint8_t>(rx_frame.data.u8[j])) & 0xFF];
@@ -31,7 +31,7 @@ uint8_t RenaultZoeGen2Battery::calculate_crc_zoe(CAN_frame& rx_frame, uint8_t cr
   return crc ^ crc_xor;
 }
 
-bool RenaultZoeGen2Battery::is_message_corrupt(CAN_frame rx_frame, uint8_t crc_xor) {
+bool RenaultZoeGen2Battery::is_message_corrupt(const CAN_frame& rx_frame, uint8_t crc_xor) {
   uint8_t crc = calculate_crc_zoe(rx_frame, crc_xor);
   return crc != rx_frame.data.u8[7];
 }
@@ -98,49 +98,49 @@ void RenaultZoeGen2Battery::update_values() {
   }*/
 
   // Update webserver datalayer
-  datalayer_extended.zoePH2.battery_soc = battery_soc;
-  datalayer_extended.zoePH2.battery_usable_soc = battery_usable_soc;
-  datalayer_extended.zoePH2.battery_soh = battery_soh;
-  datalayer_extended.zoePH2.battery_pack_voltage = battery_pack_voltage_polled_dV;
-  datalayer_extended.zoePH2.battery_max_cell_voltage = battery_max_cell_voltage_polled;
-  datalayer_extended.zoePH2.battery_min_cell_voltage = battery_min_cell_voltage_polled;
-  datalayer_extended.zoePH2.battery_12v = battery_12v;
-  datalayer_extended.zoePH2.battery_avg_temp = battery_avg_temp;
-  datalayer_extended.zoePH2.battery_min_temp = battery_min_temp;
-  datalayer_extended.zoePH2.battery_max_temp = battery_max_temp;
-  datalayer_extended.zoePH2.battery_max_power = battery_max_power;
-  datalayer_extended.zoePH2.battery_interlock = battery_interlock_polled;
-  datalayer_extended.zoePH2.battery_kwh = battery_kwh;
-  datalayer_extended.zoePH2.battery_current = battery_current;
-  datalayer_extended.zoePH2.battery_current_offset = battery_current_offset;
-  datalayer_extended.zoePH2.battery_max_generated = battery_max_generated;
-  datalayer_extended.zoePH2.battery_max_available = battery_max_available;
-  datalayer_extended.zoePH2.battery_current_voltage = battery_current_voltage;
-  datalayer_extended.zoePH2.battery_charging_status = battery_charging_status;
-  datalayer_extended.zoePH2.battery_remaining_charge = battery_remaining_charge;
-  datalayer_extended.zoePH2.battery_balance_capacity_total = battery_balance_capacity_total;
-  datalayer_extended.zoePH2.battery_balance_time_total = battery_balance_time_total;
-  datalayer_extended.zoePH2.battery_balance_capacity_sleep = battery_balance_capacity_sleep;
-  datalayer_extended.zoePH2.battery_balance_time_sleep = battery_balance_time_sleep;
-  datalayer_extended.zoePH2.battery_balance_capacity_wake = battery_balance_capacity_wake;
-  datalayer_extended.zoePH2.battery_balance_time_wake = battery_balance_time_wake;
-  datalayer_extended.zoePH2.battery_bms_state = battery_bms_state;
-  datalayer_extended.zoePH2.battery_energy_complete = battery_energy_complete;
-  datalayer_extended.zoePH2.battery_energy_partial = battery_energy_partial;
-  datalayer_extended.zoePH2.battery_slave_failures = battery_slave_failures;
-  datalayer_extended.zoePH2.battery_mileage = battery_mileage;
-  datalayer_extended.zoePH2.battery_fan_speed = battery_fan_speed;
-  datalayer_extended.zoePH2.battery_fan_period = battery_fan_period;
-  datalayer_extended.zoePH2.battery_fan_control = battery_fan_control;
-  datalayer_extended.zoePH2.battery_fan_duty = battery_fan_duty;
-  datalayer_extended.zoePH2.battery_temporisation = battery_temporisation;
-  datalayer_extended.zoePH2.battery_time = battery_time;
-  datalayer_extended.zoePH2.battery_pack_time = battery_pack_time;
-  datalayer_extended.zoePH2.battery_soc_min = battery_soc_min;
-  datalayer_extended.zoePH2.battery_soc_max = battery_soc_max;
+  datalayer_zoePH2->battery_soc = battery_soc;
+  datalayer_zoePH2->battery_usable_soc = battery_usable_soc;
+  datalayer_zoePH2->battery_soh = battery_soh;
+  datalayer_zoePH2->battery_pack_voltage = battery_pack_voltage_polled_dV;
+  datalayer_zoePH2->battery_max_cell_voltage = battery_max_cell_voltage_polled;
+  datalayer_zoePH2->battery_min_cell_voltage = battery_min_cell_voltage_polled;
+  datalayer_zoePH2->battery_12v = battery_12v;
+  datalayer_zoePH2->battery_avg_temp = battery_avg_temp;
+  datalayer_zoePH2->battery_min_temp = battery_min_temp;
+  datalayer_zoePH2->battery_max_temp = battery_max_temp;
+  datalayer_zoePH2->battery_max_power = battery_max_power;
+  datalayer_zoePH2->battery_interlock = battery_interlock_polled;
+  datalayer_zoePH2->battery_kwh = battery_kwh;
+  datalayer_zoePH2->battery_current = battery_current;
+  datalayer_zoePH2->battery_current_offset = battery_current_offset;
+  datalayer_zoePH2->battery_max_generated = battery_max_generated;
+  datalayer_zoePH2->battery_max_available = battery_max_available;
+  datalayer_zoePH2->battery_current_voltage = battery_current_voltage;
+  datalayer_zoePH2->battery_charging_status = battery_charging_status;
+  datalayer_zoePH2->battery_remaining_charge = battery_remaining_charge;
+  datalayer_zoePH2->battery_balance_capacity_total = battery_balance_capacity_total;
+  datalayer_zoePH2->battery_balance_time_total = battery_balance_time_total;
+  datalayer_zoePH2->battery_balance_capacity_sleep = battery_balance_capacity_sleep;
+  datalayer_zoePH2->battery_balance_time_sleep = battery_balance_time_sleep;
+  datalayer_zoePH2->battery_balance_capacity_wake = battery_balance_capacity_wake;
+  datalayer_zoePH2->battery_balance_time_wake = battery_balance_time_wake;
+  datalayer_zoePH2->battery_bms_state = battery_bms_state;
+  datalayer_zoePH2->battery_energy_complete = battery_energy_complete;
+  datalayer_zoePH2->battery_energy_partial = battery_energy_partial;
+  datalayer_zoePH2->battery_slave_failures = battery_slave_failures;
+  datalayer_zoePH2->battery_mileage = battery_mileage;
+  datalayer_zoePH2->battery_fan_speed = battery_fan_speed;
+  datalayer_zoePH2->battery_fan_period = battery_fan_period;
+  datalayer_zoePH2->battery_fan_control = battery_fan_control;
+  datalayer_zoePH2->battery_fan_duty = battery_fan_duty;
+  datalayer_zoePH2->battery_temporisation = battery_temporisation;
+  datalayer_zoePH2->battery_time = battery_time;
+  datalayer_zoePH2->battery_pack_time = battery_pack_time;
+  datalayer_zoePH2->battery_soc_min = battery_soc_min;
+  datalayer_zoePH2->battery_soc_max = battery_soc_max;
 }
 
-void RenaultZoeGen2Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void RenaultZoeGen2Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x0F8:
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -397,7 +397,7 @@ void RenaultZoeGen2Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
 }
 
 void RenaultZoeGen2Battery::transmit_can(unsigned long currentMillis) {
-  if (datalayer_extended.zoePH2.UserRequestNVROLReset) {
+  if (datalayer_zoePH2->UserRequestNVROLReset) {
     // Send NVROL reset frames
     transmit_reset_nvrol_frames();
   }
@@ -435,7 +435,7 @@ void RenaultZoeGen2Battery::transmit_can(unsigned long currentMillis) {
   }
 
   // Send 200ms polling CAN Message (Only if not NVROL in progress)
-  if ((currentMillis - previousMillis200 >= INTERVAL_200_MS) && !datalayer_extended.zoePH2.UserRequestNVROLReset) {
+  if ((currentMillis - previousMillis200 >= INTERVAL_200_MS) && !datalayer_zoePH2->UserRequestNVROLReset) {
     previousMillis200 = currentMillis;
 
     // Update current poll from the array
@@ -541,7 +541,7 @@ void RenaultZoeGen2Battery::transmit_reset_nvrol_frames(void) {
       ZOE_373.data.u8[0] = 0x01;
       if ((millis() - startTimeNVROL) > INTERVAL_30_S) {
         // after sleeping, set the nvrol reset flag to false, to continue normal operation of sending CAN messages
-        datalayer_extended.zoePH2.UserRequestNVROLReset = false;
+        datalayer_zoePH2->UserRequestNVROLReset = false;
         // Wake battery back up
         ZOE_373.data.u8[0] = 0xC1;
         // reset state machine, we are done!
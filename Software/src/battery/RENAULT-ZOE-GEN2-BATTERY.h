@@ -9,7 +9,7 @@ class RenaultZoeGen2Battery : public CanBattery {
   // Use this constructor for the second battery.
   RenaultZoeGen2Battery(DATALAYER_BATTERY_TYPE* datalayer_ptr, DATALAYER_INFO_ZOE_PH2* extended,
                         CAN_Interface targetCan)
-      : CanBattery(targetCan) {
+      : CanBattery(targetCan), renderer(extended) {
     datalayer_battery = datalayer_ptr;
     allows_contactor_closing = nullptr;
     datalayer_zoePH2 = extended;
@@ -18,25 +18,25 @@ class RenaultZoeGen2Battery : public CanBattery {
   }
 
   // Use the default constructor to create the first or single battery.
-  RenaultZoeGen2Battery() {
+  RenaultZoeGen2Battery() : renderer(datalayer_extended.zoePH2.get()) {
     datalayer_battery = &datalayer.battery;
     allows_contactor_closing = &datalayer.system.status.battery_allows_contactor_closing;
-    datalayer_zoePH2 = &datalayer_extended.zoePH2;
+    datalayer_zoePH2 = datalayer_extended.zoePH2.get();
   }
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
   static constexpr const char* Name = "Renault Zoe Gen2 50kWh";
 
   bool supports_reset_NVROL() { return true; }
-  void reset_NVROL() { datalayer_extended.zoePH2.UserRequestNVROLReset = true; }
+  void reset_NVROL() { datalayer_zoePH2->UserRequestNVROLReset = true; }
   bool supports_reset_DTC() { return true; }
   void reset_DTC() { UserRequestedDTCReset = true; }
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
 
-  uint8_t calculate_crc_zoe(CAN_frame& frame, uint8_t crc_xor);
+  uint8_t calculate_crc_zoe(const CAN_frame& frame, uint8_t crc_xor);
 
  private:
   RenaultZoeGen2HtmlRenderer renderer;
@@ -49,7 +49,7 @@ class RenaultZoeGen2Battery : public CanBattery {
 
   bool UserRequestedDTCReset = false;
 
-  bool is_message_corrupt(CAN_frame rx_frame, uint8_t crc_xor);
+  bool is_message_corrupt(const CAN_frame& rx_frame, uint8_t crc_xor);
 
   static const int MAX_PACK_VOLTAGE_DV = 4100;  //5000 = 500.0V
   static const int MIN_PACK_VOLTAGE_DV = 3000;
@@ -15,7 +15,7 @@ The battery has 3x CAN channels
 - Battery CAN (500kbps) lots of content, not required for operation 
 */
 
-uint8_t RivianBattery::calculateCRC(CAN_frame rx_frame, uint8_t length, uint8_t initial_value) {
+uint8_t RivianBattery::calculateCRC(const CAN_frame& rx_frame, uint8_t length, uint8_t initial_value) {
   uint8_t crc = initial_value;
   for (uint8_t j = 1; j < length; j++) {  //start at 1, since 0 is the CRC
     crc = crc8_table_SAE_J1850_ZER0[(crc ^ static_cast<uint8_t>(rx_frame.data.u8[j])) % 256];
@@ -72,27 +72,27 @@ void RivianBattery::update_values() {
   }
 
   //Update extended datalayer for HTML page
-  datalayer_extended.rivian.BMS_state = BMS_state;
-  datalayer_extended.rivian.HVIL = HVIL;
-  datalayer_extended.rivian.error_flags_from_BMS = error_flags_from_BMS;
-  datalayer_extended.rivian.contactor_state = contactor_state;
-  datalayer_extended.rivian.error_relay_open = error_relay_open;
-  datalayer_extended.rivian.puncture_fault = puncture_fault;
-  datalayer_extended.rivian.liquid_fault = liquid_fault;
-  datalayer_extended.rivian.IsolationMeasurementOngoing = IsolationMeasurementOngoing;
-  datalayer_extended.rivian.isolation_fault_status = isolation_fault_status;
-  datalayer_extended.rivian.contactor_DCFC_welded = contactor_DCFC_welded;
-  datalayer_extended.rivian.system_safe_state = system_safe_state;
-  datalayer_extended.rivian.pre_contactor_voltage = pre_contactor_voltage;
-  datalayer_extended.rivian.main_contactor_voltage = main_contactor_voltage;
-  datalayer_extended.rivian.voltage_reference = voltage_reference;
-  datalayer_extended.rivian.DCFC_contactor_voltage = DCFC_contactor_voltage;
-  datalayer_extended.rivian.slewrate_potential_violation = slewrate_potential_violation;
-  datalayer_extended.rivian.minimum_power_potential_violation = minimum_power_potential_violation;
-  datalayer_extended.rivian.operation_limit_violation_warning = operation_limit_violation_warning;
+  datalayer_rivian->BMS_state = BMS_state;
+  datalayer_rivian->HVIL = HVIL;
+  datalayer_rivian->error_flags_from_BMS = error_flags_from_BMS;
+  datalayer_rivian->contactor_state = contactor_state;
+  datalayer_rivian->error_relay_open = error_relay_open;
+  datalayer_rivian->puncture_fault = puncture_fault;
+  datalayer_rivian->liquid_fault = liquid_fault;
+  datalayer_rivian->IsolationMeasurementOngoing = IsolationMeasurementOngoing;
+  datalayer_rivian->isolation_fault_status = isolation_fault_status;
+  datalayer_rivian->contactor_DCFC_welded = contactor_DCFC_welded;
+  datalayer_rivian->system_safe_state = system_safe_state;
+  datalayer_rivian->pre_contactor_voltage = pre_contactor_voltage;
+  datalayer_rivian->main_contactor_voltage = main_contactor_voltage;
+  datalayer_rivian->voltage_reference = voltage_reference;
+  datalayer_rivian->DCFC_contactor_voltage = DCFC_contactor_voltage;
+  datalayer_rivian->slewrate_potential_violation = slewrate_potential_violation;
+  datalayer_rivian->minimum_power_potential_violation = minimum_power_potential_violation;
+  datalayer_rivian->operation_limit_violation_warning = operation_limit_violation_warning;
 }
 
-void RivianBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void RivianBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x00A:  //DCDC status [Platform CAN]+ 20ms
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -5,8 +5,10 @@
 
 class RivianBattery : public CanBattery {
  public:
+  RivianBattery() : renderer(datalayer_extended.rivian.get()) { datalayer_rivian = datalayer_extended.rivian.get(); }
+
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
   static constexpr const char* Name = "Rivian R1T large 135kWh battery";
@@ -15,7 +17,8 @@ class RivianBattery : public CanBattery {
 
  private:
   RivianHtmlRenderer renderer;
-  uint8_t calculateCRC(CAN_frame rx_frame, uint8_t length, uint8_t initial_value);
+  DATALAYER_INFO_RIVIAN* datalayer_rivian;
+  uint8_t calculateCRC(const CAN_frame& rx_frame, uint8_t length, uint8_t initial_value);
 
   static const int MAX_PACK_VOLTAGE_DV = 4480;
   static const int MIN_PACK_VOLTAGE_DV = 2920;
@@ -87,7 +87,7 @@ void RjxzsBms::update_values() {
   datalayer.battery.status.cell_min_voltage_mV = minimum_cell_voltage;
 }
 
-void RjxzsBms::handle_incoming_can_frame(CAN_frame rx_frame) {
+void RjxzsBms::handle_incoming_can_frame(const CAN_frame& rx_frame) {
 
   switch (rx_frame.ID) {
     case 0xF5:                 // This is the only message is sent from BMS
@@ -248,11 +248,17 @@ void RjxzsBms::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void RjxzsBms::transmit_can(unsigned long currentMillis) {
-  // Send 10s CAN Message
-  if (currentMillis - previousMillis10s >= INTERVAL_10_S) {
-    previousMillis10s = currentMillis;
+void RjxzsBms::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.battery.info.max_design_voltage_dV = user_selected_max_pack_voltage_dV;
+  datalayer.battery.info.min_design_voltage_dV = user_selected_min_pack_voltage_dV;
+  datalayer.battery.info.max_cell_voltage_mV = user_selected_max_cell_voltage_mV;
+  datalayer.battery.info.min_cell_voltage_mV = user_selected_min_cell_voltage_mV;
+  datalayer.system.status.battery_allows_contactor_closing = true;
 
+  // Send 10s CAN Message
+  transmit_every(INTERVAL_10_S, 1, [this](unsigned long currentMillis) {
     if (datalayer.system.status.system_status == FAULT) {
       // Incase we loose BMS comms, resend CAN start
       setup_completed = false;
@@ -264,15 +270,5 @@ void RjxzsBms::transmit_can(unsigned long currentMillis) {
       RJXZS_F4.data.u8[0] = 0x1C;  //CAN OK
       transmit_can_frame(&RJXZS_F4);
     }
-  }
-}
-
-void RjxzsBms::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.battery.info.max_design_voltage_dV = user_selected_max_pack_voltage_dV;
-  datalayer.battery.info.min_design_voltage_dV = user_selected_min_pack_voltage_dV;
-  datalayer.battery.info.max_cell_voltage_mV = user_selected_max_cell_voltage_mV;
-  datalayer.battery.info.min_cell_voltage_mV = user_selected_min_cell_voltage_mV;
-  datalayer.system.status.battery_allows_contactor_closing = true;
+  });
 }
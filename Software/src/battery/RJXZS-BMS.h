@@ -9,16 +9,15 @@ class RjxzsBms : public CanBattery {
   RjxzsBms() : CanBattery(CAN_Speed::CAN_SPEED_250KBPS) {}
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "RJXZS BMS, DIY battery";
 
  private:
   static const int MAX_CHARGE_POWER_WHEN_TOPBALANCING_W = 500;
 
-  unsigned long previousMillis10s = 0;  // will store last time a 10s CAN Message was sent
-
   //Actual content messages
   CAN_frame RJXZS_F4 = {.FD = false, .ext_ID = true, .DLC = 3, .ID = 0xF4, .data = {0x1C, 0x00, 0x02}};
 
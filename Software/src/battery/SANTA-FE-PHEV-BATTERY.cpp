@@ -13,7 +13,7 @@ TODO: Tweak temperature values once more data is known about them
 TODO: Check if CRC function works like it should. This enables checking for corrupt messages
 */
 
-static uint8_t CalculateCRC8(CAN_frame rx_frame) {
+static uint8_t CalculateCRC8(const CAN_frame& rx_frame) {
   int crc = 0;
 
   for (uint8_t framepos = 0; framepos < 8; framepos++) {
@@ -61,7 +61,7 @@ void SantaFePhevBattery::
   }
 }
 
-void SantaFePhevBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void SantaFePhevBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x1FF:
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -278,11 +278,22 @@ void SantaFePhevBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void SantaFePhevBattery::transmit_can(unsigned long currentMillis) {
-  //Send 10ms message
-  if (currentMillis - previousMillis10 >= INTERVAL_10_MS) {
-    previousMillis10 = currentMillis;
+void SantaFePhevBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer_battery->info.number_of_cells = 96;
+  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
+  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
+  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
 
+  if (allows_contactor_closing) {
+    *allows_contactor_closing = true;
+  }
+
+  //Send 10ms message
+  transmit_every(INTERVAL_10_MS, 3, [this](unsigned long currentMillis) {
     SANTAFE_200.data.u8[6] = (counter_200 << 1);
 
     checksum_200 = CalculateCRC8(SANTAFE_200);
@@ -297,19 +308,11 @@ void SantaFePhevBattery::transmit_can(unsigned long currentMillis) {
     if (counter_200 > 0xF) {
       counter_200 = 0;
     }
-  }
-
+  });
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
-
-    transmit_can_frame(&SANTAFE_523);
-  }
-
+  transmit_every(INTERVAL_100_MS, 1, [this](unsigned long currentMillis) { transmit_can_frame(&SANTAFE_523); });
   // Send 500ms CAN Message
-  if (currentMillis - previousMillis500 >= INTERVAL_500_MS) {
-    previousMillis500 = currentMillis;
-
+  transmit_every(INTERVAL_500_MS, 1, [this](unsigned long currentMillis) {
     // PID data is polled after last message sent from battery:
     poll_data_pid = (poll_data_pid % 5) + 1;
     SANTAFE_7E4_poll.data.u8[3] = (uint8_t)poll_data_pid;
@@ -320,20 +323,5 @@ void SantaFePhevBattery::transmit_can(unsigned long currentMillis) {
     } else {
       transmit_can_frame(&SANTAFE_7E4_poll);
     }
-  }
-}
-
-void SantaFePhevBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer_battery->info.number_of_cells = 96;
-  datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
-  datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
-  datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
-
-  if (allows_contactor_closing) {
-    *allows_contactor_closing = true;
-  }
+  });
 }
@@ -18,9 +18,10 @@ class SantaFePhevBattery : public CanBattery {
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Santa Fe PHEV";
 
   bool supports_reset_DTC() { return true; }
@@ -40,9 +41,6 @@ class SantaFePhevBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 4250;  //Battery is put into emergency stop if one cell goes over this value
   static const int MIN_CELL_VOLTAGE_MV = 2700;  //Battery is put into emergency stop if one cell goes below this value
 
-  unsigned long previousMillis10 = 0;   // will store last time a 10ms CAN Message was send
-  unsigned long previousMillis100 = 0;  // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis500 = 0;  // will store last time a 500ms CAN Message was send
   uint8_t poll_data_pid = 0;
   uint8_t counter_200 = 0;
   uint8_t checksum_200 = 0;
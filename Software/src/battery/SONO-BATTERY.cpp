@@ -33,7 +33,7 @@ void SonoBattery::
   datalayer.battery.status.temperature_max_dC = temperatureMax;
 }
 
-void SonoBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void SonoBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x100:
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -110,10 +110,21 @@ void SonoBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       break;
   }
 }
-void SonoBattery::transmit_can(unsigned long currentMillis) {
+
+void SonoBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.battery.info.number_of_cells = 96;
+  datalayer.system.status.battery_allows_contactor_closing = true;
+  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
+  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
+  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  datalayer.battery.info.chemistry = battery_chemistry_enum::LFP;
+
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
+  transmit_every(INTERVAL_100_MS, 1, [this](unsigned long currentMillis) {
     //VCU Command message
     SONO_400.data.u8[0] = 0x15;  //Charging enabled bit01, dischargign enabled bit23, dc charging bit45
 
@@ -121,11 +132,9 @@ void SonoBattery::transmit_can(unsigned long currentMillis) {
       SONO_400.data.u8[0] = 0x14;  //Charging DISABLED
     }
     transmit_can_frame(&SONO_400);
-  }
+  });
   // Send 1000ms CAN Message
-  if (currentMillis - previousMillis1000 >= INTERVAL_1_S) {
-    previousMillis1000 = currentMillis;
-
+  transmit_every(INTERVAL_1_S, 1, [this](unsigned long currentMillis) {
     //Time and date
     //Let's see if the battery is happy with just getting seconds incrementing
     SONO_401.data.u8[0] = 25;       //Year
@@ -136,18 +145,5 @@ void SonoBattery::transmit_can(unsigned long currentMillis) {
     SONO_401.data.u8[5] = seconds;  //Second
     seconds = (seconds + 1) % 61;
     transmit_can_frame(&SONO_401);
-  }
-}
-
-void SonoBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.battery.info.number_of_cells = 96;
-  datalayer.system.status.battery_allows_contactor_closing = true;
-  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
-  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
-  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
-  datalayer.battery.info.chemistry = battery_chemistry_enum::LFP;
+  });
 }
@@ -5,7 +5,7 @@
 #include "../devboard/utils/common_functions.h"  //For CRC table
 #include "../devboard/utils/events.h"
 
-static uint8_t CalculateCRC8SAEJ1850(CAN_frame rx_frame) {
+static uint8_t CalculateCRC8SAEJ1850(const CAN_frame& rx_frame) {
   uint8_t crc = 0xFF;  // initial value 0xFF
   for (uint8_t j = 0; j < 7; j++) {
     crc = crc8_table_SAE_J1850_ZER0[crc ^ rx_frame.data.u8[j]];
@@ -35,7 +35,7 @@ void StellantisSmallWide4x4Battery::
   }
 }
 
-void StellantisSmallWide4x4Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void StellantisSmallWide4x4Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x305:  //BPCM_HV_PowerLimits 8 lenght 100ms, BPCM sender (HV battery power limit status)
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -67,20 +67,6 @@ void StellantisSmallWide4x4Battery::handle_incoming_can_frame(CAN_frame rx_frame
   }
 }
 
-void StellantisSmallWide4x4Battery::transmit_can(unsigned long currentMillis) {
-
-  // Send 20ms CAN Message
-  if (currentMillis - previousMillis20 >= INTERVAL_20_MS) {
-    previousMillis20 = currentMillis;
-
-    counter212 = (counter212 + 1) % 16;  //Counter goes from 0 to 15 and then resets to 0
-    SMALLWIDE_212.data.u8[6] = (counter212 << 4) | 0x04;
-    SMALLWIDE_212.data.u8[7] = CalculateCRC8SAEJ1850(SMALLWIDE_212);
-
-    transmit_can_frame(&SMALLWIDE_212);  //Keepalive message
-  }
-}
-
 void StellantisSmallWide4x4Battery::setup(void) {  // Performs one time setup at startup
   strncpy(datalayer.system.info.battery_protocol, Name, 63);
   datalayer.system.info.battery_protocol[63] = '\0';
@@ -94,4 +80,12 @@ void StellantisSmallWide4x4Battery::setup(void) {  // Performs one time setup at
   if (allows_contactor_closing) {
     *allows_contactor_closing = true;
   }
+
+  transmit_every(INTERVAL_20_MS, 1, [this](unsigned long currentMillis) {
+    counter212 = (counter212 + 1) % 16;  //Counter goes from 0 to 15 and then resets to 0
+    SMALLWIDE_212.data.u8[6] = (counter212 << 4) | 0x04;
+    SMALLWIDE_212.data.u8[7] = CalculateCRC8SAEJ1850(SMALLWIDE_212);
+
+    transmit_can_frame(&SMALLWIDE_212);  //Keepalive message
+  });
 }
@@ -22,9 +22,10 @@ class StellantisSmallWide4x4Battery : public CanBattery {
   void reset_DTC() { UserRequestDTCreset = true; }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Stellantis FCA Small Wide 4x4";
 
  private:
@@ -41,7 +42,6 @@ class StellantisSmallWide4x4Battery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 4250;  //Battery is put into emergency stop if one cell goes over this value
   static const int MIN_CELL_VOLTAGE_MV = 2700;  //Battery is put into emergency stop if one cell goes below this value
 
-  unsigned long previousMillis20 = 0;  // will store last time a 20ms CAN Message was send
   uint8_t counter212 = 0xF;            //Counter for CAN message 0x212, goes from 0 to 15 and then resets to 0
   CAN_frame SMALLWIDE_212 = {.FD = false,
                              .ext_ID = false,
@@ -624,22 +624,22 @@ void TeslaBattery::
 
   // Update webserver datalayer
   //datalayer_extended.tesla.BMS_hvilFault = BMS_a036_SW_HvpHvilFault;
-  datalayer_extended.tesla.hvil_status = battery_hvil_status;
+  datalayer_tesla->hvil_status = battery_hvil_status;
   //0x20A
-  datalayer_extended.tesla.packContNegativeState = battery_packContNegativeState;
-  datalayer_extended.tesla.packContPositiveState = battery_packContPositiveState;
-  datalayer_extended.tesla.packContactorSetState = battery_packContactorSetState;
-  datalayer_extended.tesla.packCtrsClosingBlocked = battery_packCtrsClosingBlocked;
-  datalayer_extended.tesla.pyroTestInProgress = battery_pyroTestInProgress;
-  datalayer_extended.tesla.battery_packCtrsOpenNowRequested = battery_packCtrsOpenNowRequested;
-  datalayer_extended.tesla.battery_packCtrsOpenRequested = battery_packCtrsOpenRequested;
-  datalayer_extended.tesla.battery_packCtrsRequestStatus = battery_packCtrsRequestStatus;
-  datalayer_extended.tesla.battery_packCtrsResetRequestRequired = battery_packCtrsResetRequestRequired;
-  datalayer_extended.tesla.battery_dcLinkAllowedToEnergize = battery_dcLinkAllowedToEnergize;
+  datalayer_tesla->packContNegativeState = battery_packContNegativeState;
+  datalayer_tesla->packContPositiveState = battery_packContPositiveState;
+  datalayer_tesla->packContactorSetState = battery_packContactorSetState;
+  datalayer_tesla->packCtrsClosingBlocked = battery_packCtrsClosingBlocked;
+  datalayer_tesla->pyroTestInProgress = battery_pyroTestInProgress;
+  datalayer_tesla->battery_packCtrsOpenNowRequested = battery_packCtrsOpenNowRequested;
+  datalayer_tesla->battery_packCtrsOpenRequested = battery_packCtrsOpenRequested;
+  datalayer_tesla->battery_packCtrsRequestStatus = battery_packCtrsRequestStatus;
+  datalayer_tesla->battery_packCtrsResetRequestRequired = battery_packCtrsResetRequestRequired;
+  datalayer_tesla->battery_dcLinkAllowedToEnergize = battery_dcLinkAllowedToEnergize;
   //0x72A
   if (parsed_battery_serialNumber && battery_serialNumber[13] != 0) {
-    memcpy(datalayer_extended.tesla.battery_serialNumber, battery_serialNumber, sizeof(battery_serialNumber));
-    datalayer_extended.tesla.battery_manufactureDate = battery_manufactureDate;
+    memcpy(datalayer_tesla->battery_serialNumber, battery_serialNumber, sizeof(battery_serialNumber));
+    datalayer_tesla->battery_manufactureDate = battery_manufactureDate;
     //We have valid data and comms with the battery, attempt to query part number
     if (!parsed_battery_partNumber && stateMachineBMSQuery == 0xFF) {
       stateMachineBMSQuery = 0;
@@ -647,207 +647,207 @@ void TeslaBattery::
   }
   //Via UDS
   if (parsed_battery_partNumber && battery_partNumber[11] != 0) {
-    memcpy(datalayer_extended.tesla.battery_partNumber, battery_partNumber, sizeof(battery_partNumber));
+    memcpy(datalayer_tesla->battery_partNumber, battery_partNumber, sizeof(battery_partNumber));
   }
   //0x3C4
   if (parsed_PCS_partNumber && PCS_partNumber[11] != 0) {
-    memcpy(datalayer_extended.tesla.PCS_partNumber, PCS_partNumber, sizeof(PCS_partNumber));
+    memcpy(datalayer_tesla->PCS_partNumber, PCS_partNumber, sizeof(PCS_partNumber));
   }
   //0x2B4
-  datalayer_extended.tesla.battery_dcdcLvBusVolt = battery_dcdcLvBusVolt;
-  datalayer_extended.tesla.battery_dcdcHvBusVolt = battery_dcdcHvBusVolt;
-  datalayer_extended.tesla.battery_dcdcLvOutputCurrent = battery_dcdcLvOutputCurrent;
+  datalayer_tesla->battery_dcdcLvBusVolt = battery_dcdcLvBusVolt;
+  datalayer_tesla->battery_dcdcHvBusVolt = battery_dcdcHvBusVolt;
+  datalayer_tesla->battery_dcdcLvOutputCurrent = battery_dcdcLvOutputCurrent;
   //0x352
-  datalayer_extended.tesla.BMS352_mux = BMS352_mux;
-  datalayer_extended.tesla.battery_nominal_full_pack_energy = battery_nominal_full_pack_energy;
-  datalayer_extended.tesla.battery_nominal_full_pack_energy_m0 = battery_nominal_full_pack_energy_m0;
-  datalayer_extended.tesla.battery_nominal_energy_remaining = battery_nominal_energy_remaining;
-  datalayer_extended.tesla.battery_nominal_energy_remaining_m0 = battery_nominal_energy_remaining_m0;
-  datalayer_extended.tesla.battery_ideal_energy_remaining = battery_ideal_energy_remaining;
-  datalayer_extended.tesla.battery_ideal_energy_remaining_m0 = battery_ideal_energy_remaining_m0;
-  datalayer_extended.tesla.battery_energy_to_charge_complete = battery_energy_to_charge_complete;
-  datalayer_extended.tesla.battery_energy_to_charge_complete_m1 = battery_energy_to_charge_complete_m1;
-  datalayer_extended.tesla.battery_energy_buffer = battery_energy_buffer;
-  datalayer_extended.tesla.battery_energy_buffer_m1 = battery_energy_buffer_m1;
-  datalayer_extended.tesla.battery_expected_energy_remaining_m1 = battery_expected_energy_remaining_m1;
-  datalayer_extended.tesla.battery_full_charge_complete = battery_full_charge_complete;
-  datalayer_extended.tesla.battery_fully_charged = battery_fully_charged;
+  datalayer_tesla->BMS352_mux = BMS352_mux;
+  datalayer_tesla->battery_nominal_full_pack_energy = battery_nominal_full_pack_energy;
+  datalayer_tesla->battery_nominal_full_pack_energy_m0 = battery_nominal_full_pack_energy_m0;
+  datalayer_tesla->battery_nominal_energy_remaining = battery_nominal_energy_remaining;
+  datalayer_tesla->battery_nominal_energy_remaining_m0 = battery_nominal_energy_remaining_m0;
+  datalayer_tesla->battery_ideal_energy_remaining = battery_ideal_energy_remaining;
+  datalayer_tesla->battery_ideal_energy_remaining_m0 = battery_ideal_energy_remaining_m0;
+  datalayer_tesla->battery_energy_to_charge_complete = battery_energy_to_charge_complete;
+  datalayer_tesla->battery_energy_to_charge_complete_m1 = battery_energy_to_charge_complete_m1;
+  datalayer_tesla->battery_energy_buffer = battery_energy_buffer;
+  datalayer_tesla->battery_energy_buffer_m1 = battery_energy_buffer_m1;
+  datalayer_tesla->battery_expected_energy_remaining_m1 = battery_expected_energy_remaining_m1;
+  datalayer_tesla->battery_full_charge_complete = battery_full_charge_complete;
+  datalayer_tesla->battery_fully_charged = battery_fully_charged;
   //0x3D2
   datalayer_battery->status.total_discharged_battery_Wh = battery_total_discharge;
   datalayer_battery->status.total_charged_battery_Wh = battery_total_charge;
   //0x392
-  datalayer_extended.tesla.battery_moduleType = battery_moduleType;
-  datalayer_extended.tesla.battery_packMass = battery_packMass;
-  datalayer_extended.tesla.battery_platformMaxBusVoltage = battery_platformMaxBusVoltage;
+  datalayer_tesla->battery_moduleType = battery_moduleType;
+  datalayer_tesla->battery_packMass = battery_packMass;
+  datalayer_tesla->battery_platformMaxBusVoltage = battery_platformMaxBusVoltage;
   //0x2D2
-  datalayer_extended.tesla.BMS_min_voltage = BMS_min_voltage;
-  datalayer_extended.tesla.BMS_max_voltage = BMS_max_voltage;
-  datalayer_extended.tesla.battery_max_charge_current = battery_max_charge_current;
-  datalayer_extended.tesla.battery_max_discharge_current = battery_max_discharge_current;
+  datalayer_tesla->BMS_min_voltage = BMS_min_voltage;
+  datalayer_tesla->BMS_max_voltage = BMS_max_voltage;
+  datalayer_tesla->battery_max_charge_current = battery_max_charge_current;
+  datalayer_tesla->battery_max_discharge_current = battery_max_discharge_current;
   //0x292
-  datalayer_extended.tesla.battery_beginning_of_life = battery_beginning_of_life;
-  datalayer_extended.tesla.battery_battTempPct = battery_battTempPct;
-  datalayer_extended.tesla.battery_soc_ave = battery_soc_ave;
-  datalayer_extended.tesla.battery_soc_max = battery_soc_max;
-  datalayer_extended.tesla.battery_soc_min = battery_soc_min;
-  datalayer_extended.tesla.battery_soc_ui = battery_soc_ui;
+  datalayer_tesla->battery_beginning_of_life = battery_beginning_of_life;
+  datalayer_tesla->battery_battTempPct = battery_battTempPct;
+  datalayer_tesla->battery_soc_ave = battery_soc_ave;
+  datalayer_tesla->battery_soc_max = battery_soc_max;
+  datalayer_tesla->battery_soc_min = battery_soc_min;
+  datalayer_tesla->battery_soc_ui = battery_soc_ui;
   //0x332
-  datalayer_extended.tesla.battery_BrickVoltageMax = battery_BrickVoltageMax;
-  datalayer_extended.tesla.battery_BrickVoltageMin = battery_BrickVoltageMin;
-  datalayer_extended.tesla.battery_BrickTempMaxNum = battery_BrickTempMaxNum;
-  datalayer_extended.tesla.battery_BrickTempMinNum = battery_BrickTempMinNum;
-  datalayer_extended.tesla.battery_BrickModelTMax = battery_BrickModelTMax;
-  datalayer_extended.tesla.battery_BrickModelTMin = battery_BrickModelTMin;
+  datalayer_tesla->battery_BrickVoltageMax = battery_BrickVoltageMax;
+  datalayer_tesla->battery_BrickVoltageMin = battery_BrickVoltageMin;
+  datalayer_tesla->battery_BrickTempMaxNum = battery_BrickTempMaxNum;
+  datalayer_tesla->battery_BrickTempMinNum = battery_BrickTempMinNum;
+  datalayer_tesla->battery_BrickModelTMax = battery_BrickModelTMax;
+  datalayer_tesla->battery_BrickModelTMin = battery_BrickModelTMin;
   //0x212
-  datalayer_extended.tesla.BMS_isolationResistance = BMS_isolationResistance;
-  datalayer_extended.tesla.BMS_contactorState = BMS_contactorState;
-  datalayer_extended.tesla.BMS_state = BMS_state;
-  datalayer_extended.tesla.BMS_hvState = BMS_hvState;
-  datalayer_extended.tesla.BMS_uiChargeStatus = BMS_uiChargeStatus;
-  datalayer_extended.tesla.BMS_diLimpRequest = BMS_diLimpRequest;
-  datalayer_extended.tesla.BMS_chgPowerAvailable = BMS_chgPowerAvailable;
-  datalayer_extended.tesla.BMS_pcsPwmEnabled = BMS_pcsPwmEnabled;
+  datalayer_tesla->BMS_isolationResistance = BMS_isolationResistance;
+  datalayer_tesla->BMS_contactorState = BMS_contactorState;
+  datalayer_tesla->BMS_state = BMS_state;
+  datalayer_tesla->BMS_hvState = BMS_hvState;
+  datalayer_tesla->BMS_uiChargeStatus = BMS_uiChargeStatus;
+  datalayer_tesla->BMS_diLimpRequest = BMS_diLimpRequest;
+  datalayer_tesla->BMS_chgPowerAvailable = BMS_chgPowerAvailable;
+  datalayer_tesla->BMS_pcsPwmEnabled = BMS_pcsPwmEnabled;
   //0x224
-  datalayer_extended.tesla.PCS_dcdcPrechargeStatus = PCS_dcdcPrechargeStatus;
-  datalayer_extended.tesla.PCS_dcdc12VSupportStatus = PCS_dcdc12VSupportStatus;
-  datalayer_extended.tesla.PCS_dcdcHvBusDischargeStatus = PCS_dcdcHvBusDischargeStatus;
-  datalayer_extended.tesla.PCS_dcdcMainState = PCS_dcdcMainState;
-  datalayer_extended.tesla.PCS_dcdcSubState = PCS_dcdcSubState;
-  datalayer_extended.tesla.PCS_dcdcFaulted = PCS_dcdcFaulted;
-  datalayer_extended.tesla.PCS_dcdcOutputIsLimited = PCS_dcdcOutputIsLimited;
-  datalayer_extended.tesla.PCS_dcdcMaxOutputCurrentAllowed = PCS_dcdcMaxOutputCurrentAllowed;
-  datalayer_extended.tesla.PCS_dcdcPrechargeRtyCnt = PCS_dcdcPrechargeRtyCnt;
-  datalayer_extended.tesla.PCS_dcdc12VSupportRtyCnt = PCS_dcdc12VSupportRtyCnt;
-  datalayer_extended.tesla.PCS_dcdcDischargeRtyCnt = PCS_dcdcDischargeRtyCnt;
-  datalayer_extended.tesla.PCS_dcdcPwmEnableLine = PCS_dcdcPwmEnableLine;
-  datalayer_extended.tesla.PCS_dcdcSupportingFixedLvTarget = PCS_dcdcSupportingFixedLvTarget;
-  datalayer_extended.tesla.PCS_dcdcPrechargeRestartCnt = PCS_dcdcPrechargeRestartCnt;
-  datalayer_extended.tesla.PCS_dcdcInitialPrechargeSubState = PCS_dcdcInitialPrechargeSubState;
+  datalayer_tesla->PCS_dcdcPrechargeStatus = PCS_dcdcPrechargeStatus;
+  datalayer_tesla->PCS_dcdc12VSupportStatus = PCS_dcdc12VSupportStatus;
+  datalayer_tesla->PCS_dcdcHvBusDischargeStatus = PCS_dcdcHvBusDischargeStatus;
+  datalayer_tesla->PCS_dcdcMainState = PCS_dcdcMainState;
+  datalayer_tesla->PCS_dcdcSubState = PCS_dcdcSubState;
+  datalayer_tesla->PCS_dcdcFaulted = PCS_dcdcFaulted;
+  datalayer_tesla->PCS_dcdcOutputIsLimited = PCS_dcdcOutputIsLimited;
+  datalayer_tesla->PCS_dcdcMaxOutputCurrentAllowed = PCS_dcdcMaxOutputCurrentAllowed;
+  datalayer_tesla->PCS_dcdcPrechargeRtyCnt = PCS_dcdcPrechargeRtyCnt;
+  datalayer_tesla->PCS_dcdc12VSupportRtyCnt = PCS_dcdc12VSupportRtyCnt;
+  datalayer_tesla->PCS_dcdcDischargeRtyCnt = PCS_dcdcDischargeRtyCnt;
+  datalayer_tesla->PCS_dcdcPwmEnableLine = PCS_dcdcPwmEnableLine;
+  datalayer_tesla->PCS_dcdcSupportingFixedLvTarget = PCS_dcdcSupportingFixedLvTarget;
+  datalayer_tesla->PCS_dcdcPrechargeRestartCnt = PCS_dcdcPrechargeRestartCnt;
+  datalayer_tesla->PCS_dcdcInitialPrechargeSubState = PCS_dcdcInitialPrechargeSubState;
   //0x252
-  datalayer_extended.tesla.BMS_maxRegenPower = BMS_maxRegenPower;
-  datalayer_extended.tesla.BMS_maxDischargePower = BMS_maxDischargePower;
-  datalayer_extended.tesla.BMS_maxStationaryHeatPower = BMS_maxStationaryHeatPower;
-  datalayer_extended.tesla.BMS_hvacPowerBudget = BMS_hvacPowerBudget;
-  datalayer_extended.tesla.BMS_notEnoughPowerForHeatPump = BMS_notEnoughPowerForHeatPump;
-  datalayer_extended.tesla.BMS_powerLimitState = BMS_powerLimitState;
-  datalayer_extended.tesla.BMS_inverterTQF = BMS_inverterTQF;
+  datalayer_tesla->BMS_maxRegenPower = BMS_maxRegenPower;
+  datalayer_tesla->BMS_maxDischargePower = BMS_maxDischargePower;
+  datalayer_tesla->BMS_maxStationaryHeatPower = BMS_maxStationaryHeatPower;
+  datalayer_tesla->BMS_hvacPowerBudget = BMS_hvacPowerBudget;
+  datalayer_tesla->BMS_notEnoughPowerForHeatPump = BMS_notEnoughPowerForHeatPump;
+  datalayer_tesla->BMS_powerLimitState = BMS_powerLimitState;
+  datalayer_tesla->BMS_inverterTQF = BMS_inverterTQF;
   //Via UDS
   //datalayer_extended.tesla.BMS_info_buildConfigId = BMS_info_buildConfigId;
   //0x300
-  datalayer_extended.tesla.BMS_info_buildConfigId = BMS_info_buildConfigId;
-  datalayer_extended.tesla.BMS_info_hardwareId = BMS_info_hardwareId;
-  datalayer_extended.tesla.BMS_info_componentId = BMS_info_componentId;
-  datalayer_extended.tesla.BMS_info_pcbaId = BMS_info_pcbaId;
-  datalayer_extended.tesla.BMS_info_assemblyId = BMS_info_assemblyId;
-  datalayer_extended.tesla.BMS_info_usageId = BMS_info_usageId;
-  datalayer_extended.tesla.BMS_info_subUsageId = BMS_info_subUsageId;
-  datalayer_extended.tesla.BMS_info_platformType = BMS_info_platformType;
-  datalayer_extended.tesla.BMS_info_appCrc = BMS_info_appCrc;
-  datalayer_extended.tesla.BMS_info_bootGitHash = BMS_info_bootGitHash;
-  datalayer_extended.tesla.BMS_info_bootUdsProtoVersion = BMS_info_bootUdsProtoVersion;
-  datalayer_extended.tesla.BMS_info_bootCrc = BMS_info_bootCrc;
+  datalayer_tesla->BMS_info_buildConfigId = BMS_info_buildConfigId;
+  datalayer_tesla->BMS_info_hardwareId = BMS_info_hardwareId;
+  datalayer_tesla->BMS_info_componentId = BMS_info_componentId;
+  datalayer_tesla->BMS_info_pcbaId = BMS_info_pcbaId;
+  datalayer_tesla->BMS_info_assemblyId = BMS_info_assemblyId;
+  datalayer_tesla->BMS_info_usageId = BMS_info_usageId;
+  datalayer_tesla->BMS_info_subUsageId = BMS_info_subUsageId;
+  datalayer_tesla->BMS_info_platformType = BMS_info_platformType;
+  datalayer_tesla->BMS_info_appCrc = BMS_info_appCrc;
+  datalayer_tesla->BMS_info_bootGitHash = BMS_info_bootGitHash;
+  datalayer_tesla->BMS_info_bootUdsProtoVersion = BMS_info_bootUdsProtoVersion;
+  datalayer_tesla->BMS_info_bootCrc = BMS_info_bootCrc;
   //0x312
-  datalayer_extended.tesla.BMS_powerDissipation = BMS_powerDissipation;
-  datalayer_extended.tesla.BMS_flowRequest = BMS_flowRequest;
-  datalayer_extended.tesla.BMS_inletActiveCoolTargetT = BMS_inletActiveCoolTargetT;
-  datalayer_extended.tesla.BMS_inletPassiveTargetT = BMS_inletPassiveTargetT;
-  datalayer_extended.tesla.BMS_inletActiveHeatTargetT = BMS_inletActiveHeatTargetT;
-  datalayer_extended.tesla.BMS_packTMin = BMS_packTMin;
-  datalayer_extended.tesla.BMS_packTMax = BMS_packTMax;
-  datalayer_extended.tesla.BMS_pcsNoFlowRequest = BMS_pcsNoFlowRequest;
-  datalayer_extended.tesla.BMS_noFlowRequest = BMS_noFlowRequest;
+  datalayer_tesla->BMS_powerDissipation = BMS_powerDissipation;
+  datalayer_tesla->BMS_flowRequest = BMS_flowRequest;
+  datalayer_tesla->BMS_inletActiveCoolTargetT = BMS_inletActiveCoolTargetT;
+  datalayer_tesla->BMS_inletPassiveTargetT = BMS_inletPassiveTargetT;
+  datalayer_tesla->BMS_inletActiveHeatTargetT = BMS_inletActiveHeatTargetT;
+  datalayer_tesla->BMS_packTMin = BMS_packTMin;
+  datalayer_tesla->BMS_packTMax = BMS_packTMax;
+  datalayer_tesla->BMS_pcsNoFlowRequest = BMS_pcsNoFlowRequest;
+  datalayer_tesla->BMS_noFlowRequest = BMS_noFlowRequest;
   //0x3C4
-  datalayer_extended.tesla.PCS_info_buildConfigId = PCS_info_buildConfigId;
-  datalayer_extended.tesla.PCS_info_hardwareId = PCS_info_hardwareId;
-  datalayer_extended.tesla.PCS_info_componentId = PCS_info_componentId;
+  datalayer_tesla->PCS_info_buildConfigId = PCS_info_buildConfigId;
+  datalayer_tesla->PCS_info_hardwareId = PCS_info_hardwareId;
+  datalayer_tesla->PCS_info_componentId = PCS_info_componentId;
   //0x2A4
-  datalayer_extended.tesla.PCS_dcdcTemp = PCS_dcdcTemp;
-  datalayer_extended.tesla.PCS_ambientTemp = PCS_ambientTemp;
-  datalayer_extended.tesla.PCS_chgPhATemp = PCS_chgPhATemp;
-  datalayer_extended.tesla.PCS_chgPhBTemp = PCS_chgPhBTemp;
-  datalayer_extended.tesla.PCS_chgPhCTemp = PCS_chgPhCTemp;
+  datalayer_tesla->PCS_dcdcTemp = PCS_dcdcTemp;
+  datalayer_tesla->PCS_ambientTemp = PCS_ambientTemp;
+  datalayer_tesla->PCS_chgPhATemp = PCS_chgPhATemp;
+  datalayer_tesla->PCS_chgPhBTemp = PCS_chgPhBTemp;
+  datalayer_tesla->PCS_chgPhCTemp = PCS_chgPhCTemp;
   //0x2C4
-  datalayer_extended.tesla.PCS_dcdcMaxLvOutputCurrent = PCS_dcdcMaxLvOutputCurrent;
-  datalayer_extended.tesla.PCS_dcdcCurrentLimit = PCS_dcdcCurrentLimit;
-  datalayer_extended.tesla.PCS_dcdcLvOutputCurrentTempLimit = PCS_dcdcLvOutputCurrentTempLimit;
-  datalayer_extended.tesla.PCS_dcdcUnifiedCommand = PCS_dcdcUnifiedCommand;
-  datalayer_extended.tesla.PCS_dcdcCLAControllerOutput = PCS_dcdcCLAControllerOutput;
-  datalayer_extended.tesla.PCS_dcdcTankVoltage = PCS_dcdcTankVoltage;
-  datalayer_extended.tesla.PCS_dcdcTankVoltageTarget = PCS_dcdcTankVoltageTarget;
-  datalayer_extended.tesla.PCS_dcdcClaCurrentFreq = PCS_dcdcClaCurrentFreq;
-  datalayer_extended.tesla.PCS_dcdcTCommMeasured = PCS_dcdcTCommMeasured;
-  datalayer_extended.tesla.PCS_dcdcShortTimeUs = PCS_dcdcShortTimeUs;
-  datalayer_extended.tesla.PCS_dcdcHalfPeriodUs = PCS_dcdcHalfPeriodUs;
-  datalayer_extended.tesla.PCS_dcdcIntervalMaxFrequency = PCS_dcdcIntervalMaxFrequency;
-  datalayer_extended.tesla.PCS_dcdcIntervalMaxHvBusVolt = PCS_dcdcIntervalMaxHvBusVolt;
-  datalayer_extended.tesla.PCS_dcdcIntervalMaxLvBusVolt = PCS_dcdcIntervalMaxLvBusVolt;
-  datalayer_extended.tesla.PCS_dcdcIntervalMaxLvOutputCurr = PCS_dcdcIntervalMaxLvOutputCurr;
-  datalayer_extended.tesla.PCS_dcdcIntervalMinFrequency = PCS_dcdcIntervalMinFrequency;
-  datalayer_extended.tesla.PCS_dcdcIntervalMinHvBusVolt = PCS_dcdcIntervalMinHvBusVolt;
-  datalayer_extended.tesla.PCS_dcdcIntervalMinLvBusVolt = PCS_dcdcIntervalMinLvBusVolt;
-  datalayer_extended.tesla.PCS_dcdcIntervalMinLvOutputCurr = PCS_dcdcIntervalMinLvOutputCurr;
-  datalayer_extended.tesla.PCS_dcdc12vSupportLifetimekWh = PCS_dcdc12vSupportLifetimekWh;
+  datalayer_tesla->PCS_dcdcMaxLvOutputCurrent = PCS_dcdcMaxLvOutputCurrent;
+  datalayer_tesla->PCS_dcdcCurrentLimit = PCS_dcdcCurrentLimit;
+  datalayer_tesla->PCS_dcdcLvOutputCurrentTempLimit = PCS_dcdcLvOutputCurrentTempLimit;
+  datalayer_tesla->PCS_dcdcUnifiedCommand = PCS_dcdcUnifiedCommand;
+  datalayer_tesla->PCS_dcdcCLAControllerOutput = PCS_dcdcCLAControllerOutput;
+  datalayer_tesla->PCS_dcdcTankVoltage = PCS_dcdcTankVoltage;
+  datalayer_tesla->PCS_dcdcTankVoltageTarget = PCS_dcdcTankVoltageTarget;
+  datalayer_tesla->PCS_dcdcClaCurrentFreq = PCS_dcdcClaCurrentFreq;
+  datalayer_tesla->PCS_dcdcTCommMeasured = PCS_dcdcTCommMeasured;
+  datalayer_tesla->PCS_dcdcShortTimeUs = PCS_dcdcShortTimeUs;
+  datalayer_tesla->PCS_dcdcHalfPeriodUs = PCS_dcdcHalfPeriodUs;
+  datalayer_tesla->PCS_dcdcIntervalMaxFrequency = PCS_dcdcIntervalMaxFrequency;
+  datalayer_tesla->PCS_dcdcIntervalMaxHvBusVolt = PCS_dcdcIntervalMaxHvBusVolt;
+  datalayer_tesla->PCS_dcdcIntervalMaxLvBusVolt = PCS_dcdcIntervalMaxLvBusVolt;
+  datalayer_tesla->PCS_dcdcIntervalMaxLvOutputCurr = PCS_dcdcIntervalMaxLvOutputCurr;
+  datalayer_tesla->PCS_dcdcIntervalMinFrequency = PCS_dcdcIntervalMinFrequency;
+  datalayer_tesla->PCS_dcdcIntervalMinHvBusVolt = PCS_dcdcIntervalMinHvBusVolt;
+  datalayer_tesla->PCS_dcdcIntervalMinLvBusVolt = PCS_dcdcIntervalMinLvBusVolt;
+  datalayer_tesla->PCS_dcdcIntervalMinLvOutputCurr = PCS_dcdcIntervalMinLvOutputCurr;
+  datalayer_tesla->PCS_dcdc12vSupportLifetimekWh = PCS_dcdc12vSupportLifetimekWh;
   //0x310
-  datalayer_extended.tesla.HVP_info_buildConfigId = HVP_info_buildConfigId;
-  datalayer_extended.tesla.HVP_info_hardwareId = HVP_info_hardwareId;
-  datalayer_extended.tesla.HVP_info_componentId = HVP_info_componentId;
+  datalayer_tesla->HVP_info_buildConfigId = HVP_info_buildConfigId;
+  datalayer_tesla->HVP_info_hardwareId = HVP_info_hardwareId;
+  datalayer_tesla->HVP_info_componentId = HVP_info_componentId;
   //0x7AA
-  datalayer_extended.tesla.HVP_gpioPassivePyroDepl = HVP_gpioPassivePyroDepl;
-  datalayer_extended.tesla.HVP_gpioPyroIsoEn = HVP_gpioPyroIsoEn;
-  datalayer_extended.tesla.HVP_gpioCpFaultIn = HVP_gpioCpFaultIn;
-  datalayer_extended.tesla.HVP_gpioPackContPowerEn = HVP_gpioPackContPowerEn;
-  datalayer_extended.tesla.HVP_gpioHvCablesOk = HVP_gpioHvCablesOk;
-  datalayer_extended.tesla.HVP_gpioHvpSelfEnable = HVP_gpioHvpSelfEnable;
-  datalayer_extended.tesla.HVP_gpioLed = HVP_gpioLed;
-  datalayer_extended.tesla.HVP_gpioCrashSignal = HVP_gpioCrashSignal;
-  datalayer_extended.tesla.HVP_gpioShuntDataReady = HVP_gpioShuntDataReady;
-  datalayer_extended.tesla.HVP_gpioFcContPosAux = HVP_gpioFcContPosAux;
-  datalayer_extended.tesla.HVP_gpioFcContNegAux = HVP_gpioFcContNegAux;
-  datalayer_extended.tesla.HVP_gpioBmsEout = HVP_gpioBmsEout;
-  datalayer_extended.tesla.HVP_gpioCpFaultOut = HVP_gpioCpFaultOut;
-  datalayer_extended.tesla.HVP_gpioPyroPor = HVP_gpioPyroPor;
-  datalayer_extended.tesla.HVP_gpioShuntEn = HVP_gpioShuntEn;
-  datalayer_extended.tesla.HVP_gpioHvpVerEn = HVP_gpioHvpVerEn;
-  datalayer_extended.tesla.HVP_gpioPackCoontPosFlywheel = HVP_gpioPackCoontPosFlywheel;
-  datalayer_extended.tesla.HVP_gpioCpLatchEnable = HVP_gpioCpLatchEnable;
-  datalayer_extended.tesla.HVP_gpioPcsEnable = HVP_gpioPcsEnable;
-  datalayer_extended.tesla.HVP_gpioPcsDcdcPwmEnable = HVP_gpioPcsDcdcPwmEnable;
-  datalayer_extended.tesla.HVP_gpioPcsChargePwmEnable = HVP_gpioPcsChargePwmEnable;
-  datalayer_extended.tesla.HVP_gpioFcContPowerEnable = HVP_gpioFcContPowerEnable;
-  datalayer_extended.tesla.HVP_gpioHvilEnable = HVP_gpioHvilEnable;
-  datalayer_extended.tesla.HVP_gpioSecDrdy = HVP_gpioSecDrdy;
-  datalayer_extended.tesla.HVP_hvp1v5Ref = HVP_hvp1v5Ref;
-  datalayer_extended.tesla.HVP_shuntCurrentDebug = HVP_shuntCurrentDebug;
-  datalayer_extended.tesla.HVP_packCurrentMia = HVP_packCurrentMia;
-  datalayer_extended.tesla.HVP_auxCurrentMia = HVP_auxCurrentMia;
-  datalayer_extended.tesla.HVP_currentSenseMia = HVP_currentSenseMia;
-  datalayer_extended.tesla.HVP_shuntRefVoltageMismatch = HVP_shuntRefVoltageMismatch;
-  datalayer_extended.tesla.HVP_shuntThermistorMia = HVP_shuntThermistorMia;
-  datalayer_extended.tesla.HVP_shuntHwMia = HVP_shuntHwMia;
-  datalayer_extended.tesla.HVP_dcLinkVoltage = HVP_dcLinkVoltage;
-  datalayer_extended.tesla.HVP_packVoltage = HVP_packVoltage;
-  datalayer_extended.tesla.HVP_fcLinkVoltage = HVP_fcLinkVoltage;
-  datalayer_extended.tesla.HVP_packContVoltage = HVP_packContVoltage;
-  datalayer_extended.tesla.HVP_packNegativeV = HVP_packNegativeV;
-  datalayer_extended.tesla.HVP_packPositiveV = HVP_packPositiveV;
-  datalayer_extended.tesla.HVP_pyroAnalog = HVP_pyroAnalog;
-  datalayer_extended.tesla.HVP_dcLinkNegativeV = HVP_dcLinkNegativeV;
-  datalayer_extended.tesla.HVP_dcLinkPositiveV = HVP_dcLinkPositiveV;
-  datalayer_extended.tesla.HVP_fcLinkNegativeV = HVP_fcLinkNegativeV;
-  datalayer_extended.tesla.HVP_fcContCoilCurrent = HVP_fcContCoilCurrent;
-  datalayer_extended.tesla.HVP_fcContVoltage = HVP_fcContVoltage;
-  datalayer_extended.tesla.HVP_hvilInVoltage = HVP_hvilInVoltage;
-  datalayer_extended.tesla.HVP_hvilOutVoltage = HVP_hvilOutVoltage;
-  datalayer_extended.tesla.HVP_fcLinkPositiveV = HVP_fcLinkPositiveV;
-  datalayer_extended.tesla.HVP_packContCoilCurrent = HVP_packContCoilCurrent;
-  datalayer_extended.tesla.HVP_battery12V = HVP_battery12V;
-  datalayer_extended.tesla.HVP_shuntRefVoltageDbg = HVP_shuntRefVoltageDbg;
-  datalayer_extended.tesla.HVP_shuntAuxCurrentDbg = HVP_shuntAuxCurrentDbg;
-  datalayer_extended.tesla.HVP_shuntBarTempDbg = HVP_shuntBarTempDbg;
-  datalayer_extended.tesla.HVP_shuntAsicTempDbg = HVP_shuntAsicTempDbg;
-  datalayer_extended.tesla.HVP_shuntAuxCurrentStatus = HVP_shuntAuxCurrentStatus;
-  datalayer_extended.tesla.HVP_shuntBarTempStatus = HVP_shuntBarTempStatus;
-  datalayer_extended.tesla.HVP_shuntAsicTempStatus = HVP_shuntAsicTempStatus;
+  datalayer_tesla->HVP_gpioPassivePyroDepl = HVP_gpioPassivePyroDepl;
+  datalayer_tesla->HVP_gpioPyroIsoEn = HVP_gpioPyroIsoEn;
+  datalayer_tesla->HVP_gpioCpFaultIn = HVP_gpioCpFaultIn;
+  datalayer_tesla->HVP_gpioPackContPowerEn = HVP_gpioPackContPowerEn;
+  datalayer_tesla->HVP_gpioHvCablesOk = HVP_gpioHvCablesOk;
+  datalayer_tesla->HVP_gpioHvpSelfEnable = HVP_gpioHvpSelfEnable;
+  datalayer_tesla->HVP_gpioLed = HVP_gpioLed;
+  datalayer_tesla->HVP_gpioCrashSignal = HVP_gpioCrashSignal;
+  datalayer_tesla->HVP_gpioShuntDataReady = HVP_gpioShuntDataReady;
+  datalayer_tesla->HVP_gpioFcContPosAux = HVP_gpioFcContPosAux;
+  datalayer_tesla->HVP_gpioFcContNegAux = HVP_gpioFcContNegAux;
+  datalayer_tesla->HVP_gpioBmsEout = HVP_gpioBmsEout;
+  datalayer_tesla->HVP_gpioCpFaultOut = HVP_gpioCpFaultOut;
+  datalayer_tesla->HVP_gpioPyroPor = HVP_gpioPyroPor;
+  datalayer_tesla->HVP_gpioShuntEn = HVP_gpioShuntEn;
+  datalayer_tesla->HVP_gpioHvpVerEn = HVP_gpioHvpVerEn;
+  datalayer_tesla->HVP_gpioPackCoontPosFlywheel = HVP_gpioPackCoontPosFlywheel;
+  datalayer_tesla->HVP_gpioCpLatchEnable = HVP_gpioCpLatchEnable;
+  datalayer_tesla->HVP_gpioPcsEnable = HVP_gpioPcsEnable;
+  datalayer_tesla->HVP_gpioPcsDcdcPwmEnable = HVP_gpioPcsDcdcPwmEnable;
+  datalayer_tesla->HVP_gpioPcsChargePwmEnable = HVP_gpioPcsChargePwmEnable;
+  datalayer_tesla->HVP_gpioFcContPowerEnable = HVP_gpioFcContPowerEnable;
+  datalayer_tesla->HVP_gpioHvilEnable = HVP_gpioHvilEnable;
+  datalayer_tesla->HVP_gpioSecDrdy = HVP_gpioSecDrdy;
+  datalayer_tesla->HVP_hvp1v5Ref = HVP_hvp1v5Ref;
+  datalayer_tesla->HVP_shuntCurrentDebug = HVP_shuntCurrentDebug;
+  datalayer_tesla->HVP_packCurrentMia = HVP_packCurrentMia;
+  datalayer_tesla->HVP_auxCurrentMia = HVP_auxCurrentMia;
+  datalayer_tesla->HVP_currentSenseMia = HVP_currentSenseMia;
+  datalayer_tesla->HVP_shuntRefVoltageMismatch = HVP_shuntRefVoltageMismatch;
+  datalayer_tesla->HVP_shuntThermistorMia = HVP_shuntThermistorMia;
+  datalayer_tesla->HVP_shuntHwMia = HVP_shuntHwMia;
+  datalayer_tesla->HVP_dcLinkVoltage = HVP_dcLinkVoltage;
+  datalayer_tesla->HVP_packVoltage = HVP_packVoltage;
+  datalayer_tesla->HVP_fcLinkVoltage = HVP_fcLinkVoltage;
+  datalayer_tesla->HVP_packContVoltage = HVP_packContVoltage;
+  datalayer_tesla->HVP_packNegativeV = HVP_packNegativeV;
+  datalayer_tesla->HVP_packPositiveV = HVP_packPositiveV;
+  datalayer_tesla->HVP_pyroAnalog = HVP_pyroAnalog;
+  datalayer_tesla->HVP_dcLinkNegativeV = HVP_dcLinkNegativeV;
+  datalayer_tesla->HVP_dcLinkPositiveV = HVP_dcLinkPositiveV;
+  datalayer_tesla->HVP_fcLinkNegativeV = HVP_fcLinkNegativeV;
+  datalayer_tesla->HVP_fcContCoilCurrent = HVP_fcContCoilCurrent;
+  datalayer_tesla->HVP_fcContVoltage = HVP_fcContVoltage;
+  datalayer_tesla->HVP_hvilInVoltage = HVP_hvilInVoltage;
+  datalayer_tesla->HVP_hvilOutVoltage = HVP_hvilOutVoltage;
+  datalayer_tesla->HVP_fcLinkPositiveV = HVP_fcLinkPositiveV;
+  datalayer_tesla->HVP_packContCoilCurrent = HVP_packContCoilCurrent;
+  datalayer_tesla->HVP_battery12V = HVP_battery12V;
+  datalayer_tesla->HVP_shuntRefVoltageDbg = HVP_shuntRefVoltageDbg;
+  datalayer_tesla->HVP_shuntAuxCurrentDbg = HVP_shuntAuxCurrentDbg;
+  datalayer_tesla->HVP_shuntBarTempDbg = HVP_shuntBarTempDbg;
+  datalayer_tesla->HVP_shuntAsicTempDbg = HVP_shuntAsicTempDbg;
+  datalayer_tesla->HVP_shuntAuxCurrentStatus = HVP_shuntAuxCurrentStatus;
+  datalayer_tesla->HVP_shuntBarTempStatus = HVP_shuntBarTempStatus;
+  datalayer_tesla->HVP_shuntAsicTempStatus = HVP_shuntAsicTempStatus;
 
   //Safety checks for CAN message sending
   if ((datalayer.system.status.inverter_allows_contactor_closing == true) &&
@@ -896,7 +896,13 @@ void TeslaBattery::
                  (battery_dcdcLvBusVolt * 0.0390625), (battery_dcdcLvOutputCurrent * 0.1));
 }
 
-void TeslaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+std::vector<uint32_t> TeslaBattery::handled_can_ids() {
+  // Keep in sync with the switch in handle_incoming_can_frame
+  return {0x132, 0x20A, 0x212, 0x224, 0x252, 0x292, 0x2A4, 0x2B4, 0x2C4, 0x2D2, 0x300, 0x310,
+          0x312, 0x320, 0x332, 0x352, 0x392, 0x3AA, 0x3C4, 0x3D2, 0x401, 0x612, 0x72A, 0x7AA};
+}
+
+void TeslaBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   // mux, temp, mux0_read, mux1_read are instance member variables (TESLA-BATTERY.h)
 
   switch (rx_frame.ID) {
@@ -1854,18 +1860,243 @@ static constexpr CAN_frame can_msg_118[] = {
     {.FD = false, .ext_ID = false, .DLC = 8, .ID = 0x118, .data = {0x6F, 0x8E, 0x30, 0x10, 0x00, 0x08, 0x00, 0x80}},
     {.FD = false, .ext_ID = false, .DLC = 8, .ID = 0x118, .data = {0x70, 0x8F, 0x30, 0x10, 0x00, 0x08, 0x00, 0x80}}};
 
-void TeslaBattery::transmit_can(unsigned long currentMillis) {
-  // Ensure we only send one message branch at a time, to reduce worst-case
-  // runtime.
-  // transmitPhase is an instance member variable (TESLA-BATTERY.h)
-  if (++transmitPhase >= 5) {
-    transmitPhase = 0;
+void printDebugIfActive(uint8_t symbol, const char* message) {
+  if (symbol == 1) {
+    logging.println(message);
   }
+}
 
-  //Send 10ms messages
-  if (currentMillis - previousMillis10 >= INTERVAL_10_MS && transmitPhase == 0) {
-    previousMillis10 = currentMillis;
+void TeslaBattery::printFaultCodesIfActive() {
+  if (battery_packCtrsClosingBlocked &&
+      battery_packContactorSetState != 5) {  // Contactors blocked closing and not already closed
+    logging.println("ERROR: Check high voltage connectors and interlock circuit, closing contactors not allowed!");
+  }
+  if (battery_pyroTestInProgress) {
+    logging.println("ERROR: Please wait for pyro test to finish, HV cables successfully seated!");
+  }
+  if (datalayer.system.status.inverter_allows_contactor_closing == false) {
+    logging.println(
+        "ERROR: Solar inverter does not allow for contactor closing. Check communication connection to the inverter "
+        "or "
+        "disable the inverter protocol to proceed in Tesla battery testing mode.");
+  }
+  // Check each symbol and print debug information if its value is 1
+  // 0X3AA: 938 HVP_alertMatrix1
+  //printDebugIfActive(battery_WatchdogReset, "ERROR: The processor has experienced a reset due to watchdog reset"); //Uncommented due to not affecting usage
+  printDebugIfActive(battery_PowerLossReset, "ERROR: The processor has experienced a reset due to power loss");
+  printDebugIfActive(battery_SwAssertion, "ERROR: An internal software assertion has failed");
+  printDebugIfActive(battery_CrashEvent, "ERROR: crash signal is detected by HVP");
+  printDebugIfActive(battery_OverDchgCurrentFault,
+                     "ERROR: Pack discharge current is above the safe max discharge current limit!");
+  printDebugIfActive(battery_OverChargeCurrentFault,
+                     "ERROR: Pack charge current is above the safe max charge current limit!");
+  printDebugIfActive(battery_OverCurrentFault, "ERROR: Pack current (discharge or charge) is above max current limit!");
+  printDebugIfActive(battery_OverTemperatureFault,
+                     "ERROR: A pack module temperature is above the max temperature limit!");
+  printDebugIfActive(battery_OverVoltageFault, "ERROR: A brick voltage is above maximum voltage limit");
+  printDebugIfActive(battery_UnderVoltageFault, "ERROR: A brick voltage is below minimum voltage limit");
+  printDebugIfActive(battery_PrimaryBmbMiaFault,
+                     "ERROR: Voltage and temperature readings from primary BMB chain are mia");
+  printDebugIfActive(battery_SecondaryBmbMiaFault,
+                     "ERROR: Voltage and temperature readings from secondary BMB chain are mia");
+  printDebugIfActive(battery_BmbMismatchFault,
+                     "ERROR: Primary and secondary BMB chain readings don't match with each other");
+  printDebugIfActive(battery_BmsHviMiaFault, "ERROR: BMS node is mia on HVS or HVI CAN");
+  //printDebugIfActive(battery_CpMiaFault, "ERROR: CP node is mia on HVS CAN"); //Uncommented due to not affecting usage
+  printDebugIfActive(battery_PcsMiaFault, "ERROR: PCS node is mia on HVS CAN");
+  //printDebugIfActive(battery_BmsFault, "ERROR: BmsFault is active"); //Uncommented due to not affecting usage
+  printDebugIfActive(battery_PcsFault, "ERROR: PcsFault is active");
+  //printDebugIfActive(battery_CpFault, "ERROR: CpFault is active"); //Uncommented due to not affecting usage
+  printDebugIfActive(battery_ShuntHwMiaFault, "ERROR: Shunt current reading is not available");
+  printDebugIfActive(battery_PyroMiaFault, "ERROR: Pyro squib is not connected");
+  printDebugIfActive(battery_hvsMiaFault, "ERROR: Pack contactor hw fault");
+  printDebugIfActive(battery_hviMiaFault, "ERROR: FC contactor hw fault");
+  printDebugIfActive(battery_Supply12vFault, "ERROR: Low voltage (12V) battery is below minimum voltage threshold");
+  printDebugIfActive(battery_VerSupplyFault, "ERROR: Energy reserve voltage supply is below minimum voltage threshold");
+  printDebugIfActive(battery_HvilFault, "ERROR: High Voltage Inter Lock fault is detected");
+  printDebugIfActive(battery_BmsHvsMiaFault, "ERROR: BMS node is mia on HVS or HVI CAN");
+  printDebugIfActive(battery_PackVoltMismatchFault,
+                     "ERROR: Pack voltage doesn't match approximately with sum of brick voltages");
+  //printDebugIfActive(battery_EnsMiaFault, "ERROR: ENS line is not connected to HVC"); //Uncommented due to not affecting usage
+  printDebugIfActive(battery_PackPosCtrArcFault, "ERROR: HVP detectes series arc at pack contactor");
+  printDebugIfActive(battery_packNegCtrArcFault, "ERROR: HVP detectes series arc at FC contactor");
+  printDebugIfActive(battery_ShuntHwAndBmsMiaFault, "ERROR: ShuntHwAndBmsMiaFault is active");
+  printDebugIfActive(battery_fcContHwFault, "ERROR: fcContHwFault is active");
+  printDebugIfActive(battery_robinOverVoltageFault, "ERROR: robinOverVoltageFault is active");
+  printDebugIfActive(battery_packContHwFault, "ERROR: packContHwFault is active");
+  printDebugIfActive(battery_pyroFuseBlown, "ERROR: pyroFuseBlown is active");
+  printDebugIfActive(battery_pyroFuseFailedToBlow, "ERROR: pyroFuseFailedToBlow is active");
+  //printDebugIfActive(battery_CpilFault, "ERROR: CpilFault is active"); //Uncommented due to not affecting usage
+  printDebugIfActive(battery_PackContactorFellOpen, "ERROR: PackContactorFellOpen is active");
+  printDebugIfActive(battery_FcContactorFellOpen, "ERROR: FcContactorFellOpen is active");
+  printDebugIfActive(battery_packCtrCloseBlocked, "ERROR: packCtrCloseBlocked is active");
+  printDebugIfActive(battery_fcCtrCloseBlocked, "ERROR: fcCtrCloseBlocked is active");
+  printDebugIfActive(battery_packContactorForceOpen, "ERROR: packContactorForceOpen is active");
+  printDebugIfActive(battery_fcContactorForceOpen, "ERROR: fcContactorForceOpen is active");
+  printDebugIfActive(battery_dcLinkOverVoltage, "ERROR: dcLinkOverVoltage is active");
+  printDebugIfActive(battery_shuntOverTemperature, "ERROR: shuntOverTemperature is active");
+  printDebugIfActive(battery_passivePyroDeploy, "ERROR: passivePyroDeploy is active");
+  printDebugIfActive(battery_logUploadRequest, "ERROR: logUploadRequest is active");
+  printDebugIfActive(battery_packCtrCloseFailed, "ERROR: packCtrCloseFailed is active");
+  printDebugIfActive(battery_fcCtrCloseFailed, "ERROR: fcCtrCloseFailed is active");
+  printDebugIfActive(battery_shuntThermistorMia, "ERROR: shuntThermistorMia is active");
+  // 0x320 800 BMS_alertMatrix
+  printDebugIfActive(BMS_a017_SW_Brick_OV, "ERROR: BMS_a017_SW_Brick_OV");
+  printDebugIfActive(BMS_a018_SW_Brick_UV, "ERROR: BMS_a018_SW_Brick_UV");
+  printDebugIfActive(BMS_a019_SW_Module_OT, "ERROR: BMS_a019_SW_Module_OT");
+  printDebugIfActive(BMS_a021_SW_Dr_Limits_Regulation, "ERROR: BMS_a021_SW_Dr_Limits_Regulation");
+  //printDebugIfActive(BMS_a022_SW_Over_Current, "ERROR: BMS_a022_SW_Over_Current");
+  printDebugIfActive(BMS_a023_SW_Stack_OV, "ERROR: BMS_a023_SW_Stack_OV");
+  printDebugIfActive(BMS_a024_SW_Islanded_Brick, "ERROR: BMS_a024_SW_Islanded_Brick");
+  printDebugIfActive(BMS_a025_SW_PwrBalance_Anomaly, "ERROR: BMS_a025_SW_PwrBalance_Anomaly");
+  printDebugIfActive(BMS_a026_SW_HFCurrent_Anomaly, "ERROR: BMS_a026_SW_HFCurrent_Anomaly");
+  printDebugIfActive(BMS_a034_SW_Passive_Isolation, "ERROR: BMS_a034_SW_Passive_Isolation");
+  printDebugIfActive(BMS_a035_SW_Isolation, "ERROR: BMS_a035_SW_Isolation");
+  printDebugIfActive(BMS_a036_SW_HvpHvilFault, "ERROR: BMS_a036_SW_HvpHvilFault");
+  printDebugIfActive(BMS_a037_SW_Flood_Port_Open, "ERROR: BMS_a037_SW_Flood_Port_Open");
+  printDebugIfActive(BMS_a039_SW_DC_Link_Over_Voltage, "ERROR: BMS_a039_SW_DC_Link_Over_Voltage");
+  printDebugIfActive(BMS_a041_SW_Power_On_Reset, "ERROR: BMS_a041_SW_Power_On_Reset");
+  printDebugIfActive(BMS_a042_SW_MPU_Error, "ERROR: BMS_a042_SW_MPU_Error");
+  printDebugIfActive(BMS_a043_SW_Watch_Dog_Reset, "ERROR: BMS_a043_SW_Watch_Dog_Reset");
+  printDebugIfActive(BMS_a044_SW_Assertion, "ERROR: BMS_a044_SW_Assertion");
+  printDebugIfActive(BMS_a045_SW_Exception, "ERROR: BMS_a045_SW_Exception");
+  printDebugIfActive(BMS_a046_SW_Task_Stack_Usage, "ERROR: BMS_a046_SW_Task_Stack_Usage");
+  printDebugIfActive(BMS_a047_SW_Task_Stack_Overflow, "ERROR: BMS_a047_SW_Task_Stack_Overflow");
+  printDebugIfActive(BMS_a048_SW_Log_Upload_Request, "ERROR: BMS_a048_SW_Log_Upload_Request");
+  //printDebugIfActive(BMS_a050_SW_Brick_Voltage_MIA, "ERROR: BMS_a050_SW_Brick_Voltage_MIA");
+  printDebugIfActive(BMS_a051_SW_HVC_Vref_Bad, "ERROR: BMS_a051_SW_HVC_Vref_Bad");
+  printDebugIfActive(BMS_a052_SW_PCS_MIA, "ERROR: BMS_a052_SW_PCS_MIA");
+  printDebugIfActive(BMS_a053_SW_ThermalModel_Sanity, "ERROR: BMS_a053_SW_ThermalModel_Sanity");
+  printDebugIfActive(BMS_a054_SW_Ver_Supply_Fault, "ERROR: BMS_a054_SW_Ver_Supply_Fault");
+  printDebugIfActive(BMS_a059_SW_Pack_Voltage_Sensing, "ERROR: BMS_a059_SW_Pack_Voltage_Sensing");
+  printDebugIfActive(BMS_a060_SW_Leakage_Test_Failure, "ERROR: BMS_a060_SW_Leakage_Test_Failure");
+  printDebugIfActive(BMS_a061_robinBrickOverVoltage, "ERROR: BMS_a061_robinBrickOverVoltage");
+  printDebugIfActive(BMS_a062_SW_BrickV_Imbalance, "ERROR: BMS_a062_SW_BrickV_Imbalance");
+  //printDebugIfActive(BMS_a063_SW_ChargePort_Fault, "ERROR: BMS_a063_SW_ChargePort_Fault");
+  printDebugIfActive(BMS_a064_SW_SOC_Imbalance, "ERROR: BMS_a064_SW_SOC_Imbalance");
+  printDebugIfActive(BMS_a069_SW_Low_Power, "ERROR: BMS_a069_SW_Low_Power");
+  printDebugIfActive(BMS_a071_SW_SM_TransCon_Not_Met, "ERROR: BMS_a071_SW_SM_TransCon_Not_Met");
+  printDebugIfActive(BMS_a075_SW_Chg_Disable_Failure, "ERROR: BMS_a075_SW_Chg_Disable_Failure");
+  printDebugIfActive(BMS_a076_SW_Dch_While_Charging, "ERROR: BMS_a076_SW_Dch_While_Charging");
+  printDebugIfActive(BMS_a077_SW_Charger_Regulation, "ERROR: BMS_a077_SW_Charger_Regulation");
+  printDebugIfActive(BMS_a081_SW_Ctr_Close_Blocked, "ERROR: BMS_a081_SW_Ctr_Close_Blocked");
+  printDebugIfActive(BMS_a082_SW_Ctr_Force_Open, "ERROR: BMS_a082_SW_Ctr_Force_Open");
+  printDebugIfActive(BMS_a083_SW_Ctr_Close_Failure, "ERROR: BMS_a083_SW_Ctr_Close_Failure");
+  printDebugIfActive(BMS_a084_SW_Sleep_Wake_Aborted, "ERROR: BMS_a084_SW_Sleep_Wake_Aborted");
+  printDebugIfActive(BMS_a087_SW_Feim_Test_Blocked, "ERROR: BMS_a087_SW_Feim_Test_Blocked");
+  printDebugIfActive(BMS_a088_SW_VcFront_MIA_InDrive, "ERROR: BMS_a088_SW_VcFront_MIA_InDrive");
+  printDebugIfActive(BMS_a089_SW_VcFront_MIA, "ERROR: BMS_a089_SW_VcFront_MIA");
+  printDebugIfActive(BMS_a090_SW_Gateway_MIA, "ERROR: BMS_a090_SW_Gateway_MIA");
+  //printDebugIfActive(BMS_a091_SW_ChargePort_MIA, "ERROR: BMS_a091_SW_ChargePort_MIA");
+  //printDebugIfActive(BMS_a092_SW_ChargePort_Mia_On_Hv, "ERROR: BMS_a092_SW_ChargePort_Mia_On_Hv");
+  //printDebugIfActive(BMS_a094_SW_Drive_Inverter_MIA, "ERROR: BMS_a094_SW_Drive_Inverter_MIA");
+  printDebugIfActive(BMS_a099_SW_BMB_Communication, "ERROR: BMS_a099_SW_BMB_Communication");
+  printDebugIfActive(BMS_a105_SW_One_Module_Tsense, "ERROR: BMS_a105_SW_One_Module_Tsense");
+  printDebugIfActive(BMS_a106_SW_All_Module_Tsense, "ERROR: BMS_a106_SW_All_Module_Tsense");
+  printDebugIfActive(BMS_a107_SW_Stack_Voltage_MIA, "ERROR: BMS_a107_SW_Stack_Voltage_MIA");
+  printDebugIfActive(BMS_a121_SW_NVRAM_Config_Error, "ERROR: BMS_a121_SW_NVRAM_Config_Error");
+  printDebugIfActive(BMS_a122_SW_BMS_Therm_Irrational, "ERROR: BMS_a122_SW_BMS_Therm_Irrational");
+  printDebugIfActive(BMS_a123_SW_Internal_Isolation, "ERROR: BMS_a123_SW_Internal_Isolation");
+  printDebugIfActive(BMS_a127_SW_shunt_SNA, "ERROR: BMS_a127_SW_shunt_SNA");
+  printDebugIfActive(BMS_a128_SW_shunt_MIA, "ERROR: BMS_a128_SW_shunt_MIA");
+  printDebugIfActive(BMS_a129_SW_VSH_Failure, "ERROR: BMS_a129_SW_VSH_Failure");
+  printDebugIfActive(BMS_a130_IO_CAN_Error, "ERROR: BMS_a130_IO_CAN_Error");
+  printDebugIfActive(BMS_a131_Bleed_FET_Failure, "ERROR: BMS_a131_Bleed_FET_Failure");
+  printDebugIfActive(BMS_a132_HW_BMB_OTP_Uncorrctbl, "ERROR: BMS_a132_HW_BMB_OTP_Uncorrctbl");
+  printDebugIfActive(BMS_a134_SW_Delayed_Ctr_Off, "ERROR: BMS_a134_SW_Delayed_Ctr_Off");
+  printDebugIfActive(BMS_a136_SW_Module_OT_Warning, "ERROR: BMS_a136_SW_Module_OT_Warning");
+  printDebugIfActive(BMS_a137_SW_Brick_UV_Warning, "ERROR: BMS_a137_SW_Brick_UV_Warning");
+  printDebugIfActive(BMS_a139_SW_DC_Link_V_Irrational, "ERROR: BMS_a139_SW_DC_Link_V_Irrational");
+  printDebugIfActive(BMS_a141_SW_BMB_Status_Warning, "ERROR: BMS_a141_SW_BMB_Status_Warning");
+  printDebugIfActive(BMS_a144_Hvp_Config_Mismatch, "ERROR: BMS_a144_Hvp_Config_Mismatch");
+  printDebugIfActive(BMS_a145_SW_SOC_Change, "INFO: BMS_a145_SW_SOC_Change");
+  printDebugIfActive(BMS_a146_SW_Brick_Overdischarged, "ERROR: BMS_a146_SW_Brick_Overdischarged");
+  printDebugIfActive(BMS_a149_SW_Missing_Config_Block, "ERROR: BMS_a149_SW_Missing_Config_Block");
+  printDebugIfActive(BMS_a151_SW_external_isolation, "ERROR: BMS_a151_SW_external_isolation");
+  printDebugIfActive(BMS_a156_SW_BMB_Vref_bad, "ERROR: BMS_a156_SW_BMB_Vref_bad");
+  printDebugIfActive(BMS_a157_SW_HVP_HVS_Comms, "ERROR: BMS_a157_SW_HVP_HVS_Comms");
+  printDebugIfActive(BMS_a158_SW_HVP_HVI_Comms, "ERROR: BMS_a158_SW_HVP_HVI_Comms");
+  printDebugIfActive(BMS_a159_SW_HVP_ECU_Error, "ERROR: BMS_a159_SW_HVP_ECU_Error");
+  printDebugIfActive(BMS_a161_SW_DI_Open_Request, "ERROR: BMS_a161_SW_DI_Open_Request");
+  printDebugIfActive(BMS_a162_SW_No_Power_For_Support, "ERROR: BMS_a162_SW_No_Power_For_Support");
+  printDebugIfActive(BMS_a163_SW_Contactor_Mismatch, "ERROR: BMS_a163_SW_Contactor_Mismatch");
+  printDebugIfActive(BMS_a164_SW_Uncontrolled_Regen, "ERROR: BMS_a164_SW_Uncontrolled_Regen");
+  printDebugIfActive(BMS_a165_SW_Pack_Partial_Weld, "ERROR: BMS_a165_SW_Pack_Partial_Weld");
+  printDebugIfActive(BMS_a166_SW_Pack_Full_Weld, "ERROR: BMS_a166_SW_Pack_Full_Weld");
+  printDebugIfActive(BMS_a167_SW_FC_Partial_Weld, "ERROR: BMS_a167_SW_FC_Partial_Weld");
+  printDebugIfActive(BMS_a168_SW_FC_Full_Weld, "ERROR: BMS_a168_SW_FC_Full_Weld");
+  printDebugIfActive(BMS_a169_SW_FC_Pack_Weld, "ERROR: BMS_a169_SW_FC_Pack_Weld");
+  //printDebugIfActive(BMS_a170_SW_Limp_Mode, "ERROR: BMS_a170_SW_Limp_Mode");
+  printDebugIfActive(BMS_a171_SW_Stack_Voltage_Sense, "ERROR: BMS_a171_SW_Stack_Voltage_Sense");
+  printDebugIfActive(BMS_a174_SW_Charge_Failure, "ERROR: BMS_a174_SW_Charge_Failure");
+  printDebugIfActive(BMS_a176_SW_GracefulPowerOff, "ERROR: BMS_a176_SW_GracefulPowerOff");
+  printDebugIfActive(BMS_a179_SW_Hvp_12V_Fault, "ERROR: BMS_a179_SW_Hvp_12V_Fault");
+  printDebugIfActive(BMS_a180_SW_ECU_reset_blocked, "ERROR: BMS_a180_SW_ECU_reset_blocked");
+}
 
+void TeslaBattery::setup(void) {  // Performs one time setup at startup
+
+  if (allows_contactor_closing) {
+    *allows_contactor_closing = true;
+  }
+
+  //0x7FF GTW CAN frame values
+  //Mux1
+  write_signal_value(&TESLA_7FF_Mux1, 16, 16, user_selected_tesla_GTW_country, false);
+  write_signal_value(&TESLA_7FF_Mux1, 11, 1, user_selected_tesla_GTW_rightHandDrive, false);
+  //Mux3
+  write_signal_value(&TESLA_7FF_Mux3, 8, 4, user_selected_tesla_GTW_mapRegion, false);
+  write_signal_value(&TESLA_7FF_Mux3, 18, 3, user_selected_tesla_GTW_chassisType, false);
+  write_signal_value(&TESLA_7FF_Mux3, 32, 5, user_selected_tesla_GTW_packEnergy, false);
+
+  switch (
+      user_selected_tesla_GTW_packEnergy) {  //static const std::map<int, String> tesla_pack = {{0, "50 kWh"}, {2, "62 kWh"}, {1, "74 kWh"}, {3, "100 kWh"}};
+    case 0:
+      datalayer_battery->info.total_capacity_Wh = 50000;
+      break;
+    case 1:
+      datalayer_battery->info.total_capacity_Wh = 74000;
+      break;
+    case 2:
+      datalayer_battery->info.total_capacity_Wh = 62000;
+      break;
+    case 3:
+      datalayer_battery->info.total_capacity_Wh = 100000;
+      break;
+    default:
+      break;
+  }
+
+  //IF 3 / Y
+  if (user_selected_battery_type == BatteryType::TeslaModel3Y) {
+    strncpy(datalayer.system.info.battery_protocol, Name3Y, 63);
+    if (datalayer_battery->info.chemistry == battery_chemistry_enum::LFP) {
+      datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_3Y_LFP;
+      datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_3Y_LFP;
+      datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_LFP;
+      datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_LFP;
+      datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_LFP;
+    } else {
+      datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_3Y_NCMA;
+      datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_3Y_NCMA;
+      datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_NCA_NCM;
+      datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_NCA_NCM;
+      datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_NCA_NCM;
+    }
+  } else {  //S/X
+
+    strncpy(datalayer.system.info.battery_protocol, NameSX, 63);
+    datalayer.system.info.battery_protocol[63] = '\0';
+    datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_SX_NCMA;
+    datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_SX_NCMA;
+    datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_NCA_NCM;
+    datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_NCA_NCM;
+    datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_NCA_NCM;
+  }
+
+  // tx_scheduler gives each group its own phase, so the groups are not sent in the same ms
+  //Send 10ms messages
+  transmit_every(INTERVAL_10_MS, 2, [this](unsigned long currentMillis) {
     if (user_selected_tesla_digital_HVIL) {  //Special Digital HVIL mode for S/X 2024+ batteries
       if ((datalayer.system.status.inverter_allows_contactor_closing) &&
           (datalayer.system.status.system_status != FAULT)) {
@@ -1907,44 +2138,41 @@ void TeslaBattery::transmit_can(unsigned long currentMillis) {
     muxNumber_TESLA_2E1 = (muxNumber_TESLA_2E1 + 1) % 6;  //Cycle betweeen 0-1-2-3-4-5-0...
     //Generate next frames
     generateFrameCounterChecksum(TESLA_118, 8, 4, 0, 8);
-  }
-
+  });
   //Send 50ms messages
-  if (currentMillis - previousMillis50 >= INTERVAL_50_MS && transmitPhase == 1) {
-    previousMillis50 = currentMillis;
-
+  transmit_every(INTERVAL_50_MS, 3, [this](unsigned long currentMillis) {
     //0x221 VCFRONT_LVPowerState
     if (vehicleState == CAR_DRIVE) {
       if (alternateMux) {
         generateMuxFrameCounterChecksum(TESLA_221_DRIVE_Mux0, frameCounter_TESLA_221, 52, 4, 56, 8);
-        transmit_can_frame(&TESLA_221_DRIVE_Mux0);
+        transmit_can_frame(&TESLA_221_DRIVE_Mux0, CAN_TX_SAFETY);
       } else {
         generateMuxFrameCounterChecksum(TESLA_221_DRIVE_Mux1, frameCounter_TESLA_221, 52, 4, 56, 8);
-        transmit_can_frame(&TESLA_221_DRIVE_Mux1);
+        transmit_can_frame(&TESLA_221_DRIVE_Mux1, CAN_TX_SAFETY);
       }
     } else if (vehicleState == ACCESSORY) {
       if (alternateMux) {
         generateMuxFrameCounterChecksum(TESLA_221_ACCESSORY_Mux0, frameCounter_TESLA_221, 52, 4, 56, 8);
-        transmit_can_frame(&TESLA_221_ACCESSORY_Mux0);
+        transmit_can_frame(&TESLA_221_ACCESSORY_Mux0, CAN_TX_SAFETY);
       } else {
         generateMuxFrameCounterChecksum(TESLA_221_ACCESSORY_Mux1, frameCounter_TESLA_221, 52, 4, 56, 8);
-        transmit_can_frame(&TESLA_221_ACCESSORY_Mux1);
+        transmit_can_frame(&TESLA_221_ACCESSORY_Mux1, CAN_TX_SAFETY);
       }
     } else if (vehicleState == GOING_DOWN) {
       if (alternateMux) {
         generateMuxFrameCounterChecksum(TESLA_221_GOING_DOWN_Mux0, frameCounter_TESLA_221, 52, 4, 56, 8);
-        transmit_can_frame(&TESLA_221_GOING_DOWN_Mux0);
+        transmit_can_frame(&TESLA_221_GOING_DOWN_Mux0, CAN_TX_SAFETY);
       } else {
         generateMuxFrameCounterChecksum(TESLA_221_GOING_DOWN_Mux1, frameCounter_TESLA_221, 52, 4, 56, 8);
-        transmit_can_frame(&TESLA_221_GOING_DOWN_Mux1);
+        transmit_can_frame(&TESLA_221_GOING_DOWN_Mux1, CAN_TX_SAFETY);
       }
     } else if (vehicleState == CAR_OFF) {
       if (alternateMux) {
         generateMuxFrameCounterChecksum(TESLA_221_OFF_Mux0, frameCounter_TESLA_221, 52, 4, 56, 8);
-        transmit_can_frame(&TESLA_221_OFF_Mux0);
+        transmit_can_frame(&TESLA_221_OFF_Mux0, CAN_TX_SAFETY);
       } else {
         generateMuxFrameCounterChecksum(TESLA_221_OFF_Mux1, frameCounter_TESLA_221, 52, 4, 56, 8);
-        transmit_can_frame(&TESLA_221_OFF_Mux1);
+        transmit_can_frame(&TESLA_221_OFF_Mux1, CAN_TX_SAFETY);
       }
     }
 
@@ -1987,12 +2215,9 @@ void TeslaBattery::transmit_can(unsigned long currentMillis) {
 
     //Generate next frame
     generateFrameCounterChecksum(TESLA_39D, 8, 4, 0, 8);
-  }
-
+  });
   //Send 100ms messages
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS && transmitPhase == 2) {
-    previousMillis100 = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 8, [this](unsigned long currentMillis) {
     //0x102 VCLEFT_doorStatus, static
     transmit_can_frame(&TESLA_102);
     //0x103 VCRIGHT_doorStatus, static
@@ -2201,12 +2426,9 @@ void TeslaBattery::transmit_can(unsigned long currentMillis) {
           break;
       }
     }
-  }
-
+  });
   //Send 500ms messages
-  if (currentMillis - previousMillis500 >= INTERVAL_500_MS && transmitPhase == 3) {
-    previousMillis500 = currentMillis;
-
+  transmit_every(INTERVAL_500_MS, 8, [this](unsigned long currentMillis) {
     transmit_can_frame(&TESLA_213);
     transmit_can_frame(&TESLA_284);
     transmit_can_frame(&TESLA_293);
@@ -2226,251 +2448,13 @@ void TeslaBattery::transmit_can(unsigned long currentMillis) {
     generateFrameCounterChecksum(TESLA_293, 52, 4, 56, 8);
     generateFrameCounterChecksum(TESLA_313, 52, 4, 56, 8);
     generateFrameCounterChecksum(TESLA_334, 52, 4, 56, 8);
-  }
-
+  });
   //Send 1000ms messages
-  if (currentMillis - previousMillis1000 >= INTERVAL_1_S && transmitPhase == 4) {
-    previousMillis1000 = currentMillis;
-
+  transmit_every(INTERVAL_1_S, 2, [this](unsigned long currentMillis) {
     transmit_can_frame(&TESLA_082);
     transmit_can_frame(&TESLA_321);
 
     //Generate next frames
     generateFrameCounterChecksum(TESLA_321, 52, 4, 56, 8);
-  }
-}
-
-void printDebugIfActive(uint8_t symbol, const char* message) {
-  if (symbol == 1) {
-    logging.println(message);
-  }
-}
-
-void TeslaBattery::printFaultCodesIfActive() {
-  if (battery_packCtrsClosingBlocked &&
-      battery_packContactorSetState != 5) {  // Contactors blocked closing and not already closed
-    logging.println("ERROR: Check high voltage connectors and interlock circuit, closing contactors not allowed!");
-  }
-  if (battery_pyroTestInProgress) {
-    logging.println("ERROR: Please wait for pyro test to finish, HV cables successfully seated!");
-  }
-  if (datalayer.system.status.inverter_allows_contactor_closing == false) {
-    logging.println(
-        "ERROR: Solar inverter does not allow for contactor closing. Check communication connection to the inverter "
-        "or "
-        "disable the inverter protocol to proceed in Tesla battery testing mode.");
-  }
-  // Check each symbol and print debug information if its value is 1
-  // 0X3AA: 938 HVP_alertMatrix1
-  //printDebugIfActive(battery_WatchdogReset, "ERROR: The processor has experienced a reset due to watchdog reset"); //Uncommented due to not affecting usage
-  printDebugIfActive(battery_PowerLossReset, "ERROR: The processor has experienced a reset due to power loss");
-  printDebugIfActive(battery_SwAssertion, "ERROR: An internal software assertion has failed");
-  printDebugIfActive(battery_CrashEvent, "ERROR: crash signal is detected by HVP");
-  printDebugIfActive(battery_OverDchgCurrentFault,
-                     "ERROR: Pack discharge current is above the safe max discharge current limit!");
-  printDebugIfActive(battery_OverChargeCurrentFault,
-                     "ERROR: Pack charge current is above the safe max charge current limit!");
-  printDebugIfActive(battery_OverCurrentFault, "ERROR: Pack current (discharge or charge) is above max current limit!");
-  printDebugIfActive(battery_OverTemperatureFault,
-                     "ERROR: A pack module temperature is above the max temperature limit!");
-  printDebugIfActive(battery_OverVoltageFault, "ERROR: A brick voltage is above maximum voltage limit");
-  printDebugIfActive(battery_UnderVoltageFault, "ERROR: A brick voltage is below minimum voltage limit");
-  printDebugIfActive(battery_PrimaryBmbMiaFault,
-                     "ERROR: Voltage and temperature readings from primary BMB chain are mia");
-  printDebugIfActive(battery_SecondaryBmbMiaFault,
-                     "ERROR: Voltage and temperature readings from secondary BMB chain are mia");
-  printDebugIfActive(battery_BmbMismatchFault,
-                     "ERROR: Primary and secondary BMB chain readings don't match with each other");
-  printDebugIfActive(battery_BmsHviMiaFault, "ERROR: BMS node is mia on HVS or HVI CAN");
-  //printDebugIfActive(battery_CpMiaFault, "ERROR: CP node is mia on HVS CAN"); //Uncommented due to not affecting usage
-  printDebugIfActive(battery_PcsMiaFault, "ERROR: PCS node is mia on HVS CAN");
-  //printDebugIfActive(battery_BmsFault, "ERROR: BmsFault is active"); //Uncommented due to not affecting usage
-  printDebugIfActive(battery_PcsFault, "ERROR: PcsFault is active");
-  //printDebugIfActive(battery_CpFault, "ERROR: CpFault is active"); //Uncommented due to not affecting usage
-  printDebugIfActive(battery_ShuntHwMiaFault, "ERROR: Shunt current reading is not available");
-  printDebugIfActive(battery_PyroMiaFault, "ERROR: Pyro squib is not connected");
-  printDebugIfActive(battery_hvsMiaFault, "ERROR: Pack contactor hw fault");
-  printDebugIfActive(battery_hviMiaFault, "ERROR: FC contactor hw fault");
-  printDebugIfActive(battery_Supply12vFault, "ERROR: Low voltage (12V) battery is below minimum voltage threshold");
-  printDebugIfActive(battery_VerSupplyFault, "ERROR: Energy reserve voltage supply is below minimum voltage threshold");
-  printDebugIfActive(battery_HvilFault, "ERROR: High Voltage Inter Lock fault is detected");
-  printDebugIfActive(battery_BmsHvsMiaFault, "ERROR: BMS node is mia on HVS or HVI CAN");
-  printDebugIfActive(battery_PackVoltMismatchFault,
-                     "ERROR: Pack voltage doesn't match approximately with sum of brick voltages");
-  //printDebugIfActive(battery_EnsMiaFault, "ERROR: ENS line is not connected to HVC"); //Uncommented due to not affecting usage
-  printDebugIfActive(battery_PackPosCtrArcFault, "ERROR: HVP detectes series arc at pack contactor");
-  printDebugIfActive(battery_packNegCtrArcFault, "ERROR: HVP detectes series arc at FC contactor");
-  printDebugIfActive(battery_ShuntHwAndBmsMiaFault, "ERROR: ShuntHwAndBmsMiaFault is active");
-  printDebugIfActive(battery_fcContHwFault, "ERROR: fcContHwFault is active");
-  printDebugIfActive(battery_robinOverVoltageFault, "ERROR: robinOverVoltageFault is active");
-  printDebugIfActive(battery_packContHwFault, "ERROR: packContHwFault is active");
-  printDebugIfActive(battery_pyroFuseBlown, "ERROR: pyroFuseBlown is active");
-  printDebugIfActive(battery_pyroFuseFailedToBlow, "ERROR: pyroFuseFailedToBlow is active");
-  //printDebugIfActive(battery_CpilFault, "ERROR: CpilFault is active"); //Uncommented due to not affecting usage
-  printDebugIfActive(battery_PackContactorFellOpen, "ERROR: PackContactorFellOpen is active");
-  printDebugIfActive(battery_FcContactorFellOpen, "ERROR: FcContactorFellOpen is active");
-  printDebugIfActive(battery_packCtrCloseBlocked, "ERROR: packCtrCloseBlocked is active");
-  printDebugIfActive(battery_fcCtrCloseBlocked, "ERROR: fcCtrCloseBlocked is active");
-  printDebugIfActive(battery_packContactorForceOpen, "ERROR: packContactorForceOpen is active");
-  printDebugIfActive(battery_fcContactorForceOpen, "ERROR: fcContactorForceOpen is active");
-  printDebugIfActive(battery_dcLinkOverVoltage, "ERROR: dcLinkOverVoltage is active");
-  printDebugIfActive(battery_shuntOverTemperature, "ERROR: shuntOverTemperature is active");
-  printDebugIfActive(battery_passivePyroDeploy, "ERROR: passivePyroDeploy is active");
-  printDebugIfActive(battery_logUploadRequest, "ERROR: logUploadRequest is active");
-  printDebugIfActive(battery_packCtrCloseFailed, "ERROR: packCtrCloseFailed is active");
-  printDebugIfActive(battery_fcCtrCloseFailed, "ERROR: fcCtrCloseFailed is active");
-  printDebugIfActive(battery_shuntThermistorMia, "ERROR: shuntThermistorMia is active");
-  // 0x320 800 BMS_alertMatrix
-  printDebugIfActive(BMS_a017_SW_Brick_OV, "ERROR: BMS_a017_SW_Brick_OV");
-  printDebugIfActive(BMS_a018_SW_Brick_UV, "ERROR: BMS_a018_SW_Brick_UV");
-  printDebugIfActive(BMS_a019_SW_Module_OT, "ERROR: BMS_a019_SW_Module_OT");
-  printDebugIfActive(BMS_a021_SW_Dr_Limits_Regulation, "ERROR: BMS_a021_SW_Dr_Limits_Regulation");
-  //printDebugIfActive(BMS_a022_SW_Over_Current, "ERROR: BMS_a022_SW_Over_Current");
-  printDebugIfActive(BMS_a023_SW_Stack_OV, "ERROR: BMS_a023_SW_Stack_OV");
-  printDebugIfActive(BMS_a024_SW_Islanded_Brick, "ERROR: BMS_a024_SW_Islanded_Brick");
-  printDebugIfActive(BMS_a025_SW_PwrBalance_Anomaly, "ERROR: BMS_a025_SW_PwrBalance_Anomaly");
-  printDebugIfActive(BMS_a026_SW_HFCurrent_Anomaly, "ERROR: BMS_a026_SW_HFCurrent_Anomaly");
-  printDebugIfActive(BMS_a034_SW_Passive_Isolation, "ERROR: BMS_a034_SW_Passive_Isolation");
-  printDebugIfActive(BMS_a035_SW_Isolation, "ERROR: BMS_a035_SW_Isolation");
-  printDebugIfActive(BMS_a036_SW_HvpHvilFault, "ERROR: BMS_a036_SW_HvpHvilFault");
-  printDebugIfActive(BMS_a037_SW_Flood_Port_Open, "ERROR: BMS_a037_SW_Flood_Port_Open");
-  printDebugIfActive(BMS_a039_SW_DC_Link_Over_Voltage, "ERROR: BMS_a039_SW_DC_Link_Over_Voltage");
-  printDebugIfActive(BMS_a041_SW_Power_On_Reset, "ERROR: BMS_a041_SW_Power_On_Reset");
-  printDebugIfActive(BMS_a042_SW_MPU_Error, "ERROR: BMS_a042_SW_MPU_Error");
-  printDebugIfActive(BMS_a043_SW_Watch_Dog_Reset, "ERROR: BMS_a043_SW_Watch_Dog_Reset");
-  printDebugIfActive(BMS_a044_SW_Assertion, "ERROR: BMS_a044_SW_Assertion");
-  printDebugIfActive(BMS_a045_SW_Exception, "ERROR: BMS_a045_SW_Exception");
-  printDebugIfActive(BMS_a046_SW_Task_Stack_Usage, "ERROR: BMS_a046_SW_Task_Stack_Usage");
-  printDebugIfActive(BMS_a047_SW_Task_Stack_Overflow, "ERROR: BMS_a047_SW_Task_Stack_Overflow");
-  printDebugIfActive(BMS_a048_SW_Log_Upload_Request, "ERROR: BMS_a048_SW_Log_Upload_Request");
-  //printDebugIfActive(BMS_a050_SW_Brick_Voltage_MIA, "ERROR: BMS_a050_SW_Brick_Voltage_MIA");
-  printDebugIfActive(BMS_a051_SW_HVC_Vref_Bad, "ERROR: BMS_a051_SW_HVC_Vref_Bad");
-  printDebugIfActive(BMS_a052_SW_PCS_MIA, "ERROR: BMS_a052_SW_PCS_MIA");
-  printDebugIfActive(BMS_a053_SW_ThermalModel_Sanity, "ERROR: BMS_a053_SW_ThermalModel_Sanity");
-  printDebugIfActive(BMS_a054_SW_Ver_Supply_Fault, "ERROR: BMS_a054_SW_Ver_Supply_Fault");
-  printDebugIfActive(BMS_a059_SW_Pack_Voltage_Sensing, "ERROR: BMS_a059_SW_Pack_Voltage_Sensing");
-  printDebugIfActive(BMS_a060_SW_Leakage_Test_Failure, "ERROR: BMS_a060_SW_Leakage_Test_Failure");
-  printDebugIfActive(BMS_a061_robinBrickOverVoltage, "ERROR: BMS_a061_robinBrickOverVoltage");
-  printDebugIfActive(BMS_a062_SW_BrickV_Imbalance, "ERROR: BMS_a062_SW_BrickV_Imbalance");
-  //printDebugIfActive(BMS_a063_SW_ChargePort_Fault, "ERROR: BMS_a063_SW_ChargePort_Fault");
-  printDebugIfActive(BMS_a064_SW_SOC_Imbalance, "ERROR: BMS_a064_SW_SOC_Imbalance");
-  printDebugIfActive(BMS_a069_SW_Low_Power, "ERROR: BMS_a069_SW_Low_Power");
-  printDebugIfActive(BMS_a071_SW_SM_TransCon_Not_Met, "ERROR: BMS_a071_SW_SM_TransCon_Not_Met");
-  printDebugIfActive(BMS_a075_SW_Chg_Disable_Failure, "ERROR: BMS_a075_SW_Chg_Disable_Failure");
-  printDebugIfActive(BMS_a076_SW_Dch_While_Charging, "ERROR: BMS_a076_SW_Dch_While_Charging");
-  printDebugIfActive(BMS_a077_SW_Charger_Regulation, "ERROR: BMS_a077_SW_Charger_Regulation");
-  printDebugIfActive(BMS_a081_SW_Ctr_Close_Blocked, "ERROR: BMS_a081_SW_Ctr_Close_Blocked");
-  printDebugIfActive(BMS_a082_SW_Ctr_Force_Open, "ERROR: BMS_a082_SW_Ctr_Force_Open");
-  printDebugIfActive(BMS_a083_SW_Ctr_Close_Failure, "ERROR: BMS_a083_SW_Ctr_Close_Failure");
-  printDebugIfActive(BMS_a084_SW_Sleep_Wake_Aborted, "ERROR: BMS_a084_SW_Sleep_Wake_Aborted");
-  printDebugIfActive(BMS_a087_SW_Feim_Test_Blocked, "ERROR: BMS_a087_SW_Feim_Test_Blocked");
-  printDebugIfActive(BMS_a088_SW_VcFront_MIA_InDrive, "ERROR: BMS_a088_SW_VcFront_MIA_InDrive");
-  printDebugIfActive(BMS_a089_SW_VcFront_MIA, "ERROR: BMS_a089_SW_VcFront_MIA");
-  printDebugIfActive(BMS_a090_SW_Gateway_MIA, "ERROR: BMS_a090_SW_Gateway_MIA");
-  //printDebugIfActive(BMS_a091_SW_ChargePort_MIA, "ERROR: BMS_a091_SW_ChargePort_MIA");
-  //printDebugIfActive(BMS_a092_SW_ChargePort_Mia_On_Hv, "ERROR: BMS_a092_SW_ChargePort_Mia_On_Hv");
-  //printDebugIfActive(BMS_a094_SW_Drive_Inverter_MIA, "ERROR: BMS_a094_SW_Drive_Inverter_MIA");
-  printDebugIfActive(BMS_a099_SW_BMB_Communication, "ERROR: BMS_a099_SW_BMB_Communication");
-  printDebugIfActive(BMS_a105_SW_One_Module_Tsense, "ERROR: BMS_a105_SW_One_Module_Tsense");
-  printDebugIfActive(BMS_a106_SW_All_Module_Tsense, "ERROR: BMS_a106_SW_All_Module_Tsense");
-  printDebugIfActive(BMS_a107_SW_Stack_Voltage_MIA, "ERROR: BMS_a107_SW_Stack_Voltage_MIA");
-  printDebugIfActive(BMS_a121_SW_NVRAM_Config_Error, "ERROR: BMS_a121_SW_NVRAM_Config_Error");
-  printDebugIfActive(BMS_a122_SW_BMS_Therm_Irrational, "ERROR: BMS_a122_SW_BMS_Therm_Irrational");
-  printDebugIfActive(BMS_a123_SW_Internal_Isolation, "ERROR: BMS_a123_SW_Internal_Isolation");
-  printDebugIfActive(BMS_a127_SW_shunt_SNA, "ERROR: BMS_a127_SW_shunt_SNA");
-  printDebugIfActive(BMS_a128_SW_shunt_MIA, "ERROR: BMS_a128_SW_shunt_MIA");
-  printDebugIfActive(BMS_a129_SW_VSH_Failure, "ERROR: BMS_a129_SW_VSH_Failure");
-  printDebugIfActive(BMS_a130_IO_CAN_Error, "ERROR: BMS_a130_IO_CAN_Error");
-  printDebugIfActive(BMS_a131_Bleed_FET_Failure, "ERROR: BMS_a131_Bleed_FET_Failure");
-  printDebugIfActive(BMS_a132_HW_BMB_OTP_Uncorrctbl, "ERROR: BMS_a132_HW_BMB_OTP_Uncorrctbl");
-  printDebugIfActive(BMS_a134_SW_Delayed_Ctr_Off, "ERROR: BMS_a134_SW_Delayed_Ctr_Off");
-  printDebugIfActive(BMS_a136_SW_Module_OT_Warning, "ERROR: BMS_a136_SW_Module_OT_Warning");
-  printDebugIfActive(BMS_a137_SW_Brick_UV_Warning, "ERROR: BMS_a137_SW_Brick_UV_Warning");
-  printDebugIfActive(BMS_a139_SW_DC_Link_V_Irrational, "ERROR: BMS_a139_SW_DC_Link_V_Irrational");
-  printDebugIfActive(BMS_a141_SW_BMB_Status_Warning, "ERROR: BMS_a141_SW_BMB_Status_Warning");
-  printDebugIfActive(BMS_a144_Hvp_Config_Mismatch, "ERROR: BMS_a144_Hvp_Config_Mismatch");
-  printDebugIfActive(BMS_a145_SW_SOC_Change, "INFO: BMS_a145_SW_SOC_Change");
-  printDebugIfActive(BMS_a146_SW_Brick_Overdischarged, "ERROR: BMS_a146_SW_Brick_Overdischarged");
-  printDebugIfActive(BMS_a149_SW_Missing_Config_Block, "ERROR: BMS_a149_SW_Missing_Config_Block");
-  printDebugIfActive(BMS_a151_SW_external_isolation, "ERROR: BMS_a151_SW_external_isolation");
-  printDebugIfActive(BMS_a156_SW_BMB_Vref_bad, "ERROR: BMS_a156_SW_BMB_Vref_bad");
-  printDebugIfActive(BMS_a157_SW_HVP_HVS_Comms, "ERROR: BMS_a157_SW_HVP_HVS_Comms");
-  printDebugIfActive(BMS_a158_SW_HVP_HVI_Comms, "ERROR: BMS_a158_SW_HVP_HVI_Comms");
-  printDebugIfActive(BMS_a159_SW_HVP_ECU_Error, "ERROR: BMS_a159_SW_HVP_ECU_Error");
-  printDebugIfActive(BMS_a161_SW_DI_Open_Request, "ERROR: BMS_a161_SW_DI_Open_Request");
-  printDebugIfActive(BMS_a162_SW_No_Power_For_Support, "ERROR: BMS_a162_SW_No_Power_For_Support");
-  printDebugIfActive(BMS_a163_SW_Contactor_Mismatch, "ERROR: BMS_a163_SW_Contactor_Mismatch");
-  printDebugIfActive(BMS_a164_SW_Uncontrolled_Regen, "ERROR: BMS_a164_SW_Uncontrolled_Regen");
-  printDebugIfActive(BMS_a165_SW_Pack_Partial_Weld, "ERROR: BMS_a165_SW_Pack_Partial_Weld");
-  printDebugIfActive(BMS_a166_SW_Pack_Full_Weld, "ERROR: BMS_a166_SW_Pack_Full_Weld");
-  printDebugIfActive(BMS_a167_SW_FC_Partial_Weld, "ERROR: BMS_a167_SW_FC_Partial_Weld");
-  printDebugIfActive(BMS_a168_SW_FC_Full_Weld, "ERROR: BMS_a168_SW_FC_Full_Weld");
-  printDebugIfActive(BMS_a169_SW_FC_Pack_Weld, "ERROR: BMS_a169_SW_FC_Pack_Weld");
-  //printDebugIfActive(BMS_a170_SW_Limp_Mode, "ERROR: BMS_a170_SW_Limp_Mode");
-  printDebugIfActive(BMS_a171_SW_Stack_Voltage_Sense, "ERROR: BMS_a171_SW_Stack_Voltage_Sense");
-  printDebugIfActive(BMS_a174_SW_Charge_Failure, "ERROR: BMS_a174_SW_Charge_Failure");
-  printDebugIfActive(BMS_a176_SW_GracefulPowerOff, "ERROR: BMS_a176_SW_GracefulPowerOff");
-  printDebugIfActive(BMS_a179_SW_Hvp_12V_Fault, "ERROR: BMS_a179_SW_Hvp_12V_Fault");
-  printDebugIfActive(BMS_a180_SW_ECU_reset_blocked, "ERROR: BMS_a180_SW_ECU_reset_blocked");
-}
-
-void TeslaBattery::setup(void) {  // Performs one time setup at startup
-
-  if (allows_contactor_closing) {
-    *allows_contactor_closing = true;
-  }
-
-  //0x7FF GTW CAN frame values
-  //Mux1
-  write_signal_value(&TESLA_7FF_Mux1, 16, 16, user_selected_tesla_GTW_country, false);
-  write_signal_value(&TESLA_7FF_Mux1, 11, 1, user_selected_tesla_GTW_rightHandDrive, false);
-  //Mux3
-  write_signal_value(&TESLA_7FF_Mux3, 8, 4, user_selected_tesla_GTW_mapRegion, false);
-  write_signal_value(&TESLA_7FF_Mux3, 18, 3, user_selected_tesla_GTW_chassisType, false);
-  write_signal_value(&TESLA_7FF_Mux3, 32, 5, user_selected_tesla_GTW_packEnergy, false);
-
-  switch (
-      user_selected_tesla_GTW_packEnergy) {  //static const std::map<int, String> tesla_pack = {{0, "50 kWh"}, {2, "62 kWh"}, {1, "74 kWh"}, {3, "100 kWh"}};
-    case 0:
-      datalayer_battery->info.total_capacity_Wh = 50000;
-      break;
-    case 1:
-      datalayer_battery->info.total_capacity_Wh = 74000;
-      break;
-    case 2:
-      datalayer_battery->info.total_capacity_Wh = 62000;
-      break;
-    case 3:
-      datalayer_battery->info.total_capacity_Wh = 100000;
-      break;
-    default:
-      break;
-  }
-
-  //IF 3 / Y
-  if (user_selected_battery_type == BatteryType::TeslaModel3Y) {
-    strncpy(datalayer.system.info.battery_protocol, Name3Y, 63);
-    if (datalayer_battery->info.chemistry == battery_chemistry_enum::LFP) {
-      datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_3Y_LFP;
-      datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_3Y_LFP;
-      datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_LFP;
-      datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_LFP;
-      datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_LFP;
-    } else {
-      datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_3Y_NCMA;
-      datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_3Y_NCMA;
-      datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_NCA_NCM;
-      datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_NCA_NCM;
-      datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_NCA_NCM;
-    }
-  } else {  //S/X
-
-    strncpy(datalayer.system.info.battery_protocol, NameSX, 63);
-    datalayer.system.info.battery_protocol[63] = '\0';
-    datalayer_battery->info.max_design_voltage_dV = MAX_PACK_VOLTAGE_SX_NCMA;
-    datalayer_battery->info.min_design_voltage_dV = MIN_PACK_VOLTAGE_SX_NCMA;
-    datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_NCA_NCM;
-    datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_NCA_NCM;
-    datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_NCA_NCM;
-  }
+  });
 }
@@ -13,24 +13,35 @@ extern uint16_t user_selected_tesla_GTW_mapRegion;
 extern uint16_t user_selected_tesla_GTW_chassisType;
 extern uint16_t user_selected_tesla_GTW_packEnergy;
 
+// Lowest and highest ID in handled_can_ids, all standard frames. The rest of the vehicle bus, extended frames with an
+// ID in that range included, is dropped before it reaches the battery.
+static const CAN_ID_Filter TESLA_CAN_ID_FILTER = {0, 0, 0x132, 0x7AA, CAN_ID_Format::STANDARD};
+
 class TeslaBattery : public CanBattery {
  public:
   // Use the default constructor to create the first or single battery.
-  TeslaBattery() {
+  TeslaBattery()
+      : CanBattery(CAN_Speed::CAN_SPEED_500KBPS, TESLA_CAN_ID_FILTER), renderer(datalayer_extended.tesla.get()) {
     datalayer_battery = &datalayer.battery;
+    datalayer_tesla = datalayer_extended.tesla.get();
     allows_contactor_closing = &datalayer.system.status.battery_allows_contactor_closing;
     previous_max_percentage = datalayer.battery.settings.max_percentage;
   }
   // Use this constructor for the second or third battery.
-  TeslaBattery(DATALAYER_BATTERY_TYPE* datalayer_ptr, CAN_Interface targetCan) : CanBattery(targetCan) {
+  TeslaBattery(DATALAYER_BATTERY_TYPE* datalayer_ptr, CAN_Interface targetCan)
+      : CanBattery(targetCan, CAN_Speed::CAN_SPEED_500KBPS, TESLA_CAN_ID_FILTER),
+        renderer(datalayer_extended.tesla.get()) {
     datalayer_battery = datalayer_ptr;
+    datalayer_tesla = datalayer_extended.tesla.get();
     allows_contactor_closing = nullptr;
     previous_max_percentage = datalayer_ptr->settings.max_percentage;
   }
   virtual void setup();
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
+  virtual std::vector<uint32_t> handled_can_ids();
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
 
   bool supports_clear_isolation() { return true; }
   void clear_isolation() { datalayer_battery->settings.user_requests_tesla_isolation_clear = true; }
@@ -43,6 +54,8 @@ class TeslaBattery : public CanBattery {
 
   bool supports_charged_energy() { return true; }
 
+  const DATALAYER_INFO_TESLA* tesla_info() { return datalayer_tesla; }
+
   bool supports_manual_balancing() { return true; }
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
@@ -52,6 +65,7 @@ class TeslaBattery : public CanBattery {
 
  private:
   TeslaHtmlRenderer renderer;
+  DATALAYER_INFO_TESLA* datalayer_tesla;
 
  protected:
   /* Do not change anything below this line! */
@@ -86,9 +100,6 @@ class TeslaBattery : public CanBattery {
   uint8_t mux_zero_counter = 0;  // counts mux==0 frames to detect full cell scan
   uint8_t mux_max = 0;           // highest mux index seen so far
 
-  // Per-instance state for transmit_can.
-  int transmitPhase = -1;
-
   bool operate_contactors = false;
 
   // If not null, this battery decides when the contactor can be closed and writes the value here.
@@ -96,12 +107,6 @@ class TeslaBattery : public CanBattery {
 
   void printFaultCodesIfActive();
 
-  unsigned long previousMillis10 = 0;    // will store last time a 50ms CAN Message was sent
-  unsigned long previousMillis50 = 0;    // will store last time a 50ms CAN Message was sent
-  unsigned long previousMillis100 = 0;   // will store last time a 100ms CAN Message was sent
-  unsigned long previousMillis500 = 0;   // will store last time a 500ms CAN Message was sent
-  unsigned long previousMillis1000 = 0;  // will store last time a 1000ms CAN Message was sent
-
   //UDS session tracker
   //static bool uds_SessionInProgress = false; // Future use
   //0x221 VCFRONT_LVPowerState
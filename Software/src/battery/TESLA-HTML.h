@@ -17,123 +17,30 @@ static void appendFault(String& string, const char* name, bool faultActive) {
 
 class TeslaHtmlRenderer : public BatteryHtmlRenderer {
  public:
+  TeslaHtmlRenderer(DATALAYER_INFO_TESLA* dl) : tesla_dl(dl) {}
+
   String get_status_html() {
     String content;
+    render_pack_status(content);
+    render_bms_status(content);
+    render_pcs_status(content);
+    render_hvp_status(content);
+    return content;
+  }
 
-    float beginning_of_life = static_cast<float>(datalayer_extended.tesla.battery_beginning_of_life);
-    float battTempPct = static_cast<float>(datalayer_extended.tesla.battery_battTempPct) * 0.4f;
-    float dcdcLvBusVolt = static_cast<float>(datalayer_extended.tesla.battery_dcdcLvBusVolt) * 0.0390625f;
-    float dcdcHvBusVolt = static_cast<float>(datalayer_extended.tesla.battery_dcdcHvBusVolt) * 0.146484f;
-    float dcdcLvOutputCurrent = static_cast<float>(datalayer_extended.tesla.battery_dcdcLvOutputCurrent) * 0.1f;
-    float nominal_full_pack_energy =
-        static_cast<float>(datalayer_extended.tesla.battery_nominal_full_pack_energy) * 0.1f;
-    float nominal_full_pack_energy_m0 =
-        static_cast<float>(datalayer_extended.tesla.battery_nominal_full_pack_energy_m0) * 0.02f;
-    float nominal_energy_remaining =
-        static_cast<float>(datalayer_extended.tesla.battery_nominal_energy_remaining) * 0.1f;
-    float nominal_energy_remaining_m0 =
-        static_cast<float>(datalayer_extended.tesla.battery_nominal_energy_remaining_m0) * 0.02f;
-    float ideal_energy_remaining = static_cast<float>(datalayer_extended.tesla.battery_ideal_energy_remaining) * 0.1f;
-    float ideal_energy_remaining_m0 =
-        static_cast<float>(datalayer_extended.tesla.battery_ideal_energy_remaining_m0) * 0.02f;
-    float energy_to_charge_complete =
-        static_cast<float>(datalayer_extended.tesla.battery_energy_to_charge_complete) * 0.1f;
-    float energy_to_charge_complete_m1 =
-        static_cast<float>(datalayer_extended.tesla.battery_energy_to_charge_complete_m1) * 0.02f;
-    float energy_buffer = static_cast<float>(datalayer_extended.tesla.battery_energy_buffer) * 0.1f;
-    float energy_buffer_m1 = static_cast<float>(datalayer_extended.tesla.battery_energy_buffer_m1) * 0.01f;
-    float expected_energy_remaining_m1 =
-        static_cast<float>(datalayer_extended.tesla.battery_expected_energy_remaining_m1) * 0.02f;
+  // The page is long, so each block is a section of its own and only one is held in memory at a time
+  void status_sections(HtmlChunkedPage& page) {
+    page.section([this](String& content) { render_pack_status(content); });
+    page.section([this](String& content) { render_bms_status(content); });
+    page.section([this](String& content) { render_pcs_status(content); });
+    page.section([this](String& content) { render_hvp_status(content); });
+  }
+
+ private:
+  void render_pack_status(String& content) {
     float total_discharge = static_cast<float>(datalayer.battery.status.total_discharged_battery_Wh) * 0.001f;
     float total_charge = static_cast<float>(datalayer.battery.status.total_charged_battery_Wh) * 0.001f;
-    float packMass = static_cast<float>(datalayer_extended.tesla.battery_packMass);
-    float platformMaxBusVoltage =
-        static_cast<float>(datalayer_extended.tesla.battery_platformMaxBusVoltage) * 0.1f + 375;
-    float bms_min_voltage = static_cast<float>(datalayer_extended.tesla.BMS_min_voltage) * 0.01f * 2;
-    float bms_max_voltage = static_cast<float>(datalayer_extended.tesla.BMS_max_voltage) * 0.01f * 2;
-    float max_charge_current = static_cast<float>(datalayer_extended.tesla.battery_max_charge_current);
-    float max_discharge_current = static_cast<float>(datalayer_extended.tesla.battery_max_discharge_current);
-    float soc_ave = static_cast<float>(datalayer_extended.tesla.battery_soc_ave) * 0.1f;
-    float soc_max = static_cast<float>(datalayer_extended.tesla.battery_soc_max) * 0.1f;
-    float soc_min = static_cast<float>(datalayer_extended.tesla.battery_soc_min) * 0.1f;
-    float soc_ui = static_cast<float>(datalayer_extended.tesla.battery_soc_ui) * 0.1f;
-    float BrickVoltageMax = static_cast<float>(datalayer_extended.tesla.battery_BrickVoltageMax) * 0.002f;
-    float BrickVoltageMin = static_cast<float>(datalayer_extended.tesla.battery_BrickVoltageMin) * 0.002f;
-    //float BrickModelTMax = static_cast<float>(datalayer_extended.tesla.battery_BrickModelTMax) * 0.5 - 40;
-    //float BrickModelTMin = static_cast<float>(datalayer_extended.tesla.battery_BrickModelTMin) * 0.5 - 40;
-    float isolationResistance = static_cast<float>(datalayer_extended.tesla.BMS_isolationResistance) * 10;
-    float PCS_dcdcMaxOutputCurrentAllowed =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdcMaxOutputCurrentAllowed) * 0.1f;
-    float PCS_dcdcTemp = static_cast<float>(datalayer_extended.tesla.PCS_dcdcTemp) * 0.1f + 40.0f;
-    float PCS_ambientTemp = static_cast<float>(datalayer_extended.tesla.PCS_ambientTemp) * 0.1f + 40.0f;
-    float PCS_chgPhATemp = static_cast<float>(datalayer_extended.tesla.PCS_chgPhATemp) * 0.1f + 40.0f;
-    float PCS_chgPhBTemp = static_cast<float>(datalayer_extended.tesla.PCS_chgPhBTemp) * 0.1f + 40.0f;
-    float PCS_chgPhCTemp = static_cast<float>(datalayer_extended.tesla.PCS_chgPhCTemp) * 0.1f + 40.0f;
-    float BMS_maxRegenPower = static_cast<float>(datalayer_extended.tesla.BMS_maxRegenPower) * 0.01f;
-    float BMS_maxDischargePower = static_cast<float>(datalayer_extended.tesla.BMS_maxDischargePower) * 0.013f;
-    //float BMS_maxStationaryHeatPower = static_cast<float>(datalayer_extended.tesla.BMS_maxStationaryHeatPower) * 0.01f;
-    //float BMS_hvacPowerBudget = static_cast<float>(datalayer_extended.tesla.BMS_hvacPowerBudget) * 0.02;
-    float BMS_powerDissipation = static_cast<float>(datalayer_extended.tesla.BMS_powerDissipation) * 0.02f;
-    float BMS_flowRequest = static_cast<float>(datalayer_extended.tesla.BMS_flowRequest) * 0.3f;
-    float BMS_inletActiveCoolTargetT =
-        static_cast<float>(datalayer_extended.tesla.BMS_inletActiveCoolTargetT) * 0.25f - 25;
-    float BMS_inletPassiveTargetT = static_cast<float>(datalayer_extended.tesla.BMS_inletPassiveTargetT) * 0.25f - 25;
-    float BMS_inletActiveHeatTargetT =
-        static_cast<float>(datalayer_extended.tesla.BMS_inletActiveHeatTargetT) * 0.25f - 25;
-    float BMS_packTMin = static_cast<float>(datalayer_extended.tesla.BMS_packTMin) * 0.25f - 25;
-    float BMS_packTMax = static_cast<float>(datalayer_extended.tesla.BMS_packTMax) * 0.25f - 25;
-    float PCS_dcdcMaxLvOutputCurrent = static_cast<float>(datalayer_extended.tesla.PCS_dcdcMaxLvOutputCurrent) * 0.1f;
-    float PCS_dcdcCurrentLimit = static_cast<float>(datalayer_extended.tesla.PCS_dcdcCurrentLimit) * 0.1f;
-    float PCS_dcdcLvOutputCurrentTempLimit =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdcLvOutputCurrentTempLimit) * 0.1f;
-    float PCS_dcdcUnifiedCommand = static_cast<float>(datalayer_extended.tesla.PCS_dcdcUnifiedCommand) * 0.001f;
-    float PCS_dcdcCLAControllerOutput =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdcCLAControllerOutput * 0.001f);
-    float PCS_dcdcTankVoltage = static_cast<float>(datalayer_extended.tesla.PCS_dcdcTankVoltage);
-    float PCS_dcdcTankVoltageTarget = static_cast<float>(datalayer_extended.tesla.PCS_dcdcTankVoltageTarget);
-    float PCS_dcdcClaCurrentFreq = static_cast<float>(datalayer_extended.tesla.PCS_dcdcClaCurrentFreq) * 0.0976563f;
-    float PCS_dcdcTCommMeasured = static_cast<float>(datalayer_extended.tesla.PCS_dcdcTCommMeasured) * 0.00195313f;
-    float PCS_dcdcShortTimeUs = static_cast<float>(datalayer_extended.tesla.PCS_dcdcShortTimeUs) * 0.000488281f;
-    float PCS_dcdcHalfPeriodUs = static_cast<float>(datalayer_extended.tesla.PCS_dcdcHalfPeriodUs) * 0.000488281f;
-    float PCS_dcdcIntervalMaxFrequency = static_cast<float>(datalayer_extended.tesla.PCS_dcdcIntervalMaxFrequency);
-    float PCS_dcdcIntervalMaxHvBusVolt =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdcIntervalMaxHvBusVolt) * 0.1f;
-    float PCS_dcdcIntervalMaxLvBusVolt =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdcIntervalMaxLvBusVolt) * 0.1f;
-    float PCS_dcdcIntervalMaxLvOutputCurr =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdcIntervalMaxLvOutputCurr);
-    float PCS_dcdcIntervalMinFrequency = static_cast<float>(datalayer_extended.tesla.PCS_dcdcIntervalMinFrequency);
-    float PCS_dcdcIntervalMinHvBusVolt =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdcIntervalMinHvBusVolt) * 0.1f;
-    float PCS_dcdcIntervalMinLvBusVolt =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdcIntervalMinLvBusVolt) * 0.1f;
-    float PCS_dcdcIntervalMinLvOutputCurr =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdcIntervalMinLvOutputCurr);
-    float PCS_dcdc12vSupportLifetimekWh =
-        static_cast<float>(datalayer_extended.tesla.PCS_dcdc12vSupportLifetimekWh) * 0.01f;
-    float HVP_hvp1v5Ref = static_cast<float>(datalayer_extended.tesla.HVP_hvp1v5Ref) * 0.1f;
-    float HVP_shuntCurrentDebug = static_cast<float>(datalayer_extended.tesla.HVP_shuntCurrentDebug) * 0.1f;
-    float HVP_dcLinkVoltage = static_cast<float>(datalayer_extended.tesla.HVP_dcLinkVoltage) * 0.1f;
-    float HVP_packVoltage = static_cast<float>(datalayer_extended.tesla.HVP_packVoltage) * 0.1f;
-    //float HVP_fcLinkVoltage = static_cast<float>(datalayer_extended.tesla.HVP_fcLinkVoltage) * 0.1f;
-    float HVP_packContVoltage = static_cast<float>(datalayer_extended.tesla.HVP_packContVoltage) * 0.1f;
-    //float HVP_packNegativeV = static_cast<float>(datalayer_extended.tesla.HVP_packNegativeV) * 0.1f;
-    //float HVP_packPositiveV = static_cast<float>(datalayer_extended.tesla.HVP_packPositiveV) * 0.1f;
-    float HVP_pyroAnalog = static_cast<float>(datalayer_extended.tesla.HVP_pyroAnalog) * 0.1f;
-    //float HVP_dcLinkNegativeV = static_cast<float>(datalayer_extended.tesla.HVP_dcLinkNegativeV) * 0.1f;
-    //float HVP_dcLinkPositiveV = static_cast<float>(datalayer_extended.tesla.HVP_dcLinkPositiveV) * 0.1f;
-    //float HVP_fcLinkNegativeV = static_cast<float>(datalayer_extended.tesla.HVP_fcLinkNegativeV) * 0.1f;
-    //float HVP_fcContCoilCurrent = static_cast<float>(datalayer_extended.tesla.HVP_fcContCoilCurrent) * 0.1f;
-    //float HVP_fcContVoltage = static_cast<float>(datalayer_extended.tesla.HVP_fcContVoltage) * 0.1f;
-    float HVP_hvilInVoltage = static_cast<float>(datalayer_extended.tesla.HVP_hvilInVoltage) * 0.1f;
-    float HVP_hvilOutVoltage = static_cast<float>(datalayer_extended.tesla.HVP_hvilOutVoltage) * 0.1f;
-    //float HVP_fcLinkPositiveV = static_cast<float>(datalayer_extended.tesla.HVP_fcLinkPositiveV) * 0.1f;
-    float HVP_packContCoilCurrent = static_cast<float>(datalayer_extended.tesla.HVP_packContCoilCurrent) * 0.1f;
-    float HVP_battery12V = static_cast<float>(datalayer_extended.tesla.HVP_battery12V) * 0.1f;
-    //float HVP_shuntRefVoltageDbg = static_cast<float>(datalayer_extended.tesla.HVP_shuntRefVoltageDbg) * 0.001f;
-    //float HVP_shuntAuxCurrentDbg = static_cast<float>(datalayer_extended.tesla.HVP_shuntAuxCurrentDbg) * 0.1f;
-    //float HVP_shuntBarTempDbg = static_cast<float>(datalayer_extended.tesla.HVP_shuntBarTempDbg) * 0.01f;
-    //float HVP_shuntAsicTempDbg = static_cast<float>(datalayer_extended.tesla.HVP_shuntAsicTempDbg) * 0.01f;
+    float packMass = static_cast<float>(tesla_dl->battery_packMass);
 
     static const char* contactorText[] = {"UNKNOWN(0)",  "OPEN",        "CLOSING",    "BLOCKED", "OPENING",
                                           "CLOSED",      "UNKNOWN(6)",  "WELDED",     "POS_CL",  "NEG_CL",
@@ -157,96 +64,96 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
     static const char* contactorState[] = {"SNA",        "OPEN",       "PRECHARGE",   "BLOCKED",
                                            "PULLED_IN",  "OPENING",    "ECONOMIZED",  "WELDED",
                                            "UNKNOWN(8)", "UNKNOWN(9)", "UNKNOWN(10)", "UNKNOWN(11)"};
-    static const char* BMS_state[] = {"STANDBY",     "DRIVE", "SUPPORT", "CHARGE", "FEIM",
-                                      "CLEAR_FAULT", "FAULT", "WELD",    "TEST",   "SNA"};
     static const char* BMS_contactorState[] = {"SNA", "OPEN", "OPENING", "CLOSING", "CLOSED", "WELDED", "BLOCKED"};
-    static const char* BMS_hvState[] = {"DOWN",          "COMING_UP",        "GOING_DOWN", "UP_FOR_DRIVE",
-                                        "UP_FOR_CHARGE", "UP_FOR_DC_CHARGE", "UP"};
-    static const char* BMS_uiChargeStatus[] = {"DISCONNECTED", "NO_POWER",        "ABOUT_TO_CHARGE",
-                                               "CHARGING",     "CHARGE_COMPLETE", "CHARGE_STOPPED"};
-    static const char* PCS_dcdcStatus[] = {"IDLE", "ACTIVE", "FAULTED"};
-    static const char* PCS_dcdcMainState[] = {"STANDBY",          "12V_SUPPORT_ACTIVE", "PRECHARGE_STARTUP",
-                                              "PRECHARGE_ACTIVE", "DIS_HVBUS_ACTIVE",   "SHUTDOWN",
-                                              "FAULTED"};
-    static const char* PCS_dcdcSubState[] = {"PWR_UP_INIT",
-                                             "STANDBY",
-                                             "12V_SUPPORT_ACTIVE",
-                                             "DIS_HVBUS",
-                                             "PCHG_FAST_DIS_HVBUS",
-                                             "PCHG_SLOW_DIS_HVBUS",
-                                             "PCHG_DWELL_CHARGE",
-                                             "PCHG_DWELL_WAIT",
-                                             "PCHG_DI_RECOVERY_WAIT",
-                                             "PCHG_ACTIVE",
-                                             "PCHG_FLT_FAST_DIS_HVBUS",
-                                             "SHUTDOWN",
-                                             "12V_SUPPORT_FAULTED",
-                                             "DIS_HVBUS_FAULTED",
-                                             "PCHG_FAULTED",
-                                             "CLEAR_FAULTS",
-                                             "FAULTED",
-                                             "NUM"};
-    static const char* BMS_powerLimitState[] = {"NOT_CALCULATED_FOR_DRIVE", "CALCULATED_FOR_DRIVE"};
-    //static const char* HVP_status[] = {"INVALID", "NOT_AVAILABLE", "STALE", "VALID"};
     static const char* HVP_contactor[] = {"NOT_ACTIVE", "ACTIVE", "COMPLETED"};
-    static const char* falseTrue[] = {"False", "True"};
     static const char* noYes[] = {"No", "Yes"};
 
     //Main battery info
     char readableBatterySerialNumber[15];  // One extra space for null terminator
-    memcpy(readableBatterySerialNumber, datalayer_extended.tesla.battery_serialNumber,
-           sizeof(datalayer_extended.tesla.battery_serialNumber));
+    memcpy(readableBatterySerialNumber, tesla_dl->battery_serialNumber, sizeof(tesla_dl->battery_serialNumber));
     readableBatterySerialNumber[14] = '\0';  // Null terminate the string
     content += "<h4>Battery Serial Number: " + String(readableBatterySerialNumber) + "</h4>";
     char readableBatteryPartNumber[13];  // One extra space for null terminator
-    memcpy(readableBatteryPartNumber, datalayer_extended.tesla.battery_partNumber,
-           sizeof(datalayer_extended.tesla.battery_partNumber));
+    memcpy(readableBatteryPartNumber, tesla_dl->battery_partNumber, sizeof(tesla_dl->battery_partNumber));
     readableBatteryPartNumber[12] = '\0';  // Null terminate the string
     content += "<h4>Battery Part Number: " + String(readableBatteryPartNumber) + "</h4>";
     //0x3C4 PCS_info
     char readablePCSPartNumber[13];  // One extra space for null terminator
-    memcpy(readablePCSPartNumber, datalayer_extended.tesla.PCS_partNumber,
-           sizeof(datalayer_extended.tesla.PCS_partNumber));
+    memcpy(readablePCSPartNumber, tesla_dl->PCS_partNumber, sizeof(tesla_dl->PCS_partNumber));
     readablePCSPartNumber[12] = '\0';  // Null terminate the string
     content += "<h4>PCS Part Number: " + String(readablePCSPartNumber) + "</h4>";
-    content += "<h4>Battery Manufacture Date: " + String(datalayer_extended.tesla.battery_manufactureDate) + "</h4>";
+    content += "<h4>Battery Manufacture Date: " + String(tesla_dl->battery_manufactureDate) + "</h4>";
     content += "<h4>Battery Pack Mass: " + String(packMass) + " KG</h4>";
     //0x3D2 978 BMS_kwhCounter
     content += "<h4>Battery Total Discharge: " + String(total_discharge) + " kWh</h4>";
     content += "<h4>Battery Total Charge: " + String(total_charge) + " kWh</h4>";
     //0x20A 522 HVP_contactorState + HVIL
-    //content += "<h4>HVIL Fault: " + String(noYes[datalayer_extended.tesla.BMS_hvilFault]) + "</h4>";
-    content += "<h4>HVIL Status: " + String(hvilStatusState[datalayer_extended.tesla.hvil_status]) + "</h4>";
-    content +=
-        "<h4>HVP Contactor State: " + String(contactorText[datalayer_extended.tesla.packContactorSetState]) + "</h4>";
-    content +=
-        "<h4>BMS Contactor State: " + String(BMS_contactorState[datalayer_extended.tesla.BMS_contactorState]) + "</h4>";
-    content +=
-        "<h4>Negative Contactor: " + String(contactorState[datalayer_extended.tesla.packContNegativeState]) + "</h4>";
-    content +=
-        "<h4>Positive Contactor: " + String(contactorState[datalayer_extended.tesla.packContPositiveState]) + "</h4>";
-    if (datalayer_extended.tesla.packContactorSetState == 5) {  //Closed
-      content += "<h4>Closing blocked: " + String(noYes[datalayer_extended.tesla.packCtrsClosingBlocked]) +
-                 " (already CLOSED)</h4>";
+    //content += "<h4>HVIL Fault: " + String(noYes[tesla_dl->BMS_hvilFault]) + "</h4>";
+    content += "<h4>HVIL Status: " + String(hvilStatusState[tesla_dl->hvil_status]) + "</h4>";
+    content += "<h4>HVP Contactor State: " + String(contactorText[tesla_dl->packContactorSetState]) + "</h4>";
+    content += "<h4>BMS Contactor State: " + String(BMS_contactorState[tesla_dl->BMS_contactorState]) + "</h4>";
+    content += "<h4>Negative Contactor: " + String(contactorState[tesla_dl->packContNegativeState]) + "</h4>";
+    content += "<h4>Positive Contactor: " + String(contactorState[tesla_dl->packContPositiveState]) + "</h4>";
+    if (tesla_dl->packContactorSetState == 5) {  //Closed
+      content += "<h4>Closing blocked: " + String(noYes[tesla_dl->packCtrsClosingBlocked]) + " (already CLOSED)</h4>";
     } else {
-      content += "<h4>Closing blocked: " + String(noYes[datalayer_extended.tesla.packCtrsClosingBlocked]) + "</h4>";
+      content += "<h4>Closing blocked: " + String(noYes[tesla_dl->packCtrsClosingBlocked]) + "</h4>";
     }
-    content += "<h4>Pyrotest in progress: " + String(noYes[datalayer_extended.tesla.pyroTestInProgress]) + "</h4>";
-    content += "<h4>Contactors Open Now Requested: " +
-               String(noYes[datalayer_extended.tesla.battery_packCtrsOpenNowRequested]) + "</h4>";
+    content += "<h4>Pyrotest in progress: " + String(noYes[tesla_dl->pyroTestInProgress]) + "</h4>";
     content +=
-        "<h4>Contactors Open Requested: " + String(noYes[datalayer_extended.tesla.battery_packCtrsOpenRequested]) +
-        "</h4>";
-    content += "<h4>Contactors Request Status: " +
-               String(HVP_contactor[datalayer_extended.tesla.battery_packCtrsRequestStatus]) + "</h4>";
-    content += "<h4>Contactors Reset Request Required: " +
-               String(noYes[datalayer_extended.tesla.battery_packCtrsResetRequestRequired]) + "</h4>";
+        "<h4>Contactors Open Now Requested: " + String(noYes[tesla_dl->battery_packCtrsOpenNowRequested]) + "</h4>";
+    content += "<h4>Contactors Open Requested: " + String(noYes[tesla_dl->battery_packCtrsOpenRequested]) + "</h4>";
+    content +=
+        "<h4>Contactors Request Status: " + String(HVP_contactor[tesla_dl->battery_packCtrsRequestStatus]) + "</h4>";
     content +=
-        "<h4>DC Link Allowed to Energize: " + String(noYes[datalayer_extended.tesla.battery_dcLinkAllowedToEnergize]) +
+        "<h4>Contactors Reset Request Required: " + String(noYes[tesla_dl->battery_packCtrsResetRequestRequired]) +
         "</h4>";
+    content += "<h4>DC Link Allowed to Energize: " + String(noYes[tesla_dl->battery_dcLinkAllowedToEnergize]) + "</h4>";
+  }
+
+  void render_bms_status(String& content) {
+    float beginning_of_life = static_cast<float>(tesla_dl->battery_beginning_of_life);
+    float battTempPct = static_cast<float>(tesla_dl->battery_battTempPct) * 0.4f;
+    float dcdcLvBusVolt = static_cast<float>(tesla_dl->battery_dcdcLvBusVolt) * 0.0390625f;
+    float dcdcHvBusVolt = static_cast<float>(tesla_dl->battery_dcdcHvBusVolt) * 0.146484f;
+    float dcdcLvOutputCurrent = static_cast<float>(tesla_dl->battery_dcdcLvOutputCurrent) * 0.1f;
+    float nominal_full_pack_energy = static_cast<float>(tesla_dl->battery_nominal_full_pack_energy) * 0.1f;
+    float nominal_full_pack_energy_m0 = static_cast<float>(tesla_dl->battery_nominal_full_pack_energy_m0) * 0.02f;
+    float nominal_energy_remaining = static_cast<float>(tesla_dl->battery_nominal_energy_remaining) * 0.1f;
+    float nominal_energy_remaining_m0 = static_cast<float>(tesla_dl->battery_nominal_energy_remaining_m0) * 0.02f;
+    float ideal_energy_remaining = static_cast<float>(tesla_dl->battery_ideal_energy_remaining) * 0.1f;
+    float ideal_energy_remaining_m0 = static_cast<float>(tesla_dl->battery_ideal_energy_remaining_m0) * 0.02f;
+    float energy_to_charge_complete = static_cast<float>(tesla_dl->battery_energy_to_charge_complete) * 0.1f;
+    float energy_to_charge_complete_m1 = static_cast<float>(tesla_dl->battery_energy_to_charge_complete_m1) * 0.02f;
+    float energy_buffer = static_cast<float>(tesla_dl->battery_energy_buffer) * 0.1f;
+    float energy_buffer_m1 = static_cast<float>(tesla_dl->battery_energy_buffer_m1) * 0.01f;
+    float expected_energy_remaining_m1 = static_cast<float>(tesla_dl->battery_expected_energy_remaining_m1) * 0.02f;
+    float platformMaxBusVoltage = static_cast<float>(tesla_dl->battery_platformMaxBusVoltage) * 0.1f + 375;
+    float bms_min_voltage = static_cast<float>(tesla_dl->BMS_min_voltage) * 0.01f * 2;
+    float bms_max_voltage = static_cast<float>(tesla_dl->BMS_max_voltage) * 0.01f * 2;
+    float max_charge_current = static_cast<float>(tesla_dl->battery_max_charge_current);
+    float max_discharge_current = static_cast<float>(tesla_dl->battery_max_discharge_current);
+    float soc_ave = static_cast<float>(tesla_dl->battery_soc_ave) * 0.1f;
+    float soc_max = static_cast<float>(tesla_dl->battery_soc_max) * 0.1f;
+    float soc_min = static_cast<float>(tesla_dl->battery_soc_min) * 0.1f;
+    float soc_ui = static_cast<float>(tesla_dl->battery_soc_ui) * 0.1f;
+    float BrickVoltageMax = static_cast<float>(tesla_dl->battery_BrickVoltageMax) * 0.002f;
+    float BrickVoltageMin = static_cast<float>(tesla_dl->battery_BrickVoltageMin) * 0.002f;
+    //float BrickModelTMax = static_cast<float>(tesla_dl->battery_BrickModelTMax) * 0.5 - 40;
+    //float BrickModelTMin = static_cast<float>(tesla_dl->battery_BrickModelTMin) * 0.5 - 40;
+    float isolationResistance = static_cast<float>(tesla_dl->BMS_isolationResistance) * 10;
+
+    static const char* BMS_state[] = {"STANDBY",     "DRIVE", "SUPPORT", "CHARGE", "FEIM",
+                                      "CLEAR_FAULT", "FAULT", "WELD",    "TEST",   "SNA"};
+    static const char* BMS_hvState[] = {"DOWN",          "COMING_UP",        "GOING_DOWN", "UP_FOR_DRIVE",
+                                        "UP_FOR_CHARGE", "UP_FOR_DC_CHARGE", "UP"};
+    static const char* BMS_uiChargeStatus[] = {"DISCONNECTED", "NO_POWER",        "ABOUT_TO_CHARGE",
+                                               "CHARGING",     "CHARGE_COMPLETE", "CHARGE_STOPPED"};
+    static const char* noYes[] = {"No", "Yes"};
+
     // Comment what data you would like to display, order can be changed.
     //0x352 850 BMS_energyStatus
-    if (datalayer_extended.tesla.BMS352_mux == false) {
+    if (tesla_dl->BMS352_mux == false) {
       content += "<h3>BMS 0x352 w/o mux</h3>";  //if using older BMS <2021 and comment 0x352 without MUX
       content += "<h4>Calculated SOH: " + String(nominal_full_pack_energy * 100 / beginning_of_life) + "</h4>";
       content += "<h4>Nominal Full Pack Energy: " + String(nominal_full_pack_energy) + " kWh</h4>";
@@ -254,11 +161,10 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
       content += "<h4>Ideal Energy Remaining: " + String(ideal_energy_remaining) + " kWh</h4>";
       content += "<h4>Energy to Charge Complete: " + String(energy_to_charge_complete) + " kWh</h4>";
       content += "<h4>Energy Buffer: " + String(energy_buffer) + " kWh</h4>";
-      content += "<h4>Full Charge Complete: " + String(noYes[datalayer_extended.tesla.battery_full_charge_complete]) +
-                 "</h4>";  //bool
+      content += "<h4>Full Charge Complete: " + String(noYes[tesla_dl->battery_full_charge_complete]) + "</h4>";  //bool
     }
     //0x352 850 BMS_energyStatus
-    if (datalayer_extended.tesla.BMS352_mux == true) {
+    if (tesla_dl->BMS352_mux == true) {
       content += "<h3>BMS 0x352 w/ mux</h3>";  //if using newer BMS >2021 and comment 0x352 with MUX
       content += "<h4>Calculated SOH: " + String(nominal_full_pack_energy_m0 * 100 / beginning_of_life) + "</h4>";
       content += "<h4>Nominal Full Pack Energy: " + String(nominal_full_pack_energy_m0) + " kWh</h4>";
@@ -267,18 +173,17 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
       content += "<h4>Energy to Charge Complete: " + String(energy_to_charge_complete_m1) + " kWh</h4>";
       content += "<h4>Energy Buffer: " + String(energy_buffer_m1) + " kWh</h4>";
       content += "<h4>Expected Energy Remaining: " + String(expected_energy_remaining_m1) + " kWh</h4>";
-      content += "<h4>Fully Charged: " + String(noYes[datalayer_extended.tesla.battery_fully_charged]) + "</h4>";
+      content += "<h4>Fully Charged: " + String(noYes[tesla_dl->battery_fully_charged]) + "</h4>";
     }
     //0x212 530 BMS_status
     content += "<h4>Isolation Resistance: " + String(isolationResistance) + " kOhms</h4>";
-    content += "<h4>BMS State: " + String(BMS_state[datalayer_extended.tesla.BMS_state]) + "</h4>";
-    content += "<h4>BMS HV State: " + String(BMS_hvState[datalayer_extended.tesla.BMS_hvState]) + "</h4>";
-    content += "<h4>BMS UI Charge Status: " + String(BMS_uiChargeStatus[datalayer_extended.tesla.BMS_uiChargeStatus]) +
-               "</h4>";
-    content += "<h4>BMS_buildConfigId: " + String(datalayer_extended.tesla.BMS_info_buildConfigId) + "</h4>";
-    content += "<h4>BMS_hardwareId: " + String(datalayer_extended.tesla.BMS_info_hardwareId) + "</h4>";
-    content += "<h4>BMS_componentId: " + String(datalayer_extended.tesla.BMS_info_componentId) + "</h4>";
-    appendFault(content, "BMS PCS PWM Enabled", datalayer_extended.tesla.BMS_pcsPwmEnabled);
+    content += "<h4>BMS State: " + String(BMS_state[tesla_dl->BMS_state]) + "</h4>";
+    content += "<h4>BMS HV State: " + String(BMS_hvState[tesla_dl->BMS_hvState]) + "</h4>";
+    content += "<h4>BMS UI Charge Status: " + String(BMS_uiChargeStatus[tesla_dl->BMS_uiChargeStatus]) + "</h4>";
+    content += "<h4>BMS_buildConfigId: " + String(tesla_dl->BMS_info_buildConfigId) + "</h4>";
+    content += "<h4>BMS_hardwareId: " + String(tesla_dl->BMS_info_hardwareId) + "</h4>";
+    content += "<h4>BMS_componentId: " + String(tesla_dl->BMS_info_componentId) + "</h4>";
+    appendFault(content, "BMS PCS PWM Enabled", tesla_dl->BMS_pcsPwmEnabled);
     //0x292 658 BMS_socStates
     content += "<h4>Battery Beginning of Life: " + String(beginning_of_life) + " kWh</h4>";
     content += "<h4>Battery SOC UI: " + String(soc_ui) + " </h4>";
@@ -291,9 +196,9 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
     content += "<h4>PCS Lv Bus: " + String(dcdcLvBusVolt) + " V</h4>";
     content += "<h4>PCS Hv Bus: " + String(dcdcHvBusVolt) + " V</h4>";
     //0x392 BMS_packConfig
-    //content += "<h4>packConfigMultiplexer: " + String(datalayer_extended.tesla.battery_packConfigMultiplexer) + "</h4>"; // Not giving useable data
-    //content += "<h4>moduleType: " + String(datalayer_extended.tesla.battery_moduleType) + "</h4>";  // Not giving useable data
-    //content += "<h4>reserveConfig: " + String(datalayer_extended.tesla.battery_reservedConfig) + "</h4>";  // Not giving useable data
+    //content += "<h4>packConfigMultiplexer: " + String(tesla_dl->battery_packConfigMultiplexer) + "</h4>"; // Not giving useable data
+    //content += "<h4>moduleType: " + String(tesla_dl->battery_moduleType) + "</h4>";  // Not giving useable data
+    //content += "<h4>reserveConfig: " + String(tesla_dl->battery_reservedConfig) + "</h4>";  // Not giving useable data
     //content += "<h4>Battery Pack Mass: " + String(packMass) + " KG</h4>";
     content += "<h4>Platform Max Bus Voltage: " + String(platformMaxBusVoltage) + " V</h4>";
     //0x2D2 722 BMSVAlimits
@@ -304,10 +209,76 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
     //0x332 818 BMS_bmbMinMax
     content += "<h4>Brick Voltage Max: " + String(BrickVoltageMax) + " V</h4>";
     content += "<h4>Brick Voltage Min: " + String(BrickVoltageMin) + " V</h4>";
-    content += "<h4>Brick Temp Max Num: " + String(datalayer_extended.tesla.battery_BrickTempMaxNum) + " </h4>";
-    content += "<h4>Brick Temp Min Num: " + String(datalayer_extended.tesla.battery_BrickTempMinNum) + " </h4>";
+    content += "<h4>Brick Temp Max Num: " + String(tesla_dl->battery_BrickTempMaxNum) + " </h4>";
+    content += "<h4>Brick Temp Min Num: " + String(tesla_dl->battery_BrickTempMinNum) + " </h4>";
     //content += "<h4>Brick Model Temp Max: " + String(BrickModelTMax) + " C</h4>";// Not giving useable data
     //content += "<h4>Brick Model Temp Min: " + String(BrickModelTMin) + " C</h4>";// Not giving useable data
+  }
+
+  void render_pcs_status(String& content) {
+    float PCS_dcdcMaxOutputCurrentAllowed = static_cast<float>(tesla_dl->PCS_dcdcMaxOutputCurrentAllowed) * 0.1f;
+    float PCS_dcdcTemp = static_cast<float>(tesla_dl->PCS_dcdcTemp) * 0.1f + 40.0f;
+    float PCS_ambientTemp = static_cast<float>(tesla_dl->PCS_ambientTemp) * 0.1f + 40.0f;
+    float PCS_chgPhATemp = static_cast<float>(tesla_dl->PCS_chgPhATemp) * 0.1f + 40.0f;
+    float PCS_chgPhBTemp = static_cast<float>(tesla_dl->PCS_chgPhBTemp) * 0.1f + 40.0f;
+    float PCS_chgPhCTemp = static_cast<float>(tesla_dl->PCS_chgPhCTemp) * 0.1f + 40.0f;
+    float BMS_maxRegenPower = static_cast<float>(tesla_dl->BMS_maxRegenPower) * 0.01f;
+    float BMS_maxDischargePower = static_cast<float>(tesla_dl->BMS_maxDischargePower) * 0.013f;
+    //float BMS_maxStationaryHeatPower = static_cast<float>(tesla_dl->BMS_maxStationaryHeatPower) * 0.01f;
+    //float BMS_hvacPowerBudget = static_cast<float>(tesla_dl->BMS_hvacPowerBudget) * 0.02;
+    float BMS_powerDissipation = static_cast<float>(tesla_dl->BMS_powerDissipation) * 0.02f;
+    float BMS_flowRequest = static_cast<float>(tesla_dl->BMS_flowRequest) * 0.3f;
+    float BMS_inletActiveCoolTargetT = static_cast<float>(tesla_dl->BMS_inletActiveCoolTargetT) * 0.25f - 25;
+    float BMS_inletPassiveTargetT = static_cast<float>(tesla_dl->BMS_inletPassiveTargetT) * 0.25f - 25;
+    float BMS_inletActiveHeatTargetT = static_cast<float>(tesla_dl->BMS_inletActiveHeatTargetT) * 0.25f - 25;
+    float BMS_packTMin = static_cast<float>(tesla_dl->BMS_packTMin) * 0.25f - 25;
+    float BMS_packTMax = static_cast<float>(tesla_dl->BMS_packTMax) * 0.25f - 25;
+    float PCS_dcdcMaxLvOutputCurrent = static_cast<float>(tesla_dl->PCS_dcdcMaxLvOutputCurrent) * 0.1f;
+    float PCS_dcdcCurrentLimit = static_cast<float>(tesla_dl->PCS_dcdcCurrentLimit) * 0.1f;
+    float PCS_dcdcLvOutputCurrentTempLimit = static_cast<float>(tesla_dl->PCS_dcdcLvOutputCurrentTempLimit) * 0.1f;
+    float PCS_dcdcUnifiedCommand = static_cast<float>(tesla_dl->PCS_dcdcUnifiedCommand) * 0.001f;
+    float PCS_dcdcCLAControllerOutput = static_cast<float>(tesla_dl->PCS_dcdcCLAControllerOutput * 0.001f);
+    float PCS_dcdcTankVoltage = static_cast<float>(tesla_dl->PCS_dcdcTankVoltage);
+    float PCS_dcdcTankVoltageTarget = static_cast<float>(tesla_dl->PCS_dcdcTankVoltageTarget);
+    float PCS_dcdcClaCurrentFreq = static_cast<float>(tesla_dl->PCS_dcdcClaCurrentFreq) * 0.0976563f;
+    float PCS_dcdcTCommMeasured = static_cast<float>(tesla_dl->PCS_dcdcTCommMeasured) * 0.00195313f;
+    float PCS_dcdcShortTimeUs = static_cast<float>(tesla_dl->PCS_dcdcShortTimeUs) * 0.000488281f;
+    float PCS_dcdcHalfPeriodUs = static_cast<float>(tesla_dl->PCS_dcdcHalfPeriodUs) * 0.000488281f;
+    float PCS_dcdcIntervalMaxFrequency = static_cast<float>(tesla_dl->PCS_dcdcIntervalMaxFrequency);
+    float PCS_dcdcIntervalMaxHvBusVolt = static_cast<float>(tesla_dl->PCS_dcdcIntervalMaxHvBusVolt) * 0.1f;
+    float PCS_dcdcIntervalMaxLvBusVolt = static_cast<float>(tesla_dl->PCS_dcdcIntervalMaxLvBusVolt) * 0.1f;
+    float PCS_dcdcIntervalMaxLvOutputCurr = static_cast<float>(tesla_dl->PCS_dcdcIntervalMaxLvOutputCurr);
+    float PCS_dcdcIntervalMinFrequency = static_cast<float>(tesla_dl->PCS_dcdcIntervalMinFrequency);
+    float PCS_dcdcIntervalMinHvBusVolt = static_cast<float>(tesla_dl->PCS_dcdcIntervalMinHvBusVolt) * 0.1f;
+    float PCS_dcdcIntervalMinLvBusVolt = static_cast<float>(tesla_dl->PCS_dcdcIntervalMinLvBusVolt) * 0.1f;
+    float PCS_dcdcIntervalMinLvOutputCurr = static_cast<float>(tesla_dl->PCS_dcdcIntervalMinLvOutputCurr);
+    float PCS_dcdc12vSupportLifetimekWh = static_cast<float>(tesla_dl->PCS_dcdc12vSupportLifetimekWh) * 0.01f;
+
+    static const char* PCS_dcdcStatus[] = {"IDLE", "ACTIVE", "FAULTED"};
+    static const char* PCS_dcdcMainState[] = {"STANDBY",          "12V_SUPPORT_ACTIVE", "PRECHARGE_STARTUP",
+                                              "PRECHARGE_ACTIVE", "DIS_HVBUS_ACTIVE",   "SHUTDOWN",
+                                              "FAULTED"};
+    static const char* PCS_dcdcSubState[] = {"PWR_UP_INIT",
+                                             "STANDBY",
+                                             "12V_SUPPORT_ACTIVE",
+                                             "DIS_HVBUS",
+                                             "PCHG_FAST_DIS_HVBUS",
+                                             "PCHG_SLOW_DIS_HVBUS",
+                                             "PCHG_DWELL_CHARGE",
+                                             "PCHG_DWELL_WAIT",
+                                             "PCHG_DI_RECOVERY_WAIT",
+                                             "PCHG_ACTIVE",
+                                             "PCHG_FLT_FAST_DIS_HVBUS",
+                                             "SHUTDOWN",
+                                             "12V_SUPPORT_FAULTED",
+                                             "DIS_HVBUS_FAULTED",
+                                             "PCHG_FAULTED",
+                                             "CLEAR_FAULTS",
+                                             "FAULTED",
+                                             "NUM"};
+    static const char* BMS_powerLimitState[] = {"NOT_CALCULATED_FOR_DRIVE", "CALCULATED_FOR_DRIVE"};
+    static const char* falseTrue[] = {"False", "True"};
+
     //0x2A4 676 PCS_thermalStatus
     content += "<h4>PCS dcdc Temp: " + String(PCS_dcdcTemp) + " DegC</h4>";
     content += "<h4>PCS Ambient Temp: " + String(PCS_ambientTemp) + " DegC</h4>";
@@ -319,10 +290,9 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
     content += "<h4>Max Discharge Power: " + String(BMS_maxDischargePower) + " kW</h4>";
     //content += "<h4>Max Stationary Heat Power: " + String(BMS_maxStationaryHeatPower) + " kWh</h4>"; // Not giving useable data
     //content += "<h4>HVAC Power Budget: " + String(BMS_hvacPowerBudget) + " kW</h4>"; // Not giving useable data
-    //content += "<h4>Not Enough Power For Heat Pump: " + String(noYes[datalayer_extended.tesla.BMS_notEnoughPowerForHeatPump]) + "</h4>"; // Not giving useable data
-    content +=
-        "<h4>Power Limit State: " + String(BMS_powerLimitState[datalayer_extended.tesla.BMS_powerLimitState]) + "</h4>";
-    //content += "<h4>Inverter TQF: " + String(datalayer_extended.tesla.BMS_inverterTQF) + "</h4>"; // Not giving useable data
+    //content += "<h4>Not Enough Power For Heat Pump: " + String(noYes[tesla_dl->BMS_notEnoughPowerForHeatPump]) + "</h4>"; // Not giving useable data
+    content += "<h4>Power Limit State: " + String(BMS_powerLimitState[tesla_dl->BMS_powerLimitState]) + "</h4>";
+    //content += "<h4>Inverter TQF: " + String(tesla_dl->BMS_inverterTQF) + "</h4>"; // Not giving useable data
     //0x312 786 BMS_thermalStatus
     content += "<h4>Power Dissipation: " + String(BMS_powerDissipation) + " kW</h4>";
     content += "<h4>Flow Request: " + String(BMS_flowRequest) + " LPM</h4>";
@@ -331,36 +301,31 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
     content += "<h4>Inlet Active Heat Target Temp: " + String(BMS_inletActiveHeatTargetT) + " DegC</h4>";
     content += "<h4>Pack Temp Min: " + String(BMS_packTMin) + " DegC</h4>";
     content += "<h4>Pack Temp Max: " + String(BMS_packTMax) + " DegC</h4>";
-    appendFault(content, "PCS No Flow Request", datalayer_extended.tesla.BMS_pcsNoFlowRequest);
-    appendFault(content, "BMS No Flow Request", datalayer_extended.tesla.BMS_noFlowRequest);
+    appendFault(content, "PCS No Flow Request", tesla_dl->BMS_pcsNoFlowRequest);
+    appendFault(content, "BMS No Flow Request", tesla_dl->BMS_noFlowRequest);
     //0x224 548 PCS_dcdcStatus
+    content += "<h4>Precharge Status: " + String(PCS_dcdcStatus[tesla_dl->PCS_dcdcPrechargeStatus]) + "</h4>";
+    content += "<h4>12V Support Status: " + String(PCS_dcdcStatus[tesla_dl->PCS_dcdc12VSupportStatus]) + "</h4>";
     content +=
-        "<h4>Precharge Status: " + String(PCS_dcdcStatus[datalayer_extended.tesla.PCS_dcdcPrechargeStatus]) + "</h4>";
-    content += "<h4>12V Support Status: " + String(PCS_dcdcStatus[datalayer_extended.tesla.PCS_dcdc12VSupportStatus]) +
-               "</h4>";
-    content += "<h4>HV Bus Discharge Status: " +
-               String(PCS_dcdcStatus[datalayer_extended.tesla.PCS_dcdcHvBusDischargeStatus]) + "</h4>";
-    content += "<h4>Main State: " + String(PCS_dcdcMainState[datalayer_extended.tesla.PCS_dcdcMainState]) + "</h4>";
-    content += "<h4>Sub State: " + String(PCS_dcdcSubState[datalayer_extended.tesla.PCS_dcdcSubState]) + "</h4>";
-    appendFault(content, "PCS Faulted", datalayer_extended.tesla.PCS_dcdcFaulted);
-    appendFault(content, "Output Is Limited", datalayer_extended.tesla.PCS_dcdcOutputIsLimited);
+        "<h4>HV Bus Discharge Status: " + String(PCS_dcdcStatus[tesla_dl->PCS_dcdcHvBusDischargeStatus]) + "</h4>";
+    content += "<h4>Main State: " + String(PCS_dcdcMainState[tesla_dl->PCS_dcdcMainState]) + "</h4>";
+    content += "<h4>Sub State: " + String(PCS_dcdcSubState[tesla_dl->PCS_dcdcSubState]) + "</h4>";
+    appendFault(content, "PCS Faulted", tesla_dl->PCS_dcdcFaulted);
+    appendFault(content, "Output Is Limited", tesla_dl->PCS_dcdcOutputIsLimited);
     content += "<h4>Max Output Current Allowed: " + String(PCS_dcdcMaxOutputCurrentAllowed) + " A</h4>";
+    content += "<h4>Precharge Rty Cnt: " + String(falseTrue[tesla_dl->PCS_dcdcPrechargeRtyCnt]) + "</h4>";
+    content += "<h4>12V Support Rty Cnt: " + String(falseTrue[tesla_dl->PCS_dcdc12VSupportRtyCnt]) + "</h4>";
+    content += "<h4>Discharge Rty Cnt: " + String(falseTrue[tesla_dl->PCS_dcdcDischargeRtyCnt]) + "</h4>";
+    appendFault(content, "PWM Enable Line", tesla_dl->PCS_dcdcPwmEnableLine);
+    appendFault(content, "Supporting Fixed LV Target", tesla_dl->PCS_dcdcSupportingFixedLvTarget);
+    content += "<h4>Precharge Restart Cnt: " + String(falseTrue[tesla_dl->PCS_dcdcPrechargeRestartCnt]) + "</h4>";
     content +=
-        "<h4>Precharge Rty Cnt: " + String(falseTrue[datalayer_extended.tesla.PCS_dcdcPrechargeRtyCnt]) + "</h4>";
-    content +=
-        "<h4>12V Support Rty Cnt: " + String(falseTrue[datalayer_extended.tesla.PCS_dcdc12VSupportRtyCnt]) + "</h4>";
-    content +=
-        "<h4>Discharge Rty Cnt: " + String(falseTrue[datalayer_extended.tesla.PCS_dcdcDischargeRtyCnt]) + "</h4>";
-    appendFault(content, "PWM Enable Line", datalayer_extended.tesla.PCS_dcdcPwmEnableLine);
-    appendFault(content, "Supporting Fixed LV Target", datalayer_extended.tesla.PCS_dcdcSupportingFixedLvTarget);
-    content += "<h4>Precharge Restart Cnt: " + String(falseTrue[datalayer_extended.tesla.PCS_dcdcPrechargeRestartCnt]) +
-               "</h4>";
-    content += "<h4>Initial Precharge Substate: " +
-               String(PCS_dcdcSubState[datalayer_extended.tesla.PCS_dcdcInitialPrechargeSubState]) + "</h4>";
+        "<h4>Initial Precharge Substate: " + String(PCS_dcdcSubState[tesla_dl->PCS_dcdcInitialPrechargeSubState]) +
+        "</h4>";
     //0x3C4 PCS_info
-    content += "<h4>PCS_buildConfigId: " + String(datalayer_extended.tesla.PCS_info_buildConfigId) + "</h4>";
-    content += "<h4>PCS_hardwareId: " + String(datalayer_extended.tesla.PCS_info_hardwareId) + "</h4>";
-    content += "<h4>PCS_componentId: " + String(datalayer_extended.tesla.PCS_info_componentId) + "</h4>";
+    content += "<h4>PCS_buildConfigId: " + String(tesla_dl->PCS_info_buildConfigId) + "</h4>";
+    content += "<h4>PCS_hardwareId: " + String(tesla_dl->PCS_info_hardwareId) + "</h4>";
+    content += "<h4>PCS_componentId: " + String(tesla_dl->PCS_info_componentId) + "</h4>";
     //0x2C4 708 PCS_logging
     content += "<h4>PCS_dcdcMaxLvOutputCurrent: " + String(PCS_dcdcMaxLvOutputCurrent) + " A</h4>";
     content += "<h4>PCS_dcdcCurrentLimit: " + String(PCS_dcdcCurrentLimit) + " A</h4>";
@@ -382,10 +347,39 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
     content += "<h4>PCS_dcdcIntervalMinLvBusVolt: " + String(PCS_dcdcIntervalMinLvBusVolt) + " V</h4>";
     content += "<h4>PCS_dcdcIntervalMinLvOutputCurr: " + String(PCS_dcdcIntervalMinLvOutputCurr) + " A</h4>";
     content += "<h4>PCS_dcdc12vSupportLifetimekWh: " + String(PCS_dcdc12vSupportLifetimekWh) + " kWh</h4>";
+  }
+
+  void render_hvp_status(String& content) {
+    float HVP_hvp1v5Ref = static_cast<float>(tesla_dl->HVP_hvp1v5Ref) * 0.1f;
+    float HVP_shuntCurrentDebug = static_cast<float>(tesla_dl->HVP_shuntCurrentDebug) * 0.1f;
+    float HVP_dcLinkVoltage = static_cast<float>(tesla_dl->HVP_dcLinkVoltage) * 0.1f;
+    float HVP_packVoltage = static_cast<float>(tesla_dl->HVP_packVoltage) * 0.1f;
+    //float HVP_fcLinkVoltage = static_cast<float>(tesla_dl->HVP_fcLinkVoltage) * 0.1f;
+    float HVP_packContVoltage = static_cast<float>(tesla_dl->HVP_packContVoltage) * 0.1f;
+    //float HVP_packNegativeV = static_cast<float>(tesla_dl->HVP_packNegativeV) * 0.1f;
+    //float HVP_packPositiveV = static_cast<float>(tesla_dl->HVP_packPositiveV) * 0.1f;
+    float HVP_pyroAnalog = static_cast<float>(tesla_dl->HVP_pyroAnalog) * 0.1f;
+    //float HVP_dcLinkNegativeV = static_cast<float>(tesla_dl->HVP_dcLinkNegativeV) * 0.1f;
+    //float HVP_dcLinkPositiveV = static_cast<float>(tesla_dl->HVP_dcLinkPositiveV) * 0.1f;
+    //float HVP_fcLinkNegativeV = static_cast<float>(tesla_dl->HVP_fcLinkNegativeV) * 0.1f;
+    //float HVP_fcContCoilCurrent = static_cast<float>(tesla_dl->HVP_fcContCoilCurrent) * 0.1f;
+    //float HVP_fcContVoltage = static_cast<float>(tesla_dl->HVP_fcContVoltage) * 0.1f;
+    float HVP_hvilInVoltage = static_cast<float>(tesla_dl->HVP_hvilInVoltage) * 0.1f;
+    float HVP_hvilOutVoltage = static_cast<float>(tesla_dl->HVP_hvilOutVoltage) * 0.1f;
+    //float HVP_fcLinkPositiveV = static_cast<float>(tesla_dl->HVP_fcLinkPositiveV) * 0.1f;
+    float HVP_packContCoilCurrent = static_cast<float>(tesla_dl->HVP_packContCoilCurrent) * 0.1f;
+    float HVP_battery12V = static_cast<float>(tesla_dl->HVP_battery12V) * 0.1f;
+    //float HVP_shuntRefVoltageDbg = static_cast<float>(tesla_dl->HVP_shuntRefVoltageDbg) * 0.001f;
+    //float HVP_shuntAuxCurrentDbg = static_cast<float>(tesla_dl->HVP_shuntAuxCurrentDbg) * 0.1f;
+    //float HVP_shuntBarTempDbg = static_cast<float>(tesla_dl->HVP_shuntBarTempDbg) * 0.01f;
+    //float HVP_shuntAsicTempDbg = static_cast<float>(tesla_dl->HVP_shuntAsicTempDbg) * 0.01f;
+    //static const char* HVP_status[] = {"INVALID", "NOT_AVAILABLE", "STALE", "VALID"};
+    static const char* noYes[] = {"No", "Yes"};
+
     //0x310 HVP_info
-    content += "<h4>HVP_buildConfigId: " + String(datalayer_extended.tesla.HVP_info_buildConfigId) + "</h4>";
-    content += "<h4>HVP_hardwareId: " + String(datalayer_extended.tesla.HVP_info_hardwareId) + "</h4>";
-    content += "<h4>HVP_componentId: " + String(datalayer_extended.tesla.HVP_info_componentId) + "</h4>";
+    content += "<h4>HVP_buildConfigId: " + String(tesla_dl->HVP_info_buildConfigId) + "</h4>";
+    content += "<h4>HVP_hardwareId: " + String(tesla_dl->HVP_info_hardwareId) + "</h4>";
+    content += "<h4>HVP_componentId: " + String(tesla_dl->HVP_info_componentId) + "</h4>";
     //0x7AA 1962 HVP_debugMessage
     content += "<h4>HVP_battery12V: " + String(HVP_battery12V) + " V</h4>";
     content += "<h4>HVP_dcLinkVoltage: " + String(HVP_dcLinkVoltage) + " V</h4>";
@@ -396,40 +390,37 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
     content += "<h4>HVP_hvp1v5Ref: " + String(HVP_hvp1v5Ref) + " V</h4>";
     content += "<h4>HVP_hvilInVoltage: " + String(HVP_hvilInVoltage) + " V</h4>";
     content += "<h4>HVP_hvilOutVoltage: " + String(HVP_hvilOutVoltage) + " V</h4>";
-    appendFault(content, "HVP_gpioPassivePyroDepl", datalayer_extended.tesla.HVP_gpioPassivePyroDepl);
-    appendFault(content, "HVP_gpioPyroIsoEn", datalayer_extended.tesla.HVP_gpioPyroIsoEn);
-    appendFault(content, "HVP_gpioCpFaultIn", datalayer_extended.tesla.HVP_gpioCpFaultIn);
-    appendFault(content, "HVP_gpioPackContPowerEn", datalayer_extended.tesla.HVP_gpioPackContPowerEn);
-    appendFault(content, "HVP_gpioHvCablesOk", datalayer_extended.tesla.HVP_gpioHvCablesOk);
-    appendFault(content, "HVP_gpioHvpSelfEnable", datalayer_extended.tesla.HVP_gpioHvpSelfEnable);
-    appendFault(content, "HVP_gpioLed", datalayer_extended.tesla.HVP_gpioLed);
-    appendFault(content, "HVP_gpioCrashSignal", datalayer_extended.tesla.HVP_gpioCrashSignal);
-    appendFault(content, "HVP_gpioShuntDataReady", datalayer_extended.tesla.HVP_gpioShuntDataReady);
-    appendFault(content, "HVP_gpioFcContPosAux", datalayer_extended.tesla.HVP_gpioFcContPosAux);
-    appendFault(content, "HVP_gpioFcContNegAux", datalayer_extended.tesla.HVP_gpioFcContNegAux);
-    appendFault(content, "HVP_gpioBmsEout", datalayer_extended.tesla.HVP_gpioBmsEout);
-    appendFault(content, "HVP_gpioCpFaultOut", datalayer_extended.tesla.HVP_gpioCpFaultOut);
-    appendFault(content, "HVP_gpioPyroPor", datalayer_extended.tesla.HVP_gpioPyroPor);
-    appendFault(content, "HVP_gpioShuntEn", datalayer_extended.tesla.HVP_gpioShuntEn);
-    appendFault(content, "HVP_gpioHvpVerEn", datalayer_extended.tesla.HVP_gpioHvpVerEn);
-    appendFault(content, "HVP_gpioPackCoontPosFlywheel", datalayer_extended.tesla.HVP_gpioPackCoontPosFlywheel);
-    appendFault(content, "HVP_gpioCpLatchEnable", datalayer_extended.tesla.HVP_gpioCpLatchEnable);
-    appendFault(content, "HVP_gpioPcsEnable", datalayer_extended.tesla.HVP_gpioPcsEnable);
-    appendFault(content, "HVP_gpioPcsDcdcPwmEnable", datalayer_extended.tesla.HVP_gpioPcsDcdcPwmEnable);
-    appendFault(content, "HVP_gpioPcsChargePwmEnable", datalayer_extended.tesla.HVP_gpioPcsChargePwmEnable);
-    appendFault(content, "HVP_gpioFcContPowerEnable", datalayer_extended.tesla.HVP_gpioFcContPowerEnable);
-    appendFault(content, "HVP_gpioHvilEnable", datalayer_extended.tesla.HVP_gpioHvilEnable);
-    appendFault(content, "HVP_gpioSecDrdy", datalayer_extended.tesla.HVP_gpioSecDrdy);
+    appendFault(content, "HVP_gpioPassivePyroDepl", tesla_dl->HVP_gpioPassivePyroDepl);
+    appendFault(content, "HVP_gpioPyroIsoEn", tesla_dl->HVP_gpioPyroIsoEn);
+    appendFault(content, "HVP_gpioCpFaultIn", tesla_dl->HVP_gpioCpFaultIn);
+    appendFault(content, "HVP_gpioPackContPowerEn", tesla_dl->HVP_gpioPackContPowerEn);
+    appendFault(content, "HVP_gpioHvCablesOk", tesla_dl->HVP_gpioHvCablesOk);
+    appendFault(content, "HVP_gpioHvpSelfEnable", tesla_dl->HVP_gpioHvpSelfEnable);
+    appendFault(content, "HVP_gpioLed", tesla_dl->HVP_gpioLed);
+    appendFault(content, "HVP_gpioCrashSignal", tesla_dl->HVP_gpioCrashSignal);
+    appendFault(content, "HVP_gpioShuntDataReady", tesla_dl->HVP_gpioShuntDataReady);
+    appendFault(content, "HVP_gpioFcContPosAux", tesla_dl->HVP_gpioFcContPosAux);
+    appendFault(content, "HVP_gpioFcContNegAux", tesla_dl->HVP_gpioFcContNegAux);
+    appendFault(content, "HVP_gpioBmsEout", tesla_dl->HVP_gpioBmsEout);
+    appendFault(content, "HVP_gpioCpFaultOut", tesla_dl->HVP_gpioCpFaultOut);
+    appendFault(content, "HVP_gpioPyroPor", tesla_dl->HVP_gpioPyroPor);
+    appendFault(content, "HVP_gpioShuntEn", tesla_dl->HVP_gpioShuntEn);
+    appendFault(content, "HVP_gpioHvpVerEn", tesla_dl->HVP_gpioHvpVerEn);
+    appendFault(content, "HVP_gpioPackCoontPosFlywheel", tesla_dl->HVP_gpioPackCoontPosFlywheel);
+    appendFault(content, "HVP_gpioCpLatchEnable", tesla_dl->HVP_gpioCpLatchEnable);
+    appendFault(content, "HVP_gpioPcsEnable", tesla_dl->HVP_gpioPcsEnable);
+    appendFault(content, "HVP_gpioPcsDcdcPwmEnable", tesla_dl->HVP_gpioPcsDcdcPwmEnable);
+    appendFault(content, "HVP_gpioPcsChargePwmEnable", tesla_dl->HVP_gpioPcsChargePwmEnable);
+    appendFault(content, "HVP_gpioFcContPowerEnable", tesla_dl->HVP_gpioFcContPowerEnable);
+    appendFault(content, "HVP_gpioHvilEnable", tesla_dl->HVP_gpioHvilEnable);
+    appendFault(content, "HVP_gpioSecDrdy", tesla_dl->HVP_gpioSecDrdy);
     content += "<h4>HVP_shuntCurrentDebug: " + String(HVP_shuntCurrentDebug) + " A</h4>";
-    content += "<h4>HVP_packCurrentMia: " + String(noYes[datalayer_extended.tesla.HVP_packCurrentMia]) + "</h4>";
-    content += "<h4>HVP_auxCurrentMia: " + String(noYes[datalayer_extended.tesla.HVP_auxCurrentMia]) + "</h4>";
-    content += "<h4>HVP_currentSenseMia: " + String(noYes[datalayer_extended.tesla.HVP_currentSenseMia]) + "</h4>";
-    content +=
-        "<h4>HVP_shuntRefVoltageMismatch: " + String(noYes[datalayer_extended.tesla.HVP_shuntRefVoltageMismatch]) +
-        "</h4>";
-    content +=
-        "<h4>HVP_shuntThermistorMia: " + String(noYes[datalayer_extended.tesla.HVP_shuntThermistorMia]) + "</h4>";
-    content += "<h4>HVP_shuntHwMia: " + String(noYes[datalayer_extended.tesla.HVP_shuntHwMia]) + "</h4>";
+    content += "<h4>HVP_packCurrentMia: " + String(noYes[tesla_dl->HVP_packCurrentMia]) + "</h4>";
+    content += "<h4>HVP_auxCurrentMia: " + String(noYes[tesla_dl->HVP_auxCurrentMia]) + "</h4>";
+    content += "<h4>HVP_currentSenseMia: " + String(noYes[tesla_dl->HVP_currentSenseMia]) + "</h4>";
+    content += "<h4>HVP_shuntRefVoltageMismatch: " + String(noYes[tesla_dl->HVP_shuntRefVoltageMismatch]) + "</h4>";
+    content += "<h4>HVP_shuntThermistorMia: " + String(noYes[tesla_dl->HVP_shuntThermistorMia]) + "</h4>";
+    content += "<h4>HVP_shuntHwMia: " + String(noYes[tesla_dl->HVP_shuntHwMia]) + "</h4>";
     //content += "<h4>HVP_fcLinkVoltage: " + String(HVP_fcLinkVoltage) + " V</h4>"; // Not giving useable data
     //content += "<h4>HVP_packNegativeV: " + String(HVP_packNegativeV) + " V</h4>"; // Not giving useable data
     //content += "<h4>HVP_packPositiveV: " + String(HVP_packPositiveV) + " V</h4>"; // Not giving useable data
@@ -443,12 +434,12 @@ class TeslaHtmlRenderer : public BatteryHtmlRenderer {
     //content += "<h4>HVP_shuntAuxCurrentDbg: " + String(HVP_shuntAuxCurrentDbg) + " A</h4>"; // Not giving useable data
     //content += "<h4>HVP_shuntBarTempDbg: " + String(HVP_shuntBarTempDbg) + " DegC</h4>"; // Not giving useable data
     //content += "<h4>HVP_shuntAsicTempDbg: " + String(HVP_shuntAsicTempDbg) + " DegC</h4>"; // Not giving useable data
-    //content += "<h4>HVP_shuntAuxCurrentStatus: " + String(HVP_status[datalayer_extended.tesla.HVP_shuntAuxCurrentStatus]) + "</h4>"; // Not giving useable data
-    //content += "<h4>HVP_shuntBarTempStatus: " + String(HVP_status[datalayer_extended.tesla.HVP_shuntBarTempStatus]) + "</h4>"; // Not giving useable data
-    //content += "<h4>HVP_shuntAsicTempStatus: " + String(HVP_status[datalayer_extended.tesla.HVP_shuntAsicTempStatus]) + "</h4>"; // Not giving useable data
-
-    return content;
+    //content += "<h4>HVP_shuntAuxCurrentStatus: " + String(HVP_status[tesla_dl->HVP_shuntAuxCurrentStatus]) + "</h4>"; // Not giving useable data
+    //content += "<h4>HVP_shuntBarTempStatus: " + String(HVP_status[tesla_dl->HVP_shuntBarTempStatus]) + "</h4>"; // Not giving useable data
+    //content += "<h4>HVP_shuntAsicTempStatus: " + String(HVP_status[tesla_dl->HVP_shuntAsicTempStatus]) + "</h4>"; // Not giving useable data
   }
+
+  DATALAYER_INFO_TESLA* tesla_dl;
 };
 
 #endif
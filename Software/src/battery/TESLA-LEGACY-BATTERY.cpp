@@ -120,7 +120,7 @@ void TeslaLegacyBattery::update_values() {
   datalayer.battery.status.cell_min_voltage_mV = battery_cell_min_v;
 }
 
-void TeslaLegacyBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void TeslaLegacyBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   static uint8_t mux = 0;
   switch (rx_frame.ID) {
     case 0x212:  // 530 BMS_status: 5
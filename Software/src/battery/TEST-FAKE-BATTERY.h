@@ -20,7 +20,7 @@ class TestFakeBattery : public CanBattery {
   static constexpr const char* Name = "Fake battery for testing purposes";
 
   virtual void setup();
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
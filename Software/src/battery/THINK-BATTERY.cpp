@@ -34,7 +34,7 @@ void ThinkBattery::update_values() {
   }
 }
 
-void ThinkBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void ThinkBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x300:
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -128,18 +128,6 @@ void ThinkBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-void ThinkBattery::transmit_can(unsigned long currentMillis) {
-  //Send 200ms messages
-  if (currentMillis - previousMillis200 >= INTERVAL_200_MS) {
-    previousMillis200 = currentMillis;
-
-    if (datalayer.system.status.system_status != FAULT) {
-      transmit_can_frame(&PCU_310);
-      transmit_can_frame(&PCU_311);
-    }
-  }
-}
-
 void ThinkBattery::setup(void) {  // Performs one time setup at startup
   strncpy(datalayer.system.info.battery_protocol, Name, 63);
   datalayer.system.info.battery_protocol[63] = '\0';
@@ -148,4 +136,11 @@ void ThinkBattery::setup(void) {  // Performs one time setup at startup
   datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
   datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
   datalayer.system.status.battery_allows_contactor_closing = true;
+
+  transmit_every(INTERVAL_200_MS, 2, [this](unsigned long currentMillis) {
+    if (datalayer.system.status.system_status != FAULT) {
+      transmit_can_frame(&PCU_310);
+      transmit_can_frame(&PCU_311);
+    }
+  });
 }
@@ -7,9 +7,10 @@
 class ThinkBattery : public CanBattery {
  public:
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Think City";
 
  private:
@@ -19,7 +20,6 @@ class ThinkBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 4100;
   static const int MIN_CELL_VOLTAGE_MV = 3000;
 
-  unsigned long previousMillis200 = 0;  // will store last time a 100ms CAN Message was sent
 
   CAN_frame PCU_310 = {.FD = false,
                        .ext_ID = false,
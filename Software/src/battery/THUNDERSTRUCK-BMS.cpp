@@ -31,7 +31,7 @@ void ThunderstruckBMS::
   datalayer.battery.status.temperature_max_dC = highest_cell_temperature * 10;
 }
 
-void ThunderstruckBMS::handle_incoming_can_frame(CAN_frame rx_frame) {
+void ThunderstruckBMS::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x14ffcfd0:  // Temperatures
     case 0x14ffced0:
@@ -151,16 +151,6 @@ void ThunderstruckBMS::handle_incoming_can_frame(CAN_frame rx_frame) {
       break;
   }
 }
-void ThunderstruckBMS::transmit_can(unsigned long currentMillis) {
-
-  // Send 500ms CAN Message
-  if (currentMillis - previousMillis500 >= INTERVAL_500_MS) {
-    previousMillis500 = currentMillis;
-
-    transmit_can_frame(&THUND_14efd0d8);
-    //TODO, should 14ebd0d8 be sent also?
-  }
-}
 
 void ThunderstruckBMS::setup(void) {  // Performs one time setup at startup
   strncpy(datalayer.system.info.battery_protocol, Name, 63);
@@ -172,4 +162,10 @@ void ThunderstruckBMS::setup(void) {  // Performs one time setup at startup
   datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
   datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
   datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+
+  // Send 500ms CAN Message
+  transmit_every(INTERVAL_500_MS, 1, [this](unsigned long currentMillis) {
+    transmit_can_frame(&THUND_14efd0d8);
+    //TODO, should 14ebd0d8 be sent also?
+  });
 }
@@ -6,9 +6,10 @@
 class ThunderstruckBMS : public CanBattery {
  public:
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Thunderstruck BMS";
 
  private:
@@ -18,8 +19,6 @@ class ThunderstruckBMS : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 3800;  //Battery is put into emergency stop if one cell goes over this value
   static const int MIN_CELL_VOLTAGE_MV = 2700;  //Battery is put into emergency stop if one cell goes below this value
 
-  unsigned long previousMillis500 = 0;  // will store last time a 500ms CAN Message was send
-
   uint16_t lowest_cell_voltage = 3700;
   uint16_t highest_cell_voltage = 3700;
   uint16_t packvoltage_dV = 3700;
@@ -10,26 +10,26 @@ void VolvoSpaBattery::
     update_values() {  //This function maps all the values fetched via CAN to the correct parameters used for the inverter
 
   // Update webserver datalayer
-  datalayer_extended.VolvoPolestar.BECMUDynMaxLim = MAX_U;
-  datalayer_extended.VolvoPolestar.BECMUDynMinLim = MIN_U;
+  datalayer_volvo->BECMUDynMaxLim = MAX_U;
+  datalayer_volvo->BECMUDynMinLim = MIN_U;
 
-  datalayer_extended.VolvoPolestar.HvBattPwrLimDcha1 = HvBattPwrLimDcha1;
-  datalayer_extended.VolvoPolestar.HvBattPwrLimDchaSoft = HvBattPwrLimDchaSoft;
-  datalayer_extended.VolvoPolestar.HvBattPwrLimDchaSlowAgi = HvBattPwrLimDchaSlowAgi;
-  datalayer_extended.VolvoPolestar.HvBattPwrLimChrgSlowAgi = HvBattPwrLimChrgSlowAgi;
+  datalayer_volvo->HvBattPwrLimDcha1 = HvBattPwrLimDcha1;
+  datalayer_volvo->HvBattPwrLimDchaSoft = HvBattPwrLimDchaSoft;
+  datalayer_volvo->HvBattPwrLimDchaSlowAgi = HvBattPwrLimDchaSlowAgi;
+  datalayer_volvo->HvBattPwrLimChrgSlowAgi = HvBattPwrLimChrgSlowAgi;
 
   // Update requests from webserver datalayer
-  if (datalayer_extended.VolvoPolestar.UserRequestDTCreset) {
+  if (datalayer_volvo->UserRequestDTCreset) {
     transmit_can_frame(&VOLVO_DTC_Erase);  //Send global DTC erase command
-    datalayer_extended.VolvoPolestar.UserRequestDTCreset = false;
+    datalayer_volvo->UserRequestDTCreset = false;
   }
-  if (datalayer_extended.VolvoPolestar.UserRequestBECMecuReset) {
+  if (datalayer_volvo->UserRequestBECMecuReset) {
     transmit_can_frame(&VOLVO_BECM_ECUreset);  //Send BECM ecu reset command
-    datalayer_extended.VolvoPolestar.UserRequestBECMecuReset = false;
+    datalayer_volvo->UserRequestBECMecuReset = false;
   }
-  if (datalayer_extended.VolvoPolestar.UserRequestDTCreadout) {
+  if (datalayer_volvo->UserRequestDTCreadout) {
     transmit_can_frame(&VOLVO_DTCreadout);  //Send DTC readout command
-    datalayer_extended.VolvoPolestar.UserRequestDTCreadout = false;
+    datalayer_volvo->UserRequestDTCreadout = false;
   }
 
   datalayer.battery.status.remaining_capacity_Wh = (datalayer.battery.info.total_capacity_Wh - CHARGE_ENERGY);
@@ -68,14 +68,14 @@ void VolvoSpaBattery::
   }
 
   //Check safeties
-  if (datalayer_extended.VolvoPolestar.BECMsupplyVoltage < 10700) {  //10.7V,
+  if (datalayer_volvo->BECMsupplyVoltage < 10700) {  //10.7V,
     //If 12V voltage goes under this, latch battery OFF to prevent contactors from swinging between on/off
-    set_event(EVENT_12V_LOW, (datalayer_extended.VolvoPolestar.BECMsupplyVoltage / 100));
+    set_event(EVENT_12V_LOW, (datalayer_volvo->BECMsupplyVoltage / 100));
     set_event(EVENT_BATTERY_CHG_DISCHG_STOP_REQ, 0);
   }
 }
 
-void VolvoSpaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void VolvoSpaBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x3A:
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -97,22 +97,22 @@ void VolvoSpaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       }
 
       if ((rx_frame.data.u8[0] & 0x40) == 0x40)
-        datalayer_extended.VolvoPolestar.HVSysRlySts = ((rx_frame.data.u8[0] & 0x30) >> 4);
+        datalayer_volvo->HVSysRlySts = ((rx_frame.data.u8[0] & 0x30) >> 4);
       else
-        datalayer_extended.VolvoPolestar.HVSysRlySts = 0xFF;
+        datalayer_volvo->HVSysRlySts = 0xFF;
 
       if ((rx_frame.data.u8[2] & 0x40) == 0x40)
-        datalayer_extended.VolvoPolestar.HVSysDCRlySts1 = ((rx_frame.data.u8[2] & 0x30) >> 4);
+        datalayer_volvo->HVSysDCRlySts1 = ((rx_frame.data.u8[2] & 0x30) >> 4);
       else
-        datalayer_extended.VolvoPolestar.HVSysDCRlySts1 = 0xFF;
+        datalayer_volvo->HVSysDCRlySts1 = 0xFF;
       if ((rx_frame.data.u8[2] & 0x80) == 0x80)
-        datalayer_extended.VolvoPolestar.HVSysDCRlySts2 = ((rx_frame.data.u8[4] & 0x30) >> 4);
+        datalayer_volvo->HVSysDCRlySts2 = ((rx_frame.data.u8[4] & 0x30) >> 4);
       else
-        datalayer_extended.VolvoPolestar.HVSysDCRlySts2 = 0xFF;
+        datalayer_volvo->HVSysDCRlySts2 = 0xFF;
       if ((rx_frame.data.u8[0] & 0x80) == 0x80)
-        datalayer_extended.VolvoPolestar.HVSysIsoRMonrSts = ((rx_frame.data.u8[4] & 0xC0) >> 6);
+        datalayer_volvo->HVSysIsoRMonrSts = ((rx_frame.data.u8[4] & 0xC0) >> 6);
       else
-        datalayer_extended.VolvoPolestar.HVSysIsoRMonrSts = 0xFF;
+        datalayer_volvo->HVSysIsoRMonrSts = 0xFF;
 
       break;
     case 0x1A1:
@@ -183,12 +183,12 @@ void VolvoSpaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       } else if ((rx_frame.data.u8[0] == 0x05) && (rx_frame.data.u8[1] == 0x62) && (rx_frame.data.u8[2] == 0xF4) &&
                  (rx_frame.data.u8[3] == 0x42))  // BECM module voltage supply
       {
-        datalayer_extended.VolvoPolestar.BECMsupplyVoltage = ((rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5]);
+        datalayer_volvo->BECMsupplyVoltage = ((rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5]);
         transmit_can_frame(&VOLVO_BECM_HVIL_Status_Req);  //Send HVIL status readout command
       } else if ((rx_frame.data.u8[0] == 0x04) && (rx_frame.data.u8[1] == 0x62) && (rx_frame.data.u8[2] == 0x49) &&
                  (rx_frame.data.u8[3] == 0x1A))  // BECM HVIL status
       {
-        datalayer_extended.VolvoPolestar.HVILstatusBits = (rx_frame.data.u8[4]);
+        datalayer_volvo->HVILstatusBits = (rx_frame.data.u8[4]);
         transmit_can_frame(&VOLVO_DTCreadout);  //Send DTC readout command
       } else if ((rx_frame.data.u8[0] == 0x10) && (rx_frame.data.u8[1] == 0x0B) && (rx_frame.data.u8[2] == 0x62) &&
                  (rx_frame.data.u8[3] == 0x4B))  // First response frame of cell voltages
@@ -200,15 +200,15 @@ void VolvoSpaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       } else if ((rx_frame.data.u8[0] == 0x10) && (rx_frame.data.u8[2] == 0x59) &&
                  (rx_frame.data.u8[3] == 0x03))  // First response frame for DTC with more than one code
       {
-        datalayer_extended.VolvoPolestar.DTCcount = ((rx_frame.data.u8[1] - 2) / 4);
+        datalayer_volvo->DTCcount = ((rx_frame.data.u8[1] - 2) / 4);
         transmit_can_frame(&VOLVO_FlowControl);  // Send flow control
       } else if ((rx_frame.data.u8[1] == 0x59) &&
                  (rx_frame.data.u8[2] == 0x03))  // Response frame for DTC with 0 or 1 code
       {
         if (rx_frame.data.u8[0] != 0x02) {
-          datalayer_extended.VolvoPolestar.DTCcount = 1;
+          datalayer_volvo->DTCcount = 1;
         } else {
-          datalayer_extended.VolvoPolestar.DTCcount = 0;
+          datalayer_volvo->DTCcount = 0;
         }
       } else if ((rx_frame.data.u8[0] == 0x21) && (rxConsecutiveFrames)) {
         cell_voltages[battery_request_idx] |= rx_frame.data.u8[1];
@@ -221,14 +221,9 @@ void VolvoSpaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
           VOLVO_CELL_U_Req.data.u8[3] = batteryModuleNumber++;
           transmit_can_frame(&VOLVO_CELL_U_Req);  //Send cell voltage read request for next module
         } else {
-          min_max_voltage[0] = 9999;
-          min_max_voltage[1] = 0;
-          for (cellcounter = 0; cellcounter < 108; cellcounter++) {
-            if (min_max_voltage[0] > cell_voltages[cellcounter])
-              min_max_voltage[0] = cell_voltages[cellcounter];
-            if (min_max_voltage[1] < cell_voltages[cellcounter])
-              min_max_voltage[1] = cell_voltages[cellcounter];
-          }
+          Cell_Statistics cells = compute_cell_statistics(cell_voltages, 108, 0);
+          min_max_voltage[0] = cells.min_mV;
+          min_max_voltage[1] = cells.max_mV;
           transmit_can_frame(&VOLVO_SOH_Req);  //Send SOH read request
         }
         rxConsecutiveFrames = false;
@@ -247,25 +242,31 @@ void VolvoSpaBattery::readCellVoltages() {
   transmit_can_frame(&VOLVO_CELL_U_Req);  //Send cell voltage read request for first module
 }
 
-void VolvoSpaBattery::transmit_can(unsigned long currentMillis) {
-  // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
+void VolvoSpaBattery::setup(void) {  // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.battery.info.number_of_cells = 0;        // Initializes when all cells have been read
+  datalayer.battery.info.total_capacity_Wh = 78200;  //Startout in 78kWh mode (This value used for SOC calc)
+  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_108S_DV;  //Startout with max allowed range
+  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_96S_DV;   //Startout with min allowed range
+  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
 
+  // Send 100ms CAN Message
+  transmit_every(INTERVAL_100_MS, 3, [this](unsigned long currentMillis) {
     transmit_can_frame(&VOLVO_536);  //Send 0x536 Network managing frame to keep BMS alive
     transmit_can_frame(&VOLVO_372);  //Send 0x372 ECMAmbientTempCalculated
 
     if ((datalayer.system.status.system_status == ACTIVE) && startedUp) {
       datalayer.system.status.battery_allows_contactor_closing = true;
-      transmit_can_frame(&VOLVO_140_CLOSE);  //Send 0x140 Close contactors message
+      transmit_can_frame(&VOLVO_140_CLOSE, CAN_TX_SAFETY);  //Send 0x140 Close contactors message
     } else {  //datalayer.battery.status.bms_status == FAULT , OR inverter requested opening contactors, OR system not started yet
       datalayer.system.status.battery_allows_contactor_closing = false;
-      transmit_can_frame(&VOLVO_140_OPEN);  //Send 0x140 Open contactors message
+      transmit_can_frame(&VOLVO_140_OPEN, CAN_TX_SAFETY);  //Send 0x140 Open contactors message
     }
-  }
-  if (currentMillis - previousMillis1s >= INTERVAL_1_S) {
-    previousMillis1s = currentMillis;
-
+  });
+  transmit_every(INTERVAL_1_S, 1, [this](unsigned long currentMillis) {
     if (!startedUp) {
       transmit_can_frame(&VOLVO_DTC_Erase);  //Erase any DTCs preventing startup
       DTC_reset_counter++;
@@ -273,23 +274,10 @@ void VolvoSpaBattery::transmit_can(unsigned long currentMillis) {
         startedUp = true;
       }
     }
-  }
-  if (currentMillis - previousMillis60s >= INTERVAL_60_S) {
-    previousMillis60s = currentMillis;
+  });
+  transmit_every(INTERVAL_60_S, 1, [this](unsigned long currentMillis) {
     if (datalayer.system.status.system_status == ACTIVE) {
       readCellVoltages();
     }
-  }
-}
-
-void VolvoSpaBattery::setup(void) {  // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.battery.info.number_of_cells = 0;        // Initializes when all cells have been read
-  datalayer.battery.info.total_capacity_Wh = 78200;  //Startout in 78kWh mode (This value used for SOC calc)
-  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_108S_DV;  //Startout with max allowed range
-  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_96S_DV;   //Startout with min allowed range
-  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  });
 }
@@ -6,25 +6,31 @@
 
 class VolvoSpaBattery : public CanBattery {
  public:
+  VolvoSpaBattery() : renderer(datalayer_extended.VolvoPolestar.get()) {
+    datalayer_volvo = datalayer_extended.VolvoPolestar.get();
+  }
+
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Volvo / Polestar 69/78kWh SPA battery";
 
   bool supports_reset_DTC() { return true; }
-  void reset_DTC() { datalayer_extended.VolvoPolestar.UserRequestDTCreset = true; }
+  void reset_DTC() { datalayer_volvo->UserRequestDTCreset = true; }
 
   bool supports_read_DTC() { return true; }
-  void read_DTC() { datalayer_extended.VolvoPolestar.UserRequestDTCreadout = true; }
+  void read_DTC() { datalayer_volvo->UserRequestDTCreadout = true; }
 
   bool supports_reset_BECM() { return true; }
-  void reset_BECM() { datalayer_extended.VolvoPolestar.UserRequestBECMecuReset = true; }
+  void reset_BECM() { datalayer_volvo->UserRequestBECMecuReset = true; }
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
 
  private:
   VolvoSpaHtmlRenderer renderer;
+  DATALAYER_INFO_VOLVO_POLESTAR* datalayer_volvo;
 
   void readCellVoltages();
 
@@ -36,10 +42,6 @@ class VolvoSpaBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 4260;  // Charging is halted if one cell goes above this
   static const int MIN_CELL_VOLTAGE_MV = 2700;  // Charging is halted if one cell goes below this
 
-  unsigned long previousMillis100 = 0;  // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis1s = 0;   // will store last time a 1s CAN Message was send
-  unsigned long previousMillis60s = 0;  // will store last time a 60s CAN Message was send
-
   int32_t CHARGE_ENERGY = 0;             //0x1A1
   uint16_t BATT_U = 0;                   //0x3A
   uint16_t MAX_U = 0;                    //0x3A
@@ -61,7 +63,6 @@ class VolvoSpaBattery : public CanBattery {
   uint8_t battery_request_idx = 0;
   bool rxConsecutiveFrames = false;
   uint16_t min_max_voltage[2];  //contains cell min[0] and max[1] values in mV
-  uint8_t cellcounter = 0;
   uint16_t cell_voltages[108];  //array with all the cellvoltages
   bool startedUp = false;
   uint8_t DTC_reset_counter = 0;
@@ -7,26 +7,22 @@
 
 class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
  public:
+  VolvoSpaHtmlRenderer(DATALAYER_INFO_VOLVO_POLESTAR* dl) : volvo_dl(dl) {}
+
   String get_status_html() {
     String content;
-    content += "</h4><h4>BECM reported number of DTCs: " + String(datalayer_extended.VolvoPolestar.DTCcount) + "</h4>";
-    content += "<h4>BECM supply voltage: " + String(datalayer_extended.VolvoPolestar.BECMsupplyVoltage) + " mV</h4>";
+    content += "</h4><h4>BECM reported number of DTCs: " + String(volvo_dl->DTCcount) + "</h4>";
+    content += "<h4>BECM supply voltage: " + String(volvo_dl->BECMsupplyVoltage) + " mV</h4>";
 
-    content += "<h4>Dynamic max voltage: " + String(datalayer_extended.VolvoPolestar.BECMUDynMaxLim) + " V</h4>";
-    content += "<h4>Dynamic min voltage: " + String(datalayer_extended.VolvoPolestar.BECMUDynMinLim) + " V</h4>";
+    content += "<h4>Dynamic max voltage: " + String(volvo_dl->BECMUDynMaxLim) + " V</h4>";
+    content += "<h4>Dynamic min voltage: " + String(volvo_dl->BECMUDynMinLim) + " V</h4>";
 
-    content +=
-        "<h4>Discharge power limit 1: " + String(datalayer_extended.VolvoPolestar.HvBattPwrLimDcha1) + " kW</h4>";
-    content +=
-        "<h4>Discharge soft power limit: " + String(datalayer_extended.VolvoPolestar.HvBattPwrLimDchaSoft) + " kW</h4>";
-    content +=
-        "<h4>Discharge power limit slow aging: " + String(datalayer_extended.VolvoPolestar.HvBattPwrLimDchaSlowAgi) +
-        " kW</h4>";
-    content +=
-        "<h4>Charge power limit slow aging: " + String(datalayer_extended.VolvoPolestar.HvBattPwrLimChrgSlowAgi) +
-        " kW</h4>";
+    content += "<h4>Discharge power limit 1: " + String(volvo_dl->HvBattPwrLimDcha1) + " kW</h4>";
+    content += "<h4>Discharge soft power limit: " + String(volvo_dl->HvBattPwrLimDchaSoft) + " kW</h4>";
+    content += "<h4>Discharge power limit slow aging: " + String(volvo_dl->HvBattPwrLimDchaSlowAgi) + " kW</h4>";
+    content += "<h4>Charge power limit slow aging: " + String(volvo_dl->HvBattPwrLimChrgSlowAgi) + " kW</h4>";
     content += "<h4>HVIL Circuit A status: ";
-    switch (datalayer_extended.VolvoPolestar.HVILstatusBits & 0x01) {
+    switch (volvo_dl->HVILstatusBits & 0x01) {
       case 0x01:
         content += String("Open");
         break;
@@ -34,7 +30,7 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Not valid");
     }
     content += "<h4>HVIL Circuit B status: ";
-    switch (datalayer_extended.VolvoPolestar.HVILstatusBits & 0x02) {
+    switch (volvo_dl->HVILstatusBits & 0x02) {
       case 0x02:
         content += String("Open");
         break;
@@ -42,7 +38,7 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>HVIL Circuit C status: ";
-    switch (datalayer_extended.VolvoPolestar.HVILstatusBits & 0x04) {
+    switch (volvo_dl->HVILstatusBits & 0x04) {
       case 0x04:
         content += String("Open");
         break;
@@ -50,7 +46,7 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>Precharge contactor status: ";
-    switch (datalayer_extended.VolvoPolestar.HVILstatusBits & 0x08) {
+    switch (volvo_dl->HVILstatusBits & 0x08) {
       case 0x08:
         content += String("Open");
         break;
@@ -58,7 +54,7 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>Positive Contactor status: ";
-    switch (datalayer_extended.VolvoPolestar.HVILstatusBits & 0x10) {
+    switch (volvo_dl->HVILstatusBits & 0x10) {
       case 0x10:
         content += String("Open");
         break;
@@ -66,7 +62,7 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>Negative Contactor status: ";
-    switch (datalayer_extended.VolvoPolestar.HVILstatusBits & 0x20) {
+    switch (volvo_dl->HVILstatusBits & 0x20) {
       case 0x20:
         content += String("Open");
         break;
@@ -74,7 +70,7 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Closed");
     }
     content += "<h4>HV system relay status: ";
-    switch (datalayer_extended.VolvoPolestar.HVSysRlySts) {
+    switch (volvo_dl->HVSysRlySts) {
       case 0:
         content += String("Open");
         break;
@@ -91,7 +87,7 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Not valid");
     }
     content += "</h4><h4>HV system relay status 1: ";
-    switch (datalayer_extended.VolvoPolestar.HVSysDCRlySts1) {
+    switch (volvo_dl->HVSysDCRlySts1) {
       case 0:
         content += String("Open");
         break;
@@ -108,7 +104,7 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Not valid");
     }
     content += "</h4><h4>HV system relay status 2: ";
-    switch (datalayer_extended.VolvoPolestar.HVSysDCRlySts2) {
+    switch (volvo_dl->HVSysDCRlySts2) {
       case 0:
         content += String("Open");
         break;
@@ -125,7 +121,7 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Not valid");
     }
     content += "</h4><h4>HV system isolation resistance monitoring status: ";
-    switch (datalayer_extended.VolvoPolestar.HVSysIsoRMonrSts) {
+    switch (volvo_dl->HVSysIsoRMonrSts) {
       case 0:
         content += String("Not valid 1");
         break;
@@ -144,6 +140,9 @@ class VolvoSpaHtmlRenderer : public BatteryHtmlRenderer {
 
     return content;
   }
+
+ private:
+  DATALAYER_INFO_VOLVO_POLESTAR* volvo_dl;
 };
 
 #endif
@@ -10,33 +10,33 @@ void VolvoSpaHybridBattery::
     update_values() {  //This function maps all the values fetched via CAN to the correct parameters used for the inverter
 
   // Update webserver datalayer
-  datalayer_extended.VolvoHybrid.soc_bms = SOC_BMS;
-  datalayer_extended.VolvoHybrid.soc_calc = SOC_CALC;
-  datalayer_extended.VolvoHybrid.soc_rescaled = datalayer.battery.status.reported_soc;
-  datalayer_extended.VolvoHybrid.soh_bms = datalayer.battery.status.soh_pptt;
+  datalayer_volvohybrid->soc_bms = SOC_BMS;
+  datalayer_volvohybrid->soc_calc = SOC_CALC;
+  datalayer_volvohybrid->soc_rescaled = datalayer.battery.status.reported_soc;
+  datalayer_volvohybrid->soh_bms = datalayer.battery.status.soh_pptt;
 
-  datalayer_extended.VolvoHybrid.BECMBatteryVoltage = BATT_U;
-  datalayer_extended.VolvoHybrid.BECMBatteryCurrent = BATT_I;
-  datalayer_extended.VolvoHybrid.BECMUDynMaxLim = MAX_U;
-  datalayer_extended.VolvoHybrid.BECMUDynMinLim = MIN_U;
+  datalayer_volvohybrid->BECMBatteryVoltage = BATT_U;
+  datalayer_volvohybrid->BECMBatteryCurrent = BATT_I;
+  datalayer_volvohybrid->BECMUDynMaxLim = MAX_U;
+  datalayer_volvohybrid->BECMUDynMinLim = MIN_U;
 
-  datalayer_extended.VolvoHybrid.HvBattPwrLimDcha1 = HvBattPwrLimDcha1;
-  datalayer_extended.VolvoHybrid.HvBattPwrLimDchaSoft = HvBattPwrLimDchaSoft;
+  datalayer_volvohybrid->HvBattPwrLimDcha1 = HvBattPwrLimDcha1;
+  datalayer_volvohybrid->HvBattPwrLimDchaSoft = HvBattPwrLimDchaSoft;
   //datalayer_extended.VolvoHybrid.HvBattPwrLimDchaSlowAgi = HvBattPwrLimDchaSlowAgi;
   //datalayer_extended.VolvoHybrid.HvBattPwrLimChrgSlowAgi = HvBattPwrLimChrgSlowAgi;
 
   // Update requests from webserver datalayer
-  if (datalayer_extended.VolvoHybrid.UserRequestDTCreset) {
+  if (datalayer_volvohybrid->UserRequestDTCreset) {
     transmit_can_frame(&VOLVO_DTC_Erase);  //Send global DTC erase command
-    datalayer_extended.VolvoHybrid.UserRequestDTCreset = false;
+    datalayer_volvohybrid->UserRequestDTCreset = false;
   }
-  if (datalayer_extended.VolvoHybrid.UserRequestBECMecuReset) {
+  if (datalayer_volvohybrid->UserRequestBECMecuReset) {
     transmit_can_frame(&VOLVO_BECM_ECUreset);  //Send BECM ecu reset command
-    datalayer_extended.VolvoHybrid.UserRequestBECMecuReset = false;
+    datalayer_volvohybrid->UserRequestBECMecuReset = false;
   }
-  if (datalayer_extended.VolvoHybrid.UserRequestDTCreadout) {
+  if (datalayer_volvohybrid->UserRequestDTCreadout) {
     transmit_can_frame(&VOLVO_DTCreadout);  //Send DTC readout command
-    datalayer_extended.VolvoHybrid.UserRequestDTCreadout = false;
+    datalayer_volvohybrid->UserRequestDTCreadout = false;
   }
 
   remaining_capacity = (18830 - CHARGE_ENERGY);
@@ -72,7 +72,7 @@ void VolvoSpaHybridBattery::
   }
 }
 
-void VolvoSpaHybridBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void VolvoSpaHybridBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x3A:
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -105,22 +105,22 @@ void VolvoSpaHybridBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       }
 
       if ((rx_frame.data.u8[0] & 0x40) == 0x40)
-        datalayer_extended.VolvoHybrid.HVSysRlySts = ((rx_frame.data.u8[0] & 0x30) >> 4);
+        datalayer_volvohybrid->HVSysRlySts = ((rx_frame.data.u8[0] & 0x30) >> 4);
       else
-        datalayer_extended.VolvoHybrid.HVSysRlySts = 0xFF;
+        datalayer_volvohybrid->HVSysRlySts = 0xFF;
 
       if ((rx_frame.data.u8[2] & 0x40) == 0x40)
-        datalayer_extended.VolvoHybrid.HVSysDCRlySts1 = ((rx_frame.data.u8[2] & 0x30) >> 4);
+        datalayer_volvohybrid->HVSysDCRlySts1 = ((rx_frame.data.u8[2] & 0x30) >> 4);
       else
-        datalayer_extended.VolvoHybrid.HVSysDCRlySts1 = 0xFF;
+        datalayer_volvohybrid->HVSysDCRlySts1 = 0xFF;
       if ((rx_frame.data.u8[2] & 0x80) == 0x80)
-        datalayer_extended.VolvoHybrid.HVSysDCRlySts2 = ((rx_frame.data.u8[4] & 0x30) >> 4);
+        datalayer_volvohybrid->HVSysDCRlySts2 = ((rx_frame.data.u8[4] & 0x30) >> 4);
       else
-        datalayer_extended.VolvoHybrid.HVSysDCRlySts2 = 0xFF;
+        datalayer_volvohybrid->HVSysDCRlySts2 = 0xFF;
       if ((rx_frame.data.u8[0] & 0x80) == 0x80)
-        datalayer_extended.VolvoHybrid.HVSysIsoRMonrSts = ((rx_frame.data.u8[4] & 0xC0) >> 6);
+        datalayer_volvohybrid->HVSysIsoRMonrSts = ((rx_frame.data.u8[4] & 0xC0) >> 6);
       else
-        datalayer_extended.VolvoHybrid.HVSysIsoRMonrSts = 0xFF;
+        datalayer_volvohybrid->HVSysIsoRMonrSts = 0xFF;
 
       break;
     case 0x1A1:
@@ -224,7 +224,7 @@ void VolvoSpaHybridBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       } else if ((rx_frame.data.u8[0] == 0x05) && (rx_frame.data.u8[1] == 0x62) && (rx_frame.data.u8[2] == 0xF4) &&
                  (rx_frame.data.u8[3] == 0x42))  // BECM module voltage supply
       {
-        datalayer_extended.VolvoHybrid.BECMsupplyVoltage = ((rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5]);
+        datalayer_volvohybrid->BECMsupplyVoltage = ((rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5]);
       } else if ((rx_frame.data.u8[0] == 0x10) && (rx_frame.data.u8[1] == 0xCF) && (rx_frame.data.u8[2] == 0x62) &&
                  (rx_frame.data.u8[3] == 0x48) &&
                  (rx_frame.data.u8[4] == 0x06))  // First response frame of cell voltages //changed
@@ -435,16 +435,10 @@ void VolvoSpaHybridBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
           //transmit_can_frame(&VOLVO_CELL_U_Req);  //Send cell voltage read request for next module
           ;
         } else {
-          min_max_voltage[0] = 9999;
-          min_max_voltage[1] = 0;
-          for (cellcounter = 0; cellcounter < 102; cellcounter++) {
-            if (min_max_voltage[0] > cell_voltages[cellcounter])
-              min_max_voltage[0] = cell_voltages[cellcounter];
-            if (min_max_voltage[1] < cell_voltages[cellcounter]) {
-              min_max_voltage[1] = cell_voltages[cellcounter];
-              CELL_ID_U_MAX = cellcounter;
-            }
-          }
+          Cell_Statistics cells = compute_cell_statistics(cell_voltages, 102, 0);
+          min_max_voltage[0] = cells.min_mV;
+          min_max_voltage[1] = cells.max_mV;
+          CELL_ID_U_MAX = cells.max_index;
           CELL_U_MAX = min_max_voltage[1];
           CELL_U_MIN = min_max_voltage[0];
 
@@ -466,11 +460,18 @@ void VolvoSpaHybridBattery::readCellVoltages() {
   transmit_can_frame(&VOLVO_CELL_U_Req);  //Send cell voltage read request for first module
 }
 
-void VolvoSpaHybridBattery::transmit_can(unsigned long currentMillis) {
-  // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
+void VolvoSpaHybridBattery::setup(void) {                     // Performs one time setup at startup
+  strncpy(datalayer.system.info.battery_protocol, Name, 63);  //changed
+  datalayer.system.info.battery_protocol[63] = '\0';
+  datalayer.battery.info.number_of_cells = 102;  //was 108, changed
+  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
+  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
+  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
+  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
+  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
 
+  // Send 100ms CAN Message
+  transmit_every(INTERVAL_100_MS, 3, [this](unsigned long currentMillis) {
     transmit_can_frame(&VOLVO_536);  //Send 0x536 Network managing frame to keep BMS alive
     transmit_can_frame(&VOLVO_372);  //Send 0x372 ECMAmbientTempCalculated
 
@@ -481,10 +482,8 @@ void VolvoSpaHybridBattery::transmit_can(unsigned long currentMillis) {
       datalayer.system.status.battery_allows_contactor_closing = false;
       transmit_can_frame(&VOLVO_140_OPEN);  //Send 0x140 Open contactors message
     }
-  }
-  if (currentMillis - previousMillis1s >= INTERVAL_1_S) {
-    previousMillis1s = currentMillis;
-
+  });
+  transmit_every(INTERVAL_1_S, 1, [this](unsigned long currentMillis) {
     if (!startedUp) {
       transmit_can_frame(&VOLVO_DTC_Erase);  //Erase any DTCs preventing startup
       DTC_reset_counter++;
@@ -492,21 +491,9 @@ void VolvoSpaHybridBattery::transmit_can(unsigned long currentMillis) {
         startedUp = true;
       }
     }
-  }
-  if (currentMillis - previousMillis60s >= INTERVAL_60_S) {
-    previousMillis60s = currentMillis;
+  });
+  transmit_every(INTERVAL_60_S, 1, [this](unsigned long currentMillis) {
     readCellVoltages();
     logging.println("Requesting cell voltages");
-  }
-}
-
-void VolvoSpaHybridBattery::setup(void) {                     // Performs one time setup at startup
-  strncpy(datalayer.system.info.battery_protocol, Name, 63);  //changed
-  datalayer.system.info.battery_protocol[63] = '\0';
-  datalayer.battery.info.number_of_cells = 102;  //was 108, changed
-  datalayer.battery.info.max_design_voltage_dV = MAX_PACK_VOLTAGE_DV;
-  datalayer.battery.info.min_design_voltage_dV = MIN_PACK_VOLTAGE_DV;
-  datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
-  datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
-  datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+  });
 }
@@ -5,25 +5,31 @@
 
 class VolvoSpaHybridBattery : public CanBattery {
  public:
+  VolvoSpaHybridBattery() : renderer(datalayer_extended.VolvoHybrid.get()) {
+    datalayer_volvohybrid = datalayer_extended.VolvoHybrid.get();
+  }
+
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
-  virtual void transmit_can(unsigned long currentMillis);
+  // All frames are scheduled with transmit_every() in setup()
+  virtual void transmit_can(unsigned long currentMillis) {}
   static constexpr const char* Name = "Volvo PHEV battery";
 
   bool supports_reset_DTC() { return true; }
-  void reset_DTC() { datalayer_extended.VolvoHybrid.UserRequestDTCreset = true; }
+  void reset_DTC() { datalayer_volvohybrid->UserRequestDTCreset = true; }
 
   bool supports_read_DTC() { return true; }
-  void read_DTC() { datalayer_extended.VolvoHybrid.UserRequestDTCreadout = true; }
+  void read_DTC() { datalayer_volvohybrid->UserRequestDTCreadout = true; }
 
   bool supports_reset_BECM() { return true; }
-  void reset_BECM() { datalayer_extended.VolvoHybrid.UserRequestBECMecuReset = true; }
+  void reset_BECM() { datalayer_volvohybrid->UserRequestBECMecuReset = true; }
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
 
  private:
   VolvoSpaHybridHtmlRenderer renderer;
+  DATALAYER_INFO_VOLVO_HYBRID* datalayer_volvohybrid;
   void readCellVoltages();
 
   static const int MAX_PACK_VOLTAGE_DV = 4294;  //5000 = 500.0V
@@ -32,10 +38,6 @@ class VolvoSpaHybridBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 4210;  //Battery is put into emergency stop if one cell goes over this value
   static const int MIN_CELL_VOLTAGE_MV = 2700;  //Battery is put into emergency stop if one cell goes below this value
 
-  unsigned long previousMillis100 = 0;  // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis1s = 0;   // will store last time a 1s CAN Message was send
-  unsigned long previousMillis60s = 0;  // will store last time a 60s CAN Message was send
-
   float BATT_U = 0;                 //0x3A
   float MAX_U = 0;                  //0x3A
   float MIN_U = 0;                  //0x3A
@@ -58,7 +60,6 @@ class VolvoSpaHybridBattery : public CanBattery {
   uint8_t battery_request_idx = 0;
   uint8_t rxConsecutiveFrames = 0;
   uint16_t min_max_voltage[2];  //contains cell min[0] and max[1] values in mV
-  uint8_t cellcounter = 0;
   uint32_t remaining_capacity = 0;
   uint16_t cell_voltages[102];  //array with all the cellvoltages
   bool startedUp = false;
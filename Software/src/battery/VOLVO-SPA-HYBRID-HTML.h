@@ -7,26 +7,27 @@
 
 class VolvoSpaHybridHtmlRenderer : public BatteryHtmlRenderer {
  public:
+  VolvoSpaHybridHtmlRenderer(DATALAYER_INFO_VOLVO_HYBRID* dl) : volvohybrid_dl(dl) {}
+
   String get_status_html() {
     String content;
 
-    content += "<h4>BECM reported SOC: " + String(datalayer_extended.VolvoHybrid.soc_bms) + "</h4>";
-    content += "<h4>Calculated SOC: " + String(datalayer_extended.VolvoHybrid.soc_calc) + "</h4>";
-    content += "<h4>Rescaled SOC: " + String(datalayer_extended.VolvoHybrid.soc_rescaled / 10) + "</h4>";
-    content += "<h4>BECM reported SOH: " + String(datalayer_extended.VolvoHybrid.soh_bms) + "</h4>";
-    content += "<h4>BECM supply voltage: " + String(datalayer_extended.VolvoHybrid.BECMsupplyVoltage) + " mV</h4>";
+    content += "<h4>BECM reported SOC: " + String(volvohybrid_dl->soc_bms) + "</h4>";
+    content += "<h4>Calculated SOC: " + String(volvohybrid_dl->soc_calc) + "</h4>";
+    content += "<h4>Rescaled SOC: " + String(volvohybrid_dl->soc_rescaled / 10) + "</h4>";
+    content += "<h4>BECM reported SOH: " + String(volvohybrid_dl->soh_bms) + "</h4>";
+    content += "<h4>BECM supply voltage: " + String(volvohybrid_dl->BECMsupplyVoltage) + " mV</h4>";
 
-    content += "<h4>HV voltage: " + String(datalayer_extended.VolvoHybrid.BECMBatteryVoltage) + " V</h4>";
-    content += "<h4>HV current: " + String(datalayer_extended.VolvoHybrid.BECMBatteryCurrent) + " A</h4>";
-    content += "<h4>Dynamic max voltage: " + String(datalayer_extended.VolvoHybrid.BECMUDynMaxLim) + " V</h4>";
-    content += "<h4>Dynamic min voltage: " + String(datalayer_extended.VolvoHybrid.BECMUDynMinLim) + " V</h4>";
+    content += "<h4>HV voltage: " + String(volvohybrid_dl->BECMBatteryVoltage) + " V</h4>";
+    content += "<h4>HV current: " + String(volvohybrid_dl->BECMBatteryCurrent) + " A</h4>";
+    content += "<h4>Dynamic max voltage: " + String(volvohybrid_dl->BECMUDynMaxLim) + " V</h4>";
+    content += "<h4>Dynamic min voltage: " + String(volvohybrid_dl->BECMUDynMinLim) + " V</h4>";
 
-    content += "<h4>Discharge power limit 1: " + String(datalayer_extended.VolvoHybrid.HvBattPwrLimDcha1) + " kW</h4>";
-    content +=
-        "<h4>Discharge soft power limit: " + String(datalayer_extended.VolvoHybrid.HvBattPwrLimDchaSoft) + " kW</h4>";
+    content += "<h4>Discharge power limit 1: " + String(volvohybrid_dl->HvBattPwrLimDcha1) + " kW</h4>";
+    content += "<h4>Discharge soft power limit: " + String(volvohybrid_dl->HvBattPwrLimDchaSoft) + " kW</h4>";
 
     content += "<h4>HV system relay status: ";
-    switch (datalayer_extended.VolvoHybrid.HVSysRlySts) {
+    switch (volvohybrid_dl->HVSysRlySts) {
       case 0:
         content += String("Open");
         break;
@@ -43,7 +44,7 @@ class VolvoSpaHybridHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Not valid");
     }
     content += "</h4><h4>HV system relay status 1: ";
-    switch (datalayer_extended.VolvoHybrid.HVSysDCRlySts1) {
+    switch (volvohybrid_dl->HVSysDCRlySts1) {
       case 0:
         content += String("Open");
         break;
@@ -60,7 +61,7 @@ class VolvoSpaHybridHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Not valid");
     }
     content += "</h4><h4>HV system relay status 2: ";
-    switch (datalayer_extended.VolvoHybrid.HVSysDCRlySts2) {
+    switch (volvohybrid_dl->HVSysDCRlySts2) {
       case 0:
         content += String("Open");
         break;
@@ -77,7 +78,7 @@ class VolvoSpaHybridHtmlRenderer : public BatteryHtmlRenderer {
         content += String("Not valid");
     }
     content += "</h4><h4>HV system isolation resistance monitoring status: ";
-    switch (datalayer_extended.VolvoHybrid.HVSysIsoRMonrSts) {
+    switch (volvohybrid_dl->HVSysIsoRMonrSts) {
       case 0:
         content += String("Not valid 1");
         break;
@@ -96,6 +97,9 @@ class VolvoSpaHybridHtmlRenderer : public BatteryHtmlRenderer {
 
     return content;
   }
+
+ private:
+  DATALAYER_INFO_VOLVO_HYBRID* volvohybrid_dl;
 };
 
 #endif
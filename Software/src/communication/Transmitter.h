@@ -1,9 +1,26 @@
 #ifndef _TRANSMITTER_H
 #define _TRANSMITTER_H
 
+#include "tx_scheduler.h"
+
 class Transmitter {
  public:
   virtual void transmit(unsigned long currentMillis) = 0;
+
+  // Checked before the scheduled jobs of this transmitter run
+  virtual bool transmit_allowed() { return true; }
+
+  // Transmitters with jobs in tx_scheduler are no longer polled through transmit() every ms
+  bool scheduled() const { return has_scheduled_jobs; }
+
+ protected:
+  virtual ~Transmitter();
+
+  // Have tx_scheduler call callback every period_ms, frames is about how many frames it sends
+  void transmit_every(uint16_t period_ms, uint8_t frames, Tx_Callback callback);
+
+ private:
+  bool has_scheduled_jobs = false;
 };
 
 void register_transmitter(Transmitter* transmitter);
@@ -1,11 +1,16 @@
 #ifndef _CANRECEIVER_H
 #define _CANRECEIVER_H
 
+#include <vector>
 #include "../../devboard/utils/types.h"
 
 class CanReceiver {
  public:
-  virtual void receive_can_frame(CAN_frame* rx_frame) = 0;
+  virtual void receive_can_frame(const CAN_frame& rx_frame) = 0;
+
+  // The CAN IDs this receiver handles, used by init_CAN() to program the hardware acceptance filters.
+  // IDs above 0x7FF are treated as extended. An empty list (the default) means all frames are needed.
+  virtual std::vector<uint32_t> handled_can_ids() { return {}; }
 };
 
 #endif
@@ -0,0 +1,98 @@
+#include "can_dispatch.h"
+
+#include <algorithm>
+
+CAN_Dispatch_Table can_dispatch_tables[NO_CAN_INTERFACE];
+
+bool can_dispatch_add(CanReceiver* receiver, CAN_Interface interface, CAN_Speed speed, const CAN_ID_Filter& filter) {
+  if (interface >= NO_CAN_INTERFACE) {
+    return false;
+  }
+
+  CAN_Dispatch_Table& table = can_dispatch_tables[interface];
+  if (table.count >= CAN_MAX_RECEIVERS_PER_INTERFACE) {
+    return false;
+  }
+
+  CAN_Dispatch_Entry& entry = table.entries[table.count++];
+  entry.receiver = receiver;
+  entry.speed = speed;
+  entry.filter = filter;
+  entry.hits = 0;
+  entry.misses = 0;
+  return true;
+}
+
+void can_dispatch_clear() {
+  for (auto& table : can_dispatch_tables) {
+    table = CAN_Dispatch_Table();
+  }
+}
+
+std::vector<uint32_t> can_dispatch_handled_ids(CAN_Interface interface) {
+  std::vector<uint32_t> ids;
+  const CAN_Dispatch_Table& table = can_dispatch_tables[interface];
+  for (uint8_t i = 0; i < table.count; i++) {
+    auto receiver_ids = table.entries[i].receiver->handled_can_ids();
+    if (receiver_ids.empty()) {
+      return {};
+    }
+    ids.insert(ids.end(), receiver_ids.begin(), receiver_ids.end());
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+// Amount of IDs a code/mask pair accepts, as a power of two
+static inline int accepted_bits(uint32_t mask, uint32_t id_mask) {
+  return __builtin_popcount(id_mask & ~mask);
+}
+
+uint8_t can_compute_acceptance_filters(const std::vector<uint32_t>& ids, CAN_ID_Filter* out, uint8_t max_filters) {
+  if (ids.empty() || max_filters == 0) {
+    return 0;
+  }
+
+  const bool extended = ids.back() > 0x7FF;
+  if (extended && ids.front() <= 0x7FF) {
+    return 0;
+  }
+  const uint32_t id_mask = extended ? 0x1FFFFFFF : 0x7FF;
+
+  // Start with one exact filter per ID
+  std::vector<CAN_ID_Filter> groups;
+  for (auto id : ids) {
+    CAN_ID_Filter filter;
+    filter.code = id;
+    filter.mask = id_mask;
+    filter.format = extended ? CAN_ID_Format::EXTENDED : CAN_ID_Format::STANDARD;
+    groups.push_back(filter);
+  }
+
+  // Merge the pair of groups whose combined filter accepts the fewest IDs until the groups fit
+  while (groups.size() > max_filters) {
+    size_t best_a = 0, best_b = 1;
+    int64_t best_cost = INT64_MAX;
+    for (size_t a = 0; a < groups.size(); a++) {
+      for (size_t b = a + 1; b < groups.size(); b++) {
+        uint32_t mask = groups[a].mask & groups[b].mask & ~(groups[a].code ^ groups[b].code);
+        int64_t cost = (1LL << accepted_bits(mask, id_mask)) - (1LL << accepted_bits(groups[a].mask, id_mask)) -
+                       (1LL << accepted_bits(groups[b].mask, id_mask));
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_a = a;
+          best_b = b;
+        }
+      }
+    }
+    groups[best_a].mask &= groups[best_b].mask & ~(groups[best_a].code ^ groups[best_b].code);
+    groups[best_a].code &= groups[best_a].mask;
+    groups.erase(groups.begin() + best_b);
+  }
+
+  for (size_t i = 0; i < groups.size(); i++) {
+    out[i] = groups[i];
+  }
+  return groups.size();
+}
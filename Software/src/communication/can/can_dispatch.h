@@ -0,0 +1,73 @@
+#ifndef _CAN_DISPATCH_H_
+#define _CAN_DISPATCH_H_
+
+#include <vector>
+#include "../../devboard/utils/types.h"
+#include "CanReceiver.h"
+#include "comm_can.h"
+
+// Battery (up to three), inverter, charger and shunt can all share a single interface
+#define CAN_MAX_RECEIVERS_PER_INTERFACE 6
+
+typedef struct {
+  CanReceiver* receiver = nullptr;
+  CAN_Speed speed = CAN_Speed::CAN_SPEED_500KBPS;
+  CAN_ID_Filter filter;
+  /** Frames accepted by the filter and handed to the receiver */
+  uint32_t hits = 0;
+  /** Frames dropped by the filter before reaching the receiver */
+  uint32_t misses = 0;
+} CAN_Dispatch_Entry;
+
+// Fixed-size receiver list for one interface. Entries are kept in registration order.
+typedef struct {
+  uint8_t count = 0;
+  CAN_Dispatch_Entry entries[CAN_MAX_RECEIVERS_PER_INTERFACE];
+} CAN_Dispatch_Table;
+
+extern CAN_Dispatch_Table can_dispatch_tables[NO_CAN_INTERFACE];
+
+// Add a receiver to the table of the given interface. Returns false if the table is full.
+bool can_dispatch_add(CanReceiver* receiver, CAN_Interface interface, CAN_Speed speed, const CAN_ID_Filter& filter);
+
+// Remove all receivers from all interfaces
+void can_dispatch_clear();
+
+// Union of the CAN IDs handled by all receivers on the interface, sorted and without duplicates.
+// Returns an empty list if the interface has no receivers or any receiver needs every frame.
+std::vector<uint32_t> can_dispatch_handled_ids(CAN_Interface interface);
+
+// Reduce a list of IDs to at most max_filters code/mask filters that together accept every listed ID,
+// merging the groups that add the fewest unwanted IDs first. Returns the amount of filters written to out,
+// or 0 if the list is empty or mixes standard and extended IDs (accept everything in that case).
+uint8_t can_compute_acceptance_filters(const std::vector<uint32_t>& ids, CAN_ID_Filter* out, uint8_t max_filters);
+
+static inline bool can_dispatch_has_receivers(CAN_Interface interface) {
+  return can_dispatch_tables[interface].count > 0;
+}
+
+// Speed requested by the first receiver registered on the interface
+static inline CAN_Speed can_dispatch_speed(CAN_Interface interface) {
+  return can_dispatch_tables[interface].entries[0].speed;
+}
+
+static inline bool can_id_filter_accepts(const CAN_ID_Filter& filter, uint32_t id, bool ext_ID) {
+  return ((id ^ filter.code) & filter.mask) == 0 && id >= filter.min_id && id <= filter.max_id &&
+         (filter.format == CAN_ID_Format::ANY || (filter.format == CAN_ID_Format::EXTENDED) == ext_ID);
+}
+
+// Hand a received frame to every receiver on the interface whose filter accepts it
+static inline void can_dispatch_frame(const CAN_frame& rx_frame, CAN_Interface interface) {
+  CAN_Dispatch_Table& table = can_dispatch_tables[interface];
+  for (uint8_t i = 0; i < table.count; i++) {
+    CAN_Dispatch_Entry& entry = table.entries[i];
+    if (can_id_filter_accepts(entry.filter, rx_frame.ID, rx_frame.ext_ID)) {
+      entry.hits++;
+      entry.receiver->receive_can_frame(rx_frame);
+    } else {
+      entry.misses++;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,216 @@
+#include "can_replay.h"
+
+#include <string.h>
+
+CanReplayLog can_replay_log;
+CAN_Replay_Statistics can_replay_statistics;
+
+static inline int hex_value(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  c |= 0x20;
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+static inline void skip_spaces(const char*& p, const char* end) {
+  while (p < end && (*p == ' ' || *p == '\t')) {
+    p++;
+  }
+}
+
+bool can_replay_parse_line(const char* line, size_t length, uint64_t& timestamp_us, CAN_frame& frame) {
+  const char* p = line;
+  const char* end = line + length;
+
+  // Timestamp "(seconds.fraction)", parsed as integers so microseconds survive large second counts
+  skip_spaces(p, end);
+  if (p == end || *p++ != '(') {
+    return false;
+  }
+  uint64_t seconds = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    seconds = seconds * 10 + (*p++ - '0');
+  }
+  uint32_t micros = 0;
+  if (p < end && *p == '.') {
+    p++;
+    uint32_t scale = 100000;
+    while (p < end && *p >= '0' && *p <= '9') {
+      micros += (*p++ - '0') * scale;
+      scale /= 10;
+    }
+  }
+  if (p == end || *p++ != ')') {
+    return false;
+  }
+  timestamp_us = seconds * 1000000 + micros;
+
+  // Bus name, the replay interface is selected on the webserver instead
+  skip_spaces(p, end);
+  while (p < end && *p != ' ' && *p != '\t') {
+    p++;
+  }
+  skip_spaces(p, end);
+
+  // Identifier
+  uint32_t id = 0;
+  int digits = 0;
+  for (int value; p < end && (value = hex_value(*p)) >= 0; p++, digits++) {
+    id = (id << 4) | value;
+  }
+  // The width of the ID marks the frame format, as in candump: 3 digits for standard and 8 for extended frames.
+  // Logs of older firmware wrote IDs without padding, there 4 to 7 digits can only be an extended ID above 0x7FF.
+  const bool extended = digits > 3;
+  if (digits == 0 || digits > 8 || id > 0x1FFFFFFF || (extended && digits < 8 && id <= 0x7FF)) {
+    return false;
+  }
+
+  // Length "[8]"
+  skip_spaces(p, end);
+  if (p == end || *p++ != '[') {
+    return false;
+  }
+  uint32_t dlc = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    dlc = dlc * 10 + (*p++ - '0');
+  }
+  if (p == end || *p++ != ']' || dlc > 64) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < dlc; i++) {
+    skip_spaces(p, end);
+    if (end - p < 2 || hex_value(p[0]) < 0 || hex_value(p[1]) < 0) {
+      return false;
+    }
+    frame.data.u8[i] = (hex_value(p[0]) << 4) | hex_value(p[1]);
+    p += 2;
+  }
+
+  frame.ID = id;
+  frame.DLC = dlc;
+  frame.ext_ID = extended;
+  frame.FD = dlc > 8;
+  return true;
+}
+
+void CanReplayLog::clear() {
+  frames.clear();
+  frames.shrink_to_fit();
+  payload.clear();
+  payload.shrink_to_fit();
+  line_length = 0;
+  line_overflow = false;
+  previous_timestamp_us = 0;
+  have_timestamp = false;
+  skipped = 0;
+  dropped = 0;
+  bounded = false;
+}
+
+void CanReplayLog::reserve_for_upload(size_t upload_bytes) {
+  frames.reserve(upload_bytes / CAN_REPLAY_MIN_FRAME_LINE);
+  payload.reserve(upload_bytes / CAN_REPLAY_TEXT_PER_DATA_BYTE);
+  bounded = true;
+}
+
+void CanReplayLog::add_line(const char* text, size_t length) {
+  while (length > 0 && (text[length - 1] == '\r' || text[length - 1] == ' ')) {
+    length--;
+  }
+  if (length == 0) {
+    return;
+  }
+
+  uint64_t timestamp_us;
+  CAN_frame frame;
+  if (!can_replay_parse_line(text, length, timestamp_us, frame)) {
+    skipped++;
+    return;
+  }
+
+  // Logs glued together may jump back in time, replay those frames back to back
+  uint64_t delta_us = have_timestamp && timestamp_us > previous_timestamp_us ? timestamp_us - previous_timestamp_us : 0;
+  previous_timestamp_us = timestamp_us;
+  have_timestamp = true;
+
+  if (bounded && (frames.size() == frames.capacity() || payload.capacity() - payload.size() < frame.DLC)) {
+    dropped++;
+    return;
+  }
+
+  CAN_Replay_Frame stored;
+  stored.delta_us = delta_us > UINT32_MAX ? UINT32_MAX : delta_us;
+  stored.id = frame.ID;
+  stored.data_offset = payload.size();
+  stored.dlc = frame.DLC;
+  stored.flags = (frame.ext_ID ? CAN_REPLAY_FLAG_EXT : 0) | (frame.FD ? CAN_REPLAY_FLAG_FD : 0);
+  frames.push_back(stored);
+  payload.insert(payload.end(), frame.data.u8, frame.data.u8 + frame.DLC);
+}
+
+void CanReplayLog::feed(const uint8_t* data, size_t length) {
+  const char* p = (const char*)data;
+  const char* end = p + length;
+
+  while (p < end) {
+    const char* newline = (const char*)memchr(p, '\n', end - p);
+    const char* chunk_end = newline ? newline : end;
+    size_t chunk = chunk_end - p;
+
+    if (line_length + chunk > sizeof(line)) {
+      line_overflow = true;  // Too long to be a frame, drop the whole line
+    } else {
+      memcpy(line + line_length, p, chunk);
+      line_length += chunk;
+    }
+    p = chunk_end;
+
+    if (newline) {
+      if (line_overflow) {
+        skipped++;
+      } else {
+        add_line(line, line_length);
+      }
+      line_length = 0;
+      line_overflow = false;
+      p++;
+    }
+  }
+}
+
+void CanReplayLog::finish() {
+  if (line_overflow) {
+    skipped++;
+  } else if (line_length > 0) {
+    add_line(line, line_length);
+  }
+  line_length = 0;
+  line_overflow = false;
+  frames.shrink_to_fit();
+  payload.shrink_to_fit();
+}
+
+uint32_t CanReplayLog::frame(size_t index, CAN_frame& out) const {
+  const CAN_Replay_Frame& stored = frames[index];
+  out.ID = stored.id;
+  out.DLC = stored.dlc;
+  out.ext_ID = stored.flags & CAN_REPLAY_FLAG_EXT;
+  out.FD = stored.flags & CAN_REPLAY_FLAG_FD;
+  memcpy(out.data.u8, payload.data() + stored.data_offset, stored.dlc);
+  return stored.delta_us;
+}
+
+void can_replay_record_interval(CAN_Replay_Statistics& stats, int64_t intended_us, int64_t achieved_us) {
+  int64_t jitter = achieved_us - intended_us;
+  uint32_t jitter_us = jitter < 0 ? -jitter : jitter;
+  stats.intervals++;
+  stats.jitter_sum_us += jitter_us;
+  if (jitter_us > stats.max_jitter_us) {
+    stats.max_jitter_us = jitter_us;
+  }
+}
@@ -0,0 +1,126 @@
+#ifndef _CAN_REPLAY_H_
+#define _CAN_REPLAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "../../devboard/utils/types.h"
+
+#define CAN_REPLAY_FLAG_EXT 0x01
+#define CAN_REPLAY_FLAG_FD 0x02
+
+// Longest log line accepted, fits a CAN FD frame with 64 data bytes
+#define CAN_REPLAY_LINE_MAX 320
+
+// Shortest line the CAN log exports write for a frame, "(0.000) RX0 1 [0]" and the newline, and the text taken by
+// every data byte. Together they bound the memory the frames of an upload can need.
+#define CAN_REPLAY_MIN_FRAME_LINE 18
+#define CAN_REPLAY_TEXT_PER_DATA_BYTE 3
+
+// Waits shorter than this are not worth arming a timer for, the frame is sent right away
+#define CAN_REPLAY_MIN_TIMER_US 100
+
+// Pre-decoded frame of an uploaded log. The data bytes live in a shared pool so classic CAN frames stay small.
+typedef struct {
+  /** Time since the previous frame in the log, in microseconds */
+  uint32_t delta_us;
+  /** CAN identifier */
+  uint32_t id;
+  /** Offset of the data bytes in the payload pool */
+  uint32_t data_offset;
+  /** Payload length in bytes */
+  uint8_t dlc;
+  /** CAN_REPLAY_FLAG_* bits */
+  uint8_t flags;
+} CAN_Replay_Frame;
+
+typedef struct {
+  /** Frames sent since the replay was started, over all loops */
+  uint32_t frames_sent = 0;
+  /** Completed passes through the log */
+  uint32_t loops = 0;
+  /** Inter-frame intervals measured */
+  uint32_t intervals = 0;
+  /** Sum of |achieved - intended| inter-frame interval, in microseconds */
+  uint64_t jitter_sum_us = 0;
+  /** Largest |achieved - intended| inter-frame interval, in microseconds */
+  uint32_t max_jitter_us = 0;
+  /** Largest delay of a frame behind its deadline, in microseconds */
+  uint32_t max_lateness_us = 0;
+} CAN_Replay_Statistics;
+
+// Uploaded CAN log, parsed while the upload chunks arrive. Lines are in the format of the webserver CAN log
+// export and the SD card CAN log: "(seconds.fraction) RX0 1AB [8] 01 02 03 04 05 06 07 08"
+class CanReplayLog {
+ public:
+  void clear();
+
+  // Memory for the frames of an upload of upload_bytes, at most
+  static size_t bytes_for_upload(size_t upload_bytes) {
+    return upload_bytes / CAN_REPLAY_MIN_FRAME_LINE * sizeof(CAN_Replay_Frame) +
+           upload_bytes / CAN_REPLAY_TEXT_PER_DATA_BYTE;
+  }
+
+  // Reserve bytes_for_upload() up front, so parsing never has to grow the buffers. Frames that still do not fit,
+  // from lines shorter than the exports write, are dropped and counted.
+  void reserve_for_upload(size_t upload_bytes);
+
+  // Parse a chunk of the upload. Lines may be split over chunks at any point.
+  void feed(const uint8_t* data, size_t length);
+
+  // Parse the last line if the upload did not end with a newline
+  void finish();
+
+  size_t size() const { return frames.size(); }
+  bool empty() const { return frames.empty(); }
+
+  // Lines that did not hold a frame
+  uint32_t skipped_lines() const { return skipped; }
+
+  // Frames that did not fit into the reservation of reserve_for_upload()
+  uint32_t dropped_frames() const { return dropped; }
+
+  // Bytes used by the decoded frames
+  size_t memory_used() const {
+    return frames.capacity() * sizeof(CAN_Replay_Frame) + payload.capacity() + sizeof(*this);
+  }
+
+  // Decode a stored frame, returns the time since the previous frame in microseconds
+  uint32_t frame(size_t index, CAN_frame& out) const;
+
+ private:
+  void add_line(const char* line, size_t length);
+
+  std::vector<CAN_Replay_Frame> frames;
+  std::vector<uint8_t> payload;
+  char line[CAN_REPLAY_LINE_MAX];
+  size_t line_length = 0;
+  bool line_overflow = false;
+  uint64_t previous_timestamp_us = 0;
+  bool have_timestamp = false;
+  uint32_t skipped = 0;
+  uint32_t dropped = 0;
+  /** Set by reserve_for_upload(), the buffers do not grow beyond their reservation */
+  bool bounded = false;
+};
+
+// Parse a single log line into a frame and its timestamp. Returns false if the line holds no frame. The frame is
+// extended if its ID is written with more than 3 hex digits.
+bool can_replay_parse_line(const char* line, size_t length, uint64_t& timestamp_us, CAN_frame& frame);
+
+// Time offset at which a frame logged elapsed_us after the first one is due when replaying at speed_percent
+static inline uint64_t can_replay_scaled_us(uint64_t elapsed_us, uint16_t speed_percent) {
+  return speed_percent == 0 ? elapsed_us : elapsed_us * 100 / speed_percent;
+}
+
+// Account one inter-frame interval, as intended by the log (already scaled) and as achieved on the bus
+void can_replay_record_interval(CAN_Replay_Statistics& stats, int64_t intended_us, int64_t achieved_us);
+
+static inline uint32_t can_replay_mean_jitter_us(const CAN_Replay_Statistics& stats) {
+  return stats.intervals == 0 ? 0 : stats.jitter_sum_us / stats.intervals;
+}
+
+extern CanReplayLog can_replay_log;
+extern CAN_Replay_Statistics can_replay_statistics;
+
+#endif
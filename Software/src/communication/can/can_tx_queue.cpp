@@ -0,0 +1,176 @@
+#include "can_tx_queue.h"
+
+#include <string.h>
+
+CanTxQueue* can_tx_queues[NO_CAN_INTERFACE] = {nullptr};
+
+const char* can_tx_priority_name(CAN_Tx_Priority priority) {
+  switch (priority) {
+    case CAN_TX_SAFETY:
+      return "safety";
+    case CAN_TX_LIMITS:
+      return "limits";
+    case CAN_TX_KEEPALIVE:
+      return "keepalive";
+    case CAN_TX_DIAGNOSTIC:
+      return "diagnostic";
+    default:
+      return "unknown";
+  }
+}
+
+CAN_Tx_Priority can_tx_priority_for(const CAN_frame& frame, CAN_Tx_Priority sender_class) {
+  // 11-bit requests go to 0x7DF (functional) or 0x7E0-0x7E7 (physical), 29-bit ones to 0x18DBxxxx / 0x18DAxxxx.
+  // Other IDs in the 0x700 range are vendor frames, e.g. Tesla's 0x7FF, and keep the class of their sender.
+  if ((!frame.ext_ID && (frame.ID == 0x7DF || (frame.ID >= 0x7E0 && frame.ID <= 0x7E7))) ||
+      (frame.ext_ID && (frame.ID & 0x1FFE0000) == 0x18DA0000)) {
+    return CAN_TX_DIAGNOSTIC;
+  }
+  return sender_class;
+}
+
+CanTxQueue::CanTxQueue() {
+  static const uint8_t sizes[CAN_TX_PRIORITY_COUNT] = {CAN_TX_DEPTH_SAFETY, CAN_TX_DEPTH_LIMITS,
+                                                       CAN_TX_DEPTH_KEEPALIVE, CAN_TX_DEPTH_DIAGNOSTIC};
+  uint8_t offset = 0;
+  for (uint8_t c = 0; c < CAN_TX_PRIORITY_COUNT; c++) {
+    rings[c].offset = offset;
+    rings[c].size = sizes[c];
+    offset += sizes[c];
+  }
+  draining = false;
+#ifndef UNIT_TEST
+  portMUX_INITIALIZE(&mux);
+#endif
+  clear();
+  stats.frames_sent = 0;
+  for (auto& dropped : stats.dropped) {
+    dropped = 0;
+  }
+  stats.depth_peak = 0;
+  latency_histogram_reset(stats.latency);
+}
+
+void CanTxQueue::lock() {
+#ifdef UNIT_TEST
+  mutex.lock();
+#else
+  portENTER_CRITICAL(&mux);
+#endif
+}
+
+void CanTxQueue::unlock() {
+#ifdef UNIT_TEST
+  mutex.unlock();
+#else
+  portEXIT_CRITICAL(&mux);
+#endif
+}
+
+void CanTxQueue::clear() {
+  lock();
+  for (auto& ring : rings) {
+    ring.head = 0;
+    ring.count = 0;
+  }
+  unlock();
+}
+
+uint16_t CanTxQueue::depth() {
+  lock();
+  uint16_t total = waiting();
+  unlock();
+  return total;
+}
+
+uint16_t CanTxQueue::waiting() const {
+  uint16_t total = 0;
+  for (const auto& ring : rings) {
+    total += ring.count;
+  }
+  return total;
+}
+
+bool CanTxQueue::push(const CAN_frame& frame, CAN_Tx_Priority priority, uint32_t now_us) {
+  if (priority >= CAN_TX_PRIORITY_COUNT) {
+    priority = CAN_TX_KEEPALIVE;
+  }
+  lock();
+  Ring& ring = rings[priority];
+  bool dropped = false;
+  if (ring.count == ring.size) {
+    // The newest value of a periodic frame is worth more than the oldest one
+    ring.head = (ring.head + 1) % ring.size;
+    ring.count--;
+    stats.dropped[priority]++;
+    dropped = true;
+  }
+
+  Entry& entry = entries[ring.offset + (ring.head + ring.count) % ring.size];
+  entry.frame.FD = frame.FD;
+  entry.frame.ext_ID = frame.ext_ID;
+  entry.frame.DLC = frame.DLC;
+  entry.frame.ID = frame.ID;
+  memcpy(entry.frame.data.u8, frame.data.u8, frame.DLC <= sizeof(frame.data.u8) ? frame.DLC : sizeof(frame.data.u8));
+  entry.queued_us = now_us;
+  ring.count++;
+
+  uint16_t total = waiting();
+  if (total > stats.depth_peak) {
+    stats.depth_peak = total;
+  }
+  unlock();
+  return !dropped;
+}
+
+bool CanTxQueue::begin_drain() {
+  lock();
+  bool claimed = !draining;
+  draining = true;
+  unlock();
+  return claimed;
+}
+
+void CanTxQueue::end_drain() {
+  lock();
+  draining = false;
+  unlock();
+}
+
+bool CanTxQueue::take(Entry& entry, uint8_t& priority) {
+  lock();
+  for (uint8_t c = 0; c < CAN_TX_PRIORITY_COUNT; c++) {
+    Ring& ring = rings[c];
+    if (ring.count > 0) {
+      entry = entries[ring.offset + ring.head];
+      ring.head = (ring.head + 1) % ring.size;
+      ring.count--;
+      priority = c;
+      unlock();
+      return true;
+    }
+  }
+  unlock();
+  return false;
+}
+
+void CanTxQueue::put_back(const Entry& entry, uint8_t priority) {
+  lock();
+  Ring& ring = rings[priority];
+  if (ring.count == ring.size) {
+    // The class filled up while the frame was out, it is the oldest one so it makes way
+    stats.dropped[priority]++;
+  } else {
+    ring.head = (ring.head + ring.size - 1) % ring.size;
+    ring.count++;
+    entries[ring.offset + ring.head] = entry;
+  }
+  unlock();
+}
+
+void CanTxQueue::count_sent(const Entry& entry, uint32_t now_us) {
+  lock();
+  latency_histogram_record(stats.latency, (int64_t)(now_us - entry.queued_us));
+  stats.frames_sent++;
+  unlock();
+}
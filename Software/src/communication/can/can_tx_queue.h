@@ -0,0 +1,129 @@
+#ifndef _CAN_TX_QUEUE_H_
+#define _CAN_TX_QUEUE_H_
+
+#include <stdint.h>
+#include "../../devboard/utils/latency_histogram.h"
+#include "../../devboard/utils/types.h"
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#endif
+
+// Priority classes of transmitted frames, lower values are sent first
+enum CAN_Tx_Priority : uint8_t {
+  CAN_TX_SAFETY,      // Contactor and other safety related commands
+  CAN_TX_LIMITS,      // Limits and values reported to the inverter
+  CAN_TX_KEEPALIVE,   // Periodic frames keeping the other side awake
+  CAN_TX_DIAGNOSTIC,  // UDS / OBD requests
+  CAN_TX_PRIORITY_COUNT,
+  // Diagnostic requests by ID, otherwise the class of the sender, see can_tx_priority_for()
+  CAN_TX_PRIORITY_AUTO = CAN_TX_PRIORITY_COUNT
+};
+
+// Frames queued per class before the oldest frame of that class is dropped
+#define CAN_TX_DEPTH_SAFETY 8
+#define CAN_TX_DEPTH_LIMITS 16
+#define CAN_TX_DEPTH_KEEPALIVE 16
+#define CAN_TX_DEPTH_DIAGNOSTIC 8
+
+// Transmit statistics per CAN interface
+typedef struct {
+  /** Frames accepted by the controller since boot */
+  uint32_t frames_sent;
+  /** Frames dropped per priority class because the queue of that class was full */
+  uint32_t dropped[CAN_TX_PRIORITY_COUNT];
+  /** Highest amount of frames waiting at once since boot */
+  uint16_t depth_peak;
+  /** Time from queueing a frame until the controller accepted it */
+  Latency_Histogram latency;
+} CAN_TX_Statistics;
+
+const char* can_tx_priority_name(CAN_Tx_Priority priority);
+
+// Class of a frame sent without one: UDS / OBD requests by ID, everything else gets the class of its sender,
+// limits for inverter protocols and keep-alive for batteries and the rest. Safety frames are marked by the sender.
+CAN_Tx_Priority can_tx_priority_for(const CAN_frame& frame, CAN_Tx_Priority sender_class);
+
+// Software transmit queue of one CAN interface. Frames are kept per priority class and handed to the
+// controller highest class first, as far as it has room for them. Frames that do not fit wait for the
+// next drain instead of being lost, and when a class overflows its oldest frame makes way.
+//
+// The core task and the CAN replay task both push and drain. The queue itself is only changed in a short
+// critical section, frames are handed to the controller outside of it, and only one task drains at a time.
+class CanTxQueue {
+ public:
+  CanTxQueue();
+
+  // Returns false if the oldest frame of the class was dropped to make room
+  bool push(const CAN_frame& frame, CAN_Tx_Priority priority, uint32_t now_us);
+
+  // Call send(frame) for queued frames, highest class first, until it returns false or the queue is empty.
+  // Returns the amount of frames sent. Returns 0 right away while another task is draining, the frames
+  // then go out with its drain or the next one.
+  template <typename Send>
+  uint16_t drain(Send send, uint32_t now_us) {
+    if (!begin_drain()) {
+      return 0;
+    }
+    uint16_t sent = 0;
+    Entry entry;
+    uint8_t priority;
+    while (take(entry, priority)) {
+      if (!send(entry.frame)) {
+        put_back(entry, priority);  // Controller is full, keep the rest for the next drain
+        break;
+      }
+      count_sent(entry, now_us);
+      sent++;
+    }
+    end_drain();
+    return sent;
+  }
+
+  void clear();
+  uint16_t depth();
+  uint16_t depth(CAN_Tx_Priority priority) const { return rings[priority].count; }
+  const CAN_TX_Statistics& statistics() const { return stats; }
+
+ private:
+  typedef struct {
+    CAN_frame frame;
+    uint32_t queued_us;
+  } Entry;
+
+  typedef struct {
+    uint8_t offset;
+    uint8_t size;
+    uint8_t head;
+    uint8_t count;
+  } Ring;
+
+  void lock();
+  void unlock();
+  uint16_t waiting() const;
+  bool begin_drain();
+  void end_drain();
+  // Remove the first frame of the highest class that has one
+  bool take(Entry& entry, uint8_t& priority);
+  // Return a frame the controller had no room for to the front of its class
+  void put_back(const Entry& entry, uint8_t priority);
+  void count_sent(const Entry& entry, uint32_t now_us);
+
+  Entry entries[CAN_TX_DEPTH_SAFETY + CAN_TX_DEPTH_LIMITS + CAN_TX_DEPTH_KEEPALIVE + CAN_TX_DEPTH_DIAGNOSTIC];
+  Ring rings[CAN_TX_PRIORITY_COUNT];
+  CAN_TX_Statistics stats;
+  bool draining;
+#ifdef UNIT_TEST
+  std::mutex mutex;
+#else
+  portMUX_TYPE mux;
+#endif
+};
+
+// Queues of the interfaces set up by init_CAN(), nullptr for the others. CANFD_NATIVE and CANFD_ADDON_MCP2518
+// both send through the same controller and share one queue.
+extern CanTxQueue* can_tx_queues[NO_CAN_INTERFACE];
+
+#endif
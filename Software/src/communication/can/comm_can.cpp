@@ -3,17 +3,18 @@
 #include "../../lib/pierremolinaro-ACAN2517FD/ACAN2517FD.h"
 #include "../../lib/pierremolinaro-acan-esp32/ACAN_ESP32.h"
 #include "CanReceiver.h"
+#include "can_dispatch.h"
 #include "comm_can.h"
 #include "src/datalayer/datalayer.h"
 #include "src/devboard/safety/safety.h"
 #include "src/devboard/sdcard/sdcard.h"
+#include "src/devboard/utils/log_ring.h"
 #include "src/devboard/utils/logging.h"
 #include "utils.h"
 
 #include <esp_private/periph_ctrl.h>
 
 #include <algorithm>
-#include <map>
 
 // The spare ESP32 SPI buses are called HSPI and VSPI, whereas on a ESP32S3
 // they are called FSPI and HSPI.
@@ -32,23 +33,22 @@ volatile CAN_Configuration can_config = {.battery = CAN_NATIVE,
                                          .charger = CAN_NATIVE,
                                          .shunt = CAN_NATIVE};
 
-struct CanReceiverRegistration {
-  CanReceiver* receiver;
-  CAN_Speed speed;
-};
+void map_can_frame_to_variable(const CAN_frame& rx_frame, CAN_Interface interface);
 
-static std::multimap<CAN_Interface, CanReceiverRegistration> can_receivers;
-
-void map_can_frame_to_variable(CAN_frame* rx_frame, CAN_Interface interface);
-
-void register_can_receiver(CanReceiver* receiver, CAN_Interface interface, CAN_Speed speed) {
-  can_receivers.insert({interface, {receiver, speed}});
-  DEBUG_PRINTF("CAN receiver registered, total: %d\n", can_receivers.size());
+void register_can_receiver(CanReceiver* receiver, CAN_Interface interface, CAN_Speed speed,
+                           const CAN_ID_Filter& filter) {
+  if (!can_dispatch_add(receiver, interface, speed, filter)) {
+    logging.printf("Too many CAN receivers on %s, receiver ignored\n", getCANInterfaceName(interface));
+    return;
+  }
+  DEBUG_PRINTF("CAN receiver registered on %s, total: %d\n", getCANInterfaceName(interface),
+               can_dispatch_tables[interface].count);
 }
 
 uint32_t init_native_can(CAN_Speed speed, gpio_num_t tx_pin, gpio_num_t rx_pin);
 
 static ACAN_ESP32_Settings* settingsespcan = nullptr;
+static ACAN_ESP32_Filter native_filter = ACAN_ESP32_Filter::acceptAll();
 
 static uint32_t quartz_frequency;
 uint8_t user_selected_can_addon_crystal_frequency_mhz = 0;
@@ -61,25 +61,118 @@ static SPIClass SPI2517(SPI2517_BUS);
 uint8_t user_selected_canfd_addon_crystal_frequency_mhz = 0;
 static ACAN2517FD* canfd;
 static ACAN2517FDSettings* settings2517;
+static ACAN2517FDFilters* filters2517;
 static ACAN2517FD* canfd_2;
 static ACAN2517FDSettings* settings2517_2;
 bool use_canfd_as_can = false;
 static bool native_can_initialized = false;
 //CAN logging filter settings
 uint16_t user_selected_CAN_ID_cutoff_filter = 0;  //Messages below this ID will not be logged in webserver
+//Amount of frames drained from the native CAN driver buffer per core_loop iteration
+uint8_t user_selected_can_native_rx_burst = CAN_RX_BURST_DEFAULT;
+//Program the CAN controller acceptance filters from the IDs the receivers handle
+bool user_selected_can_hardware_filters = true;
+
+CAN_RX_Statistics can_rx_statistics[NO_CAN_INTERFACE];
+
+static void update_can_rx_statistics(CAN_Interface interface, uint16_t frames, bool budget_exhausted) {
+  CAN_RX_Statistics& stats = can_rx_statistics[interface];
+  stats.frames_received += frames;
+  stats.frames_last_tick = frames;
+  if (frames > stats.frames_max_tick) {
+    stats.frames_max_tick = frames;
+  }
+  if (budget_exhausted) {
+    stats.budget_exhausted_count++;
+  }
+}
+
+// Add the IDs handled on an interface to ids. Returns false if the interface needs every frame.
+static bool collect_handled_can_ids(CAN_Interface interface, std::vector<uint32_t>& ids) {
+  if (!can_dispatch_has_receivers(interface)) {
+    return true;
+  }
+  auto handled = can_dispatch_handled_ids(interface);
+  if (handled.empty()) {
+    return false;
+  }
+  ids.insert(ids.end(), handled.begin(), handled.end());
+  return true;
+}
+
+// The ESP32 TWAI controller has a single acceptance filter, usable as one or two (standard IDs only) mask groups
+static ACAN_ESP32_Filter native_acceptance_filter() {
+  std::vector<uint32_t> ids;
+  if (!user_selected_can_hardware_filters || !collect_handled_can_ids(CAN_NATIVE, ids)) {
+    return ACAN_ESP32_Filter::acceptAll();
+  }
+
+  CAN_ID_Filter groups[2];
+  const bool extended = !ids.empty() && ids.back() > 0x7FF;
+  const uint8_t count = can_compute_acceptance_filters(ids, groups, extended ? 1 : 2);
+  if (count == 0) {
+    return ACAN_ESP32_Filter::acceptAll();
+  }
+
+  logging.printf("Native CAN hardware filter: %d IDs in %d group(s)\n", (int)ids.size(), count);
+  if (extended) {
+    return ACAN_ESP32_Filter::singleExtendedFilter(ACAN_ESP32_Filter::data, groups[0].code,
+                                                   ~groups[0].mask & 0x1FFFFFFF);
+  }
+  if (count == 1) {
+    return ACAN_ESP32_Filter::singleStandardFilter(ACAN_ESP32_Filter::data, groups[0].code, ~groups[0].mask & 0x7FF);
+  }
+  return ACAN_ESP32_Filter::dualStandardFilter(ACAN_ESP32_Filter::data, groups[0].code, ~groups[0].mask & 0x7FF,
+                                               ACAN_ESP32_Filter::data, groups[1].code, ~groups[1].mask & 0x7FF);
+}
+
+// The MCP2517/2518FD has 32 filters, each with its own mask
+static ACAN2517FDFilters* mcp2518_acceptance_filters(CAN_Interface first, CAN_Interface second) {
+  auto* filters = new ACAN2517FDFilters();
+  std::vector<uint32_t> ids;
+  CAN_ID_Filter groups[32];
+  uint8_t count = 0;
+  if (user_selected_can_hardware_filters && collect_handled_can_ids(first, ids) &&
+      collect_handled_can_ids(second, ids)) {
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    count = can_compute_acceptance_filters(ids, groups, 32);
+  }
+
+  if (count == 0) {
+    filters->appendPassAllFilter(NULL);
+    return filters;
+  }
+
+  logging.printf("CAN-FD hardware filters: %d IDs in %d group(s)\n", (int)ids.size(), count);
+  const tFrameFormat format = (ids.back() > 0x7FF) ? kExtended : kStandard;
+  for (uint8_t i = 0; i < count; i++) {
+    filters->appendFilter(format, groups[i].mask, groups[i].code, NULL);
+  }
+  return filters;
+}
 
 bool init_CAN() {
   // Native CAN (onboard the ESP32)
 
-  auto nativeIt = can_receivers.find(CAN_NATIVE);
-
   if (user_selected_can_addon_crystal_frequency_mhz > 0) {
     quartz_frequency = user_selected_can_addon_crystal_frequency_mhz * 1000000UL;
   } else {
     quartz_frequency = CRYSTAL_FREQUENCY_MHZ * 1000000UL;
   }
 
-  if (nativeIt != can_receivers.end()) {
+  // Transmit queues of the interfaces in use, before any task can send on them. The native CAN-FD port is driven by
+  // the same MCP2518 as the add-on, so both use the add-on's queue.
+  for (uint8_t i = 0; i < NO_CAN_INTERFACE; i++) {
+    const bool used = can_dispatch_has_receivers((CAN_Interface)i) ||
+                      (i == CANFD_ADDON_MCP2518 && can_dispatch_has_receivers(CANFD_NATIVE));
+    if (i != CANFD_NATIVE && can_tx_queues[i] == nullptr && used) {
+      can_tx_queues[i] = new CanTxQueue();
+    }
+  }
+  can_tx_queues[CANFD_NATIVE] = can_tx_queues[CANFD_ADDON_MCP2518];
+
+  if (can_dispatch_has_receivers(CAN_NATIVE)) {
     auto se_pin = esp32hal->CAN_SE_PIN();
     auto tx_pin = esp32hal->CAN_TX_PIN();
     auto rx_pin = esp32hal->CAN_RX_PIN();
@@ -96,7 +189,8 @@ bool init_CAN() {
       return false;
     }
 
-    const uint32_t errorCode = init_native_can(nativeIt->second.speed, tx_pin, rx_pin);
+    native_filter = native_acceptance_filter();
+    const uint32_t errorCode = init_native_can(can_dispatch_speed(CAN_NATIVE), tx_pin, rx_pin);
     if (errorCode == 0) {
       native_can_initialized = true;
       logging.println("Native Can ok");
@@ -127,8 +221,7 @@ bool init_CAN() {
 
   // Add-on CAN interface (via MCP2515)
 
-  auto addonIt = can_receivers.find(CAN_ADDON_MCP2515);
-  if (addonIt != can_receivers.end()) {
+  if (can_dispatch_has_receivers(CAN_ADDON_MCP2515)) {
     auto cs_pin = esp32hal->MCP2515_CS();
     auto int_pin = esp32hal->MCP2515_INT();
     auto sck_pin = esp32hal->MCP2515_SCK();
@@ -154,7 +247,7 @@ bool init_CAN() {
 
     SPI2515.begin(sck_pin, miso_pin, mosi_pin);
     can2515 = new MCP2515_Lite(SPI2515, cs_pin, int_pin);
-    if (can2515->begin({(int)addonIt->second.speed * 1000UL, quartz_frequency})) {
+    if (can2515->begin({(int)can_dispatch_speed(CAN_ADDON_MCP2515) * 1000UL, quartz_frequency})) {
       logging.println("MCP2515 CAN ok");
     } else {
       logging.println("MCP2515 CAN init failed");
@@ -165,9 +258,9 @@ bool init_CAN() {
 
   // FD interface(s) (via MCP2518FD)
 
-  auto fdNativeIt = can_receivers.find(CANFD_NATIVE);
-  auto fdAddonIt = can_receivers.find(CANFD_ADDON_MCP2518);
-  auto fdAddonIt_2 = can_receivers.find(CANFD_ADDON_MCP2518_2);
+  const bool fdNative = can_dispatch_has_receivers(CANFD_NATIVE);
+  const bool fdAddon = can_dispatch_has_receivers(CANFD_ADDON_MCP2518);
+  const bool fdAddon_2 = can_dispatch_has_receivers(CANFD_ADDON_MCP2518_2);
 
   if (user_selected_canfd_addon_crystal_frequency_mhz == 20) {
     quartz_fd_frequency = ACAN2517FDSettings::OSC_20MHz;
@@ -177,7 +270,7 @@ bool init_CAN() {
     quartz_fd_frequency = ACAN2517FDSettings::OSC_40MHz;
   }
 
-  if (fdNativeIt != can_receivers.end() || fdAddonIt != can_receivers.end() || fdAddonIt_2 != can_receivers.end()) {
+  if (fdNative || fdAddon || fdAddon_2) {
     // Initialise SPI bus first
     auto sck_pin = esp32hal->MCP2517_SCK();
     auto sdo_pin = esp32hal->MCP2517_SDO();
@@ -190,9 +283,9 @@ bool init_CAN() {
     SPI2517.begin(sck_pin, sdo_pin, sdi_pin);
   }
 
-  if (fdNativeIt != can_receivers.end() || fdAddonIt != can_receivers.end()) {
+  if (fdNative || fdAddon) {
 
-    auto speed = (fdNativeIt != can_receivers.end()) ? fdNativeIt->second.speed : fdAddonIt->second.speed;
+    auto speed = fdNative ? can_dispatch_speed(CANFD_NATIVE) : can_dispatch_speed(CANFD_ADDON_MCP2518);
 
     auto cs_pin = esp32hal->MCP2517_CS();
     auto int_pin = esp32hal->MCP2517_INT();
@@ -213,7 +306,8 @@ bool init_CAN() {
     // ListenOnly / Normal20B / NormalFDs
     settings2517->mRequestedMode = use_canfd_as_can ? ACAN2517FDSettings::Normal20B : ACAN2517FDSettings::NormalFD;
 
-    const uint32_t errorCode2517 = canfd->begin(*settings2517, [] { canfd->isr(); });
+    filters2517 = mcp2518_acceptance_filters(CANFD_NATIVE, CANFD_ADDON_MCP2518);
+    const uint32_t errorCode2517 = canfd->begin(*settings2517, [] { canfd->isr(); }, *filters2517);
     canfd->poll();
     if (errorCode2517 == 0) {
       logging.print("Bit Rate prescaler: ");
@@ -240,7 +334,7 @@ bool init_CAN() {
     }
   }
 
-  if (fdAddonIt_2 != can_receivers.end()) {
+  if (fdAddon_2) {
 
     auto cs_pin = esp32hal->MCP2517_CS2();
     auto int_pin = esp32hal->MCP2517_INT2();
@@ -252,14 +346,16 @@ bool init_CAN() {
     canfd_2 = new ACAN2517FD(cs_pin, SPI2517, int_pin);
 
     logging.println("CAN FD add-on 2 (ESP32+MCP2517) selected");
-    auto speed = fdAddonIt_2->second.speed;
+    auto speed = can_dispatch_speed(CANFD_ADDON_MCP2518_2);
     auto bitRate = (int)speed * 1000UL;
     settings2517_2 = new ACAN2517FDSettings(quartz_fd_frequency, bitRate, DataBitRateFactor::x4);
     // Arbitration bit rate: 250/500 kbit/s, data bit rate: 1/2 Mbit/s
 
     settings2517_2->mRequestedMode = use_canfd_as_can ? ACAN2517FDSettings::Normal20B : ACAN2517FDSettings::NormalFD;
 
-    const uint32_t errorCode2517_2 = canfd_2->begin(*settings2517_2, [] { canfd_2->isr(); });
+    ACAN2517FDFilters* filters2517_2 = mcp2518_acceptance_filters(CANFD_ADDON_MCP2518_2, CANFD_ADDON_MCP2518_2);
+    const uint32_t errorCode2517_2 = canfd_2->begin(*settings2517_2, [] { canfd_2->isr(); }, *filters2517_2);
+    delete filters2517_2;
     canfd_2->poll();
     if (errorCode2517_2 != 0) {
       logging.print("CAN-FD 2 Configuration error 0x");
@@ -272,77 +368,98 @@ bool init_CAN() {
   return true;
 }
 
-void transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface) {
-  if (!allowed_to_send_CAN) {
-    return;
-  }
-  print_can_frame(*tx_frame, interface, frameDirection(MSG_TX));
-
-  if (datalayer.system.info.CAN_SD_logging_active) {
-    add_can_frame_to_buffer(*tx_frame, frameDirection(MSG_TX));
-  }
-
+// Hand a frame to the controller of an interface. Returns false if the controller has no room for it right now.
+static bool send_to_controller(const CAN_frame& tx_frame, CAN_Interface interface) {
   switch (interface) {
     case CAN_NATIVE: {
       CANMessage frame;
-      frame.id = tx_frame->ID;
-      frame.ext = tx_frame->ext_ID;
-      frame.len = tx_frame->DLC;
+      frame.id = tx_frame.ID;
+      frame.ext = tx_frame.ext_ID;
+      frame.len = tx_frame.DLC;
       for (uint8_t i = 0; i < frame.len; i++) {
-        frame.data[i] = tx_frame->data.u8[i];
-      }
-
-      if (!ACAN_ESP32::can.tryToSend(frame)) {
-        datalayer.system.info.can_native_send_fail = true;
+        frame.data[i] = tx_frame.data.u8[i];
       }
-    } break;
+      return ACAN_ESP32::can.tryToSend(frame);
+    }
     case CAN_ADDON_MCP2515: {
       MCP2515_Lite_Frame mcp2515_frame;
-      copy_can_frame_to_mcp2515_lite_frame(*tx_frame, mcp2515_frame);
-
-      if (!can2515->sendFrame(mcp2515_frame)) {
-        datalayer.system.info.can_2515_send_fail = true;
-      }
-    } break;
+      copy_can_frame_to_mcp2515_lite_frame(tx_frame, mcp2515_frame);
+      return can2515->sendFrame(mcp2515_frame);
+    }
     case CANFD_NATIVE:
-    case CANFD_ADDON_MCP2518: {
-      CANFDMessage MCP2518Frame;
-      if (tx_frame->FD) {
-        MCP2518Frame.type = CANFDMessage::CANFD_WITH_BIT_RATE_SWITCH;
-      } else {  //Classic CAN message
-        MCP2518Frame.type = CANFDMessage::CAN_DATA;
-      }
-      MCP2518Frame.id = tx_frame->ID;
-      MCP2518Frame.ext = tx_frame->ext_ID;
-      MCP2518Frame.len = tx_frame->DLC;
-      memcpy(MCP2518Frame.data, tx_frame->data.u8, std::min(tx_frame->DLC, (uint8_t)sizeof(MCP2518Frame.data)));
-
-      if (!canfd->tryToSend(MCP2518Frame)) {
-        datalayer.system.info.can_2518_send_fail = true;
-      }
-    } break;
+    case CANFD_ADDON_MCP2518:
     case CANFD_ADDON_MCP2518_2: {
       CANFDMessage MCP2518Frame;
-      if (tx_frame->FD) {
+      if (tx_frame.FD) {
         MCP2518Frame.type = CANFDMessage::CANFD_WITH_BIT_RATE_SWITCH;
       } else {  //Classic CAN message
         MCP2518Frame.type = CANFDMessage::CAN_DATA;
       }
-      MCP2518Frame.id = tx_frame->ID;
-      MCP2518Frame.ext = tx_frame->ext_ID;
-      MCP2518Frame.len = tx_frame->DLC;
-      memcpy(MCP2518Frame.data, tx_frame->data.u8, std::min(tx_frame->DLC, (uint8_t)sizeof(MCP2518Frame.data)));
-
-      if (!canfd_2->tryToSend(MCP2518Frame)) {
-        datalayer.system.info.can_2518_send_fail = true;
-      }
-    } break;
+      MCP2518Frame.id = tx_frame.ID;
+      MCP2518Frame.ext = tx_frame.ext_ID;
+      MCP2518Frame.len = tx_frame.DLC;
+      memcpy(MCP2518Frame.data, tx_frame.data.u8, std::min(tx_frame.DLC, (uint8_t)sizeof(MCP2518Frame.data)));
+      return (interface == CANFD_ADDON_MCP2518_2 ? canfd_2 : canfd)->tryToSend(MCP2518Frame);
+    }
     default:
       // Invalid interface sent with function call. TODO: Raise event that coders messed up
+      return true;
+  }
+}
+
+static void set_send_fail(CAN_Interface interface) {
+  switch (interface) {
+    case CAN_NATIVE:
+      datalayer.system.info.can_native_send_fail = true;
+      break;
+    case CAN_ADDON_MCP2515:
+      datalayer.system.info.can_2515_send_fail = true;
+      break;
+    default:
+      datalayer.system.info.can_2518_send_fail = true;
       break;
   }
 }
 
+static void drain_can_tx_queue(CAN_Interface interface) {
+  can_tx_queues[interface]->drain(
+      [interface](const CAN_frame& frame) { return send_to_controller(frame, interface); }, micros());
+}
+
+void transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface, CAN_Tx_Priority priority) {
+  if (!allowed_to_send_CAN || interface >= NO_CAN_INTERFACE || can_tx_queues[interface] == nullptr) {
+    return;  // Interface not set up by init_CAN()
+  }
+  print_can_frame(*tx_frame, interface, frameDirection(MSG_TX));
+
+  if (datalayer.system.info.CAN_SD_logging_active) {
+    add_can_frame_to_buffer(*tx_frame, frameDirection(MSG_TX), interface);
+  }
+
+  if (priority == CAN_TX_PRIORITY_AUTO) {
+    priority = can_tx_priority_for(*tx_frame, CAN_TX_KEEPALIVE);
+  }
+  // Frames the controller has no room for wait in the queue. Only an overflowing queue counts as a send failure.
+  if (!can_tx_queues[interface]->push(*tx_frame, priority, micros())) {
+    set_send_fail(interface);
+  }
+  drain_can_tx_queue(interface);
+}
+
+void drain_can_tx_queues() {
+  // CANFD_NATIVE is drained with the queue it shares with CANFD_ADDON_MCP2518
+  for (uint8_t i = 0; i < NO_CAN_INTERFACE; i++) {
+    if (can_tx_queues[i] == nullptr || i == CANFD_NATIVE) {
+      continue;
+    }
+    if (!allowed_to_send_CAN) {
+      can_tx_queues[i]->clear();
+      continue;
+    }
+    drain_can_tx_queue((CAN_Interface)i);
+  }
+}
+
 // Receive functions
 void receive_can() {
   if (native_can_initialized) {
@@ -362,41 +479,55 @@ void receive_can() {
   }
 }
 
-void receive_frame_can_native() {  // This section checks if we have a complete CAN message incoming on native CAN port
+void receive_frame_can_native() {  // This section drains complete CAN messages incoming on native CAN port
   CANMessage frame;
+  const uint16_t budget = user_selected_can_native_rx_burst;
+  uint16_t count = 0;
 
-  if (ACAN_ESP32::can.available()) {
-    if (ACAN_ESP32::can.receive(frame)) {
-
-      CAN_frame rx_frame;
-      rx_frame.ID = frame.id;
-      rx_frame.ext_ID = frame.ext;
-      rx_frame.DLC = frame.len;
-      for (uint8_t i = 0; i < frame.len && i < 8; i++) {
-        rx_frame.data.u8[i] = frame.data[i];
-      }
+  // Drain in bursts, a busy 500kbps bus delivers several frames per core_loop iteration
+  while (count < budget && ACAN_ESP32::can.receive(frame)) {
+    count++;
 
-      //message incoming, pass it on to the handler
-      map_can_frame_to_variable(&rx_frame, CAN_NATIVE);
+    CAN_frame rx_frame;
+    rx_frame.ID = frame.id;
+    rx_frame.ext_ID = frame.ext;
+    rx_frame.DLC = frame.len;
+    for (uint8_t i = 0; i < frame.len && i < 8; i++) {
+      rx_frame.data.u8[i] = frame.data[i];
     }
+
+    //message incoming, pass it on to the handler
+    map_can_frame_to_variable(rx_frame, CAN_NATIVE);
   }
+
+  update_can_rx_statistics(CAN_NATIVE, count, count == budget && ACAN_ESP32::can.available());
+
+  CAN_RX_Statistics& stats = can_rx_statistics[CAN_NATIVE];
+  stats.driver_buffer_peak = ACAN_ESP32::can.driverReceiveBufferPeakCount();
+  stats.driver_buffer_size = ACAN_ESP32::can.driverReceiveBufferSize();
+  // Bit 0: hardware FIFO overrun, bit 1: driver buffer overflow
+  stats.overflow_flags |= (ACAN_ESP32::can.statusFlags() & 0x03);
 }
 
 void receive_frame_can_addon() {  // This section checks if we have a complete CAN message incoming on add-on CAN port
   MCP2515_Lite_Frame rx_frame;
   CAN_frame full_frame;
 
-  int count = 0;
-  while (count++ < 16 && can2515->receiveFrame(rx_frame)) {
+  uint16_t count = 0;
+  while (count < CAN_RX_BURST_DEFAULT && can2515->receiveFrame(rx_frame)) {
+    count++;
     copy_mcp2515_lite_frame_to_can_frame(rx_frame, full_frame);
-    map_can_frame_to_variable(&full_frame, CAN_ADDON_MCP2515);
+    map_can_frame_to_variable(full_frame, CAN_ADDON_MCP2515);
   }
+
+  update_can_rx_statistics(CAN_ADDON_MCP2515, count, count == CAN_RX_BURST_DEFAULT);
 }
 
 void receive_frame_canfd_addon() {  // This section checks if we have a complete CAN-FD message incoming
   CANFDMessage MCP2518frame;
-  int count = 0;
-  while (canfd->available() && count++ < 16) {
+  uint16_t count = 0;
+  while (count < CAN_RX_BURST_DEFAULT && canfd->available()) {
+    count++;
     canfd->receive(MCP2518frame);
 
     CAN_frame rx_frame;
@@ -405,15 +536,25 @@ void receive_frame_canfd_addon() {  // This section checks if we have a complete
     rx_frame.DLC = MCP2518frame.len;
     memcpy(rx_frame.data.u8, MCP2518frame.data, std::min(rx_frame.DLC, (uint8_t)sizeof(rx_frame.data.u8)));
     //message incoming, pass it on to the handler
-    map_can_frame_to_variable(&rx_frame, CANFD_ADDON_MCP2518);
-    map_can_frame_to_variable(&rx_frame, CANFD_NATIVE);
+    map_can_frame_to_variable(rx_frame, CANFD_ADDON_MCP2518);
+    map_can_frame_to_variable(rx_frame, CANFD_NATIVE);
+  }
+
+  update_can_rx_statistics(CANFD_ADDON_MCP2518, count, count == CAN_RX_BURST_DEFAULT && canfd->available());
+
+  CAN_RX_Statistics& stats = can_rx_statistics[CANFD_ADDON_MCP2518];
+  stats.driver_buffer_peak = canfd->driverReceiveBufferPeakCount();
+  stats.driver_buffer_size = settings2517->mDriverReceiveFIFOSize;
+  if (canfd->hardwareReceiveBufferOverflowCount() > 0) {
+    stats.overflow_flags |= 0x01;
   }
 }
 
 void receive_frame_canfd_addon_2() {  // This section checks if we have a complete CAN-FD message incoming on 2nd CAN-FD add-on
   CANFDMessage MCP2518frame;
-  int count = 0;
-  while (canfd_2->available() && count++ < 16) {
+  uint16_t count = 0;
+  while (count < CAN_RX_BURST_DEFAULT && canfd_2->available()) {
+    count++;
     canfd_2->receive(MCP2518frame);
 
     CAN_frame rx_frame;
@@ -422,12 +563,21 @@ void receive_frame_canfd_addon_2() {  // This section checks if we have a comple
     rx_frame.DLC = MCP2518frame.len;
     memcpy(rx_frame.data.u8, MCP2518frame.data, std::min(rx_frame.DLC, (uint8_t)sizeof(rx_frame.data.u8)));
     //message incoming, pass it on to the handler
-    map_can_frame_to_variable(&rx_frame, CANFD_ADDON_MCP2518_2);
+    map_can_frame_to_variable(rx_frame, CANFD_ADDON_MCP2518_2);
+  }
+
+  update_can_rx_statistics(CANFD_ADDON_MCP2518_2, count, count == CAN_RX_BURST_DEFAULT && canfd_2->available());
+
+  CAN_RX_Statistics& stats = can_rx_statistics[CANFD_ADDON_MCP2518_2];
+  stats.driver_buffer_peak = canfd_2->driverReceiveBufferPeakCount();
+  stats.driver_buffer_size = settings2517_2->mDriverReceiveFIFOSize;
+  if (canfd_2->hardwareReceiveBufferOverflowCount() > 0) {
+    stats.overflow_flags |= 0x01;
   }
 }
 
 // Support functions
-void print_can_frame(CAN_frame frame, CAN_Interface interface, frameDirection msgDir) {
+void print_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir) {
 
   if (datalayer.system.info.CAN_usb_logging_active) {
     uint8_t i = 0;
@@ -461,39 +611,30 @@ void print_can_frame(CAN_frame frame, CAN_Interface interface, frameDirection ms
   }
 }
 
-void map_can_frame_to_variable(CAN_frame* rx_frame, CAN_Interface interface) {
+void map_can_frame_to_variable(const CAN_frame& rx_frame, CAN_Interface interface) {
   if (interface !=
       CANFD_NATIVE) {  //Avoid printing twice due to receive_frame_canfd_addon sending to both FD interfaces
     //TODO: This check can be removed later when refactored to use inline functions for logging
-    print_can_frame(*rx_frame, interface, frameDirection(MSG_RX));
+    print_can_frame(rx_frame, interface, frameDirection(MSG_RX));
   }
 
   if (datalayer.system.info.CAN_SD_logging_active) {
     if (interface !=
         CANFD_NATIVE) {  //Avoid printing twice due to receive_frame_canfd_addon sending to both FD interfaces
       //TODO: This check can be removed later when refactored to use inline functions for logging
-      add_can_frame_to_buffer(*rx_frame, frameDirection(MSG_RX));
+      add_can_frame_to_buffer(rx_frame, frameDirection(MSG_RX), interface);
     }
   }
 
   // Send the frame to all the receivers registered for this interface.
-  auto receivers = can_receivers.equal_range(interface);
-
-  for (auto it = receivers.first; it != receivers.second; ++it) {
-    auto& receiver = it->second;
-    receiver.receiver->receive_can_frame(rx_frame);
-  }
+  can_dispatch_frame(rx_frame, interface);
 }
 
-void dump_can_frame(CAN_frame& frame, CAN_Interface interface, frameDirection msgDir) {
-  char* message_string = datalayer.system.info.logged_can_messages;
-  int offset = datalayer.system.info.logged_can_messages_offset;  // Keeps track of the current position in the buffer
-  size_t message_string_size = sizeof(datalayer.system.info.logged_can_messages);
+void dump_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir) {
+  char message_string[LOG_RING_LINE_MAX];
+  size_t message_string_size = sizeof(message_string);
+  int offset = 0;
 
-  if (offset + 128 > sizeof(datalayer.system.info.logged_can_messages)) {
-    // Not enough space, reset and start from the beginning
-    offset = 0;
-  }
   unsigned long currentTime = millis();
   // Add timestamp
   offset += snprintf(message_string + offset, message_string_size - offset, "(%lu.%03lu) ", currentTime / 1000,
@@ -503,25 +644,26 @@ void dump_can_frame(CAN_frame& frame, CAN_Interface interface, frameDirection ms
   offset += snprintf(message_string + offset, message_string_size - offset, "%s%d ", (msgDir == MSG_RX) ? "RX" : "TX",
                      (int)(interface * 2) + (msgDir == MSG_RX ? 0 : 1));
 
-  // Add ID and DLC
-  offset += snprintf(message_string + offset, message_string_size - offset, "%lX [%u] ", frame.ID, frame.DLC);
+  // Add ID and DLC. Like candump, standard IDs take 3 digits and extended IDs 8, which is how the frame format is read
+  // back when the log is replayed.
+  offset += snprintf(message_string + offset, message_string_size - offset,
+                     frame.ext_ID ? "%08lX [%u] " : "%03lX [%u] ", frame.ID, frame.DLC);
 
   // Add data bytes
-  for (uint8_t i = 0; i < frame.DLC; i++) {
+  for (uint8_t i = 0; i < frame.DLC && offset < (int)message_string_size; i++) {
     if (i < frame.DLC - 1) {
       offset += snprintf(message_string + offset, message_string_size - offset, "%02X ", frame.data.u8[i]);
     } else {
       offset += snprintf(message_string + offset, message_string_size - offset, "%02X", frame.data.u8[i]);
     }
   }
-  // Add linebreak
-  offset += snprintf(message_string + offset, message_string_size - offset, "\n");
 
-  datalayer.system.info.logged_can_messages_offset = offset;  // Update offset in buffer
+  // The whole line goes into the ring at once, so it cannot tear or interleave with other writers
+  web_log_ring.write_line(message_string, min((size_t)offset, message_string_size - 1));
 }
 
 void stop_can() {
-  if (can_receivers.find(CAN_NATIVE) != can_receivers.end()) {
+  if (can_dispatch_has_receivers(CAN_NATIVE)) {
     ACAN_ESP32::can.end();
   }
 
@@ -535,8 +677,8 @@ void stop_can() {
 }
 
 void restart_can() {
-  if (can_receivers.find(CAN_NATIVE) != can_receivers.end()) {
-    ACAN_ESP32::can.begin(*settingsespcan);
+  if (can_dispatch_has_receivers(CAN_NATIVE)) {
+    ACAN_ESP32::can.begin(*settingsespcan, native_filter);
   }
 
   if (can2515) {
@@ -544,7 +686,7 @@ void restart_can() {
   }
 
   if (canfd) {
-    canfd->begin(*settings2517, [] { canfd->isr(); });
+    canfd->begin(*settings2517, [] { canfd->isr(); }, *filters2517);
     canfd->poll();
   }
 }
@@ -569,7 +711,7 @@ uint32_t init_native_can(CAN_Speed speed, gpio_num_t tx_pin, gpio_num_t rx_pin)
   settingsespcan->mRxPin = rx_pin;
 
   // (Re)start the CAN interface
-  return ACAN_ESP32::can.begin(*settingsespcan);
+  return ACAN_ESP32::can.begin(*settingsespcan, native_filter);
 }
 
 // Change the speed of the given CAN interface. Returns true if successful.
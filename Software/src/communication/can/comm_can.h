@@ -2,19 +2,51 @@
 #define _COMM_CAN_H_
 
 #include "../../devboard/utils/types.h"
+#include "can_tx_queue.h"
 
 extern bool use_canfd_as_can;
 extern uint8_t user_selected_can_addon_crystal_frequency_mhz;
 extern uint8_t user_selected_canfd_addon_crystal_frequency_mhz;
 extern uint16_t user_selected_CAN_ID_cutoff_filter;
+extern uint8_t user_selected_can_native_rx_burst;
+extern bool user_selected_can_hardware_filters;
 
-void dump_can_frame(CAN_frame& frame, CAN_Interface interface, frameDirection msgDir);
-void transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface);
+void dump_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir);
+// Queue a frame for an interface and send as much of its queue as the controller takes right now.
+// Without a priority the class is picked by can_tx_priority_for(), keep-alive unless it is a diagnostic request.
+void transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface,
+                                     CAN_Tx_Priority priority = CAN_TX_PRIORITY_AUTO);
+// Send frames still waiting in the transmit queues, called once per core_loop iteration
+void drain_can_tx_queues();
 
 //These defines are not used if user updates values via Settings page
 #define CRYSTAL_FREQUENCY_MHZ 8
 #define CANFD_ADDON_CRYSTAL_FREQUENCY_MHZ ACAN2517FDSettings::OSC_40MHz
 
+// Max amount of frames drained from an interface receive buffer per core_loop iteration
+#define CAN_RX_BURST_DEFAULT 16
+#define CAN_RX_BURST_MAX 64
+
+// Receive statistics per CAN interface, used to verify that no frames are lost under heavy bus load
+typedef struct {
+  /** Total amount of frames received on this interface since boot */
+  uint32_t frames_received = 0;
+  /** Amount of core_loop iterations where the burst budget ran out with frames still pending */
+  uint32_t budget_exhausted_count = 0;
+  /** Amount of frames drained during the last core_loop iteration */
+  uint16_t frames_last_tick = 0;
+  /** Most frames drained during a single core_loop iteration since boot */
+  uint16_t frames_max_tick = 0;
+  /** Highest fill level seen in the driver receive buffer (0 if not supported by the driver) */
+  uint16_t driver_buffer_peak = 0;
+  /** Size of the driver receive buffer (0 if not supported by the driver) */
+  uint16_t driver_buffer_size = 0;
+  /** Sticky overflow bits. Bit 0: hardware receive FIFO overflow, Bit 1: driver receive buffer overflow */
+  uint8_t overflow_flags = 0;
+} CAN_RX_Statistics;
+
+extern CAN_RX_Statistics can_rx_statistics[NO_CAN_INTERFACE];
+
 class CanReceiver;
 
 typedef struct {
@@ -38,11 +70,25 @@ enum class CAN_Speed {
   CAN_SPEED_1000KBPS = 1000
 };
 
+// Frame format a CAN_ID_Filter accepts
+enum class CAN_ID_Format : uint8_t { ANY, STANDARD, EXTENDED };
+
+// Optional acceptance window for a CanReceiver. A frame is only handed to the receiver if
+// (ID & mask) == (code & mask), min_id <= ID <= max_id and its format matches. The default accepts every frame.
+typedef struct {
+  uint32_t code = 0;
+  uint32_t mask = 0;
+  uint32_t min_id = 0;
+  uint32_t max_id = 0x1FFFFFFF;
+  CAN_ID_Format format = CAN_ID_Format::ANY;
+} CAN_ID_Filter;
+
 // Register a receiver object for a given CAN interface.
 // By default receivers expect the CAN interface to be operated at "fast" speed.
 // If halfSpeed is true, half speed is used.
+// Frames rejected by the optional filter are dropped before the receiver is called.
 void register_can_receiver(CanReceiver* receiver, CAN_Interface interface,
-                           CAN_Speed speed = CAN_Speed::CAN_SPEED_500KBPS);
+                           CAN_Speed speed = CAN_Speed::CAN_SPEED_500KBPS, const CAN_ID_Filter& filter = {});
 
 /**
  * @brief Initializes all CAN interfaces requested earlier by other modules (see register_can_receiver)
@@ -105,7 +151,7 @@ void receive_frame_canfd_addon_2();
  *
  * @return void
  */
-void print_can_frame(CAN_frame frame, CAN_Interface interface, frameDirection msgDir);
+void print_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir);
 
 // Stop/pause CAN communication for all interfaces
 void stop_can();
@@ -2,6 +2,7 @@
 #include "../../battery/BATTERIES.h"
 #include "../../battery/Battery.h"
 #include "../../battery/Shunt.h"
+#include "../../datalayer/telemetry_history.h"
 #include "../../charger/CanCharger.h"
 #include "../../communication/can/comm_can.h"
 #include "../../devboard/mqtt/mqtt.h"
@@ -14,7 +15,11 @@
 
 // Initialization functions
 
-void init_stored_settings() {
+static const char* settings_source_string(Settings_Source source) {
+  return source == SETTINGS_FROM_BLOB ? "one blob" : "their own keys";
+}
+
+static void read_stored_settings() {
   static uint32_t temp = 0;
   BatteryEmulatorSettingsStore settings(false);
   //  ATTENTION ! The maximum length for settings keys is 15 characters
@@ -35,6 +40,8 @@ void init_stored_settings() {
   http_username = settings.getString("HTTPUSER", "admin").c_str();
   http_password = settings.getString("HTTPPASS").c_str();
   webserver_auth = settings.getBool("WEBAUTH", false) && !http_username.empty() && !http_password.empty();
+  web_push_interval_ms = settings.getUInt("WEBPUSHMS", 1000);
+  telemetry_history_dram_kb = settings.getUInt("HISTDRAMKB", 0);
 
   temp = settings.getUInt("BATTERY_WH_MAX", false);
   if (temp != 0) {
@@ -103,6 +110,8 @@ void init_stored_settings() {
   user_selected_inverter_deye_workaround = settings.getBool("DEYEBYD", false);
   user_selected_can_addon_crystal_frequency_mhz = settings.getUInt("CANFREQ", 8);
   user_selected_canfd_addon_crystal_frequency_mhz = settings.getUInt("CANFDFREQ", 40);
+  user_selected_can_native_rx_burst =
+      constrain(settings.getUInt("CANRXBURST", CAN_RX_BURST_DEFAULT), 1u, (uint32_t)CAN_RX_BURST_MAX);
   user_selected_LEAF_interlock_mandatory = settings.getBool("INTERLOCKREQ", false);
   user_selected_daly_power_per_percent = settings.getUInt("DALYPWRPCT", 50);
   user_selected_daly_power_per_dV = settings.getUInt("DALYPWRDV", 50);
@@ -163,6 +172,7 @@ void init_stored_settings() {
   periodic_bms_reset = settings.getBool("PERBMSRESET", false);
   remote_bms_reset = settings.getBool("REMBMSRESET", false);
   use_canfd_as_can = settings.getBool("CANFDASCAN", false);
+  user_selected_can_hardware_filters = settings.getBool("CANHWFILTER", true);
 #ifdef HW_LILYGO2CAN
   user_selected_gpioopt1 = (GPIOOPT1)settings.getUInt("GPIOOPT1", 0);
 #endif
@@ -204,6 +214,10 @@ void init_stored_settings() {
   mqtt_publish_interval_ms = settings.getUInt("MQTTPUBLISHMS", 5000);
   ha_autodiscovery_enabled = settings.getBool("HADISC", false);
   mqtt_transmit_all_cellvoltages = settings.getBool("MQTTCELLV", false);
+  mqtt_delta_enabled = settings.getBool("MQTTDELTA", false);
+  mqtt_full_refresh_s = settings.getUInt("MQTTREFRESH", 300);
+  mqtt_cell_deadband_mV = settings.getUInt("MQTTDBCELL", 5);
+  mqtt_cell_format = (MqttCellFormat)settings.getUInt("MQTTCELLFMT", (int)MqttCellFormat::Float);
   custom_hostname = settings.getString("HOSTNAME").c_str();
 
   static_IP_enabled = settings.getBool("STATICIP", false);
@@ -232,12 +246,26 @@ void init_stored_settings() {
   ct_clamp_pin_atten = (adc_attenuation_enum)settings.getUInt("CTATTEN", 3);
   ct_invert_current = settings.getBool("CTINVERT", false);
 
-  datalayer_extended.bydAtto3.auto_calibrate_soc_drift_percent =
-      constrain(settings.getUInt("BYDAUTOCALDRIFT", 5), 1u, 20u);
-  datalayer_extended.bydAtto3.auto_calibrate_soc_enabled = settings.getBool("BYDAUTOCALEN", true);
-  datalayer_extended.bydAtto3_2.auto_calibrate_soc_drift_percent =
-      constrain(settings.getUInt("BYDAUTOCALDRFT2", 5), 1u, 20u);
-  datalayer_extended.bydAtto3_2.auto_calibrate_soc_enabled = settings.getBool("BYDAUTOCALEN2", true);
+  // Only a BYD battery has these values, other batteries do not allocate them
+  if (user_selected_battery_type == BatteryType::BydAtto3) {
+    DATALAYER_INFO_BYDATTO3* byd = datalayer_extended.bydAtto3.get();
+    byd->auto_calibrate_soc_drift_percent = constrain(settings.getUInt("BYDAUTOCALDRIFT", 5), 1u, 20u);
+    byd->auto_calibrate_soc_enabled = settings.getBool("BYDAUTOCALEN", true);
+    if (user_selected_second_battery) {
+      DATALAYER_INFO_BYDATTO3* byd2 = datalayer_extended.bydAtto3_2.get();
+      byd2->auto_calibrate_soc_drift_percent = constrain(settings.getUInt("BYDAUTOCALDRFT2", 5), 1u, 20u);
+      byd2->auto_calibrate_soc_enabled = settings.getBool("BYDAUTOCALEN2", true);
+    }
+  }
+}
+
+void init_stored_settings() {
+  const uint32_t start_us = micros();
+  read_stored_settings();  // Includes writing the blob on the first boot after an update
+  datalayer.system.status.settings_load_us = micros() - start_us;
+  DEBUG_PRINTF("Settings loaded from %s with %u NVS reads in %u us, %u ms after boot\n",
+               settings_source_string(settings_blob.loaded_from()), (unsigned)settings_blob.load_reads(),
+               (unsigned)datalayer.system.status.settings_load_us, (unsigned)millis());
 }
 
 void store_settings_equipment_stop() {
@@ -259,8 +287,14 @@ void store_settings() {
   settings.saveUInt("TARGETCHVOLT", datalayer.battery.settings.max_user_set_charge_voltage_dV);
   settings.saveUInt("TARGETDISCHVOLT", datalayer.battery.settings.max_user_set_discharge_voltage_dV);
   settings.saveUInt("BMSRESETDUR", datalayer.battery.settings.user_set_bms_reset_duration_ms);
-  settings.saveUInt("BYDAUTOCALDRIFT", datalayer_extended.bydAtto3.auto_calibrate_soc_drift_percent);
-  settings.saveBool("BYDAUTOCALEN", datalayer_extended.bydAtto3.auto_calibrate_soc_enabled);
-  settings.saveUInt("BYDAUTOCALDRFT2", datalayer_extended.bydAtto3_2.auto_calibrate_soc_drift_percent);
-  settings.saveBool("BYDAUTOCALEN2", datalayer_extended.bydAtto3_2.auto_calibrate_soc_enabled);
+  if (datalayer_extended.bydAtto3.allocated()) {
+    const DATALAYER_INFO_BYDATTO3* byd = datalayer_extended.bydAtto3.get();
+    settings.saveUInt("BYDAUTOCALDRIFT", byd->auto_calibrate_soc_drift_percent);
+    settings.saveBool("BYDAUTOCALEN", byd->auto_calibrate_soc_enabled);
+  }
+  if (datalayer_extended.bydAtto3_2.allocated()) {
+    const DATALAYER_INFO_BYDATTO3* byd2 = datalayer_extended.bydAtto3_2.get();
+    settings.saveUInt("BYDAUTOCALDRFT2", byd2->auto_calibrate_soc_drift_percent);
+    settings.saveBool("BYDAUTOCALEN2", byd2->auto_calibrate_soc_enabled);
+  }
 }
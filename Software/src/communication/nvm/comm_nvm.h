@@ -8,6 +8,7 @@
 #include "../../devboard/utils/events.h"
 #include "../../devboard/utils/logging.h"
 #include "../../devboard/wifi/wifi.h"
+#include "settings_blob.h"
 
 /**
  * @brief Initialization of setting storage
@@ -38,64 +39,136 @@ void store_settings();
 
 // Wraps the Preferences object begin/end calls, so that the scope of this object
 // runs them automatically (via constructor/destructor).
+// Settings in settings_schema are read from and saved to settings_blob, which is written to NVS as one blob when the
+// store goes out of scope. Any other key is still read and written on its own.
+// A writable store holds the settings lock from construction until its changes are committed, so the changes of one
+// task are never committed halfway by another. Keep it short-lived, other tasks wait for it. A read-only store only
+// takes the lock for each read, it may be kept for as long as a web page is being sent.
 class BatteryEmulatorSettingsStore {
  public:
-  BatteryEmulatorSettingsStore(bool readOnly = false) {
+  BatteryEmulatorSettingsStore(bool readOnly = false) : readOnly(readOnly) {
+    lock_settings();
     if (!settings.begin("batterySettings", readOnly)) {
       set_event(EVENT_PERSISTENT_SAVE_INFO, 0);
     }
+    if (!settings_blob.loaded()) {
+      settings_blob.load(settings);
+    }
+    if (readOnly) {
+      unlock_settings();
+    }
   }
 
-  ~BatteryEmulatorSettingsStore() { settings.end(); }
+  ~BatteryEmulatorSettingsStore() {
+    if (!readOnly && !settings_blob.commit(settings)) {
+      set_event(EVENT_PERSISTENT_SAVE_INFO, 1);
+    }
+    settings.end();
+    if (!readOnly) {
+      unlock_settings();
+    }
+  }
 
   void clearAll() {
+    SettingsLock lock;
     settings.clear();
+    settings_blob.clear();
     settingsUpdated = true;
   }
 
   int32_t getInt(const char* name, int32_t defaultValue) {
-    return settings.isKey(name) ? settings.getInt(name, defaultValue) : defaultValue;
+    SettingsLock lock;
+    int field = settings_blob.find(name);
+    if (field < 0) {
+      return settings.isKey(name) ? settings.getInt(name, defaultValue) : defaultValue;
+    }
+    return settings_blob.state(field) == SETTING_STORED ? (int32_t)settings_blob.number(field) : defaultValue;
   }
 
   void saveInt(const char* name, int32_t value) {
+    SettingsLock lock;
     auto oldValue = getInt(name, std::numeric_limits<int32_t>::max());
     if (value != oldValue) {
-      settings.putInt(name, value);
+      int field = settings_blob.find(name);
+      if (field < 0) {
+        settings.putInt(name, value);
+      } else {
+        settings_blob.set_number(field, (uint32_t)value);
+      }
       settingsUpdated = true;
     }
   }
 
   uint32_t getUInt(const char* name, uint32_t defaultValue) {
-    return settings.isKey(name) ? settings.getUInt(name, defaultValue) : defaultValue;
+    SettingsLock lock;
+    int field = settings_blob.find(name);
+    if (field < 0) {
+      return settings.isKey(name) ? settings.getUInt(name, defaultValue) : defaultValue;
+    }
+    return settings_blob.state(field) == SETTING_STORED ? settings_blob.number(field) : defaultValue;
   }
 
   void saveUInt(const char* name, uint32_t value) {
+    SettingsLock lock;
     auto oldValue = getUInt(name, std::numeric_limits<uint32_t>::max());
-    settings.putUInt(name, value);
+    int field = settings_blob.find(name);
+    if (field < 0) {
+      settings.putUInt(name, value);
+    } else {
+      settings_blob.set_number(field, value);
+    }
     settingsUpdated = settingsUpdated || value != oldValue;
   }
 
-  bool settingExists(const char* name) { return settings.isKey(name); }
+  bool settingExists(const char* name) {
+    SettingsLock lock;
+    int field = settings_blob.find(name);
+    return field < 0 ? settings.isKey(name) : settings_blob.state(field) != SETTING_ABSENT;
+  }
 
   bool getBool(const char* name, bool defaultValue = false) {
-    return settings.isKey(name) ? settings.getBool(name, defaultValue) : defaultValue;
+    SettingsLock lock;
+    int field = settings_blob.find(name);
+    if (field < 0) {
+      return settings.isKey(name) ? settings.getBool(name, defaultValue) : defaultValue;
+    }
+    return settings_blob.state(field) == SETTING_STORED ? settings_blob.number(field) != 0 : defaultValue;
   }
 
   void saveBool(const char* name, bool value) {
+    SettingsLock lock;
     auto oldValue = getBool(name, false);
-    settings.putBool(name, value);
+    int field = settings_blob.find(name);
+    if (field < 0) {
+      settings.putBool(name, value);
+    } else {
+      settings_blob.set_number(field, value);
+    }
     settingsUpdated = settingsUpdated || value != oldValue;
   }
 
   String getString(const char* name) { return getString(name, ""); }
 
   String getString(const char* name, const char* defaultValue) {
+    SettingsLock lock;
+    int field = settings_blob.find(name);
+    if (field >= 0 && settings_blob.state(field) != SETTING_OWN_KEY) {
+      return settings_blob.state(field) == SETTING_STORED ? String(settings_blob.text(field).c_str())
+                                                          : String(defaultValue);
+    }
     return settings.isKey(name) ? settings.getString(name, defaultValue) : String(defaultValue);
   }
 
   void saveString(const char* name, const char* value) {
+    SettingsLock lock;
     auto oldValue = getString(name, "");
-    settings.putString(name, value);
+    int field = settings_blob.find(name);
+    if (field < 0 || !settings_blob.set_text(field, value)) {
+      settings.putString(name, value);
+      if (field >= 0) {
+        settings_blob.set_own_key(field);
+      }
+    }
     settingsUpdated = settingsUpdated || String(value) != oldValue;
   }
 
@@ -103,6 +176,7 @@ class BatteryEmulatorSettingsStore {
 
  private:
   Preferences settings;
+  bool readOnly;
 
   // To track if settings were updated
   bool settingsUpdated = false;
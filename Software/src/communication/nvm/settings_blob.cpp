@@ -0,0 +1,374 @@
+#include "settings_blob.h"
+
+#include <Preferences.h>
+#include <string.h>
+#include "../../devboard/utils/common_functions.h"
+#include "../../devboard/utils/events.h"
+#include "../../devboard/utils/logging.h"
+
+#ifdef UNIT_TEST
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// Positions are stored in the blob: new settings go at the end, a setting that is no longer used keeps its place
+const Setting_Field settings_schema[] = {
+    {"APNAME", SETTING_STRING},
+    {"APPASSWORD", SETTING_STRING},
+    {"BATT2COMM", SETTING_UINT},
+    {"BATT3COMM", SETTING_UINT},
+    {"BATTCHEM", SETTING_UINT},
+    {"BATTCOMM", SETTING_UINT},
+    {"BATTCVMAX", SETTING_UINT},
+    {"BATTCVMIN", SETTING_UINT},
+    {"BATTERY_WH_MAX", SETTING_UINT},
+    {"BATTPVMAX", SETTING_UINT},
+    {"BATTPVMIN", SETTING_UINT},
+    {"BATTTYPE", SETTING_UINT},
+    {"BMSRESETDUR", SETTING_UINT},
+    {"BYDAUTOCALDRFT2", SETTING_UINT},
+    {"BYDAUTOCALDRIFT", SETTING_UINT},
+    {"BYDAUTOCALEN", SETTING_BOOL},
+    {"BYDAUTOCALEN2", SETTING_BOOL},
+    {"CANFDASCAN", SETTING_BOOL},
+    {"CANFDFREQ", SETTING_UINT},
+    {"CANFREQ", SETTING_UINT},
+    {"CANHWFILTER", SETTING_BOOL},
+    {"CANLOGSD", SETTING_BOOL},
+    {"CANLOGUSB", SETTING_BOOL},
+    {"CANRXBURST", SETTING_UINT},
+    {"CHGCOMM", SETTING_UINT},
+    {"CHGPOWER", SETTING_UINT},
+    {"CHGTYPE", SETTING_UINT},
+    {"CNTCTRL", SETTING_BOOL},
+    {"CNTCTRLDBL", SETTING_BOOL},
+    {"CNTCTRLTRI", SETTING_BOOL},
+    {"CTANOM", SETTING_UINT},
+    {"CTATTEN", SETTING_UINT},
+    {"CTINVERT", SETTING_BOOL},
+    {"CTOFFSET", SETTING_STRING},
+    {"CTVNOM", SETTING_UINT},
+    {"DALYDVSTART", SETTING_UINT},
+    {"DALYPWR0C", SETTING_UINT},
+    {"DALYPWRDEG", SETTING_UINT},
+    {"DALYPWRDV", SETTING_UINT},
+    {"DALYPWRPCT", SETTING_UINT},
+    {"DBLBTR", SETTING_BOOL},
+    {"DCHGPOWER", SETTING_UINT},
+    {"DEYEBYD", SETTING_BOOL},
+    {"DIGITALHVIL", SETTING_BOOL},
+    {"EQSTOP", SETTING_UINT},
+    {"EQUIPMENT_STOP", SETTING_BOOL},
+    {"ESPNOWENABLED", SETTING_BOOL},
+    {"EXTPRECHARGE", SETTING_BOOL},
+    {"GATEWAY1", SETTING_UINT},
+    {"GATEWAY2", SETTING_UINT},
+    {"GATEWAY3", SETTING_UINT},
+    {"GATEWAY4", SETTING_UINT},
+    {"GPIOOPT1", SETTING_UINT},
+    {"GPIOOPT2", SETTING_UINT},
+    {"GPIOOPT3", SETTING_UINT},
+    {"GPIOOPT4", SETTING_UINT},
+    {"GPIOOPT5", SETTING_UINT},
+    {"GPIOOPT6", SETTING_UINT},
+    {"GTWCHASSIS", SETTING_UINT},
+    {"GTWCOUNTRY", SETTING_UINT},
+    {"GTWMAPREG", SETTING_UINT},
+    {"GTWPACK", SETTING_UINT},
+    {"GTWRHD", SETTING_BOOL},
+    {"HADEVICEID", SETTING_STRING},
+    {"HADISC", SETTING_BOOL},
+    {"HOSTNAME", SETTING_STRING},
+    {"HTTPPASS", SETTING_STRING},
+    {"HTTPUSER", SETTING_STRING},
+    {"INTERLOCKREQ", SETTING_BOOL},
+    {"INVBTYPE", SETTING_UINT},
+    {"INVCAPACITY", SETTING_UINT},
+    {"INVCELLS", SETTING_UINT},
+    {"INVCELLSPER", SETTING_UINT},
+    {"INVCOMM", SETTING_UINT},
+    {"INVICNT", SETTING_UINT},
+    {"INVMODULES", SETTING_UINT},
+    {"INVSUNTYPE", SETTING_UINT},
+    {"INVTYPE", SETTING_UINT},
+    {"INVVLEVEL", SETTING_UINT},
+    {"LEDMODE", SETTING_UINT},
+    {"LOCALIP1", SETTING_UINT},
+    {"LOCALIP2", SETTING_UINT},
+    {"LOCALIP3", SETTING_UINT},
+    {"LOCALIP4", SETTING_UINT},
+    {"LOWPASSFILTER", SETTING_BOOL},
+    {"MAXCHARGEAMP", SETTING_UINT},
+    {"MAXDISCHARGEAMP", SETTING_UINT},
+    {"MAXPERCENTAGE", SETTING_UINT},
+    {"MAXPREFREQ", SETTING_UINT},
+    {"MAXPRETIME", SETTING_UINT},
+    {"MINPERCENTAGE", SETTING_INT},
+    {"MQTTCELLFMT", SETTING_UINT},
+    {"MQTTCELLV", SETTING_BOOL},
+    {"MQTTDBCELL", SETTING_UINT},
+    {"MQTTDELTA", SETTING_BOOL},
+    {"MQTTDEVICENAME", SETTING_STRING},
+    {"MQTTENABLED", SETTING_BOOL},
+    {"MQTTOBJIDPREFIX", SETTING_STRING},
+    {"MQTTPASSWORD", SETTING_STRING},
+    {"MQTTPORT", SETTING_UINT},
+    {"MQTTPUBLISHMS", SETTING_UINT},
+    {"MQTTREFRESH", SETTING_UINT},
+    {"MQTTSERVER", SETTING_STRING},
+    {"MQTTTIMEOUT", SETTING_UINT},
+    {"MQTTTOPIC", SETTING_STRING},
+    {"MQTTTOPICS", SETTING_BOOL},
+    {"MQTTUSER", SETTING_STRING},
+    {"NCCONTACTOR", SETTING_BOOL},
+    {"NOINVDISC", SETTING_BOOL},
+    {"PASSWORD", SETTING_STRING},
+    {"PERBMSRESET", SETTING_BOOL},
+    {"PERFPROFILE", SETTING_BOOL},
+    {"PRECHGMS", SETTING_UINT},
+    {"PRIMOGEN24", SETTING_BOOL},
+    {"PWMCNTCTRL", SETTING_BOOL},
+    {"PWMFREQ", SETTING_UINT},
+    {"PWMHOLD", SETTING_UINT},
+    {"PYLONBAUD", SETTING_UINT},
+    {"PYLONBRAND", SETTING_UINT},
+    {"PYLONOFFSET", SETTING_BOOL},
+    {"PYLONORDER", SETTING_BOOL},
+    {"PYLONSEND", SETTING_UINT},
+    {"RAMPDOWNSOC", SETTING_UINT},
+    {"REMBMSRESET", SETTING_BOOL},
+    {"SDLOGENABLED", SETTING_BOOL},
+    {"SHUNTCOMM", SETTING_UINT},
+    {"SHUNTTYPE", SETTING_UINT},
+    {"SOCESTIMATED", SETTING_BOOL},
+    {"SOFAR_ID", SETTING_UINT},
+    {"SSID", SETTING_STRING},
+    {"STATICIP", SETTING_BOOL},
+    {"SUBNET1", SETTING_UINT},
+    {"SUBNET2", SETTING_UINT},
+    {"SUBNET3", SETTING_UINT},
+    {"SUBNET4", SETTING_UINT},
+    {"TARGETCHVOLT", SETTING_UINT},
+    {"TARGETDISCHVOLT", SETTING_UINT},
+    {"TRIBTR", SETTING_BOOL},
+    {"USBENABLED", SETTING_BOOL},
+    {"USEVOLTLIMITS", SETTING_BOOL},
+    {"USE_SCALED_SOC", SETTING_BOOL},
+    {"WEBAUTH", SETTING_BOOL},
+    {"WEBENABLED", SETTING_BOOL},
+    {"WEBPUSHMS", SETTING_UINT},
+    {"WIFIAPENABLED", SETTING_BOOL},
+    {"WIFICHANNEL", SETTING_UINT},
+    {"HISTDRAMKB", SETTING_UINT},
+};
+
+const uint16_t settings_schema_fields = sizeof(settings_schema) / sizeof(settings_schema[0]);
+
+SettingsBlob settings_blob;
+
+#ifdef UNIT_TEST
+static std::recursive_mutex settings_mutex;
+#else
+static StaticSemaphore_t settings_mutex_buffer;
+static SemaphoreHandle_t settings_mutex = xSemaphoreCreateRecursiveMutexStatic(&settings_mutex_buffer);
+#endif
+
+void lock_settings() {
+#ifdef UNIT_TEST
+  settings_mutex.lock();
+#else
+  xSemaphoreTakeRecursive(settings_mutex, portMAX_DELAY);
+#endif
+}
+
+void unlock_settings() {
+#ifdef UNIT_TEST
+  settings_mutex.unlock();
+#else
+  xSemaphoreGiveRecursive(settings_mutex);
+#endif
+}
+
+SettingsBlob::SettingsBlob()
+    : states(settings_schema_fields, SETTING_ABSENT),
+      numbers(settings_schema_fields, 0),
+      strings(settings_schema_fields) {}
+
+void SettingsBlob::load(Preferences& prefs) {
+  reads = 0;
+  uint16_t fields = 0;
+  reads++;
+  if (prefs.isKey(SETTINGS_BLOB_KEY)) {
+    reads += 2;
+    std::vector<uint8_t> data(prefs.getBytesLength(SETTINGS_BLOB_KEY));
+    if (!data.empty() && prefs.getBytes(SETTINGS_BLOB_KEY, data.data(), data.size()) == data.size()) {
+      fields = deserialize(data.data(), data.size());
+    }
+    if (fields == 0) {
+      // Settings saved since the blob was introduced are lost, the own keys hold the values from before that
+      DEBUG_PRINTF("Settings blob of %u bytes failed its CRC or version check, using the settings in their own keys\n",
+                   (unsigned)data.size());
+      set_event(EVENT_PERSISTENT_SAVE_INFO, SETTINGS_BLOB_REJECTED);
+    }
+  }
+
+  // Migrate what the blob does not hold from the per-key layout
+  for (uint16_t field = fields; field < settings_schema_fields; field++) {
+    read_own_key(prefs, field);
+  }
+  source = fields == settings_schema_fields ? SETTINGS_FROM_BLOB : SETTINGS_FROM_KEYS;
+  changed = fields < settings_schema_fields;
+}
+
+void SettingsBlob::read_own_key(Preferences& prefs, int field) {
+  const Setting_Field& schema = settings_schema[field];
+  states[field] = SETTING_ABSENT;
+  numbers[field] = 0;
+  strings[field].clear();
+  reads++;
+  if (!prefs.isKey(schema.key)) {
+    return;
+  }
+  reads++;
+  states[field] = SETTING_STORED;
+  switch (schema.type) {
+    case SETTING_BOOL:
+      numbers[field] = prefs.getBool(schema.key, false);
+      break;
+    case SETTING_INT:
+      numbers[field] = (uint32_t)prefs.getInt(schema.key, 0);
+      break;
+    case SETTING_UINT:
+      numbers[field] = prefs.getUInt(schema.key, 0);
+      break;
+    case SETTING_STRING:
+      if (!set_text(field, prefs.getString(schema.key, "").c_str())) {
+        set_own_key(field);
+      }
+      break;
+  }
+}
+
+bool SettingsBlob::commit(Preferences& prefs) {
+  if (!changed) {
+    return true;
+  }
+  std::vector<uint8_t> data;
+  serialize(data, settings_schema_fields);
+  if (prefs.putBytes(SETTINGS_BLOB_KEY, data.data(), data.size()) != data.size()) {
+    return false;
+  }
+  changed = false;
+  return true;
+}
+
+void SettingsBlob::clear() {
+  for (uint16_t field = 0; field < settings_schema_fields; field++) {
+    states[field] = SETTING_ABSENT;
+    numbers[field] = 0;
+    strings[field].clear();
+  }
+  changed = false;
+}
+
+int SettingsBlob::find(const char* key) const {
+  for (uint16_t field = 0; field < settings_schema_fields; field++) {
+    if (strcmp(settings_schema[field].key, key) == 0) {
+      return field;
+    }
+  }
+  return -1;
+}
+
+void SettingsBlob::set_number(int field, uint32_t value) {
+  if (states[field] != SETTING_STORED || numbers[field] != value) {
+    states[field] = SETTING_STORED;
+    numbers[field] = value;
+    changed = true;
+  }
+}
+
+bool SettingsBlob::set_text(int field, const char* value) {
+  if (strlen(value) > SETTINGS_STRING_MAX_LENGTH) {
+    return false;
+  }
+  if (states[field] != SETTING_STORED || strings[field] != value) {
+    states[field] = SETTING_STORED;
+    strings[field] = value;
+    changed = true;
+  }
+  return true;
+}
+
+void SettingsBlob::set_own_key(int field) {
+  if (states[field] != SETTING_OWN_KEY) {
+    states[field] = SETTING_OWN_KEY;
+    strings[field].clear();
+    changed = true;
+  }
+}
+
+void SettingsBlob::serialize(std::vector<uint8_t>& out, uint16_t fields) const {
+  out.assign(sizeof(Settings_Blob_Header), 0);
+  out.insert(out.end(), states.begin(), states.begin() + fields);
+  for (uint16_t field = 0; field < fields; field++) {
+    if (settings_schema[field].type == SETTING_STRING) {
+      out.push_back((uint8_t)strings[field].size());
+      out.insert(out.end(), strings[field].begin(), strings[field].end());
+    } else {
+      const uint8_t* bytes = (const uint8_t*)&numbers[field];
+      out.insert(out.end(), bytes, bytes + sizeof(uint32_t));
+    }
+  }
+
+  Settings_Blob_Header header;
+  header.magic = SETTINGS_BLOB_MAGIC;
+  header.version = SETTINGS_BLOB_VERSION;
+  header.fields = fields;
+  header.length = out.size() - sizeof(header);
+  header.crc = crc32_ieee(out.data() + sizeof(header), header.length);
+  memcpy(out.data(), &header, sizeof(header));
+}
+
+uint16_t SettingsBlob::deserialize(const uint8_t* data, size_t length) {
+  Settings_Blob_Header header;
+  if (length < sizeof(header)) {
+    return 0;
+  }
+  memcpy(&header, data, sizeof(header));
+  const uint8_t* body = data + sizeof(header);
+  if (header.magic != SETTINGS_BLOB_MAGIC || header.version != SETTINGS_BLOB_VERSION ||
+      header.length != length - sizeof(header) || header.crc != crc32_ieee(body, header.length)) {
+    return 0;
+  }
+
+  // Fields beyond our schema come from newer firmware and are dropped
+  const uint16_t fields = header.fields < settings_schema_fields ? header.fields : settings_schema_fields;
+  if (header.length < header.fields) {
+    return 0;
+  }
+  const uint8_t* value = body + header.fields;
+  const uint8_t* end = body + header.length;
+  for (uint16_t field = 0; field < fields; field++) {
+    if (body[field] > SETTING_OWN_KEY) {
+      return 0;
+    }
+    states[field] = (Setting_State)body[field];
+    if (settings_schema[field].type == SETTING_STRING) {
+      if (value >= end || end - (value + 1) < value[0]) {
+        return 0;
+      }
+      strings[field].assign((const char*)value + 1, value[0]);
+      value += 1 + value[0];
+    } else {
+      if (end - value < (ptrdiff_t)sizeof(uint32_t)) {
+        return 0;
+      }
+      memcpy(&numbers[field], value, sizeof(uint32_t));
+      value += sizeof(uint32_t);
+    }
+  }
+  return fields;
+}
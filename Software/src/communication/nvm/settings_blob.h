@@ -0,0 +1,138 @@
+#ifndef _SETTINGS_BLOB_H_
+#define _SETTINGS_BLOB_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class Preferences;
+
+// Key of the blob in the settings namespace, next to the keys of the older per-key layout
+#define SETTINGS_BLOB_KEY "SETTINGSBLOB"
+#define SETTINGS_BLOB_MAGIC 0x42534542
+// Bumped when the encoding of the fields changes. Fields appended to the schema need no new version.
+#define SETTINGS_BLOB_VERSION 1
+// Longest string kept in the blob, longer strings stay in a key of their own
+#define SETTINGS_STRING_MAX_LENGTH 255
+// Data of EVENT_PERSISTENT_SAVE_INFO when a stored blob was not valid. 0 and 1 mean the namespace could not be opened
+// or saved.
+#define SETTINGS_BLOB_REJECTED 2
+
+enum Setting_Type : uint8_t { SETTING_BOOL, SETTING_INT, SETTING_UINT, SETTING_STRING };
+
+enum Setting_State : uint8_t {
+  /** Never saved, reading it gives the default of the caller */
+  SETTING_ABSENT,
+  /** Value is in the blob */
+  SETTING_STORED,
+  /** String too long for the blob, kept in its own key */
+  SETTING_OWN_KEY
+};
+
+enum Settings_Source : uint8_t {
+  SETTINGS_NOT_LOADED,
+  /** The blob held every field */
+  SETTINGS_FROM_BLOB,
+  /** Some or all fields were read from their own keys: first boot after an update, or the blob was invalid */
+  SETTINGS_FROM_KEYS
+};
+
+typedef struct {
+  /** Key in the settings namespace, at most 15 characters */
+  const char* key;
+  Setting_Type type;
+} Setting_Field;
+
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  /** Fields in the blob, a blob written by older firmware has fewer */
+  uint16_t fields;
+  /** Bytes after the header */
+  uint32_t length;
+  /** crc32_ieee of the bytes after the header */
+  uint32_t crc;
+} Settings_Blob_Header;
+
+// All settings in one NVS blob instead of one key each.
+//
+// Every known setting has a fixed position in settings_schema. The blob holds a state byte per field, followed by
+// the values in schema order: four bytes for numbers and booleans, a length byte and the characters for strings.
+// The header carries a version and a CRC, a blob that does not pass both is ignored.
+//
+// Loading reads the blob with one lookup. Fields that are not in the blob, because it was written by firmware with a
+// shorter schema or is missing or invalid, are read from their own keys as before and the blob is marked for
+// writing. Those keys are left in place but are no longer written: after a downgrade, older firmware finds the
+// settings as they were before the upgrade, and changes made since are lost.
+//
+// Changes are kept in memory until commit(), which writes the whole blob with one put. NVS replaces a blob only once
+// the new one is completely written, so a reset during a save leaves either all old or all new settings.
+//
+// Settings are saved from the core task, the MQTT task and the web server. Every access goes through lock_settings(),
+// see BatteryEmulatorSettingsStore.
+class SettingsBlob {
+ public:
+  SettingsBlob();
+
+  void load(Preferences& prefs);
+
+  // Write the blob if anything changed since it was loaded or committed
+  bool commit(Preferences& prefs);
+
+  // Forget all values, after the namespace was cleared
+  void clear();
+
+  bool loaded() const { return source != SETTINGS_NOT_LOADED; }
+  Settings_Source loaded_from() const { return source; }
+  // NVS lookups made by load()
+  uint16_t load_reads() const { return reads; }
+  bool dirty() const { return changed; }
+
+  // Position of the key in settings_schema, -1 for keys that only exist in the per-key layout
+  int find(const char* key) const;
+
+  Setting_State state(int field) const { return states[field]; }
+  uint32_t number(int field) const { return numbers[field]; }
+  const std::string& text(int field) const { return strings[field]; }
+
+  void set_number(int field, uint32_t value);
+  // Returns false if the string is too long for the blob, the caller keeps it in its own key
+  bool set_text(int field, const char* value);
+  void set_own_key(int field);
+
+  // Encode the first fields of the schema, fewer than all only to stand in for older firmware
+  void serialize(std::vector<uint8_t>& out, uint16_t fields) const;
+  // Decode a blob, returns the number of fields it held or 0 if it is not valid
+  uint16_t deserialize(const uint8_t* data, size_t length);
+
+ private:
+  void read_own_key(Preferences& prefs, int field);
+
+  std::vector<Setting_State> states;
+  std::vector<uint32_t> numbers;
+  std::vector<std::string> strings;
+  Settings_Source source = SETTINGS_NOT_LOADED;
+  uint16_t reads = 0;
+  bool changed = false;
+};
+
+extern const Setting_Field settings_schema[];
+extern const uint16_t settings_schema_fields;
+
+// Shared by every BatteryEmulatorSettingsStore, loaded by the first one
+extern SettingsBlob settings_blob;
+
+// Recursive lock of settings_blob, a task may take it again while it holds it
+void lock_settings();
+void unlock_settings();
+
+class SettingsLock {
+ public:
+  SettingsLock() { lock_settings(); }
+  ~SettingsLock() { unlock_settings(); }
+  SettingsLock(const SettingsLock&) = delete;
+  SettingsLock& operator=(const SettingsLock&) = delete;
+};
+
+#endif
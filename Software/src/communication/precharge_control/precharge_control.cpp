@@ -69,7 +69,9 @@ void handle_precharge_control(unsigned long currentMillis) {
   }
 
   int32_t target_voltage = datalayer.battery.status.voltage_dV;
-  int32_t external_voltage = datalayer_extended.meb.BMS_voltage_intermediate_dV;
+  // Only the MEB battery measures the voltage after its contactors
+  int32_t external_voltage =
+      datalayer_extended.meb.allocated() ? datalayer_extended.meb->BMS_voltage_intermediate_dV : 0;
 
   switch (datalayer.system.status.precharge_status) {
     case AUTO_PRECHARGE_IDLE:
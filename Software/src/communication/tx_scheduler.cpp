@@ -0,0 +1,175 @@
+#include "tx_scheduler.h"
+
+#include <Arduino.h>
+#include "../devboard/utils/latency_histogram.h"
+#include "Transmitter.h"
+
+TxScheduler tx_scheduler;
+
+static const uint8_t NO_JOB = TX_SCHEDULER_MAX_JOBS;
+
+static uint32_t gcd(uint32_t a, uint32_t b) {
+  while (b != 0) {
+    uint32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+Transmitter::~Transmitter() {
+  if (has_scheduled_jobs) {
+    tx_scheduler.remove(this);
+  }
+}
+
+void Transmitter::transmit_every(uint16_t period_ms, uint8_t frames, Tx_Callback callback) {
+  if (tx_scheduler.add(this, period_ms, frames, callback)) {
+    has_scheduled_jobs = true;
+  }
+}
+
+TxScheduler::TxScheduler() {
+  clear();
+}
+
+void TxScheduler::clear() {
+  for (auto& job : table) {
+    job.owner = nullptr;
+    job.callback = nullptr;
+  }
+  for (auto& slot : slots) {
+    slot = NO_JOB;
+  }
+  jobs = 0;
+}
+
+uint16_t TxScheduler::pick_phase(uint16_t period_ms, uint8_t frames) const {
+  // Two jobs coincide every lcm(period, other period) ms if their phases are equal modulo the gcd of the periods.
+  // Prefer the first due time where the coinciding frames per ms are lowest.
+  uint16_t candidates = period_ms < TX_SCHEDULER_MAX_PHASE_MS ? period_ms : TX_SCHEDULER_MAX_PHASE_MS;
+  uint16_t best = 0;
+  float best_cost = 0;
+  for (uint16_t offset = 0; offset < candidates; offset++) {
+    uint32_t due = last_tick + 1 + offset;
+    float cost = 0;
+    for (const auto& job : table) {
+      if (job.owner == nullptr) {
+        continue;
+      }
+      int32_t divisor = gcd(period_ms, job.period_ms);
+      if ((int32_t)(due - job.due) % divisor == 0) {
+        cost += (float)(frames + job.frames) * divisor / ((uint32_t)period_ms * job.period_ms);
+      }
+    }
+    if (offset == 0 || cost < best_cost) {
+      best = offset;
+      best_cost = cost;
+      if (cost == 0) {
+        break;
+      }
+    }
+  }
+  return best;
+}
+
+bool TxScheduler::add(Transmitter* owner, uint16_t period_ms, uint8_t frames, Tx_Callback callback) {
+  if (period_ms == 0 || jobs == TX_SCHEDULER_MAX_JOBS) {
+    return false;
+  }
+  if (!started) {
+    last_tick = millis();
+  }
+
+  uint8_t index = 0;
+  while (table[index].owner != nullptr) {
+    index++;
+  }
+  Job& job = table[index];
+  job.due = last_tick + 1 + pick_phase(period_ms, frames);
+  job.owner = owner;
+  job.callback = callback;
+  job.period_ms = period_ms;
+  job.frames = frames;
+  insert(index);
+  jobs++;
+  return true;
+}
+
+void TxScheduler::insert(uint8_t index) {
+  uint8_t& head = slots[table[index].due % TX_SCHEDULER_WHEEL_SLOTS];
+  table[index].next = head;
+  head = index;
+}
+
+void TxScheduler::unlink(uint8_t index) {
+  uint8_t* link = &slots[table[index].due % TX_SCHEDULER_WHEEL_SLOTS];
+  while (*link != NO_JOB) {
+    if (*link == index) {
+      *link = table[index].next;
+      return;
+    }
+    link = &table[*link].next;
+  }
+}
+
+void TxScheduler::remove(Transmitter* owner) {
+  for (uint8_t i = 0; i < TX_SCHEDULER_MAX_JOBS; i++) {
+    if (table[i].owner == owner) {
+      unlink(i);
+      table[i].owner = nullptr;
+      table[i].callback = nullptr;
+      jobs--;
+    }
+  }
+}
+
+void TxScheduler::record_lateness(const Job& job, uint32_t now) {
+  Latency_Stage stage = job.period_ms < 50    ? LATENCY_TX_10MS
+                        : job.period_ms < 500 ? LATENCY_TX_100MS
+                                              : LATENCY_TX_1S;
+  latency_histogram_record(latency_histograms[stage], (int64_t)(now - job.due) * 1000);
+}
+
+void TxScheduler::run(unsigned long currentMillis) {
+  uint32_t now = currentMillis;
+  if (!started) {
+    started = true;
+    if ((int32_t)(now - last_tick) <= 0) {
+      last_tick = now - 1;
+    }
+  }
+  uint32_t ticks = now - last_tick;
+  if (ticks == 0 || ticks > INT32_MAX) {
+    return;
+  }
+  // After a stall every slot is visited once, jobs that are overdue run straight away
+  if (ticks > TX_SCHEDULER_WHEEL_SLOTS) {
+    ticks = TX_SCHEDULER_WHEEL_SLOTS;
+  }
+  last_tick = now;
+
+  for (uint32_t tick = now - ticks + 1; ticks > 0; tick++, ticks--) {
+    uint8_t& slot = slots[tick % TX_SCHEDULER_WHEEL_SLOTS];
+    uint8_t index = slot;
+    slot = NO_JOB;
+
+    while (index != NO_JOB) {
+      Job& job = table[index];
+      uint8_t next = job.next;
+      if ((int32_t)(job.due - now) <= 0) {
+        record_lateness(job, now);
+        job.due += job.period_ms;
+        if ((int32_t)(job.due - now) <= 0) {
+          // Skip the periods that were missed, keeping the phase
+          job.due += ((now - job.due) / job.period_ms + 1) * job.period_ms;
+        }
+        if (job.owner->transmit_allowed()) {
+          job.callback(now);
+        }
+      }
+      insert(index);
+      index = next;
+    }
+  }
+}
@@ -0,0 +1,63 @@
+#ifndef _TX_SCHEDULER_H
+#define _TX_SCHEDULER_H
+
+#include <stdint.h>
+#include <functional>
+
+class Transmitter;
+
+#define TX_SCHEDULER_MAX_JOBS 64
+// 1 ms per slot. Jobs due further ahead than one revolution wait in their slot until their time comes.
+#define TX_SCHEDULER_WHEEL_SLOTS 128
+// Phases tried when staggering a new job, longer periods are placed within the first second
+#define TX_SCHEDULER_MAX_PHASE_MS 1000
+
+typedef std::function<void(unsigned long currentMillis)> Tx_Callback;
+
+// Runs the periodic transmit jobs of all integrations from the core loop. Jobs sit in a timer wheel, so a tick
+// only looks at the jobs of its own slot, and a transmitter whose frames are not due is not called at all.
+// New jobs get the phase where they coincide least with the jobs already there, which spreads the 10 ms,
+// 100 ms and 1 s frames of all integrations over different ticks instead of sending them in one burst.
+// How late jobs run is recorded in the LATENCY_TX_* histograms.
+class TxScheduler {
+ public:
+  TxScheduler();
+
+  // Call callback every period_ms (1-65535) for owner. frames is about how many frames the callback sends,
+  // it weighs the job when picking phases. Returns false if the job table is full.
+  bool add(Transmitter* owner, uint16_t period_ms, uint8_t frames, Tx_Callback callback);
+  // Drop all jobs of owner
+  void remove(Transmitter* owner);
+  void clear();
+
+  // Run the jobs that became due up to currentMillis. Callbacks must not add or remove jobs.
+  void run(unsigned long currentMillis);
+
+  uint8_t job_count() const { return jobs; }
+
+ private:
+  typedef struct {
+    Transmitter* owner;
+    Tx_Callback callback;
+    uint32_t due;
+    uint16_t period_ms;
+    uint8_t frames;
+    /** Next job in the same wheel slot, or TX_SCHEDULER_MAX_JOBS */
+    uint8_t next;
+  } Job;
+
+  uint16_t pick_phase(uint16_t period_ms, uint8_t frames) const;
+  void insert(uint8_t index);
+  void unlink(uint8_t index);
+  void record_lateness(const Job& job, uint32_t now);
+
+  Job table[TX_SCHEDULER_MAX_JOBS];
+  uint8_t slots[TX_SCHEDULER_WHEEL_SLOTS];
+  uint8_t jobs = 0;
+  uint32_t last_tick = 0;
+  bool started = false;
+};
+
+extern TxScheduler tx_scheduler;
+
+#endif
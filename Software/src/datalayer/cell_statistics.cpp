@@ -0,0 +1,63 @@
+#include "cell_statistics.h"
+#include "datalayer.h"
+
+Cell_Statistics compute_cell_statistics(const uint16_t* cells_mV, size_t count, uint16_t min_valid_mV) {
+  Cell_Statistics stats = {};
+
+  // Branch free, so the loop vectorises on the host and pipelines on the ESP32
+  uint16_t min_mV = UINT16_MAX;
+  uint16_t max_mV = 0;
+  uint32_t sum_mV = 0;
+  uint32_t valid = 0;
+  for (size_t i = 0; i < count; i++) {
+    uint16_t cell = cells_mV[i];
+    bool is_valid = cell >= min_valid_mV;
+    valid += is_valid;
+    sum_mV += is_valid ? cell : 0;
+    min_mV = (is_valid && cell < min_mV) ? cell : min_mV;
+    max_mV = (is_valid && cell > max_mV) ? cell : max_mV;
+  }
+  if (valid == 0) {
+    return stats;
+  }
+
+  stats.valid_cells = valid;
+  stats.min_mV = min_mV;
+  stats.max_mV = max_mV;
+  stats.deviation_mV = max_mV - min_mV;
+  stats.sum_mV = sum_mV;
+  stats.average_mV = (sum_mV + valid / 2) / valid;
+
+  // min_mV and max_mV are valid voltages, so a matching cell is always a valid one
+  bool min_found = false;
+  bool max_found = false;
+  for (size_t i = 0; i < count && !(min_found && max_found); i++) {
+    if (!min_found && cells_mV[i] == min_mV) {
+      stats.min_index = i;
+      min_found = true;
+    }
+    if (!max_found && cells_mV[i] == max_mV) {
+      stats.max_index = i;
+      max_found = true;
+    }
+  }
+  return stats;
+}
+
+uint16_t count_balancing_cells(const bool* balancing, size_t count) {
+  uint16_t cells = 0;
+  for (size_t i = 0; i < count; i++) {
+    cells += balancing[i] ? 1 : 0;
+  }
+  return cells;
+}
+
+void update_cell_statistics(DATALAYER_BATTERY_TYPE& battery) {
+  size_t cells = battery.info.number_of_cells;
+  if (cells > MAX_AMOUNT_CELLS) {
+    cells = MAX_AMOUNT_CELLS;
+  }
+  Cell_Statistics stats = compute_cell_statistics(battery.status.cell_voltages_mV, cells, 1);
+  stats.balancing_cells = count_balancing_cells(battery.status.cell_balancing_status, cells);
+  battery.status.cell_statistics = stats;
+}
@@ -0,0 +1,31 @@
+#ifndef _CELL_STATISTICS_H_
+#define _CELL_STATISTICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+  uint32_t sum_mV;
+  /** Cells with a reading, cells below the valid voltage are left out of all other fields */
+  uint16_t valid_cells;
+  uint16_t min_mV;
+  uint16_t max_mV;
+  /** Index of the first cell at min_mV and max_mV */
+  uint16_t min_index;
+  uint16_t max_index;
+  /** max_mV - min_mV */
+  uint16_t deviation_mV;
+  uint16_t average_mV;
+  /** Cells with their balancing resistor switched on */
+  uint16_t balancing_cells;
+} Cell_Statistics;
+
+// Min, max, sum and average of count cell voltages, in one pass that the compiler can vectorise. Cells below
+// min_valid_mV have not been read yet and are skipped, pass 0 to use every cell. All fields are 0 if no cell is
+// valid. The indices are found by a second scan that stops at the first cells with the extreme voltages.
+Cell_Statistics compute_cell_statistics(const uint16_t* cells_mV, size_t count, uint16_t min_valid_mV);
+
+// Amount of set flags in the balancing status of count cells
+uint16_t count_balancing_cells(const bool* balancing, size_t count);
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "../devboard/utils/types.h"
 #include "../system_settings.h"
+#include "cell_statistics.h"
 
 /*Note when editing this file. Order of datatypes matter heavily to keep padding and flash size in check*/
 
@@ -120,6 +121,8 @@ struct DATALAYER_BATTERY_STATUS_TYPE {
    * Not available for all battery manufacturers.
    */
   bool cell_balancing_status[MAX_AMOUNT_CELLS];
+  /** Min, max, average and balancing of the cells above, recalculated once per cycle by update_cell_statistics() */
+  Cell_Statistics cell_statistics = {};
 };
 
 struct DATALAYER_BATTERY_SETTINGS_TYPE {
@@ -203,6 +206,9 @@ typedef struct {
   DATALAYER_BATTERY_SETTINGS_TYPE settings;
 } DATALAYER_BATTERY_TYPE;
 
+// Recalculate status.cell_statistics from the cell voltages and balancing flags of the battery
+void update_cell_statistics(DATALAYER_BATTERY_TYPE& battery);
+
 struct DATALAYER_CHARGER_TYPE {
   /** Charger setpoint voltage */
   float charger_setpoint_HV_VDC = 0;
@@ -260,8 +266,6 @@ struct DATALAYER_SHUNT_TYPE {
 };
 
 struct DATALAYER_SYSTEM_INFO_TYPE {
-  /** array with incoming CAN messages, for displaying on webserver */
-  char logged_can_messages[15000] = {0};
   /** array with type of battery used, for displaying on webserver */
   char battery_protocol[64] = {0};
   /** array with type of battery used, for displaying on webserver */
@@ -269,7 +273,6 @@ struct DATALAYER_SYSTEM_INFO_TYPE {
   /** array with type of inverter brand used, for displaying on webserver */
   char inverter_brand[8] = {0};
 
-  size_t logged_can_messages_offset = 0;
   /** ESP32 main CPU temperature, for displaying on webserver and for safeties */
   float CPU_temperature = 0;
   /** ESP32 free heap amount, for displaying on webserver and for safeties */
@@ -277,6 +280,8 @@ struct DATALAYER_SYSTEM_INFO_TYPE {
 
   /** uint8_t, enumeration which CAN interface should be used for log playback */
   uint8_t can_replay_interface = CAN_NATIVE;
+  /** uint16_t, speed of log playback in percent of the logged rate */
+  uint16_t can_replay_speed_percent = 100;
 
   /** bool, determines if CAN messages should be logged for webserver */
   bool can_logging_active = false;
@@ -337,6 +342,8 @@ struct DATALAYER_SYSTEM_STATUS_TYPE {
    * This will show the performance of CAN TX when the total time reached a new worst case
    */
   int64_t time_snap_cantx_us = 0;
+  /** Time init_stored_settings took at boot */
+  int64_t settings_load_us = 0;
 
   /** uint8_t */
   /** A counter set each time a new message comes from inverter.
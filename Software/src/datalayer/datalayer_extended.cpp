@@ -1,3 +1,5 @@
 #include "datalayer_extended.h"
 
+std::atomic<uint32_t> datalayer_extended_allocated_bytes{0};
+
 DataLayerExtended datalayer_extended;
@@ -2,6 +2,7 @@
 #define _DATALAYER_EXTENDED_H_
 
 #include <stdint.h>
+#include <atomic>
 
 struct DATALAYER_INFO_BOLTAMPERA {
   /** uint16_t */
@@ -1012,32 +1013,84 @@ struct DATALAYER_INFO_ZOE_PH2 {
   bool UserRequestNVROLReset = false;
 };
 
+// Bytes held by the allocated DataLayerExtendedBlocks
+extern std::atomic<uint32_t> datalayer_extended_allocated_bytes;
+
+// The extended values of one battery type, on the heap once the battery that uses them is set up. Setup allocates
+// the blocks for the configured batteries, see allocate_datalayer_extended(). A block that is used without that,
+// for example by a battery created later, is allocated on first use instead. Whichever task gets there first wins
+// the allocation, the other task frees its own copy and uses the winner.
+template <typename T>
+class DataLayerExtendedBlock {
+ public:
+  DataLayerExtendedBlock() = default;
+  DataLayerExtendedBlock(const DataLayerExtendedBlock&) = delete;
+  DataLayerExtendedBlock& operator=(const DataLayerExtendedBlock&) = delete;
+
+  ~DataLayerExtendedBlock() {
+    T* block = info.load(std::memory_order_acquire);
+    if (block) {
+      datalayer_extended_allocated_bytes -= sizeof(T);
+      delete block;
+    }
+  }
+
+  T* get() {
+    T* block = info.load(std::memory_order_acquire);
+    return block ? block : allocate();
+  }
+
+  T* operator->() { return get(); }
+
+  bool allocated() const { return info.load(std::memory_order_acquire) != nullptr; }
+
+  T* allocate() {
+    T* existing = info.load(std::memory_order_acquire);
+    if (existing) {
+      return existing;
+    }
+    T* block = new T();
+    T* expected = nullptr;
+    if (!info.compare_exchange_strong(expected, block, std::memory_order_acq_rel)) {
+      delete block;
+      return expected;
+    }
+    datalayer_extended_allocated_bytes += sizeof(T);
+    return block;
+  }
+
+ private:
+  std::atomic<T*> info{nullptr};
+};
+
+// Values that only some battery types report, for their "More battery info" pages and MQTT. Only the blocks of the
+// batteries in use take memory, resolve them with -> or get().
 class DataLayerExtended {
  public:
-  DATALAYER_INFO_BOLTAMPERA boltampera;
-  DATALAYER_INFO_BOLTAMPERA boltampera_2;
-  DATALAYER_INFO_BMWPHEV bmwphev;
-  DATALAYER_INFO_BMWIX bmwix;
-  DATALAYER_INFO_BYDATTO3 bydAtto3;
-  DATALAYER_INFO_BYDATTO3 bydAtto3_2;
-  DATALAYER_INFO_CELLPOWER cellpower;
-  DATALAYER_INFO_CHADEMO chademo;
-  DATALAYER_INFO_CMFAEV CMFAEV;
-  DATALAYER_INFO_CMPSMART stellantisCMPsmart;
-  DATALAYER_INFO_ECMP stellantisECMP;
-  DATALAYER_INFO_FORD_MACH_E fordMachE;
-  DATALAYER_INFO_GEELY_GEOMETRY_C geometryC;
-  DATALAYER_INFO_KIAHYUNDAI64 KiaHyundai64;
-  DATALAYER_INFO_KIAHYUNDAI64 KiaHyundai64_2;
-  DATALAYER_INFO_RIVIAN rivian;
-  DATALAYER_INFO_TESLA tesla;
-  DATALAYER_INFO_NISSAN_LEAF nissanleaf;
-  DATALAYER_INFO_MEB meb;
-  DATALAYER_INFO_VOLVO_POLESTAR VolvoPolestar;
-  DATALAYER_INFO_VOLVO_HYBRID VolvoHybrid;
-  DATALAYER_INFO_GEELY_SEA GeelySEA;
-  DATALAYER_INFO_ZOE zoe;
-  DATALAYER_INFO_ZOE_PH2 zoePH2;
+  DataLayerExtendedBlock<DATALAYER_INFO_BOLTAMPERA> boltampera;
+  DataLayerExtendedBlock<DATALAYER_INFO_BOLTAMPERA> boltampera_2;
+  DataLayerExtendedBlock<DATALAYER_INFO_BMWPHEV> bmwphev;
+  DataLayerExtendedBlock<DATALAYER_INFO_BMWIX> bmwix;
+  DataLayerExtendedBlock<DATALAYER_INFO_BYDATTO3> bydAtto3;
+  DataLayerExtendedBlock<DATALAYER_INFO_BYDATTO3> bydAtto3_2;
+  DataLayerExtendedBlock<DATALAYER_INFO_CELLPOWER> cellpower;
+  DataLayerExtendedBlock<DATALAYER_INFO_CHADEMO> chademo;
+  DataLayerExtendedBlock<DATALAYER_INFO_CMFAEV> CMFAEV;
+  DataLayerExtendedBlock<DATALAYER_INFO_CMPSMART> stellantisCMPsmart;
+  DataLayerExtendedBlock<DATALAYER_INFO_ECMP> stellantisECMP;
+  DataLayerExtendedBlock<DATALAYER_INFO_FORD_MACH_E> fordMachE;
+  DataLayerExtendedBlock<DATALAYER_INFO_GEELY_GEOMETRY_C> geometryC;
+  DataLayerExtendedBlock<DATALAYER_INFO_KIAHYUNDAI64> KiaHyundai64;
+  DataLayerExtendedBlock<DATALAYER_INFO_KIAHYUNDAI64> KiaHyundai64_2;
+  DataLayerExtendedBlock<DATALAYER_INFO_RIVIAN> rivian;
+  DataLayerExtendedBlock<DATALAYER_INFO_TESLA> tesla;
+  DataLayerExtendedBlock<DATALAYER_INFO_NISSAN_LEAF> nissanleaf;
+  DataLayerExtendedBlock<DATALAYER_INFO_MEB> meb;
+  DataLayerExtendedBlock<DATALAYER_INFO_VOLVO_POLESTAR> VolvoPolestar;
+  DataLayerExtendedBlock<DATALAYER_INFO_VOLVO_HYBRID> VolvoHybrid;
+  DataLayerExtendedBlock<DATALAYER_INFO_GEELY_SEA> GeelySEA;
+  DataLayerExtendedBlock<DATALAYER_INFO_ZOE> zoe;
+  DataLayerExtendedBlock<DATALAYER_INFO_ZOE_PH2> zoePH2;
 };
 
 extern DataLayerExtended datalayer_extended;
@@ -0,0 +1,29 @@
+#include "datalayer_snapshot.h"
+
+static SeqLock<DataLayerSnapshot> snapshot;
+
+void publish_datalayer_snapshot(unsigned long currentMillis) {
+  snapshot.write_with([currentMillis](DataLayerSnapshot& target) {
+    target.battery = datalayer.battery;
+    target.battery2 = datalayer.battery2;
+    target.battery3 = datalayer.battery3;
+    target.shunt = datalayer.shunt;
+    target.charger = datalayer.charger;
+    target.published_ms = currentMillis;
+  });
+}
+
+void read_datalayer_snapshot(DataLayerSnapshot& out) {
+  snapshot.read(out);
+}
+
+void read_datalayer_snapshot_battery(uint8_t index, DATALAYER_BATTERY_TYPE& out) {
+  snapshot.read_with([index, &out](const DataLayerSnapshot& source) {
+    const DATALAYER_BATTERY_TYPE* batteries[] = {&source.battery, &source.battery2, &source.battery3};
+    memcpy(&out, batteries[index < 3 ? index : 0], sizeof(out));
+  });
+}
+
+uint32_t datalayer_snapshot_version() {
+  return snapshot.version();
+}
@@ -0,0 +1,33 @@
+#ifndef _DATALAYER_SNAPSHOT_H_
+#define _DATALAYER_SNAPSHOT_H_
+
+#include "../devboard/utils/seqlock.h"
+#include "datalayer.h"
+
+// Copy of the datalayer parts that the webserver, MQTT, display and ESP-NOW read from the other core. The core task
+// publishes it at the end of the values stage, so readers see the values of one update together instead of cell
+// voltages, voltage, current and power from different moments.
+typedef struct {
+  DATALAYER_BATTERY_TYPE battery;
+  DATALAYER_BATTERY_TYPE battery2;
+  DATALAYER_BATTERY_TYPE battery3;
+  DATALAYER_SHUNT_TYPE shunt;
+  DATALAYER_CHARGER_TYPE charger;
+  /** millis() when the snapshot was published, 0 before the first one */
+  uint32_t published_ms;
+} DataLayerSnapshot;
+
+// Copy the current datalayer into the snapshot. Called by the core task only.
+void publish_datalayer_snapshot(unsigned long currentMillis);
+
+// Copy the latest snapshot to out. Lock-free and safe from any task.
+void read_datalayer_snapshot(DataLayerSnapshot& out);
+
+// Copy only one battery of the latest snapshot, index 0 to 2. For readers that handle one battery at a time and do
+// not need room for the whole snapshot.
+void read_datalayer_snapshot_battery(uint8_t index, DATALAYER_BATTERY_TYPE& out);
+
+// Amount of snapshots published so far
+uint32_t datalayer_snapshot_version();
+
+#endif
@@ -0,0 +1,298 @@
+#include "telemetry_history.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <new>
+#include "../devboard/utils/logging.h"
+
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+#endif
+
+const char* const history_field_names[HISTORY_PACK_FIELDS] = {
+    "voltage_dV", "current_dA", "soc_pptt", "temperature_min_dC", "temperature_max_dC", "cell_min_mV", "cell_max_mV",
+};
+
+const uint16_t history_interval_s[HISTORY_RESOLUTIONS] = {1, 60, 900};
+
+// 15 minutes of 1 s entries, 24 hours of 1 min entries and 7 days of 15 min entries
+static const uint32_t history_full_entries[HISTORY_RESOLUTIONS] = {900, 1440, 672};
+
+TelemetryHistory telemetry_history;
+uint16_t telemetry_history_dram_kb = 0;
+
+static size_t align8(size_t bytes) {
+  return (bytes + 7) & ~(size_t)7;
+}
+
+size_t TelemetryHistory::bytes_for(const History_Config& config) {
+  const size_t fields = HISTORY_PACK_FIELDS + config.cells;
+  size_t bytes = 0;
+  for (uint8_t r = 0; r < HISTORY_RESOLUTIONS; r++) {
+    bytes += align8(config.entries[r] * sizeof(History_Entry));
+    bytes += align8(config.entries[r] * fields * sizeof(History_Value));
+  }
+  // Running min, max and sum of the coarser resolutions, and the sample filled by record()
+  bytes += (HISTORY_RESOLUTIONS - 1) * (2 * align8(fields * sizeof(int16_t)) + align8(fields * sizeof(int32_t)));
+  bytes += align8(fields * sizeof(int16_t));
+  return bytes;
+}
+
+History_Config history_config_for_budget(size_t budget_bytes, uint16_t cells) {
+  History_Config config = {};
+  config.cells = cells;
+  const size_t fixed = TelemetryHistory::bytes_for(config);
+  for (uint8_t r = 0; r < HISTORY_RESOLUTIONS; r++) {
+    config.entries[r] = history_full_entries[r];
+  }
+  const size_t full = TelemetryHistory::bytes_for(config);
+  if (full <= budget_bytes) {
+    return config;
+  }
+  if (budget_bytes <= fixed) {
+    return History_Config{{0, 0, 0}, cells};
+  }
+
+  for (uint8_t r = 0; r < HISTORY_RESOLUTIONS; r++) {
+    config.entries[r] = (uint64_t)history_full_entries[r] * (budget_bytes - fixed) / (full - fixed);
+  }
+  // Rounding up to the alignment can still go a few bytes over
+  while (TelemetryHistory::bytes_for(config) > budget_bytes && config.entries[0] > 0) {
+    for (uint8_t r = 0; r < HISTORY_RESOLUTIONS; r++) {
+      config.entries[r] -= config.entries[r] > 0 ? 1 : 0;
+    }
+  }
+  return config;
+}
+
+size_t history_dram_budget(size_t requested_bytes, size_t largest_free_block) {
+  const size_t budget = std::min({requested_bytes, (size_t)TELEMETRY_HISTORY_DRAM_MAX, largest_free_block / 4});
+  return budget < TELEMETRY_HISTORY_DRAM_FLOOR ? 0 : budget;
+}
+
+TelemetryHistory::~TelemetryHistory() {
+  // heap_caps_malloc memory is released by free() as well
+  free(memory);
+}
+
+static void* allocate_history(size_t bytes, bool psram) {
+#ifndef UNIT_TEST
+  if (psram) {
+    return heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+  }
+#endif
+  return malloc(bytes);
+}
+
+bool TelemetryHistory::begin(const History_Config& new_config, bool use_psram) {
+  if (enabled()) {
+    return false;
+  }
+  for (uint8_t r = 0; r < HISTORY_RESOLUTIONS; r++) {
+    if (new_config.entries[r] == 0) {
+      return false;
+    }
+  }
+  const size_t bytes = bytes_for(new_config);
+  uint8_t* block = (uint8_t*)allocate_history(bytes, use_psram);
+  if (block == nullptr) {
+    return false;
+  }
+  memset(block, 0, bytes);
+  config = new_config;
+  psram = use_psram;
+
+  const size_t field_count = fields();
+  uint8_t* next = block;
+  for (uint8_t r = 0; r < HISTORY_RESOLUTIONS; r++) {
+    History_Ring& ring = rings[r];
+    ring.entries = (History_Entry*)next;
+    for (uint32_t i = 0; i < config.entries[r]; i++) {
+      new (&ring.entries[i]) History_Entry();
+    }
+    next += align8(config.entries[r] * sizeof(History_Entry));
+    ring.values = (History_Value*)next;
+    next += align8(config.entries[r] * field_count * sizeof(History_Value));
+    ring.head.store(0, std::memory_order_relaxed);
+    ring.samples = 0;
+  }
+  for (uint8_t r = 1; r < HISTORY_RESOLUTIONS; r++) {
+    History_Ring& ring = rings[r];
+    ring.min = (int16_t*)next;
+    next += align8(field_count * sizeof(int16_t));
+    ring.max = (int16_t*)next;
+    next += align8(field_count * sizeof(int16_t));
+    ring.sum = (int32_t*)next;
+    next += align8(field_count * sizeof(int32_t));
+  }
+  sample = (int16_t*)next;
+  memory = block;
+  return true;
+}
+
+void TelemetryHistory::record(const DATALAYER_BATTERY_TYPE& battery, uint32_t time_s) {
+  if (!enabled()) {
+    return;
+  }
+  sample[HISTORY_VOLTAGE_DV] = battery.status.voltage_dV;
+  sample[HISTORY_CURRENT_DA] = battery.status.current_dA;
+  sample[HISTORY_SOC_PPTT] = battery.status.real_soc;
+  sample[HISTORY_TEMPERATURE_MIN_DC] = battery.status.temperature_min_dC;
+  sample[HISTORY_TEMPERATURE_MAX_DC] = battery.status.temperature_max_dC;
+  sample[HISTORY_CELL_MIN_MV] = battery.status.cell_min_voltage_mV;
+  sample[HISTORY_CELL_MAX_MV] = battery.status.cell_max_voltage_mV;
+
+  const uint16_t cells = std::min<uint16_t>(battery.info.number_of_cells, config.cells);
+  int16_t* cell_values = sample + HISTORY_PACK_FIELDS;
+  for (uint16_t i = 0; i < cells; i++) {
+    cell_values[i] = battery.status.cell_voltages_mV[i];
+  }
+  memset(cell_values + cells, 0, (config.cells - cells) * sizeof(int16_t));
+
+  record_values(sample, time_s);
+}
+
+void TelemetryHistory::reset_bucket(History_Ring& ring, uint32_t bucket) {
+  const uint16_t count = fields();
+  for (uint16_t f = 0; f < count; f++) {
+    ring.min[f] = INT16_MAX;
+    ring.max[f] = INT16_MIN;
+    ring.sum[f] = 0;
+  }
+  ring.bucket = bucket;
+}
+
+static int16_t rounded_average(int32_t sum, uint16_t samples) {
+  const int32_t half = samples / 2;
+  return (sum >= 0 ? sum + half : sum - half) / samples;
+}
+
+void TelemetryHistory::write_entry(uint8_t resolution, uint32_t time_s, uint16_t samples, const int16_t* min,
+                                   const int16_t* max, const int32_t* sum) {
+  History_Ring& ring = rings[resolution];
+  const uint32_t sequence = ring.head.load(std::memory_order_relaxed);
+  History_Entry& e = entry(resolution, sequence);
+
+  // Invalidate the entry before touching its contents, then publish it with its new sequence number
+  e.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  e.time_s = time_s;
+  e.samples = samples;
+  History_Value* values = entry_values(resolution, sequence);
+  const uint16_t count = fields();
+  for (uint16_t f = 0; f < count; f++) {
+    values[f].min = min[f];
+    values[f].max = max[f];
+    values[f].avg = sum ? rounded_average(sum[f], samples) : min[f];
+  }
+  e.sequence.store(sequence + 1, std::memory_order_release);
+  ring.head.store(sequence + 1, std::memory_order_release);
+}
+
+void TelemetryHistory::record_values(const int16_t* values, uint32_t time_s) {
+  if (!enabled()) {
+    return;
+  }
+  // The finest resolution keeps every sample as it is
+  write_entry(0, time_s, 1, values, values, nullptr);
+
+  const uint16_t count = fields();
+  for (uint8_t r = 1; r < HISTORY_RESOLUTIONS; r++) {
+    History_Ring& ring = rings[r];
+    const uint32_t bucket = time_s / history_interval_s[r];
+    if (ring.samples > 0 && bucket != ring.bucket) {
+      write_entry(r, ring.bucket * history_interval_s[r], ring.samples, ring.min, ring.max, ring.sum);
+      ring.samples = 0;
+    }
+    if (ring.samples == 0) {
+      reset_bucket(ring, bucket);
+    }
+    for (uint16_t f = 0; f < count; f++) {
+      const int16_t value = values[f];
+      ring.min[f] = value < ring.min[f] ? value : ring.min[f];
+      ring.max[f] = value > ring.max[f] ? value : ring.max[f];
+      ring.sum[f] += value;
+    }
+    ring.samples++;
+  }
+}
+
+uint32_t TelemetryHistory::end(uint8_t resolution) const {
+  if (memory == nullptr || resolution >= HISTORY_RESOLUTIONS) {
+    return 0;
+  }
+  return rings[resolution].head.load(std::memory_order_acquire);
+}
+
+uint32_t TelemetryHistory::oldest(uint8_t resolution) const {
+  const uint32_t head = end(resolution);
+  if (head == 0) {
+    return 0;
+  }
+  return head > config.entries[resolution] ? head - config.entries[resolution] : 0;
+}
+
+uint32_t TelemetryHistory::find(uint8_t resolution, uint32_t time_s) const {
+  uint32_t low = oldest(resolution);
+  uint32_t high = end(resolution);
+  while (low < high) {
+    const uint32_t middle = low + (high - low) / 2;
+    uint32_t entry_time_s;
+    uint16_t samples;
+    // An entry overwritten during the search is older than any that is still kept
+    if (!read(resolution, middle, entry_time_s, samples, nullptr, 0, 0) || entry_time_s < time_s) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+bool TelemetryHistory::read(uint8_t resolution, uint32_t sequence, uint32_t& time_s, uint16_t& samples,
+                            History_Value* values, uint16_t first_field, uint16_t count) const {
+  const uint32_t head = end(resolution);
+  if (sequence >= head || head - sequence > config.entries[resolution] || first_field + count > fields()) {
+    return false;
+  }
+  const History_Entry& e = entry(resolution, sequence);
+  if (e.sequence.load(std::memory_order_acquire) != sequence + 1) {
+    return false;
+  }
+  time_s = e.time_s;
+  samples = e.samples;
+  if (count > 0) {
+    memcpy(values, entry_values(resolution, sequence) + first_field, count * sizeof(History_Value));
+  }
+  // The copy only counts if nobody started rewriting the entry in the meantime
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return e.sequence.load(std::memory_order_relaxed) == sequence + 1;
+}
+
+void init_telemetry_history() {
+  bool psram = false;
+  size_t budget = 0;
+#ifndef UNIT_TEST
+  if (psramFound()) {
+    psram = true;
+    budget = std::min((size_t)TELEMETRY_HISTORY_PSRAM_BUDGET, heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 2);
+  } else if (telemetry_history_dram_kb > 0) {
+    budget = history_dram_budget((size_t)telemetry_history_dram_kb * 1024,
+                                 heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+  }
+#endif
+  if (budget == 0) {
+    DEBUG_PRINTF("Telemetry history off, no PSRAM and no internal RAM set aside for it\n");
+    return;
+  }
+  const History_Config config = history_config_for_budget(budget, psram ? MAX_AMOUNT_CELLS : 0);
+  if (!telemetry_history.begin(config, psram)) {
+    DEBUG_PRINTF("Telemetry history disabled, %u bytes not available\n", (unsigned)TelemetryHistory::bytes_for(config));
+    return;
+  }
+  DEBUG_PRINTF("Telemetry history uses %u bytes of %s: %u s, %u min and %u h\n",
+               (unsigned)telemetry_history.allocated_bytes(), psram ? "PSRAM" : "RAM", (unsigned)config.entries[0],
+               (unsigned)config.entries[1], (unsigned)(config.entries[2] / 4));
+}
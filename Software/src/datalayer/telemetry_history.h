@@ -0,0 +1,163 @@
+#ifndef _TELEMETRY_HISTORY_H_
+#define _TELEMETRY_HISTORY_H_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include "datalayer.h"
+
+// Resolutions kept by the history, finest first
+#define HISTORY_RESOLUTIONS 3
+// Memory used for the history when the board has PSRAM. Half of the free PSRAM is used if there is less.
+#define TELEMETRY_HISTORY_PSRAM_BUDGET (3 * 1024 * 1024)
+// Most internal RAM the history may use on boards without PSRAM, only the pack values are kept there
+#define TELEMETRY_HISTORY_DRAM_MAX (64 * 1024)
+// Less internal RAM than this holds too little history to be useful, the history then stays off
+#define TELEMETRY_HISTORY_DRAM_FLOOR (8 * 1024)
+
+// Pack values kept for every entry, followed by one field per cell voltage
+enum History_Field : uint8_t {
+  HISTORY_VOLTAGE_DV,
+  HISTORY_CURRENT_DA,
+  HISTORY_SOC_PPTT,
+  HISTORY_TEMPERATURE_MIN_DC,
+  HISTORY_TEMPERATURE_MAX_DC,
+  HISTORY_CELL_MIN_MV,
+  HISTORY_CELL_MAX_MV,
+  HISTORY_PACK_FIELDS
+};
+
+// Names of the pack fields, as used in the history JSON
+extern const char* const history_field_names[HISTORY_PACK_FIELDS];
+
+// Seconds covered by one entry at each resolution: 1 s, 1 min and 15 min
+extern const uint16_t history_interval_s[HISTORY_RESOLUTIONS];
+
+typedef struct {
+  int16_t min;
+  int16_t max;
+  int16_t avg;
+} History_Value;
+
+typedef struct {
+  /** Sequence number of the entry plus one, 0 while the entry is being written */
+  std::atomic<uint32_t> sequence;
+  /** Uptime in seconds at the start of the interval */
+  uint32_t time_s;
+  /** Samples aggregated into the entry */
+  uint16_t samples;
+  uint16_t reserved;
+} History_Entry;
+
+typedef struct {
+  /** Entries kept at each resolution */
+  uint32_t entries[HISTORY_RESOLUTIONS];
+  /** Cell voltages kept per entry, 0 for only the pack values */
+  uint16_t cells;
+} History_Config;
+
+// Entries per resolution for the given memory budget. Starts from 15 minutes of 1 s entries, 24 hours of 1 min
+// entries and 7 days of 15 min entries and shortens all three by the same factor until they fit.
+History_Config history_config_for_budget(size_t budget_bytes, uint16_t cells);
+
+// Internal RAM for the history on a board without PSRAM: what the user asked for, but at most a quarter of the
+// largest free block so WiFi, MQTT and the webserver keep room. 0 if that is below TELEMETRY_HISTORY_DRAM_FLOOR.
+size_t history_dram_budget(size_t requested_bytes, size_t largest_free_block);
+
+// Ring history of the pack values and cell voltages of one battery at three resolutions, with the min, max and
+// average of every value over each entry's interval.
+//
+// The core task records one sample per second. A sample is written straight into the 1 s ring and added to the
+// running min, max and sum of the coarser resolutions, which become an entry once their interval is over. That
+// is a fixed amount of work per sample, no matter how long the history is. All memory is allocated once by begin().
+//
+// Readers in other tasks copy entry by entry and check the sequence stamps before and after the copy, the same way
+// as LogRing, so entries that get overwritten during the copy are skipped instead of showing up torn.
+class TelemetryHistory {
+ public:
+  TelemetryHistory() = default;
+  TelemetryHistory(const TelemetryHistory&) = delete;
+  TelemetryHistory& operator=(const TelemetryHistory&) = delete;
+  ~TelemetryHistory();
+
+  // Bytes begin() allocates for the given config
+  static size_t bytes_for(const History_Config& config);
+
+  // Allocate the rings, from PSRAM if psram is set. Returns false if the memory is not available, the history then
+  // stays disabled and record() does nothing. Called once, before the first record().
+  bool begin(const History_Config& config, bool psram);
+
+  bool enabled() const { return memory != nullptr; }
+  bool in_psram() const { return psram; }
+  size_t allocated_bytes() const { return enabled() ? bytes_for(config) : 0; }
+
+  // Fields per entry, the pack values plus the cells
+  uint16_t fields() const { return HISTORY_PACK_FIELDS + config.cells; }
+  uint16_t cells() const { return config.cells; }
+  uint32_t capacity(uint8_t resolution) const { return config.entries[resolution]; }
+
+  // Add one sample of the battery. Called by the core task once per second, time_s must not go backwards.
+  void record(const DATALAYER_BATTERY_TYPE& battery, uint32_t time_s);
+
+  // Add one sample with fields() values
+  void record_values(const int16_t* values, uint32_t time_s);
+
+  // Sequence number of the next entry at the resolution, entries before it up to capacity() back can be read
+  uint32_t end(uint8_t resolution) const;
+
+  // Sequence number of the oldest entry still kept at the resolution
+  uint32_t oldest(uint8_t resolution) const;
+
+  // Sequence number of the first kept entry that starts at or after time_s, end() if there is none
+  uint32_t find(uint8_t resolution, uint32_t time_s) const;
+
+  // Copy count values starting at first_field of one entry. Returns false if the entry is not kept (anymore) or
+  // is being written.
+  bool read(uint8_t resolution, uint32_t sequence, uint32_t& time_s, uint16_t& samples, History_Value* values,
+            uint16_t first_field, uint16_t count) const;
+
+ private:
+  typedef struct {
+    History_Entry* entries;
+    History_Value* values;
+    /** Sequence number of the next entry */
+    std::atomic<uint32_t> head;
+    /** Running min, max and sum of the interval being collected, unused at the finest resolution */
+    int16_t* min;
+    int16_t* max;
+    int32_t* sum;
+    /** Interval being collected, time_s / interval */
+    uint32_t bucket;
+    uint16_t samples;
+  } History_Ring;
+
+  History_Entry& entry(uint8_t resolution, uint32_t sequence) const {
+    return rings[resolution].entries[sequence % config.entries[resolution]];
+  }
+  History_Value* entry_values(uint8_t resolution, uint32_t sequence) const {
+    return rings[resolution].values + (size_t)(sequence % config.entries[resolution]) * fields();
+  }
+  void write_entry(uint8_t resolution, uint32_t time_s, uint16_t samples, const int16_t* min, const int16_t* max,
+                   const int32_t* sum);
+  void reset_bucket(History_Ring& ring, uint32_t bucket);
+
+  History_Config config = {};
+  void* memory = nullptr;
+  bool psram = false;
+  History_Ring rings[HISTORY_RESOLUTIONS] = {};
+  /** One sample of the battery, filled by record() */
+  int16_t* sample = nullptr;
+};
+
+// Allocate the history of the first battery, in PSRAM with the cell voltages if the board has it. Without PSRAM a
+// short pack-only history is kept in internal RAM, only if telemetry_history_dram_kb asks for it. Called from
+// setup() after the settings are read and before the tasks that read the history are started.
+void init_telemetry_history();
+
+// kB of internal RAM for the history on boards without PSRAM, 0 keeps it off. Set from the settings.
+extern uint16_t telemetry_history_dram_kb;
+
+// History of the first battery, recorded by the core task and served by the webserver
+extern TelemetryHistory telemetry_history;
+
+#endif
@@ -0,0 +1,103 @@
+#include "ha_discovery.h"
+
+uint32_t ha_discovery_hash(const void* data, size_t length, uint32_t hash) {
+  // FNV-1a
+  const uint8_t* bytes = (const uint8_t*)data;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ bytes[i]) * 0x01000193;
+  }
+  return hash;
+}
+
+void HaDiscoveryPublisher::add_group(const char* name, std::function<size_t()> count, Builder build,
+                                     uint32_t stored_digest) {
+  Group group = {name, count, build, stored_digest};
+  start(group, stored_digest != 0 ? State::Verify : State::Publish);
+  groups.push_back(group);
+}
+
+void HaDiscoveryPublisher::start(Group& group, State state) {
+  group.state = state;
+  group.total = 0;
+  group.cursor = 0;
+  group.digest = seed;
+}
+
+bool HaDiscoveryPublisher::done() const {
+  for (const auto& group : groups) {
+    if (group.state != State::Done) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void HaDiscoveryPublisher::restart() {
+  for (auto& group : groups) {
+    group.stored_digest = 0;
+    start(group, State::Publish);
+  }
+}
+
+bool HaDiscoveryPublisher::run(const Publish& publish, const OutboxSize& outbox_size) {
+  size_t publishes = 0, builds = 0;
+  for (auto& group : groups) {
+    while (group.state != State::Done) {
+      if (group.cursor == 0) {
+        group.total = group.count();
+        if (group.total == 0) {
+          break;  // Not known yet, try the next group
+        }
+        uint32_t total = group.total;
+        group.digest = ha_discovery_hash(&total, sizeof(total), seed);
+      }
+
+      if (group.cursor == group.total) {
+        if (group.state == State::Verify) {
+          if (group.digest == group.stored_digest) {
+            stats.skipped += group.total;
+            group.state = State::Done;
+          } else {
+            start(group, State::Publish);
+          }
+          continue;
+        }
+        group.state = State::Done;
+        group.stored_digest = group.digest != 0 ? group.digest : 1;
+        if (on_group_published) {
+          on_group_published(group.name.c_str(), group.stored_digest);
+        }
+        continue;
+      }
+
+      if (builds >= builds_per_run) {
+        return false;
+      }
+      builds++;
+      topic.clear();
+      payload.clear();
+      bool applies = group.build(group.cursor, topic, payload);
+      uint32_t digest = ha_discovery_hash(topic.data(), topic.size(), group.digest);
+      digest = ha_discovery_hash(payload.data(), payload.size(), digest);
+
+      if (group.state == State::Publish && applies) {
+        if (publishes >= publishes_per_run) {
+          return false;
+        }
+        if (outbox_size() > outbox_limit) {
+          stats.deferred++;
+          return false;
+        }
+        if (!publish(topic.c_str(), payload.c_str())) {
+          stats.failed++;
+          return false;  // Retry this config on the next run
+        }
+        publishes++;
+        stats.published++;
+      }
+      group.digest = digest;
+      group.cursor++;
+    }
+  }
+  return done();
+}
@@ -0,0 +1,82 @@
+#ifndef __HA_DISCOVERY_H__
+#define __HA_DISCOVERY_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Publishes Home Assistant discovery configs a few at a time, so they do not flood the MQTT outbox at boot.
+//
+// Configs are organised in groups, such as the cell voltage sensors of one battery. Each run publishes at most a
+// fixed amount of configs and stops early while the outbox holds more than a limit, or when a publish fails. The
+// next run continues with the config that was not published. When a group is complete its digest, a hash over all
+// its topics and payloads, is handed to on_group_published so it can be stored. After a restart a group whose
+// configs still hash to the stored digest is skipped, since the broker already retains those configs.
+
+typedef struct {
+  uint32_t published;
+  /** Configs not sent since the broker already had them */
+  uint32_t skipped;
+  /** Runs that stopped early because the outbox was too full */
+  uint32_t deferred;
+  uint32_t failed;
+} HA_Discovery_Statistics;
+
+uint32_t ha_discovery_hash(const void* data, size_t length, uint32_t hash = 0x811C9DC5);
+
+class HaDiscoveryPublisher {
+ public:
+  // Writes config number index of a group to topic and payload. Returns false if the config does not apply.
+  typedef std::function<bool(size_t index, std::string& topic, std::string& payload)> Builder;
+  typedef std::function<bool(const char* topic, const char* payload)> Publish;
+  // Bytes waiting in the MQTT outbox
+  typedef std::function<size_t()> OutboxSize;
+
+  // seed is mixed into every digest, so a different broker or topic name publishes everything again
+  HaDiscoveryPublisher(uint32_t seed, size_t publishes_per_run, size_t builds_per_run, size_t outbox_limit)
+      : seed(seed), publishes_per_run(publishes_per_run), builds_per_run(builds_per_run), outbox_limit(outbox_limit) {}
+
+  // count returns how many configs the group has, 0 while that is not known yet. stored_digest is the digest saved
+  // from on_group_published, or 0 if the group was never published.
+  void add_group(const char* name, std::function<size_t()> count, Builder build, uint32_t stored_digest);
+
+  // Publish the next configs. Returns true once every group is complete.
+  bool run(const Publish& publish, const OutboxSize& outbox_size);
+
+  bool done() const;
+
+  // Publish every group again, for example when Home Assistant restarted and lost the retained configs
+  void restart();
+
+  const HA_Discovery_Statistics& statistics() const { return stats; }
+
+  std::function<void(const char* name, uint32_t digest)> on_group_published;
+
+ private:
+  enum class State { Verify, Publish, Done };
+
+  typedef struct {
+    std::string name;
+    std::function<size_t()> count;
+    Builder build;
+    uint32_t stored_digest;
+    State state;
+    size_t total;
+    size_t cursor;
+    uint32_t digest;
+  } Group;
+
+  void start(Group& group, State state);
+
+  uint32_t seed;
+  size_t publishes_per_run;
+  size_t builds_per_run;
+  size_t outbox_limit;
+  std::vector<Group> groups;
+  HA_Discovery_Statistics stats = {};
+  std::string topic, payload;
+};
+
+#endif
@@ -2,20 +2,25 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <freertos/FreeRTOS.h>
+#include <atomic>
 #include <src/communication/nvm/comm_nvm.h>
-#include <list>
 #include "../../battery/BATTERIES.h"
 #include "../../communication/contactorcontrol/comm_contactorcontrol.h"
 #include "../../datalayer/datalayer.h"
 #include "../../datalayer/datalayer_extended.h"
+#include "../../datalayer/datalayer_snapshot.h"
 #include "../../devboard/hal/hal.h"
 #include "../../devboard/safety/safety.h"
 #include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
 #include "../utils/events.h"
+#include "../utils/latency_histogram.h"
 #include "../utils/timer.h"
 #include "../webserver/webserver.h"
+#include "ha_discovery.h"
 #include "mqtt.h"
+#include "mqtt_cells.h"
 #include "mqtt_client.h"
+#include "mqtt_delta.h"
 
 std::string mqtt_user;
 std::string mqtt_password;
@@ -25,6 +30,12 @@ bool ha_autodiscovery_enabled = false;
 bool mqtt_transmit_all_cellvoltages = false;
 uint16_t mqtt_timeout_ms = 2000;
 uint16_t mqtt_publish_interval_ms = 5000;
+bool mqtt_delta_enabled = false;
+uint16_t mqtt_full_refresh_s = 300;
+uint16_t mqtt_cell_deadband_mV = 5;
+MqttCellFormat mqtt_cell_format = MqttCellFormat::Float;
+
+static_assert(MQTT_CELL_CHUNK_MAX_SIZE <= MQTT_MSG_BUFFER_SIZE, "A cell voltage chunk must fit in mqtt_msg");
 
 const int mqtt_port_default = 0;
 const char* mqtt_server_default = "";
@@ -52,6 +63,7 @@ esp_mqtt_client_config_t mqtt_cfg;
 esp_mqtt_client_handle_t client;
 char mqtt_msg[MQTT_MSG_BUFFER_SIZE];
 MyTimer publish_global_timer(0);  // Will be configured with mqtt_publish_interval_ms on first use
+MyTimer full_refresh_timer(0);   // Will be configured with mqtt_full_refresh_s on first use
 MyTimer check_global_timer(800);  // check timmer - low-priority MQTT checks, where responsiveness is not critical.
 bool client_started = false;
 static String lwt_topic = "";
@@ -65,9 +77,54 @@ static bool publish_common_info(void);
 static bool publish_cell_voltages(void);
 static bool publish_cell_balancing(void);
 static bool publish_events(void);
+static bool publish_latency(void);
+
+// Battery values of one core task update, taken once per publish so all messages agree with each other
+static DataLayerSnapshot snapshot;
+
+// How far a common info value may move before it is published again, when delta publishing is enabled.
+// The "_2" fields of the second battery use the same deadband.
+static const Mqtt_Deadband common_info_deadbands[] = {{"SOC", 0.1f, 0.0f},
+                                                      {"SOC_real", 0.1f, 0.0f},
+                                                      {"state_of_health", 0.1f, 0.0f},
+                                                      {"temperature_min", 0.5f, 0.0f},
+                                                      {"temperature_max", 0.5f, 0.0f},
+                                                      {"stat_batt_power", 50.0f, 0.02f},
+                                                      {"battery_current", 0.5f, 0.02f},
+                                                      {"battery_voltage", 0.5f, 0.0f},
+                                                      {"cell_max_voltage", 0.005f, 0.0f},
+                                                      {"cell_min_voltage", 0.005f, 0.0f},
+                                                      {"cell_voltage_delta", 5.0f, 0.0f},
+                                                      {"remaining_capacity_real", 50.0f, 0.0f},
+                                                      {"remaining_capacity", 50.0f, 0.0f},
+                                                      {"max_discharge_power", 100.0f, 0.02f},
+                                                      {"max_charge_power", 100.0f, 0.02f},
+                                                      {"charged_energy", 50.0f, 0.0f},
+                                                      {"discharged_energy", 50.0f, 0.0f},
+                                                      {"dc_dc_current", 0.5f, 0.0f},
+                                                      {"dc_dc_voltage", 0.2f, 0.0f},
+                                                      {"cpu_temp", 2.0f, 0.0f},
+                                                      {"emulator_uptime", 300.0f, 0.0f}};
+
+static MqttFieldDelta common_info_delta(common_info_deadbands,
+                                        sizeof(common_info_deadbands) / sizeof(common_info_deadbands[0]));
+// One per chunk of cells, the first one is used for the whole array in the Float format
+static MqttArrayDelta cell_voltages_delta[MAX_AMOUNT_CELLS / MQTT_CELLS_PER_CHUNK + 1];
+static MqttArrayDelta cell_voltages_delta_2[MAX_AMOUNT_CELLS / MQTT_CELLS_PER_CHUNK + 1];
+static MqttArrayDelta cell_balancing_delta, cell_balancing_delta_2;
+
+// True when every message is sent whole: delta publishing is off, or a periodic refresh for late subscribers is due
+static bool publish_full = true;
+// Set by the MQTT event handler on (re)connect, taken by the publish loop
+static std::atomic<bool> full_refresh_requested{true};
 
 /** Publish global values and call callbacks for specific modules */
 static void publish_values(void) {
+  read_datalayer_snapshot(snapshot);
+
+  // Taken in one step, so a request made while this publish runs is kept for the next one
+  const bool refresh_requested = full_refresh_requested.exchange(false);
+  publish_full = !mqtt_delta_enabled || refresh_requested || full_refresh_timer.elapsed();
 
   if (mqtt_publish((topic_name + "/status").c_str(), "online", false) == false) {
     return;
@@ -92,12 +149,14 @@ static void publish_values(void) {
       return;
     }
   }
+
+  if (datalayer.system.info.performance_measurement_active) {
+    if (publish_latency() == false) {
+      return;
+    }
+  }
 }
 
-static bool ha_common_info_published = false;
-static bool ha_cell_voltages_published = false;
-static bool ha_events_published = false;
-static bool ha_buttons_published = false;
 struct SensorConfig {
   const char* default_entity_id;
   const char* name;
@@ -116,11 +175,10 @@ static std::function<bool(Battery*)> supports_charged = [](Battery* b) {
   return b->supports_charged_energy();
 };
 static std::function<bool(Battery*)> supports_tesla_dcdc_metrics = [](Battery* b) {
-  return b != nullptr && (user_selected_battery_type == BatteryType::TeslaModel3Y ||
-                          user_selected_battery_type == BatteryType::TeslaModelSX);
+  return b != nullptr && b->tesla_info() != nullptr;
 };
 static std::function<bool(Battery*)> supports_byd_autocal_metrics = [](Battery* b) {
-  return b != nullptr && user_selected_battery_type == BatteryType::BydAtto3;
+  return b != nullptr && b->byd_atto3_info() != nullptr;
 };
 
 SensorConfig batterySensorConfigTemplate[] = {
@@ -158,17 +216,25 @@ SensorConfig globalSensorConfigTemplate[] = {{"bms_status", "BMS Status", "", ""
                                              {"emulator_uptime", "Emulator Uptime", "", "s", "duration", always},
                                              {"cpu_temp", "CPU Temperature", "", "°C", "temperature", always}};
 
-static std::list<SensorConfig> sensorConfigs;
+static std::vector<SensorConfig> sensorConfigs;
+
+// With delta publishing a field may be missing from a message, the sensor then keeps its previous state
+static std::string value_template_for(const std::string& field) {
+  if (mqtt_delta_enabled) {
+    return "{{ value_json." + field + " if value_json." + field + " is defined else this.state }}";
+  }
+  return "{{ value_json." + field + " }}";
+}
 
 void create_battery_sensor_configs() {
   for (auto& config : batterySensorConfigTemplate) {
-    config.value_template = strdup(("{{ value_json." + std::string(config.default_entity_id) + " }}").c_str());
+    config.value_template = strdup(value_template_for(config.default_entity_id).c_str());
 
     sensorConfigs.push_back(config);
 
     if (battery2) {
       auto original_condition = config.condition;
-      config.value_template = strdup(("{{ value_json." + std::string(config.default_entity_id) + "_2 }}").c_str());
+      config.value_template = strdup(value_template_for(std::string(config.default_entity_id) + "_2").c_str());
       config.name = strdup(String(config.name + String(" 2")).c_str());
       config.default_entity_id = strdup(String(config.default_entity_id + String("_2")).c_str());
       config.condition = [original_condition](Battery*) {
@@ -182,7 +248,7 @@ void create_battery_sensor_configs() {
 
 void create_global_sensor_configs() {
   for (auto& config : globalSensorConfigTemplate) {
-    config.value_template = strdup(("{{ value_json." + std::string(config.default_entity_id) + " }}").c_str());
+    config.value_template = strdup(value_template_for(config.default_entity_id).c_str());
     sensorConfigs.push_back(config);
   }
 }
@@ -232,9 +298,13 @@ void set_battery_voltage_attributes(JsonDocument& doc, int i, int cellNumber, co
   doc["unique_id"] = topic_name + default_entity_id_prefix + "_battery_voltage_cell" + String(cellNumber);
   doc["device_class"] = "voltage";
   doc["state_class"] = "measurement";
-  doc["state_topic"] = state_topic;
+  if (mqtt_cell_format == MqttCellFormat::Float) {
+    doc["state_topic"] = state_topic;
+  } else {
+    doc["state_topic"] = state_topic + "/" + String(i / MQTT_CELLS_PER_CHUNK);
+  }
   doc["unit_of_measurement"] = "V";
-  doc["value_template"] = "{{ value_json.cell_voltages[" + String(i) + "] }}";
+  doc["value_template"] = mqtt_cell_value_template(mqtt_cell_format, i);
 }
 
 static String generateButtonTopic(const char* subtype) {
@@ -259,7 +329,7 @@ static const char* get_balancing_status_text(balancing_status_enum status) {
 }
 
 void set_battery_attributes(JsonDocument& doc, const DATALAYER_BATTERY_TYPE& battery, const String& suffix,
-                            bool supports_charged) {
+                            Battery* instance) {
   doc["SOC" + suffix] = ((float)battery.status.reported_soc) / 100.0f;
   doc["SOC_real" + suffix] = ((float)battery.status.real_soc) / 100.0f;
   doc["state_of_health" + suffix] = ((float)battery.status.soh_pptt) / 100.0f;
@@ -280,31 +350,23 @@ void set_battery_attributes(JsonDocument& doc, const DATALAYER_BATTERY_TYPE& bat
   doc["max_discharge_power" + suffix] = ((float)battery.status.max_discharge_power_W);
   doc["max_charge_power" + suffix] = ((float)battery.status.max_charge_power_W);
 
-  if (supports_charged) {
-    if (datalayer.battery.status.total_charged_battery_Wh != 0 &&
-        datalayer.battery.status.total_discharged_battery_Wh != 0) {
-      doc["charged_energy" + suffix] = ((float)datalayer.battery.status.total_charged_battery_Wh);
-      doc["discharged_energy" + suffix] = ((float)datalayer.battery.status.total_discharged_battery_Wh);
+  if (instance->supports_charged_energy()) {
+    if (snapshot.battery.status.total_charged_battery_Wh != 0 &&
+        snapshot.battery.status.total_discharged_battery_Wh != 0) {
+      doc["charged_energy" + suffix] = ((float)snapshot.battery.status.total_charged_battery_Wh);
+      doc["discharged_energy" + suffix] = ((float)snapshot.battery.status.total_discharged_battery_Wh);
     }
   }
 
   // Add balancing data
-  uint16_t active_cells = 0;
-  if (battery.info.number_of_cells != 0u) {
-    for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
-      if (battery.status.cell_balancing_status[i]) {
-        active_cells++;
-      }
-    }
-  }
-  doc["balancing_active_cells" + suffix] = active_cells;
+  doc["balancing_active_cells" + suffix] = battery.status.cell_statistics.balancing_cells;
   doc["balancing_status" + suffix] = get_balancing_status_text(battery.status.balancing_status);
-  if (suffix.length() == 0u && supports_tesla_dcdc_metrics(::battery)) {
-    doc["dc_dc_current" + suffix] = static_cast<float>(datalayer_extended.tesla.battery_dcdcLvOutputCurrent) * 0.1f;
-    doc["dc_dc_voltage" + suffix] = static_cast<float>(datalayer_extended.tesla.battery_dcdcLvBusVolt) * 0.0390625f;
+  if (const DATALAYER_INFO_TESLA* tesla = instance->tesla_info()) {
+    doc["dc_dc_current" + suffix] = static_cast<float>(tesla->battery_dcdcLvOutputCurrent) * 0.1f;
+    doc["dc_dc_voltage" + suffix] = static_cast<float>(tesla->battery_dcdcLvBusVolt) * 0.0390625f;
   }
-  if (supports_byd_autocal_metrics(::battery)) {
-    const DATALAYER_INFO_BYDATTO3& byd = (suffix == "_2") ? datalayer_extended.bydAtto3_2 : datalayer_extended.bydAtto3;
+  if (const DATALAYER_INFO_BYDATTO3* info = instance->byd_atto3_info()) {
+    const DATALAYER_INFO_BYDATTO3& byd = *info;
     doc["autocal_taper" + suffix] = byd.autocal_crit_taper;
     doc["autocal_dwell_s" + suffix] = byd.autocal_dwell_accumulated_ms / 1000u;
     doc["autocal_cooldown_ready" + suffix] = byd.autocal_crit_cooldown_ready;
@@ -318,157 +380,154 @@ static bool publish_common_info(void) {
   static JsonDocument doc;
   static String state_topic = topic_name + "/info";
 
-  //  if(ha_autodiscovery_enabled) {
-
-  if (ha_autodiscovery_enabled && !ha_common_info_published) {
-    for (auto& config : sensorConfigs) {
-      if (!config.condition(battery)) {
-        continue;
-      }
-
-      doc["name"] = config.name;
-      doc["state_topic"] = state_topic;
-      doc["unique_id"] = topic_name + "_" + String(config.default_entity_id);
-      const String default_entity_object_id = default_entity_id_prefix + String(config.default_entity_id);
-      doc["default_entity_id"] = generateSensorDefaultEntityId(default_entity_object_id);
-      doc["value_template"] = config.value_template;
-      if (config.unit != nullptr && strlen(config.unit) > 0) {
-        doc["unit_of_measurement"] = config.unit;
-      }
-      if (config.device_class != nullptr && strlen(config.device_class) > 0) {
-        doc["device_class"] = config.device_class;
-        doc["state_class"] = "measurement";
-      }
-      set_common_discovery_attributes(doc);
-      serializeJson(doc, mqtt_msg);
-      if (mqtt_publish(generateCommonInfoAutoConfigTopic(config.default_entity_id).c_str(), mqtt_msg, true)) {
-        ha_common_info_published = true;
-      } else {
-        return false;
-      }
-      doc.clear();
-    }
+  doc["bms_status"] = getBMSStatus(datalayer.system.status.system_status);
+  doc["pause_status"] = get_emulator_pause_status();
 
-  } else {
-    doc["bms_status"] = getBMSStatus(datalayer.system.status.system_status);
-    doc["pause_status"] = get_emulator_pause_status();
+  //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
+  if (snapshot.battery.status.CAN_battery_still_alive && allowed_to_send_CAN && esp32hal->system_booted_up()) {
+    set_battery_attributes(doc, snapshot.battery, "", battery);
+  }
 
+  if (battery2) {
     //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
-    if (datalayer.battery.status.CAN_battery_still_alive && allowed_to_send_CAN && esp32hal->system_booted_up()) {
-      set_battery_attributes(doc, datalayer.battery, "", battery->supports_charged_energy());
+    if (snapshot.battery2.status.CAN_battery_still_alive && allowed_to_send_CAN && esp32hal->system_booted_up()) {
+      set_battery_attributes(doc, snapshot.battery2, "_2", battery2);
     }
+  }
 
-    if (battery2) {
-      //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
-      if (datalayer.battery2.status.CAN_battery_still_alive && allowed_to_send_CAN && esp32hal->system_booted_up()) {
-        set_battery_attributes(doc, datalayer.battery2, "_2", battery2->supports_charged_energy());
-      }
-    }
+  doc["event_level"] = get_event_level_string(get_event_level());
+  doc["emulator_status"] = get_emulator_status_string(get_emulator_status());
+  doc["cpu_temp"] = (int)(datalayer.system.info.CPU_temperature + 0.5);
+  doc["emulator_uptime"] = millis64() / 1000;
 
-    doc["event_level"] = get_event_level_string(get_event_level());
-    doc["emulator_status"] = get_emulator_status_string(get_emulator_status());
-    doc["cpu_temp"] = (int)(datalayer.system.info.CPU_temperature + 0.5);
-    doc["emulator_uptime"] = millis64() / 1000;
+  size_t full_size = measureJson(doc);
+  if (!common_info_delta.filter(doc.as<JsonObject>(), publish_full)) {
+    mqtt_delta_count(false, full_size);
+    doc.clear();
+    return true;
+  }
 
-    serializeJson(doc, mqtt_msg);
-    if (mqtt_publish(state_topic.c_str(), mqtt_msg, false) == false) {
-      logging.println("Common info MQTT msg could not be sent");
+  size_t size = serializeJson(doc, mqtt_msg);
+  if (mqtt_publish(state_topic.c_str(), mqtt_msg, false) == false) {
+    logging.println("Common info MQTT msg could not be sent");
+    common_info_delta.reset();
+    return false;
+  }
+  mqtt_delta_count(true, size);
+  mqtt_delta_statistics.bytes_saved += full_size - size;
+  doc.clear();
+  return true;
+}
+
+// Cell voltages of one battery in a compact format, one message per chunk of cells on <topic>/<chunk number>.
+// A chunk is sent whole when any of its cells moved more than the cell deadband.
+static bool publish_cell_voltage_chunks(const DATALAYER_BATTERY_TYPE& battery, const String& topic,
+                                        MqttArrayDelta* deltas) {
+  uint16_t deadband = mqtt_delta_enabled ? mqtt_cell_deadband_mV : 0;
+  size_t cells = battery.info.number_of_cells;
+  for (size_t chunk = 0; chunk < mqtt_cell_chunk_count(cells); chunk++) {
+    MqttArrayDelta& delta = deltas[chunk];
+    size_t first = chunk * MQTT_CELLS_PER_CHUNK;
+    size_t count = std::min<size_t>(MQTT_CELLS_PER_CHUNK, cells - first);
+    if (!delta.changed(battery.status.cell_voltages_mV + first, count, deadband, publish_full)) {
+      mqtt_delta_count(false, delta.last_size);
+      continue;
+    }
+
+    const uint16_t* cells_mV = battery.status.cell_voltages_mV;
+    size_t size = mqtt_encode_cell_chunk(mqtt_cell_format, cells_mV, cells, chunk, mqtt_msg, sizeof(mqtt_msg));
+    if (!mqtt_publish((topic + "/" + String(chunk)).c_str(), mqtt_msg, false)) {
+      logging.println("Cell voltage MQTT msg could not be sent");
+      delta.reset();
       return false;
     }
-    doc.clear();
+    mqtt_delta_count(true, size);
+    delta.last_size = size;
   }
   return true;
 }
 
+// All cell voltages of one battery, sent whole when any cell moved more than the cell deadband
+static bool publish_cell_voltage_state(JsonDocument& doc, const DATALAYER_BATTERY_TYPE& battery, const String& topic,
+                                       MqttArrayDelta* deltas) {
+  // If cell voltages have been populated...
+  if (battery.info.number_of_cells == 0u || battery.status.cell_voltages_mV[battery.info.number_of_cells - 1] == 0u) {
+    return true;
+  }
+
+  if (mqtt_cell_format != MqttCellFormat::Float) {
+    return publish_cell_voltage_chunks(battery, topic, deltas);
+  }
+
+  MqttArrayDelta& delta = deltas[0];
+  uint16_t deadband = mqtt_delta_enabled ? mqtt_cell_deadband_mV : 0;
+  if (!delta.changed(battery.status.cell_voltages_mV, battery.info.number_of_cells, deadband, publish_full)) {
+    mqtt_delta_count(false, delta.last_size);
+    return true;
+  }
+
+  JsonArray cell_voltages = doc["cell_voltages"].to<JsonArray>();
+  for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
+    cell_voltages.add(((float)battery.status.cell_voltages_mV[i]) / 1000.0f);
+  }
+
+  size_t size = serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+  doc.clear();
+
+  if (!mqtt_publish(topic.c_str(), mqtt_msg, false)) {
+    logging.println("Cell voltage MQTT msg could not be sent");
+    delta.reset();
+    return false;
+  }
+  mqtt_delta_count(true, size);
+  delta.last_size = size;
+  return true;
+}
+
 static bool publish_cell_voltages(void) {
   static JsonDocument doc;
   static String state_topic = topic_name + "/spec_data";
   static String state_topic_2 = topic_name + "/spec_data_2";
 
-  if (ha_autodiscovery_enabled) {
-    bool successfully_published = false;
-    if (ha_cell_voltages_published == false) {
-
-      // If the cell voltage number isn't initialized...
-      if (datalayer.battery.info.number_of_cells != 0u) {
-
-        for (int i = 0; i < datalayer.battery.info.number_of_cells; i++) {
-          int cellNumber = i + 1;
-          set_battery_voltage_attributes(doc, i, cellNumber, state_topic, default_entity_id_prefix, "");
-          set_common_discovery_attributes(doc);
-
-          serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
-          if (mqtt_publish(generateCellVoltageAutoConfigTopic(cellNumber, "").c_str(), mqtt_msg, true) == false) {
-            return false;
-          }
-        }
-        successfully_published = true;
-        doc.clear();  // clear after sending autoconfig
-      }
-
-      if (battery2) {
-        successfully_published = false;
-        // TODO: Combine this identical block with the previous one.
-        // If the cell voltage number isn't initialized...
-        if (datalayer.battery2.info.number_of_cells != 0u) {
-
-          for (int i = 0; i < datalayer.battery2.info.number_of_cells; i++) {
-            int cellNumber = i + 1;
-            set_battery_voltage_attributes(doc, i, cellNumber, state_topic_2, default_entity_id_prefix + "2_", " 2");
-            set_common_discovery_attributes(doc);
-
-            serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
-            if (mqtt_publish(generateCellVoltageAutoConfigTopic(cellNumber, "_2_").c_str(), mqtt_msg, true) == false) {
-              return false;
-            }
-          }
-          successfully_published = true;
-          doc.clear();  // clear after sending autoconfig
-        }
-      }
-    }
-    if (successfully_published) {
-      ha_cell_voltages_published = true;
+  if (!publish_cell_voltage_state(doc, snapshot.battery, state_topic, cell_voltages_delta)) {
+    return false;
+  }
+  if (battery2) {
+    if (!publish_cell_voltage_state(doc, snapshot.battery2, state_topic_2, cell_voltages_delta_2)) {
+      return false;
     }
   }
+  return true;
+}
 
-  // If cell voltages have been populated...
-  if (datalayer.battery.info.number_of_cells != 0u &&
-      datalayer.battery.status.cell_voltages_mV[datalayer.battery.info.number_of_cells - 1] != 0u) {
-
-    JsonArray cell_voltages = doc["cell_voltages"].to<JsonArray>();
-    for (size_t i = 0; i < datalayer.battery.info.number_of_cells; ++i) {
-      cell_voltages.add(((float)datalayer.battery.status.cell_voltages_mV[i]) / 1000.0f);
-    }
+// All balancing flags of one battery, sent whole when any flag changed
+static bool publish_cell_balancing_state(JsonDocument& doc, const DATALAYER_BATTERY_TYPE& battery, const String& topic,
+                                         MqttArrayDelta& delta) {
+  // If cell balancing data is available...
+  if (battery.info.number_of_cells == 0u) {
+    return true;
+  }
 
-    serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+  if (!delta.changed(battery.status.cell_balancing_status, battery.info.number_of_cells, publish_full)) {
+    mqtt_delta_count(false, delta.last_size);
+    return true;
+  }
 
-    if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false)) {
-      logging.println("Cell voltage MQTT msg could not be sent");
-      return false;
-    }
-    doc.clear();
+  JsonArray cell_balancing = doc["cell_balancing"].to<JsonArray>();
+  for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
+    cell_balancing.add(battery.status.cell_balancing_status[i]);
   }
 
-  if (battery2) {
-    // If cell voltages have been populated...
-    if (datalayer.battery2.info.number_of_cells != 0u &&
-        datalayer.battery2.status.cell_voltages_mV[datalayer.battery2.info.number_of_cells - 1] != 0u) {
-
-      JsonArray cell_voltages = doc["cell_voltages"].to<JsonArray>();
-      for (size_t i = 0; i < datalayer.battery2.info.number_of_cells; ++i) {
-        cell_voltages.add(((float)datalayer.battery2.status.cell_voltages_mV[i]) / 1000.0f);
-      }
-
-      serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
-
-      if (!mqtt_publish(state_topic_2.c_str(), mqtt_msg, false)) {
-        logging.println("Cell voltage MQTT msg could not be sent");
-        return false;
-      }
-      doc.clear();
-    }
+  size_t size = serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+  doc.clear();
+
+  if (!mqtt_publish(topic.c_str(), mqtt_msg, false)) {
+    logging.println("Cell balancing MQTT msg could not be sent");
+    delta.reset();
+    return false;
   }
+  mqtt_delta_count(true, size);
+  delta.last_size = size;
   return true;
 }
 
@@ -477,136 +536,231 @@ static bool publish_cell_balancing(void) {
   static String state_topic = topic_name + "/balancing_data";
   static String state_topic_2 = topic_name + "/balancing_data_2";
 
-  // If cell balancing data is available...
-  if (datalayer.battery.info.number_of_cells != 0u) {
+  if (!publish_cell_balancing_state(doc, snapshot.battery, state_topic, cell_balancing_delta)) {
+    return false;
+  }
+  // Handle second battery if available
+  if (battery2) {
+    if (!publish_cell_balancing_state(doc, snapshot.battery2, state_topic_2, cell_balancing_delta_2)) {
+      return false;
+    }
+  }
+  return true;
+}
 
-    JsonArray cell_balancing = doc["cell_balancing"].to<JsonArray>();
-    for (size_t i = 0; i < datalayer.battery.info.number_of_cells; ++i) {
-      cell_balancing.add(datalayer.battery.status.cell_balancing_status[i]);
+bool publish_events() {
+  static JsonDocument doc;
+  static String state_topic = topic_name + "/events";
+  const EVENTS_STRUCT_TYPE* event_pointer;
+
+  //clear the vector
+  order_events.clear();
+  // Collect all events
+  for (int i = 0; i < EVENT_NOF_EVENTS; i++) {
+    event_pointer = get_event_pointer((EVENTS_ENUM_TYPE)i);
+    if (event_pointer->occurences > 0 && !event_pointer->MQTTpublished) {
+      order_events.push_back({static_cast<EVENTS_ENUM_TYPE>(i), event_pointer});
     }
+  }
+  // Sort events by timestamp
+  std::sort(order_events.begin(), order_events.end(), compareEventsByTimestampAsc);
 
-    serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+  for (const auto& event : order_events) {
 
+    EVENTS_ENUM_TYPE event_handle = event.event_handle;
+    event_pointer = event.event_pointer;
+
+    doc["event_type"] = String(get_event_enum_string(event_handle));
+    doc["severity"] = String(get_event_level_string(event_handle));
+    doc["count"] = String(event_pointer->occurences);
+    doc["data"] = String(event_pointer->data);
+    doc["message"] = get_event_message_string(event_handle);
+    doc["millis"] = String(event_pointer->timestamp);
+
+    serializeJson(doc, mqtt_msg);
     if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false)) {
-      logging.println("Cell balancing MQTT msg could not be sent");
+      logging.println("Common info MQTT msg could not be sent");
       return false;
+    } else {
+      set_event_MQTTpublished(event_handle);
     }
     doc.clear();
+    //clear the vector
+    order_events.clear();
   }
+  return true;
+}
 
-  // Handle second battery if available
-  if (battery2) {
-    if (datalayer.battery2.info.number_of_cells != 0u) {
+static bool publish_latency(void) {
+  static JsonDocument doc;
+  static String state_topic = topic_name + "/latency";
+
+  latency_histograms_to_json(doc.to<JsonObject>());
+  serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+  doc.clear();
+  if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false)) {
+    logging.println("Latency MQTT msg could not be sent");
+    return false;
+  }
+  return true;
+}
 
-      JsonArray cell_balancing = doc["cell_balancing"].to<JsonArray>();
-      for (size_t i = 0; i < datalayer.battery2.info.number_of_cells; ++i) {
-        cell_balancing.add(datalayer.battery2.status.cell_balancing_status[i]);
-      }
+// Discovery configs are published at most this many per check interval, and not while the outbox holds more
+// than the limit in bytes, so the state messages keep flowing while hundreds of cell sensors are announced
+#define HA_DISCOVERY_PUBLISHES_PER_RUN 8
+#define HA_DISCOVERY_BUILDS_PER_RUN 32
+#define HA_DISCOVERY_OUTBOX_LIMIT 8192
+#define HA_STATUS_TOPIC "homeassistant/status"
 
-      serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+static HaDiscoveryPublisher* ha_discovery = nullptr;
+// Set from the MQTT event task when Home Assistant comes online, handled by the MQTT loop
+static volatile bool ha_discovery_restart_requested = false;
 
-      if (!mqtt_publish(state_topic_2.c_str(), mqtt_msg, false)) {
-        logging.println("Cell balancing MQTT msg could not be sent");
-        return false;
-      }
-      doc.clear();
-    }
+static bool build_sensor_discovery(size_t index, std::string& topic, std::string& payload) {
+  static JsonDocument doc;
+  const SensorConfig& config = sensorConfigs[index];
+  if (!config.condition(battery)) {
+    return false;
   }
+
+  doc["name"] = config.name;
+  doc["state_topic"] = topic_name + "/info";
+  doc["unique_id"] = topic_name + "_" + String(config.default_entity_id);
+  const String default_entity_object_id = default_entity_id_prefix + String(config.default_entity_id);
+  doc["default_entity_id"] = generateSensorDefaultEntityId(default_entity_object_id);
+  doc["value_template"] = config.value_template;
+  if (config.unit != nullptr && strlen(config.unit) > 0) {
+    doc["unit_of_measurement"] = config.unit;
+  }
+  if (config.device_class != nullptr && strlen(config.device_class) > 0) {
+    doc["device_class"] = config.device_class;
+    doc["state_class"] = "measurement";
+  }
+  set_common_discovery_attributes(doc);
+  topic = generateCommonInfoAutoConfigTopic(config.default_entity_id).c_str();
+  serializeJson(doc, payload);
+  doc.clear();
   return true;
 }
 
-bool publish_events() {
+static bool build_cell_voltage_discovery(size_t index, std::string& topic, std::string& payload, bool second) {
   static JsonDocument doc;
-  static String state_topic = topic_name + "/events";
-  if (ha_autodiscovery_enabled && !ha_events_published) {
+  int cellNumber = index + 1;
+  if (second) {
+    set_battery_voltage_attributes(doc, index, cellNumber, topic_name + "/spec_data_2", default_entity_id_prefix + "2_",
+                                   " 2");
+  } else {
+    set_battery_voltage_attributes(doc, index, cellNumber, topic_name + "/spec_data", default_entity_id_prefix, "");
+  }
+  set_common_discovery_attributes(doc);
+  topic = generateCellVoltageAutoConfigTopic(cellNumber, second ? "_2_" : "").c_str();
+  serializeJson(doc, payload);
+  doc.clear();
+  return true;
+}
 
-    doc["name"] = "Event";
-    doc["state_topic"] = state_topic;
-    doc["unique_id"] = topic_name + "_event";
-    doc["default_entity_id"] = generateSensorDefaultEntityId(default_entity_id_prefix + "event");
-    doc["value_template"] =
-        "{{ value_json.event_type ~ ' (c:' ~ value_json.count ~ ',m:' ~  value_json.millis ~ ') ' ~ value_json.message "
-        "}}";
-    doc["json_attributes_topic"] = state_topic;
-    doc["json_attributes_template"] = "{{ value_json | tojson }}";
-    set_common_discovery_attributes(doc);
-    serializeJson(doc, mqtt_msg);
-    if (mqtt_publish(generateEventsAutoConfigTopic("event").c_str(), mqtt_msg, true)) {
-      ha_events_published = true;
-    } else {
-      return false;
-    }
+static bool build_event_discovery(size_t index, std::string& topic, std::string& payload) {
+  static JsonDocument doc;
+  String state_topic = topic_name + "/events";
+  doc["name"] = "Event";
+  doc["state_topic"] = state_topic;
+  doc["unique_id"] = topic_name + "_event";
+  doc["default_entity_id"] = generateSensorDefaultEntityId(default_entity_id_prefix + "event");
+  doc["value_template"] =
+      "{{ value_json.event_type ~ ' (c:' ~ value_json.count ~ ',m:' ~  value_json.millis ~ ') ' ~ value_json.message "
+      "}}";
+  doc["json_attributes_topic"] = state_topic;
+  doc["json_attributes_template"] = "{{ value_json | tojson }}";
+  set_common_discovery_attributes(doc);
+  topic = generateEventsAutoConfigTopic("event").c_str();
+  serializeJson(doc, payload);
+  doc.clear();
+  return true;
+}
 
-    doc.clear();
-  } else {
-    const EVENTS_STRUCT_TYPE* event_pointer;
+static bool build_button_discovery(size_t index, std::string& topic, std::string& payload) {
+  static JsonDocument doc;
+  const SensorConfig& config = buttonConfigs[index];
+  doc["name"] = config.name;
+  doc["unique_id"] = default_entity_id_prefix + config.default_entity_id;
+  doc["command_topic"] = generateButtonTopic(config.default_entity_id);
+  set_common_discovery_attributes(doc);
+  topic = generateButtonAutoConfigTopic(config.default_entity_id).c_str();
+  serializeJson(doc, payload);
+  doc.clear();
+  return true;
+}
 
-    //clear the vector
-    order_events.clear();
-    // Collect all events
-    for (int i = 0; i < EVENT_NOF_EVENTS; i++) {
-      event_pointer = get_event_pointer((EVENTS_ENUM_TYPE)i);
-      if (event_pointer->occurences > 0 && !event_pointer->MQTTpublished) {
-        order_events.push_back({static_cast<EVENTS_ENUM_TYPE>(i), event_pointer});
-      }
-    }
-    // Sort events by timestamp
-    std::sort(order_events.begin(), order_events.end(), compareEventsByTimestampAsc);
-
-    for (const auto& event : order_events) {
-
-      EVENTS_ENUM_TYPE event_handle = event.event_handle;
-      event_pointer = event.event_pointer;
-
-      doc["event_type"] = String(get_event_enum_string(event_handle));
-      doc["severity"] = String(get_event_level_string(event_handle));
-      doc["count"] = String(event_pointer->occurences);
-      doc["data"] = String(event_pointer->data);
-      doc["message"] = get_event_message_string(event_handle);
-      doc["millis"] = String(event_pointer->timestamp);
-
-      serializeJson(doc, mqtt_msg);
-      if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false)) {
-        logging.println("Common info MQTT msg could not be sent");
-        return false;
-      } else {
-        set_event_MQTTpublished(event_handle);
-      }
-      doc.clear();
-      //clear the vector
-      order_events.clear();
-    }
+// The digests of completely published groups are kept in their own namespace, apart from the user settings
+static uint32_t stored_discovery_digest(const char* group) {
+  Preferences digests;
+  if (!digests.begin("haDiscovery", true)) {
+    return 0;
   }
-  return true;
+  uint32_t digest = digests.getUInt(group, 0);
+  digests.end();
+  return digest;
 }
 
-static bool publish_buttons_discovery(void) {
-  if (ha_autodiscovery_enabled) {
-    if (ha_buttons_published == false) {
-      logging.println("Publishing buttons discovery");
-
-      static JsonDocument doc;
-      for (int i = 0; i < sizeof(buttonConfigs) / sizeof(buttonConfigs[0]); i++) {
-        SensorConfig& config = buttonConfigs[i];
-        doc["name"] = config.name;
-        doc["unique_id"] = default_entity_id_prefix + config.default_entity_id;
-        doc["command_topic"] = generateButtonTopic(config.default_entity_id);
-        set_common_discovery_attributes(doc);
-        serializeJson(doc, mqtt_msg);
-        if (mqtt_publish(generateButtonAutoConfigTopic(config.default_entity_id).c_str(), mqtt_msg, true)) {
-          ha_buttons_published = true;
-        } else {
-          return false;
-        }
-        doc.clear();
-      }
+static void store_discovery_digest(const char* group, uint32_t digest) {
+  Preferences digests;
+  if (digests.begin("haDiscovery", false)) {
+    digests.putUInt(group, digest);
+    digests.end();
+  }
+  logging.printf("HA discovery for %s published\n", group);
+}
+
+static void setup_ha_discovery() {
+  uint32_t seed = ha_discovery_hash(mqtt_server.data(), mqtt_server.size());
+  seed = ha_discovery_hash(&mqtt_port, sizeof(mqtt_port), seed);
+  ha_discovery = new HaDiscoveryPublisher(seed, HA_DISCOVERY_PUBLISHES_PER_RUN, HA_DISCOVERY_BUILDS_PER_RUN,
+                                          HA_DISCOVERY_OUTBOX_LIMIT);
+  ha_discovery->on_group_published = store_discovery_digest;
+
+  ha_discovery->add_group(
+      "sensors", []() { return sensorConfigs.size(); }, build_sensor_discovery, stored_discovery_digest("sensors"));
+  if (mqtt_transmit_all_cellvoltages) {
+    // Waits until the battery reported its cell count
+    ha_discovery->add_group(
+        "cells", []() { return (size_t)datalayer.battery.info.number_of_cells; },
+        [](size_t index, std::string& topic, std::string& payload) {
+          return build_cell_voltage_discovery(index, topic, payload, false);
+        },
+        stored_discovery_digest("cells"));
+    if (battery2) {
+      ha_discovery->add_group(
+          "cells2", []() { return (size_t)datalayer.battery2.info.number_of_cells; },
+          [](size_t index, std::string& topic, std::string& payload) {
+            return build_cell_voltage_discovery(index, topic, payload, true);
+          },
+          stored_discovery_digest("cells2"));
     }
   }
-  return true;
+  ha_discovery->add_group(
+      "event", []() { return (size_t)1; }, build_event_discovery, stored_discovery_digest("event"));
+  ha_discovery->add_group(
+      "buttons", []() { return sizeof(buttonConfigs) / sizeof(buttonConfigs[0]); }, build_button_discovery,
+      stored_discovery_digest("buttons"));
+}
+
+static void run_ha_discovery() {
+  if (ha_discovery_restart_requested) {
+    ha_discovery_restart_requested = false;
+    ha_discovery->restart();
+  }
+  if (ha_discovery->done()) {
+    return;
+  }
+  ha_discovery->run([](const char* topic, const char* payload) { return mqtt_publish(topic, payload, true); },
+                    []() { return (size_t)max(0, esp_mqtt_client_get_outbox_size(client)); });
 }
 
 static void subscribe() {
   esp_mqtt_client_subscribe(client, (topic_name + "/command/+").c_str(), 1);
+  if (ha_autodiscovery_enabled) {
+    esp_mqtt_client_subscribe(client, HA_STATUS_TOPIC, 1);
+  }
 }
 
 void mqtt_message_received(char* topic_raw, int topic_len, char* data, int data_len) {
@@ -615,6 +769,13 @@ void mqtt_message_received(char* topic_raw, int topic_len, char* data, int data_
 
   logging.printf("MQTT message arrived: [%.*s]\n", topic_len, topic);
 
+  if (ha_autodiscovery_enabled && strcmp(topic, HA_STATUS_TOPIC) == 0) {
+    // Home Assistant restarted, it may have lost configs that were not retained by the broker
+    if (data_len == 6 && strncmp(data, "online", 6) == 0) {
+      ha_discovery_restart_requested = true;
+    }
+  }
+
   if (remote_bms_reset) {
     if (strcmp(topic, generateButtonTopic("BMSRESET").c_str()) == 0) {
       logging.println("Triggering BMS reset");
@@ -682,8 +843,9 @@ static void mqtt_event_handler(void* handler_args, esp_event_base_t base, int32_
       clear_event(EVENT_MQTT_DISCONNECT);
       set_event(EVENT_MQTT_CONNECT, 0);
 
-      publish_buttons_discovery();
       subscribe();
+      // The broker may have lost the retained state, send everything on the next publish
+      full_refresh_requested = true;
       logging.println("MQTT connected");
       break;
     case MQTT_EVENT_DISCONNECTED:
@@ -729,11 +891,12 @@ bool init_mqtt(void) {
   if (ha_autodiscovery_enabled) {
     create_battery_sensor_configs();
     create_global_sensor_configs();
+    setup_ha_discovery();
   }
 
   if (mqtt_manual_topic_object_name) {
 
-    BatteryEmulatorSettingsStore settings;
+    BatteryEmulatorSettingsStore settings(true);
     topic_name = settings.getString("MQTTTOPIC", mqtt_topic_name);
     default_entity_id_prefix = settings.getString("MQTTOBJIDPREFIX", mqtt_default_entity_id_prefix);
     device_name = settings.getString("MQTTDEVICENAME", mqtt_device_name);
@@ -798,12 +961,17 @@ void mqtt_client_loop(void) {
     if (client_started == false) {
       // Configure timer with the loaded interval on first use
       publish_global_timer = MyTimer(mqtt_publish_interval_ms);
+      full_refresh_timer = MyTimer((unsigned long)mqtt_full_refresh_s * 1000);
       esp_mqtt_client_start(client);
       client_started = true;
       logging.println("MQTT initialized");
       return;
     }
 
+    if (ha_discovery && !ota_active) {
+      run_ha_discovery();
+    }
+
     // Skip publishing if OTA update is in progress to avoid interference
     if (publish_global_timer.elapsed() && !ota_active) {
       publish_values();
@@ -37,6 +37,7 @@
 #include <Arduino.h>
 #include <string>
 #include <vector>
+#include "mqtt_cells.h"
 
 #define MQTT_MSG_BUFFER_SIZE (4096)
 
@@ -46,6 +47,10 @@ extern bool mqtt_enabled;
 extern bool mqtt_transmit_all_cellvoltages;
 extern uint16_t mqtt_timeout_ms;
 extern uint16_t mqtt_publish_interval_ms;
+extern bool mqtt_delta_enabled;       // Only publish values that moved beyond their deadband
+extern uint16_t mqtt_full_refresh_s;    // With delta publishing, send every value at least this often
+extern uint16_t mqtt_cell_deadband_mV;  // With delta publishing, cell voltage change that publishes all cells
+extern MqttCellFormat mqtt_cell_format;
 extern bool ha_autodiscovery_enabled;
 extern std::string mqtt_server;
 extern std::string mqtt_user;
@@ -0,0 +1,179 @@
+#include "mqtt_cells.h"
+
+static const char base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+const char* mqtt_cell_format_name(MqttCellFormat format) {
+  switch (format) {
+    case MqttCellFormat::Float:
+      return "JSON volts";
+    case MqttCellFormat::Millivolts:
+      return "JSON millivolts";
+    case MqttCellFormat::DeltaFromMin:
+      return "JSON delta from min";
+    case MqttCellFormat::Base64:
+      return "Base64 packed";
+  }
+  return "";
+}
+
+// Appends to a fixed buffer and remembers if anything did not fit
+class PayloadWriter {
+ public:
+  PayloadWriter(char* out, size_t size) : out(out), size(size) {}
+
+  void text(const char* s) {
+    while (*s) {
+      put(*s++);
+    }
+  }
+
+  void number(uint32_t value) {
+    char digits[10];
+    int count = 0;
+    do {
+      digits[count++] = '0' + value % 10;
+      value /= 10;
+    } while (value > 0);
+    while (count > 0) {
+      put(digits[--count]);
+    }
+  }
+
+  void put(char c) {
+    if (length + 1 < size) {
+      out[length] = c;
+    } else {
+      overflow = true;
+    }
+    length++;
+  }
+
+  // Terminates the payload, returns its length or 0 if it did not fit
+  size_t finish() {
+    if (size == 0) {
+      return 0;
+    }
+    out[overflow ? 0 : length] = '\0';
+    return overflow ? 0 : length;
+  }
+
+ private:
+  char* out;
+  size_t size;
+  size_t length = 0;
+  bool overflow = false;
+};
+
+static void write_base64(PayloadWriter& writer, const uint16_t* values, size_t count) {
+  uint32_t bits = 0;
+  int bit_count = 0;
+  for (size_t i = 0; i < count; i++) {
+    for (int shift = 8; shift >= 0; shift -= 8) {
+      bits = (bits << 8) | ((values[i] >> shift) & 0xFF);
+      bit_count += 8;
+      while (bit_count >= 6) {
+        bit_count -= 6;
+        writer.put(base64_alphabet[(bits >> bit_count) & 0x3F]);
+      }
+    }
+  }
+  if (bit_count > 0) {
+    writer.put(base64_alphabet[(bits << (6 - bit_count)) & 0x3F]);
+  }
+  // Pad to a multiple of 4 characters
+  size_t chars = (count * 16 + 5) / 6;
+  for (; chars % 4 != 0; chars++) {
+    writer.put('=');
+  }
+}
+
+size_t mqtt_encode_cell_chunk(MqttCellFormat format, const uint16_t* cells_mV, size_t cells, size_t chunk, char* out,
+                              size_t out_size) {
+  size_t first = chunk * MQTT_CELLS_PER_CHUNK;
+  if (first >= cells) {
+    return 0;
+  }
+  size_t count = cells - first < MQTT_CELLS_PER_CHUNK ? cells - first : MQTT_CELLS_PER_CHUNK;
+  const uint16_t* values = cells_mV + first;
+
+  PayloadWriter writer(out, out_size);
+  writer.text("{\"first\":");
+  writer.number(first);
+  switch (format) {
+    case MqttCellFormat::Millivolts:
+      writer.text(",\"cell_voltages_mV\":[");
+      for (size_t i = 0; i < count; i++) {
+        if (i > 0) {
+          writer.put(',');
+        }
+        writer.number(values[i]);
+      }
+      writer.text("]}");
+      break;
+    case MqttCellFormat::DeltaFromMin: {
+      uint16_t min = values[0];
+      for (size_t i = 1; i < count; i++) {
+        min = values[i] < min ? values[i] : min;
+      }
+      writer.text(",\"min_mV\":");
+      writer.number(min);
+      writer.text(",\"delta_mV\":[");
+      for (size_t i = 0; i < count; i++) {
+        if (i > 0) {
+          writer.put(',');
+        }
+        writer.number(values[i] - min);
+      }
+      writer.text("]}");
+      break;
+    }
+    case MqttCellFormat::Base64:
+      writer.text(",\"count\":");
+      writer.number(count);
+      writer.text(",\"packed_mV\":\"");
+      write_base64(writer, values, count);
+      writer.text("\"}");
+      break;
+    default:
+      return 0;
+  }
+  return writer.finish();
+}
+
+// Jinja expression for the 16 bits of cell index in a base64 string s, with a the base64 alphabet. Every character
+// that holds some of the bits contributes (character value // 2^low bits skipped % 2^bits used * 2^position).
+static std::string base64_cell_expression(size_t index) {
+  std::string expression;
+  size_t start = index * 16, end = start + 16;
+  for (size_t c = start / 6; c * 6 < end; c++) {
+    size_t low = c * 6 > start ? c * 6 : start;
+    size_t high = c * 6 + 6 < end ? c * 6 + 6 : end;
+    std::string term = "a.find(s[" + std::to_string(c) + "])";
+    if (c * 6 + 6 > high) {
+      term += " // " + std::to_string(1u << (c * 6 + 6 - high));
+    }
+    if (low > c * 6) {
+      term += " % " + std::to_string(1u << (high - low));
+    }
+    if (end > high) {
+      term += " * " + std::to_string(1u << (end - high));
+    }
+    expression += (expression.empty() ? "" : " + ") + term;
+  }
+  return expression;
+}
+
+std::string mqtt_cell_value_template(MqttCellFormat format, size_t cell) {
+  std::string index = std::to_string(cell % MQTT_CELLS_PER_CHUNK);
+  switch (format) {
+    case MqttCellFormat::Millivolts:
+      return "{{ value_json.cell_voltages_mV[" + index + "] / 1000 }}";
+    case MqttCellFormat::DeltaFromMin:
+      return "{{ (value_json.min_mV + value_json.delta_mV[" + index + "]) / 1000 }}";
+    case MqttCellFormat::Base64:
+      return std::string("{% set a = '") + base64_alphabet + "' %}{% set s = value_json.packed_mV %}{{ (" +
+             base64_cell_expression(cell % MQTT_CELLS_PER_CHUNK) + ") / 1000 }}";
+    default:
+      return "{{ value_json.cell_voltages[" + std::to_string(cell) + "] }}";
+  }
+}
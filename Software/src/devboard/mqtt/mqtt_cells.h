@@ -0,0 +1,41 @@
+#ifndef __MQTT_CELLS_H__
+#define __MQTT_CELLS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// How cell voltages are published on the spec_data topics
+enum class MqttCellFormat {
+  // {"cell_voltages":[3.712,...]} on one topic per battery, as before
+  Float = 0,
+  // {"first":0,"cell_voltages_mV":[3712,...]}
+  Millivolts = 1,
+  // {"first":0,"min_mV":3700,"delta_mV":[12,...]}, each cell is min_mV + delta_mV
+  DeltaFromMin = 2,
+  // {"first":0,"count":48,"packed_mV":"DoA..."}, base64 of big-endian uint16 mV values
+  Base64 = 3,
+};
+
+// The compact formats are published in chunks of this many cells, on <topic>/<chunk number>. Only chunks with a
+// changed cell are sent again when delta publishing is enabled.
+#define MQTT_CELLS_PER_CHUNK 48
+
+// Longest payload of a full chunk in any compact format
+#define MQTT_CELL_CHUNK_MAX_SIZE (64 + MQTT_CELLS_PER_CHUNK * 6)
+
+const char* mqtt_cell_format_name(MqttCellFormat format);
+
+inline size_t mqtt_cell_chunk_count(size_t cells) {
+  return (cells + MQTT_CELLS_PER_CHUNK - 1) / MQTT_CELLS_PER_CHUNK;
+}
+
+// Write the payload of one chunk of cells_mV in a compact format. Returns the payload length, or 0 if the format
+// is not a compact one or out_size is too small.
+size_t mqtt_encode_cell_chunk(MqttCellFormat format, const uint16_t* cells_mV, size_t cells, size_t chunk, char* out,
+                              size_t out_size);
+
+// Home Assistant value template that extracts cell number cell (counted from 0) in volts from its chunk payload
+std::string mqtt_cell_value_template(MqttCellFormat format, size_t cell);
+
+#endif
@@ -0,0 +1,102 @@
+#include "mqtt_delta.h"
+
+#include <math.h>
+#include <string.h>
+
+Mqtt_Delta_Statistics mqtt_delta_statistics = {};
+
+void mqtt_delta_count(bool published, size_t bytes) {
+  if (published) {
+    mqtt_delta_statistics.messages_published++;
+    mqtt_delta_statistics.bytes_published += bytes;
+  } else {
+    mqtt_delta_statistics.messages_suppressed++;
+    mqtt_delta_statistics.bytes_saved += bytes;
+  }
+}
+
+const Mqtt_Deadband* MqttFieldDelta::find(const char* key) const {
+  size_t length = strlen(key);
+  for (size_t i = 0; i < deadband_count; i++) {
+    size_t name_length = strlen(deadbands[i].key);
+    if (strncmp(key, deadbands[i].key, name_length) != 0) {
+      continue;
+    }
+    if (length == name_length ||
+        (length == name_length + 2 && key[name_length] == '_' && key[name_length + 1] >= '2' &&
+         key[name_length + 1] <= '3')) {
+      return &deadbands[i];
+    }
+  }
+  return nullptr;
+}
+
+bool MqttFieldDelta::changed(const char* key, JsonVariantConst value, const Published& published) const {
+  if (value.is<float>() || value.is<bool>()) {
+    if (!published.is_number) {
+      return true;
+    }
+    float number = value.is<bool>() ? (value.as<bool>() ? 1.0f : 0.0f) : value.as<float>();
+    float difference = fabsf(number - published.number);
+    const Mqtt_Deadband* deadband = find(key);
+    if (deadband == nullptr) {
+      return difference > 0;
+    }
+    float limit = fmaxf(deadband->absolute, deadband->relative * fabsf(published.number));
+    return difference > limit;
+  }
+  if (value.is<const char*>()) {
+    return published.is_number || published.text != value.as<const char*>();
+  }
+  // Arrays and objects are not tracked
+  return true;
+}
+
+bool MqttFieldDelta::filter(JsonObject doc, bool full) {
+  std::vector<std::string> unchanged;
+  for (JsonPair field : doc) {
+    const char* key = field.key().c_str();
+    JsonVariantConst value = field.value();
+    auto it = last.find(key);
+    if (!full && it != last.end() && !changed(key, value, it->second)) {
+      unchanged.push_back(key);
+      continue;
+    }
+
+    Published& published = last[key];
+    published.is_number = value.is<float>() || value.is<bool>();
+    if (value.is<bool>()) {
+      published.number = value.as<bool>() ? 1.0f : 0.0f;
+    } else if (published.is_number) {
+      published.number = value.as<float>();
+    } else if (value.is<const char*>()) {
+      published.text = value.as<const char*>();
+    }
+  }
+  for (const auto& key : unchanged) {
+    doc.remove(key);
+  }
+  return doc.size() > 0;
+}
+
+bool MqttArrayDelta::changed(const uint16_t* values, size_t count, uint16_t deadband, bool full) {
+  bool publish = full || last.size() != count;
+  for (size_t i = 0; !publish && i < count; i++) {
+    publish = abs((int)values[i] - (int)last[i]) > deadband;
+  }
+  if (publish) {
+    last.assign(values, values + count);
+  }
+  return publish;
+}
+
+bool MqttArrayDelta::changed(const bool* values, size_t count, bool full) {
+  bool publish = full || last.size() != count;
+  for (size_t i = 0; !publish && i < count; i++) {
+    publish = values[i] != (last[i] != 0);
+  }
+  if (publish) {
+    last.assign(values, values + count);
+  }
+  return publish;
+}
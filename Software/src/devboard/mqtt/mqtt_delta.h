@@ -0,0 +1,80 @@
+#ifndef __MQTT_DELTA_H__
+#define __MQTT_DELTA_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+
+// A field is published again once it moved more than absolute, or more than relative times its last published
+// value, whichever is larger. Fields without an entry are published on every change.
+typedef struct {
+  /** Field name, also matches the same name with a battery suffix ("_2", "_3") */
+  const char* key;
+  float absolute;
+  float relative;
+} Mqtt_Deadband;
+
+typedef struct {
+  uint32_t messages_published;
+  /** Messages not sent because nothing in them changed */
+  uint32_t messages_suppressed;
+  uint32_t bytes_published;
+  /** Bytes not sent, for unchanged fields and suppressed messages */
+  uint32_t bytes_saved;
+} Mqtt_Delta_Statistics;
+
+extern Mqtt_Delta_Statistics mqtt_delta_statistics;
+
+// Count a message that was sent with bytes payload, or was not sent and would have had bytes payload
+void mqtt_delta_count(bool published, size_t bytes);
+
+// Remembers the last published value of every field of a JSON message and drops the fields that did not change
+// beyond their deadband.
+class MqttFieldDelta {
+ public:
+  MqttFieldDelta(const Mqtt_Deadband* deadbands, size_t count) : deadbands(deadbands), deadband_count(count) {}
+
+  // Remove the unchanged fields from doc, or keep all of them if full is true. The remaining fields are remembered
+  // as published. Returns false if no field is left.
+  bool filter(JsonObject doc, bool full);
+
+  // Forget what was published, the next filter() keeps every field
+  void reset() { last.clear(); }
+
+ private:
+  typedef struct {
+    bool is_number;
+    float number;
+    std::string text;
+  } Published;
+
+  const Mqtt_Deadband* find(const char* key) const;
+  bool changed(const char* key, JsonVariantConst value, const Published& published) const;
+
+  const Mqtt_Deadband* deadbands;
+  size_t deadband_count;
+  std::map<std::string, Published> last;
+};
+
+// Tracks the last published state of an array message, such as all cell voltages. Arrays are always sent whole,
+// since consumers address their values by position.
+class MqttArrayDelta {
+ public:
+  // Returns true if the array has to be published: full is true, the length changed or any value moved more than
+  // deadband. The values are then remembered as published.
+  bool changed(const uint16_t* values, size_t count, uint16_t deadband, bool full);
+  bool changed(const bool* values, size_t count, bool full);
+
+  void reset() { last.clear(); }
+
+  // Payload size of the last published message, used to account for suppressed ones
+  size_t last_size = 0;
+
+ private:
+  std::vector<uint16_t> last;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "can_log_record.h"
+#include <string.h>
+
+size_t make_can_log_record(CAN_Log_Record& record, const CAN_frame& frame, CAN_Interface interface,
+                           frameDirection msgDir, uint64_t timestamp_us) {
+  record.timestamp_us = timestamp_us;
+  record.id = frame.ID;
+  record.interface = (uint8_t)interface;
+  record.flags = (msgDir == MSG_TX ? CAN_LOG_RECORD_FLAG_TX : 0) | (frame.ext_ID ? CAN_LOG_RECORD_FLAG_EXT : 0) |
+                 (frame.FD ? CAN_LOG_RECORD_FLAG_FD : 0);
+  record.dlc = frame.DLC > sizeof(record.data) ? sizeof(record.data) : frame.DLC;
+  record.reserved = 0;
+  memcpy(record.data, frame.data.u8, record.dlc);
+  return can_log_record_size(record);
+}
+
+static const char hex_digits[] = "0123456789ABCDEF";
+
+// Write value as decimal, zero padded to min_digits. Returns the amount of characters written.
+static size_t put_decimal(char* out, uint64_t value, uint8_t min_digits) {
+  char tmp[20];
+  uint8_t len = 0;
+  do {
+    tmp[len++] = '0' + (value % 10);
+    value /= 10;
+  } while (value > 0 || len < min_digits);
+  for (uint8_t i = 0; i < len; i++) {
+    out[i] = tmp[len - 1 - i];
+  }
+  return len;
+}
+
+// Write value as upper case hex, zero padded to min_digits. Returns the amount of characters written.
+static size_t put_hex(char* out, uint32_t value, uint8_t min_digits) {
+  char tmp[8];
+  uint8_t len = 0;
+  do {
+    tmp[len++] = hex_digits[value & 0x0F];
+    value >>= 4;
+  } while (value > 0 || len < min_digits);
+  for (uint8_t i = 0; i < len; i++) {
+    out[i] = tmp[len - 1 - i];
+  }
+  return len;
+}
+
+size_t format_can_log_record(const CAN_Log_Record& record, char* out, size_t out_size) {
+  if (out_size < CAN_LOG_RECORD_MAX_TEXT) {
+    if (out_size > 0) {
+      out[0] = '\0';
+    }
+    return 0;
+  }
+
+  const uint8_t dlc = record.dlc > sizeof(record.data) ? sizeof(record.data) : record.dlc;
+  const bool tx = record.flags & CAN_LOG_RECORD_FLAG_TX;
+  size_t pos = 0;
+
+  out[pos++] = '(';
+  pos += put_decimal(out + pos, record.timestamp_us / 1000000, 1);
+  out[pos++] = '.';
+  pos += put_decimal(out + pos, record.timestamp_us % 1000000, 6);
+  out[pos++] = ')';
+  out[pos++] = ' ';
+  out[pos++] = tx ? 'T' : 'R';
+  out[pos++] = 'X';
+  pos += put_decimal(out + pos, record.interface * 2 + (tx ? 1 : 0), 1);
+  out[pos++] = ' ';
+  // Like candump, standard IDs take 3 digits and extended IDs 8, which is how the frame format is read back
+  pos += put_hex(out + pos, record.id, (record.flags & CAN_LOG_RECORD_FLAG_EXT) ? 8 : 3);
+  out[pos++] = ' ';
+  out[pos++] = '[';
+  pos += put_decimal(out + pos, dlc, 1);
+  out[pos++] = ']';
+
+  for (uint8_t i = 0; i < dlc; i++) {
+    out[pos++] = ' ';
+    out[pos++] = hex_digits[record.data[i] >> 4];
+    out[pos++] = hex_digits[record.data[i] & 0x0F];
+  }
+  out[pos++] = '\n';
+  out[pos] = '\0';
+  return pos;
+}
@@ -0,0 +1,47 @@
+#ifndef CAN_LOG_RECORD_H
+#define CAN_LOG_RECORD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../utils/types.h"
+
+#define CAN_LOG_RECORD_FLAG_TX 0x01
+#define CAN_LOG_RECORD_FLAG_EXT 0x02
+#define CAN_LOG_RECORD_FLAG_FD 0x04
+
+// Binary CAN capture record, queued as a single ring buffer item per frame.
+// Only the header and the first `dlc` payload bytes are queued, see can_log_record_size().
+typedef struct {
+  /** Time of capture in microseconds since boot */
+  uint64_t timestamp_us;
+  /** CAN identifier */
+  uint32_t id;
+  /** CAN_Interface the frame was sent or received on */
+  uint8_t interface;
+  /** CAN_LOG_RECORD_FLAG_* bits */
+  uint8_t flags;
+  /** Payload length in bytes */
+  uint8_t dlc;
+  uint8_t reserved;
+  uint8_t data[64];
+} CAN_Log_Record;
+
+static_assert(offsetof(CAN_Log_Record, data) == 16, "CAN_Log_Record header must stay 16 bytes");
+
+// Longest line format_can_log_record() can produce, including the terminating zero
+#define CAN_LOG_RECORD_MAX_TEXT (64 + 64 * 3)
+
+// Fill a record from a frame, returns the amount of bytes of the record that need to be stored
+size_t make_can_log_record(CAN_Log_Record& record, const CAN_frame& frame, CAN_Interface interface,
+                           frameDirection msgDir, uint64_t timestamp_us);
+
+static inline size_t can_log_record_size(const CAN_Log_Record& record) {
+  return offsetof(CAN_Log_Record, data) + record.dlc;
+}
+
+// Convert a record to a candump style text line, "(seconds.micros) RX0 1AB [8] 01 02 03 04 05 06 07 08\n".
+// The bus number follows the webserver CAN log: interface * 2 for RX, interface * 2 + 1 for TX.
+// Returns the amount of characters written, excluding the terminating zero.
+size_t format_can_log_record(const CAN_Log_Record& record, char* out, size_t out_size);
+
+#endif  // CAN_LOG_RECORD_H
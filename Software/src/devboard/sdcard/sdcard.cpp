@@ -1,83 +1,233 @@
 #include "sdcard.h"
+#include "can_log_record.h"
+#include "esp_timer.h"
 #include "freertos/ringbuf.h"
 
-File can_log_file;
-File log_file;
+#include <algorithm>
+#include <atomic>
+
+#define CAN_RING_BUFFER_SIZE (32 * 1024)
+#define LOG_RING_BUFFER_SIZE 1024
+
+// Ring buffer items are gathered into blocks of this size before they are written to the card.
+// The blocks are aligned to SD_SECTOR_SIZE within the file, so each write covers whole sectors.
+#define SD_SECTOR_SIZE 512
+#define CAN_WRITE_BLOCK_SIZE (8 * 1024)
+#define LOG_WRITE_BLOCK_SIZE (4 * 1024)
+// Pending data is written out and flushed at the latest after this time
+#define SD_WRITE_MAX_DELAY_MS 2000
+
+typedef struct {
+  const char* path;
+  File file;
+  bool open = false;
+  uint8_t* block = nullptr;
+  size_t block_size = 0;
+  size_t used = 0;
+  size_t file_size = 0;
+  unsigned long pending_since = 0;
+  bool pending = false;
+  unsigned long stats_window_start = 0;
+  uint32_t stats_window_bytes = 0;
+  SD_Log_Statistics* stats;
+} SD_Log_Writer;
+
 RingbufHandle_t can_bufferHandle;
 RingbufHandle_t log_bufferHandle;
 
-bool can_logging_paused = false;
-bool can_file_open = false;
-bool delete_can_file = false;
+SD_Log_Statistics sd_can_log_statistics;
+SD_Log_Statistics sd_debug_log_statistics;
+
+static SD_Log_Writer can_writer = {.path = CAN_LOG_FILE, .stats = &sd_can_log_statistics};
+static SD_Log_Writer log_writer = {.path = LOG_FILE, .stats = &sd_debug_log_statistics};
+
+volatile bool can_logging_paused = false;
+volatile SD_Log_Delete_State can_log_delete_state = SD_LOG_DELETE_IDLE;
+// Exports in progress, and whether logging_loop has closed the file for them
+static std::atomic<uint8_t> can_log_exports{0};
+volatile bool can_log_closed = false;
 
-bool logging_paused = false;
-bool log_file_open = false;
-bool delete_log_file = false;
+volatile bool logging_paused = false;
+volatile SD_Log_Delete_State log_delete_state = SD_LOG_DELETE_IDLE;
+static std::atomic<uint8_t> log_exports{0};
+volatile bool log_closed = false;
 
 bool sd_card_active = false;
 
 void delete_can_log() {
+  can_log_delete_state = SD_LOG_DELETE_PENDING;
   can_logging_paused = true;
-  delete_can_file = true;
+}
+
+SD_Log_Delete_State get_can_log_delete_state() {
+  return can_log_delete_state;
 }
 
 void resume_can_writing() {
-  can_logging_paused = false;
-  can_log_file = SD_MMC.open(CAN_LOG_FILE, FILE_APPEND);
-  can_file_open = true;
+  // The file is reopened by logging_loop when the next frame arrives
+  can_log_exports--;
 }
 
 void pause_can_writing() {
-  can_logging_paused = true;
+  // logging_loop writes out what it has collected and closes the file the next time it runs
+  can_log_closed = false;
+  can_log_exports++;
+}
+
+bool is_can_log_closed() {
+  return can_log_closed;
 }
 
 void delete_log() {
+  log_delete_state = SD_LOG_DELETE_PENDING;
   logging_paused = true;
-  if (log_file_open) {
-    log_file.close();
-    log_file_open = false;
-  }
-  SD_MMC.remove(LOG_FILE);
-  logging_paused = false;
+}
+
+SD_Log_Delete_State get_log_delete_state() {
+  return log_delete_state;
 }
 
 void resume_log_writing() {
-  logging_paused = false;
-  log_file = SD_MMC.open(LOG_FILE, FILE_APPEND);
-  log_file_open = true;
+  log_exports--;
 }
 
 void pause_log_writing() {
-  logging_paused = true;
+  log_closed = false;
+  log_exports++;
 }
 
-void add_can_frame_to_buffer(CAN_frame frame, frameDirection msgDir) {
+bool is_log_closed() {
+  return log_closed;
+}
 
-  if (!sd_card_active)
-    return;
+static bool sd_writer_init(SD_Log_Writer& writer, size_t block_size) {
+  writer.block = (uint8_t*)malloc(block_size);
+  if (writer.block == nullptr) {
+    return false;
+  }
+  writer.block_size = block_size;
+  writer.stats->block_size = block_size;
+  return true;
+}
 
-  unsigned long currentTime = millis();
-  static char messagestr_buffer[32];
-  size_t size = 0;
-  size = snprintf(messagestr_buffer + size, sizeof(messagestr_buffer) - size, "(%lu.%03lu) %s %lX [%u] ",
-                  currentTime / 1000, currentTime % 1000, (msgDir == MSG_RX ? "RX0" : "TX1"), frame.ID, frame.DLC);
+static void sd_writer_update_statistics(SD_Log_Writer& writer) {
+  unsigned long now = millis();
+  if (now - writer.stats_window_start >= 1000) {
+    writer.stats->bytes_per_second =
+        (uint64_t)(writer.stats->bytes_written - writer.stats_window_bytes) * 1000 / (now - writer.stats_window_start);
+    writer.stats_window_start = now;
+    writer.stats_window_bytes = writer.stats->bytes_written;
+  }
+}
 
-  if (xRingbufferSend(can_bufferHandle, &messagestr_buffer, size, pdMS_TO_TICKS(2)) != pdTRUE) {
-    logging.println("Failed to send message to can ring buffer!");
-    return;
+static void sd_writer_track_ring(SD_Log_Writer& writer, RingbufHandle_t ring, size_t ring_size) {
+  size_t used = ring_size - xRingbufferGetCurFreeSize(ring);
+  if (used > writer.stats->ring_high_water) {
+    writer.stats->ring_high_water = used;
   }
+  writer.stats->ring_size = ring_size;
+}
 
-  uint8_t i = 0;
-  for (i = 0; i < frame.DLC; i++) {
-    if (i < frame.DLC - 1)
-      size = snprintf(messagestr_buffer, sizeof(messagestr_buffer), "%02X ", frame.data.u8[i]);
-    else
-      size = snprintf(messagestr_buffer, sizeof(messagestr_buffer), "%02X\n", frame.data.u8[i]);
+// Open the file for appending if it is not open yet. A failed open is counted and retried with the next write.
+static bool sd_writer_open(SD_Log_Writer& writer) {
+  if (!writer.open) {
+    writer.file = SD_MMC.open(writer.path, FILE_APPEND);
+    if (!writer.file) {
+      writer.stats->write_failures++;
+      return false;
+    }
+    writer.open = true;
+    writer.file_size = writer.file.size();
+  }
+  return true;
+}
 
-    if (xRingbufferSend(can_bufferHandle, &messagestr_buffer, size, pdMS_TO_TICKS(2)) != pdTRUE) {
-      logging.println("Failed to send message to can ring buffer!");
+// Write the collected block to the card, optionally followed by a flush of the file
+static void sd_writer_write_out(SD_Log_Writer& writer, bool flush) {
+  if (writer.used > 0) {
+    if (!sd_writer_open(writer)) {
+      // The block is lost, the next one starts over
+      writer.used = 0;
+      writer.pending = false;
       return;
     }
+    if (writer.file.write(writer.block, writer.used) == writer.used) {
+      writer.file_size += writer.used;
+      writer.stats->bytes_written += writer.used;
+      writer.stats->blocks_written++;
+    } else {
+      // Reopen with the next block so file_size, and with it the block alignment, is read back from the card
+      writer.stats->write_failures++;
+      writer.file.close();
+      writer.open = false;
+    }
+    writer.used = 0;
+  }
+  if (flush && writer.pending && writer.open) {
+    writer.file.flush();
+    writer.stats->flushes++;
+    writer.pending = false;
+  }
+}
+
+static void sd_writer_append(SD_Log_Writer& writer, const uint8_t* data, size_t length) {
+  if (writer.block == nullptr || !sd_writer_open(writer)) {
+    return;
+  }
+  if (!writer.pending) {
+    writer.pending = true;
+    writer.pending_since = millis();
+  }
+
+  while (length > 0) {
+    // The first block after opening is shortened so that all following blocks start on a sector boundary
+    size_t limit = writer.block_size - (writer.file_size % SD_SECTOR_SIZE);
+    size_t chunk = std::min(length, limit - writer.used);
+    memcpy(writer.block + writer.used, data, chunk);
+    writer.used += chunk;
+    data += chunk;
+    length -= chunk;
+    if (writer.used == limit) {
+      sd_writer_write_out(writer, false);
+    }
+  }
+}
+
+static void sd_writer_close(SD_Log_Writer& writer) {
+  sd_writer_write_out(writer, true);
+  if (writer.open) {
+    writer.file.close();
+    writer.open = false;
+  }
+}
+
+// Close and delete the file of a writer, in the logging task so the file is never removed while it is written
+static SD_Log_Delete_State sd_writer_delete(SD_Log_Writer& writer) {
+  sd_writer_close(writer);
+  writer.used = 0;
+  writer.pending = false;
+  writer.file_size = 0;
+  return !SD_MMC.exists(writer.path) || SD_MMC.remove(writer.path) ? SD_LOG_DELETE_DONE : SD_LOG_DELETE_FAILED;
+}
+
+// Time bound: write out and flush whatever is pending once it is old enough
+static void sd_writer_check_timeout(SD_Log_Writer& writer) {
+  if (writer.pending && millis() - writer.pending_since >= SD_WRITE_MAX_DELAY_MS) {
+    sd_writer_write_out(writer, true);
+  }
+}
+
+void add_can_frame_to_buffer(const CAN_frame& frame, frameDirection msgDir, CAN_Interface interface) {
+
+  if (!sd_card_active)
+    return;
+
+  // Only the binary record is queued here, the text conversion is done by logging_loop
+  CAN_Log_Record record;
+  size_t size = make_can_log_record(record, frame, interface, msgDir, esp_timer_get_time());
+
+  if (xRingbufferSend(can_bufferHandle, &record, size, 0) != pdTRUE) {
+    sd_can_log_statistics.items_dropped++;
   }
 }
 
@@ -86,35 +236,35 @@ void write_can_frame_to_sdcard() {
   if (!sd_card_active)
     return;
 
+  sd_writer_track_ring(can_writer, can_bufferHandle, CAN_RING_BUFFER_SIZE);
+
+  if (can_log_delete_state == SD_LOG_DELETE_PENDING) {
+    can_log_delete_state = sd_writer_delete(can_writer);
+    can_logging_paused = false;
+  } else if (can_logging_paused || can_log_exports > 0) {
+    sd_writer_close(can_writer);
+    can_log_closed = can_log_exports > 0;
+  }
+
   size_t receivedMessageSize;
   uint8_t* buffer = (uint8_t*)xRingbufferReceive(can_bufferHandle, &receivedMessageSize, pdMS_TO_TICKS(10));
 
-  if (buffer != NULL) {
-
-    if (can_logging_paused) {
-      if (can_file_open) {
-        can_log_file.close();
-        can_file_open = false;
-      }
-      if (delete_can_file) {
-        SD_MMC.remove(CAN_LOG_FILE);
-        delete_can_file = false;
-        can_logging_paused = false;
-      }
-      vRingbufferReturnItem(can_bufferHandle, (void*)buffer);
-      return;
-    }
-
-    if (can_file_open == false) {
-      can_log_file = SD_MMC.open(CAN_LOG_FILE, FILE_APPEND);
-      can_file_open = true;
+  // Drain what is queued right now, the items end up in the write block
+  while (buffer != NULL) {
+    if (!can_logging_paused && can_log_exports == 0) {
+      static char line[CAN_LOG_RECORD_MAX_TEXT];
+      // Ring items are only byte aligned and hold just the used part of the record
+      CAN_Log_Record record;
+      memcpy(&record, buffer, std::min(receivedMessageSize, sizeof(record)));
+      size_t length = format_can_log_record(record, line, sizeof(line));
+      sd_writer_append(can_writer, (uint8_t*)line, length);
     }
-
-    can_log_file.write(buffer, receivedMessageSize);
-    can_log_file.flush();
-
     vRingbufferReturnItem(can_bufferHandle, (void*)buffer);
+    buffer = (uint8_t*)xRingbufferReceive(can_bufferHandle, &receivedMessageSize, 0);
   }
+
+  sd_writer_check_timeout(can_writer);
+  sd_writer_update_statistics(can_writer);
 }
 
 void add_log_to_buffer(const uint8_t* buffer, size_t size) {
@@ -123,7 +273,7 @@ void add_log_to_buffer(const uint8_t* buffer, size_t size) {
     return;
 
   if (xRingbufferSend(log_bufferHandle, buffer, size, pdMS_TO_TICKS(1)) != pdTRUE) {
-    logging.println("Failed to send message to log ring buffer!");
+    sd_debug_log_statistics.items_dropped++;
     return;
   }
 }
@@ -133,40 +283,45 @@ void write_log_to_sdcard() {
   if (!sd_card_active)
     return;
 
-  size_t receivedMessageSize;
-  uint8_t* buffer = (uint8_t*)xRingbufferReceive(log_bufferHandle, &receivedMessageSize, pdMS_TO_TICKS(10));
+  sd_writer_track_ring(log_writer, log_bufferHandle, LOG_RING_BUFFER_SIZE);
 
-  if (buffer != NULL) {
+  if (log_delete_state == SD_LOG_DELETE_PENDING) {
+    log_delete_state = sd_writer_delete(log_writer);
+    logging_paused = false;
+  } else if (logging_paused || log_exports > 0) {
+    sd_writer_close(log_writer);
+    log_closed = log_exports > 0;
+  }
 
-    if (logging_paused) {
-      vRingbufferReturnItem(log_bufferHandle, (void*)buffer);
-      return;
-    }
+  size_t receivedMessageSize;
+  uint8_t* buffer = (uint8_t*)xRingbufferReceive(log_bufferHandle, &receivedMessageSize, pdMS_TO_TICKS(10));
 
-    if (log_file_open == false) {
-      log_file = SD_MMC.open(LOG_FILE, FILE_APPEND);
-      log_file_open = true;
+  while (buffer != NULL) {
+    if (!logging_paused && log_exports == 0) {
+      sd_writer_append(log_writer, buffer, receivedMessageSize);
     }
-
-    log_file.write(buffer, receivedMessageSize);
-    log_file.flush();
     vRingbufferReturnItem(log_bufferHandle, (void*)buffer);
+    buffer = (uint8_t*)xRingbufferReceive(log_bufferHandle, &receivedMessageSize, 0);
   }
+
+  sd_writer_check_timeout(log_writer);
+  sd_writer_update_statistics(log_writer);
 }
 
 void init_logging_buffers() {
 
   if (datalayer.system.info.CAN_SD_logging_active) {
-    can_bufferHandle = xRingbufferCreate(32 * 1024, RINGBUF_TYPE_BYTEBUF);
-    if (can_bufferHandle == NULL) {
+    // One item per CAN_Log_Record, so records are never split at the wrap-around point
+    can_bufferHandle = xRingbufferCreate(CAN_RING_BUFFER_SIZE, RINGBUF_TYPE_NOSPLIT);
+    if (can_bufferHandle == NULL || !sd_writer_init(can_writer, CAN_WRITE_BLOCK_SIZE)) {
       logging.println("Failed to create CAN ring buffer!");
       return;
     }
   }
 
   if (datalayer.system.info.SD_logging_active) {
-    log_bufferHandle = xRingbufferCreate(1024, RINGBUF_TYPE_BYTEBUF);
-    if (log_bufferHandle == NULL) {
+    log_bufferHandle = xRingbufferCreate(LOG_RING_BUFFER_SIZE, RINGBUF_TYPE_BYTEBUF);
+    if (log_bufferHandle == NULL || !sd_writer_init(log_writer, LOG_WRITE_BLOCK_SIZE)) {
       logging.println("Failed to create log ring buffer!");
       return;
     }
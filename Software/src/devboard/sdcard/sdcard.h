@@ -9,21 +9,59 @@
 #define CAN_LOG_FILE "/canlog.txt"
 #define LOG_FILE "/log.txt"
 
+// Write statistics for a log file on the SD card
+typedef struct {
+  /** Bytes written to the card since boot */
+  uint32_t bytes_written = 0;
+  /** Write throughput over the last second */
+  uint32_t bytes_per_second = 0;
+  /** Amount of block writes and file flushes since boot */
+  uint32_t blocks_written = 0;
+  uint32_t flushes = 0;
+  /** Size of the write-coalescing block */
+  uint32_t block_size = 0;
+  /** Highest ring buffer fill level seen, and the ring buffer size */
+  uint32_t ring_high_water = 0;
+  uint32_t ring_size = 0;
+  /** Items that did not fit in the ring buffer and were lost */
+  uint32_t items_dropped = 0;
+  /** Opens and block writes that failed, their data was lost */
+  uint32_t write_failures = 0;
+} SD_Log_Statistics;
+
+enum SD_Log_Delete_State : uint8_t {
+  SD_LOG_DELETE_IDLE,
+  /** Waiting for logging_loop to close and delete the file */
+  SD_LOG_DELETE_PENDING,
+  SD_LOG_DELETE_DONE,
+  SD_LOG_DELETE_FAILED
+};
+
+extern SD_Log_Statistics sd_can_log_statistics;
+extern SD_Log_Statistics sd_debug_log_statistics;
+
 void init_logging_buffers();
 void deinit_logging_buffers();
 
 bool init_sdcard();
 void log_sdcard_details();
 
-void add_can_frame_to_buffer(CAN_frame frame, frameDirection msgDir);
+void add_can_frame_to_buffer(const CAN_frame& frame, frameDirection msgDir, CAN_Interface interface);
 void write_can_frame_to_sdcard();
 
+// Pause writing for an export: logging_loop writes out what it collected and closes the file, is_..._closed() tells
+// when that is done. Frames and lines arriving until the matching resume are not logged.
 void pause_can_writing();
 void resume_can_writing();
+bool is_can_log_closed();
+// Ask logging_loop to delete the file, get_..._delete_state() tells when it is done and whether it worked
 void delete_can_log();
+SD_Log_Delete_State get_can_log_delete_state();
 void delete_log();
+SD_Log_Delete_State get_log_delete_state();
 void resume_log_writing();
 void pause_log_writing();
+bool is_log_closed();
 
 void add_log_to_buffer(const uint8_t* buffer, size_t size);
 void write_log_to_sdcard();
@@ -11,6 +11,19 @@ int16_t sign_extend_to_int16(uint16_t input, unsigned input_bit_width) {
   return (input ^ mask) - mask;
 }
 
+uint32_t crc32_ieee(const void* data, size_t length) {
+  // Bitwise, so it needs no table
+  const uint8_t* bytes = (const uint8_t*)data;
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= bytes[i];
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
 /* CRC tables for various integrations to call*/
 
 const uint8_t crc8_table_SAE_J1850_ZER0[256] = {  //0x1D Poly,initial value 0x3F,Final XOR value varies
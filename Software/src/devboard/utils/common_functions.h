@@ -1,3 +1,4 @@
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -13,3 +14,13 @@ extern int16_t sign_extend_to_int16(uint16_t input, unsigned input_bit_width);
 extern const uint8_t crc8_table_SAE_J1850_ZER0[256];
 extern const uint8_t crctable_nissan_leaf[256];
 extern const uint8_t crctable_geely_geometryC[256];
+
+/**
+ * @brief CRC-32 (IEEE 802.3, as used by zlib) of a block of memory
+ *
+ * @param[in] data, length
+ *
+ * @return uint32_t CRC of the data
+ *
+ */
+extern uint32_t crc32_ieee(const void* data, size_t length);
@@ -0,0 +1,332 @@
+#include "event_journal.h"
+
+#include <string.h>
+#include <algorithm>
+#include "../../datalayer/datalayer.h"
+#include "common_functions.h"
+#include "events.h"
+#include "logging.h"
+
+#ifndef UNIT_TEST
+#include "esp_attr.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#endif
+
+// Marks memory that holds a queue from a previous boot, anything else is left over from power-on
+#define EVENT_JOURNAL_PENDING_MAGIC 0x4A564542
+// Largest part of the partition used for the journal, mount() reads the first record of every sector
+#define EVENT_JOURNAL_MAX_SIZE (128 * 1024)
+
+static_assert(sizeof(Event_Journal_Record) == 24, "Event journal records are stored in flash");
+static_assert(EVENT_NOF_EVENTS <= UINT8_MAX, "Events are stored as one byte in the journal");
+
+EventJournal event_journal;
+
+#ifdef UNIT_TEST
+static Event_Journal_Pending journal_pending;
+#else
+static RTC_NOINIT_ATTR Event_Journal_Pending journal_pending;
+#endif
+static EventJournalQueue journal_queue(journal_pending);
+static uint32_t journal_erase_max_us = 0;
+
+static const char* const EVENT_JOURNAL_KIND_STRING[EVENT_JOURNAL_KINDS] = {"set", "latched", "cleared", "reset"};
+
+const char* event_journal_kind_string(uint8_t kind) {
+  return kind < EVENT_JOURNAL_KINDS ? EVENT_JOURNAL_KIND_STRING[kind] : "unknown";
+}
+
+bool EventJournal::is_valid(const Event_Journal_Record& record) {
+  return record.crc == crc32_ieee(&record, offsetof(Event_Journal_Record, crc));
+}
+
+bool EventJournal::is_erased(const Event_Journal_Record& record) {
+  const uint8_t* bytes = (const uint8_t*)&record;
+  for (size_t i = 0; i < sizeof(record); i++) {
+    if (bytes[i] != 0xFF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void EventJournal::seal(Event_Journal_Record& record) {
+  record.crc = crc32_ieee(&record, offsetof(Event_Journal_Record, crc));
+}
+
+bool EventJournal::sector_is_erased(EventJournalStorage* storage, uint32_t sector) {
+  for (uint32_t slot = 0; slot < records_per_sector(); slot++) {
+    Event_Journal_Record record;
+    if (!storage->read(offset_of(sector, slot), &record, sizeof(record)) || !is_erased(record)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool EventJournal::mount(EventJournalStorage* new_storage) {
+  const uint32_t sector_count = new_storage->size() / EVENT_JOURNAL_SECTOR_SIZE;
+  if (sector_count < 2) {
+    return false;
+  }
+
+  // The sector that starts with the highest sequence number was written last
+  bool found = false;
+  uint32_t newest = 0;
+  uint32_t newest_first_sequence = 0;
+  for (uint32_t sector = 0; sector < sector_count; sector++) {
+    Event_Journal_Record record;
+    if (new_storage->read(offset_of(sector, 0), &record, sizeof(record)) && is_valid(record) &&
+        (!found || record.sequence > newest_first_sequence)) {
+      found = true;
+      newest = sector;
+      newest_first_sequence = record.sequence;
+    }
+  }
+
+  uint32_t slot = 0;
+  uint32_t next_sequence = 1;
+  uint16_t last_boot = 0;
+  if (found) {
+    for (; slot < records_per_sector(); slot++) {
+      Event_Journal_Record record;
+      if (!new_storage->read(offset_of(newest, slot), &record, sizeof(record))) {
+        return false;
+      }
+      if (is_erased(record)) {
+        break;
+      }
+      // A record torn by a reset is skipped, the next one goes after it
+      if (is_valid(record)) {
+        next_sequence = record.sequence + 1;
+        last_boot = record.boot;
+      }
+    }
+  } else if (!sector_is_erased(new_storage, 0) && !new_storage->erase_sector(0)) {
+    return false;
+  }
+
+  sectors = sector_count;
+  head_sector.store(newest, std::memory_order_relaxed);
+  head_slot = slot;
+  next.store(next_sequence, std::memory_order_relaxed);
+  boot_number = found ? last_boot + 1 : 1;
+  storage = new_storage;
+
+  // Sectors left erased by the previous boot count towards the reserve, the rest is erased now, before the core task
+  // runs
+  erased_ahead = 0;
+  while (erased_ahead < reserve() && sector_is_erased(storage, (newest + 1 + erased_ahead) % sectors)) {
+    erased_ahead++;
+  }
+  while (erase_ahead()) {}
+  return true;
+}
+
+bool EventJournal::append(Event_Journal_Record& record) {
+  if (!mounted() || full()) {
+    return false;
+  }
+  uint32_t sector = head_sector.load(std::memory_order_relaxed);
+  if (head_slot >= records_per_sector()) {
+    sector = (sector + 1) % sectors;
+    head_sector.store(sector, std::memory_order_release);
+    head_slot = 0;
+    erased_ahead--;
+  }
+
+  record.sequence = next.load(std::memory_order_relaxed);
+  seal(record);
+  const bool written = storage->write(offset_of(sector, head_slot), &record, sizeof(record));
+  // A failed write can still leave part of the record behind, so the slot is used up either way
+  head_slot++;
+  if (written) {
+    next.store(record.sequence + 1, std::memory_order_release);
+  }
+  return written;
+}
+
+bool EventJournal::erase_ahead() {
+  if (!mounted() || erased_ahead >= reserve()) {
+    return false;
+  }
+  const uint32_t sector = (head_sector.load(std::memory_order_relaxed) + 1 + erased_ahead) % sectors;
+  if (!storage->erase_sector(sector * EVENT_JOURNAL_SECTOR_SIZE)) {
+    return false;
+  }
+  erased_ahead++;
+  return true;
+}
+
+void EventJournalQueue::reset() {
+  pending.head.store(0, std::memory_order_relaxed);
+  pending.flushed.store(0, std::memory_order_relaxed);
+  pending.dropped.store(0, std::memory_order_relaxed);
+  for (uint32_t i = 0; i < EVENT_JOURNAL_PENDING_SLOTS; i++) {
+    pending.slots[i].stamp.store(0, std::memory_order_relaxed);
+  }
+  pending.magic = EVENT_JOURNAL_PENDING_MAGIC;
+}
+
+uint32_t EventJournalQueue::recover() {
+  if (pending.magic != EVENT_JOURNAL_PENDING_MAGIC || queued() > EVENT_JOURNAL_PENDING_SLOTS) {
+    reset();
+    return 0;
+  }
+  return queued();
+}
+
+bool EventJournalQueue::push(const Event_Journal_Record& record) {
+  uint32_t position = pending.head.load(std::memory_order_relaxed);
+  do {
+    if (position - pending.flushed.load(std::memory_order_acquire) >= EVENT_JOURNAL_PENDING_SLOTS) {
+      pending.dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!pending.head.compare_exchange_weak(position, position + 1, std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+
+  // Invalidate the slot before touching its contents, then publish it with its new position
+  Event_Journal_Pending_Slot& slot = pending.slots[position % EVENT_JOURNAL_PENDING_SLOTS];
+  slot.stamp.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.record = record;
+  EventJournal::seal(slot.record);
+  slot.stamp.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+uint32_t EventJournalQueue::flush(EventJournal& journal, bool skip_unfinished) {
+  if (!journal.mounted()) {
+    return 0;
+  }
+  uint32_t written = 0;
+  uint32_t position = pending.flushed.load(std::memory_order_relaxed);
+  const uint32_t head = pending.head.load(std::memory_order_acquire);
+  while (position != head) {
+    Event_Journal_Pending_Slot& slot = pending.slots[position % EVENT_JOURNAL_PENDING_SLOTS];
+    Event_Journal_Record record;
+    bool complete = slot.stamp.load(std::memory_order_acquire) == position + 1;
+    if (complete) {
+      record = slot.record;
+      complete = EventJournal::is_valid(record);
+    }
+    if (!complete && !skip_unfinished) {
+      break;  // Its writer is still busy, try again next time
+    }
+    if (complete && journal.full()) {
+      break;  // Waits here until erase_ahead() made room
+    }
+    if (complete && journal.append(record)) {
+      written++;
+    }
+    position++;
+    pending.flushed.store(position, std::memory_order_release);
+  }
+  return written;
+}
+
+#ifndef UNIT_TEST
+// The journal uses the data partition that the partition tables reserve for a file system, the firmware has none
+class PartitionJournalStorage : public EventJournalStorage {
+ public:
+  bool open() {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, nullptr);
+    return partition != nullptr;
+  }
+  uint32_t size() const override { return std::min<uint32_t>(partition->size, EVENT_JOURNAL_MAX_SIZE); }
+  bool read(uint32_t offset, void* out, size_t length) const override {
+    return esp_partition_read(partition, offset, out, length) == ESP_OK;
+  }
+  bool write(uint32_t offset, const void* data, size_t length) override {
+    return esp_partition_write(partition, offset, data, length) == ESP_OK;
+  }
+  bool erase_sector(uint32_t offset) override {
+    const int64_t start_us = esp_timer_get_time();
+    const bool erased = esp_partition_erase_range(partition, offset, EVENT_JOURNAL_SECTOR_SIZE) == ESP_OK;
+    const uint32_t duration_us = esp_timer_get_time() - start_us;
+    if (duration_us > journal_erase_max_us) {
+      journal_erase_max_us = duration_us;
+      if (duration_us > EVENT_JOURNAL_CORE_DEADLINE_US) {
+        DEBUG_PRINTF("Event journal: sector erase took %u us, the core task missed its %u us deadline\n",
+                     (unsigned)duration_us, (unsigned)EVENT_JOURNAL_CORE_DEADLINE_US);
+      }
+    }
+    return erased;
+  }
+
+ private:
+  const esp_partition_t* partition = nullptr;
+};
+
+static PartitionJournalStorage journal_storage;
+#endif
+
+void init_event_journal() {
+  const uint32_t recovered = journal_queue.recover();
+#ifndef UNIT_TEST
+  if (!journal_storage.open() || !event_journal.mount(&journal_storage)) {
+    DEBUG_PRINTF("Event journal: no usable partition, events are not kept over reboots\n");
+    return;
+  }
+#endif
+  // Whatever the previous boot queued, up to the reset, goes into the journal before the first event of this boot
+  const uint32_t written = journal_queue.flush(event_journal, true);
+  DEBUG_PRINTF("Event journal: boot %u, room for %u records, %u of %u queued before the reset written\n",
+               (unsigned)event_journal.boot(), (unsigned)event_journal.capacity(), (unsigned)written,
+               (unsigned)recovered);
+}
+
+void journal_event(uint8_t event, uint8_t data, Event_Journal_Kind kind, uint8_t level) {
+  Event_Journal_Record record = {};
+  record.timestamp_ms = millis64();
+  record.boot = event_journal.boot();
+  record.event = event;
+  record.data = data;
+  record.kind = kind;
+  record.level = level;
+  journal_queue.push(record);
+}
+
+// An erase stalls the core task, so it waits until the battery is disconnected or no current flows
+static bool journal_may_erase() {
+  return datalayer.system.status.contactors_engaged == 2 ||
+         abs(datalayer.battery.status.current_dA) < EVENT_JOURNAL_IDLE_CURRENT_DA;
+}
+
+void flush_event_journal() {
+  // One sector per call at most, the reserve is topped up over the following calls
+  if (journal_may_erase()) {
+    event_journal.erase_ahead();
+  }
+  journal_queue.flush(event_journal, false);
+}
+
+void event_journal_to_json(uint32_t since_sequence, uint16_t max_records, JsonObject root) {
+  root["boot"] = event_journal.boot();
+  root["next_sequence"] = event_journal.next_sequence();
+  root["queued"] = journal_queue.queued();
+  root["dropped"] = journal_queue.dropped();
+  root["erase_max_us"] = journal_erase_max_us;
+  JsonArray records = root["records"].to<JsonArray>();
+  uint16_t count = 0;
+  event_journal.visit(since_sequence, [&](const Event_Journal_Record& record) {
+    if (count >= max_records) {
+      return;
+    }
+    count++;
+    JsonObject out = records.add<JsonObject>();
+    out["sequence"] = record.sequence;
+    out["boot"] = record.boot;
+    out["timestamp_ms"] = record.timestamp_ms;
+    out["kind"] = event_journal_kind_string(record.kind);
+    if (record.kind == EVENT_JOURNAL_RESET_ALL) {
+      return;
+    }
+    // Records from before a firmware update may name events that have moved since
+    out["event"] = record.event < EVENT_NOF_EVENTS ? get_event_enum_string((EVENTS_ENUM_TYPE)record.event) : "";
+    out["level"] = get_event_level_string((EVENTS_LEVEL_TYPE)record.level);
+    out["data"] = record.data;
+  });
+}
@@ -0,0 +1,219 @@
+#ifndef _EVENT_JOURNAL_H_
+#define _EVENT_JOURNAL_H_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+
+// Erase unit of the flash, the journal is written sector by sector
+#define EVENT_JOURNAL_SECTOR_SIZE 4096
+// Records waiting for the flash, in memory that survives a panic or watchdog reset
+#define EVENT_JOURNAL_PENDING_SLOTS 64
+// How often the pending records are written to flash
+#define EVENT_JOURNAL_FLUSH_INTERVAL_MS 1000
+// Records in one /api/v1/journal response
+#define EVENT_JOURNAL_RESPONSE_RECORDS 100
+// Period of the core task, an erase that takes longer makes it miss a cycle
+#define EVENT_JOURNAL_CORE_DEADLINE_US 10000
+// Sectors kept erased ahead of the one being written, 170 records each
+#define EVENT_JOURNAL_ERASED_RESERVE 2
+// Below this battery current, in dA, the system counts as idle and the journal may erase
+#define EVENT_JOURNAL_IDLE_CURRENT_DA 10
+
+enum Event_Journal_Kind : uint8_t {
+  EVENT_JOURNAL_SET,
+  EVENT_JOURNAL_SET_LATCHED,
+  EVENT_JOURNAL_CLEARED,
+  /** All events were reset, event is 0 */
+  EVENT_JOURNAL_RESET_ALL,
+  EVENT_JOURNAL_KINDS
+};
+
+typedef struct {
+  /** millis64() when the event changed */
+  uint64_t timestamp_ms;
+  /** Position in the journal, counts up across reboots */
+  uint32_t sequence;
+  /** Boot the record was made in, counts up on every start */
+  uint16_t boot;
+  /** EVENTS_ENUM_TYPE */
+  uint8_t event;
+  uint8_t data;
+  /** Event_Journal_Kind */
+  uint8_t kind;
+  /** EVENTS_LEVEL_TYPE of the event */
+  uint8_t level;
+  uint16_t reserved;
+  /** crc32_ieee of the bytes before it */
+  uint32_t crc;
+} Event_Journal_Record;
+
+// Flash the journal is kept in: a raw partition on the ESP32, memory in the unit tests. Offsets are relative to the
+// start of the journal. Writes can only clear bits, erase_sector sets a whole sector back to 0xFF.
+class EventJournalStorage {
+ public:
+  virtual ~EventJournalStorage() {}
+  virtual uint32_t size() const = 0;
+  virtual bool read(uint32_t offset, void* out, size_t length) const = 0;
+  virtual bool write(uint32_t offset, const void* data, size_t length) = 0;
+  virtual bool erase_sector(uint32_t offset) = 0;
+};
+
+// Append-only journal of event changes in flash.
+//
+// The flash is used as a circular list of sectors. Records are written one after the other, and once a sector is
+// full the oldest sector is written next, so every sector is erased equally often. Each record carries a CRC; a
+// record torn by a reset is skipped. mount() finds the end of the journal by comparing the first record of every
+// sector and then scanning the newest sector.
+//
+// An erase keeps the flash cache off on both cores for tens of ms, stalling every task that runs from flash, the
+// core task included. So append() never erases: it only moves on into sectors that are already erased. mount()
+// erases EVENT_JOURNAL_ERASED_RESERVE sectors ahead of the newest one at boot, and erase_ahead() tops the reserve up
+// again at a moment the writer picks, when the stall does no harm. While the reserve is used up the journal is full()
+// and the records wait in the queue.
+//
+// Only one task appends. Other tasks may visit at the same time, they skip records that do not pass the CRC.
+class EventJournal {
+ public:
+  // Find the end of the journal in storage. A storage without a valid record starts a new journal.
+  bool mount(EventJournalStorage* storage);
+
+  bool mounted() const { return storage != nullptr; }
+
+  // Write the record with the next sequence number and its CRC. Returns false without writing when full().
+  bool append(Event_Journal_Record& record);
+
+  // The current sector is full and no erased sector is left ahead of it
+  bool full() const { return head_slot >= records_per_sector() && erased_ahead == 0; }
+
+  // Erase one more sector ahead if the reserve is not complete. Returns true if it erased. The records in that
+  // sector are the oldest ones and are dropped.
+  bool erase_ahead();
+
+  // Sequence number the next record gets
+  uint32_t next_sequence() const { return next.load(std::memory_order_acquire); }
+
+  // Number of the running boot, one more than the newest boot in the journal when it was mounted
+  uint16_t boot() const { return boot_number; }
+
+  // Records that fit into the storage
+  uint32_t capacity() const { return sectors * records_per_sector(); }
+
+  // Call visitor(const Event_Journal_Record&) for every valid record from from_sequence on, oldest first
+  template <typename Visitor>
+  void visit(uint32_t from_sequence, Visitor&& visitor) const {
+    if (!mounted()) {
+      return;
+    }
+    const uint32_t newest = head_sector.load(std::memory_order_acquire);
+    for (uint32_t i = 1; i <= sectors; i++) {
+      const uint32_t sector = (newest + i) % sectors;
+      for (uint32_t slot = 0; slot < records_per_sector(); slot++) {
+        Event_Journal_Record record;
+        if (!storage->read(offset_of(sector, slot), &record, sizeof(record)) || is_erased(record)) {
+          break;
+        }
+        if (is_valid(record) && record.sequence >= from_sequence) {
+          visitor((const Event_Journal_Record&)record);
+        }
+      }
+    }
+  }
+
+  static bool is_valid(const Event_Journal_Record& record);
+  static bool is_erased(const Event_Journal_Record& record);
+  static void seal(Event_Journal_Record& record);
+
+ private:
+  static uint32_t records_per_sector() { return EVENT_JOURNAL_SECTOR_SIZE / sizeof(Event_Journal_Record); }
+  static uint32_t offset_of(uint32_t sector, uint32_t slot) {
+    return sector * EVENT_JOURNAL_SECTOR_SIZE + slot * sizeof(Event_Journal_Record);
+  }
+  static bool sector_is_erased(EventJournalStorage* storage, uint32_t sector);
+  // At least the newest sector is kept on a small storage
+  uint32_t reserve() const {
+    return sectors > EVENT_JOURNAL_ERASED_RESERVE ? EVENT_JOURNAL_ERASED_RESERVE : sectors - 1;
+  }
+
+  EventJournalStorage* storage = nullptr;
+  uint32_t sectors = 0;
+  /** Sector written last, and the next free slot in it */
+  std::atomic<uint32_t> head_sector{0};
+  uint32_t head_slot = 0;
+  /** Erased sectors following head_sector, ready for append() */
+  uint32_t erased_ahead = 0;
+  std::atomic<uint32_t> next{1};
+  uint16_t boot_number = 0;
+};
+
+typedef struct {
+  /** Position of the record in the queue plus one, 0 while the record is being written */
+  std::atomic<uint32_t> stamp;
+  Event_Journal_Record record;
+} Event_Journal_Pending_Slot;
+
+// Records on their way to the flash. Kept in memory that is not cleared by a panic or watchdog reset, so the events
+// leading up to the reset can still be written after the reboot.
+typedef struct {
+  uint32_t magic;
+  /** Records queued so far */
+  std::atomic<uint32_t> head;
+  /** Records written to flash or skipped so far */
+  std::atomic<uint32_t> flushed;
+  /** Records dropped because the queue was full */
+  std::atomic<uint32_t> dropped;
+  Event_Journal_Pending_Slot slots[EVENT_JOURNAL_PENDING_SLOTS];
+} Event_Journal_Pending;
+
+// Lock-free queue in front of the journal. Any task can push, set_event runs on both cores, and never waits for the
+// flash. One task flushes the queue into the journal.
+class EventJournalQueue {
+ public:
+  explicit EventJournalQueue(Event_Journal_Pending& pending) : pending(pending) {}
+
+  // Keep the records of the previous boot if the memory holds a valid queue, otherwise start empty. Returns the
+  // amount of records kept.
+  uint32_t recover();
+
+  // Queue a record. Returns false and counts a drop if the queue is full.
+  bool push(const Event_Journal_Record& record);
+
+  // Write the queued records to the journal, in order. Stops at a record that is still being written, unless
+  // skip_unfinished is set, as after a reboot where its writer is gone, and when the journal is full. Returns the
+  // amount of records written.
+  uint32_t flush(EventJournal& journal, bool skip_unfinished);
+
+  uint32_t queued() const {
+    return pending.head.load(std::memory_order_acquire) - pending.flushed.load(std::memory_order_acquire);
+  }
+  uint32_t dropped() const { return pending.dropped.load(std::memory_order_relaxed); }
+
+ private:
+  void reset();
+
+  Event_Journal_Pending& pending;
+};
+
+const char* event_journal_kind_string(uint8_t kind);
+
+// Mount the journal in flash and write the records left in the queue by the previous boot. Called first in setup(),
+// before any event is set.
+void init_event_journal();
+
+// Queue a change of an event for the journal, from any task
+void journal_event(uint8_t event, uint8_t data, Event_Journal_Kind kind, uint8_t level);
+
+// Erase a sector ahead if the system is idle or the contactors are open, then write the queued changes to flash.
+// Called periodically from the loop task.
+void flush_event_journal();
+
+// Records from since_sequence on, at most max_records, for /api/v1/journal:
+// {"boot":..,"next_sequence":..,"queued":..,"dropped":..,"erase_max_us":..,"records":[{"sequence":..,"boot":..,
+// "timestamp_ms":..,"event":"EVENT_..","level":"EVENT_LEVEL_..","kind":"set","data":..},..]}
+// erase_max_us is the longest sector erase so far, every task running from flash was stalled for that long.
+void event_journal_to_json(uint32_t since_sequence, uint16_t max_records, JsonObject root);
+
+extern EventJournal event_journal;
+
+#endif
@@ -3,16 +3,24 @@
 #include "../../datalayer/datalayer.h"
 #include "../../devboard/hal/hal.h"
 #include "../../devboard/utils/logging.h"
+#include "event_journal.h"
+
+#include <atomic>
+
+static const char* EVENTS_ENUM_TYPE_STRING[] = {EVENTS_ENUM_TYPE(GENERATE_STRING)};
+static const char* EVENTS_LEVEL_TYPE_STRING[] = {EVENTS_LEVEL_TYPE(GENERATE_STRING)};
+#define EVENT_NOF_LEVELS (sizeof(EVENTS_LEVEL_TYPE_STRING) / sizeof(EVENTS_LEVEL_TYPE_STRING[0]))
 
 typedef struct {
   EVENTS_STRUCT_TYPE entries[EVENT_NOF_EVENTS];
   EVENTS_LEVEL_TYPE level;
+  /** Active and latched events per level, so the level follows from a few counters instead of a scan. Events are set
+   *  and cleared from several tasks, so the counters are atomic. */
+  std::atomic<uint16_t> active[EVENT_NOF_LEVELS];
 } EVENT_TYPE;
 
 /* Local variables */
 static EVENT_TYPE events;
-static const char* EVENTS_ENUM_TYPE_STRING[] = {EVENTS_ENUM_TYPE(GENERATE_STRING)};
-static const char* EVENTS_LEVEL_TYPE_STRING[] = {EVENTS_LEVEL_TYPE(GENERATE_STRING)};
 static const char* EMULATOR_STATUS_STRING[] = {EMULATOR_STATUS(GENERATE_STRING)};
 
 /* Local function prototypes */
@@ -160,6 +168,8 @@ void set_event_latched(EVENTS_ENUM_TYPE event, uint8_t data) {
 void clear_event(EVENTS_ENUM_TYPE event) {
   if (events.entries[event].state == EVENT_STATE_ACTIVE) {
     events.entries[event].state = EVENT_STATE_INACTIVE;
+    events.active[events.entries[event].level].fetch_sub(1);
+    journal_event(event, events.entries[event].data, EVENT_JOURNAL_CLEARED, events.entries[event].level);
     update_event_level();
     update_bms_status();
   }
@@ -173,7 +183,11 @@ void reset_all_events() {
     events.entries[i].occurences = 0;
     events.entries[i].MQTTpublished = false;  // Not published by default
   }
+  for (uint8_t level = 0; level < EVENT_NOF_LEVELS; level++) {
+    events.active[level] = 0;
+  }
   events.level = EVENT_LEVEL_INFO;
+  journal_event(0, 0, EVENT_JOURNAL_RESET_ALL, EVENT_LEVEL_INFO);
   update_bms_status();
 }
 
@@ -345,7 +359,8 @@ String get_event_message_string(EVENTS_ENUM_TYPE event) {
     case EVENT_DUMMY_ERROR:
       return "The dummy error event was set!";  // Don't change this event message!
     case EVENT_PERSISTENT_SAVE_INFO:
-      return "Failed to save user settings. Namespace full?";
+      return "Failed to save user settings. Namespace full? With data 2, the saved settings were damaged and older "
+             "values were loaded instead.";
     case EVENT_SERIAL_RX_WARNING:
       return "Error in serial function: No data received for some time, see data for minutes";
     case EVENT_SERIAL_RX_FAILURE:
@@ -492,6 +507,9 @@ static void set_event(EVENTS_ENUM_TYPE event, uint8_t data, bool latched) {
   if ((events.entries[event].state != EVENT_STATE_ACTIVE) &&
       (events.entries[event].state != EVENT_STATE_ACTIVE_LATCHED)) {
     events.entries[event].MQTTpublished = false;
+    events.active[events.entries[event].level].fetch_add(1);
+    // Only changes go into the journal, not every repeat of an event that is already active
+    journal_event(event, data, latched ? EVENT_JOURNAL_SET_LATCHED : EVENT_JOURNAL_SET, events.entries[event].level);
 
     DEBUG_PRINTF("Event: %s\n", get_event_message_string(event).c_str());
   }
@@ -543,11 +561,24 @@ bool compareEventsByTimestampAsc(const EventData& a, const EventData& b) {
 }
 
 static void update_event_level(void) {
-  EVENTS_LEVEL_TYPE temporary_level = EVENT_LEVEL_INFO;
+  // Highest level with an active event, levels are in order of priority
+  uint8_t level = EVENT_NOF_LEVELS - 1;
+  while (level > EVENT_LEVEL_INFO && events.active[level] == 0) {
+    level--;
+  }
+  events.level = (EVENTS_LEVEL_TYPE)level;
+
+#ifdef DEBUG_VIA_USB
+  // Cross-check the counters against a scan of all events
+  EVENTS_LEVEL_TYPE scanned_level = EVENT_LEVEL_INFO;
   for (uint8_t i = 0u; i < EVENT_NOF_EVENTS; i++) {
     if ((events.entries[i].state == EVENT_STATE_ACTIVE) || (events.entries[i].state == EVENT_STATE_ACTIVE_LATCHED)) {
-      temporary_level = (EVENTS_LEVEL_TYPE)max(events.entries[i].level, temporary_level);
+      scanned_level = (EVENTS_LEVEL_TYPE)max(events.entries[i].level, scanned_level);
     }
   }
-  events.level = temporary_level;
+  if (scanned_level != events.level) {
+    DEBUG_PRINTF("Event level %s from the counters, %s from a scan\n", get_event_level_string(events.level),
+                 get_event_level_string(scanned_level));
+  }
+#endif
 }
@@ -0,0 +1,107 @@
+#include "latency_histogram.h"
+
+Latency_Histogram latency_histograms[LATENCY_STAGE_COUNT];
+
+const char* latency_stage_name(Latency_Stage stage) {
+  switch (stage) {
+    case LATENCY_CORE_COMM:
+      return "core_comm";
+    case LATENCY_CORE_10MS:
+      return "core_10ms";
+    case LATENCY_CORE_VALUES:
+      return "core_values";
+    case LATENCY_CORE_CANTX:
+      return "core_cantx";
+    case LATENCY_CORE_TOTAL:
+      return "core_total";
+    case LATENCY_CORE_PERIOD_JITTER:
+      return "core_period_jitter";
+    case LATENCY_MQTT_LOOP:
+      return "mqtt_loop";
+    case LATENCY_CONNECTIVITY_LOOP:
+      return "connectivity_loop";
+    case LATENCY_TX_10MS:
+      return "tx_10ms";
+    case LATENCY_TX_100MS:
+      return "tx_100ms";
+    case LATENCY_TX_1S:
+      return "tx_1s";
+    default:
+      return "unknown";
+  }
+}
+
+uint32_t latency_histogram_count(const Latency_Histogram& histogram) {
+  uint32_t count = 0;
+  for (const auto& bucket : histogram.buckets) {
+    count += bucket.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+uint32_t latency_histogram_percentile(const Latency_Histogram& histogram, uint8_t percentile) {
+  // Work on a copy, other tasks may keep recording while we walk the buckets
+  uint32_t buckets[LATENCY_HISTOGRAM_BUCKETS];
+  uint64_t total = 0;
+  for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+    buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+    total += buckets[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  const uint64_t rank = (total * percentile + 99) / 100;
+  const uint32_t max_us = histogram.max_us.load(std::memory_order_relaxed);
+  uint64_t seen = 0;
+  for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+    seen += buckets[i];
+    if (seen >= rank && seen > 0) {
+      uint32_t limit = latency_histogram_bucket_limit_us(i);
+      return limit < max_us ? limit : max_us;
+    }
+  }
+  return max_us;
+}
+
+void latency_histogram_reset(Latency_Histogram& histogram) {
+  for (auto& bucket : histogram.buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  histogram.max_us.store(0, std::memory_order_relaxed);
+}
+
+void latency_histograms_reset() {
+  for (auto& histogram : latency_histograms) {
+    latency_histogram_reset(histogram);
+  }
+}
+
+void latency_histograms_to_json(JsonObject root) {
+  JsonArray limits = root["bucket_limit_us"].to<JsonArray>();
+  for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS - 1; i++) {
+    limits.add(latency_histogram_bucket_limit_us(i));
+  }
+
+  JsonObject stages = root["stages"].to<JsonObject>();
+  for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+    const Latency_Histogram& histogram = latency_histograms[s];
+    JsonObject stage = stages[latency_stage_name((Latency_Stage)s)].to<JsonObject>();
+    stage["count"] = latency_histogram_count(histogram);
+    stage["p50"] = latency_histogram_percentile(histogram, 50);
+    stage["p90"] = latency_histogram_percentile(histogram, 90);
+    stage["p99"] = latency_histogram_percentile(histogram, 99);
+    stage["max"] = histogram.max_us.load(std::memory_order_relaxed);
+
+    int highest = -1;
+    for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+      if (histogram.buckets[i].load(std::memory_order_relaxed) > 0) {
+        highest = i;
+      }
+    }
+    JsonArray buckets = stage["buckets"].to<JsonArray>();
+    for (int i = 0; i <= highest; i++) {
+      buckets.add(histogram.buckets[i].load(std::memory_order_relaxed));
+    }
+  }
+}
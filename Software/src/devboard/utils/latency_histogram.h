@@ -0,0 +1,75 @@
+#ifndef _LATENCY_HISTOGRAM_H_
+#define _LATENCY_HISTOGRAM_H_
+
+#include <atomic>
+#include <stdint.h>
+#include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+
+// Bucket 0 counts 0 us, bucket i counts 2^(i-1) to 2^i - 1 us. The last bucket also takes everything above 4 s.
+#define LATENCY_HISTOGRAM_BUCKETS 24
+
+// Fixed-size log2 histogram of durations in microseconds. Recording is a couple of atomic operations,
+// so it needs no heap and can be used from any task or ISR.
+typedef struct {
+  std::atomic<uint32_t> buckets[LATENCY_HISTOGRAM_BUCKETS];
+  /** Longest duration recorded since the last reset */
+  std::atomic<uint32_t> max_us;
+} Latency_Histogram;
+
+enum Latency_Stage : uint8_t {
+  LATENCY_CORE_COMM,           // receive_can() and receive_rs485()
+  LATENCY_CORE_10MS,           // 10 ms tasks in core_loop
+  LATENCY_CORE_VALUES,         // 1 s update_values() pass
+  LATENCY_CORE_CANTX,          // Transmitters
+  LATENCY_CORE_TOTAL,          // Whole core_loop iteration
+  LATENCY_CORE_PERIOD_JITTER,  // Deviation of the core_loop period from 1 ms
+  LATENCY_MQTT_LOOP,           // mqtt_client_loop()
+  LATENCY_CONNECTIVITY_LOOP,   // One pass of connectivity_loop
+  LATENCY_TX_10MS,             // How late tx_scheduler ran jobs with periods below 50 ms
+  LATENCY_TX_100MS,            // ... below 500 ms
+  LATENCY_TX_1S,               // ... of 500 ms and more
+  LATENCY_STAGE_COUNT
+};
+
+extern Latency_Histogram latency_histograms[LATENCY_STAGE_COUNT];
+
+const char* latency_stage_name(Latency_Stage stage);
+
+static inline uint8_t latency_histogram_bucket(uint32_t duration_us) {
+  if (duration_us == 0) {
+    return 0;
+  }
+  uint8_t bucket = 32 - __builtin_clz(duration_us);
+  return bucket < LATENCY_HISTOGRAM_BUCKETS ? bucket : LATENCY_HISTOGRAM_BUCKETS - 1;
+}
+
+// Largest duration counted in a bucket
+static inline uint32_t latency_histogram_bucket_limit_us(uint8_t bucket) {
+  return bucket >= LATENCY_HISTOGRAM_BUCKETS - 1 ? UINT32_MAX : (1UL << bucket) - 1;
+}
+
+static inline void latency_histogram_record(Latency_Histogram& histogram, int64_t duration_us) {
+  uint32_t duration = duration_us < 0 ? 0 : duration_us > UINT32_MAX ? UINT32_MAX : (uint32_t)duration_us;
+  histogram.buckets[latency_histogram_bucket(duration)].fetch_add(1, std::memory_order_relaxed);
+
+  uint32_t max = histogram.max_us.load(std::memory_order_relaxed);
+  while (duration > max && !histogram.max_us.compare_exchange_weak(max, duration, std::memory_order_relaxed)) {
+  }
+}
+
+// Total amount of durations recorded
+uint32_t latency_histogram_count(const Latency_Histogram& histogram);
+
+// Upper bound in microseconds of the given percentile (0-100), never above the recorded maximum.
+// Returns 0 for an empty histogram.
+uint32_t latency_histogram_percentile(const Latency_Histogram& histogram, uint8_t percentile);
+
+void latency_histogram_reset(Latency_Histogram& histogram);
+
+void latency_histograms_reset();
+
+// Add count, p50, p90, p99, max and the bucket counts of every stage to a JSON object.
+// Bucket counts are listed up to the highest non-empty bucket, bucket i ends at bucket_limit_us[i].
+void latency_histograms_to_json(JsonObject root);
+
+#endif
@@ -0,0 +1,133 @@
+#include "log_ring.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static Log_Ring_Slot web_log_slots[WEB_LOG_RING_SLOTS];
+LogRing web_log_ring(web_log_slots, WEB_LOG_RING_SLOTS);
+
+LogRing::LogRing(Log_Ring_Slot* slots, uint32_t slot_count) : slots(slots), slot_count(slot_count) {}
+
+void LogRing::write_line(const char* text, size_t length) {
+  if (length > LOG_RING_LINE_MAX) {
+    length = LOG_RING_LINE_MAX;
+  }
+  const uint8_t count = length == 0 ? 1 : (length + LOG_RING_SLOT_TEXT - 1) / LOG_RING_SLOT_TEXT;
+  const uint32_t sequence = head.fetch_add(count, std::memory_order_relaxed);
+
+  for (uint8_t i = 0; i < count; i++) {
+    Log_Ring_Slot& s = slot(sequence + i);
+    const size_t offset = (size_t)i * LOG_RING_SLOT_TEXT;
+    const size_t chunk = length - offset < LOG_RING_SLOT_TEXT ? length - offset : LOG_RING_SLOT_TEXT;
+
+    // Invalidate the slot before touching its contents, then publish it with its new sequence number
+    s.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.index = i;
+    s.count = count;
+    s.length = chunk;
+    memcpy(s.text, text + offset, chunk);
+    s.sequence.store(sequence + i + 1, std::memory_order_release);
+  }
+}
+
+uint8_t LogRing::read_line(uint32_t sequence, uint32_t end, char* out, size_t& length) const {
+  const Log_Ring_Slot& head_slot = slot(sequence);
+  if (head_slot.sequence.load(std::memory_order_acquire) != sequence + 1) {
+    return 0;
+  }
+  const uint8_t index = head_slot.index;
+  const uint8_t count = head_slot.count;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (head_slot.sequence.load(std::memory_order_relaxed) != sequence + 1 || index != 0 || count == 0 ||
+      count > end - sequence) {
+    return 0;
+  }
+
+  length = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const Log_Ring_Slot& s = slot(sequence + i);
+    const uint32_t stamp = s.sequence.load(std::memory_order_acquire);
+    if (stamp != sequence + i + 1) {
+      return 0;
+    }
+    const size_t chunk = s.length;
+    if (chunk > LOG_RING_SLOT_TEXT || length + chunk > LOG_RING_LINE_MAX) {
+      return 0;
+    }
+    memcpy(out + length, s.text, chunk);
+    // The copy only counts if nobody started rewriting the slot in the meantime
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s.sequence.load(std::memory_order_relaxed) != stamp) {
+      return 0;
+    }
+    length += chunk;
+  }
+  return count;
+}
+
+Log_Ring_Pending_Line* LogRing::pending_line(const void* producer) {
+  for (auto& line : pending) {
+    if (line.producer.load(std::memory_order_relaxed) == producer) {
+      return &line;
+    }
+  }
+  for (auto& line : pending) {
+    const void* expected = nullptr;
+    if (line.producer.compare_exchange_strong(expected, producer, std::memory_order_acq_rel)) {
+      line.length = 0;
+      return &line;
+    }
+  }
+  return nullptr;
+}
+
+void LogRing::flush(Log_Ring_Pending_Line& line) {
+  size_t length = line.length;
+  if (length > 0 && line.text[length - 1] == '\r') {
+    length--;
+  }
+  write_line(line.text, length);
+  line.length = 0;
+}
+
+void LogRing::append(const void* producer, const char* text, size_t length, unsigned long timestamp_ms) {
+  Log_Ring_Pending_Line* line = pending_line(producer);
+  if (line == nullptr) {
+    // More tasks logging than we have room for, keep the fragment as a line of its own
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r')) {
+      length--;
+    }
+    write_line(text, length);
+    return;
+  }
+
+  while (length > 0) {
+    if (line->length == 0) {
+      int written = snprintf(line->text, LOG_RING_LINE_MAX, "%8lu.%03lu ", timestamp_ms / 1000, timestamp_ms % 1000);
+      line->length = written > 0 ? written : 0;
+    }
+
+    const char* newline = (const char*)memchr(text, '\n', length);
+    const size_t chunk = newline ? newline - text : length;
+    const size_t room = LOG_RING_LINE_MAX - line->length;
+    const size_t copied = chunk < room ? chunk : room;
+    memcpy(line->text + line->length, text, copied);
+    line->length += copied;
+    text += copied;
+    length -= copied;
+
+    if (copied < chunk || line->length == LOG_RING_LINE_MAX) {
+      flush(*line);  // Line too long, continue on the next one
+    } else if (newline) {
+      flush(*line);
+      text++;
+      length--;
+    }
+  }
+
+  // Nothing left over, hand the entry back for the next task
+  if (line->length == 0) {
+    line->producer.store(nullptr, std::memory_order_release);
+  }
+}
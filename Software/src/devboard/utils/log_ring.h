@@ -0,0 +1,105 @@
+#ifndef _LOG_RING_H_
+#define _LOG_RING_H_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Text bytes carried by one slot. A line longer than this spans several consecutive slots.
+#define LOG_RING_SLOT_TEXT 24
+// Longest line kept in the ring, including the timestamp. Fits a CAN FD frame dump, longer lines are split.
+#define LOG_RING_LINE_MAX 256
+// Tasks that can have a partially written line pending at the same time. An entry is only held until the line is
+// complete, so tasks that come and go do not use up the table.
+#define LOG_RING_PRODUCERS 8
+// Slots in the webserver log ring, must be a power of two. 512 slots of 32 bytes hold the newest 12 KB of text in
+// 16 KB. The 15000 byte buffer they replace was emptied whenever it filled up, so it held 7.5 KB on average and
+// sometimes nothing; the ring always shows the newest lines. The next power of two would double the RAM.
+#define WEB_LOG_RING_SLOTS 512
+
+typedef struct {
+  /** Sequence number of the line chunk stored in the slot plus one, 0 while the slot is being written */
+  std::atomic<uint32_t> sequence;
+  /** Position of this chunk within its line */
+  uint8_t index;
+  /** Amount of slots the line occupies */
+  uint8_t count;
+  /** Text bytes used in this slot */
+  uint8_t length;
+  uint8_t reserved;
+  char text[LOG_RING_SLOT_TEXT];
+} Log_Ring_Slot;
+
+typedef struct {
+  /** Task assembling a line in this entry, nullptr if free. Set while the task has an unfinished line. */
+  std::atomic<const void*> producer;
+  uint16_t length;
+  char text[LOG_RING_LINE_MAX];
+} Log_Ring_Pending_Line;
+
+// Fixed-size ring of text lines, shared by every task that logs and read by the webserver.
+//
+// Writers never block and never wait for each other: a line reserves its slots with a single atomic add and
+// publishes each slot by stamping it with its sequence number. Once the ring is full the oldest lines are
+// overwritten. Readers copy line by line and check the stamps before and after the copy, so lines that are still
+// being written or get overwritten during the copy are left out instead of showing up torn.
+class LogRing {
+ public:
+  LogRing(Log_Ring_Slot* slots, uint32_t slot_count);
+
+  // Add one complete line, without the trailing newline
+  void write_line(const char* text, size_t length);
+
+  // Add text that may hold partial lines. Fragments are collected per producer (the calling task) until a
+  // newline arrives, so lines from different tasks never interleave. Every new line starts with a timestamp.
+  // The producer only holds an entry of the table while it has an unfinished line.
+  void append(const void* producer, const char* text, size_t length, unsigned long timestamp_ms);
+
+  // Drop all lines written so far. Safe to call while other tasks are writing.
+  void clear() { first.store(head.load(std::memory_order_acquire), std::memory_order_release); }
+
+  bool empty() const { return head.load(std::memory_order_acquire) == first.load(std::memory_order_acquire); }
+
+  // Text capacity of the ring in bytes
+  size_t capacity() const { return (size_t)slot_count * LOG_RING_SLOT_TEXT; }
+
+  // Call visitor(const char* line, size_t length) for every complete line in the ring, oldest first.
+  // Only lines written before the call started are visited.
+  template <typename Visitor>
+  void visit(Visitor&& visitor) const {
+    const uint32_t end = head.load(std::memory_order_acquire);
+    const uint32_t cleared = first.load(std::memory_order_acquire);
+    uint32_t sequence = (end - cleared) > slot_count ? end - slot_count : cleared;
+    char line[LOG_RING_LINE_MAX];
+
+    while (sequence != end) {
+      size_t length = 0;
+      uint8_t count = read_line(sequence, end, line, length);
+      if (count == 0) {
+        sequence++;  // Unfinished, overwritten or the tail of a line that started before the window
+        continue;
+      }
+      visitor((const char*)line, length);
+      sequence += count;
+    }
+  }
+
+ private:
+  Log_Ring_Slot& slot(uint32_t sequence) const { return slots[sequence & (slot_count - 1)]; }
+  uint8_t read_line(uint32_t sequence, uint32_t end, char* out, size_t& length) const;
+  Log_Ring_Pending_Line* pending_line(const void* producer);
+  void flush(Log_Ring_Pending_Line& line);
+
+  Log_Ring_Slot* slots;
+  uint32_t slot_count;
+  /** Sequence number of the next slot to be reserved */
+  std::atomic<uint32_t> head{0};
+  /** Sequence number of the first slot after the last clear() */
+  std::atomic<uint32_t> first{0};
+  Log_Ring_Pending_Line pending[LOG_RING_PRODUCERS] = {};
+};
+
+// Debug log and CAN log lines shown on the webserver
+extern LogRing web_log_ring;
+
+#endif
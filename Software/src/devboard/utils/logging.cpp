@@ -1,6 +1,7 @@
 #include "logging.h"
 #include "../../datalayer/datalayer.h"
 #include "../sdcard/sdcard.h"
+#include "log_ring.h"
 
 #define MAX_LINE_LENGTH_PRINTF 128
 #define MAX_LENGTH_TIME_STR 14
@@ -8,35 +9,10 @@
 bool previous_message_was_newline = true;
 
 void Logging::add_timestamp(size_t size) {
-
-  size_t offset =
-      datalayer.system.info.logged_can_messages_offset;  // Keeps track of the current position in the buffer
-  size_t message_string_size = sizeof(datalayer.system.info.logged_can_messages);
   unsigned long currentTime = millis();
-  char* timestr;
-  static char timestr_buffer[MAX_LENGTH_TIME_STR];
-
-  if (datalayer.system.info.web_logging_active) {
-    if (!datalayer.system.info.can_logging_active) {
-      /* If web debug is active and can logging is inactive, 
-       * we use the debug logging memory directly for writing the timestring */
-      if (offset + size + MAX_LENGTH_TIME_STR > message_string_size) {
-        offset = 0;
-      }
-      timestr = datalayer.system.info.logged_can_messages + offset;
-    } else {
-      timestr = timestr_buffer;
-    }
-  } else {
-    timestr = timestr_buffer;
-  }
-
-  offset += min(MAX_LENGTH_TIME_STR - 1,
-                snprintf(timestr, MAX_LENGTH_TIME_STR, "%8lu.%03lu ", currentTime / 1000, currentTime % 1000));
+  char timestr[MAX_LENGTH_TIME_STR];
 
-  if (datalayer.system.info.web_logging_active && !datalayer.system.info.can_logging_active) {
-    datalayer.system.info.logged_can_messages_offset = offset;  // Update offset in buffer
-  }
+  snprintf(timestr, MAX_LENGTH_TIME_STR, "%8lu.%03lu ", currentTime / 1000, currentTime % 1000);
 
   if (datalayer.system.info.SD_logging_active) {
     add_log_to_buffer((uint8_t*)timestr, MAX_LENGTH_TIME_STR);
@@ -72,16 +48,8 @@ size_t Logging::write(const uint8_t* buffer, size_t size) {
   }
 
   if (datalayer.system.info.web_logging_active && !datalayer.system.info.can_logging_active) {
-    char* message_string = datalayer.system.info.logged_can_messages;
-    size_t offset =
-        datalayer.system.info.logged_can_messages_offset;  // Keeps track of the current position in the buffer
-    size_t message_string_size = sizeof(datalayer.system.info.logged_can_messages);
-
-    if (offset + size > message_string_size) {
-      offset = 0;
-    }
-    memcpy(message_string + offset, buffer, size);
-    datalayer.system.info.logged_can_messages_offset = offset + size;  // Update offset in buffer
+    // The ring timestamps and assembles lines per task, so output from other tasks cannot end up mid-line
+    web_log_ring.append(xTaskGetCurrentTaskHandle(), (const char*)buffer, size, millis());
   }
 
   previous_message_was_newline = buffer[size - 1] == '\n';
@@ -99,34 +67,17 @@ void Logging::printf(const char* fmt, ...) {
     add_timestamp(MAX_LINE_LENGTH_PRINTF);
   }
 
-  char* message_string = datalayer.system.info.logged_can_messages;
-  size_t message_string_size = sizeof(datalayer.system.info.logged_can_messages);
-  size_t offset =
-      datalayer.system.info.logged_can_messages_offset;  // Keeps track of the current position in the buffer
-  static char buffer[MAX_LINE_LENGTH_PRINTF];
-  char* message_buffer;
-
-  if (datalayer.system.info.web_logging_active) {
-    if (!datalayer.system.info.can_logging_active) {
-      /* If web debug is active and can logging is inactive, 
-       * we use the debug logging memory directly for writing the output */
-      if (offset + MAX_LINE_LENGTH_PRINTF > message_string_size) {
-        // Not enough space, reset and start from the beginning
-        offset = 0;
-      }
-      message_buffer = message_string + offset;
-    } else {
-      message_buffer = buffer;
-    }
-  } else {
-    message_buffer = buffer;
-  }
+  char message_buffer[MAX_LINE_LENGTH_PRINTF];
 
   va_list args;
   va_start(args, fmt);
   int size = min(MAX_LINE_LENGTH_PRINTF - 1, vsnprintf(message_buffer, MAX_LINE_LENGTH_PRINTF, fmt, args));
   va_end(args);
 
+  if (size <= 0) {
+    return;
+  }
+
   if (datalayer.system.info.SD_logging_active) {
     add_log_to_buffer((uint8_t*)message_buffer, size);
   }
@@ -136,9 +87,7 @@ void Logging::printf(const char* fmt, ...) {
   }
 
   if (datalayer.system.info.web_logging_active && !datalayer.system.info.can_logging_active) {
-    // Data was already added to buffer, just move offset
-    datalayer.system.info.logged_can_messages_offset =
-        offset + size;  // Keeps track of the current position in the buffer
+    web_log_ring.append(xTaskGetCurrentTaskHandle(), message_buffer, size, millis());
   }
 
   previous_message_was_newline = message_buffer[size - 1] == '\n';
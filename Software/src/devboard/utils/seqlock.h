@@ -0,0 +1,65 @@
+#ifndef _SEQLOCK_H_
+#define _SEQLOCK_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+// A value written by one task and copied out by any number of tasks on either core, without locks.
+//
+// The writer bumps the sequence to an odd number, updates the value and bumps it to the next even number. It never
+// waits for readers. A reader copies the value and checks that the sequence was the same even number before and
+// after the copy, otherwise a write overlapped and it copies again. Writes are expected to be short and rare
+// compared to reads, so readers hardly ever retry.
+template <typename T>
+class SeqLock {
+  static_assert(std::is_trivially_copyable<T>::value, "SeqLock values are copied with memcpy");
+
+ public:
+  // Update the value in place. fill(value) must only touch the value, it runs while readers are held off.
+  template <typename Fill>
+  void write_with(Fill fill) {
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    fill(value);
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  void write(const T& source) {
+    write_with([&source](T& target) { memcpy(&target, &source, sizeof(T)); });
+  }
+
+  // Copy a coherent value to out. Returns the amount of retries needed.
+  uint32_t read(T& out) const {
+    return read_with([&out](const T& value) { memcpy(&out, (const void*)&value, sizeof(T)); });
+  }
+
+  // Copy the parts of a coherent value that the reader needs. copy(value) must only read from the value, it runs
+  // again when a write overlapped. Returns the amount of retries needed.
+  template <typename Copy>
+  uint32_t read_with(Copy copy) const {
+    uint32_t retries = 0;
+    while (true) {
+      uint32_t before = sequence.load(std::memory_order_acquire);
+      if ((before & 1) == 0) {
+        copy(value);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+          return retries;
+        }
+      }
+      retries++;
+    }
+  }
+
+  // Amount of completed writes, readers can compare it to skip work when nothing changed
+  uint32_t version() const { return sequence.load(std::memory_order_acquire) >> 1; }
+
+ private:
+  std::atomic<uint32_t> sequence{0};
+  T value{};
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define TIME_MEAS_H_
 
 #include "esp_timer.h"
+#include "latency_histogram.h"
 
 /** Start time measurement in microseconds
  * Input parameter must be a unique "tag", e.g: START_TIME_MEASUREMENT(wifi);
@@ -19,5 +20,15 @@
  * This will log the maximum value in the destination variable.
  */
 #define END_TIME_MEASUREMENT_MAX(x, y) y = MAX(y, esp_timer_get_time() - start_time_##x)
+/** End time measurement in microseconds, log maximum and add to a latency histogram
+ * Input parameters are the unique tag, the ALREADY EXISTING destination variable (int64_t)
+ * and a Latency_Stage, e.g: END_TIME_MEASUREMENT_MAX_HISTOGRAM(wifi, my_wifi_time_int64_t, LATENCY_CONNECTIVITY_LOOP);
+ */
+#define END_TIME_MEASUREMENT_MAX_HISTOGRAM(x, y, stage)               \
+  do {                                                                \
+    int64_t elapsed_##x = esp_timer_get_time() - start_time_##x;      \
+    y = MAX(y, elapsed_##x);                                          \
+    latency_histogram_record(latency_histograms[stage], elapsed_##x); \
+  } while (0)
 
 #endif
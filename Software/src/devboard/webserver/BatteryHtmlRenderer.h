@@ -2,6 +2,7 @@
 #define _BATTERY_HTML_RENDERER_H
 
 #include <WString.h>
+#include "html_chunked_page.h"
 
 // Each battery can implement this interface to render more battery specific HTML
 // content
@@ -9,6 +10,12 @@ class BatteryHtmlRenderer {
  public:
   virtual String get_status_html() = 0;
 
+  // Adds the status HTML to a streamed page, by default as one section. A renderer with a long page overrides this
+  // with several sections, so only one of them is held in memory at a time.
+  virtual void status_sections(HtmlChunkedPage& page) {
+    page.section([this](String& content) { content += get_status_html(); });
+  }
+
   // Base URL for the upstream GitHub repository's data folder.
   // Battery renderers can pass this to get_dtc_json_loader_html() directly,
   // or supply their own URL string for a different server/fork.
@@ -63,77 +63,75 @@ std::vector<BatteryCommand> battery_commands = {
      [](Battery* b) { b->reset_energy_saving_mode(); }},
 };
 
-String advanced_battery_processor(const String& var) {
-  if (var == "X") {
-    String content = "";
-    //Page format
-    content += "<style>";
-    content += "body { background-color: black; color: white; }";
-    content +=
-        "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin: 5px; "
-        "cursor: pointer; border-radius: 10px; }";
-    content += "button:hover { background-color: #3A4A52; }";
-    content += "h4 { margin: 0.6em 0; line-height: 1.2; }";
-    content += "</style>";
-    content += "<button onclick='goToMainPage()'>Back to main page</button>";
-
+static const char advanced_battery_head[] =
+    "<style>"
+    "body { background-color: black; color: white; }"
+    "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin: 5px; "
+    "cursor: pointer; border-radius: 10px; }"
+    "button:hover { background-color: #3A4A52; }"
+    "h4 { margin: 0.6em 0; line-height: 1.2; }"
+    "</style>"
+    "<button onclick='goToMainPage()'>Back to main page</button>"
     // Start a new block with a specific background color
-    content += "<div style='background-color: #303E47; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
+    "<div style='background-color: #303E47; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
 
-    // Render buttons dynamically based on what commands the battery supports.
-    auto render_command_buttons = [&content](Battery* batt, int ix) {
-      for (const auto& cmd : battery_commands) {
-        if (cmd.condition(batt)) {
-          // Button for user action
-          content += "<button onclick='ask" + String(cmd.identifier) + "(" + String(ix) + ")'>" + String(cmd.title) +
-                     "</button>";
+static const char advanced_battery_tail[] =
+    "</div>"
+    "<script>"
+    "function exportLog() { window.location.href = '/export_log'; }"
+    "function goToMainPage() { window.location.href = '/'; }"
+    "</script>";
 
-          // Script that calls the backend to perform the command
-          content += "<script>";
-          content += "function ask" + String(cmd.identifier) + "(batteryNum) { ";
+// Render buttons dynamically based on what commands the battery supports.
+static void render_command_buttons(String& content, Battery* batt, int ix) {
+  for (const auto& cmd : battery_commands) {
+    if (cmd.condition(batt)) {
+      // Button for user action
+      content += "<button onclick='ask" + String(cmd.identifier) + "(" + String(ix) + ")'>" + String(cmd.title) +
+                 "</button>";
 
-          if (cmd.prompt) {
-            content += "if (window.confirm('Are you sure you want to " + String(cmd.prompt) + "'))";
-          }
+      // Script that calls the backend to perform the command
+      content += "<script>";
+      content += "function ask" + String(cmd.identifier) + "(batteryNum) { ";
 
-          content += "{" + String(cmd.identifier) + "(batteryNum); } }";
-          content += "function " + String(cmd.identifier) + "(batteryNum) {";
-          content += "  var xhr = new XMLHttpRequest();";
-          content += "  xhr.open('PUT', '/" + String(cmd.identifier) + "', true);";
-          // Send index of the battery as PUT content
-          content += "  xhr.send(batteryNum);";
-          content += "}";
-          content += "</script>";
-        }
+      if (cmd.prompt) {
+        content += "if (window.confirm('Are you sure you want to " + String(cmd.prompt) + "'))";
       }
-    };
 
-    if (battery) {
-      content += battery->get_status_renderer().get_status_html();
-      render_command_buttons(battery, 0);
+      content += "{" + String(cmd.identifier) + "(batteryNum); } }";
+      content += "function " + String(cmd.identifier) + "(batteryNum) {";
+      content += "  var xhr = new XMLHttpRequest();";
+      content += "  xhr.open('PUT', '/" + String(cmd.identifier) + "', true);";
+      // Send index of the battery as PUT content
+      content += "  xhr.send(batteryNum);";
+      content += "}";
+      content += "</script>";
     }
+  }
+}
 
-    if (battery2) {
-      content += "<hr>";
-      content += "<h4>Values from battery 2</h4>";
-      content += battery2->get_status_renderer().get_status_html();
-      render_command_buttons(battery2, 1);
-    }
+void advanced_battery_sections(HtmlChunkedPage& page) {
+  page.text(advanced_battery_head);
+
+  // The batteries add their values as sections of their own, so only one block is held in memory at a time
+  if (battery) {
+    battery->get_status_renderer().status_sections(page);
+    page.section([](String& content) { render_command_buttons(content, battery, 0); });
+  }
 
+  if (battery2) {
+    page.text("<hr><h4>Values from battery 2</h4>");
+    battery2->get_status_renderer().status_sections(page);
+    page.section([](String& content) { render_command_buttons(content, battery2, 1); });
+  }
+
+  page.section([](String& content) {
     if (battery3) {
       content += "<h4>Values from battery 3</h4>";
       content += "<h4 style='color: #f39c12;'>⚠️ Advanced detailed info is currently limited to the Main Battery.</h4>";
-      render_command_buttons(battery3, 2);
+      render_command_buttons(content, battery3, 2);
     }
+  });
 
-    content += "</div>";
-
-    content += "<script>";
-    content += "function exportLog() { window.location.href = '/export_log'; }";
-    content += "function goToMainPage() { window.location.href = '/'; }";
-    content += "</script>";
-
-    return content;
-  }
-  return String();
+  page.text(advanced_battery_tail);
 }
@@ -3,15 +3,14 @@
 
 #include <Arduino.h>
 #include <string>
+#include "html_chunked_page.h"
 
 /**
- * @brief Replaces placeholder with content section in web page
+ * @brief Adds the sections of the advanced battery page, streamed in place of %X% in index_html
  *
- * @param[in] var
- *
- * @return String
+ * @param[in] page
  */
-String advanced_battery_processor(const String& var);
+void advanced_battery_sections(HtmlChunkedPage& page);
 
 class Battery;
 
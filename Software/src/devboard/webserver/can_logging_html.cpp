@@ -2,12 +2,12 @@
 #include <Arduino.h>
 #include "../../communication/can/comm_can.h"
 #include "../../datalayer/datalayer.h"
+#include "../utils/log_ring.h"
 #include "index_html.h"
 
 String can_logger_processor(void) {
   if (!datalayer.system.info.can_logging_active) {
-    datalayer.system.info.logged_can_messages_offset = 0;
-    datalayer.system.info.logged_can_messages[0] = '\0';
+    web_log_ring.clear();
   }
   datalayer.system.info.can_logging_active =
       true;  // Signal to main loop that we should log messages. Disabled by default for performance reasons
@@ -42,20 +42,15 @@ String can_logger_processor(void) {
   content += "<div style='background-color: #303E47; padding: 20px; border-radius: 15px'>";
 
   // Check for messages
-  if (datalayer.system.info.logged_can_messages[0] == 0) {
+  if (web_log_ring.empty()) {
     content += "CAN logger started! Refresh page to display incoming(RX) and outgoing(TX) messages";
   } else {
-    // Split the messages using the newline character
-    String messages = String(datalayer.system.info.logged_can_messages);
-    int startIndex = 0;
-    int endIndex = messages.indexOf('\n');
-    while (endIndex != -1) {
-      // Extract a single message and wrap it in a styled div
-      String singleMessage = messages.substring(startIndex, endIndex);
-      content += "<div class='can-message'>" + singleMessage + "</div>";
-      startIndex = endIndex + 1;  // Move past the newline character
-      endIndex = messages.indexOf('\n', startIndex);
-    }
+    // Wrap every logged message in a styled div
+    web_log_ring.visit([&content](const char* line, size_t length) {
+      content += "<div class='can-message'>";
+      content.concat(line, length);
+      content += "</div>";
+    });
   }
 
   content += "</div>";
@@ -1,147 +1,159 @@
 #include "can_replay_html.h"
 #include <Arduino.h>
+#include "../../communication/can/can_replay.h"
 #include "../../datalayer/datalayer.h"
+#include "../utils/log_ring.h"
 #include "index_html.h"
 
-String can_replay_processor(void) {
+// The static parts of the page stay in flash and are streamed as they are
+static const char can_replay_head[] =
+    "<style>"
+    "body { background-color: black; color: white; font-family: Arial, sans-serif; }"
+    "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin-bottom: 20px; "
+    "cursor: pointer; border-radius: 10px; }"
+    "button:hover { background-color: #3A4A52; }"
+    ".can-message { background-color: #404E57; margin-bottom: 5px; padding: 10px; border-radius: 5px; font-family: "
+    "monospace; }"
+    "</style>"
+    "<button onclick='home()'>Back to main page</button>"
+    // Start a new block for the CAN messages
+    "<div style='background-color: #303E47; padding: 20px; border-radius: 15px'>"
+    // Ask user to select which CAN interface log should be sent to
+    "<h3>Step 1: Select CAN Interface for Playback</h3>"
+    // Dropdown with choices
+    "<label for='canInterface'>CAN Interface:</label>";
+
+static const char can_replay_playback[] =
+    "</select>"
+    // Add a button to submit the selected CAN interface
+    // This function writes the selection to datalayer.system.info.can_replay_interface
+    "<button onclick='sendCANSelection()'>Apply</button>"
+    "<h3>Step 2: Upload CAN Log File</h3>"
+    "<p>Click Browse to select a .txt CANdump log file to upload</p>"
+    "<input type='file' id='file-input' accept='.txt'>"
+    "<button id='upload-btn'>Upload</button>"
+    "<h3>Step 3: Playback control</h3>"
+    //Checkbox to see if the user wants the log to repeat once it reaches the end
+    "<input type=\"checkbox\" id=\"loopCheckbox\"> Loop ";
+
+static const char can_replay_controls[] =
+    // Add a button to start playing the log
+    "<button onclick='startReplay()'>Start</button> "
+    // Add a button to stop playing the log
+    "<button onclick='stopReplay()'>Stop</button> "
+    // Status indicator
+    "<span id='statusIndicator' style='margin-left:10px; font-weight:bold;'>Stopped</span> ";
+
+static const char can_replay_scripts[] =
+    "<h3>Uploaded Log Preview:</h3>"
+    "<pre id='file-content'></pre>"
+    "<script>"
+    "const fileInput = document.getElementById('file-input');"
+    "const uploadBtn = document.getElementById('upload-btn');"
+    "const fileContent = document.getElementById('file-content');"
+    "let selectedFile = null;"
+    "fileInput.addEventListener('change', () => { selectedFile = fileInput.files[0]; });"
+    "uploadBtn.addEventListener('click', () => {"
+    "if (!selectedFile) { alert('Please select a file first!'); return; }"
+    "const formData = new FormData();"
+    "formData.append('file', selectedFile);"
+    "const xhr = new XMLHttpRequest();"
+    "xhr.open('POST', '/import_can_log', true);"
+    "xhr.onload = () => { if (xhr.status === 200) { alert('File uploaded successfully!'); const reader = new "
+    "FileReader(); reader.onload = function (e) { fileContent.textContent = e.target.result; }; "
+    "reader.readAsText(selectedFile); } else { alert('Upload failed! Server error.'); }};"
+    "xhr.send(formData);"
+    "});"
+    "</script>"
+    "</div>"
+    // Add JavaScript for updating status
+    "<script>"
+    "function startReplay() {"
+    "  let loop = document.getElementById('loopCheckbox').checked ? 1 : 0;"
+    "  let speed = document.getElementById('speedInput').value;"
+    "  fetch('/startReplay?loop=' + loop + '&speed=' + speed, { method: 'GET' })"
+    "    .then(response => response.text())"
+    "    .then(data => {"
+    "      console.log(data);"
+    "      document.getElementById('statusIndicator').innerText = 'Running...';"
+    "      document.getElementById('statusIndicator').style.color = 'green';"
+    "      if (loop === 0) {"  // If loop is not checked
+    "        setTimeout(() => {"
+    "          document.getElementById('statusIndicator').innerText = 'Completed';"
+    "          document.getElementById('statusIndicator').style.color = 'white';"
+    "        }, 5000);"  // 5-second timeout before reverting the text
+    "      }"
+    "    })"
+    "    .catch(error => console.error('Error:', error));"
+    "}"
+    "function stopReplay() {"
+    "  fetch('/stopReplay', { method: 'GET' })"
+    "    .then(response => response.text())"
+    "    .then(data => {"
+    "      console.log(data);"
+    "      document.getElementById('statusIndicator').innerText = 'Stopped';"
+    "      document.getElementById('statusIndicator').style.color = 'red';"
+    "    })"
+    "    .catch(error => console.error('Error:', error));"
+    "}"
+    "function sendCANSelection() {"
+    "  var selectedInterface = document.getElementById('canInterface').value;"
+    "  var xhr = new XMLHttpRequest();"
+    "  xhr.open('GET', '/setCANInterface?interface=' + selectedInterface, true);"
+    "  xhr.onreadystatechange = function() {"
+    "    if (xhr.readyState === 4) {"
+    "      if (xhr.status === 200) {"
+    "        alert('Success: ' + xhr.responseText);"
+    "      } else {"
+    "        alert('Error: ' + xhr.responseText);"
+    "      }"
+    "    }"
+    "  };"
+    "  xhr.send();"
+    "}"
+    "function home() { window.location.href = '/'; }"
+    "</script>";
+
+void can_replay_page(HtmlChunkedPage& page) {
   if (!datalayer.system.info.can_logging_active) {
-    datalayer.system.info.logged_can_messages_offset = 0;
-    datalayer.system.info.logged_can_messages[0] = '\0';
+    web_log_ring.clear();
   }
   datalayer.system.info.can_logging_active =
       true;  // Signal to main loop that we should log messages. Disabled by default for performance reasons
-  String content = index_html_header;
-  // Page format
-  content += "<style>";
-  content += "body { background-color: black; color: white; font-family: Arial, sans-serif; }";
-  content +=
-      "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin-bottom: 20px; "
-      "cursor: pointer; border-radius: 10px; }";
-  content += "button:hover { background-color: #3A4A52; }";
-  content +=
-      ".can-message { background-color: #404E57; margin-bottom: 5px; padding: 10px; border-radius: 5px; font-family: "
-      "monospace; }";
-  content += "</style>";
-  content += "<button onclick='home()'>Back to main page</button>";
 
-  // Start a new block for the CAN messages
-  content += "<div style='background-color: #303E47; padding: 20px; border-radius: 15px'>";
-
-  // Ask user to select which CAN interface log should be sent to
-  content += "<h3>Step 1: Select CAN Interface for Playback</h3>";
-
-  // Dropdown with choices
-  content += "<label for='canInterface'>CAN Interface:</label>";
-  content += "<select id='canInterface' name='canInterface'>";
-  content += "<option value='" + String(CAN_NATIVE) + "' " +
-             (datalayer.system.info.can_replay_interface == CAN_NATIVE ? "selected" : "") + ">CAN Native</option>";
-  content += "<option value='" + String(CANFD_NATIVE) + "' " +
-             (datalayer.system.info.can_replay_interface == CANFD_NATIVE ? "selected" : "") + ">CANFD Native</option>";
-  content += "<option value='" + String(CAN_ADDON_MCP2515) + "' " +
-             (datalayer.system.info.can_replay_interface == CAN_ADDON_MCP2515 ? "selected" : "") +
-             ">CAN Addon MCP2515</option>";
-  content += "<option value='" + String(CANFD_ADDON_MCP2518) + "' " +
-             (datalayer.system.info.can_replay_interface == CANFD_ADDON_MCP2518 ? "selected" : "") +
-             ">CANFD Addon MCP2518</option>";
-
-  content += "</select>";
-
-  // Add a button to submit the selected CAN interface
-  // This function writes the selection to datalayer.system.info.can_replay_interface
-  content += "<button onclick='sendCANSelection()'>Apply</button>";
-
-  content += "<h3>Step 2: Upload CAN Log File</h3>";
-  content += "<p>Click Browse to select a .txt CANdump log file to upload</p>";
-  content += "<input type='file' id='file-input' accept='.txt'>";
-  content += "<button id='upload-btn'>Upload</button>";
-
-  content += "<h3>Step 3: Playback control</h3>";
-
-  //Checkbox to see if the user wants the log to repeat once it reaches the end
-  content += "<input type=\"checkbox\" id=\"loopCheckbox\"> Loop ";
-
-  // Add a button to start playing the log
-  content += "<button onclick='startReplay()'>Start</button> ";
-
-  // Add a button to stop playing the log
-  content += "<button onclick='stopReplay()'>Stop</button> ";
-
-  // Status indicator
-  content += "<span id='statusIndicator' style='margin-left:10px; font-weight:bold;'>Stopped</span> ";
-
-  content += "<h3>Uploaded Log Preview:</h3>";
-  content += "<pre id='file-content'></pre>";
-
-  content += "<script>";
-  content += "const fileInput = document.getElementById('file-input');";
-  content += "const uploadBtn = document.getElementById('upload-btn');";
-  content += "const fileContent = document.getElementById('file-content');";
-  content += "let selectedFile = null;";
-
-  content += "fileInput.addEventListener('change', () => { selectedFile = fileInput.files[0]; });";
-
-  content += "uploadBtn.addEventListener('click', () => {";
-  content += "if (!selectedFile) { alert('Please select a file first!'); return; }";
-  content += "const formData = new FormData();";
-  content += "formData.append('file', selectedFile);";
-  content += "const xhr = new XMLHttpRequest();";
-  content += "xhr.open('POST', '/import_can_log', true);";
-  content +=
-      "xhr.onload = () => { if (xhr.status === 200) { alert('File uploaded successfully!'); const reader = new "
-      "FileReader(); reader.onload = function (e) { fileContent.textContent = e.target.result; }; "
-      "reader.readAsText(selectedFile); } else { alert('Upload failed! Server error.'); }};";
-  content += "xhr.send(formData);";
-  content += "});";
-  content += "</script>";
-
-  content += "</div>";
-
-  // Add JavaScript for updating status
-  content += "<script>";
-  content += "function startReplay() {";
-  content += "  let loop = document.getElementById('loopCheckbox').checked ? 1 : 0;";
-  content += "  fetch('/startReplay?loop=' + loop, { method: 'GET' })";
-  content += "    .then(response => response.text())";
-  content += "    .then(data => {";
-  content += "      console.log(data);";
-  content += "      document.getElementById('statusIndicator').innerText = 'Running...';";
-  content += "      document.getElementById('statusIndicator').style.color = 'green';";
-  content += "      if (loop === 0) {";  // If loop is not checked
-  content += "        setTimeout(() => {";
-  content += "          document.getElementById('statusIndicator').innerText = 'Completed';";
-  content += "          document.getElementById('statusIndicator').style.color = 'white';";
-  content += "        }, 5000);";  // 5-second timeout before reverting the text
-  content += "      }";
-  content += "    })";
-  content += "    .catch(error => console.error('Error:', error));";
-  content += "}";
-  content += "function stopReplay() {";
-  content += "  fetch('/stopReplay', { method: 'GET' })";
-  content += "    .then(response => response.text())";
-  content += "    .then(data => {";
-  content += "      console.log(data);";
-  content += "      document.getElementById('statusIndicator').innerText = 'Stopped';";
-  content += "      document.getElementById('statusIndicator').style.color = 'red';";
-  content += "    })";
-  content += "    .catch(error => console.error('Error:', error));";
-  content += "}";
-  content += "function sendCANSelection() {";
-  content += "  var selectedInterface = document.getElementById('canInterface').value;";
-  content += "  var xhr = new XMLHttpRequest();";
-  content += "  xhr.open('GET', '/setCANInterface?interface=' + selectedInterface, true);";
-  content += "  xhr.onreadystatechange = function() {";
-  content += "    if (xhr.readyState === 4) {";
-  content += "      if (xhr.status === 200) {";
-  content += "        alert('Success: ' + xhr.responseText);";
-  content += "      } else {";
-  content += "        alert('Error: ' + xhr.responseText);";
-  content += "      }";
-  content += "    }";
-  content += "  };";
-  content += "  xhr.send();";
-  content += "}";
-  content += "function home() { window.location.href = '/'; }";
-  content += "</script>";
-  content += index_html_footer;
-  return content;
+  page.text(index_html_header).text(can_replay_head);
+  page.section([](String& content) {
+    content += "<select id='canInterface' name='canInterface'>";
+    content += "<option value='" + String(CAN_NATIVE) + "' " +
+               (datalayer.system.info.can_replay_interface == CAN_NATIVE ? "selected" : "") + ">CAN Native</option>";
+    content += "<option value='" + String(CANFD_NATIVE) + "' " +
+               (datalayer.system.info.can_replay_interface == CANFD_NATIVE ? "selected" : "") +
+               ">CANFD Native</option>";
+    content += "<option value='" + String(CAN_ADDON_MCP2515) + "' " +
+               (datalayer.system.info.can_replay_interface == CAN_ADDON_MCP2515 ? "selected" : "") +
+               ">CAN Addon MCP2515</option>";
+    content += "<option value='" + String(CANFD_ADDON_MCP2518) + "' " +
+               (datalayer.system.info.can_replay_interface == CANFD_ADDON_MCP2518 ? "selected" : "") +
+               ">CANFD Addon MCP2518</option>";
+  });
+  page.text(can_replay_playback);
+  page.section([](String& content) {
+    // Playback speed relative to the timestamps in the log
+    content += "<input type=\"number\" id=\"speedInput\" value=\"" +
+               String(datalayer.system.info.can_replay_speed_percent / 100.0f, 2) +
+               "\" min=\"0.01\" max=\"100\" step=\"0.01\" style=\"width: 5em;\"> x speed ";
+  });
+  page.text(can_replay_controls);
+  page.section([](String& content) {
+    // Loaded log and timing of the last replay
+    content += "<p style='font-family: monospace;'>Loaded log: " + String(can_replay_log.size()) + " frames, " +
+               String(can_replay_log.memory_used() / 1024) + " kB, " + String(can_replay_log.skipped_lines()) +
+               " lines skipped<br>";
+    content += "Last replay: " + String(can_replay_statistics.frames_sent) + " frames, " +
+               String(can_replay_statistics.loops) + " loops, inter-frame jitter mean " +
+               String(can_replay_mean_jitter_us(can_replay_statistics)) + " us, max " +
+               String(can_replay_statistics.max_jitter_us) + " us, max lateness " +
+               String(can_replay_statistics.max_lateness_us) + " us</p>";
+  });
+  page.text(can_replay_scripts).text(index_html_footer);
 }
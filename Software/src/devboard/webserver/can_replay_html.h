@@ -3,14 +3,13 @@
 
 #include <Arduino.h>
 #include <string>
+#include "html_chunked_page.h"
 
 /**
- * @brief Replaces placeholder with content section in web page
+ * @brief Adds the CAN replay page, including header and footer
  *
- * @param[in] var
- *
- * @return String
+ * @param[in] page
  */
-String can_replay_processor(void);
+void can_replay_page(HtmlChunkedPage& page);
 
 #endif
@@ -1,15 +1,13 @@
 #ifndef CELLMONITOR_H
 #define CELLMONITOR_H
 
-#include <WString.h>
+#include "html_chunked_page.h"
 
 /**
- * @brief Replaces placeholder with content section in web page
+ * @brief Adds the sections of the cell monitor page, streamed in place of %X% in index_html
  *
- * @param[in] var
- *
- * @return String
+ * @param[in] page
  */
-String cellmonitor_processor(const String& var);
+void cellmonitor_sections(HtmlChunkedPage& page);
 
 #endif
@@ -1,41 +1,22 @@
 #include "debug_logging_html.h"
 #include <Arduino.h>
 #include "../../datalayer/datalayer.h"
+#include "../sdcard/sdcard.h"
+#include "../utils/log_ring.h"
 #include "index_html.h"
 
-char* strnchr(const char* s, int c, size_t n) {
-  // Like strchr, but only searches the first 'n' bytes of the string.
-
-  if (s == NULL) {
-    return NULL;
-  }
-
-  // Iterate through the string up to 'n' characters or until a null terminator is found.
-  for (size_t i = 0; i < n && s[i] != '\0'; ++i) {
-    if (s[i] == c) {
-      // Character found, return a pointer to it.
-      return (char*)&s[i];
-    }
-  }
-
-  // If the character to be found is the null terminator, and we haven't exceeded
-  // 'n' bytes, check if the null terminator is at the current position.
-  if (c == '\0') {
-    for (size_t i = 0; i < n; ++i) {
-      if (s[i] == '\0') {
-        return (char*)&s[i];
-      }
-    }
-  }
-
-  // Character not found within the first 'n' bytes.
-  return NULL;
+static String sd_log_statistics_line(const char* name, const SD_Log_Statistics& stats) {
+  return String(name) + ": " + String(stats.bytes_written / 1024) + " kB written, " + String(stats.bytes_per_second) +
+         " B/s, " + String(stats.blocks_written) + " blocks of " + String(stats.block_size) + " B, " +
+         String(stats.flushes) + " flushes, ring buffer peak " + String(stats.ring_high_water) + "/" +
+         String(stats.ring_size) + " B, " + String(stats.items_dropped) + " dropped, " + String(stats.write_failures) +
+         " failed writes<br>";
 }
 
 String debug_logger_processor(void) {
   String content = String();
   // Reserve enough space for the content to avoid reallocations.
-  if (!content.reserve(1000 + sizeof(datalayer.system.info.logged_can_messages))) {
+  if (!content.reserve(1000 + web_log_ring.capacity())) {
     if (content.reserve(15)) {
       content += "Out of memory.";
     }
@@ -62,36 +43,23 @@ String debug_logger_processor(void) {
   }
   content += "<button onclick='goToMainPage()'>Back to main page</button>";
 
-  // Start a new block for the debug log messages
-  content += "<PRE style='text-align: left'>";
-  size_t offset = datalayer.system.info.logged_can_messages_offset;
-  // If we're mid-buffer, print the older part first.
-  if (offset > 0 && offset < (sizeof(datalayer.system.info.logged_can_messages) - 1)) {
-    // Find the next newline after the current offset. The offset will always be
-    // before the penultimate character, so (offset + 1) will be the final '\0'
-    // or earlier.
-
-    char* next_newline = strnchr(&datalayer.system.info.logged_can_messages[offset + 1], '\n',
-                                 sizeof(datalayer.system.info.logged_can_messages) - offset - 1);
-
-    if (next_newline != NULL) {
-      // We found a newline, so append from the character after that. We check
-      // the string length to ensure we don't add any intermediate '\0'
-      // characters.
-      content.concat(next_newline + 1,
-                     strnlen(next_newline + 1, sizeof(datalayer.system.info.logged_can_messages) - offset - 2));
-    } else {
-      // No newline found, so append from the next character after the offset to
-      // the end of the buffer. We check the string length to ensure we don't
-      // add any intermediate '\0' characters.
-      content.concat(&datalayer.system.info.logged_can_messages[offset + 1],
-                     strnlen(&datalayer.system.info.logged_can_messages[offset + 1],
-                             sizeof(datalayer.system.info.logged_can_messages) - offset - 1));
+  if (datalayer.system.info.SD_logging_active || datalayer.system.info.CAN_SD_logging_active) {
+    content += "<div style='font-family: monospace;'>";
+    if (datalayer.system.info.SD_logging_active) {
+      content += sd_log_statistics_line("SD debug log", sd_debug_log_statistics);
     }
+    if (datalayer.system.info.CAN_SD_logging_active) {
+      content += sd_log_statistics_line("SD CAN log", sd_can_log_statistics);
+    }
+    content += "</div>";
   }
-  // Append the first part of the buffer up to the current write offset (which
-  // points to the first \0).
-  content.concat(datalayer.system.info.logged_can_messages, offset);
+
+  // Start a new block for the debug log messages
+  content += "<PRE style='text-align: left'>";
+  web_log_ring.visit([&content](const char* line, size_t length) {
+    content.concat(line, length);
+    content += '\n';
+  });
   content += "</PRE>";
 
   // Add JavaScript for navigation
@@ -0,0 +1,159 @@
+#include "history_response.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static_assert(sizeof(History_Binary_Header) == 16, "Binary history header is part of the format");
+static_assert(sizeof(History_Binary_Entry) == 8, "Binary history entry is part of the format");
+
+bool history_resolution_for_interval(uint32_t interval_s, uint8_t& resolution) {
+  for (uint8_t r = 0; r < HISTORY_RESOLUTIONS; r++) {
+    if (history_interval_s[r] == interval_s) {
+      resolution = r;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parse_history_cells(const char* text, uint16_t kept_cells, uint16_t& first_cell, uint16_t& cells) {
+  first_cell = 0;
+  cells = 0;
+  if (strcmp(text, "none") == 0) {
+    return true;
+  }
+  if (strcmp(text, "all") == 0) {
+    cells = kept_cells;
+    return true;
+  }
+
+  char* rest;
+  unsigned long first = strtoul(text, &rest, 10);
+  unsigned long last = first;
+  if (rest == text) {
+    return false;
+  }
+  if (*rest == '-') {
+    const char* second = rest + 1;
+    last = strtoul(second, &rest, 10);
+    if (rest == second) {
+      return false;
+    }
+  }
+  if (*rest != '\0' || first == 0 || last < first) {
+    return false;
+  }
+  if (first > kept_cells) {
+    return true;
+  }
+  if (last > kept_cells) {
+    last = kept_cells;
+  }
+  first_cell = first - 1;
+  cells = last - first + 1;
+  return true;
+}
+
+HistoryResponse::HistoryResponse(const TelemetryHistory& history, const History_Query& query, uint32_t now_s)
+    : history(history), query(query), now_s(now_s) {
+  if (this->query.first_cell >= history.cells()) {
+    this->query.cells = 0;
+  } else if (this->query.first_cell + this->query.cells > history.cells()) {
+    this->query.cells = history.cells() - this->query.first_cell;
+  }
+  if (this->query.cells == 0) {
+    this->query.first_cell = 0;
+  }
+  fields = HISTORY_PACK_FIELDS + this->query.cells;
+  // One copy from the start of the entry up to the last cell, so pack values and cells are from the same entry
+  values.resize(HISTORY_PACK_FIELDS + this->query.first_cell + this->query.cells);
+  sequence = history.find(query.resolution, query.from_s);
+  end = history.end(query.resolution);
+}
+
+void HistoryResponse::render_header() {
+  const uint16_t interval_s = history_interval_s[query.resolution];
+  if (query.binary) {
+    History_Binary_Header header = {};
+    memcpy(header.magic, HISTORY_BINARY_MAGIC, sizeof(header.magic));
+    header.version = HISTORY_BINARY_VERSION;
+    header.interval_s = interval_s;
+    header.fields = fields;
+    header.first_cell = query.first_cell;
+    header.now_s = now_s;
+    pending.assign((const char*)&header, sizeof(header));
+    return;
+  }
+
+  pending = "{\"interval_s\":" + std::to_string(interval_s) + ",\"now_s\":" + std::to_string(now_s) + ",\"fields\":[";
+  for (uint8_t f = 0; f < HISTORY_PACK_FIELDS; f++) {
+    pending += f == 0 ? "\"" : ",\"";
+    pending += history_field_names[f];
+    pending += '"';
+  }
+  for (uint16_t c = 0; c < query.cells; c++) {
+    pending += ",\"cell_" + std::to_string(query.first_cell + c + 1) + "_mV\"";
+  }
+  pending += "],\"entries\":[";
+}
+
+bool HistoryResponse::render_entry() {
+  const History_Value* cells = values.data() + HISTORY_PACK_FIELDS + query.first_cell;
+  while (sequence != end) {
+    uint32_t time_s;
+    uint16_t samples;
+    const bool readable = history.read(query.resolution, sequence, time_s, samples, values.data(), 0, values.size());
+    sequence++;
+    if (!readable) {
+      continue;  // Overwritten since the response started
+    }
+    if (time_s > query.to_s) {
+      sequence = end;
+      return false;
+    }
+
+    if (query.binary) {
+      History_Binary_Entry entry = {time_s, samples, 0};
+      pending.assign((const char*)&entry, sizeof(entry));
+      pending.append((const char*)values.data(), HISTORY_PACK_FIELDS * sizeof(History_Value));
+      pending.append((const char*)cells, query.cells * sizeof(History_Value));
+    } else {
+      char number[24];
+      snprintf(number, sizeof(number), "%s[%u,%u", entries_sent == 0 ? "" : ",", (unsigned)time_s,
+               (unsigned)samples);
+      pending = number;
+      for (uint16_t f = 0; f < fields; f++) {
+        const History_Value& v = f < HISTORY_PACK_FIELDS ? values[f] : cells[f - HISTORY_PACK_FIELDS];
+        snprintf(number, sizeof(number), ",%d,%d,%d", v.min, v.max, v.avg);
+        pending += number;
+      }
+      pending += ']';
+    }
+    entries_sent++;
+    return true;
+  }
+  return false;
+}
+
+size_t HistoryResponse::fill(uint8_t* buffer, size_t max_len) {
+  if (offset == pending.size()) {
+    pending.clear();
+    offset = 0;
+    if (!header_sent) {
+      render_header();
+      header_sent = true;
+    } else if (!render_entry()) {
+      if (finished || query.binary) {
+        return 0;
+      }
+      pending = "]}";
+      finished = true;
+    }
+  }
+
+  size_t count = pending.size() - offset < max_len ? pending.size() - offset : max_len;
+  memcpy(buffer, pending.data() + offset, count);
+  offset += count;
+  return count;
+}
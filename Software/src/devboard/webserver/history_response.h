@@ -0,0 +1,88 @@
+#ifndef HISTORY_RESPONSE_H
+#define HISTORY_RESPONSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "../../datalayer/telemetry_history.h"
+
+// Range of the telemetry history for /api/v1/history
+typedef struct {
+  /** Index into history_interval_s */
+  uint8_t resolution;
+  /** Entries starting from from_s up to and including to_s, in seconds of uptime */
+  uint32_t from_s;
+  uint32_t to_s;
+  /** Cell voltages to include, starting at first_cell (0 based), 0 cells for only the pack values */
+  uint16_t first_cell;
+  uint16_t cells;
+  /** Compact binary instead of JSON */
+  bool binary;
+} History_Query;
+
+// First bytes of the binary format, followed by the version
+#define HISTORY_BINARY_MAGIC "BEH"
+#define HISTORY_BINARY_VERSION 1
+
+// Header of the binary format. Every entry follows as a History_Binary_Entry with fields * 3 int16 values after it,
+// min, max and average of each field. All values are little endian.
+typedef struct {
+  char magic[3];
+  uint8_t version;
+  uint16_t interval_s;
+  /** Pack fields plus the cells in the response */
+  uint16_t fields;
+  uint16_t first_cell;
+  uint16_t reserved;
+  /** Uptime when the response was started */
+  uint32_t now_s;
+} History_Binary_Header;
+
+typedef struct {
+  uint32_t time_s;
+  uint16_t samples;
+  uint16_t reserved;
+} History_Binary_Entry;
+
+// Resolution index for an interval in seconds (1, 60 or 900). Returns false for other intervals.
+bool history_resolution_for_interval(uint32_t interval_s, uint8_t& resolution);
+
+// Parse a cell range like "1-16" (1 based, inclusive), "all" or "none" against the cells kept by the history.
+// The range is clipped to the kept cells. Returns false if the text is not a range.
+bool parse_history_cells(const char* text, uint16_t kept_cells, uint16_t& first_cell, uint16_t& cells);
+
+// Streams a range of the history as a chunked response, one entry at a time, so a long range needs no more heap
+// than a single entry. Entries overwritten while the response is being sent are left out.
+//
+// JSON: {"interval_s":60,"now_s":..,"fields":["voltage_dV",..,"cell_1_mV",..],"entries":[[time_s,samples,
+// min,max,avg,min,max,avg,..],..]} with min, max and average of every field in the order of "fields".
+class HistoryResponse {
+ public:
+  HistoryResponse(const TelemetryHistory& history, const History_Query& query, uint32_t now_s);
+
+  // Fills the response buffer with up to max_len bytes. Returns 0 once the response is complete. Matches
+  // AwsResponseFiller, with this object as the state that tracks the position.
+  size_t fill(uint8_t* buffer, size_t max_len);
+
+ private:
+  void render_header();
+  // Render the next readable entry into pending. Returns false once the range is done.
+  bool render_entry();
+
+  const TelemetryHistory& history;
+  History_Query query;
+  uint32_t now_s;
+  uint16_t fields;
+  /** Next entry to send, and the end of the range when the response started */
+  uint32_t sequence;
+  uint32_t end;
+  uint32_t entries_sent = 0;
+  bool header_sent = false;
+  bool finished = false;
+  std::vector<History_Value> values;
+  std::string pending;
+  size_t offset = 0;
+};
+
+#endif  // HISTORY_RESPONSE_H
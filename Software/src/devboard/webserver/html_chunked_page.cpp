@@ -0,0 +1,65 @@
+#include "html_chunked_page.h"
+#include <string.h>
+
+HTML_Render_Statistics html_render_statistics = {};
+
+HtmlChunkedPage& HtmlChunkedPage::text(const char* flash_text) {
+  parts.push_back({flash_text, nullptr});
+  return *this;
+}
+
+HtmlChunkedPage& HtmlChunkedPage::section(Section render) {
+  parts.push_back({nullptr, render});
+  return *this;
+}
+
+bool HtmlChunkedPage::next_part() {
+  while (part < parts.size()) {
+    Part& current = parts[part++];
+    if (current.text) {
+      pending = current.text;
+      pending_length = strlen(current.text);
+    } else {
+      // Keeps the capacity of the scratch String, so sections after the largest one do not allocate
+      scratch = "";
+      current.render(scratch);
+      current.render = nullptr;
+      pending = scratch.c_str();
+      pending_length = scratch.length();
+      if (pending_length > largest_section) {
+        largest_section = pending_length;
+      }
+    }
+    if (pending_length > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void HtmlChunkedPage::finish() {
+  finished = true;
+  html_render_statistics.pages++;
+  html_render_statistics.bytes_last_page = bytes_sent;
+  html_render_statistics.largest_section_last_page = largest_section;
+  if (largest_section > html_render_statistics.largest_section) {
+    html_render_statistics.largest_section = largest_section;
+  }
+}
+
+size_t HtmlChunkedPage::fill(uint8_t* buffer, size_t max_len) {
+  size_t written = 0;
+  while (written < max_len && !finished) {
+    if (pending_length == 0 && !next_part()) {
+      finish();
+      break;
+    }
+    size_t count = pending_length < max_len - written ? pending_length : max_len - written;
+    memcpy(buffer + written, pending, count);
+    pending += count;
+    pending_length -= count;
+    written += count;
+    bytes_sent += count;
+  }
+  return written;
+}
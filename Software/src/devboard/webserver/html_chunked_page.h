@@ -0,0 +1,59 @@
+#ifndef HTML_CHUNKED_PAGE_H
+#define HTML_CHUNKED_PAGE_H
+
+#include <WString.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+// Streams a web page as a chunked response instead of building it in one String.
+//
+// A page is a list of parts. Text parts point at constant text in flash and are copied straight into the response
+// buffer. Section parts render a small piece of dynamic HTML, such as one block of the status page, into a scratch
+// String when the response gets to them. So the heap needed for a page view is the largest section, not the page.
+
+typedef struct {
+  uint32_t pages;
+  /** Bytes sent for the last page */
+  uint32_t bytes_last_page;
+  /** Largest rendered section of the last page, which bounds its heap use */
+  uint32_t largest_section_last_page;
+  /** Largest rendered section of any page since boot */
+  uint32_t largest_section;
+} HTML_Render_Statistics;
+
+extern HTML_Render_Statistics html_render_statistics;
+
+class HtmlChunkedPage {
+ public:
+  typedef std::function<void(String& out)> Section;
+
+  HtmlChunkedPage& text(const char* flash_text);
+  HtmlChunkedPage& section(Section render);
+
+  // Fills the response buffer with up to max_len bytes of the page. Returns 0 once the page is complete. Matches
+  // AwsResponseFiller, with the page as the state that tracks the position.
+  size_t fill(uint8_t* buffer, size_t max_len);
+
+ private:
+  typedef struct {
+    const char* text;
+    Section render;
+  } Part;
+
+  // Make pending point at the next part with something to send. Returns false at the end of the page.
+  bool next_part();
+  void finish();
+
+  std::vector<Part> parts;
+  size_t part = 0;
+  const char* pending = nullptr;
+  size_t pending_length = 0;
+  String scratch;
+  uint32_t bytes_sent = 0;
+  uint32_t largest_section = 0;
+  bool finished = false;
+};
+
+#endif  // HTML_CHUNKED_PAGE_H
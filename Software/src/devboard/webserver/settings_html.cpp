@@ -6,6 +6,7 @@
 #include "../../communication/can/comm_can.h"
 #include "../../communication/nvm/comm_nvm.h"
 #include "../../datalayer/datalayer.h"
+#include "../mqtt/mqtt_cells.h"
 #include "html_escape.h"
 #include "index_html.h"
 #include "src/battery/BATTERIES.h"
@@ -104,6 +105,12 @@ static const std::map<int, String> led_modes = {{0, "Classic"},     {1, "Energy
 static const std::map<int, String> led_modes = {{0, "Classic"}, {1, "Energy Flow"}, {2, "Heartbeat"}};
 #endif
 
+static const std::map<int, String> mqtt_cell_formats = {
+    {(int)MqttCellFormat::Float, mqtt_cell_format_name(MqttCellFormat::Float)},
+    {(int)MqttCellFormat::Millivolts, mqtt_cell_format_name(MqttCellFormat::Millivolts)},
+    {(int)MqttCellFormat::DeltaFromMin, mqtt_cell_format_name(MqttCellFormat::DeltaFromMin)},
+    {(int)MqttCellFormat::Base64, mqtt_cell_format_name(MqttCellFormat::Base64)}};
+
 static const std::map<int, String> tesla_countries = {
     {21843, "US (USA)"},     {17217, "CA (Canada)"},  {18242, "GB (UK & N Ireland)"},
     {17483, "DK (Denmark)"}, {17477, "DE (Germany)"}, {16725, "AU (Australia)"}};
@@ -377,6 +384,14 @@ String raw_settings_processor(const String& var, BatteryEmulatorSettingsStore& s
     return settings.getBool("WEBAUTH") ? "checked" : "";
   }
 
+  if (var == "WEBPUSHMS") {
+    return String(settings.getUInt("WEBPUSHMS", 1000));
+  }
+
+  if (var == "HISTDRAMKB") {
+    return String(settings.getUInt("HISTDRAMKB", 0));
+  }
+
   if (var == "HTTPUSER") {
     return settings.getString("HTTPUSER", "admin");
   }
@@ -509,6 +524,10 @@ String raw_settings_processor(const String& var, BatteryEmulatorSettingsStore& s
     return settings.getBool("CANFDASCAN") ? "checked" : "";
   }
 
+  if (var == "CANHWFILTER") {
+    return settings.getBool("CANHWFILTER", true) ? "checked" : "";
+  }
+
   if (var == "WIFIAPENABLED") {
     return settings.getBool("WIFIAPENABLED", wifiap_enabled) ? "checked" : "";
   }
@@ -653,6 +672,22 @@ String raw_settings_processor(const String& var, BatteryEmulatorSettingsStore& s
     return String(settings.getUInt("MQTTPUBLISHMS", 5000) / 1000);
   }
 
+  if (var == "MQTTCELLFMT") {
+    return options_from_map(settings.getUInt("MQTTCELLFMT", (int)MqttCellFormat::Float), mqtt_cell_formats);
+  }
+
+  if (var == "MQTTDELTA") {
+    return settings.getBool("MQTTDELTA") ? "checked" : "";
+  }
+
+  if (var == "MQTTREFRESH") {
+    return String(settings.getUInt("MQTTREFRESH", 300));
+  }
+
+  if (var == "MQTTDBCELL") {
+    return String(settings.getUInt("MQTTDBCELL", 5));
+  }
+
   if (var == "MQTTOBJIDPREFIX") {
     return settings.getString("MQTTOBJIDPREFIX");
   }
@@ -903,6 +938,10 @@ String raw_settings_processor(const String& var, BatteryEmulatorSettingsStore& s
     return String(settings.getUInt("CANFDFREQ", 40));
   }
 
+  if (var == "CANRXBURST") {
+    return String(settings.getUInt("CANRXBURST", CAN_RX_BURST_DEFAULT));
+  }
+
   if (var == "PRECHGMS") {
     return String(settings.getUInt("PRECHGMS", 100));
   }
@@ -1478,6 +1517,11 @@ const char* getCANInterfaceName(CAN_Interface interface) {
 
         <label>Show web interface password: </label>
         <input type='checkbox' onchange='toggleWebPasswordVisibility(this.checked)' />
+
+        <label>Live value push interval ms: </label>
+        <input name='WEBPUSHMS' type='number' value="%WEBPUSHMS%"
+        min="0" max="60000" step="1"
+        title="Shortest time between updates on /api/v1/events, 0 disables the stream (0-60000). Default: 1000" />
         </div>
         </div>
 
@@ -1784,6 +1828,15 @@ const char* getCANInterfaceName(CAN_Interface interface) {
         <input type='number' name='CANFDFREQ' value="%CANFDFREQ%" 
         min="0" max="1000" step="1"
         title="Configure this if you are using a custom add-on CAN board. Integers only" />
+
+        <label>Native CAN RX frames per cycle: </label>
+        <input type='number' name='CANRXBURST' value="%CANRXBURST%" 
+        min="1" max="64" step="1"
+        title="Maximum amount of CAN frames handled per 1ms cycle on the native CAN port. Raise this on very busy CAN buses" />
+
+        <label>CAN hardware filters: </label>
+        <input type='checkbox' name='CANHWFILTER' value='on' %CANHWFILTER% 
+        title="Let the CAN controllers drop frames that no selected integration uses. Disable to see all bus traffic in the CAN log" />
         
         <label>Equipment stop button: </label><select name='EQSTOP'>
         %EQSTOP%  
@@ -1946,6 +1999,20 @@ const char* getCANInterfaceName(CAN_Interface interface) {
         min="1" max="300" step="1"
         title="How often to publish MQTT messages in seconds (1-300, step 1). Default: 5" />
         <label>Send all cellvoltages via MQTT: </label><input type='checkbox' name='MQTTCELLV' value='on' %MQTTCELLV% />
+        <label for='MQTTCELLFMT'>MQTT cellvoltage format: </label><select name='MQTTCELLFMT' id='MQTTCELLFMT'
+        title="Compact formats are sent in chunks of 48 cells on spec_data/0, spec_data/1 and so on">
+        %MQTTCELLFMT%
+        </select>
+        <label>Only publish changed MQTT values: </label>
+        <input type='checkbox' name='MQTTDELTA' value='on' %MQTTDELTA% />
+        <label>MQTT full refresh interval (seconds): </label>
+        <input name='MQTTREFRESH' type='number' value="%MQTTREFRESH%" 
+        min="10" max="3600" step="1"
+        title="With changed-only publishing, how often all values are sent for new subscribers (10-3600). Default: 300" />
+        <label>MQTT cell voltage deadband mV: </label>
+        <input name='MQTTDBCELL' type='number' value="%MQTTDBCELL%" 
+        min="0" max="100" step="1"
+        title="With changed-only publishing, cell voltages are sent when a cell moved more than this (0-100). Default: 5" />
         <label>Remote BMS reset via MQTT allowed: </label>
         <input type='checkbox' name='REMBMSRESET' value='on' %REMBMSRESET% />
         <label>Customized MQTT topics: </label>
@@ -1976,6 +2043,11 @@ const char* getCANInterfaceName(CAN_Interface interface) {
         <input type='checkbox' name='PERFPROFILE' value='on' %PERFPROFILE%          
               title="For developers. Enable this to get detailed performance metrics on the front page" />
 
+        <label>Telemetry history RAM kB without PSRAM: </label>
+        <input name='HISTDRAMKB' type='number' value="%HISTDRAMKB%"
+        min="0" max="64" step="1"
+        title="Internal RAM for the pack value history on boards without PSRAM, 0 keeps it off. Less than 8 kB free for it also keeps it off. Takes effect after reboot (0-64). Default: 0" />
+
         <label>Enable CAN message logging via USB serial: </label>
         <input type='checkbox' name='CANLOGUSB' value='on' %CANLOGUSB%  
               title="WARNING: Causes performance issues. Enable this to get incoming/outgoing CAN messages logged via USB cable. Avoid if possible" />
@@ -0,0 +1,77 @@
+#include "status_events.h"
+#include <string.h>
+
+void StatusEvents::poll(uint32_t now_ms) {
+  if (started && now_ms - published_ms < interval_ms) {
+    return;
+  }
+  started = true;
+  published_ms = now_ms;
+
+  JsonDocument doc;
+  build(doc.to<JsonObject>());
+  bool full = full_requested;
+  if (!delta.filter(doc.as<JsonObject>(), full)) {
+    return;  // Nothing changed
+  }
+  full_requested = false;
+
+  std::string data;
+  serializeJson(doc, data);
+  event = "event: status\ndata: " + data + "\n\n";
+  event_full = full;
+  sequence++;
+  stats.events++;
+  if (full) {
+    stats.full_events++;
+  }
+}
+
+StatusEventsClient::StatusEventsClient(StatusEvents& events, uint32_t now_ms)
+    : events(events), sequence(events.sequence), sent_ms(now_ms) {
+  events.full_requested = true;
+  events.stats.clients++;
+}
+
+StatusEventsClient::~StatusEventsClient() {
+  events.stats.clients--;
+}
+
+size_t StatusEventsClient::fill(uint8_t* buffer, size_t max_len, uint32_t now_ms) {
+  if (max_len == 0) {
+    return STATUS_EVENTS_TRY_AGAIN;
+  }
+  if (offset == pending.size()) {
+    pending.clear();
+    offset = 0;
+
+    events.poll(now_ms);
+    if (events.sequence != sequence) {
+      bool missed = events.sequence != sequence + 1;
+      sequence = events.sequence;
+      if (events.event_full || (synced && !missed)) {
+        pending = events.event;
+        synced = true;
+      } else {
+        // Fell behind, or missed the event with all fields it waited for. The changes from here on would leave it with
+        // stale values, so it asks for all fields again.
+        synced = false;
+        events.full_requested = true;
+      }
+    }
+
+    if (pending.empty() && now_ms - sent_ms >= STATUS_EVENTS_KEEPALIVE_MS) {
+      pending = ":\n\n";
+    }
+    if (pending.empty()) {
+      return STATUS_EVENTS_TRY_AGAIN;
+    }
+    sent_ms = now_ms;
+    events.stats.bytes += pending.size();
+  }
+
+  size_t count = pending.size() - offset < max_len ? pending.size() - offset : max_len;
+  memcpy(buffer, pending.data() + offset, count);
+  offset += count;
+  return count;
+}
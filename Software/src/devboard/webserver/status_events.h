@@ -0,0 +1,84 @@
+#ifndef STATUS_EVENTS_H
+#define STATUS_EVENTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+#include "status_json.h"
+
+// Returned by StatusEventsClient::fill while there is nothing to send, same value as RESPONSE_TRY_AGAIN
+#define STATUS_EVENTS_TRY_AGAIN 0xFFFFFFFF
+
+// Comment line sent to idle clients, so connections that went away are noticed
+#define STATUS_EVENTS_KEEPALIVE_MS 15000
+
+typedef struct {
+  uint32_t events;
+  /** Events that carried every field, for a client that connected or fell behind */
+  uint32_t full_events;
+  uint32_t bytes;
+  /** Clients connected right now */
+  uint32_t clients;
+} Status_Events_Statistics;
+
+// Server-sent events with the fields of the status JSON that changed, for any amount of clients.
+//
+// At most once per interval the status document is built and filtered by a StatusDelta, and the result becomes the
+// latest event. Every client sends that same event, so more viewers do not mean more work. A client that connects
+// asks for the next event to carry every field, and skips the events before it. A client that missed an event, since
+// its connection was too slow, does the same.
+//
+// Everything runs from the response fillers, so only in the task that serves the web requests.
+class StatusEvents {
+ public:
+  typedef std::function<void(JsonObject root)> Builder;
+
+  explicit StatusEvents(Builder build) : build(build) {}
+
+  // Smallest time between two events
+  uint32_t interval_ms = 1000;
+
+  // Build the next event if the interval has passed
+  void poll(uint32_t now_ms);
+
+  const Status_Events_Statistics& statistics() const { return stats; }
+
+ private:
+  friend class StatusEventsClient;
+
+  Builder build;
+  StatusDelta delta;
+  bool full_requested = true;
+  bool started = false;
+  uint32_t published_ms = 0;
+  /** Number of the latest event, 0 before the first one */
+  uint32_t sequence = 0;
+  bool event_full = false;
+  std::string event;
+  Status_Events_Statistics stats = {};
+};
+
+// One connected client, kept by its response filler
+class StatusEventsClient {
+ public:
+  StatusEventsClient(StatusEvents& events, uint32_t now_ms);
+  ~StatusEventsClient();
+
+  // Fills the response buffer with up to max_len bytes of events. Returns STATUS_EVENTS_TRY_AGAIN if there is
+  // nothing to send yet, it never ends the response by returning 0.
+  size_t fill(uint8_t* buffer, size_t max_len, uint32_t now_ms);
+
+ private:
+  StatusEvents& events;
+  /** Latest event this client has seen, sent or skipped */
+  uint32_t sequence;
+  /** Has sent an event with every field, so the following changes make sense to it */
+  bool synced = false;
+  uint32_t sent_ms;
+  std::string pending;
+  size_t offset = 0;
+};
+
+#endif  // STATUS_EVENTS_H
@@ -0,0 +1,114 @@
+#include "status_json.h"
+#include "../../datalayer/datalayer.h"
+#include "../safety/safety.h"
+#include "../utils/events.h"
+
+static const char* battery_names[] = {"battery", "battery2", "battery3"};
+
+// How far a value has to move before the event stream sends it again
+static const Mqtt_Deadband status_deadbands[] = {{"uptime_s", 60.0f, 0.0f},
+                                                 {"cpu_temp", 1.0f, 0.0f},
+                                                 {"temperature_min", 0.5f, 0.0f},
+                                                 {"temperature_max", 0.5f, 0.0f},
+                                                 {"stat_batt_power", 20.0f, 0.01f},
+                                                 {"battery_current", 0.2f, 0.0f},
+                                                 {"battery_voltage", 0.5f, 0.0f},
+                                                 {"cell_max_voltage", 0.002f, 0.0f},
+                                                 {"cell_min_voltage", 0.002f, 0.0f},
+                                                 {"cell_voltage_delta", 0.002f, 0.0f},
+                                                 {"remaining_capacity_real", 10.0f, 0.0f},
+                                                 {"remaining_capacity", 10.0f, 0.0f}};
+
+void status_battery_to_json(const DATALAYER_BATTERY_TYPE& battery, JsonObject out) {
+  out["SOC"] = ((float)battery.status.reported_soc) / 100.0f;
+  out["SOC_real"] = ((float)battery.status.real_soc) / 100.0f;
+  out["state_of_health"] = ((float)battery.status.soh_pptt) / 100.0f;
+  out["temperature_min"] = ((float)battery.status.temperature_min_dC) / 10.0f;
+  out["temperature_max"] = ((float)battery.status.temperature_max_dC) / 10.0f;
+  out["stat_batt_power"] = battery.status.active_power_W;
+  out["battery_current"] = ((float)battery.status.current_dA) / 10.0f;
+  out["battery_voltage"] = ((float)battery.status.voltage_dV) / 10.0f;
+  out["cell_max_voltage"] = ((float)battery.status.cell_max_voltage_mV) / 1000.0f;
+  out["cell_min_voltage"] = ((float)battery.status.cell_min_voltage_mV) / 1000.0f;
+  out["cell_voltage_delta"] =
+      ((float)battery.status.cell_max_voltage_mV - (float)battery.status.cell_min_voltage_mV) / 1000.0f;
+  out["total_capacity"] = battery.info.total_capacity_Wh;
+  out["remaining_capacity_real"] = battery.status.remaining_capacity_Wh;
+  out["remaining_capacity"] = battery.status.reported_remaining_capacity_Wh;
+  out["max_discharge_power"] = battery.status.max_discharge_power_W;
+  out["max_charge_power"] = battery.status.max_charge_power_W;
+  out["bms_status"] = (int)battery.status.real_bms_status;
+  out["balancing_status"] = (int)battery.status.balancing_status;
+  out["number_of_cells"] = battery.info.number_of_cells;
+}
+
+void status_battery_details_to_json(const DATALAYER_BATTERY_TYPE& battery, JsonObject out) {
+  JsonObject info = out["info"].to<JsonObject>();
+  info["max_design_voltage"] = ((float)battery.info.max_design_voltage_dV) / 10.0f;
+  info["min_design_voltage"] = ((float)battery.info.min_design_voltage_dV) / 10.0f;
+  info["max_cell_voltage"] = ((float)battery.info.max_cell_voltage_mV) / 1000.0f;
+  info["min_cell_voltage"] = ((float)battery.info.min_cell_voltage_mV) / 1000.0f;
+  info["max_cell_voltage_deviation"] = ((float)battery.info.max_cell_voltage_deviation_mV) / 1000.0f;
+  info["chemistry"] = (int)battery.info.chemistry;
+
+  status_battery_to_json(battery, out["status"].to<JsonObject>());
+
+  const Cell_Statistics& cell_stats = battery.status.cell_statistics;
+  JsonObject statistics = out["cell_statistics"].to<JsonObject>();
+  statistics["valid_cells"] = cell_stats.valid_cells;
+  statistics["min_mV"] = cell_stats.min_mV;
+  statistics["max_mV"] = cell_stats.max_mV;
+  statistics["min_index"] = cell_stats.min_index;
+  statistics["max_index"] = cell_stats.max_index;
+  statistics["average_mV"] = cell_stats.average_mV;
+  statistics["deviation_mV"] = cell_stats.deviation_mV;
+  statistics["balancing_cells"] = cell_stats.balancing_cells;
+
+  uint8_t cells = battery.info.number_of_cells;
+  if (cells > MAX_AMOUNT_CELLS) {
+    cells = MAX_AMOUNT_CELLS;
+  }
+  JsonArray voltages = out["cell_voltages_mV"].to<JsonArray>();
+  JsonArray balancing = out["cell_balancing"].to<JsonArray>();
+  for (uint8_t i = 0; i < cells; i++) {
+    voltages.add(battery.status.cell_voltages_mV[i]);
+    balancing.add(battery.status.cell_balancing_status[i] ? 1 : 0);
+  }
+}
+
+void status_to_json(const DataLayerSnapshot& snapshot, uint8_t batteries, JsonObject root) {
+  JsonObject system = root["system"].to<JsonObject>();
+  system["bms_status"] = getBMSStatus(datalayer.system.status.system_status);
+  system["pause_status"] = get_emulator_pause_status();
+  system["emulator_status"] = get_emulator_status_string(get_emulator_status());
+  system["event_level"] = get_event_level_string(get_event_level());
+  system["cpu_temp"] = (int)(datalayer.system.info.CPU_temperature + 0.5);
+  system["uptime_s"] = millis64() / 1000;
+
+  const DATALAYER_BATTERY_TYPE* packs[] = {&snapshot.battery, &snapshot.battery2, &snapshot.battery3};
+  for (uint8_t i = 0; i < batteries && i < 3; i++) {
+    status_battery_to_json(*packs[i], root[battery_names[i]].to<JsonObject>());
+  }
+}
+
+bool StatusDelta::filter(JsonObject doc, bool full) {
+  std::vector<std::string> unchanged;
+  for (JsonPair object : doc) {
+    JsonObject fields = object.value().as<JsonObject>();
+    if (fields.isNull()) {
+      continue;
+    }
+    auto it = objects.find(object.key().c_str());
+    if (it == objects.end()) {
+      MqttFieldDelta delta(status_deadbands, sizeof(status_deadbands) / sizeof(status_deadbands[0]));
+      it = objects.emplace(object.key().c_str(), delta).first;
+    }
+    if (!it->second.filter(fields, full)) {
+      unchanged.push_back(object.key().c_str());
+    }
+  }
+  for (const auto& key : unchanged) {
+    doc.remove(key);
+  }
+  return doc.size() > 0;
+}
@@ -0,0 +1,35 @@
+#ifndef STATUS_JSON_H
+#define STATUS_JSON_H
+
+#include <map>
+#include <string>
+#include "../../datalayer/datalayer_snapshot.h"
+#include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+#include "../mqtt/mqtt_delta.h"
+
+// Live values for /api/v1/status and the /api/v1/events stream. Battery fields use the same names and units as
+// the MQTT info topic, so dashboards can be moved between the two.
+//
+// {"system":{...},"battery":{...},"battery2":{...},"battery3":{...}}, with an object for each battery in use.
+void status_to_json(const DataLayerSnapshot& snapshot, uint8_t batteries, JsonObject root);
+
+// Values of one battery, as in the battery objects of status_to_json
+void status_battery_to_json(const DATALAYER_BATTERY_TYPE& battery, JsonObject out);
+
+// Design limits, cell statistics, cell voltages and balancing of one battery for /api/v1/battery
+void status_battery_details_to_json(const DATALAYER_BATTERY_TYPE& battery, JsonObject out);
+
+// Keeps the fields of a status document that changed since the last one that was sent, per object
+class StatusDelta {
+ public:
+  // Remove the unchanged fields, and objects left empty, from doc. Keeps everything if full is true.
+  // Returns false if nothing changed.
+  bool filter(JsonObject doc, bool full);
+
+  void reset() { objects.clear(); }
+
+ private:
+  std::map<std::string, MqttFieldDelta> objects;
+};
+
+#endif  // STATUS_JSON_H
@@ -6,21 +6,33 @@
 #include "../../battery/Battery.h"
 #include "../../battery/Shunt.h"
 #include "../../charger/CHARGERS.h"
+#include "../../communication/can/can_dispatch.h"
+#include "../../communication/can/can_replay.h"
 #include "../../communication/can/comm_can.h"
 #include "../../communication/contactorcontrol/comm_contactorcontrol.h"
 #include "../../communication/equipmentstopbutton/comm_equipmentstopbutton.h"
 #include "../../communication/nvm/comm_nvm.h"
 #include "../../datalayer/datalayer.h"
 #include "../../datalayer/datalayer_extended.h"
+#include "../../datalayer/telemetry_history.h"
 #include "../../devboard/safety/safety.h"
 #include "../../inverter/INVERTERS.h"
 #include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+#include "../mqtt/mqtt.h"
+#include "../mqtt/mqtt_delta.h"
 #include "../sdcard/sdcard.h"
+#include "../utils/event_journal.h"
 #include "../utils/events.h"
+#include "../utils/latency_histogram.h"
 #include "../utils/led_handler.h"
+#include "../utils/log_ring.h"
 #include "../utils/timer.h"
 #include "esp_task_wdt.h"
+#include "esp_timer.h"
+#include "history_response.h"
 #include "html_escape.h"
+#include "status_events.h"
+#include "status_json.h"
 
 #include <string>
 
@@ -28,6 +40,7 @@ std::string http_username;
 std::string http_password;
 
 bool webserver_auth = false;
+uint16_t web_push_interval_ms = 1000;
 static constexpr const char* WEB_AUTH_REALM = "Battery Emulator";
 
 // Create AsyncWebServer object on port 80
@@ -51,8 +64,14 @@ bool ota_active = false;
 
 const char get_firmware_info_html[] = R"rawliteral(%X%)rawliteral";
 
-String importedLogs = "";      // Store the uploaded logfile contents in RAM
-bool isReplayRunning = false;  // Global flag to track replay state
+bool isReplayRunning = false;              // Global flag to track replay state
+volatile bool replayStopRequested = false;  // Abort the running replay, also within a pass
+static bool replay_upload_too_large = false;
+
+// Heap left to the rest of the firmware when an uploaded log is decoded for replay
+#define CAN_REPLAY_HEAP_MARGIN (32 * 1024)
+// Longest a replay waiting for a distant frame takes to notice /stopReplay
+#define CAN_REPLAY_STOP_POLL_MS 100
 
 // True when user has updated settings that need a reboot to be effective.
 bool settingsUpdated = false;
@@ -65,117 +84,151 @@ bool webserver_auth_is_ready() {
 
 void handleFileUpload(AsyncWebServerRequest* request, String filename, size_t index, uint8_t* data, size_t len,
                       bool final) {
+  if (isReplayRunning) {
+    // The replay task reads the decoded log, it cannot change underneath it
+    if (final) {
+      request->send(409, "text/plain", "Stop the replay before uploading a new log");
+    }
+    return;
+  }
+
   if (!index) {
-    importedLogs = "";  // Clear previous logs
-    logging.printf("Receiving file: %s\n", filename.c_str());
+    can_replay_log.clear();  // Clear previous logs
+    // The frames are reserved for the whole upload at once. finish() moves them into buffers of their final size,
+    // so for a moment both are held.
+    const size_t needed = CanReplayLog::bytes_for_upload(request->contentLength());
+    replay_upload_too_large =
+        needed > ESP.getMaxAllocHeap() || 2 * needed + CAN_REPLAY_HEAP_MARGIN > ESP.getFreeHeap();
+    if (replay_upload_too_large) {
+      logging.printf("Rejecting file: %s, %u bytes would need %u bytes of RAM\n", filename.c_str(),
+                     request->contentLength(), needed);
+    } else {
+      can_replay_log.reserve_for_upload(request->contentLength());
+      logging.printf("Receiving file: %s\n", filename.c_str());
+    }
   }
 
-  // Append received data to the string (RAM storage)
-  importedLogs += String((char*)data).substring(0, len);
+  if (replay_upload_too_large) {
+    if (final) {
+      request->send(413, "text/plain", "Log file too large for the free memory");
+    }
+    return;
+  }
+
+  // Decode the chunk right away, only the compact frames are kept in RAM
+  can_replay_log.feed(data, len);
 
   if (final) {
-    logging.println("Upload Complete!");
+    can_replay_log.finish();
+    logging.printf("Upload Complete! %u frames, %u lines skipped, %u frames dropped, %u bytes\n",
+                   can_replay_log.size(), can_replay_log.skipped_lines(), can_replay_log.dropped_frames(),
+                   can_replay_log.memory_used());
     request->send(200, "text/plain", "File uploaded successfully");
   }
 }
 
-void canReplayTask(void* param) {
-  std::vector<String> messages;
-  messages.reserve(1000);  // Pre-allocate memory to reduce fragmentation
-
-  if (!importedLogs.isEmpty()) {
-    int lastIndex = 0;
+static void replay_timer_callback(void* arg) {
+  xTaskNotifyGive((TaskHandle_t)arg);
+}
 
-    while (true) {
-      int nextIndex = importedLogs.indexOf("\n", lastIndex);
-      if (nextIndex == -1) {
-        messages.push_back(importedLogs.substring(lastIndex));
-        break;
-      }
-      messages.push_back(importedLogs.substring(lastIndex, nextIndex));
-      lastIndex = nextIndex + 1;
+// Sleep until the esp_timer clock reaches deadline_us. Longer waits block on a one-shot timer,
+// so the task does not depend on the FreeRTOS tick and other tasks keep running. The wait is cut
+// into slices, so a stop request is seen during long gaps in the log.
+static void replay_wait_until(esp_timer_handle_t timer, int64_t deadline_us) {
+  int64_t remaining = deadline_us - esp_timer_get_time();
+  if (remaining < CAN_REPLAY_MIN_TIMER_US) {
+    return;
+  }
+  esp_timer_start_once(timer, remaining);
+  while (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CAN_REPLAY_STOP_POLL_MS)) == 0) {
+    if (replayStopRequested) {
+      esp_timer_stop(timer);
+      return;
     }
+  }
+}
 
+void canReplayTask(void* param) {
+  esp_timer_handle_t timer = nullptr;
+  const esp_timer_create_args_t timer_args = {.callback = &replay_timer_callback,
+                                              .arg = xTaskGetCurrentTaskHandle(),
+                                              .dispatch_method = ESP_TIMER_TASK,
+                                              .name = "can_replay"};
+  const CAN_Interface interface = (CAN_Interface)datalayer.system.info.can_replay_interface;
+  const bool fd_interface = interface == CANFD_NATIVE || interface == CANFD_ADDON_MCP2518;
+  const uint16_t speed_percent = datalayer.system.info.can_replay_speed_percent;
+
+  can_replay_statistics = CAN_Replay_Statistics();
+
+  if (!can_replay_log.empty() && esp_timer_create(&timer_args, &timer) == ESP_OK) {
     do {
-      float firstTimestamp = -1.0f;
-      float lastTimestamp = 0.0f;
-      bool firstMessageSent = false;  // Track first message
-
-      for (size_t i = 0; i < messages.size(); i++) {
-        String line = messages[i];
-        line.trim();
-        if (line.length() == 0)
-          continue;
-
-        int timeStart = line.indexOf("(") + 1;
-        int timeEnd = line.indexOf(")");
-        if (timeStart == 0 || timeEnd == -1)
-          continue;
-
-        float currentTimestamp = line.substring(timeStart, timeEnd).toFloat();
-
-        if (firstTimestamp < 0) {
-          firstTimestamp = currentTimestamp;
+      const int64_t start_us = esp_timer_get_time();
+      uint64_t elapsed_us = 0;  // Log time since the first frame of this pass
+      int64_t previous_sent_us = 0;
+      int64_t previous_deadline_us = 0;
+      uint32_t sent_without_waiting = 0;
+
+      for (size_t i = 0; i < can_replay_log.size() && !replayStopRequested; i++) {
+        CAN_frame frame;
+        uint32_t delta_us = can_replay_log.frame(i, frame);
+        frame.FD |= fd_interface;
+        if (i > 0) {
+          elapsed_us += delta_us;
         }
 
-        // Send first message immediately
-        if (!firstMessageSent) {
-          firstMessageSent = true;
-          firstTimestamp = currentTimestamp;  // Adjust reference time
-        } else {
-          // Delay only if this isn't the first message
-          float deltaT = (currentTimestamp - lastTimestamp) * 1000;
-          vTaskDelay((int)deltaT / portTICK_PERIOD_MS);
+        const int64_t deadline_us = start_us + can_replay_scaled_us(elapsed_us, speed_percent);
+        if (deadline_us - esp_timer_get_time() >= CAN_REPLAY_MIN_TIMER_US) {
+          replay_wait_until(timer, deadline_us);
+          sent_without_waiting = 0;
+          if (replayStopRequested) {
+            break;
+          }
+        } else if (++sent_without_waiting >= 100) {
+          // Frames with (nearly) equal timestamps, give the idle task a chance now and then
+          vTaskDelay(1);
+          sent_without_waiting = 0;
         }
 
-        lastTimestamp = currentTimestamp;
-
-        int interfaceStart = timeEnd + 2;
-        int interfaceEnd = line.indexOf(" ", interfaceStart);
-        if (interfaceEnd == -1)
-          continue;
-
-        int idStart = interfaceEnd + 1;
-        int idEnd = line.indexOf(" [", idStart);
-        if (idStart == -1 || idEnd == -1)
-          continue;
+        const int64_t sent_us = esp_timer_get_time();
+        transmit_can_frame_to_interface(&frame, interface);
 
-        String messageID = line.substring(idStart, idEnd);
-        int dlcStart = idEnd + 2;
-        int dlcEnd = line.indexOf("]", dlcStart);
-        if (dlcEnd == -1)
-          continue;
-
-        String dlc = line.substring(dlcStart, dlcEnd);
-        int dataStart = dlcEnd + 2;
-        String dataBytes = line.substring(dataStart);
-
-        currentFrame.ID = strtol(messageID.c_str(), NULL, 16);
-        currentFrame.DLC = dlc.toInt();
-
-        int byteIndex = 0;
-        char* token = strtok((char*)dataBytes.c_str(), " ");
-        while (token != NULL && byteIndex < currentFrame.DLC) {
-          currentFrame.data.u8[byteIndex++] = strtol(token, NULL, 16);
-          token = strtok(NULL, " ");
+        if (sent_us > deadline_us && (uint64_t)(sent_us - deadline_us) > can_replay_statistics.max_lateness_us) {
+          can_replay_statistics.max_lateness_us = sent_us - deadline_us;
         }
-
-        currentFrame.FD = (datalayer.system.info.can_replay_interface == CANFD_NATIVE) ||
-                          (datalayer.system.info.can_replay_interface == CANFD_ADDON_MCP2518);
-        currentFrame.ext_ID = (currentFrame.ID > 0x7F0);
-
-        transmit_can_frame_to_interface(&currentFrame, (CAN_Interface)datalayer.system.info.can_replay_interface);
+        if (i > 0) {
+          can_replay_record_interval(can_replay_statistics, deadline_us - previous_deadline_us,
+                                     sent_us - previous_sent_us);
+        }
+        previous_sent_us = sent_us;
+        previous_deadline_us = deadline_us;
+        can_replay_statistics.frames_sent++;
       }
-    } while (datalayer.system.info.loop_playback);
+      can_replay_statistics.loops++;
+    } while (datalayer.system.info.loop_playback && !replayStopRequested);
 
-    messages.clear();          // Free vector memory
-    messages.shrink_to_fit();  // Release excess memory
+    esp_timer_stop(timer);
+    esp_timer_delete(timer);
   }
 
+  logging.printf("CAN replay done: %u frames, jitter mean %u us max %u us, max lateness %u us\n",
+                 can_replay_statistics.frames_sent, can_replay_mean_jitter_us(can_replay_statistics),
+                 can_replay_statistics.max_jitter_us, can_replay_statistics.max_lateness_us);
+
   isReplayRunning = false;  // Mark replay as stopped
   vTaskDelete(NULL);
 }
 
+// Copy of the lines currently in the web log ring, for exporting
+static String web_log_text() {
+  String logs;
+  logs.reserve(web_log_ring.capacity());
+  web_log_ring.visit([&logs](const char* line, size_t length) {
+    logs.concat(line, length);
+    logs += '\n';
+  });
+  return logs;
+}
+
 void def_route_with_auth(const char* uri, AsyncWebServer& serv, WebRequestMethodComposite method,
                          std::function<void(AsyncWebServerRequest*)> handler) {
   serv.on(uri, method, [handler](AsyncWebServerRequest* request) {
@@ -186,6 +239,110 @@ void def_route_with_auth(const char* uri, AsyncWebServer& serv, WebRequestMethod
   });
 }
 
+// Amount of batteries in use, for the status JSON
+static uint8_t batteries_in_use() {
+  return battery3 ? 3 : battery2 ? 2 : battery ? 1 : 0;
+}
+
+// Snapshot of the task that serves the web requests, shared by the event stream and the JSON APIs below. Each of
+// them reads it again and is done with it before returning, so they never see each other's copy.
+static DataLayerSnapshot web_snapshot;
+
+// Live values for /api/v1/events
+static StatusEvents status_events([](JsonObject root) {
+  read_datalayer_snapshot(web_snapshot);
+  status_to_json(web_snapshot, batteries_in_use(), root);
+});
+
+static_assert(STATUS_EVENTS_TRY_AGAIN == RESPONSE_TRY_AGAIN, "Status events have to wait like other responses");
+
+// Longest time a delete request waits for the logging task
+#define LOG_DELETE_TIMEOUT_MS 5000
+
+// Answers a delete request once the logging task has deleted the file. The filler waits with RESPONSE_TRY_AGAIN, so
+// the web server task is not blocked meanwhile.
+static void send_log_delete_result(AsyncWebServerRequest* request, SD_Log_Delete_State (*get_state)()) {
+  const unsigned long requested = millis();
+  request->sendChunked("text/plain", [get_state, requested](uint8_t* buffer, size_t max_len, size_t index) -> size_t {
+    if (index > 0) {
+      return 0;
+    }
+    const char* text;
+    switch (get_state()) {
+      case SD_LOG_DELETE_DONE:
+        text = "Log file deleted";
+        break;
+      case SD_LOG_DELETE_FAILED:
+        text = "Failed to delete log file";
+        break;
+      default:
+        if (millis() - requested < LOG_DELETE_TIMEOUT_MS) {
+          return RESPONSE_TRY_AGAIN;
+        }
+        text = "Log file not deleted yet, the logging task did not respond";
+        break;
+    }
+    const size_t length = std::min(strlen(text), max_len);
+    memcpy(buffer, text, length);
+    return length;
+  });
+}
+
+// Longest time an export waits for the logging task to write out and close the file
+#define LOG_EXPORT_TIMEOUT_MS 5000
+
+// Sends a log file from the SD card as a download. Writing is paused until the request ends, and the file is only
+// opened once the logging task has written out what it collected and closed it, so the export ends with the newest
+// frames or lines. The filler waits with RESPONSE_TRY_AGAIN, so the web server task is not blocked meanwhile.
+static void send_sd_log_file(AsyncWebServerRequest* request, const char* path, void (*pause)(), void (*resume)(),
+                             bool (*is_closed)()) {
+  pause();
+  // Called once when the request ends, whether the download completed or the client went away
+  request->onDisconnect(resume);
+  const unsigned long requested = millis();
+  auto file = std::make_shared<File>();
+  AsyncWebServerResponse* response = request->beginChunkedResponse(
+      "text/plain", [path, is_closed, requested, file](uint8_t* buffer, size_t max_len, size_t index) -> size_t {
+        if (!*file) {
+          if (index > 0) {
+            return 0;
+          }
+          if (!is_closed()) {
+            if (millis() - requested < LOG_EXPORT_TIMEOUT_MS) {
+              return RESPONSE_TRY_AGAIN;
+            }
+            const char* text = "Log file not exported, the logging task did not respond";
+            const size_t length = std::min(strlen(text), max_len);
+            memcpy(buffer, text, length);
+            return length;
+          }
+          *file = SD_MMC.open(path, FILE_READ);
+          if (!*file) {
+            return 0;
+          }
+        }
+        return file->read(buffer, max_len);
+      });
+  response->addHeader("Content-Disposition",
+                      String("attachment; filename=\"") + (path[0] == '/' ? path + 1 : path) + "\"");
+  request->send(response);
+}
+
+// Sends the page as a chunked response. The page is kept alive by the filler until the response is complete.
+static void send_chunked_page(AsyncWebServerRequest* request, std::shared_ptr<HtmlChunkedPage> page) {
+  request->sendChunked("text/html",
+                       [page](uint8_t* buffer, size_t max_len, size_t index) { return page->fill(buffer, max_len); });
+}
+
+// Sends a page with the layout of index_html, with the sections added by add_sections in place of %X%
+static void send_index_page(AsyncWebServerRequest* request, void (*add_sections)(HtmlChunkedPage& page)) {
+  auto page = std::make_shared<HtmlChunkedPage>();
+  page->text(index_html_header).text(common_javascript);
+  add_sections(*page);
+  page->text(index_html_footer);
+  send_chunked_page(request, page);
+}
+
 void init_webserver() {
   if (webserver_auth_is_ready()) {
     web_auth_middleware.setUsername(http_username.c_str());
@@ -216,7 +373,7 @@ void init_webserver() {
   def_route_with_auth("/", server, HTTP_GET, [](AsyncWebServerRequest* request) {
     // Clear OTA active flag as a safeguard in case onOTAEnd() wasn't called
     ota_active = false;
-    request->send(200, "text/html", index_html, processor);
+    send_index_page(request, status_page_sections);
   });
 
   // Route for going to settings web page
@@ -230,7 +387,7 @@ void init_webserver() {
 
   // Route for going to advanced battery info web page
   def_route_with_auth("/advanced", server, HTTP_GET, [](AsyncWebServerRequest* request) {
-    request->send(200, "text/html", index_html, advanced_battery_processor);
+    send_index_page(request, advanced_battery_sections);
   });
 
   // Route for going to CAN logging web page
@@ -240,7 +397,9 @@ void init_webserver() {
 
   // Route for going to CAN replay web page
   def_route_with_auth("/canreplay", server, HTTP_GET, [](AsyncWebServerRequest* request) {
-    request->send(request->beginResponse(200, "text/html", can_replay_processor()));
+    auto page = std::make_shared<HtmlChunkedPage>();
+    can_replay_page(*page);
+    send_chunked_page(request, page);
   });
 
   def_route_with_auth("/startReplay", server, HTTP_GET, [](AsyncWebServerRequest* request) {
@@ -251,6 +410,14 @@ void init_webserver() {
     }
 
     datalayer.system.info.loop_playback = request->hasParam("loop") && request->getParam("loop")->value().toInt() == 1;
+    if (request->hasParam("speed")) {
+      // Speed multiplier, 0.01x to 100x
+      float speed = request->getParam("speed")->value().toFloat();
+      datalayer.system.info.can_replay_speed_percent = constrain((int)(speed * 100 + 0.5f), 1, 10000);
+    } else {
+      datalayer.system.info.can_replay_speed_percent = 100;
+    }
+    replayStopRequested = false;
     isReplayRunning = true;  // Set flag before starting task
 
     xTaskCreatePinnedToCore(canReplayTask, "CAN_Replay", 8192, NULL, 1, NULL, 1);
@@ -261,6 +428,7 @@ void init_webserver() {
   // Route for stopping the CAN replay
   def_route_with_auth("/stopReplay", server, HTTP_GET, [](AsyncWebServerRequest* request) {
     datalayer.system.info.loop_playback = false;
+    replayStopRequested = true;
 
     request->send(200, "text/plain", "CAN replay stopped!");
   });
@@ -308,20 +476,18 @@ void init_webserver() {
   if (datalayer.system.info.CAN_SD_logging_active) {
     // Define the handler to export can log
     server.on("/export_can_log", HTTP_GET, [](AsyncWebServerRequest* request) {
-      pause_can_writing();
-      request->send(SD_MMC, CAN_LOG_FILE, String(), true);
-      resume_can_writing();
+      send_sd_log_file(request, CAN_LOG_FILE, pause_can_writing, resume_can_writing, is_can_log_closed);
     });
 
     // Define the handler to delete can log
     server.on("/delete_can_log", HTTP_GET, [](AsyncWebServerRequest* request) {
       delete_can_log();
-      request->send(200, "text/plain", "Log file deleted");
+      send_log_delete_result(request, get_can_log_delete_state);
     });
   } else {
     // Define the handler to export can log
     server.on("/export_can_log", HTTP_GET, [](AsyncWebServerRequest* request) {
-      String logs = String(datalayer.system.info.logged_can_messages);
+      String logs = web_log_text();
       if (logs.length() == 0) {
         logs = "No logs available.";
       }
@@ -351,19 +517,17 @@ void init_webserver() {
     // Define the handler to delete log file
     server.on("/delete_log", HTTP_GET, [](AsyncWebServerRequest* request) {
       delete_log();
-      request->send(200, "text/plain", "Log file deleted");
+      send_log_delete_result(request, get_log_delete_state);
     });
 
     // Define the handler to export debug log
     server.on("/export_log", HTTP_GET, [](AsyncWebServerRequest* request) {
-      pause_log_writing();
-      request->send(SD_MMC, LOG_FILE, String(), true);
-      resume_log_writing();
+      send_sd_log_file(request, LOG_FILE, pause_log_writing, resume_log_writing, is_log_closed);
     });
   } else {
     // Define the handler to export debug log
     server.on("/export_log", HTTP_GET, [](AsyncWebServerRequest* request) {
-      String logs = String(datalayer.system.info.logged_can_messages);
+      String logs = web_log_text();
       if (logs.length() == 0) {
         logs = "No logs available.";
       }
@@ -389,9 +553,111 @@ void init_webserver() {
     });
   }
 
+  // Latency histograms of the core, MQTT and connectivity loops as JSON. Add ?reset=1 to start over afterwards.
+  def_route_with_auth("/api/v1/latency", server, HTTP_GET, [](AsyncWebServerRequest* request) {
+    JsonDocument doc;
+    latency_histograms_to_json(doc.to<JsonObject>());
+    String content;
+    serializeJson(doc, content);
+    if (request->hasParam("reset") && request->getParam("reset")->value().toInt() == 1) {
+      latency_histograms_reset();
+    }
+    request->send(200, "application/json", content);
+  });
+
+  // Event changes kept in flash over reboots, oldest first. ?since= a sequence number, by default the latest
+  // EVENT_JOURNAL_RESPONSE_RECORDS records. Continue from the last sequence number of a response plus one.
+  def_route_with_auth("/api/v1/journal", server, HTTP_GET, [](AsyncWebServerRequest* request) {
+    uint32_t next = event_journal.next_sequence();
+    uint32_t since = next > EVENT_JOURNAL_RESPONSE_RECORDS ? next - EVENT_JOURNAL_RESPONSE_RECORDS : 0;
+    if (request->hasParam("since")) {
+      since = request->getParam("since")->value().toInt();
+    }
+    JsonDocument doc;
+    event_journal_to_json(since, EVENT_JOURNAL_RESPONSE_RECORDS, doc.to<JsonObject>());
+    String content;
+    serializeJson(doc, content);
+    request->send(200, "application/json", content);
+  });
+
+  // Live values as JSON, with the same fields as the event stream below
+  def_route_with_auth("/api/v1/status", server, HTTP_GET, [](AsyncWebServerRequest* request) {
+    read_datalayer_snapshot(web_snapshot);
+    JsonDocument doc;
+    status_to_json(web_snapshot, batteries_in_use(), doc.to<JsonObject>());
+    String content;
+    serializeJson(doc, content);
+    request->send(200, "application/json", content);
+  });
+
+  // Design limits, cell voltages and balancing of one battery as JSON. Add ?index=2 or 3 for the other batteries.
+  def_route_with_auth("/api/v1/battery", server, HTTP_GET, [](AsyncWebServerRequest* request) {
+    int index = request->hasParam("index") ? request->getParam("index")->value().toInt() : 1;
+    if (index < 1 || index > batteries_in_use()) {
+      request->send(404, "text/plain", "No such battery");
+      return;
+    }
+    read_datalayer_snapshot_battery(index - 1, web_snapshot.battery);
+    JsonDocument doc;
+    status_battery_details_to_json(web_snapshot.battery, doc.to<JsonObject>());
+    String content;
+    serializeJson(doc, content);
+    request->send(200, "application/json", content);
+  });
+
+  // Pack values and cell voltages of the first battery over time, see history_response.h for the format.
+  // ?interval=1, 60 (default) or 900 seconds, ?from= and ?to= in seconds of uptime, ?cells=1-16, all or none
+  // (default), ?format=bin for the compact binary format.
+  def_route_with_auth("/api/v1/history", server, HTTP_GET, [](AsyncWebServerRequest* request) {
+    if (!telemetry_history.enabled()) {
+      request->send(404, "text/plain", "Telemetry history is not available");
+      return;
+    }
+    History_Query query = {};
+    query.to_s = UINT32_MAX;
+    uint32_t interval_s = request->hasParam("interval") ? request->getParam("interval")->value().toInt() : 60;
+    bool valid = history_resolution_for_interval(interval_s, query.resolution);
+    if (request->hasParam("from")) {
+      query.from_s = request->getParam("from")->value().toInt();
+    }
+    if (request->hasParam("to")) {
+      query.to_s = request->getParam("to")->value().toInt();
+    }
+    if (request->hasParam("cells")) {
+      valid = valid && parse_history_cells(request->getParam("cells")->value().c_str(), telemetry_history.cells(),
+                                           query.first_cell, query.cells);
+    }
+    query.binary = request->hasParam("format") && request->getParam("format")->value() == "bin";
+    if (!valid) {
+      request->send(400, "text/plain", "Invalid interval or cells");
+      return;
+    }
+    auto response = std::make_shared<HistoryResponse>(telemetry_history, query, millis64() / 1000);
+    request->sendChunked(query.binary ? "application/octet-stream" : "application/json",
+                         [response](uint8_t* buffer, size_t max_len, size_t index) {
+                           return response->fill(buffer, max_len);
+                         });
+  });
+
+  // Server-sent events with the changed fields of /api/v1/status, at most once per web_push_interval_ms. The
+  // response stays open and its filler waits with RESPONSE_TRY_AGAIN until there is a new event.
+  status_events.interval_ms = web_push_interval_ms;
+  def_route_with_auth("/api/v1/events", server, HTTP_GET, [](AsyncWebServerRequest* request) {
+    if (web_push_interval_ms == 0) {
+      request->send(404, "text/plain", "Live value push is disabled in settings");
+      return;
+    }
+    auto client = std::make_shared<StatusEventsClient>(status_events, millis());
+    AsyncWebServerResponse* response = request->beginChunkedResponse(
+        "text/event-stream",
+        [client](uint8_t* buffer, size_t max_len, size_t index) { return client->fill(buffer, max_len, millis()); });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+  });
+
   // Route for going to cellmonitor web page
   def_route_with_auth("/cellmonitor", server, HTTP_GET, [](AsyncWebServerRequest* request) {
-    request->send(200, "text/html", index_html, cellmonitor_processor);
+    send_index_page(request, cellmonitor_sections);
   });
 
   // Route for going to event log web page
@@ -424,6 +690,7 @@ void init_webserver() {
       "MQTTTOPICS",   "MQTTCELLV",     "GTWRHD",        "DIGITALHVIL", "PERFPROFILE",   "INTERLOCKREQ",
       "SOCESTIMATED", "PYLONOFFSET",   "PYLONORDER",    "DEYEBYD",     "NCCONTACTOR",   "TRIBTR",
       "CNTCTRLTRI",   "ESPNOWENABLED", "PRIMOGEN24",    "CTINVERT",    "LOWPASSFILTER", "WEBAUTH",
+      "CANHWFILTER",  "MQTTDELTA",
   };
 
   const char* uintSettingNames[] = {
@@ -434,7 +701,8 @@ void init_webserver() {
       "PWMFREQ",    "PWMHOLD",     "GTWCOUNTRY", "GTWMAPREG",   "GTWCHASSIS",  "GTWPACK",   "LEDMODE",     "GPIOOPT1",
       "GPIOOPT2",   "GPIOOPT3",    "INVSUNTYPE", "GPIOOPT4",    "CTVNOM",      "CTANOM",    "CTATTEN",     "PYLONBAUD",
       "PYLONBRAND", "DALYPWRPCT",  "DALYPWRDV",  "DALYDVSTART", "DALYPWRDEG",  "DALYPWR0C", "RAMPDOWNSOC", "GPIOOPT5",
-      "GPIOOPT6",   "INVICNT",
+      "GPIOOPT6",   "INVICNT",     "CANRXBURST", "MQTTREFRESH", "MQTTDBCELL", "MQTTCELLFMT", "WEBPUSHMS",
+      "HISTDRAMKB",
   };
 
   const char* stringSettingNames[] = {"APNAME",         "APPASSWORD",   "HOSTNAME",  "MQTTSERVER",
@@ -549,7 +817,8 @@ void init_webserver() {
 
               for (auto& boolSetting : boolSettingNames) {
                 auto p = request->getParam(boolSetting, true);
-                const bool default_value = (std::string(boolSetting) == std::string("WIFIAPENABLED"));
+                const bool default_value = (std::string(boolSetting) == std::string("WIFIAPENABLED") ||
+                                            std::string(boolSetting) == std::string("CANHWFILTER"));
                 const bool value = p != nullptr && p->value() == "on";
                 if (settings.getBool(boolSetting, default_value) != value) {
                   settings.saveBool(boolSetting, value);
@@ -626,14 +895,14 @@ void init_webserver() {
 
   // Route for editing SOC Calibration BYD
   update_string_setting("/editCalTargetSOC", [](String value) {
-    datalayer_extended.bydAtto3.calibrationTargetSOC = static_cast<uint16_t>(value.toFloat());
+    datalayer_extended.bydAtto3->calibrationTargetSOC = static_cast<uint16_t>(value.toFloat());
   });
 
   // Save auto-calibrate enabled flag to RAM + NVM
   def_route_with_auth("/editBydAtto3AutoCalEnabled", server, HTTP_GET, [](AsyncWebServerRequest* request) {
     if (request->hasParam("value")) {
       bool enabled = request->getParam("value")->value().toInt() != 0;
-      datalayer_extended.bydAtto3.auto_calibrate_soc_enabled = enabled;
+      datalayer_extended.bydAtto3->auto_calibrate_soc_enabled = enabled;
       Preferences prefs;
       prefs.begin("batterySettings", false);
       prefs.putBool("BYDAUTOCALEN", enabled);
@@ -647,7 +916,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       int value = request->getParam("value")->value().toInt();
       if (value >= 1 && value <= 20) {
-        datalayer_extended.bydAtto3.auto_calibrate_soc_drift_percent = (uint8_t)value;
+        datalayer_extended.bydAtto3->auto_calibrate_soc_drift_percent = (uint8_t)value;
         Preferences prefs;
         prefs.begin("batterySettings", false);
         prefs.putUInt("BYDAUTOCALDRIFT", (uint8_t)value);
@@ -659,22 +928,22 @@ void init_webserver() {
 
   // Route for editing AH Calibration BYD
   update_string_setting("/editCalTargetAH", [](String value) {
-    datalayer_extended.bydAtto3.calibrationTargetAH = static_cast<uint16_t>(value.toFloat());
+    datalayer_extended.bydAtto3->calibrationTargetAH = static_cast<uint16_t>(value.toFloat());
   });
 
   // Battery 2 auto-calibration routes
   update_string_setting("/editCalTargetSOC2", [](String value) {
-    datalayer_extended.bydAtto3_2.calibrationTargetSOC = static_cast<uint16_t>(value.toFloat());
+    datalayer_extended.bydAtto3_2->calibrationTargetSOC = static_cast<uint16_t>(value.toFloat());
   });
 
   update_string_setting("/editCalTargetAH2", [](String value) {
-    datalayer_extended.bydAtto3_2.calibrationTargetAH = static_cast<uint16_t>(value.toFloat());
+    datalayer_extended.bydAtto3_2->calibrationTargetAH = static_cast<uint16_t>(value.toFloat());
   });
 
   def_route_with_auth("/editBydAtto3AutoCalEnabled2", server, HTTP_GET, [](AsyncWebServerRequest* request) {
     if (request->hasParam("value")) {
       bool enabled = request->getParam("value")->value().toInt() != 0;
-      datalayer_extended.bydAtto3_2.auto_calibrate_soc_enabled = enabled;
+      datalayer_extended.bydAtto3_2->auto_calibrate_soc_enabled = enabled;
       Preferences prefs;
       prefs.begin("batterySettings", false);
       prefs.putBool("BYDAUTOCALEN2", enabled);
@@ -687,7 +956,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       int value = request->getParam("value")->value().toInt();
       if (value >= 1 && value <= 20) {
-        datalayer_extended.bydAtto3_2.auto_calibrate_soc_drift_percent = (uint8_t)value;
+        datalayer_extended.bydAtto3_2->auto_calibrate_soc_drift_percent = (uint8_t)value;
         Preferences prefs;
         prefs.begin("batterySettings", false);
         prefs.putUInt("BYDAUTOCALDRFT2", (uint8_t)value);
@@ -921,201 +1190,446 @@ String get_uptime() {
          " minutes, " + (String)remaining_seconds + " seconds";
 }
 
-String processor(const String& var) {
-  if (var == "X") {
-    String content = "";
-    content += "<style>";
-    content += "body { background-color: black; color: white; }";
-    content +=
-        "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin-bottom: 20px; "
-        "cursor: pointer; border-radius: 10px; }";
-    content += "button:hover { background-color: #3A4A52; }";
-    content += "h2 { font-size: 1.2em; margin: 0.3em 0 0.5em 0; }";
-    content += "h4 { margin: 0.6em 0; line-height: 1.2; }";
-    //content += ".tooltip { position: relative; display: inline-block; }";
-    content += ".tooltip .tooltiptext {";
-    content += "  visibility: hidden;";
-    content += "  width: 200px;";
-    content += "  background-color: #3A4A52;";  // Matching your button hover color
-    content += "  color: white;";
-    content += "  text-align: center;";
-    content += "  border-radius: 6px;";
-    content += "  padding: 8px;";
-    content += "  position: absolute;";
-    content += "  z-index: 1;";
-    content += "  margin-left: -100px;";
-    content += "  opacity: 0;";
-    content += "  transition: opacity 0.3s;";
-    content += "  font-size: 0.9em;";
-    content += "  font-weight: normal;";
-    content += "  line-height: 1.4;";
-    content += "}";
-    content += ".tooltip:hover .tooltiptext { visibility: visible; opacity: 1; }";
-    content += ".tooltip-icon { color: #505E67; cursor: help; }";  // Matching your button color
-    content += "</style>";
-
-    // Compact header
-    content += "<h2>Battery Emulator</h2>";
-
-    // Start content block
-    content += "<div style='background-color: #303E47; padding: 10px; margin-bottom: 10px; border-radius: 50px'>";
-    content += "<div id='bxUpd' style='text-align:center'></div>";
-    content += "<h4>Software: " + String(version_number);
+// Style, system information and statistics
+static void status_page_system_info(String& content) {
+  content += "<style>";
+  content += "body { background-color: black; color: white; }";
+  content +=
+      "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin-bottom: 20px; "
+      "cursor: pointer; border-radius: 10px; }";
+  content += "button:hover { background-color: #3A4A52; }";
+  content += "h2 { font-size: 1.2em; margin: 0.3em 0 0.5em 0; }";
+  content += "h4 { margin: 0.6em 0; line-height: 1.2; }";
+  //content += ".tooltip { position: relative; display: inline-block; }";
+  content += ".tooltip .tooltiptext {";
+  content += "  visibility: hidden;";
+  content += "  width: 200px;";
+  content += "  background-color: #3A4A52;";  // Matching your button hover color
+  content += "  color: white;";
+  content += "  text-align: center;";
+  content += "  border-radius: 6px;";
+  content += "  padding: 8px;";
+  content += "  position: absolute;";
+  content += "  z-index: 1;";
+  content += "  margin-left: -100px;";
+  content += "  opacity: 0;";
+  content += "  transition: opacity 0.3s;";
+  content += "  font-size: 0.9em;";
+  content += "  font-weight: normal;";
+  content += "  line-height: 1.4;";
+  content += "}";
+  content += ".tooltip:hover .tooltiptext { visibility: visible; opacity: 1; }";
+  content += ".tooltip-icon { color: #505E67; cursor: help; }";  // Matching your button color
+  content += "</style>";
+
+  // Compact header
+  content += "<h2>Battery Emulator</h2>";
+
+  // Start content block
+  content += "<div style='background-color: #303E47; padding: 10px; margin-bottom: 10px; border-radius: 50px'>";
+  content += "<div id='bxUpd' style='text-align:center'></div>";
+  content += "<h4>Software: " + String(version_number);
 
 // Show hardware used:
 #ifdef HW_LILYGO
-    content += " Hardware: LilyGo T-CAN485";
+  content += " Hardware: LilyGo T-CAN485";
 #endif  // HW_LILYGO
 #ifdef HW_LILYGO2CAN
-    content += " Hardware: LilyGo T_2CAN";
+  content += " Hardware: LilyGo T_2CAN";
 #endif  // HW_LILYGO2CAN
 #ifdef HW_BECOM
-    content += " Hardware: BECom";
+  content += " Hardware: BECom";
 #endif  // HW_BECOM
 #ifdef HW_STARK
-    content += " Hardware: Stark CMR Module";
+  content += " Hardware: Stark CMR Module";
 #endif  // HW_STARK
 #ifdef HW_WAVESHARE
-    content += " Hardware: Waveshare ESP32-S3-RS485-CAN";
+  content += " Hardware: Waveshare ESP32-S3-RS485-CAN";
 #endif  // HW_WAVESHARE
-    content += " @ " + String(datalayer.system.info.CPU_temperature, 1) + " &deg;C</h4>";
-    content += "<h4>Uptime: " + get_uptime() + "</h4>";
-    if (datalayer.system.info.performance_measurement_active) {
-      content +=
-          "<h4>Free heap: " + String(ESP.getFreeHeap()) + ", max alloc: " + String(ESP.getMaxAllocHeap()) + "</h4>";
-      FlashMode_t mode = ESP.getFlashChipMode();
-      content += "<h4>Flash mode: " +
-                 String(mode == FM_QIO    ? "QIO"
-                        : mode == FM_QOUT ? "QOUT"
-                        : mode == FM_DIO  ? "DIO"
-                        : mode == FM_DOUT ? "DOUT"
-                                          : /*mode == FM_UNKNOWN*/ "Unknown") +
-                 ", size: " + String(ESP.getFlashChipSize() / (1024 * 1024)) + " MB</h4>";
-      // Load information
-      content += "<h4>Core task max load: " + String(datalayer.system.status.core_task_max_us) + " us</h4>";
-      content +=
-          "<h4>Core task max load last 10 s: " + String(datalayer.system.status.core_task_10s_max_us) + " us</h4>";
-      content +=
-          "<h4>MQTT function (MQTT task) max load last 10 s: " + String(datalayer.system.status.mqtt_task_10s_max_us) +
-          " us</h4>";
-      content +=
-          "<h4>WIFI function (MQTT task) max load last 10 s: " + String(datalayer.system.status.wifi_task_10s_max_us) +
-          " us</h4>";
-      content += "<h4>Max load @ worst case execution of core task:</h4>";
-      content += "<h4>10ms function timing: " + String(datalayer.system.status.time_snap_10ms_us) + " us</h4>";
-      content += "<h4>Values function timing: " + String(datalayer.system.status.time_snap_values_us) + " us</h4>";
-      content += "<h4>CAN/serial RX function timing: " + String(datalayer.system.status.time_snap_comm_us) + " us</h4>";
-      content += "<h4>CAN TX function timing: " + String(datalayer.system.status.time_snap_cantx_us) + " us</h4>";
+  content += " @ " + String(datalayer.system.info.CPU_temperature, 1) + " &deg;C</h4>";
+  content += "<h4>Uptime: " + get_uptime() + "</h4>";
+  if (datalayer.system.info.performance_measurement_active) {
+    content +=
+        "<h4>Free heap: " + String(ESP.getFreeHeap()) + ", max alloc: " + String(ESP.getMaxAllocHeap()) + "</h4>";
+    FlashMode_t mode = ESP.getFlashChipMode();
+    content += "<h4>Flash mode: " +
+               String(mode == FM_QIO    ? "QIO"
+                      : mode == FM_QOUT ? "QOUT"
+                      : mode == FM_DIO  ? "DIO"
+                      : mode == FM_DOUT ? "DOUT"
+                                        : /*mode == FM_UNKNOWN*/ "Unknown") +
+               ", size: " + String(ESP.getFlashChipSize() / (1024 * 1024)) + " MB</h4>";
+    // Load information
+    content += "<h4>Core task max load: " + String(datalayer.system.status.core_task_max_us) + " us</h4>";
+    content +=
+        "<h4>Core task max load last 10 s: " + String(datalayer.system.status.core_task_10s_max_us) + " us</h4>";
+    content +=
+        "<h4>MQTT function (MQTT task) max load last 10 s: " + String(datalayer.system.status.mqtt_task_10s_max_us) +
+        " us</h4>";
+    content +=
+        "<h4>WIFI function (MQTT task) max load last 10 s: " + String(datalayer.system.status.wifi_task_10s_max_us) +
+        " us</h4>";
+    content += "<h4>Max load @ worst case execution of core task:</h4>";
+    content += "<h4>10ms function timing: " + String(datalayer.system.status.time_snap_10ms_us) + " us</h4>";
+    content += "<h4>Values function timing: " + String(datalayer.system.status.time_snap_values_us) + " us</h4>";
+    content += "<h4>CAN/serial RX function timing: " + String(datalayer.system.status.time_snap_comm_us) + " us</h4>";
+    content += "<h4>CAN TX function timing: " + String(datalayer.system.status.time_snap_cantx_us) + " us</h4>";
+    content += "<h4>Settings load at boot: " + String(datalayer.system.status.settings_load_us) + " us, from " +
+               String(settings_blob.loaded_from() == SETTINGS_FROM_BLOB ? "one blob" : "their own keys") + "</h4>";
+    // CAN receive statistics, only for interfaces that have received anything
+    for (int i = 0; i < NO_CAN_INTERFACE; i++) {
+      const CAN_RX_Statistics& stats = can_rx_statistics[i];
+      if (stats.frames_received == 0) {
+        continue;
+      }
+      content += "<h4>" + String(getCANInterfaceName((CAN_Interface)i)) + " RX: " + String(stats.frames_received) +
+                 " frames, max " + String(stats.frames_max_tick) + " per tick, budget exhausted " +
+                 String(stats.budget_exhausted_count) + " times";
+      if (stats.driver_buffer_size > 0) {
+        content +=
+            ", driver buffer peak " + String(stats.driver_buffer_peak) + "/" + String(stats.driver_buffer_size);
+      }
+      if (stats.overflow_flags & 0x01) {
+        content += ", <span style='color: red;'>hardware FIFO overflow!</span>";
+      }
+      if (stats.overflow_flags & 0x02) {
+        content += ", <span style='color: red;'>driver buffer overflow!</span>";
+      }
+      content += "</h4>";
+      const CAN_Dispatch_Table& table = can_dispatch_tables[i];
+      for (uint8_t r = 0; r < table.count; r++) {
+        content += "<h4>" + String(getCANInterfaceName((CAN_Interface)i)) + " receiver " + String(r + 1) + ": " +
+                   String(table.entries[r].hits) + " frames handled, " + String(table.entries[r].misses) +
+                   " filtered</h4>";
+      }
     }
+    // CAN transmit queues, only for interfaces that have sent anything. The CAN-FD interfaces share one queue, it
+    // is listed under the add-on.
+    for (int i = 0; i < NO_CAN_INTERFACE; i++) {
+      if (can_tx_queues[i] == nullptr || i == CANFD_NATIVE) {
+        continue;
+      }
+      const CAN_TX_Statistics& stats = can_tx_queues[i]->statistics();
+      content += "<h4>" + String(getCANInterfaceName((CAN_Interface)i)) + " TX: " + String(stats.frames_sent) +
+                 " frames, queued " + String(can_tx_queues[i]->depth()) + " (peak " + String(stats.depth_peak) +
+                 "), latency p50 " + String(latency_histogram_percentile(stats.latency, 50)) + " us, p99 " +
+                 String(latency_histogram_percentile(stats.latency, 99)) + " us, max " +
+                 String(stats.latency.max_us.load()) + " us";
+      for (uint8_t c = 0; c < CAN_TX_PRIORITY_COUNT; c++) {
+        if (stats.dropped[c] > 0) {
+          content += ", <span style='color: red;'>" + String(stats.dropped[c]) + " " +
+                     can_tx_priority_name((CAN_Tx_Priority)c) + " dropped</span>";
+        }
+      }
+      content += "</h4>";
+    }
+  }
 
-    wl_status_t status = WiFi.status();
-    // Display ssid of network connected to and, if connected to the WiFi, its own IP
-    content += "<h4>SSID: " + html_escape(ssid.c_str());
-    if (status == WL_CONNECTED) {
-      // Get and display the signal strength (RSSI) and channel
-      content += " RSSI:" + String(WiFi.RSSI()) + " dBm Ch: " + String(WiFi.channel());
+  wl_status_t status = WiFi.status();
+  // Display ssid of network connected to and, if connected to the WiFi, its own IP
+  content += "<h4>SSID: " + html_escape(ssid.c_str());
+  if (status == WL_CONNECTED) {
+    // Get and display the signal strength (RSSI) and channel
+    content += " RSSI:" + String(WiFi.RSSI()) + " dBm Ch: " + String(WiFi.channel());
+  }
+  content += "</h4>";
+  if (status == WL_CONNECTED) {
+    content += "<h4>Hostname: " + html_escape(WiFi.getHostname()) + "</h4>";
+    content += "<h4>IP: " + WiFi.localIP().toString() + "</h4>";
+  } else {
+    content += "<h4>Wifi state: " + getConnectResultString(status) + "</h4>";
+  }
+  if (mqtt_enabled) {
+    // MQTT traffic since boot, and what delta publishing kept off the wire
+    const Mqtt_Delta_Statistics& mqtt_stats = mqtt_delta_statistics;
+    float uptime_s = max(1.0f, millis64() / 1000.0f);
+    content += "<h4>MQTT sent: " + String(mqtt_stats.messages_published / uptime_s, 2) + " msg/s, " +
+               String(mqtt_stats.bytes_published / uptime_s, 1) + " B/s";
+    if (mqtt_delta_enabled) {
+      content += ", saved: " + String(mqtt_stats.messages_suppressed / uptime_s, 2) + " msg/s, " +
+                 String(mqtt_stats.bytes_saved / uptime_s, 1) + " B/s";
     }
     content += "</h4>";
-    if (status == WL_CONNECTED) {
-      content += "<h4>Hostname: " + html_escape(WiFi.getHostname()) + "</h4>";
-      content += "<h4>IP: " + WiFi.localIP().toString() + "</h4>";
-    } else {
-      content += "<h4>Wifi state: " + getConnectResultString(status) + "</h4>";
+  }
+  // Pages are streamed in sections, so the largest section bounds the heap a page view needs
+  const HTML_Render_Statistics& html_stats = html_render_statistics;
+  content += "<h4>Web pages: " + String(html_stats.pages) + " served, last " + String(html_stats.bytes_last_page) +
+             " B, largest section " + String(html_stats.largest_section_last_page) + " B (max " +
+             String(html_stats.largest_section) + " B)</h4>";
+  if (web_push_interval_ms > 0) {
+    const Status_Events_Statistics& events_stats = status_events.statistics();
+    content += "<h4>Live value clients: " + String(events_stats.clients) + ", events sent: " +
+               String(events_stats.events) + " (" + String(events_stats.full_events) + " full)</h4>";
+  }
+  // Close the block
+  content += "</div>";
+}
+
+// Which inverter, battery, charger and shunt are used
+static void status_page_equipment(String& content) {
+  if (inverter || battery || charger || user_selected_shunt_type != ShuntType::None) {
+    // Start a new block with a specific background color
+    content += "<div style='background-color: #333; padding: 10px; margin-bottom: 10px; border-radius: 50px'>";
+
+    // Display which components are used
+    if (inverter) {
+      content += "<h4 style='color: white;'>Inverter protocol: ";
+      content += inverter->name();
+      content += " ";
+      content += datalayer.system.info.inverter_brand;
+      content += "</h4>";
     }
+
+    if (battery) {
+      content += "<h4 style='color: white;'>Battery protocol: ";
+      content += datalayer.system.info.battery_protocol;
+      if (battery3) {
+        content += " (Triple battery)";
+      } else if (battery2) {
+        content += " (Double battery)";
+      }
+      if (datalayer.battery.info.chemistry == battery_chemistry_enum::LFP) {
+        content += " (LFP)";
+      }
+      content += "</h4>";
+    }
+
+    if (user_selected_shunt_type != ShuntType::None) {
+      content += "<h4 style='color: white;'>Shunt protocol: ";
+      content += datalayer.system.info.shunt_protocol;
+      content += "</h4>";
+    }
+
+    if (charger) {
+      content += "<h4 style='color: white;'>Charger protocol: ";
+      content += charger->name();
+      content += "</h4>";
+    }
+
     // Close the block
     content += "</div>";
+  }
+}
 
-    if (inverter || battery || charger || user_selected_shunt_type != ShuntType::None) {
-      // Start a new block with a specific background color
-      content += "<div style='background-color: #333; padding: 10px; margin-bottom: 10px; border-radius: 50px'>";
-
-      // Display which components are used
-      if (inverter) {
-        content += "<h4 style='color: white;'>Inverter protocol: ";
-        content += inverter->name();
-        content += " ";
-        content += datalayer.system.info.inverter_brand;
-        content += "</h4>";
-      }
+// Values and status of each battery
+static void status_page_batteries(String& content) {
+  if (battery) {
+    if (battery2) {
+      // Start a new block with a specific background color. Color changes depending on BMS status
+      content += "<div style='display: flex; width: 100%;'>";
+      content += "<div style='flex: 1; background-color: ";
+    } else {
+      // Start a new block with a specific background color. Color changes depending on system status
+      content += "<div style='background-color: ";
+    }
 
-      if (battery) {
-        content += "<h4 style='color: white;'>Battery protocol: ";
-        content += datalayer.system.info.battery_protocol;
-        if (battery3) {
-          content += " (Triple battery)";
-        } else if (battery2) {
-          content += " (Double battery)";
-        }
-        if (datalayer.battery.info.chemistry == battery_chemistry_enum::LFP) {
-          content += " (LFP)";
-        }
-        content += "</h4>";
-      }
+    switch (get_emulator_status()) {
+      case EMULATOR_STATUS::STATUS_OK:
+        content += "#2D3F2F;";
+        break;
+      case EMULATOR_STATUS::STATUS_WARNING:
+        content += "#F5CC00;";
+        break;
+      case EMULATOR_STATUS::STATUS_ERROR:
+        content += "#A70107;";
+        break;
+      case EMULATOR_STATUS::STATUS_UPDATING:
+        content += "#2B35AF;";  // Blue in test mode
+        break;
+    }
 
-      if (user_selected_shunt_type != ShuntType::None) {
-        content += "<h4 style='color: white;'>Shunt protocol: ";
-        content += datalayer.system.info.shunt_protocol;
-        content += "</h4>";
-      }
+    // Add the common style properties
+    content += "padding: 10px; margin-bottom: 10px; border-radius: 50px;'>";
+
+    // Display battery statistics within this block
+    float socRealFloat =
+        static_cast<float>(datalayer.battery.status.real_soc) / 100.0f;  // Convert to float and divide by 100
+    float socScaledFloat =
+        static_cast<float>(datalayer.battery.status.reported_soc) / 100.0f;  // Convert to float and divide by 100
+    float sohFloat =
+        static_cast<float>(datalayer.battery.status.soh_pptt) / 100.0f;  // Convert to float and divide by 100
+    float voltageFloat =
+        static_cast<float>(datalayer.battery.status.voltage_dV) / 10.0f;  // Convert to float and divide by 10
+    float currentFloat =
+        static_cast<float>(datalayer.battery.status.current_dA) / 10.0f;  // Convert to float and divide by 10
+    float powerFloat = static_cast<float>(datalayer.battery.status.active_power_W);                // Convert to float
+    float tempMaxFloat = static_cast<float>(datalayer.battery.status.temperature_max_dC) / 10.0f;  // Convert to float
+    float tempMinFloat = static_cast<float>(datalayer.battery.status.temperature_min_dC) / 10.0f;  // Convert to float
+    float maxCurrentChargeFloat =
+        static_cast<float>(datalayer.battery.status.max_charge_current_dA) / 10.0f;  // Convert to float
+    float maxCurrentDischargeFloat =
+        static_cast<float>(datalayer.battery.status.max_discharge_current_dA) / 10.0f;  // Convert to float
+    uint16_t cell_delta_mv =
+        datalayer.battery.status.cell_max_voltage_mV - datalayer.battery.status.cell_min_voltage_mV;
+
+    if (datalayer.battery.settings.soc_scaling_active)
+      content += "<h4 style='color: white;'>Scaled SOC: " + String(socScaledFloat, 2) +
+                 "&percnt; (real: " + String(socRealFloat, 2) + "&percnt;)</h4>";
+    else
+      content += "<h4 style='color: white;'>SOC: " + String(socRealFloat, 2) + "&percnt;</h4>";
+
+    content += "<h4 style='color: white;'>SOH: " + String(sohFloat, 2) + "&percnt;</h4>";
+    content += "<h4 style='color: white;'>Voltage: " + String(voltageFloat, 1) +
+               " V &nbsp; Current: " + String(currentFloat, 1) + " A</h4>";
+    content += formatPowerValue("Power", powerFloat, "", 1);
+
+    if (datalayer.battery.settings.soc_scaling_active)
+      content += "<h4 style='color: white;'>Scaled total capacity: " +
+                 formatPowerValue(datalayer.battery.info.reported_total_capacity_Wh, "h", 1) +
+                 " (real: " + formatPowerValue(datalayer.battery.info.total_capacity_Wh, "h", 1) + ")</h4>";
+    else
+      content += formatPowerValue("Total capacity", datalayer.battery.info.total_capacity_Wh, "h", 1);
+
+    if (datalayer.battery.settings.soc_scaling_active)
+      content += "<h4 style='color: white;'>Scaled remaining capacity: " +
+                 formatPowerValue(datalayer.battery.status.reported_remaining_capacity_Wh, "h", 1) +
+                 " (real: " + formatPowerValue(datalayer.battery.status.remaining_capacity_Wh, "h", 1) + ")</h4>";
+    else
+      content += formatPowerValue("Remaining capacity", datalayer.battery.status.remaining_capacity_Wh, "h", 1);
 
-      if (charger) {
-        content += "<h4 style='color: white;'>Charger protocol: ";
-        content += charger->name();
-        content += "</h4>";
+    if (datalayer.system.info.equipment_stop_active) {
+      content +=
+          formatPowerValue("Max discharge power", datalayer.battery.status.max_discharge_power_W, "", 1, "red");
+      content += formatPowerValue("Max charge power", datalayer.battery.status.max_charge_power_W, "", 1, "red");
+      content += "<h4 style='color: red;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
+      content += "<h4 style='color: red;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
+    } else {
+      content += formatPowerValue("Max discharge power", datalayer.battery.status.max_discharge_power_W, "", 1);
+      content += formatPowerValue("Max charge power", datalayer.battery.status.max_charge_power_W, "", 1);
+      content += "<h4 style='color: white;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A";
+      if (datalayer.battery.settings.remote_settings_limit_discharge) {
+        content += " (Remote)</h4>";
+      } else if (datalayer.battery.settings.user_settings_limit_discharge) {
+        content += " (Manual)</h4>";
+      } else {
+        content += " (BMS)</h4>";
+      }
+      content += "<h4 style='color: white;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A";
+      if (datalayer.battery.settings.remote_settings_limit_charge) {
+        content += " (Remote)</h4>";
+      } else if (datalayer.battery.settings.user_settings_limit_charge) {
+        content += " (Manual)</h4>";
+      } else {
+        content += " (BMS)</h4>";
       }
+    }
 
-      // Close the block
-      content += "</div>";
+    content += "<h4>Cell min/max: " + String(datalayer.battery.status.cell_min_voltage_mV) + " mV / " +
+               String(datalayer.battery.status.cell_max_voltage_mV) + " mV</h4>";
+    if (cell_delta_mv > datalayer.battery.info.max_cell_voltage_deviation_mV) {
+      content += "<h4 style='color: red;'>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
+    } else {
+      content += "<h4>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
     }
+    content += "<h4>Temperature min/max: " + String(tempMinFloat, 1) + " &deg;C / " + String(tempMaxFloat, 1) +
+               " &deg;C</h4>";
 
-    if (battery) {
-      if (battery2) {
-        // Start a new block with a specific background color. Color changes depending on BMS status
-        content += "<div style='display: flex; width: 100%;'>";
-        content += "<div style='flex: 1; background-color: ";
+    if (battery && battery->supports_real_BMS_status()) {
+      content += "<h4>Battery BMS status: ";
+      switch (datalayer.battery.status.real_bms_status) {
+        case BMS_ACTIVE:
+          content += String("OK");
+          break;
+        case BMS_FAULT:
+          content += String("FAULT");
+          break;
+        case BMS_DISCONNECTED:
+          content += String("DISCONNECTED");
+          break;
+        case BMS_STANDBY:
+          content += String("STANDBY");
+          break;
+        default:
+          content += String("??");
+          break;
+      }
+      content += "</h4>";
+    }
+
+    if (datalayer.battery.status.current_dA == 0) {
+      content += "<h4>Battery idle</h4>";
+    } else if (datalayer.battery.status.current_dA < 0) {
+      content += "<h4>Battery discharging!";
+      if (datalayer.battery.settings.inverter_limits_discharge) {
+        content += " (Inverter limiting)</h4>";
       } else {
-        // Start a new block with a specific background color. Color changes depending on system status
-        content += "<div style='background-color: ";
+        if (datalayer.battery.settings.user_settings_limit_discharge) {
+          content += " (Settings limiting)</h4>";
+        } else {
+          content += " (Battery limiting)</h4>";
+        }
       }
+      content += "</h4>";
+    } else {  // > 0 , positive current
+      content += "<h4>Battery charging!";
+      if (datalayer.battery.settings.inverter_limits_charge) {
+        content += " (Inverter limiting)</h4>";
+      } else {
+        if (datalayer.battery.settings.user_settings_limit_charge) {
+          content += " (Settings limiting)</h4>";
+        } else {
+          content += " (Battery limiting)</h4>";
+        }
+      }
+    }
+
+    content += "<h4>System status: ";
+    switch (datalayer.system.status.system_status) {
+      case ACTIVE:
+        content += String("OK");
+        break;
+      case UPDATING:
+        content += String("UPDATING");
+        break;
+      case FAULT:
+        content += String("FAULT ");
+        content += "<button onclick='Events()'>Inspect reason</button> ";
+        break;
+      case INACTIVE:
+        content += String("INACTIVE");
+        break;
+      case STANDBY:
+        content += String("STANDBY");
+        break;
+      default:
+        content += String("??");
+        break;
+    }
+    content += "</h4>";
+
+    // Close the block
+    content += "</div>";
 
-      switch (get_emulator_status()) {
-        case EMULATOR_STATUS::STATUS_OK:
+    if (battery2) {
+      content += "<div style='flex: 1; background-color: ";
+      switch (datalayer.system.status.system_status) {
+        case ACTIVE:
           content += "#2D3F2F;";
           break;
-        case EMULATOR_STATUS::STATUS_WARNING:
-          content += "#F5CC00;";
-          break;
-        case EMULATOR_STATUS::STATUS_ERROR:
+        case FAULT:
           content += "#A70107;";
           break;
-        case EMULATOR_STATUS::STATUS_UPDATING:
-          content += "#2B35AF;";  // Blue in test mode
+        default:
+          content += "#2D3F2F;";
           break;
       }
-
       // Add the common style properties
       content += "padding: 10px; margin-bottom: 10px; border-radius: 50px;'>";
 
       // Display battery statistics within this block
-      float socRealFloat =
-          static_cast<float>(datalayer.battery.status.real_soc) / 100.0f;  // Convert to float and divide by 100
-      float socScaledFloat =
-          static_cast<float>(datalayer.battery.status.reported_soc) / 100.0f;  // Convert to float and divide by 100
-      float sohFloat =
-          static_cast<float>(datalayer.battery.status.soh_pptt) / 100.0f;  // Convert to float and divide by 100
-      float voltageFloat =
-          static_cast<float>(datalayer.battery.status.voltage_dV) / 10.0f;  // Convert to float and divide by 10
-      float currentFloat =
-          static_cast<float>(datalayer.battery.status.current_dA) / 10.0f;  // Convert to float and divide by 10
-      float powerFloat = static_cast<float>(datalayer.battery.status.active_power_W);                // Convert to float
-      float tempMaxFloat = static_cast<float>(datalayer.battery.status.temperature_max_dC) / 10.0f;  // Convert to float
-      float tempMinFloat = static_cast<float>(datalayer.battery.status.temperature_min_dC) / 10.0f;  // Convert to float
-      float maxCurrentChargeFloat =
-          static_cast<float>(datalayer.battery.status.max_charge_current_dA) / 10.0f;  // Convert to float
-      float maxCurrentDischargeFloat =
-          static_cast<float>(datalayer.battery.status.max_discharge_current_dA) / 10.0f;  // Convert to float
-      uint16_t cell_delta_mv =
-          datalayer.battery.status.cell_max_voltage_mV - datalayer.battery.status.cell_min_voltage_mV;
+      socRealFloat =
+          static_cast<float>(datalayer.battery2.status.real_soc) / 100.0f;  // Convert to float and divide by 100
+      //socScaledFloat; // Same value used for bat2
+      sohFloat =
+          static_cast<float>(datalayer.battery2.status.soh_pptt) / 100.0f;  // Convert to float and divide by 100
+      voltageFloat =
+          static_cast<float>(datalayer.battery2.status.voltage_dV) / 10.0f;  // Convert to float and divide by 10
+      currentFloat =
+          static_cast<float>(datalayer.battery2.status.current_dA) / 10.0f;       // Convert to float and divide by 10
+      powerFloat = static_cast<float>(datalayer.battery2.status.active_power_W);  // Convert to float
+      tempMaxFloat = static_cast<float>(datalayer.battery2.status.temperature_max_dC) / 10.0f;  // Convert to float
+      tempMinFloat = static_cast<float>(datalayer.battery2.status.temperature_min_dC) / 10.0f;  // Convert to float
+      cell_delta_mv = datalayer.battery2.status.cell_max_voltage_mV - datalayer.battery2.status.cell_min_voltage_mV;
 
       if (datalayer.battery.settings.soc_scaling_active)
         content += "<h4 style='color: white;'>Scaled SOC: " + String(socScaledFloat, 2) +
@@ -1130,132 +1644,51 @@ String processor(const String& var) {
 
       if (datalayer.battery.settings.soc_scaling_active)
         content += "<h4 style='color: white;'>Scaled total capacity: " +
-                   formatPowerValue(datalayer.battery.info.reported_total_capacity_Wh, "h", 1) +
-                   " (real: " + formatPowerValue(datalayer.battery.info.total_capacity_Wh, "h", 1) + ")</h4>";
+                   formatPowerValue(datalayer.battery2.info.reported_total_capacity_Wh, "h", 1) +
+                   " (real: " + formatPowerValue(datalayer.battery2.info.total_capacity_Wh, "h", 1) + ")</h4>";
       else
-        content += formatPowerValue("Total capacity", datalayer.battery.info.total_capacity_Wh, "h", 1);
+        content += formatPowerValue("Total capacity", datalayer.battery2.info.total_capacity_Wh, "h", 1);
 
       if (datalayer.battery.settings.soc_scaling_active)
         content += "<h4 style='color: white;'>Scaled remaining capacity: " +
-                   formatPowerValue(datalayer.battery.status.reported_remaining_capacity_Wh, "h", 1) +
-                   " (real: " + formatPowerValue(datalayer.battery.status.remaining_capacity_Wh, "h", 1) + ")</h4>";
+                   formatPowerValue(datalayer.battery2.status.reported_remaining_capacity_Wh, "h", 1) +
+                   " (real: " + formatPowerValue(datalayer.battery2.status.remaining_capacity_Wh, "h", 1) + ")</h4>";
       else
-        content += formatPowerValue("Remaining capacity", datalayer.battery.status.remaining_capacity_Wh, "h", 1);
+        content += formatPowerValue("Remaining capacity", datalayer.battery2.status.remaining_capacity_Wh, "h", 1);
 
       if (datalayer.system.info.equipment_stop_active) {
         content +=
-            formatPowerValue("Max discharge power", datalayer.battery.status.max_discharge_power_W, "", 1, "red");
-        content += formatPowerValue("Max charge power", datalayer.battery.status.max_charge_power_W, "", 1, "red");
-        content += "<h4 style='color: red;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
+            formatPowerValue("Max discharge power", datalayer.battery2.status.max_discharge_power_W, "", 1, "red");
+        content += formatPowerValue("Max charge power", datalayer.battery2.status.max_charge_power_W, "", 1, "red");
+        content +=
+            "<h4 style='color: red;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
         content += "<h4 style='color: red;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
       } else {
-        content += formatPowerValue("Max discharge power", datalayer.battery.status.max_discharge_power_W, "", 1);
-        content += formatPowerValue("Max charge power", datalayer.battery.status.max_charge_power_W, "", 1);
-        content += "<h4 style='color: white;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A";
-        if (datalayer.battery.settings.remote_settings_limit_discharge) {
-          content += " (Remote)</h4>";
-        } else if (datalayer.battery.settings.user_settings_limit_discharge) {
-          content += " (Manual)</h4>";
-        } else {
-          content += " (BMS)</h4>";
-        }
-        content += "<h4 style='color: white;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A";
-        if (datalayer.battery.settings.remote_settings_limit_charge) {
-          content += " (Remote)</h4>";
-        } else if (datalayer.battery.settings.user_settings_limit_charge) {
-          content += " (Manual)</h4>";
-        } else {
-          content += " (BMS)</h4>";
-        }
+        content += formatPowerValue("Max discharge power", datalayer.battery2.status.max_discharge_power_W, "", 1);
+        content += formatPowerValue("Max charge power", datalayer.battery2.status.max_charge_power_W, "", 1);
+        content +=
+            "<h4 style='color: white;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
+        content += "<h4 style='color: white;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
       }
 
-      content += "<h4>Cell min/max: " + String(datalayer.battery.status.cell_min_voltage_mV) + " mV / " +
-                 String(datalayer.battery.status.cell_max_voltage_mV) + " mV</h4>";
-      if (cell_delta_mv > datalayer.battery.info.max_cell_voltage_deviation_mV) {
+      content += "<h4>Cell min/max: " + String(datalayer.battery2.status.cell_min_voltage_mV) + " mV / " +
+                 String(datalayer.battery2.status.cell_max_voltage_mV) + " mV</h4>";
+      if (cell_delta_mv > datalayer.battery2.info.max_cell_voltage_deviation_mV) {
         content += "<h4 style='color: red;'>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
       } else {
         content += "<h4>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
       }
       content += "<h4>Temperature min/max: " + String(tempMinFloat, 1) + " &deg;C / " + String(tempMaxFloat, 1) +
                  " &deg;C</h4>";
-
-      if (battery && battery->supports_real_BMS_status()) {
-        content += "<h4>Battery BMS status: ";
-        switch (datalayer.battery.status.real_bms_status) {
-          case BMS_ACTIVE:
-            content += String("OK");
-            break;
-          case BMS_FAULT:
-            content += String("FAULT");
-            break;
-          case BMS_DISCONNECTED:
-            content += String("DISCONNECTED");
-            break;
-          case BMS_STANDBY:
-            content += String("STANDBY");
-            break;
-          default:
-            content += String("??");
-            break;
-        }
-        content += "</h4>";
-      }
-
-      if (datalayer.battery.status.current_dA == 0) {
+      if (datalayer.battery2.status.current_dA == 0) {
         content += "<h4>Battery idle</h4>";
-      } else if (datalayer.battery.status.current_dA < 0) {
-        content += "<h4>Battery discharging!";
-        if (datalayer.battery.settings.inverter_limits_discharge) {
-          content += " (Inverter limiting)</h4>";
-        } else {
-          if (datalayer.battery.settings.user_settings_limit_discharge) {
-            content += " (Settings limiting)</h4>";
-          } else {
-            content += " (Battery limiting)</h4>";
-          }
-        }
-        content += "</h4>";
-      } else {  // > 0 , positive current
-        content += "<h4>Battery charging!";
-        if (datalayer.battery.settings.inverter_limits_charge) {
-          content += " (Inverter limiting)</h4>";
-        } else {
-          if (datalayer.battery.settings.user_settings_limit_charge) {
-            content += " (Settings limiting)</h4>";
-          } else {
-            content += " (Battery limiting)</h4>";
-          }
-        }
+      } else if (datalayer.battery2.status.current_dA < 0) {
+        content += "<h4>Battery discharging!</h4>";
+      } else {  // > 0
+        content += "<h4>Battery charging!</h4>";
       }
-
-      content += "<h4>System status: ";
-      switch (datalayer.system.status.system_status) {
-        case ACTIVE:
-          content += String("OK");
-          break;
-        case UPDATING:
-          content += String("UPDATING");
-          break;
-        case FAULT:
-          content += String("FAULT ");
-          content += "<button onclick='Events()'>Inspect reason</button> ";
-          break;
-        case INACTIVE:
-          content += String("INACTIVE");
-          break;
-        case STANDBY:
-          content += String("STANDBY");
-          break;
-        default:
-          content += String("??");
-          break;
-      }
-      content += "</h4>";
-
-      // Close the block
       content += "</div>";
-
-      if (battery2) {
+      if (battery3) {
         content += "<div style='flex: 1; background-color: ";
         switch (datalayer.system.status.system_status) {
           case ACTIVE:
@@ -1273,18 +1706,18 @@ String processor(const String& var) {
 
         // Display battery statistics within this block
         socRealFloat =
-            static_cast<float>(datalayer.battery2.status.real_soc) / 100.0f;  // Convert to float and divide by 100
+            static_cast<float>(datalayer.battery3.status.real_soc) / 100.0f;  // Convert to float and divide by 100
         //socScaledFloat; // Same value used for bat2
         sohFloat =
-            static_cast<float>(datalayer.battery2.status.soh_pptt) / 100.0f;  // Convert to float and divide by 100
+            static_cast<float>(datalayer.battery3.status.soh_pptt) / 100.0f;  // Convert to float and divide by 100
         voltageFloat =
-            static_cast<float>(datalayer.battery2.status.voltage_dV) / 10.0f;  // Convert to float and divide by 10
+            static_cast<float>(datalayer.battery3.status.voltage_dV) / 10.0f;  // Convert to float and divide by 10
         currentFloat =
-            static_cast<float>(datalayer.battery2.status.current_dA) / 10.0f;       // Convert to float and divide by 10
-        powerFloat = static_cast<float>(datalayer.battery2.status.active_power_W);  // Convert to float
-        tempMaxFloat = static_cast<float>(datalayer.battery2.status.temperature_max_dC) / 10.0f;  // Convert to float
-        tempMinFloat = static_cast<float>(datalayer.battery2.status.temperature_min_dC) / 10.0f;  // Convert to float
-        cell_delta_mv = datalayer.battery2.status.cell_max_voltage_mV - datalayer.battery2.status.cell_min_voltage_mV;
+            static_cast<float>(datalayer.battery3.status.current_dA) / 10.0f;  // Convert to float and divide by 10
+        powerFloat = static_cast<float>(datalayer.battery3.status.active_power_W);                // Convert to float
+        tempMaxFloat = static_cast<float>(datalayer.battery3.status.temperature_max_dC) / 10.0f;  // Convert to float
+        tempMinFloat = static_cast<float>(datalayer.battery3.status.temperature_min_dC) / 10.0f;  // Convert to float
+        cell_delta_mv = datalayer.battery3.status.cell_max_voltage_mV - datalayer.battery3.status.cell_min_voltage_mV;
 
         if (datalayer.battery.settings.soc_scaling_active)
           content += "<h4 style='color: white;'>Scaled SOC: " + String(socScaledFloat, 2) +
@@ -1299,373 +1732,298 @@ String processor(const String& var) {
 
         if (datalayer.battery.settings.soc_scaling_active)
           content += "<h4 style='color: white;'>Scaled total capacity: " +
-                     formatPowerValue(datalayer.battery2.info.reported_total_capacity_Wh, "h", 1) +
-                     " (real: " + formatPowerValue(datalayer.battery2.info.total_capacity_Wh, "h", 1) + ")</h4>";
+                     formatPowerValue(datalayer.battery3.info.reported_total_capacity_Wh, "h", 1) +
+                     " (real: " + formatPowerValue(datalayer.battery3.info.total_capacity_Wh, "h", 1) + ")</h4>";
         else
-          content += formatPowerValue("Total capacity", datalayer.battery2.info.total_capacity_Wh, "h", 1);
+          content += formatPowerValue("Total capacity", datalayer.battery3.info.total_capacity_Wh, "h", 1);
 
         if (datalayer.battery.settings.soc_scaling_active)
           content += "<h4 style='color: white;'>Scaled remaining capacity: " +
-                     formatPowerValue(datalayer.battery2.status.reported_remaining_capacity_Wh, "h", 1) +
-                     " (real: " + formatPowerValue(datalayer.battery2.status.remaining_capacity_Wh, "h", 1) + ")</h4>";
+                     formatPowerValue(datalayer.battery3.status.reported_remaining_capacity_Wh, "h", 1) +
+                     " (real: " + formatPowerValue(datalayer.battery3.status.remaining_capacity_Wh, "h", 1) +
+                     ")</h4>";
         else
-          content += formatPowerValue("Remaining capacity", datalayer.battery2.status.remaining_capacity_Wh, "h", 1);
+          content += formatPowerValue("Remaining capacity", datalayer.battery3.status.remaining_capacity_Wh, "h", 1);
 
         if (datalayer.system.info.equipment_stop_active) {
           content +=
-              formatPowerValue("Max discharge power", datalayer.battery2.status.max_discharge_power_W, "", 1, "red");
-          content += formatPowerValue("Max charge power", datalayer.battery2.status.max_charge_power_W, "", 1, "red");
+              formatPowerValue("Max discharge power", datalayer.battery3.status.max_discharge_power_W, "", 1, "red");
+          content += formatPowerValue("Max charge power", datalayer.battery3.status.max_charge_power_W, "", 1, "red");
           content +=
               "<h4 style='color: red;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
           content += "<h4 style='color: red;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
         } else {
-          content += formatPowerValue("Max discharge power", datalayer.battery2.status.max_discharge_power_W, "", 1);
-          content += formatPowerValue("Max charge power", datalayer.battery2.status.max_charge_power_W, "", 1);
+          content += formatPowerValue("Max discharge power", datalayer.battery3.status.max_discharge_power_W, "", 1);
+          content += formatPowerValue("Max charge power", datalayer.battery3.status.max_charge_power_W, "", 1);
           content +=
               "<h4 style='color: white;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
           content += "<h4 style='color: white;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
         }
 
-        content += "<h4>Cell min/max: " + String(datalayer.battery2.status.cell_min_voltage_mV) + " mV / " +
-                   String(datalayer.battery2.status.cell_max_voltage_mV) + " mV</h4>";
-        if (cell_delta_mv > datalayer.battery2.info.max_cell_voltage_deviation_mV) {
+        content += "<h4>Cell min/max: " + String(datalayer.battery3.status.cell_min_voltage_mV) + " mV / " +
+                   String(datalayer.battery3.status.cell_max_voltage_mV) + " mV</h4>";
+        if (cell_delta_mv > datalayer.battery3.info.max_cell_voltage_deviation_mV) {
           content += "<h4 style='color: red;'>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
         } else {
           content += "<h4>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
         }
         content += "<h4>Temperature min/max: " + String(tempMinFloat, 1) + " &deg;C / " + String(tempMaxFloat, 1) +
                    " &deg;C</h4>";
-        if (datalayer.battery2.status.current_dA == 0) {
+        if (datalayer.battery3.status.current_dA == 0) {
           content += "<h4>Battery idle</h4>";
-        } else if (datalayer.battery2.status.current_dA < 0) {
+        } else if (datalayer.battery3.status.current_dA < 0) {
           content += "<h4>Battery discharging!</h4>";
         } else {  // > 0
           content += "<h4>Battery charging!</h4>";
         }
         content += "</div>";
-        if (battery3) {
-          content += "<div style='flex: 1; background-color: ";
-          switch (datalayer.system.status.system_status) {
-            case ACTIVE:
-              content += "#2D3F2F;";
-              break;
-            case FAULT:
-              content += "#A70107;";
-              break;
-            default:
-              content += "#2D3F2F;";
-              break;
-          }
-          // Add the common style properties
-          content += "padding: 10px; margin-bottom: 10px; border-radius: 50px;'>";
-
-          // Display battery statistics within this block
-          socRealFloat =
-              static_cast<float>(datalayer.battery3.status.real_soc) / 100.0f;  // Convert to float and divide by 100
-          //socScaledFloat; // Same value used for bat2
-          sohFloat =
-              static_cast<float>(datalayer.battery3.status.soh_pptt) / 100.0f;  // Convert to float and divide by 100
-          voltageFloat =
-              static_cast<float>(datalayer.battery3.status.voltage_dV) / 10.0f;  // Convert to float and divide by 10
-          currentFloat =
-              static_cast<float>(datalayer.battery3.status.current_dA) / 10.0f;  // Convert to float and divide by 10
-          powerFloat = static_cast<float>(datalayer.battery3.status.active_power_W);                // Convert to float
-          tempMaxFloat = static_cast<float>(datalayer.battery3.status.temperature_max_dC) / 10.0f;  // Convert to float
-          tempMinFloat = static_cast<float>(datalayer.battery3.status.temperature_min_dC) / 10.0f;  // Convert to float
-          cell_delta_mv = datalayer.battery3.status.cell_max_voltage_mV - datalayer.battery3.status.cell_min_voltage_mV;
-
-          if (datalayer.battery.settings.soc_scaling_active)
-            content += "<h4 style='color: white;'>Scaled SOC: " + String(socScaledFloat, 2) +
-                       "&percnt; (real: " + String(socRealFloat, 2) + "&percnt;)</h4>";
-          else
-            content += "<h4 style='color: white;'>SOC: " + String(socRealFloat, 2) + "&percnt;</h4>";
-
-          content += "<h4 style='color: white;'>SOH: " + String(sohFloat, 2) + "&percnt;</h4>";
-          content += "<h4 style='color: white;'>Voltage: " + String(voltageFloat, 1) +
-                     " V &nbsp; Current: " + String(currentFloat, 1) + " A</h4>";
-          content += formatPowerValue("Power", powerFloat, "", 1);
-
-          if (datalayer.battery.settings.soc_scaling_active)
-            content += "<h4 style='color: white;'>Scaled total capacity: " +
-                       formatPowerValue(datalayer.battery3.info.reported_total_capacity_Wh, "h", 1) +
-                       " (real: " + formatPowerValue(datalayer.battery3.info.total_capacity_Wh, "h", 1) + ")</h4>";
-          else
-            content += formatPowerValue("Total capacity", datalayer.battery3.info.total_capacity_Wh, "h", 1);
-
-          if (datalayer.battery.settings.soc_scaling_active)
-            content += "<h4 style='color: white;'>Scaled remaining capacity: " +
-                       formatPowerValue(datalayer.battery3.status.reported_remaining_capacity_Wh, "h", 1) +
-                       " (real: " + formatPowerValue(datalayer.battery3.status.remaining_capacity_Wh, "h", 1) +
-                       ")</h4>";
-          else
-            content += formatPowerValue("Remaining capacity", datalayer.battery3.status.remaining_capacity_Wh, "h", 1);
-
-          if (datalayer.system.info.equipment_stop_active) {
-            content +=
-                formatPowerValue("Max discharge power", datalayer.battery3.status.max_discharge_power_W, "", 1, "red");
-            content += formatPowerValue("Max charge power", datalayer.battery3.status.max_charge_power_W, "", 1, "red");
-            content +=
-                "<h4 style='color: red;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
-            content += "<h4 style='color: red;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
-          } else {
-            content += formatPowerValue("Max discharge power", datalayer.battery3.status.max_discharge_power_W, "", 1);
-            content += formatPowerValue("Max charge power", datalayer.battery3.status.max_charge_power_W, "", 1);
-            content +=
-                "<h4 style='color: white;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
-            content += "<h4 style='color: white;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
-          }
-
-          content += "<h4>Cell min/max: " + String(datalayer.battery3.status.cell_min_voltage_mV) + " mV / " +
-                     String(datalayer.battery3.status.cell_max_voltage_mV) + " mV</h4>";
-          if (cell_delta_mv > datalayer.battery3.info.max_cell_voltage_deviation_mV) {
-            content += "<h4 style='color: red;'>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
-          } else {
-            content += "<h4>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
-          }
-          content += "<h4>Temperature min/max: " + String(tempMinFloat, 1) + " &deg;C / " + String(tempMaxFloat, 1) +
-                     " &deg;C</h4>";
-          if (datalayer.battery3.status.current_dA == 0) {
-            content += "<h4>Battery idle</h4>";
-          } else if (datalayer.battery3.status.current_dA < 0) {
-            content += "<h4>Battery discharging!</h4>";
-          } else {  // > 0
-            content += "<h4>Battery charging!</h4>";
-          }
-          content += "</div>";
-          content += "</div>";
-        }
         content += "</div>";
       }
+      content += "</div>";
     }
-    // Block for Contactor status and component request status
-    // Start a new block with gray background color
-    content += "<div style='background-color: #333; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
+  }
+}
 
-    if (emulator_pause_status == NORMAL) {
-      content += "<h4>Power status: " + String(get_emulator_pause_status().c_str()) + " </h4>";
-    } else {
-      content += "<h4 style='color: red;'>Power status: " + String(get_emulator_pause_status().c_str()) + " </h4>";
-    }
+static void status_page_contactors(String& content) {
+  // Block for Contactor status and component request status
+  // Start a new block with gray background color
+  content += "<div style='background-color: #333; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
 
-    content += "<h4>Emulator allows contactor closing: ";
-    if (datalayer.system.status.system_status == FAULT) {
-      content += "<span style='color: red;'>&#10005;</span>";
-    } else {
+  if (emulator_pause_status == NORMAL) {
+    content += "<h4>Power status: " + String(get_emulator_pause_status().c_str()) + " </h4>";
+  } else {
+    content += "<h4 style='color: red;'>Power status: " + String(get_emulator_pause_status().c_str()) + " </h4>";
+  }
+
+  content += "<h4>Emulator allows contactor closing: ";
+  if (datalayer.system.status.system_status == FAULT) {
+    content += "<span style='color: red;'>&#10005;</span>";
+  } else {
+    content += "<span>&#10003;</span>";
+  }
+  content += " Inverter allows contactor closing: ";
+  if (datalayer.system.status.inverter_allows_contactor_closing == true) {
+    content += "<span>&#10003;</span></h4>";
+  } else {
+    content += "<span style='color: red;'>&#10005;</span></h4>";
+  }
+  if (battery2) {
+    content += "<h4>Secondary battery allowed to join ";
+    if (datalayer.system.status.battery2_allowed_contactor_closing == true) {
       content += "<span>&#10003;</span>";
-    }
-    content += " Inverter allows contactor closing: ";
-    if (datalayer.system.status.inverter_allows_contactor_closing == true) {
-      content += "<span>&#10003;</span></h4>";
     } else {
-      content += "<span style='color: red;'>&#10005;</span></h4>";
+      content += "<span style='color: red;'>&#10005; (voltage mismatch)</span>";
     }
-    if (battery2) {
-      content += "<h4>Secondary battery allowed to join ";
-      if (datalayer.system.status.battery2_allowed_contactor_closing == true) {
-        content += "<span>&#10003;</span>";
-      } else {
-        content += "<span style='color: red;'>&#10005; (voltage mismatch)</span>";
-      }
-    }
-    if (battery3) {
-      content += "<h4>Third battery allowed to join ";
-      if (datalayer.system.status.battery3_allowed_contactor_closing == true) {
-        content += "<span>&#10003;</span>";
-      } else {
-        content += "<span style='color: red;'>&#10005; (voltage mismatch)</span>";
-      }
+  }
+  if (battery3) {
+    content += "<h4>Third battery allowed to join ";
+    if (datalayer.system.status.battery3_allowed_contactor_closing == true) {
+      content += "<span>&#10003;</span>";
+    } else {
+      content += "<span style='color: red;'>&#10005; (voltage mismatch)</span>";
     }
+  }
 
-    if (!contactor_control_enabled) {
-      content += "<div class=\"tooltip\">";
-      content += "<h4>Contactors not fully controlled via emulator <span style=\"color:orange\">[?]</span></h4>";
+  if (!contactor_control_enabled) {
+    content += "<div class=\"tooltip\">";
+    content += "<h4>Contactors not fully controlled via emulator <span style=\"color:orange\">[?]</span></h4>";
+    content +=
+        "<span class=\"tooltiptext\">This means you are either running CAN controlled contactors OR manually "
+        "powering the contactors. Battery-Emulator will have limited amount of control over the contactors!</span>";
+    content += "</div>";
+  } else {  //contactor_control_enabled TRUE
+    content += "<div class=\"tooltip\"><h4>Contactors controlled by emulator, state: ";
+    if (datalayer.system.status.contactors_engaged == 0) {
+      content += "<span style='color: red;'>OFF (DISCONNECTED)</span>";
+    } else if (datalayer.system.status.contactors_engaged == 1) {
+      content += "<span style='color: green;'>ON</span>";
+    } else if (datalayer.system.status.contactors_engaged == 2) {
+      content += "<span style='color: red;'>OFF (FAULT)</span>";
+      content += "<span class=\"tooltip-icon\"> [!]</span>";
       content +=
-          "<span class=\"tooltiptext\">This means you are either running CAN controlled contactors OR manually "
-          "powering the contactors. Battery-Emulator will have limited amount of control over the contactors!</span>";
-      content += "</div>";
-    } else {  //contactor_control_enabled TRUE
-      content += "<div class=\"tooltip\"><h4>Contactors controlled by emulator, state: ";
-      if (datalayer.system.status.contactors_engaged == 0) {
-        content += "<span style='color: red;'>OFF (DISCONNECTED)</span>";
-      } else if (datalayer.system.status.contactors_engaged == 1) {
-        content += "<span style='color: green;'>ON</span>";
-      } else if (datalayer.system.status.contactors_engaged == 2) {
-        content += "<span style='color: red;'>OFF (FAULT)</span>";
-        content += "<span class=\"tooltip-icon\"> [!]</span>";
-        content +=
-            "<span class=\"tooltiptext\">Emulator spent too much time in critical FAULT event. Investigate event "
-            "causing this via Events page. Reboot required to resume operation!</span>";
-      } else if (datalayer.system.status.contactors_engaged == 3) {
-        content += "<span style='color: orange;'>PRECHARGE</span>";
-      }
-      content += "</h4></div>";
-      if (contactor_control_enabled_double_battery && battery2) {
-        content += "<h4>Secondary battery contactor, state: ";
-        if (pwm_contactor_control) {
-          if (datalayer.system.status.contactors_battery2_engaged) {
-            content += "<span style='color: green;'>Economized</span>";
-          } else {
-            content += "<span style='color: red;'>OFF</span>";
-          }
-        } else if (
-            esp32hal->SECOND_BATTERY_CONTACTORS_PIN() !=
-            GPIO_NUM_NC) {  // No PWM_CONTACTOR_CONTROL , we can read the pin and see feedback. Helpful if channel overloaded
-          if (digitalRead(esp32hal->SECOND_BATTERY_CONTACTORS_PIN()) == HIGH) {
-            content += "<span style='color: green;'>ON</span>";
-          } else {
-            content += "<span style='color: red;'>OFF</span>";
-          }
-        }  //no PWM_CONTACTOR_CONTROL
-        content += "</h4>";
-      }
+          "<span class=\"tooltiptext\">Emulator spent too much time in critical FAULT event. Investigate event "
+          "causing this via Events page. Reboot required to resume operation!</span>";
+    } else if (datalayer.system.status.contactors_engaged == 3) {
+      content += "<span style='color: orange;'>PRECHARGE</span>";
     }
+    content += "</h4></div>";
+    if (contactor_control_enabled_double_battery && battery2) {
+      content += "<h4>Secondary battery contactor, state: ";
+      if (pwm_contactor_control) {
+        if (datalayer.system.status.contactors_battery2_engaged) {
+          content += "<span style='color: green;'>Economized</span>";
+        } else {
+          content += "<span style='color: red;'>OFF</span>";
+        }
+      } else if (
+          esp32hal->SECOND_BATTERY_CONTACTORS_PIN() !=
+          GPIO_NUM_NC) {  // No PWM_CONTACTOR_CONTROL , we can read the pin and see feedback. Helpful if channel overloaded
+        if (digitalRead(esp32hal->SECOND_BATTERY_CONTACTORS_PIN()) == HIGH) {
+          content += "<span style='color: green;'>ON</span>";
+        } else {
+          content += "<span style='color: red;'>OFF</span>";
+        }
+      }  //no PWM_CONTACTOR_CONTROL
+      content += "</h4>";
+    }
+  }
 
-    // Close the block
-    content += "</div>";
+  // Close the block
+  content += "</div>";
+}
 
-    if (charger) {
-      // Start a new block with orange background color
-      content += "<div style='background-color: #FF6E00; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
+static void status_page_charger(String& content) {
+  if (charger) {
+    // Start a new block with orange background color
+    content += "<div style='background-color: #FF6E00; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
 
-      content += "<h4>Charger HV Enabled: ";
-      if (datalayer.charger.charger_HV_enabled) {
-        content += "<span>&#10003;</span>";
-      } else {
-        content += "<span style='color: red;'>&#10005;</span>";
-      }
-      content += "</h4>";
+    content += "<h4>Charger HV Enabled: ";
+    if (datalayer.charger.charger_HV_enabled) {
+      content += "<span>&#10003;</span>";
+    } else {
+      content += "<span style='color: red;'>&#10005;</span>";
+    }
+    content += "</h4>";
 
-      content += "<h4>Charger Aux12v Enabled: ";
-      if (datalayer.charger.charger_aux12V_enabled) {
-        content += "<span>&#10003;</span>";
-      } else {
-        content += "<span style='color: red;'>&#10005;</span>";
-      }
-      content += "</h4>";
+    content += "<h4>Charger Aux12v Enabled: ";
+    if (datalayer.charger.charger_aux12V_enabled) {
+      content += "<span>&#10003;</span>";
+    } else {
+      content += "<span style='color: red;'>&#10005;</span>";
+    }
+    content += "</h4>";
 
-      auto chgPwrDC = charger->outputPowerDC();
-      auto chgEff = charger->efficiency();
+    auto chgPwrDC = charger->outputPowerDC();
+    auto chgEff = charger->efficiency();
 
-      content += formatPowerValue("Charger Output Power", chgPwrDC, "", 1);
-      if (charger->efficiencySupported()) {
-        content += "<h4 style='color: white;'>Charger Efficiency: " + String(chgEff) + "%</h4>";
-      }
+    content += formatPowerValue("Charger Output Power", chgPwrDC, "", 1);
+    if (charger->efficiencySupported()) {
+      content += "<h4 style='color: white;'>Charger Efficiency: " + String(chgEff) + "%</h4>";
+    }
 
-      float HVvol = charger->HVDC_output_voltage();
-      float HVcur = charger->HVDC_output_current();
-      float LVvol = charger->LVDC_output_voltage();
-      float LVcur = charger->LVDC_output_current();
+    float HVvol = charger->HVDC_output_voltage();
+    float HVcur = charger->HVDC_output_current();
+    float LVvol = charger->LVDC_output_voltage();
+    float LVcur = charger->LVDC_output_current();
 
-      content += "<h4 style='color: white;'>Charger HVDC Output V: " + String(HVvol, 2) + " V</h4>";
-      content += "<h4 style='color: white;'>Charger HVDC Output I: " + String(HVcur, 2) + " A</h4>";
-      content += "<h4 style='color: white;'>Charger LVDC Output I: " + String(LVcur, 2) + "</h4>";
-      content += "<h4 style='color: white;'>Charger LVDC Output V: " + String(LVvol, 2) + "</h4>";
+    content += "<h4 style='color: white;'>Charger HVDC Output V: " + String(HVvol, 2) + " V</h4>";
+    content += "<h4 style='color: white;'>Charger HVDC Output I: " + String(HVcur, 2) + " A</h4>";
+    content += "<h4 style='color: white;'>Charger LVDC Output I: " + String(LVcur, 2) + "</h4>";
+    content += "<h4 style='color: white;'>Charger LVDC Output V: " + String(LVvol, 2) + "</h4>";
 
-      float ACcur = charger->AC_input_current();
-      float ACvol = charger->AC_input_voltage();
+    float ACcur = charger->AC_input_current();
+    float ACvol = charger->AC_input_voltage();
 
-      content += "<h4 style='color: white;'>Charger AC Input V: " + String(ACvol, 2) + " VAC</h4>";
-      content += "<h4 style='color: white;'>Charger AC Input I: " + String(ACcur, 2) + " A</h4>";
+    content += "<h4 style='color: white;'>Charger AC Input V: " + String(ACvol, 2) + " VAC</h4>";
+    content += "<h4 style='color: white;'>Charger AC Input I: " + String(ACcur, 2) + " A</h4>";
 
-      content += "</div>";
-    }
+    content += "</div>";
+  }
+}
 
-    if (emulator_pause_request_ON)
-      content += "<button onclick='PauseBattery(false)'>Resume charge/discharge</button> ";
-    else
-      content +=
-          "<button onclick=\"if(confirm('Are you sure you want to pause charging and discharging? This will set the "
-          "maximum charge and discharge values to zero, preventing any further power flow.')) { PauseBattery(true); "
-          "}\">Pause charge/discharge</button> ";
-
-    content += "<button onclick='OTA()'>Perform OTA update</button> ";
-    content += "<button onclick='Settings()'>Change Settings</button> ";
-    content += "<button onclick='Advanced()'>More Battery Info</button> ";
-    content += "<button onclick='CANlog()'>CAN logger</button> ";
-    content += "<button onclick='CANreplay()'>CAN replay</button> ";
-    if (datalayer.system.info.web_logging_active || datalayer.system.info.SD_logging_active) {
-      content += "<button onclick='Log()'>Log</button> ";
-    }
-    content += "<button onclick='Cellmon()'>Cellmonitor</button> ";
-    content += "<button onclick='Events()'>Events</button> ";
-    content += "<button onclick='askReboot()'>Reboot Emulator</button> ";
-    if (webserver_auth)
-      content += "<button onclick='logout()'>Logout</button>";
-    if (!datalayer.system.info.equipment_stop_active)
-      content +=
-          "<br/><button style=\"background:red;color:white;cursor:pointer;\""
-          " onclick=\""
-          "if(confirm('This action will attempt to open contactors on the battery. Are you "
-          "sure?')) { estop(true); }\""
-          ">Open Contactors</button><br/>";
-    else
-      content +=
-          "<br/><button style=\"background:green;color:white;cursor:pointer;\""
-          "20px;font-size:16px;font-weight:bold;cursor:pointer;border-radius:5px; margin:10px;"
-          " onclick=\""
-          "if(confirm('This action will attempt to close contactors and enable power transfer. Are you sure?')) { "
-          "estop(false); }\""
-          ">Close Contactors</button><br/>";
-    content += "<script>";
-    content += "function OTA() { window.location.href = '/update'; }";
-    content += "function Cellmon() { window.location.href = '/cellmonitor'; }";
-    content += "function Settings() { window.location.href = '/settings'; }";
-    content += "function Advanced() { window.location.href = '/advanced'; }";
-    content += "function CANlog() { window.location.href = '/canlog'; }";
-    content += "function CANreplay() { window.location.href = '/canreplay'; }";
-    content += "function Log() { window.location.href = '/log'; }";
-    content += "function Events() { window.location.href = '/events'; }";
-    if (webserver_auth) {
-      content += "function logout() {";
-      content += "  window.location.href = '/logout';";
-      content += "}";
-    }
-    content += "function PauseBattery(pause){";
-    content +=
-        "var xhr=new "
-        "XMLHttpRequest();xhr.onload=function() { "
-        "window.location.reload();};xhr.open('GET','/pause?value='+pause,true);xhr.send();";
-    content += "}";
-    content += "function estop(stop){";
+// Control buttons and their scripts
+static void status_page_controls(String& content) {
+  if (emulator_pause_request_ON)
+    content += "<button onclick='PauseBattery(false)'>Resume charge/discharge</button> ";
+  else
     content +=
-        "var xhr=new "
-        "XMLHttpRequest();xhr.onload=function() { "
-        "window.location.reload();};xhr.open('GET','/equipmentStop?value='+stop,true);xhr.send();";
-    content += "}";
-    content += "</script>";
-
-    //Script for refreshing page
-    content += "<script>";
-    content += "setTimeout(function(){ location.reload(true); }, 15000);";
-    content += "</script>";
-
-    // In-UI update notification (browser-side; skips dev builds, 6h cached) - issue #1660
-    content += "<script>";
-    content += "(function(){var cur='" + String(version_number) + "';";
-    content += "if(cur.indexOf('dev')>=0)return;";
-    content += "var el=document.getElementById('bxUpd');if(!el)return;";
-    content += "function p(v){return v.replace(/^v/,'').split('.').map(function(x){return parseInt(x,10)||0;});}";
-    content +=
-        "function nw(a,b){for(var i=0;i<Math.max(a.length,b.length);i++){var x=a[i]||0,y=b[i]||0;if(x>y)return "
-        "true;if(x<y)return false;}return false;}";
+        "<button onclick=\"if(confirm('Are you sure you want to pause charging and discharging? This will set the "
+        "maximum charge and discharge values to zero, preventing any further power flow.')) { PauseBattery(true); "
+        "}\">Pause charge/discharge</button> ";
+
+  content += "<button onclick='OTA()'>Perform OTA update</button> ";
+  content += "<button onclick='Settings()'>Change Settings</button> ";
+  content += "<button onclick='Advanced()'>More Battery Info</button> ";
+  content += "<button onclick='CANlog()'>CAN logger</button> ";
+  content += "<button onclick='CANreplay()'>CAN replay</button> ";
+  if (datalayer.system.info.web_logging_active || datalayer.system.info.SD_logging_active) {
+    content += "<button onclick='Log()'>Log</button> ";
+  }
+  content += "<button onclick='Cellmon()'>Cellmonitor</button> ";
+  content += "<button onclick='Events()'>Events</button> ";
+  content += "<button onclick='askReboot()'>Reboot Emulator</button> ";
+  if (webserver_auth)
+    content += "<button onclick='logout()'>Logout</button>";
+  if (!datalayer.system.info.equipment_stop_active)
     content +=
-        "function show(t,u){if(nw(p(t),p(cur)))el.innerHTML=\"<a href='\"+u+\"' target='_blank' "
-        "style='display:inline-block;margin:2px 0 10px;padding:8px 16px;background:#505E67;border:1px solid "
-        "#4caf50;border-radius:10px;color:#fff;font-weight:bold;text-decoration:none'>&#128276; New version \"+t+\" "
-        "available &rarr;</a>\";}";
-    content += "var c=null;try{c=JSON.parse(localStorage.getItem('beUpd'));}catch(e){}var now=Date.now();";
-    content += "if(c&&c.t&&(now-c.t)<21600000){show(c.tag,c.url);return;}";
+        "<br/><button style=\"background:red;color:white;cursor:pointer;\""
+        " onclick=\""
+        "if(confirm('This action will attempt to open contactors on the battery. Are you "
+        "sure?')) { estop(true); }\""
+        ">Open Contactors</button><br/>";
+  else
     content +=
-        "fetch('https://api.github.com/repos/dalathegreat/Battery-Emulator/releases/latest')."
-        "then(function(r){return r.json();}).then(function(d){if(!d||!d.tag_name)return;"
-        "try{localStorage.setItem('beUpd',JSON.stringify({t:now,tag:d.tag_name,url:d.html_url}));}catch(e){}"
-        "show(d.tag_name,d.html_url);}).catch(function(){});";
-    content += "})();";
-    content += "</script>";
-
-    return content;
+        "<br/><button style=\"background:green;color:white;cursor:pointer;\""
+        "20px;font-size:16px;font-weight:bold;cursor:pointer;border-radius:5px; margin:10px;"
+        " onclick=\""
+        "if(confirm('This action will attempt to close contactors and enable power transfer. Are you sure?')) { "
+        "estop(false); }\""
+        ">Close Contactors</button><br/>";
+  content += "<script>";
+  content += "function OTA() { window.location.href = '/update'; }";
+  content += "function Cellmon() { window.location.href = '/cellmonitor'; }";
+  content += "function Settings() { window.location.href = '/settings'; }";
+  content += "function Advanced() { window.location.href = '/advanced'; }";
+  content += "function CANlog() { window.location.href = '/canlog'; }";
+  content += "function CANreplay() { window.location.href = '/canreplay'; }";
+  content += "function Log() { window.location.href = '/log'; }";
+  content += "function Events() { window.location.href = '/events'; }";
+  if (webserver_auth) {
+    content += "function logout() {";
+    content += "  window.location.href = '/logout';";
+    content += "}";
   }
-  return String();
+  content += "function PauseBattery(pause){";
+  content +=
+      "var xhr=new "
+      "XMLHttpRequest();xhr.onload=function() { "
+      "window.location.reload();};xhr.open('GET','/pause?value='+pause,true);xhr.send();";
+  content += "}";
+  content += "function estop(stop){";
+  content +=
+      "var xhr=new "
+      "XMLHttpRequest();xhr.onload=function() { "
+      "window.location.reload();};xhr.open('GET','/equipmentStop?value='+stop,true);xhr.send();";
+  content += "}";
+  content += "</script>";
+
+  //Script for refreshing page
+  content += "<script>";
+  content += "setTimeout(function(){ location.reload(true); }, 15000);";
+  content += "</script>";
+
+  // In-UI update notification (browser-side; skips dev builds, 6h cached) - issue #1660
+  content += "<script>";
+  content += "(function(){var cur='" + String(version_number) + "';";
+  content += "if(cur.indexOf('dev')>=0)return;";
+  content += "var el=document.getElementById('bxUpd');if(!el)return;";
+  content += "function p(v){return v.replace(/^v/,'').split('.').map(function(x){return parseInt(x,10)||0;});}";
+  content +=
+      "function nw(a,b){for(var i=0;i<Math.max(a.length,b.length);i++){var x=a[i]||0,y=b[i]||0;if(x>y)return "
+      "true;if(x<y)return false;}return false;}";
+  content +=
+      "function show(t,u){if(nw(p(t),p(cur)))el.innerHTML=\"<a href='\"+u+\"' target='_blank' "
+      "style='display:inline-block;margin:2px 0 10px;padding:8px 16px;background:#505E67;border:1px solid "
+      "#4caf50;border-radius:10px;color:#fff;font-weight:bold;text-decoration:none'>&#128276; New version \"+t+\" "
+      "available &rarr;</a>\";}";
+  content += "var c=null;try{c=JSON.parse(localStorage.getItem('beUpd'));}catch(e){}var now=Date.now();";
+  content += "if(c&&c.t&&(now-c.t)<21600000){show(c.tag,c.url);return;}";
+  content +=
+      "fetch('https://api.github.com/repos/dalathegreat/Battery-Emulator/releases/latest')."
+      "then(function(r){return r.json();}).then(function(d){if(!d||!d.tag_name)return;"
+      "try{localStorage.setItem('beUpd',JSON.stringify({t:now,tag:d.tag_name,url:d.html_url}));}catch(e){}"
+      "show(d.tag_name,d.html_url);}).catch(function(){});";
+  content += "})();";
+  content += "</script>";
+}
+
+void status_page_sections(HtmlChunkedPage& page) {
+  page.section(status_page_system_info)
+      .section(status_page_equipment)
+      .section(status_page_batteries)
+      .section(status_page_contactors)
+      .section(status_page_charger)
+      .section(status_page_controls);
 }
 
 void onOTAStart() {
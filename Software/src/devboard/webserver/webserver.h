@@ -7,11 +7,13 @@
 #include "../../lib/ESP32Async-ESPAsyncWebServer/src/ESPAsyncWebServer.h"
 #include "../../lib/ayushsharma82-ElegantOTA/src/ElegantOTA.h"
 #include "../../lib/mathieucarbou-AsyncTCPSock/src/AsyncTCP.h"
+#include "html_chunked_page.h"
 
 extern const char* version_number;  // The current software version, shown on webserver
 extern std::string http_username;
 extern std::string http_password;
 extern bool webserver_auth;
+extern uint16_t web_push_interval_ms;  // Shortest time between /api/v1/events updates, 0 disables them
 
 // Common charger parameters
 extern float charger_stat_HVcur;
@@ -55,13 +57,11 @@ void init_webserver();
 void init_ElegantOTA();
 
 /**
- * @brief Replaces placeholder with content section in web page
+ * @brief Adds the sections of the status page, streamed in place of %X% in index_html
  *
- * @param[in] var
- *
- * @return String
+ * @param[in] page
  */
-String processor(const String& var);
+void status_page_sections(HtmlChunkedPage& page);
 String get_firmware_info_processor(const String& var);
 
 /**
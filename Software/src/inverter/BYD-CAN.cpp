@@ -101,7 +101,7 @@ void BydCanInverter::
   BYD_250.data.u8[5] = (uint8_t)(datalayer.battery.info.reported_total_capacity_Wh / 100);
 }
 
-void BydCanInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void BydCanInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x151:  //Message originating from BYD HVS compatible inverter. Reply with CAN identifier!
       inverterStartedUp = true;
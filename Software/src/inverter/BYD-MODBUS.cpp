@@ -28,35 +28,29 @@ void BydModbusInverter::handle_static_data() {
   static uint16_t* data_array_pointers[] = {si_data, byd_data, battery_data, volt_data, serial_data, static_data};
   static uint16_t data_sizes[] = {sizeof(si_data),   sizeof(byd_data),    sizeof(battery_data),
                                   sizeof(volt_data), sizeof(serial_data), sizeof(static_data)};
-  static uint16_t i = 100;
+  uint16_t addr = 100;
   for (uint8_t arr_idx = 0; arr_idx < sizeof(data_array_pointers) / sizeof(uint16_t*); arr_idx++) {
-    uint16_t data_size = data_sizes[arr_idx];
-    for (int j = 0; j < data_size / sizeof(uint16_t); j++) {
-      mbPV[i + j] = data_array_pointers[arr_idx][j];
-    }
-    i += data_size / sizeof(uint16_t);
+    uint16_t words = data_sizes[arr_idx] / sizeof(uint16_t);
+    mbPV.write(addr, words, data_array_pointers[arr_idx]);
+    addr += words;
   }
   static uint16_t init_p201[13] = {0, 0, 0, MAX_POWER, MAX_POWER, 0, 0, 53248, 10, 53248, 10, 0, 0};
-  for (int i = 0; i < sizeof(init_p201) / sizeof(uint16_t); i++) {
-    mbPV[200 + i] = init_p201[i];
-  }
+  mbPV.write(200, sizeof(init_p201) / sizeof(uint16_t), init_p201);
   static uint16_t init_p301[24] = {0,  0,  128, 0, 0,  0,     0, 0, 0,  2000,  0,   2000,
                                    75, 95, 0,   0, 16, 22741, 0, 0, 13, 52064, 230, 9900};
-  for (int i = 0; i < sizeof(init_p301) / sizeof(uint16_t); i++) {
-    mbPV[300 + i] = init_p301[i];
-  }
+  mbPV.write(300, sizeof(init_p301) / sizeof(uint16_t), init_p301);
 }
 
 void BydModbusInverter::handle_update_data_modbusp201_byd() {
-  mbPV[202] =
-      std::min(datalayer.battery.info.reported_total_capacity_Wh, static_cast<uint32_t>(57960u));  //Cap to 58kWh
+  mbPV.set(202, std::min(datalayer.battery.info.reported_total_capacity_Wh,
+                         static_cast<uint32_t>(57960u)));  //Cap to 58kWh
   if (user_selected_primo_gen24) {
-    mbPV[205] =  // Max Voltage, if higher Gen24 forces discharge, cap to 450.0V for Primo to avoid constant warning
-        std::min(datalayer.battery.info.max_design_voltage_dV, static_cast<uint16_t>(4500u));
+    // Max Voltage, if higher Gen24 forces discharge, cap to 450.0V for Primo to avoid constant warning
+    mbPV.set(205, std::min(datalayer.battery.info.max_design_voltage_dV, static_cast<uint16_t>(4500u)));
   } else {  //Symo inverter which can take up to 700V, so we can use the real max voltage of the battery without capping
-    mbPV[205] = datalayer.battery.info.max_design_voltage_dV;
+    mbPV.set(205, datalayer.battery.info.max_design_voltage_dV);
   }
-  mbPV[206] = (datalayer.battery.info.min_design_voltage_dV);  // Min Voltage, if lower Gen24 disables battery
+  mbPV.set(206, (datalayer.battery.info.min_design_voltage_dV));  // Min Voltage, if lower Gen24 disables battery
 }
 
 void BydModbusInverter::handle_update_data_modbusp301_byd() {
@@ -80,37 +74,37 @@ void BydModbusInverter::handle_update_data_modbusp301_byd() {
   max_charge_W = std::min(datalayer.battery.status.max_charge_power_W, user_configured_max_charge_W);
 
   if (datalayer.system.status.system_status == ACTIVE) {
-    mbPV[308] = datalayer.battery.status.voltage_dV;
+    mbPV.set(308, datalayer.battery.status.voltage_dV);
   } else {
-    mbPV[308] = 0;
+    mbPV.set(308, 0);
   }
-  mbPV[300] = datalayer.system.status.system_status;
-  mbPV[302] = 128 + bms_char_dis_status;
+  mbPV.set(300, datalayer.system.status.system_status);
+  mbPV.set(302, 128 + bms_char_dis_status);
   if (datalayer.battery.status.reported_soc < 100) {
-    mbPV[303] = 100;  //Force SOC to never go below 1% to avoid overdischarge
+    mbPV.set(303, 100);  //Force SOC to never go below 1% to avoid overdischarge
   } else {
-    mbPV[303] = datalayer.battery.status.reported_soc;
+    mbPV.set(303, datalayer.battery.status.reported_soc);
   }
   if (battery2) {
-    mbPV[304] = std::min(datalayer.battery.info.total_capacity_Wh + datalayer.battery2.info.total_capacity_Wh,
-                         static_cast<uint32_t>(57960u));  //Cap to 58kWh
+    mbPV.set(304, std::min(datalayer.battery.info.total_capacity_Wh + datalayer.battery2.info.total_capacity_Wh,
+                           static_cast<uint32_t>(57960u)));  //Cap to 58kWh
   } else {
-    mbPV[304] = std::min(datalayer.battery.info.total_capacity_Wh, static_cast<uint32_t>(57960u));  //Cap to 58kWh
+    mbPV.set(304, std::min(datalayer.battery.info.total_capacity_Wh, static_cast<uint32_t>(57960u)));  //Cap to 58kWh
   }
   if (battery2) {
-    mbPV[305] = std::min(datalayer.battery.status.reported_remaining_capacity_Wh +
-                             datalayer.battery2.status.reported_remaining_capacity_Wh,
-                         static_cast<uint32_t>(57960u));  //Cap to 58kWh
+    mbPV.set(305, std::min(datalayer.battery.status.reported_remaining_capacity_Wh +
+                               datalayer.battery2.status.reported_remaining_capacity_Wh,
+                           static_cast<uint32_t>(57960u)));  //Cap to 58kWh
   } else {
-    mbPV[305] = std::min(datalayer.battery.status.reported_remaining_capacity_Wh,
-                         static_cast<uint32_t>(57960u));  //Cap to 58kWh
+    mbPV.set(305, std::min(datalayer.battery.status.reported_remaining_capacity_Wh,
+                           static_cast<uint32_t>(57960u)));  //Cap to 58kWh
   }
-  mbPV[306] = std::min(max_discharge_W, static_cast<uint32_t>(30000u));  //Cap to 30000 if exceeding
-  mbPV[307] = std::min(max_charge_W, static_cast<uint32_t>(30000u));     //Cap to 30000 if exceeding
-  mbPV[310] = datalayer.battery.status.voltage_dV;
-  mbPV[312] = datalayer.battery.status.temperature_min_dC;
-  mbPV[313] = datalayer.battery.status.temperature_max_dC;
-  mbPV[323] = datalayer.battery.status.soh_pptt;
+  mbPV.set(306, std::min(max_discharge_W, static_cast<uint32_t>(30000u)));  //Cap to 30000 if exceeding
+  mbPV.set(307, std::min(max_charge_W, static_cast<uint32_t>(30000u)));     //Cap to 30000 if exceeding
+  mbPV.set(310, datalayer.battery.status.voltage_dV);
+  mbPV.set(312, datalayer.battery.status.temperature_min_dC);
+  mbPV.set(313, datalayer.battery.status.temperature_max_dC);
+  mbPV.set(323, datalayer.battery.status.soh_pptt);
 }
 
 void BydModbusInverter::verify_temperature() {
@@ -145,7 +139,7 @@ void BydModbusInverter::verify_inverter_modbus() {
 
     all_401_values_equal = true;
     for (int i = 0; i < HISTORY_LENGTH; ++i) {
-      if (register_401_history[i] != mbPV[401]) {
+      if (register_401_history[i] != mbPV.get(401)) {
         all_401_values_equal = false;
         break;
       }
@@ -158,7 +152,7 @@ void BydModbusInverter::verify_inverter_modbus() {
     }
 
     // Update history
-    register_401_history[history_index] = mbPV[401];
+    register_401_history[history_index] = mbPV.get(401);
     history_index = (history_index + 1) % HISTORY_LENGTH;
   }
 }
@@ -6,7 +6,8 @@
 
 class BydModbusInverter : public ModbusInverterProtocol {
  public:
-  BydModbusInverter() : ModbusInverterProtocol(21) {}
+  // Static info at 100-167, p201 at 200, p301 at 300 and the register the inverter writes at 401
+  BydModbusInverter() : ModbusInverterProtocol(21, {{100, 68}, {200, 16}, {300, 32}, {400, 16}}) {}
   const char* name() override { return Name; }
   bool setup() override;
   void update_values();
@@ -14,8 +14,10 @@ class CanInverterProtocol : public InverterProtocol, Transmitter, CanReceiver {
   virtual const char* interface_name() { return getCANInterfaceName(can_interface); }
   InverterInterfaceType interface_type() { return InverterInterfaceType::Can; }
 
+  // Polled every ms until the inverter schedules its frames with transmit_every(). Inverters that schedule all of
+  // their frames still implement it, empty, so an inverter that forgets to send does not compile.
   virtual void transmit_can(unsigned long currentMillis) = 0;
-  virtual void map_can_frame_to_variable(CAN_frame rx_frame) = 0;
+  virtual void map_can_frame_to_variable(const CAN_frame& rx_frame) = 0;
 
   void transmit(unsigned long currentMillis) {
     if (allowed_to_send_CAN) {
@@ -23,7 +25,9 @@ class CanInverterProtocol : public InverterProtocol, Transmitter, CanReceiver {
     }
   }
 
-  void receive_can_frame(CAN_frame* frame) { map_can_frame_to_variable(*frame); }
+  bool transmit_allowed() { return allowed_to_send_CAN; }
+
+  void receive_can_frame(const CAN_frame& frame) { map_can_frame_to_variable(frame); }
 
  protected:
   CAN_Interface can_interface;
@@ -39,7 +43,17 @@ class CanInverterProtocol : public InverterProtocol, Transmitter, CanReceiver {
     logging.println(")");
   }
 
-  void transmit_can_frame(CAN_frame* frame) { transmit_can_frame_to_interface(frame, can_interface); }
+  // Inverter frames report limits and values unless the caller marks them otherwise
+  void transmit_can_frame(CAN_frame* frame, CAN_Tx_Priority priority = CAN_TX_PRIORITY_AUTO) {
+    transmit_can_frame_to_interface(
+        frame, can_interface, priority == CAN_TX_PRIORITY_AUTO ? can_tx_priority_for(*frame, CAN_TX_LIMITS) : priority);
+  }
+
+  using Transmitter::transmit_every;
+  // Send frame as it is every period_ms
+  void transmit_every(uint16_t period_ms, CAN_frame* frame) {
+    transmit_every(period_ms, 1, [this, frame](unsigned long currentMillis) { transmit_can_frame(frame); });
+  }
 };
 
 #endif
@@ -8,7 +8,8 @@
 #define RS485_DE_PIN -1
 #endif
 // Creates a ModbusRTU server instance with 2000ms timeout
-ModbusInverterProtocol::ModbusInverterProtocol(int serverId) : MBserver(2000, RS485_DE_PIN) {
+ModbusInverterProtocol::ModbusInverterProtocol(int serverId, std::initializer_list<Modbus_Register_Window> windows)
+    : mbPV(windows), MBserver(2000, RS485_DE_PIN) {
   _serverId = serverId;
 
   MBserver.registerWorker(_serverId, READ_HOLD_REGISTER,
@@ -36,6 +37,12 @@ ModbusMessage ModbusInverterProtocol::FC03(ModbusMessage request) {
   request.get(2, addr);    // read address from request
   request.get(4, words);   // read # of words from request
 
+  // # of registers proper?
+  if (words > 125) {  // can't fit more than this in the response packet
+    response.setError(request.getServerID(), request.getFunctionCode(), ILLEGAL_DATA_VALUE);
+    logging.printf("Modbus FC03 error: bad registers addr=%d words=%d\n", addr, words);
+    return response;
+  }
   // Address overflow?
   if ((addr + words) > MBPV_MAX) {
     // Yes - send respective error response
@@ -44,12 +51,11 @@ ModbusMessage ModbusInverterProtocol::FC03(ModbusMessage request) {
     return response;
   }
 
-  // Set up response
+  // Set up response, the registers are copied as one block
+  uint8_t data[250];
+  mbPV.read_be(addr, words, data);
   response.add(request.getServerID(), request.getFunctionCode(), (uint8_t)(words * 2));
-  for (uint8_t i = 0; i < words; ++i) {
-    // send increasing data values
-    response.add((uint16_t)(mbPV[addr + i]));
-  }
+  response.add(data, words * 2);
 
   return response;
 }
@@ -71,10 +77,10 @@ ModbusMessage ModbusInverterProtocol::FC06(ModbusMessage request) {
   }
 
   // Do the write
-  mbPV[addr] = val;
+  mbPV.set(addr, val);
 
   // Set up response
-  response.add(request.getServerID(), request.getFunctionCode(), mbPV[addr]);
+  response.add(request.getServerID(), request.getFunctionCode(), mbPV.get(addr));
   return response;
 }
 
@@ -84,15 +90,15 @@ ModbusMessage ModbusInverterProtocol::FC16(ModbusMessage request) {
   uint16_t addr = 0;       // Start address
   uint16_t words = 0;      // total words to write
   uint8_t bytes = 0;       // # of data bytes in request
-  uint16_t val = 0;        // value to be written
   request.get(2, addr);    // read address from request
   request.get(4, words);   // read # of words from request
   request.get(6, bytes);   // read # of data bytes from request (seems redundant with # of words)
 
   // # of registers proper?
-  if ((bytes != (words * 2))  // byte count in request must match # of words in request
-      || (words > 123))       // can't support more than this in request packet
-  {                           // Yes - send respective error response
+  if ((bytes != (words * 2))            // byte count in request must match # of words in request
+      || (words > 123)                  // can't support more than this in request packet
+      || (request.size() < 7 + bytes))  // data must actually be there
+  {                                     // Yes - send respective error response
     response.setError(request.getServerID(), request.getFunctionCode(), ILLEGAL_DATA_VALUE);
     logging.printf("Modbus FC16 error: bad registers addr=%d words=%d bytes=%d\n", addr, words, bytes);
     return response;
@@ -105,11 +111,8 @@ ModbusMessage ModbusInverterProtocol::FC16(ModbusMessage request) {
     return response;
   }
 
-  // Do the writes
-  for (uint8_t i = 0; i < words; ++i) {
-    request.get(7 + (i * 2), val);  //data starts at byte 6 in request packet
-    mbPV[addr + i] = val;
-  }
+  // Do the writes, data starts at byte 7 in request packet
+  mbPV.write_be(addr, words, request.data() + 7);
 
   // Set up response
   response.add(request.getServerID(), request.getFunctionCode(), addr, words);
@@ -124,7 +127,6 @@ ModbusMessage ModbusInverterProtocol::FC23(ModbusMessage request) {
   uint16_t write_addr = 0;       // Start address for write
   uint16_t write_words = 0;      // total words to write
   uint8_t write_bytes = 0;       // # of data bytes in write request
-  uint16_t write_val = 0;        // value to be written
   request.get(2, read_addr);     // read address from request
   request.get(4, read_words);    // read # of words from request
   request.get(6, write_addr);    // read address from request
@@ -133,10 +135,11 @@ ModbusMessage ModbusInverterProtocol::FC23(ModbusMessage request) {
 
   // ERROR CHECKS
   // # of registers proper?
-  if ((write_bytes != (write_words * 2))  // byte count in request must match # of words in request
-      || (write_words > 121)              // can't fit more than this in the packet for FC23
-      || (read_words > 125))              // can't fit more than this in the response packet
-  {                                       // Yes - send respective error response
+  if ((write_bytes != (write_words * 2))        // byte count in request must match # of words in request
+      || (write_words > 121)                    // can't fit more than this in the packet for FC23
+      || (read_words > 125)                     // can't fit more than this in the response packet
+      || (request.size() < 11 + write_bytes))  // data must actually be there
+  {                                             // Yes - send respective error response
     response.setError(request.getServerID(), request.getFunctionCode(), ILLEGAL_DATA_VALUE);
     logging.printf("Modbus FC23 error: bad registers write_addr=%d write_words=%d write_bytes=%d read_words=%d\n",
                    write_addr, write_words, write_bytes, read_words);
@@ -152,19 +155,15 @@ ModbusMessage ModbusInverterProtocol::FC23(ModbusMessage request) {
   }
 
   //WRITE SECTION  - write is done before read for FC23
-  // Do the writes
-  for (uint8_t i = 0; i < write_words; ++i) {
-    request.get(11 + (i * 2), write_val);  //data starts at byte 6 in request packet
-    mbPV[write_addr + i] = write_val;
-  }
+  // Do the writes, data starts at byte 11 in request packet
+  mbPV.write_be(write_addr, write_words, request.data() + 11);
 
   // READ SECTION
   // Set up response
+  uint8_t data[250];
+  mbPV.read_be(read_addr, read_words, data);
   response.add(request.getServerID(), request.getFunctionCode(), (uint8_t)(read_words * 2));
-  for (uint8_t i = 0; i < read_words; ++i) {
-    // send increasing data values
-    response.add((uint16_t)(mbPV[read_addr + i]));
-  }
+  response.add(data, read_words * 2);
 
   return response;
 }
@@ -4,11 +4,11 @@
 #include "../lib/eModbus-eModbus/ModbusMessage.h"
 #include "../lib/eModbus-eModbus/ModbusServerRTU.h"
 #include "InverterProtocol.h"
+#include "ModbusRegisterFile.h"
 
 #include <HardwareSerial.h>
 
 #include <stdint.h>
-#include <map>
 
 // The abstract base class for all Modbus inverter protocols
 class ModbusInverterProtocol : public InverterProtocol {
@@ -16,7 +16,8 @@ class ModbusInverterProtocol : public InverterProtocol {
   InverterInterfaceType interface_type() { return InverterInterfaceType::Modbus; }
 
  protected:
-  ModbusInverterProtocol(int serverId);
+  // windows are the register ranges the protocol serves, see ModbusRegisterFile
+  ModbusInverterProtocol(int serverId, std::initializer_list<Modbus_Register_Window> windows = {});
   ~ModbusInverterProtocol();
 
   ModbusMessage FC03(ModbusMessage request);
@@ -29,7 +30,7 @@ class ModbusInverterProtocol : public InverterProtocol {
   // The Modbus server ID we respond to
   int _serverId;
   // The Modbus registers themselves
-  std::map<uint16_t, uint16_t> mbPV;
+  ModbusRegisterFile mbPV;
 
   ModbusServerRTU MBserver;
 };
@@ -0,0 +1,160 @@
+#include "ModbusRegisterFile.h"
+
+#include <string.h>
+
+ModbusRegisterFile::ModbusRegisterFile(std::initializer_list<Modbus_Register_Window> windows) {
+  uint16_t used = 0;
+  for (const auto& range : windows) {
+    if (this->windows == MODBUS_REGISTER_WINDOWS_MAX || used == MODBUS_REGISTER_FILE_SIZE) {
+      break;
+    }
+    uint32_t count = range.count;
+    count = count < (uint32_t)(MODBUS_REGISTER_FILE_SIZE - used) ? count : MODBUS_REGISTER_FILE_SIZE - used;
+    count = count < 0x10000u - range.first ? count : 0x10000u - range.first;
+    bool overlaps = false;
+    for (int i = 0; i < this->windows; i++) {
+      const Modbus_Register_Window& other = layout[i].range;
+      overlaps |= range.first < (uint32_t)other.first + other.count && other.first < range.first + count;
+    }
+    if (count == 0 || overlaps) {
+      continue;
+    }
+
+    Window& w = layout[this->windows++];
+    w.range.first = range.first;
+    w.range.count = count;
+    w.offset = used;
+    w.dirty = false;
+    used += count;
+  }
+}
+
+int ModbusRegisterFile::find(uint32_t address, uint32_t count) const {
+  for (int i = 0; i < windows; i++) {
+    const Window& w = layout[i];
+    if (address >= w.range.first && address + count <= (uint32_t)w.range.first + w.range.count) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void ModbusRegisterFile::mark_dirty(Window& w, uint16_t first, uint16_t last) {
+  if (!w.dirty) {
+    w.dirty_first = first;
+    w.dirty_last = last;
+    w.dirty = true;
+    return;
+  }
+  if (first < w.dirty_first) {
+    w.dirty_first = first;
+  }
+  if (last > w.dirty_last) {
+    w.dirty_last = last;
+  }
+}
+
+uint16_t ModbusRegisterFile::get(uint16_t address) const {
+  int i = find(address, 1);
+  if (i >= 0) {
+    return registers[layout[i].offset + address - layout[i].range.first];
+  }
+  auto it = sparse.find(address);
+  return it == sparse.end() ? 0 : it->second;
+}
+
+void ModbusRegisterFile::set(uint16_t address, uint16_t value) {
+  int i = find(address, 1);
+  if (i < 0) {
+    sparse[address] = value;
+    return;
+  }
+  uint16_t& reg = registers[layout[i].offset + address - layout[i].range.first];
+  if (reg != value) {
+    reg = value;
+    mark_dirty(layout[i], address, address);
+  }
+}
+
+void ModbusRegisterFile::read(uint16_t address, uint16_t count, uint16_t* values) const {
+  int i = find(address, count);
+  if (i >= 0) {
+    memcpy(values, &registers[layout[i].offset + address - layout[i].range.first], count * sizeof(uint16_t));
+    return;
+  }
+  // Spans a window boundary or lies outside the windows
+  for (uint16_t n = 0; n < count; n++) {
+    values[n] = get(address + n);
+  }
+}
+
+void ModbusRegisterFile::write(uint16_t address, uint16_t count, const uint16_t* values) {
+  int i = find(address, count);
+  if (i < 0) {
+    for (uint16_t n = 0; n < count; n++) {
+      set(address + n, values[n]);
+    }
+    return;
+  }
+
+  uint16_t* regs = &registers[layout[i].offset + address - layout[i].range.first];
+  uint16_t first = 0;
+  while (first < count && regs[first] == values[first]) {
+    first++;
+  }
+  if (first == count) {
+    return;
+  }
+  uint16_t last = count - 1;
+  while (regs[last] == values[last]) {
+    last--;
+  }
+  memcpy(regs + first, values + first, (last - first + 1) * sizeof(uint16_t));
+  mark_dirty(layout[i], address + first, address + last);
+}
+
+void ModbusRegisterFile::read_be(uint16_t address, uint16_t count, uint8_t* bytes) const {
+  int i = find(address, count);
+  const uint16_t* regs = i >= 0 ? &registers[layout[i].offset + address - layout[i].range.first] : nullptr;
+  for (uint16_t n = 0; n < count; n++) {
+    uint16_t value = regs ? regs[n] : get(address + n);
+    bytes[n * 2] = value >> 8;
+    bytes[n * 2 + 1] = value & 0xFF;
+  }
+}
+
+void ModbusRegisterFile::write_be(uint16_t address, uint16_t count, const uint8_t* bytes) {
+  int i = find(address, count);
+  if (i < 0) {
+    for (uint16_t n = 0; n < count; n++) {
+      set(address + n, (bytes[n * 2] << 8) | bytes[n * 2 + 1]);
+    }
+    return;
+  }
+
+  uint16_t* regs = &registers[layout[i].offset + address - layout[i].range.first];
+  int32_t first = -1, last = -1;
+  for (uint16_t n = 0; n < count; n++) {
+    uint16_t value = (bytes[n * 2] << 8) | bytes[n * 2 + 1];
+    if (regs[n] != value) {
+      regs[n] = value;
+      if (first < 0) {
+        first = n;
+      }
+      last = n;
+    }
+  }
+  if (first >= 0) {
+    mark_dirty(layout[i], address + first, address + last);
+  }
+}
+
+bool ModbusRegisterFile::take_dirty(uint8_t window, uint16_t& first, uint16_t& last) {
+  if (window >= windows || !layout[window].dirty) {
+    return false;
+  }
+  first = layout[window].dirty_first;
+  last = layout[window].dirty_last;
+  layout[window].dirty = false;
+  return true;
+}
@@ -0,0 +1,69 @@
+#ifndef MODBUS_REGISTER_FILE_H
+#define MODBUS_REGISTER_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <initializer_list>
+#include <map>
+
+// Registers that can be kept in flat windows, shared by all windows of a register file
+#define MODBUS_REGISTER_FILE_SIZE 256
+#define MODBUS_REGISTER_WINDOWS_MAX 8
+
+typedef struct {
+  /** First register address of the window */
+  uint16_t first;
+  /** Amount of registers in the window */
+  uint16_t count;
+} Modbus_Register_Window;
+
+// Holding registers of a Modbus server. The address ranges a protocol serves are declared up front and laid out back
+// to back in one flat array, so a block read or write inside a window is a single copy without lookups or heap use.
+// Addresses outside the windows still work, they are kept in a sparse map like all registers used to be.
+// Each window tracks the span of registers whose value changed since it was last taken.
+class ModbusRegisterFile {
+ public:
+  // Windows that do not fit in MODBUS_REGISTER_FILE_SIZE, or beyond MODBUS_REGISTER_WINDOWS_MAX, are clipped
+  ModbusRegisterFile(std::initializer_list<Modbus_Register_Window> windows = {});
+
+  uint16_t get(uint16_t address) const;
+  void set(uint16_t address, uint16_t value);
+
+  // Copy count registers starting at address
+  void read(uint16_t address, uint16_t count, uint16_t* values) const;
+  void write(uint16_t address, uint16_t count, const uint16_t* values);
+
+  // Same as read/write, with every register as two big-endian bytes like in a Modbus PDU
+  void read_be(uint16_t address, uint16_t count, uint8_t* bytes) const;
+  void write_be(uint16_t address, uint16_t count, const uint8_t* bytes);
+
+  // Get the lowest and highest changed register address of a window and clear its dirty span.
+  // Returns false if nothing in the window changed.
+  bool take_dirty(uint8_t window, uint16_t& first, uint16_t& last);
+
+  uint8_t window_count() const { return windows; }
+  const Modbus_Register_Window& window(uint8_t index) const { return layout[index].range; }
+  // Amount of registers stored outside the windows
+  size_t sparse_count() const { return sparse.size(); }
+
+ private:
+  typedef struct {
+    Modbus_Register_Window range;
+    /** Index of the first register of the window in registers[] */
+    uint16_t offset;
+    uint16_t dirty_first;
+    uint16_t dirty_last;
+    bool dirty;
+  } Window;
+
+  // Index of the window holding all of [address, address + count), or -1
+  int find(uint32_t address, uint32_t count) const;
+  void mark_dirty(Window& w, uint16_t first, uint16_t last);
+
+  Window layout[MODBUS_REGISTER_WINDOWS_MAX];
+  uint8_t windows = 0;
+  uint16_t registers[MODBUS_REGISTER_FILE_SIZE] = {0};
+  std::map<uint16_t, uint16_t> sparse;
+};
+
+#endif
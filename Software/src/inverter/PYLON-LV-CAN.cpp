@@ -112,7 +112,7 @@ void PylonLvInverter::update_values() {
   // PYLON_35E is pre-filled with the manufacturer name
 }
 
-void PylonLvInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void PylonLvInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x305:  //Message originating from inverter.
       // according to the spec, this message includes only 0-bytes
@@ -123,16 +123,14 @@ void PylonLvInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
   }
 }
 
-void PylonLvInverter::transmit_can(unsigned long currentMillis) {
-
-  if (currentMillis - previousMillis1000ms >= 1000) {
-    previousMillis1000ms = currentMillis;
-
+bool PylonLvInverter::setup() {
+  transmit_every(INTERVAL_1_S, 6, [this](unsigned long currentMillis) {
     transmit_can_frame(&PYLON_351);
     transmit_can_frame(&PYLON_355);
     transmit_can_frame(&PYLON_356);
     transmit_can_frame(&PYLON_359);
     transmit_can_frame(&PYLON_35C);
     transmit_can_frame(&PYLON_35E);
-  }
+  });
+  return true;
 }
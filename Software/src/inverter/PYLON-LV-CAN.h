@@ -7,8 +7,10 @@ class PylonLvInverter : public CanInverterProtocol {
  public:
   const char* name() override { return Name; }
   void update_values();
-  void transmit_can(unsigned long currentMillis);
-  void map_can_frame_to_variable(CAN_frame rx_frame);
+  bool setup() override;
+  // All frames are scheduled with transmit_every() in setup()
+  void transmit_can(unsigned long currentMillis) {}
+  void map_can_frame_to_variable(const CAN_frame& rx_frame);
   static constexpr const char* Name = "Pylontech LV battery over CAN bus";
 
  private:
@@ -23,7 +25,6 @@ class PylonLvInverter : public CanInverterProtocol {
 
   static constexpr const char* MANUFACTURER_NAME = "BatEmuLV";
 
-  unsigned long previousMillis1000ms = 0;
 
   CAN_frame PYLON_351 = {.FD = false,
                          .ext_ID = false,
@@ -184,7 +184,7 @@ void SchneiderInverter::
   SE_320.data.u8[1] = 0x02;
 }
 
-void SchneiderInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SchneiderInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x310:  // Still alive message from inverter, every 1s
       datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE;
@@ -194,33 +194,28 @@ void SchneiderInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
   }
 }
 
-void SchneiderInverter::transmit_can(unsigned long currentMillis) {
-
+bool SchneiderInverter::setup() {
   // Send 500ms CAN Message
-  if (currentMillis - previousMillis500ms >= INTERVAL_500_MS) {
-    previousMillis500ms = currentMillis;
-
+  transmit_every(INTERVAL_500_MS, 5, [this](unsigned long currentMillis) {
     transmit_can_frame(&SE_321);
     transmit_can_frame(&SE_322);
     transmit_can_frame(&SE_323);
     transmit_can_frame(&SE_324);
     transmit_can_frame(&SE_325);
-  }
+  });
   // Send 2s CAN Message
-  if (currentMillis - previousMillis2s >= INTERVAL_2_S) {
-    previousMillis2s = currentMillis;
-
+  transmit_every(INTERVAL_2_S, 3, [this](unsigned long currentMillis) {
     transmit_can_frame(&SE_320);
     transmit_can_frame(&SE_326);
     transmit_can_frame(&SE_327);
-  }
+  });
   // Send 10s CAN Message
-  if (currentMillis - previousMillis10s >= INTERVAL_10_S) {
-    previousMillis10s = currentMillis;
+  transmit_every(INTERVAL_10_S, 5, [this](unsigned long currentMillis) {
     transmit_can_frame(&SE_328);
     transmit_can_frame(&SE_330);
     transmit_can_frame(&SE_331);
     transmit_can_frame(&SE_332);
     transmit_can_frame(&SE_333);
-  }
+  });
+  return true;
 }
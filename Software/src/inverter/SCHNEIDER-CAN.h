@@ -7,8 +7,10 @@ class SchneiderInverter : public CanInverterProtocol {
  public:
   const char* name() override { return Name; }
   void update_values();
-  void transmit_can(unsigned long currentMillis);
-  void map_can_frame_to_variable(CAN_frame rx_frame);
+  bool setup() override;
+  // All frames are scheduled with transmit_every() in setup()
+  void transmit_can(unsigned long currentMillis) {}
+  void map_can_frame_to_variable(const CAN_frame& rx_frame);
   static constexpr const char* Name = "Schneider V2 SE BMS CAN";
 
  private:
@@ -35,10 +37,6 @@ class SchneiderInverter : public CanInverterProtocol {
   static const int COMMAND_CHARGE_AND_DISCHARGE_ALLOWED = 0x06;
   static const int COMMAND_STOP = 0x08;
 
-  unsigned long previousMillis10s = 0;    // will store last time a 10s CAN Message was send
-  unsigned long previousMillis2s = 0;     // will store last time a 2s CAN Message was send
-  unsigned long previousMillis500ms = 0;  // will store last time a 500ms CAN Message was send
-
   CAN_frame SE_320 = {.FD = false,  //SE BMS Protocol Version
                       .ext_ID = true,
                       .DLC = 2,
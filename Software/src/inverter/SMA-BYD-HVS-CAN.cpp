@@ -102,7 +102,7 @@ void SmaBydHvsInverter::
   }
 }
 
-void SmaBydHvsInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SmaBydHvsInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x360:  //Message originating from SMA inverter - Voltage and current
       datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE * 3;
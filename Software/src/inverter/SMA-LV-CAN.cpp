@@ -63,7 +63,7 @@ void SmaLvInverter::
   //TODO: Map error/warnings in 0x35A
 }
 
-void SmaLvInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SmaLvInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x305:
       datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE * 3;
@@ -85,11 +85,8 @@ void SmaLvInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
   }
 }
 
-void SmaLvInverter::transmit_can(unsigned long currentMillis) {
-
-  if (currentMillis - previousMillis100ms >= INTERVAL_100_MS) {
-    previousMillis100ms = currentMillis;
-
+bool SmaLvInverter::setup() {
+  transmit_every(INTERVAL_100_MS, 7, [this](unsigned long currentMillis) {
     transmit_can_frame(&SMA_351);
     transmit_can_frame(&SMA_355);
     transmit_can_frame(&SMA_356);
@@ -104,5 +101,6 @@ void SmaLvInverter::transmit_can(unsigned long currentMillis) {
       //After receiving this message, Sunny Island will immediately go into standby.
       //Please send start command, to start again. Manual start is also possible.
     }
-  }
+  });
+  return true;
 }
@@ -91,7 +91,7 @@ void SofarInverter::
   SOFAR_30F.data.u8[1] = enable_flags;
 }
 
-void SofarInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SofarInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x605:
     case 0x705: {
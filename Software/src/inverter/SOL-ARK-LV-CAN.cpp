@@ -87,7 +87,7 @@ void SolArkLvInverter::update_values() {
   // SOLARK_35E is pre-filled with the manufacturer name (BAT-EMU)
 }
 
-void SolArkLvInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SolArkLvInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x305:  //Message originating from inverter, signalling that data rec OK
       datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE;
@@ -97,16 +97,14 @@ void SolArkLvInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
   }
 }
 
-void SolArkLvInverter::transmit_can(unsigned long currentMillis) {
-
-  if (currentMillis - previousMillis1000ms >= INTERVAL_1_S) {
-    previousMillis1000ms = currentMillis;
-
+bool SolArkLvInverter::setup() {
+  transmit_every(INTERVAL_1_S, 6, [this](unsigned long currentMillis) {
     transmit_can_frame(&SOLARK_351);
     transmit_can_frame(&SOLARK_355);
     transmit_can_frame(&SOLARK_356);
     transmit_can_frame(&SOLARK_359);
     transmit_can_frame(&SOLARK_35C);
     transmit_can_frame(&SOLARK_35E);
-  }
+  });
+  return true;
 }
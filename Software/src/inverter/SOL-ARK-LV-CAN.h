@@ -7,12 +7,13 @@ class SolArkLvInverter : public CanInverterProtocol {
  public:
   const char* name() override { return Name; }
   void update_values();
-  void transmit_can(unsigned long currentMillis);
-  void map_can_frame_to_variable(CAN_frame rx_frame);
+  bool setup() override;
+  // All frames are scheduled with transmit_every() in setup()
+  void transmit_can(unsigned long currentMillis) {}
+  void map_can_frame_to_variable(const CAN_frame& rx_frame);
   static constexpr const char* Name = "Sol-Ark LV protocol over CAN bus";
 
  private:
-  unsigned long previousMillis1000ms = 0;
 
   const uint8_t MODULE_NUMBER = 1;  //8-bit integer representing quantity of parallel connected batteries
 
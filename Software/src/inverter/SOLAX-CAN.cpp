@@ -143,7 +143,7 @@ void solax_pack_identity_ascii(const uint8_t mac[6], uint8_t slot, uint8_t half,
   }
 }
 
-void SolaxInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SolaxInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
 
   if (rx_frame.ID == 0x1871) {
     datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE;
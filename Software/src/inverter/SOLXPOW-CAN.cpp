@@ -209,7 +209,7 @@ void SolxpowInverter::
 #endif  // Not INVERT_LOW_HIGH_BYTES
 }
 
-void SolxpowInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SolxpowInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x4200:  //Message originating from inverter. Depending on which data is required, act accordingly
       datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE;
@@ -39,7 +39,7 @@ void VCUInverter::update_values() {  //Called every 1s
   LEAF_5BC.data.u8[4] = (datalayer.battery.status.soh_pptt / 100) << 1;
 }
 
-void VCUInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void VCUInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x1F2:
       datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE;
@@ -58,11 +58,9 @@ void VCUInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
   }
 }
 
-void VCUInverter::transmit_can(unsigned long currentMillis) {
+bool VCUInverter::setup() {
   // Send 10ms CAN Message
-  if (currentMillis - previousMillis10ms >= INTERVAL_10_MS) {
-    previousMillis10ms = currentMillis;
-
+  transmit_every(INTERVAL_10_MS, 2, [this](unsigned long currentMillis) {
     mprun10 = (mprun10 + 1) % 4;  // mprun10 cycles between 0-1-2-3-0-1...
     LEAF_1DC.data.u8[6] = mprun10;
     LEAF_1DC.data.u8[7] = calculate_CRC_Nissan(&LEAF_1DC);
@@ -70,11 +68,9 @@ void VCUInverter::transmit_can(unsigned long currentMillis) {
     LEAF_1DB.data.u8[6] = mprun10;
     LEAF_1DB.data.u8[7] = calculate_CRC_Nissan(&LEAF_1DB);
     transmit_can_frame(&LEAF_1DB);
-  }
+  });
   // Send 100ms CAN Messages
-  if (currentMillis - previousMillis100ms >= INTERVAL_100_MS) {
-    previousMillis100ms = currentMillis;
-
+  transmit_every(INTERVAL_100_MS, 2, [this](unsigned long currentMillis) {
     mprun100 = (mprun100 + 1) % 4;  // mprun10 cycles between 0-1-2-3-0-1...
     counter_55B = (counter_55B + 1) % 10;
     if (counter_55B < 5) {
@@ -86,11 +82,9 @@ void VCUInverter::transmit_can(unsigned long currentMillis) {
     LEAF_55B.data.u8[7] = calculate_CRC_Nissan(&LEAF_55B);
     transmit_can_frame(&LEAF_55B);
     transmit_can_frame(&LEAF_5BC);
-  }
+  });
   // Send 100ms CAN Messages
-  if (currentMillis - previousMillis500ms >= INTERVAL_500_MS) {
-    previousMillis500ms = currentMillis;
-
+  transmit_every(INTERVAL_500_MS, 2, [this](unsigned long currentMillis) {
     transmit_can_frame(&LEAF_59E);
     if (LEAF_5C0.data.u8[0] == 0x40) {
       LEAF_5C0.data.u8[0] = 0x80;
@@ -100,5 +94,6 @@ void VCUInverter::transmit_can(unsigned long currentMillis) {
       LEAF_5C0.data.u8[0] = 0x40;
     }
     transmit_can_frame(&LEAF_5C0);
-  }
+  });
+  return true;
 }
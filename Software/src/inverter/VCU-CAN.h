@@ -7,14 +7,13 @@ class VCUInverter : public CanInverterProtocol {
  public:
   const char* name() override { return Name; }
   void update_values();
-  void transmit_can(unsigned long currentMillis);
-  void map_can_frame_to_variable(CAN_frame rx_frame);
+  bool setup() override;
+  // All frames are scheduled with transmit_every() in setup()
+  void transmit_can(unsigned long currentMillis) {}
+  void map_can_frame_to_variable(const CAN_frame& rx_frame);
   static constexpr const char* Name = "VCU mode: Nissan LEAF battery";
 
  private:
-  unsigned long previousMillis10ms = 0;
-  unsigned long previousMillis100ms = 0;
-  unsigned long previousMillis500ms = 0;
   uint16_t remining_gids = 281;
   uint8_t mprun10 = 0;
   uint8_t mprun100 = 0;
@@ -0,0 +1,14 @@
+// Micro benchmarks of the hot paths on the host, kept out of the unit tests so their output does not drown the test
+// results. Run them directly to see the numbers; gtest flags such as --gtest_filter apply.
+
+#include <gtest/gtest.h>
+
+void RegisterCanDispatchBenchmarks(void);
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  RegisterCanDispatchBenchmarks();
+  return RUN_ALL_TESTS();
+}
+
+void store_settings_equipment_stop(void) {}
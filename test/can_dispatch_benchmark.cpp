@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "utils/utils.h"
+
+#include "../Software/src/battery/BATTERIES.h"
+#include "../Software/src/devboard/utils/events.h"
+#include "../Software/src/inverter/INVERTERS.h"
+
+// Measures how many frames per second the receive path can push through each CAN
+// battery handler and inverter map_can_frame_to_variable(). The numbers are
+// printed and recorded as test properties; the tests only fail if a handler crashes.
+
+static const int BENCHMARK_ROUNDS = 8;
+
+// A deterministic sweep over the whole 11-bit ID space with a few payload patterns,
+// so every handler sees both the IDs it cares about and the ones it ignores.
+static std::vector<CAN_frame> make_benchmark_frames() {
+  static const uint8_t patterns[][8] = {
+      {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+      {0x01, 0x64, 0x0F, 0xA0, 0x27, 0x10, 0x55, 0xAA},
+      {0x10, 0x08, 0x62, 0x01, 0x02, 0x03, 0x04, 0x05},
+  };
+  std::vector<CAN_frame> frames;
+  for (const auto& pattern : patterns) {
+    for (uint32_t id = 0; id <= 0x7FF; id++) {
+      CAN_frame frame = {.FD = false, .ext_ID = false, .DLC = 8, .ID = id};
+      for (int i = 0; i < 8; i++) {
+        frame.data.u8[i] = pattern[i];
+      }
+      frames.push_back(frame);
+    }
+  }
+  return frames;
+}
+
+template <typename Handler>
+static double measure_frames_per_second(const std::vector<CAN_frame>& frames, Handler handle) {
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+    for (const auto& frame : frames) {
+      handle(frame);
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return (frames.size() * BENCHMARK_ROUNDS) / elapsed.count();
+}
+
+static void report(const char* kind, const char* name, double frames_per_second) {
+  testing::Test::RecordProperty("frames_per_second", std::to_string((uint64_t)frames_per_second));
+  std::cout << "[ DISPATCH ] " << kind << " " << name << ": " << (uint64_t)frames_per_second << " frames/s"
+            << std::endl;
+}
+
+class BatteryDispatchBenchmark : public testing::Test {
+ public:
+  explicit BatteryDispatchBenchmark(BatteryType type) : type(type) {}
+
+  void SetUp() override {
+    datalayer = DataLayer();
+    reset_all_events();
+    init_hal();
+    user_selected_battery_type = type;
+    setup_battery();
+  }
+
+  void TearDown() override {
+    if (battery) {
+      delete battery;
+      battery = nullptr;
+    }
+  }
+
+  void TestBody() override {
+    auto* can_battery = dynamic_cast<CanBattery*>(battery);
+    if (can_battery == nullptr) {
+      GTEST_SKIP() << "Battery is not a CanBattery subclass";
+    }
+    auto frames = make_benchmark_frames();
+    double fps = measure_frames_per_second(frames, [&](const CAN_frame& f) { can_battery->receive_can_frame(f); });
+    report("battery", name_for_battery_type(type), fps);
+    EXPECT_GT(fps, 0);
+  }
+
+ private:
+  BatteryType type;
+};
+
+class InverterDispatchBenchmark : public testing::Test {
+ public:
+  explicit InverterDispatchBenchmark(InverterProtocolType type) : type(type) {}
+
+  void SetUp() override {
+    datalayer = DataLayer();
+    reset_all_events();
+    init_hal();
+    user_selected_inverter_protocol = type;
+    setup_inverter();
+  }
+
+  void TearDown() override {
+    if (inverter) {
+      delete inverter;
+      inverter = nullptr;
+    }
+  }
+
+  void TestBody() override {
+    auto* can_inverter = dynamic_cast<CanInverterProtocol*>(inverter);
+    if (can_inverter == nullptr) {
+      GTEST_SKIP() << "Inverter is not a CAN protocol";
+    }
+    auto frames = make_benchmark_frames();
+    double fps = measure_frames_per_second(frames, [&](const CAN_frame& f) { can_inverter->receive_can_frame(f); });
+    report("inverter", name_for_inverter_type(type), fps);
+    EXPECT_GT(fps, 0);
+  }
+
+ private:
+  InverterProtocolType type;
+};
+
+static bool is_can_battery(BatteryType type) {
+  if (type == BatteryType::TestFake) {
+    return false;
+  }
+  datalayer = DataLayer();
+  init_hal();
+  Battery* tmp_battery = create_battery(type);
+  bool can = dynamic_cast<CanBattery*>(tmp_battery) != nullptr;
+  delete tmp_battery;
+  return can;
+}
+
+void RegisterCanDispatchBenchmarks() {
+  for (int i = 0; i < (int)BatteryType::Highest; i++) {
+    if (!is_can_battery((BatteryType)i)) {
+      continue;
+    }
+    std::string test_name = ("Battery" + snake_case_to_camel_case(name_for_battery_type((BatteryType)i)));
+    testing::RegisterTest("CanDispatchBenchmark", test_name.c_str(), nullptr, nullptr, __FILE__, __LINE__,
+                          [=]() -> testing::Test* { return new BatteryDispatchBenchmark((BatteryType)i); });
+  }
+
+  for (auto type : supported_inverter_protocols()) {
+    if (type == InverterProtocolType::None || name_for_inverter_type(type) == nullptr) {
+      continue;
+    }
+    std::string test_name = ("Inverter" + snake_case_to_camel_case(name_for_inverter_type(type)));
+    testing::RegisterTest("CanDispatchBenchmark", test_name.c_str(), nullptr, nullptr, __FILE__, __LINE__,
+                          [=]() -> testing::Test* { return new InverterDispatchBenchmark(type); });
+  }
+}
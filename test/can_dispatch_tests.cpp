@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/can_dispatch.h"
+
+class CountingReceiver : public CanReceiver {
+ public:
+  void receive_can_frame(const CAN_frame& rx_frame) override {
+    received++;
+    last_id = rx_frame.ID;
+  }
+  int received = 0;
+  uint32_t last_id = 0;
+};
+
+class CanDispatchTests : public testing::Test {
+ protected:
+  void SetUp() override { can_dispatch_clear(); }
+  void TearDown() override { can_dispatch_clear(); }
+};
+
+TEST_F(CanDispatchTests, DefaultFilterAcceptsEverything) {
+  CountingReceiver receiver;
+  ASSERT_TRUE(can_dispatch_add(&receiver, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS, {}));
+
+  CAN_frame frame = {.ID = 0x7FF};
+  can_dispatch_frame(frame, CAN_NATIVE);
+  frame.ID = 0x18FF50E5;
+  can_dispatch_frame(frame, CAN_NATIVE);
+
+  EXPECT_EQ(receiver.received, 2);
+  EXPECT_EQ(can_dispatch_tables[CAN_NATIVE].entries[0].hits, 2u);
+  EXPECT_EQ(can_dispatch_tables[CAN_NATIVE].entries[0].misses, 0u);
+}
+
+TEST_F(CanDispatchTests, FramesOnlyReachReceiversOnTheirInterface) {
+  CountingReceiver native, addon;
+  can_dispatch_add(&native, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS, {});
+  can_dispatch_add(&addon, CAN_ADDON_MCP2515, CAN_Speed::CAN_SPEED_250KBPS, {});
+
+  CAN_frame frame = {.ID = 0x100};
+  can_dispatch_frame(frame, CAN_ADDON_MCP2515);
+
+  EXPECT_EQ(native.received, 0);
+  EXPECT_EQ(addon.received, 1);
+  EXPECT_TRUE(can_dispatch_has_receivers(CAN_NATIVE));
+  EXPECT_FALSE(can_dispatch_has_receivers(CANFD_NATIVE));
+  EXPECT_EQ(can_dispatch_speed(CAN_ADDON_MCP2515), CAN_Speed::CAN_SPEED_250KBPS);
+}
+
+TEST_F(CanDispatchTests, MaskAndRangeDropFramesBeforeReceiver) {
+  CountingReceiver masked, ranged;
+  CAN_ID_Filter mask_filter = {.code = 0x200, .mask = 0x700};  // 0x200-0x2FF
+  CAN_ID_Filter range_filter = {.min_id = 0x300, .max_id = 0x3FF};
+  can_dispatch_add(&masked, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS, mask_filter);
+  can_dispatch_add(&ranged, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS, range_filter);
+
+  for (uint32_t id = 0; id <= 0x7FF; id++) {
+    CAN_frame frame = {.ID = id};
+    can_dispatch_frame(frame, CAN_NATIVE);
+  }
+
+  EXPECT_EQ(masked.received, 0x100);
+  EXPECT_EQ(ranged.received, 0x100);
+  EXPECT_EQ(can_dispatch_tables[CAN_NATIVE].entries[0].hits, 0x100u);
+  EXPECT_EQ(can_dispatch_tables[CAN_NATIVE].entries[0].misses, 0x700u);
+  EXPECT_EQ(ranged.last_id, 0x3FFu);
+}
+
+TEST_F(CanDispatchTests, FormatSeparatesStandardAndExtendedFrames) {
+  CountingReceiver standard, extended, any;
+  can_dispatch_add(&standard, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS,
+                   {.min_id = 0x100, .max_id = 0x2FF, .format = CAN_ID_Format::STANDARD});
+  can_dispatch_add(&extended, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS,
+                   {.min_id = 0x100, .max_id = 0x2FF, .format = CAN_ID_Format::EXTENDED});
+  can_dispatch_add(&any, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS, {.min_id = 0x100, .max_id = 0x2FF});
+
+  can_dispatch_frame({.ext_ID = false, .ID = 0x200}, CAN_NATIVE);
+  can_dispatch_frame({.ext_ID = true, .ID = 0x200}, CAN_NATIVE);
+  can_dispatch_frame({.ext_ID = true, .ID = 0x201}, CAN_NATIVE);
+
+  EXPECT_EQ(standard.received, 1);
+  EXPECT_EQ(extended.received, 2);
+  EXPECT_EQ(any.received, 3);
+  EXPECT_EQ(extended.last_id, 0x201u);
+}
+
+TEST_F(CanDispatchTests, TableRejectsReceiversWhenFull) {
+  CountingReceiver receivers[CAN_MAX_RECEIVERS_PER_INTERFACE + 1];
+  for (int i = 0; i < CAN_MAX_RECEIVERS_PER_INTERFACE; i++) {
+    EXPECT_TRUE(can_dispatch_add(&receivers[i], CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS, {}));
+  }
+  EXPECT_FALSE(can_dispatch_add(&receivers[CAN_MAX_RECEIVERS_PER_INTERFACE], CAN_NATIVE,
+                                CAN_Speed::CAN_SPEED_500KBPS, {}));
+
+  CAN_frame frame = {.ID = 0x123};
+  can_dispatch_frame(frame, CAN_NATIVE);
+  for (int i = 0; i < CAN_MAX_RECEIVERS_PER_INTERFACE; i++) {
+    EXPECT_EQ(receivers[i].received, 1);
+  }
+  EXPECT_EQ(receivers[CAN_MAX_RECEIVERS_PER_INTERFACE].received, 0);
+}
+
+class ListedIdsReceiver : public CountingReceiver {
+ public:
+  explicit ListedIdsReceiver(std::vector<uint32_t> ids) : ids(ids) {}
+  std::vector<uint32_t> handled_can_ids() override { return ids; }
+  std::vector<uint32_t> ids;
+};
+
+TEST_F(CanDispatchTests, HandledIdsAreMergedPerInterface) {
+  ListedIdsReceiver battery({0x300, 0x100, 0x200}), charger({0x200, 0x400});
+  can_dispatch_add(&battery, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS, {});
+  can_dispatch_add(&charger, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS, {});
+
+  EXPECT_EQ(can_dispatch_handled_ids(CAN_NATIVE), std::vector<uint32_t>({0x100, 0x200, 0x300, 0x400}));
+
+  // A receiver without a list needs every frame
+  CountingReceiver inverter;
+  can_dispatch_add(&inverter, CAN_NATIVE, CAN_Speed::CAN_SPEED_500KBPS, {});
+  EXPECT_TRUE(can_dispatch_handled_ids(CAN_NATIVE).empty());
+}
+
+TEST_F(CanDispatchTests, AcceptanceFiltersCoverAllIds) {
+  std::vector<uint32_t> ids = {0x132, 0x20A, 0x212, 0x224, 0x252, 0x292, 0x2A4, 0x2B4, 0x2C4, 0x2D2, 0x300, 0x310,
+                               0x312, 0x320, 0x332, 0x352, 0x392, 0x3AA, 0x3C4, 0x3D2, 0x401, 0x612, 0x72A, 0x7AA};
+  for (uint8_t max_filters : {1, 2, 8, 32}) {
+    CAN_ID_Filter filters[32];
+    uint8_t count = can_compute_acceptance_filters(ids, filters, max_filters);
+    ASSERT_GT(count, 0);
+    ASSERT_LE(count, max_filters);
+
+    int accepted = 0;
+    for (uint32_t id = 0; id <= 0x7FF; id++) {
+      bool match = false;
+      for (uint8_t i = 0; i < count; i++) {
+        match |= can_id_filter_accepts(filters[i], id, false);
+      }
+      bool listed = std::find(ids.begin(), ids.end(), id) != ids.end();
+      if (listed) {
+        EXPECT_TRUE(match) << "ID 0x" << std::hex << id << " rejected with " << (int)max_filters << " filters";
+      }
+      accepted += match;
+    }
+    if (max_filters >= ids.size()) {
+      EXPECT_EQ(accepted, (int)ids.size());
+    } else if (max_filters > 1) {
+      // A single mask covering 0x132..0x7AA has to accept everything, but more groups must do better
+      EXPECT_LT(accepted, 0x800);
+    }
+  }
+}
+
+TEST_F(CanDispatchTests, AcceptanceFiltersSingleGroupIsTightest) {
+  CAN_ID_Filter filter;
+  ASSERT_EQ(can_compute_acceptance_filters({0x180, 0x181, 0x182, 0x183}, &filter, 1), 1);
+  EXPECT_EQ(filter.code, 0x180u);
+  EXPECT_EQ(filter.mask, 0x7FCu);
+}
+
+TEST_F(CanDispatchTests, AcceptanceFiltersAcceptAllForMixedFormats) {
+  CAN_ID_Filter filters[2];
+  EXPECT_EQ(can_compute_acceptance_filters({0x100, 0x18FF50E5}, filters, 2), 0);
+  EXPECT_EQ(can_compute_acceptance_filters({}, filters, 2), 0);
+  EXPECT_EQ(can_compute_acceptance_filters({0x18FF50E5, 0x18FF51E5}, filters, 1), 1);
+  EXPECT_EQ(filters[0].mask, 0x1FFFFFFFu & ~0x100u);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/devboard/sdcard/can_log_record.h"
+
+TEST(CanLogRecordTests, ClassicFrameMatchesCandumpFormat) {
+  CAN_frame frame = {.FD = false, .ext_ID = false, .DLC = 8, .ID = 0x1AB,
+                     .data = {.u8 = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF}}};
+  CAN_Log_Record record;
+  EXPECT_EQ(make_can_log_record(record, frame, CAN_NATIVE, MSG_RX, 12345678901ULL), 16u + 8u);
+
+  char line[CAN_LOG_RECORD_MAX_TEXT];
+  size_t length = format_can_log_record(record, line, sizeof(line));
+  EXPECT_STREQ(line, "(12345.678901) RX0 1AB [8] 01 23 45 67 89 AB CD EF\n");
+  EXPECT_EQ(length, strlen(line));
+}
+
+TEST(CanLogRecordTests, DirectionAndInterfaceSelectBusNumber) {
+  CAN_frame frame = {.FD = false, .ext_ID = true, .DLC = 0, .ID = 0x18FF50E5};
+  CAN_Log_Record record;
+  EXPECT_EQ(make_can_log_record(record, frame, CAN_ADDON_MCP2515, MSG_TX, 5), 16u);
+  EXPECT_EQ(record.flags, CAN_LOG_RECORD_FLAG_TX | CAN_LOG_RECORD_FLAG_EXT);
+
+  char line[CAN_LOG_RECORD_MAX_TEXT];
+  format_can_log_record(record, line, sizeof(line));
+  EXPECT_STREQ(line, "(0.000005) TX5 18FF50E5 [0]\n");
+}
+
+TEST(CanLogRecordTests, IdWidthMarksFrameFormat) {
+  CAN_Log_Record record;
+  char line[CAN_LOG_RECORD_MAX_TEXT];
+  make_can_log_record(record, {.ext_ID = false, .DLC = 0, .ID = 0x01}, CAN_NATIVE, MSG_RX, 0);
+  format_can_log_record(record, line, sizeof(line));
+  EXPECT_STREQ(line, "(0.000000) RX0 001 [0]\n");
+
+  make_can_log_record(record, {.ext_ID = true, .DLC = 0, .ID = 0x100}, CAN_NATIVE, MSG_RX, 0);
+  format_can_log_record(record, line, sizeof(line));
+  EXPECT_STREQ(line, "(0.000000) RX0 00000100 [0]\n");
+}
+
+TEST(CanLogRecordTests, FdFrameFitsLongestLine) {
+  CAN_frame frame = {.FD = true, .ext_ID = true, .DLC = 64, .ID = 0x1FFFFFFF};
+  for (int i = 0; i < 64; i++) {
+    frame.data.u8[i] = 0xFF;
+  }
+  CAN_Log_Record record;
+  EXPECT_EQ(make_can_log_record(record, frame, CANFD_ADDON_MCP2518_2, MSG_TX, UINT64_MAX), sizeof(CAN_Log_Record));
+
+  char line[CAN_LOG_RECORD_MAX_TEXT];
+  size_t length = format_can_log_record(record, line, sizeof(line));
+  EXPECT_LT(length, sizeof(line));
+  EXPECT_EQ(line[length - 1], '\n');
+
+  // Too small output buffers are rejected instead of truncated
+  char small[16];
+  EXPECT_EQ(format_can_log_record(record, small, sizeof(small)), 0u);
+}
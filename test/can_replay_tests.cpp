@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "../Software/src/communication/can/can_replay.h"
+
+static const char* replay_log =
+    "(1700000000.000100) RX0 1AB [8] 01 02 03 04 05 06 07 08\n"
+    "(1700000000.002350) TX1 18FF50E5 [2] AA bb\r\n"
+    "\n"
+    "garbage line\n"
+    "(1700000000.012350) RX2 7FF [0] \n"
+    "(1700000001.5) RX2 123 [12] 00 01 02 03 04 05 06 07 08 09 0A 0B";
+
+class CanReplayTests : public testing::Test {
+ protected:
+  CanReplayLog log;
+};
+
+TEST_F(CanReplayTests, ParsesLineWithMicrosecondTimestamp) {
+  std::string line = "(1700000000.000123) RX0 1AB [3] 01 fe 10";
+  uint64_t timestamp_us;
+  CAN_frame frame = {};
+  ASSERT_TRUE(can_replay_parse_line(line.c_str(), line.size(), timestamp_us, frame));
+  EXPECT_EQ(timestamp_us, 1700000000000123ull);
+  EXPECT_EQ(frame.ID, 0x1ABu);
+  EXPECT_EQ(frame.DLC, 3);
+  EXPECT_FALSE(frame.ext_ID);
+  EXPECT_FALSE(frame.FD);
+  EXPECT_EQ(frame.data.u8[1], 0xFE);
+  EXPECT_EQ(frame.data.u8[2], 0x10);
+}
+
+TEST_F(CanReplayTests, IdWidthMarksExtendedFrames) {
+  uint64_t timestamp_us;
+  CAN_frame frame = {};
+  std::string line = "(1.0) RX0 00000100 [0]";
+  ASSERT_TRUE(can_replay_parse_line(line.c_str(), line.size(), timestamp_us, frame));
+  EXPECT_EQ(frame.ID, 0x100u);
+  EXPECT_TRUE(frame.ext_ID);
+
+  line = "(1.0) RX0 001 [0]";
+  ASSERT_TRUE(can_replay_parse_line(line.c_str(), line.size(), timestamp_us, frame));
+  EXPECT_EQ(frame.ID, 0x1u);
+  EXPECT_FALSE(frame.ext_ID);
+
+  // Logs of older firmware did not pad extended IDs
+  line = "(1.0) RX0 1234 [0]";
+  ASSERT_TRUE(can_replay_parse_line(line.c_str(), line.size(), timestamp_us, frame));
+  EXPECT_TRUE(frame.ext_ID);
+
+  // No writer pads a standard ID to 4 digits
+  line = "(1.0) RX0 0100 [0]";
+  EXPECT_FALSE(can_replay_parse_line(line.c_str(), line.size(), timestamp_us, frame));
+}
+
+TEST_F(CanReplayTests, RejectsMalformedLines) {
+  uint64_t timestamp_us;
+  CAN_frame frame;
+  for (std::string line : {"", "1.0 RX0 1AB [1] 00", "(1.0) RX0 XYZ [1] 00", "(1.0) RX0 1AB [2] 00",
+                           "(1.0) RX0 1AB [65] 00", "(1.0) RX0 1AB 00"}) {
+    EXPECT_FALSE(can_replay_parse_line(line.c_str(), line.size(), timestamp_us, frame)) << line;
+  }
+}
+
+TEST_F(CanReplayTests, DecodesLogIntoFramesWithDeltas) {
+  log.feed((const uint8_t*)replay_log, strlen(replay_log));
+  log.finish();
+
+  ASSERT_EQ(log.size(), 4u);
+  EXPECT_EQ(log.skipped_lines(), 1u);
+
+  CAN_frame frame;
+  EXPECT_EQ(log.frame(0, frame), 0u);
+  EXPECT_EQ(frame.ID, 0x1ABu);
+  EXPECT_EQ(frame.data.u8[7], 0x08);
+
+  EXPECT_EQ(log.frame(1, frame), 2250u);
+  EXPECT_EQ(frame.ID, 0x18FF50E5u);
+  EXPECT_TRUE(frame.ext_ID);
+  EXPECT_EQ(frame.DLC, 2);
+  EXPECT_EQ(frame.data.u8[1], 0xBB);
+
+  EXPECT_EQ(log.frame(2, frame), 10000u);
+  EXPECT_EQ(frame.DLC, 0);
+
+  EXPECT_EQ(log.frame(3, frame), 1487650u);
+  EXPECT_TRUE(frame.FD);
+  EXPECT_EQ(frame.DLC, 12);
+  EXPECT_EQ(frame.data.u8[11], 0x0B);
+}
+
+TEST_F(CanReplayTests, ReservationHoldsWholeUploadWithoutGrowing) {
+  const size_t upload = strlen(replay_log);
+  log.reserve_for_upload(upload);
+  EXPECT_LE(log.memory_used(), CanReplayLog::bytes_for_upload(upload) + sizeof(log));
+  const size_t reserved = log.memory_used();
+
+  log.feed((const uint8_t*)replay_log, upload);
+  EXPECT_EQ(log.memory_used(), reserved);
+  log.finish();
+  EXPECT_EQ(log.size(), 4u);
+  EXPECT_EQ(log.dropped_frames(), 0u);
+}
+
+TEST_F(CanReplayTests, FramesBeyondReservationAreDropped) {
+  const char* text = "(0.000) RX0 1 [0]\n(0.001) RX0 2 [0]\n(0.002) RX0 3 [0]\n";
+  log.reserve_for_upload(CAN_REPLAY_MIN_FRAME_LINE);
+  log.feed((const uint8_t*)text, strlen(text));
+  log.finish();
+  EXPECT_EQ(log.size(), 1u);
+  EXPECT_EQ(log.dropped_frames(), 2u);
+
+  // A new upload starts without the old reservation
+  log.clear();
+  log.feed((const uint8_t*)text, strlen(text));
+  EXPECT_EQ(log.size(), 3u);
+}
+
+TEST_F(CanReplayTests, ChunkBoundariesDoNotMatter) {
+  CanReplayLog whole;
+  whole.feed((const uint8_t*)replay_log, strlen(replay_log));
+  whole.finish();
+
+  for (size_t chunk = 1; chunk < 40; chunk++) {
+    log.clear();
+    for (size_t offset = 0; offset < strlen(replay_log); offset += chunk) {
+      log.feed((const uint8_t*)replay_log + offset, std::min(chunk, strlen(replay_log) - offset));
+    }
+    log.finish();
+
+    ASSERT_EQ(log.size(), whole.size()) << "chunk size " << chunk;
+    for (size_t i = 0; i < log.size(); i++) {
+      CAN_frame a, b;
+      EXPECT_EQ(log.frame(i, a), whole.frame(i, b));
+      EXPECT_EQ(a.ID, b.ID);
+      EXPECT_EQ(a.DLC, b.DLC);
+      EXPECT_EQ(memcmp(a.data.u8, b.data.u8, a.DLC), 0);
+    }
+  }
+}
+
+TEST_F(CanReplayTests, OverlongAndBackwardsLinesAreHandled) {
+  std::string text = "(10.0) RX0 100 [0]\n" + std::string(CAN_REPLAY_LINE_MAX + 1, 'x') + "\n(5.0) RX0 101 [0]\n";
+  log.feed((const uint8_t*)text.c_str(), text.size());
+  log.finish();
+
+  ASSERT_EQ(log.size(), 2u);
+  EXPECT_EQ(log.skipped_lines(), 1u);
+  CAN_frame frame;
+  EXPECT_EQ(log.frame(1, frame), 0u);  // Going back in time replays immediately
+}
+
+TEST_F(CanReplayTests, SpeedScalesDeadlines) {
+  EXPECT_EQ(can_replay_scaled_us(1000000, 100), 1000000u);
+  EXPECT_EQ(can_replay_scaled_us(1000000, 200), 500000u);
+  EXPECT_EQ(can_replay_scaled_us(1000000, 50), 2000000u);
+  EXPECT_EQ(can_replay_scaled_us(3, 10000), 0u);
+}
+
+TEST_F(CanReplayTests, JitterStatistics) {
+  CAN_Replay_Statistics stats;
+  can_replay_record_interval(stats, 1000, 1100);
+  can_replay_record_interval(stats, 1000, 700);
+  can_replay_record_interval(stats, 1000, 1000);
+  EXPECT_EQ(stats.intervals, 3u);
+  EXPECT_EQ(stats.max_jitter_us, 300u);
+  EXPECT_EQ(can_replay_mean_jitter_us(stats), 133u);
+}
@@ -0,0 +1,290 @@
+// Runs battery and inverter integrations against each other on a VirtualCanBus for a long stretch of simulated
+// time. The battery interface and the inverter interface are put on one wire, so every frame the inverter side
+// sends reaches the battery side and the other way around. Matching pairs (a Pylon battery with the Pylon
+// inverter protocol) close the loop through the datalayer. The run is driven the way core_loop drives the
+// firmware: the bus is advanced every simulated ms, values are updated every simulated second and the
+// transmitters are run after that.
+//
+// The CPU time per simulated second, bus load, lost and dropped frames, the longest gap per CAN ID and the events
+// raised are printed and written as JSON, so timing regressions show up before they reach hardware.
+//
+// Usage: can_soak [--battery NAME] [--inverter NAME] [--seconds N] [--bitrate BPS] [--loss P] [--seed N]
+//                 [--output FILE] [--max-cpu-us N]
+//
+// NAME matches part of the integration name, every matching battery is run against every matching inverter.
+// With --max-cpu-us the exit code is 2 if a pair needs more CPU time than that per simulated second.
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "emul/virtual_can_bus.h"
+
+#include "../Software/src/battery/BATTERIES.h"
+#include "../Software/src/devboard/safety/safety.h"
+#include "../Software/src/devboard/utils/events.h"
+#include "../Software/src/inverter/INVERTERS.h"
+
+void store_settings_equipment_stop(void) {}
+
+// Where the soak puts the two sides, both interfaces are connected to one wire
+static const CAN_Interface BATTERY_INTERFACE = CAN_NATIVE;
+static const CAN_Interface INVERTER_INTERFACE = CAN_ADDON_MCP2515;
+
+typedef struct {
+  uint32_t id;
+  bool from_battery;
+  uint64_t count;
+  uint64_t first_us;
+  uint64_t last_us;
+  uint64_t max_gap_us;
+} IdTiming;
+
+typedef struct {
+  std::string battery;
+  std::string inverter;
+  uint32_t seconds;
+  double wall_ms;
+  double cpu_us_per_sim_s;
+  double bus_load_percent;
+  Virtual_CAN_Statistics bus;
+  std::vector<IdTiming> ids;
+  std::vector<std::string> events;
+} SoakResult;
+
+typedef struct {
+  uint32_t seconds = 3600;
+  Virtual_CAN_Config bus;
+} SoakOptions;
+
+static bool is_can_battery(BatteryType type) {
+  datalayer = DataLayer();
+  init_hal();
+  Battery* tmp_battery = create_battery(type);
+  bool can = dynamic_cast<CanBattery*>(tmp_battery) != nullptr;
+  delete tmp_battery;
+  return can;
+}
+
+static bool is_can_inverter(InverterProtocolType type) {
+  if (type == InverterProtocolType::None) {
+    return false;
+  }
+  user_selected_inverter_protocol = type;
+  setup_inverter();
+  bool can = inverter && inverter->interface_type() == InverterInterfaceType::Can;
+  delete inverter;
+  inverter = nullptr;
+  return can;
+}
+
+static void reset_firmware_state() {
+  datalayer = DataLayer();
+  reset_all_events();
+  init_hal();
+  set_millis64(0);
+  allowed_to_send_CAN = true;
+
+  // Same limits as the CAN log safety tests, for custom-BMS batteries
+  user_selected_max_pack_voltage_dV = 378 + 10;
+  user_selected_min_pack_voltage_dV = 261 - 10;
+  user_selected_max_cell_voltage_mV = 4200 + 20;
+  user_selected_min_cell_voltage_mV = 2900 - 20;
+}
+
+static SoakResult soak(BatteryType battery_type, InverterProtocolType inverter_type, const SoakOptions& options) {
+  using clock = std::chrono::steady_clock;
+  SoakResult result = {.battery = name_for_battery_type(battery_type),
+                       .inverter = name_for_inverter_type(inverter_type),
+                       .seconds = options.seconds};
+
+  reset_firmware_state();
+  can_config.battery = BATTERY_INTERFACE;
+  can_config.inverter = INVERTER_INTERFACE;
+
+  VirtualCanBus bus(options.bus);
+  bus.connect(BATTERY_INTERFACE, INVERTER_INTERFACE);
+  bus.attach();
+
+  std::map<std::pair<uint32_t, bool>, IdTiming> timings;
+  bus.on_frame([&timings](const CAN_frame& frame, CAN_Interface from, uint64_t at_us) {
+    bool from_battery = from == BATTERY_INTERFACE;
+    auto it = timings.find({frame.ID, from_battery});
+    if (it == timings.end()) {
+      timings[{frame.ID, from_battery}] = {frame.ID, from_battery, 1, at_us, at_us, 0};
+      return;
+    }
+    IdTiming& timing = it->second;
+    timing.max_gap_us = std::max(timing.max_gap_us, at_us - timing.last_us);
+    timing.last_us = at_us;
+    timing.count++;
+  });
+
+  user_selected_battery_type = battery_type;
+  setup_battery();
+  user_selected_inverter_protocol = inverter_type;
+  setup_inverter();
+
+  auto start = clock::now();
+  for (uint64_t ms = 1; ms <= (uint64_t)options.seconds * 1000; ms++) {
+    set_millis64(ms);
+    bus.run_until(ms * 1000);
+
+    if (ms % 1000 == 0) {
+      update_pause_state();
+      if (battery) {
+        battery->update_values();
+      }
+      update_machineryprotection();
+      if (inverter) {
+        inverter->update_values();
+      }
+    }
+
+    bus.transmit_all(ms);
+  }
+  auto elapsed = clock::now() - start;
+
+  result.wall_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+  result.cpu_us_per_sim_s = result.wall_ms * 1000 / options.seconds;
+  result.bus = bus.statistics(BATTERY_INTERFACE);
+  result.bus_load_percent = 100.0 * result.bus.busy_us / ((double)options.seconds * 1000000);
+  for (const auto& entry : timings) {
+    result.ids.push_back(entry.second);
+  }
+  for (int i = 0; i < EVENT_NOF_EVENTS; i++) {
+    if (get_event_pointer((EVENTS_ENUM_TYPE)i)->occurences > 0) {
+      result.events.push_back(get_event_enum_string((EVENTS_ENUM_TYPE)i));
+    }
+  }
+
+  delete inverter;
+  inverter = nullptr;
+  delete battery;
+  battery = nullptr;
+  return result;
+}
+
+// Longest gap of an ID compared to its average period, 1.0 for a perfectly regular ID
+static double worst_gap_ratio(const SoakResult& result) {
+  double worst = 0;
+  for (const auto& id : result.ids) {
+    if (id.count < 3) {
+      continue;
+    }
+    double period = (double)(id.last_us - id.first_us) / (id.count - 1);
+    if (period > 0) {
+      worst = std::max(worst, id.max_gap_us / period);
+    }
+  }
+  return worst;
+}
+
+static void write_json(const std::string& path, const SoakOptions& options, const std::vector<SoakResult>& results) {
+  std::ofstream out(path);
+  out << std::fixed << std::setprecision(3);
+  out << "{\n  \"seconds\": " << options.seconds << ",\n  \"bitrate\": " << options.bus.bitrate
+      << ",\n  \"loss\": " << options.bus.loss << ",\n  \"seed\": " << options.bus.seed << ",\n  \"pairs\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& r = results[i];
+    out << "    {\"battery\": \"" << r.battery << "\", \"inverter\": \"" << r.inverter
+        << "\", \"wall_ms\": " << r.wall_ms << ", \"cpu_us_per_sim_s\": " << r.cpu_us_per_sim_s
+        << ", \"bus_load_percent\": " << r.bus_load_percent
+        << ", \"frames_sent\": " << r.bus.frames_sent << ", \"frames_lost\": " << r.bus.frames_lost
+        << ", \"frames_received\": " << r.bus.frames_received << ", \"tx_overflows\": " << r.bus.tx_overflows
+        << ", \"max_wait_us\": " << r.bus.max_wait_us << ", \"worst_gap_ratio\": " << worst_gap_ratio(r)
+        << ",\n     \"events\": [";
+    for (size_t e = 0; e < r.events.size(); e++) {
+      out << (e ? ", " : "") << "\"" << r.events[e] << "\"";
+    }
+    out << "],\n     \"ids\": [";
+    for (size_t n = 0; n < r.ids.size(); n++) {
+      const auto& id = r.ids[n];
+      out << (n ? ", " : "") << "{\"id\": " << id.id << ", \"from\": \"" << (id.from_battery ? "battery" : "inverter")
+          << "\", \"count\": " << id.count << ", \"max_gap_us\": " << id.max_gap_us << "}";
+    }
+    out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+  SoakOptions options;
+  std::string output = "can_soak.json";
+  std::string battery_filter, inverter_filter;
+  double max_cpu_us = 0;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--battery") && i + 1 < argc) {
+      battery_filter = argv[++i];
+    } else if (!strcmp(argv[i], "--inverter") && i + 1 < argc) {
+      inverter_filter = argv[++i];
+    } else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+      options.seconds = std::max(1, atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "--bitrate") && i + 1 < argc) {
+      options.bus.bitrate = std::max(10000, atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "--loss") && i + 1 < argc) {
+      options.bus.loss = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      options.bus.seed = strtoul(argv[++i], nullptr, 10);
+    } else if (!strcmp(argv[i], "--output") && i + 1 < argc) {
+      output = argv[++i];
+    } else if (!strcmp(argv[i], "--max-cpu-us") && i + 1 < argc) {
+      max_cpu_us = atof(argv[++i]);
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--battery NAME] [--inverter NAME] [--seconds N] [--bitrate BPS] [--loss P] [--seed N]"
+                   " [--output FILE] [--max-cpu-us N]"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<BatteryType> batteries;
+  for (int i = 0; i < (int)BatteryType::Highest; i++) {
+    BatteryType type = (BatteryType)i;
+    if (is_can_battery(type) && std::string(name_for_battery_type(type)).find(battery_filter) != std::string::npos) {
+      batteries.push_back(type);
+    }
+  }
+  std::vector<InverterProtocolType> inverters;
+  for (int i = 0; i < (int)InverterProtocolType::Highest; i++) {
+    InverterProtocolType type = (InverterProtocolType)i;
+    if (is_can_inverter(type) && std::string(name_for_inverter_type(type)).find(inverter_filter) != std::string::npos) {
+      inverters.push_back(type);
+    }
+  }
+  if (batteries.empty() || inverters.empty()) {
+    std::cerr << "No CAN battery or inverter matches the filters" << std::endl;
+    return 1;
+  }
+
+  std::vector<SoakResult> results;
+  bool too_slow = false;
+  for (auto battery_type : batteries) {
+    for (auto inverter_type : inverters) {
+      results.push_back(soak(battery_type, inverter_type, options));
+
+      const auto& r = results.back();
+      std::cout << std::fixed << std::setprecision(1) << "[ SOAK     ] " << std::left << std::setw(40) << r.battery
+                << std::setw(40) << r.inverter << std::right << std::setw(8) << r.cpu_us_per_sim_s << " us/sim s"
+                << std::setw(8) << options.seconds * 1000.0 / r.wall_ms << "x" << std::setw(7) << r.bus_load_percent
+                << "% load" << std::setw(10) << r.bus.frames_sent << " frames" << std::setw(6) << r.bus.frames_lost
+                << " lost" << std::setw(6) << r.bus.tx_overflows << " dropped" << std::setprecision(2) << std::setw(7)
+                << worst_gap_ratio(r) << " worst gap" << std::setw(4) << r.events.size() << " events" << std::endl;
+      if (max_cpu_us > 0 && r.cpu_us_per_sim_s > max_cpu_us) {
+        too_slow = true;
+      }
+    }
+  }
+
+  write_json(output, options, results);
+  std::cout << results.size() << " pairs, " << options.seconds << " s simulated each, results written to " << output
+            << std::endl;
+  return too_slow ? 2 : 0;
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../Software/src/communication/can/can_tx_queue.h"
+
+static CAN_frame frame_with_id(uint32_t id, bool ext = false) {
+  CAN_frame frame = {.FD = false, .ext_ID = ext, .DLC = 8, .ID = id, .data = {.u8 = {0}}};
+  frame.data.u8[0] = id & 0xFF;
+  return frame;
+}
+
+class CanTxQueueTests : public testing::Test {
+ protected:
+  // Drain with room for `room` frames in the controller, collecting the IDs that went out
+  std::vector<uint32_t> drain(uint16_t room, uint32_t now_us = 0) {
+    std::vector<uint32_t> sent;
+    queue.drain(
+        [&](const CAN_frame& frame) {
+          if (sent.size() == room) {
+            return false;
+          }
+          sent.push_back(frame.ID);
+          return true;
+        },
+        now_us);
+    return sent;
+  }
+
+  CanTxQueue queue;
+};
+
+TEST_F(CanTxQueueTests, HigherClassesGoFirst) {
+  queue.push(frame_with_id(0x7E0), CAN_TX_DIAGNOSTIC, 0);
+  queue.push(frame_with_id(0x100), CAN_TX_KEEPALIVE, 0);
+  queue.push(frame_with_id(0x200), CAN_TX_LIMITS, 0);
+  queue.push(frame_with_id(0x101), CAN_TX_KEEPALIVE, 0);
+  queue.push(frame_with_id(0x300), CAN_TX_SAFETY, 0);
+
+  EXPECT_EQ(drain(10), (std::vector<uint32_t>{0x300, 0x200, 0x100, 0x101, 0x7E0}));
+  EXPECT_EQ(queue.depth(), 0);
+  EXPECT_EQ(queue.statistics().frames_sent, 5u);
+}
+
+TEST_F(CanTxQueueTests, FramesWaitWhileControllerIsFull) {
+  for (uint32_t id = 0x100; id < 0x106; id++) {
+    queue.push(frame_with_id(id), CAN_TX_KEEPALIVE, 0);
+  }
+  EXPECT_EQ(drain(2), (std::vector<uint32_t>{0x100, 0x101}));
+  EXPECT_EQ(queue.depth(), 4);
+
+  // A safety frame arriving meanwhile overtakes the frames still waiting
+  queue.push(frame_with_id(0x300), CAN_TX_SAFETY, 0);
+  EXPECT_EQ(drain(2), (std::vector<uint32_t>{0x300, 0x102}));
+  EXPECT_EQ(drain(10), (std::vector<uint32_t>{0x103, 0x104, 0x105}));
+  for (uint8_t c = 0; c < CAN_TX_PRIORITY_COUNT; c++) {
+    EXPECT_EQ(queue.statistics().dropped[c], 0u);
+  }
+}
+
+TEST_F(CanTxQueueTests, OverflowDropsOldestOfItsClassOnly) {
+  queue.push(frame_with_id(0x300), CAN_TX_SAFETY, 0);
+  for (uint32_t i = 0; i < CAN_TX_DEPTH_DIAGNOSTIC + 3; i++) {
+    bool kept = queue.push(frame_with_id(0x700 + i), CAN_TX_DIAGNOSTIC, 0);
+    EXPECT_EQ(kept, i < CAN_TX_DEPTH_DIAGNOSTIC);
+  }
+  EXPECT_EQ(queue.depth(CAN_TX_DIAGNOSTIC), CAN_TX_DEPTH_DIAGNOSTIC);
+  EXPECT_EQ(queue.depth(CAN_TX_SAFETY), 1);
+  EXPECT_EQ(queue.statistics().dropped[CAN_TX_DIAGNOSTIC], 3u);
+  EXPECT_EQ(queue.statistics().dropped[CAN_TX_SAFETY], 0u);
+  EXPECT_EQ(queue.statistics().depth_peak, CAN_TX_DEPTH_DIAGNOSTIC + 1);
+
+  auto sent = drain(2);
+  EXPECT_EQ(sent, (std::vector<uint32_t>{0x300, 0x703}));  // 0x700-0x702 made way
+}
+
+TEST_F(CanTxQueueTests, LatencyIsRecordedWhenSent) {
+  queue.push(frame_with_id(0x100), CAN_TX_KEEPALIVE, 1000);
+  queue.push(frame_with_id(0x101), CAN_TX_KEEPALIVE, 1000);
+  drain(1, 1100);
+  drain(1, 5000);
+  const CAN_TX_Statistics& stats = queue.statistics();
+  EXPECT_EQ(latency_histogram_count(stats.latency), 2u);
+  EXPECT_EQ(stats.latency.max_us.load(), 4000u);
+}
+
+TEST_F(CanTxQueueTests, ClearKeepsStatistics) {
+  queue.push(frame_with_id(0x100), CAN_TX_KEEPALIVE, 0);
+  drain(1);
+  queue.push(frame_with_id(0x101), CAN_TX_KEEPALIVE, 0);
+  queue.clear();
+  EXPECT_EQ(queue.depth(), 0);
+  EXPECT_TRUE(drain(10).empty());
+  EXPECT_EQ(queue.statistics().frames_sent, 1u);
+}
+
+// The core task preempting the replay task while it hands a frame to the controller
+TEST_F(CanTxQueueTests, DrainInterruptedByAnotherTaskSendsEachFrameOnce) {
+  queue.push(frame_with_id(0x100), CAN_TX_KEEPALIVE, 0);
+  queue.push(frame_with_id(0x101), CAN_TX_KEEPALIVE, 0);
+  std::vector<uint32_t> sent;
+  uint16_t sent_by_other_task = 0xFFFF;
+  queue.drain(
+      [&](const CAN_frame& frame) {
+        if (sent.empty()) {
+          queue.push(frame_with_id(0x300), CAN_TX_SAFETY, 0);
+          sent_by_other_task = drain(10).size();
+        }
+        sent.push_back(frame.ID);
+        return true;
+      },
+      0);
+  EXPECT_EQ(sent_by_other_task, 0);
+  // The frame queued meanwhile goes out with the drain that was running
+  EXPECT_EQ(sent, (std::vector<uint32_t>{0x100, 0x300, 0x101}));
+  EXPECT_EQ(queue.depth(), 0);
+  EXPECT_EQ(queue.statistics().frames_sent, 3u);
+}
+
+TEST_F(CanTxQueueTests, FrameTheControllerRefusedKeepsItsPlace) {
+  for (uint32_t id = 0x700; id < 0x700 + CAN_TX_DEPTH_DIAGNOSTIC; id++) {
+    queue.push(frame_with_id(id), CAN_TX_DIAGNOSTIC, 0);
+  }
+  EXPECT_EQ(drain(1), (std::vector<uint32_t>{0x700}));
+  EXPECT_EQ(drain(1), (std::vector<uint32_t>{0x701}));
+  EXPECT_EQ(queue.depth(CAN_TX_DIAGNOSTIC), CAN_TX_DEPTH_DIAGNOSTIC - 2);
+
+  // The class fills up while the oldest frame is out with a controller that refuses it
+  queue.drain(
+      [&](const CAN_frame& frame) {
+        queue.push(frame_with_id(0x7F0), CAN_TX_DIAGNOSTIC, 0);
+        queue.push(frame_with_id(0x7F1), CAN_TX_DIAGNOSTIC, 0);
+        queue.push(frame_with_id(0x7F2), CAN_TX_DIAGNOSTIC, 0);
+        return false;
+      },
+      0);
+  EXPECT_EQ(queue.depth(CAN_TX_DIAGNOSTIC), CAN_TX_DEPTH_DIAGNOSTIC);
+  EXPECT_EQ(queue.statistics().dropped[CAN_TX_DIAGNOSTIC], 1u);
+  EXPECT_EQ(drain(1), (std::vector<uint32_t>{0x703}));
+}
+
+TEST(CanTxPriorityTests, DefaultClasses) {
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x7DF), CAN_TX_KEEPALIVE), CAN_TX_DIAGNOSTIC);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x7E0), CAN_TX_KEEPALIVE), CAN_TX_DIAGNOSTIC);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x7E7), CAN_TX_LIMITS), CAN_TX_DIAGNOSTIC);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x18DAF110, true), CAN_TX_KEEPALIVE), CAN_TX_DIAGNOSTIC);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x18DB33F1, true), CAN_TX_KEEPALIVE), CAN_TX_DIAGNOSTIC);
+  // Responses and vendor frames in the 0x700 range keep the class of their sender
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x7E8), CAN_TX_KEEPALIVE), CAN_TX_KEEPALIVE);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x7FF), CAN_TX_KEEPALIVE), CAN_TX_KEEPALIVE);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x700), CAN_TX_LIMITS), CAN_TX_LIMITS);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x7DF, true), CAN_TX_KEEPALIVE), CAN_TX_KEEPALIVE);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x18FF50E5, true), CAN_TX_KEEPALIVE), CAN_TX_KEEPALIVE);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x351), CAN_TX_LIMITS), CAN_TX_LIMITS);
+  EXPECT_EQ(can_tx_priority_for(frame_with_id(0x351), CAN_TX_KEEPALIVE), CAN_TX_KEEPALIVE);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include "../Software/src/datalayer/datalayer.h"
+
+// Compares the shared cell statistics pass with the separate loops it replaced, one for min/max in the battery,
+// one for the balancing count in MQTT and one for the average, on full 192 cell packs. The numbers are printed and
+// recorded as test properties; the test only fails if the results differ.
+
+static const int CELL_BENCHMARK_ROUNDS = 20000;
+
+static void fill_pack(DATALAYER_BATTERY_TYPE& battery) {
+  battery.info.number_of_cells = MAX_AMOUNT_CELLS;
+  uint32_t seed = 12345;
+  for (int i = 0; i < MAX_AMOUNT_CELLS; i++) {
+    seed = seed * 1103515245 + 12345;
+    battery.status.cell_voltages_mV[i] = 3600 + (seed >> 16) % 200;
+    battery.status.cell_balancing_status[i] = ((seed >> 8) & 7) == 0;
+  }
+}
+
+// The loops the batteries, MQTT and webserver ran before
+static Cell_Statistics separate_loops(const DATALAYER_BATTERY_TYPE& battery) {
+  Cell_Statistics stats = {};
+  stats.min_mV = 9999;
+  for (uint8_t i = 0; i < battery.info.number_of_cells; i++) {
+    if (battery.status.cell_voltages_mV[i] != 0) {
+      if (battery.status.cell_voltages_mV[i] < stats.min_mV) {
+        stats.min_mV = battery.status.cell_voltages_mV[i];
+        stats.min_index = i;
+      }
+      if (battery.status.cell_voltages_mV[i] > stats.max_mV) {
+        stats.max_mV = battery.status.cell_voltages_mV[i];
+        stats.max_index = i;
+      }
+    }
+  }
+  for (uint8_t i = 0; i < battery.info.number_of_cells; i++) {
+    if (battery.status.cell_voltages_mV[i] != 0) {
+      stats.sum_mV += battery.status.cell_voltages_mV[i];
+      stats.valid_cells++;
+    }
+  }
+  for (uint8_t i = 0; i < battery.info.number_of_cells; i++) {
+    if (battery.status.cell_balancing_status[i]) {
+      stats.balancing_cells++;
+    }
+  }
+  stats.deviation_mV = stats.max_mV - stats.min_mV;
+  stats.average_mV = (stats.sum_mV + stats.valid_cells / 2) / stats.valid_cells;
+  return stats;
+}
+
+template <typename Pass>
+static double measure_packs_per_second(Pass pass) {
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < CELL_BENCHMARK_ROUNDS; round++) {
+    pass();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return CELL_BENCHMARK_ROUNDS / elapsed.count();
+}
+
+TEST(CellStatisticsBenchmark, Pack192Cells) {
+  static DATALAYER_BATTERY_TYPE battery;
+  fill_pack(battery);
+
+  Cell_Statistics reference = separate_loops(battery);
+  update_cell_statistics(battery);
+  const Cell_Statistics& shared = battery.status.cell_statistics;
+  EXPECT_EQ(shared.min_mV, reference.min_mV);
+  EXPECT_EQ(shared.max_mV, reference.max_mV);
+  EXPECT_EQ(shared.min_index, reference.min_index);
+  EXPECT_EQ(shared.max_index, reference.max_index);
+  EXPECT_EQ(shared.sum_mV, reference.sum_mV);
+  EXPECT_EQ(shared.average_mV, reference.average_mV);
+  EXPECT_EQ(shared.balancing_cells, reference.balancing_cells);
+
+  volatile uint32_t sink = 0;
+  double separate = measure_packs_per_second([&]() {
+    battery.status.cell_voltages_mV[sink % MAX_AMOUNT_CELLS] ^= 1;
+    sink = sink + separate_loops(battery).sum_mV;
+  });
+  double single = measure_packs_per_second([&]() {
+    battery.status.cell_voltages_mV[sink % MAX_AMOUNT_CELLS] ^= 1;
+    update_cell_statistics(battery);
+    sink = sink + battery.status.cell_statistics.sum_mV;
+  });
+
+  testing::Test::RecordProperty("separate_loops_packs_per_second", std::to_string((uint64_t)separate));
+  testing::Test::RecordProperty("cell_statistics_packs_per_second", std::to_string((uint64_t)single));
+  std::cout << "[ CELLS    ] separate loops: " << (uint64_t)separate
+            << " packs/s, cell statistics: " << (uint64_t)single << " packs/s" << std::endl;
+  EXPECT_GT(single, 0);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/datalayer/datalayer.h"
+
+TEST(CellStatistics, MinMaxAverageAndIndices) {
+  const uint16_t cells[] = {3700, 3712, 3695, 3712, 3695, 3701};
+  Cell_Statistics stats = compute_cell_statistics(cells, 6, 0);
+  EXPECT_EQ(stats.valid_cells, 6);
+  EXPECT_EQ(stats.min_mV, 3695);
+  EXPECT_EQ(stats.max_mV, 3712);
+  EXPECT_EQ(stats.deviation_mV, 17);
+  EXPECT_EQ(stats.sum_mV, 22215u);
+  EXPECT_EQ(stats.average_mV, 3703);
+  // First cell with the extreme voltage
+  EXPECT_EQ(stats.min_index, 2);
+  EXPECT_EQ(stats.max_index, 1);
+}
+
+TEST(CellStatistics, SkipsCellsBelowValidVoltage) {
+  const uint16_t cells[] = {0, 3650, 900, 3660, 0};
+  Cell_Statistics stats = compute_cell_statistics(cells, 5, 1001);
+  EXPECT_EQ(stats.valid_cells, 2);
+  EXPECT_EQ(stats.min_mV, 3650);
+  EXPECT_EQ(stats.max_mV, 3660);
+  EXPECT_EQ(stats.min_index, 1);
+  EXPECT_EQ(stats.max_index, 3);
+  EXPECT_EQ(stats.average_mV, 3655);
+
+  // With 0 every cell counts, also the ones not read yet
+  Cell_Statistics all = compute_cell_statistics(cells, 5, 0);
+  EXPECT_EQ(all.valid_cells, 5);
+  EXPECT_EQ(all.min_mV, 0);
+  EXPECT_EQ(all.min_index, 0);
+}
+
+TEST(CellStatistics, NoValidCells) {
+  const uint16_t cells[] = {0, 0, 0};
+  Cell_Statistics stats = compute_cell_statistics(cells, 3, 1);
+  EXPECT_EQ(stats.valid_cells, 0);
+  EXPECT_EQ(stats.min_mV, 0);
+  EXPECT_EQ(stats.max_mV, 0);
+  EXPECT_EQ(stats.average_mV, 0);
+
+  Cell_Statistics none = compute_cell_statistics(cells, 0, 0);
+  EXPECT_EQ(none.valid_cells, 0);
+}
+
+TEST(CellStatistics, UpdatesBatteryStatus) {
+  DATALAYER_BATTERY_TYPE battery = {};
+  battery.info.number_of_cells = 4;
+  battery.status.cell_voltages_mV[0] = 3300;
+  battery.status.cell_voltages_mV[1] = 3310;
+  battery.status.cell_voltages_mV[2] = 0;  // Not read yet
+  battery.status.cell_voltages_mV[3] = 3290;
+  battery.status.cell_balancing_status[1] = true;
+  battery.status.cell_balancing_status[3] = true;
+  // Outside number_of_cells, ignored
+  battery.status.cell_voltages_mV[4] = 4200;
+  battery.status.cell_balancing_status[4] = true;
+
+  update_cell_statistics(battery);
+  const Cell_Statistics& stats = battery.status.cell_statistics;
+  EXPECT_EQ(stats.valid_cells, 3);
+  EXPECT_EQ(stats.min_mV, 3290);
+  EXPECT_EQ(stats.min_index, 3);
+  EXPECT_EQ(stats.max_mV, 3310);
+  EXPECT_EQ(stats.max_index, 1);
+  EXPECT_EQ(stats.average_mV, 3300);
+  EXPECT_EQ(stats.balancing_cells, 2);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../Software/src/battery/BATTERIES.h"
+#include "../Software/src/datalayer/datalayer_extended.h"
+
+// What DataLayerExtended took before its blocks moved to the heap: every battery type's values, all the time
+static const size_t static_layout_bytes =
+    2 * sizeof(DATALAYER_INFO_BOLTAMPERA) + sizeof(DATALAYER_INFO_BMWPHEV) + sizeof(DATALAYER_INFO_BMWIX) +
+    2 * sizeof(DATALAYER_INFO_BYDATTO3) + sizeof(DATALAYER_INFO_CELLPOWER) + sizeof(DATALAYER_INFO_CHADEMO) +
+    sizeof(DATALAYER_INFO_CMFAEV) + sizeof(DATALAYER_INFO_CMPSMART) + sizeof(DATALAYER_INFO_ECMP) +
+    sizeof(DATALAYER_INFO_FORD_MACH_E) + sizeof(DATALAYER_INFO_GEELY_GEOMETRY_C) +
+    2 * sizeof(DATALAYER_INFO_KIAHYUNDAI64) + sizeof(DATALAYER_INFO_RIVIAN) + sizeof(DATALAYER_INFO_TESLA) +
+    sizeof(DATALAYER_INFO_NISSAN_LEAF) + sizeof(DATALAYER_INFO_MEB) + sizeof(DATALAYER_INFO_VOLVO_POLESTAR) +
+    sizeof(DATALAYER_INFO_VOLVO_HYBRID) + sizeof(DATALAYER_INFO_GEELY_SEA) + sizeof(DATALAYER_INFO_ZOE) +
+    sizeof(DATALAYER_INFO_ZOE_PH2);
+
+TEST(DataLayerExtended, NothingAllocatedUntilUsed) {
+  uint32_t before = datalayer_extended_allocated_bytes;
+  DataLayerExtended extended;
+  EXPECT_EQ(datalayer_extended_allocated_bytes, before);
+  EXPECT_FALSE(extended.tesla.allocated());
+
+  // First use allocates the block with its default values
+  EXPECT_EQ(extended.bydAtto3->calibrationTargetSOC, 100);
+  EXPECT_TRUE(extended.bydAtto3.allocated());
+  EXPECT_FALSE(extended.bydAtto3_2.allocated());
+  EXPECT_EQ(datalayer_extended_allocated_bytes - before, sizeof(DATALAYER_INFO_BYDATTO3));
+
+  // Later uses, and allocating again, keep the same block
+  DATALAYER_INFO_BYDATTO3* block = extended.bydAtto3.get();
+  EXPECT_EQ(extended.bydAtto3.allocate(), block);
+  EXPECT_EQ(datalayer_extended_allocated_bytes - before, sizeof(DATALAYER_INFO_BYDATTO3));
+}
+
+TEST(DataLayerExtended, ReleasesBlocks) {
+  uint32_t before = datalayer_extended_allocated_bytes;
+  {
+    DataLayerExtended extended;
+    extended.meb.allocate();
+    extended.zoe.allocate();
+    EXPECT_EQ(datalayer_extended_allocated_bytes - before, sizeof(DATALAYER_INFO_MEB) + sizeof(DATALAYER_INFO_ZOE));
+  }
+  EXPECT_EQ(datalayer_extended_allocated_bytes, before);
+}
+
+TEST(DataLayerExtended, FirstUseFromTwoTasksAllocatesOnce) {
+  for (int round = 0; round < 50; round++) {
+    uint32_t before = datalayer_extended_allocated_bytes;
+    DataLayerExtended extended;
+    DATALAYER_INFO_TESLA* seen[2] = {nullptr, nullptr};
+    std::thread first([&]() { seen[0] = extended.tesla.get(); });
+    std::thread second([&]() { seen[1] = extended.tesla.get(); });
+    first.join();
+    second.join();
+    ASSERT_EQ(seen[0], seen[1]);
+    ASSERT_EQ(datalayer_extended_allocated_bytes - before, sizeof(DATALAYER_INFO_TESLA));
+  }
+}
+
+TEST(DataLayerExtended, AllocatesOnlyTheConfiguredBattery) {
+  DataLayerExtended tesla;
+  allocate_datalayer_extended(tesla, BatteryType::TeslaModel3Y, false);
+  EXPECT_TRUE(tesla.tesla.allocated());
+  EXPECT_FALSE(tesla.meb.allocated());
+  EXPECT_FALSE(tesla.bydAtto3.allocated());
+
+  DataLayerExtended byd;
+  allocate_datalayer_extended(byd, BatteryType::BydAtto3, true);
+  EXPECT_TRUE(byd.bydAtto3.allocated());
+  EXPECT_TRUE(byd.bydAtto3_2.allocated());
+  EXPECT_FALSE(byd.tesla.allocated());
+
+  DataLayerExtended none;
+  allocate_datalayer_extended(none, BatteryType::Pylon, true);
+  EXPECT_FALSE(none.tesla.allocated());
+}
+
+// Prints how much DRAM each battery type keeps for its extended values, compared to the static layout
+TEST(DataLayerExtended, ReportsSavedMemory) {
+  std::cout << "[ DRAM     ] static layout: " << static_layout_bytes << " bytes" << std::endl;
+  size_t largest = 0;
+  for (BatteryType type : supported_battery_types()) {
+    const char* name = name_for_battery_type(type);
+    if (name == nullptr) {
+      continue;
+    }
+    uint32_t before = datalayer_extended_allocated_bytes;
+    DataLayerExtended extended;
+    allocate_datalayer_extended(extended, type, true);
+    size_t used = datalayer_extended_allocated_bytes - before;
+    if (used > largest) {
+      largest = used;
+    }
+    EXPECT_LT(used, static_layout_bytes) << name;
+    std::cout << "[ DRAM     ] " << name << ": " << used << " bytes, "
+              << static_layout_bytes - used << " bytes freed" << std::endl;
+  }
+  testing::Test::RecordProperty("static_layout_bytes", std::to_string(static_layout_bytes));
+  testing::Test::RecordProperty("largest_battery_bytes", std::to_string(largest));
+}
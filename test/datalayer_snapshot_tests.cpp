@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../Software/src/datalayer/datalayer_snapshot.h"
+#include "../Software/src/devboard/utils/seqlock.h"
+
+// What the core task does in the values stage: update the battery values one field at a time, then publish
+static void write_battery_values(uint16_t value) {
+  datalayer.battery.info.number_of_cells = MAX_AMOUNT_CELLS;
+  for (int i = 0; i < MAX_AMOUNT_CELLS; i++) {
+    datalayer.battery.status.cell_voltages_mV[i] = value;
+    datalayer.battery.status.cell_balancing_status[i] = value & 1;
+  }
+  datalayer.battery.status.cell_max_voltage_mV = value;
+  datalayer.battery.status.cell_min_voltage_mV = value;
+  datalayer.battery.status.voltage_dV = value;
+  datalayer.battery.status.current_dA = (int16_t)(value / 2);
+  datalayer.battery.status.active_power_W = (int32_t)value * (value / 2) / 100;
+}
+
+static void expect_coherent(const DataLayerSnapshot& snapshot) {
+  const auto& status = snapshot.battery.status;
+  uint16_t value = status.voltage_dV;
+  ASSERT_EQ(status.cell_max_voltage_mV, value);
+  ASSERT_EQ(status.cell_min_voltage_mV, value);
+  ASSERT_EQ(status.current_dA, (int16_t)(value / 2));
+  ASSERT_EQ(status.active_power_W, (int32_t)value * (value / 2) / 100);
+  for (int i = 0; i < MAX_AMOUNT_CELLS; i++) {
+    ASSERT_EQ(status.cell_voltages_mV[i], value) << "cell " << i;
+    ASSERT_EQ(status.cell_balancing_status[i], (bool)(value & 1)) << "cell " << i;
+  }
+}
+
+TEST(DataLayerSnapshotTests, PublishCopiesValues) {
+  datalayer = DataLayer();
+  uint32_t version = datalayer_snapshot_version();
+  write_battery_values(3700);
+  publish_datalayer_snapshot(1234);
+  write_battery_values(3800);  // Not published yet
+
+  static DataLayerSnapshot snapshot;
+  read_datalayer_snapshot(snapshot);
+  EXPECT_EQ(datalayer_snapshot_version(), version + 1);
+  EXPECT_EQ(snapshot.published_ms, 1234u);
+  EXPECT_EQ(snapshot.battery.info.number_of_cells, MAX_AMOUNT_CELLS);
+  expect_coherent(snapshot);
+  EXPECT_EQ(snapshot.battery.status.voltage_dV, 3700);
+}
+
+TEST(DataLayerSnapshotTests, ReadsOneBattery) {
+  datalayer = DataLayer();
+  datalayer.battery.status.voltage_dV = 3000;
+  datalayer.battery2.status.voltage_dV = 3100;
+  datalayer.battery3.status.voltage_dV = 3200;
+  publish_datalayer_snapshot(1);
+
+  DATALAYER_BATTERY_TYPE pack;
+  for (uint8_t index = 0; index < 3; index++) {
+    read_datalayer_snapshot_battery(index, pack);
+    EXPECT_EQ(pack.status.voltage_dV, 3000 + 100 * index);
+  }
+}
+
+TEST(DataLayerSnapshotTests, SeqLockRetriesWhileWriting) {
+  SeqLock<uint32_t> lock;
+  std::atomic<bool> inside{false}, release{false};
+  std::thread writer([&]() {
+    lock.write_with([&](uint32_t& value) {
+      inside = true;
+      while (!release.load()) {
+        std::this_thread::yield();
+      }
+      value = 42;
+    });
+  });
+  while (!inside.load()) {
+    std::this_thread::yield();
+  }
+
+  std::thread reader([&]() {
+    uint32_t value = 0;
+    EXPECT_GT(lock.read(value), 0u);
+    EXPECT_EQ(value, 42u);
+  });
+  // The reader spins until the write is done
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  release = true;
+  writer.join();
+  reader.join();
+  EXPECT_EQ(lock.version(), 1u);
+}
+
+// The core task keeps updating and publishing while tasks on the other core read. Every snapshot must hold the
+// values of exactly one update, and a reader must never see an older update after a newer one.
+TEST(DataLayerSnapshotStressTests, ConcurrentReadersNeverSeeTornValues) {
+  datalayer = DataLayer();
+  write_battery_values(1);
+  publish_datalayer_snapshot(1);
+
+  constexpr int updates = 20000;
+  constexpr int readers = 3;
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> reads{0};
+
+  std::vector<std::thread> threads;
+  for (int r = 0; r < readers; r++) {
+    threads.emplace_back([&]() {
+      static thread_local DataLayerSnapshot snapshot;
+      uint16_t last = 0;
+      while (!done.load()) {
+        read_datalayer_snapshot(snapshot);
+        expect_coherent(snapshot);
+        ASSERT_GE(snapshot.battery.status.voltage_dV, last);
+        last = snapshot.battery.status.voltage_dV;
+        reads++;
+      }
+    });
+  }
+
+  for (int i = 2; i <= updates; i++) {
+    write_battery_values((uint16_t)i);
+    publish_datalayer_snapshot(i);
+  }
+  done = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_GT(reads.load(), 0u);
+  std::cout << "[ SNAPSHOT ] " << updates << " updates, " << reads.load() << " coherent reads" << std::endl;
+}
@@ -0,0 +1,117 @@
+#include "Preferences.h"
+
+#include <string.h>
+
+uint32_t Preferences::reads = 0;
+uint32_t Preferences::writes = 0;
+
+std::map<std::string, std::map<std::string, Preferences::Value>>& Preferences::namespaces() {
+  static std::map<std::string, std::map<std::string, Value>> all;
+  return all;
+}
+
+void Preferences::erase_all() {
+  namespaces().clear();
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partition_label) {
+  values = &namespaces()[name];
+  this->readOnly = readOnly;
+  return true;
+}
+
+void Preferences::end() {
+  values = nullptr;
+}
+
+bool Preferences::clear() {
+  if (values == nullptr || readOnly) {
+    return false;
+  }
+  writes++;
+  values->clear();
+  return true;
+}
+
+bool Preferences::remove(const char* key) {
+  if (values == nullptr || readOnly) {
+    return false;
+  }
+  writes++;
+  return values->erase(key) > 0;
+}
+
+size_t Preferences::putNumber(const char* key, Type type, uint32_t value, size_t size) {
+  if (values == nullptr || readOnly) {
+    return 0;
+  }
+  writes++;
+  (*values)[key] = Value{type, value, {}};
+  return size;
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+  if (values == nullptr || readOnly) {
+    return 0;
+  }
+  writes++;
+  (*values)[key] = Value{STRING, 0, std::vector<uint8_t>(value, value + strlen(value))};
+  return strlen(value);
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+  if (values == nullptr || readOnly) {
+    return 0;
+  }
+  writes++;
+  (*values)[key] = Value{BYTES, 0, std::vector<uint8_t>((const uint8_t*)value, (const uint8_t*)value + len)};
+  return len;
+}
+
+bool Preferences::isKey(const char* key) {
+  reads++;
+  return values != nullptr && values->count(key) > 0;
+}
+
+const Preferences::Value* Preferences::find(const char* key, Type type) {
+  reads++;
+  if (values == nullptr) {
+    return nullptr;
+  }
+  auto it = values->find(key);
+  return it != values->end() && it->second.type == type ? &it->second : nullptr;
+}
+
+uint32_t Preferences::getNumber(const char* key, Type type, uint32_t defaultValue) {
+  const Value* value = find(key, type);
+  return value != nullptr ? value->number : defaultValue;
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t maxLen) {
+  const Value* stored = find(key, STRING);
+  if (stored == nullptr || stored->bytes.size() + 1 > maxLen) {
+    return 0;
+  }
+  memcpy(value, stored->bytes.data(), stored->bytes.size());
+  value[stored->bytes.size()] = 0;
+  return stored->bytes.size() + 1;
+}
+
+String Preferences::getString(const char* key, String defaultValue) {
+  const Value* stored = find(key, STRING);
+  return stored != nullptr ? String(std::string(stored->bytes.begin(), stored->bytes.end())) : defaultValue;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  const Value* stored = find(key, BYTES);
+  return stored != nullptr ? stored->bytes.size() : 0;
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+  const Value* stored = find(key, BYTES);
+  if (stored == nullptr || stored->bytes.size() > maxLen) {
+    return 0;
+  }
+  memcpy(buf, stored->bytes.data(), stored->bytes.size());
+  return stored->bytes.size();
+}
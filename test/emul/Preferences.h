@@ -3,7 +3,12 @@
 
 #include <WString.h>
 #include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
 
+// NVS in memory. Values are kept per namespace across begin/end like on the ESP32, and a value only reads back with
+// the type it was written with.
 class Preferences {
 
  public:
@@ -12,19 +17,45 @@ class Preferences {
   bool begin(const char* name, bool readOnly = false, const char* partition_label = NULL);
   void end();
   bool clear();
+  bool remove(const char* key);
 
-  size_t putInt(const char* key, int32_t value) { return 0; }
-  size_t putUInt(const char* key, uint32_t value) { return 0; }
-  size_t putBool(const char* key, bool value) { return 0; }
-  size_t putString(const char* key, const char* value) { return 0; }
-  size_t putString(const char* key, String value) { return 0; }
+  size_t putInt(const char* key, int32_t value) { return putNumber(key, INT, (uint32_t)value, sizeof(value)); }
+  size_t putUInt(const char* key, uint32_t value) { return putNumber(key, UINT, value, sizeof(value)); }
+  size_t putBool(const char* key, bool value) { return putNumber(key, BOOL, value, sizeof(value)); }
+  size_t putString(const char* key, const char* value);
+  size_t putString(const char* key, String value) { return putString(key, value.c_str()); }
+  size_t putBytes(const char* key, const void* value, size_t len);
 
-  bool isKey(const char* key) { return false; }
+  bool isKey(const char* key);
 
-  int32_t getInt(const char* key, int32_t defaultValue = 0) { return 0; }
-  uint32_t getUInt(const char* key, uint32_t defaultValue = 0) { return 0; }
-  bool getBool(const char* key, bool defaultValue = false) { return false; }
-  size_t getString(const char* key, char* value, size_t maxLen) { return 0; }
-  String getString(const char* key, String defaultValue = String()) { return String(); }
+  int32_t getInt(const char* key, int32_t defaultValue = 0) { return (int32_t)getNumber(key, INT, defaultValue); }
+  uint32_t getUInt(const char* key, uint32_t defaultValue = 0) { return getNumber(key, UINT, defaultValue); }
+  bool getBool(const char* key, bool defaultValue = false) { return getNumber(key, BOOL, defaultValue) != 0; }
+  size_t getString(const char* key, char* value, size_t maxLen);
+  String getString(const char* key, String defaultValue = String());
+  size_t getBytesLength(const char* key);
+  size_t getBytes(const char* key, void* buf, size_t maxLen);
+
+  // Reads and writes of all Preferences objects, for tests that count NVS accesses
+  static uint32_t reads;
+  static uint32_t writes;
+  // Drop every namespace, as on a freshly erased flash
+  static void erase_all();
+
+ private:
+  enum Type { INT, UINT, BOOL, STRING, BYTES };
+  struct Value {
+    Type type;
+    uint32_t number;
+    std::vector<uint8_t> bytes;
+  };
+
+  size_t putNumber(const char* key, Type type, uint32_t value, size_t size);
+  uint32_t getNumber(const char* key, Type type, uint32_t defaultValue);
+  const Value* find(const char* key, Type type);
+  static std::map<std::string, std::map<std::string, Value>>& namespaces();
+
+  std::map<std::string, Value>* values = nullptr;
+  bool readOnly = false;
 };
 #endif
@@ -1,9 +1,24 @@
 #include "../../Software/src/communication/Transmitter.h"
 #include "../../Software/src/communication/can/comm_can.h"
+#include "../../Software/src/devboard/safety/safety.h"
+#include "virtual_can_bus.h"
 
-void transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface) {}
+// Frames and registrations are dropped unless a VirtualCanBus is attached
 
-void register_can_receiver(CanReceiver* receiver, CAN_Interface interface, CAN_Speed speed) {}
+void transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface, CAN_Tx_Priority priority) {
+  if (VirtualCanBus::active() && allowed_to_send_CAN) {
+    VirtualCanBus::active()->transmit(*tx_frame, interface);
+  }
+}
+
+void drain_can_tx_queues() {}
+
+void register_can_receiver(CanReceiver* receiver, CAN_Interface interface, CAN_Speed speed,
+                           const CAN_ID_Filter& filter) {
+  if (VirtualCanBus::active()) {
+    VirtualCanBus::active()->add_receiver(receiver, interface, filter);
+  }
+}
 
 bool change_can_speed(CAN_Interface interface, CAN_Speed speed) {
   return true;
@@ -17,6 +32,10 @@ char const* getCANInterfaceName(CAN_Interface) {
   return "Foobar";
 }
 
-void register_transmitter(Transmitter* transmitter) {}
+void register_transmitter(Transmitter* transmitter) {
+  if (VirtualCanBus::active()) {
+    VirtualCanBus::active()->add_transmitter(transmitter);
+  }
+}
 
-void dump_can_frame(CAN_frame& frame, CAN_Interface interface, frameDirection msgDir) {}
+void dump_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir) {}
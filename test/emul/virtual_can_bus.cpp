@@ -0,0 +1,204 @@
+#include "virtual_can_bus.h"
+#include "../../Software/src/communication/can/can_dispatch.h"
+
+#include <algorithm>
+
+static VirtualCanBus* active_bus = nullptr;
+
+// Lower values win arbitration. The 11 base ID bits come first, then SRR/RTR and IDE, which are dominant for
+// standard data frames and recessive for extended ones, then the 18 bits of the ID extension.
+static uint32_t arbitration_field(const CAN_frame& frame) {
+  if (frame.ext_ID) {
+    return (((frame.ID >> 18) & 0x7FF) << 20) | (3 << 18) | (frame.ID & 0x3FFFF);
+  }
+  return (frame.ID & 0x7FF) << 20;
+}
+
+VirtualCanBus::VirtualCanBus(const Virtual_CAN_Config& config) : config(config) {
+  for (uint8_t i = 0; i < NO_CAN_INTERFACE; i++) {
+    segment_of[i] = i;
+  }
+  rng_state = config.seed != 0 ? config.seed : 1;
+}
+
+VirtualCanBus::~VirtualCanBus() {
+  detach();
+}
+
+void VirtualCanBus::attach() {
+  active_bus = this;
+}
+
+void VirtualCanBus::detach() {
+  if (active_bus == this) {
+    active_bus = nullptr;
+  }
+}
+
+VirtualCanBus* VirtualCanBus::active() {
+  return active_bus;
+}
+
+void VirtualCanBus::connect(CAN_Interface a, CAN_Interface b) {
+  uint8_t from = segment_of[b];
+  for (auto& segment : segment_of) {
+    if (segment == from) {
+      segment = segment_of[a];
+    }
+  }
+}
+
+void VirtualCanBus::add_receiver(CanReceiver* receiver, CAN_Interface interface, const CAN_ID_Filter& filter) {
+  receivers.push_back({receiver, interface, filter});
+}
+
+void VirtualCanBus::add_transmitter(Transmitter* transmitter) {
+  transmitters.push_back(transmitter);
+}
+
+void VirtualCanBus::transmit(const CAN_frame& frame, CAN_Interface from) {
+  queue(frame, from, from);
+}
+
+void VirtualCanBus::inject(const CAN_frame& frame, CAN_Interface on) {
+  queue(frame, NO_CAN_INTERFACE, on);
+}
+
+void VirtualCanBus::queue(const CAN_frame& frame, CAN_Interface from, CAN_Interface on) {
+  if (on >= NO_CAN_INTERFACE) {
+    return;
+  }
+  Segment& segment = segments[segment_of[on]];
+  if (from != NO_CAN_INTERFACE) {
+    size_t waiting = std::count_if(segment.pending.begin(), segment.pending.end(),
+                                   [from](const Pending& pending) { return pending.from == from; });
+    if (waiting >= config.tx_buffer) {
+      segment.stats.tx_overflows++;
+      return;
+    }
+  }
+  segment.pending.push_back({frame, from, clock_us, sequence++});
+}
+
+uint32_t VirtualCanBus::frame_time_us(const CAN_frame& frame) const {
+  uint32_t bytes = std::min<uint32_t>(frame.DLC, sizeof(frame.data.u8));
+  // SOF up to the CRC is subject to bit stuffing, worst case one stuff bit per four bits after the first
+  uint32_t stuffed = (frame.ext_ID ? 54 : 34) + 8 * bytes;
+  // CRC delimiter, ACK slot and delimiter, end of frame and interframe space
+  uint32_t bits = stuffed + (stuffed - 1) / 4 + 13;
+  return (uint32_t)(((uint64_t)bits * 1000000 + config.bitrate - 1) / config.bitrate);
+}
+
+bool VirtualCanBus::lose_frame() {
+  if (config.loss <= 0) {
+    return false;
+  }
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state / 4294967296.0 < config.loss;
+}
+
+void VirtualCanBus::deliver(uint8_t index, const Pending& pending) {
+  for (const auto& receiver : receivers) {
+    if (segment_of[receiver.interface] != index || receiver.interface == pending.from) {
+      continue;
+    }
+    if (!can_id_filter_accepts(receiver.filter, pending.frame.ID, pending.frame.ext_ID)) {
+      continue;
+    }
+    segments[index].stats.frames_received++;
+    receiver.receiver->receive_can_frame(pending.frame);
+  }
+  if (frame_callback) {
+    frame_callback(pending.frame, pending.from, clock_us);
+  }
+}
+
+uint32_t VirtualCanBus::run_segment(uint8_t index, uint64_t now_us) {
+  Segment& segment = segments[index];
+  uint32_t finished = 0;
+  while (true) {
+    if (segment.busy) {
+      if (segment.busy_until_us > now_us) {
+        break;
+      }
+      segment.busy = false;
+      finished++;
+      if (!segment.on_wire_lost) {
+        // Frames sent by the receivers in response are queued at the time this one finished
+        clock_us = segment.busy_until_us;
+        Pending done = segment.on_wire;
+        deliver(index, done);
+      }
+      continue;
+    }
+    if (segment.pending.empty()) {
+      break;
+    }
+
+    uint64_t start = segment.busy_until_us;
+    uint64_t first_queued = UINT64_MAX;
+    for (const auto& pending : segment.pending) {
+      first_queued = std::min(first_queued, pending.queued_us);
+    }
+    start = std::max(start, first_queued);
+    if (start > now_us) {
+      break;
+    }
+
+    // Every frame waiting when the wire goes idle takes part in arbitration
+    auto winner = segment.pending.end();
+    for (auto it = segment.pending.begin(); it != segment.pending.end(); ++it) {
+      if (it->queued_us > start) {
+        continue;
+      }
+      if (winner == segment.pending.end() ||
+          arbitration_field(it->frame) < arbitration_field(winner->frame) ||
+          (arbitration_field(it->frame) == arbitration_field(winner->frame) && it->sequence < winner->sequence)) {
+        winner = it;
+      }
+    }
+    segment.on_wire = *winner;
+    segment.pending.erase(winner);
+
+    uint32_t duration = frame_time_us(segment.on_wire.frame);
+    segment.busy = true;
+    segment.busy_until_us = start + duration;
+    segment.on_wire_lost = lose_frame();
+    segment.stats.frames_sent++;
+    segment.stats.busy_us += duration;
+    segment.stats.max_wait_us = std::max<uint32_t>(segment.stats.max_wait_us, start - segment.on_wire.queued_us);
+    if (segment.on_wire_lost) {
+      segment.stats.frames_lost++;
+    }
+  }
+  return finished;
+}
+
+void VirtualCanBus::run_until(uint64_t now_us) {
+  // Frames delivered on one segment can make receivers send on another, so repeat until nothing moves
+  uint32_t finished;
+  do {
+    finished = 0;
+    for (uint8_t i = 0; i < NO_CAN_INTERFACE; i++) {
+      if (segment_of[i] == i) {
+        finished += run_segment(i, now_us);
+      }
+    }
+  } while (finished > 0);
+  clock_us = now_us;
+}
+
+void VirtualCanBus::transmit_all(unsigned long currentMillis) {
+  for (auto& transmitter : transmitters) {
+    if (!transmitter->scheduled()) {
+      transmitter->transmit(currentMillis);
+    }
+  }
+  tx_scheduler.run(currentMillis);
+}
+
+const Virtual_CAN_Statistics& VirtualCanBus::statistics(CAN_Interface interface) const {
+  return segments[segment_of[interface]].stats;
+}
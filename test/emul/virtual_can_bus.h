@@ -0,0 +1,120 @@
+#ifndef _VIRTUAL_CAN_BUS_H
+#define _VIRTUAL_CAN_BUS_H
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+#include "../../Software/src/communication/Transmitter.h"
+#include "../../Software/src/communication/can/CanReceiver.h"
+#include "../../Software/src/communication/can/comm_can.h"
+
+typedef struct {
+  /** Bitrate of every segment. CAN-FD frames are timed at this rate as well (no bit rate switch). */
+  uint32_t bitrate = 500000;
+  /** Probability (0-1) that a frame is corrupted on the wire and not received by anyone */
+  double loss = 0.0;
+  /** Seed of the loss generator, runs with the same seed lose the same frames */
+  uint32_t seed = 1;
+  /** Frames an interface can have waiting for the wire before further frames are dropped */
+  uint16_t tx_buffer = 64;
+} Virtual_CAN_Config;
+
+typedef struct {
+  /** Frames that won arbitration and went over the wire, lost ones included */
+  uint64_t frames_sent = 0;
+  /** Frames corrupted on the wire */
+  uint64_t frames_lost = 0;
+  /** Frames handed to receivers, one per receiver */
+  uint64_t frames_received = 0;
+  /** Frames dropped because the sending interface had tx_buffer frames waiting */
+  uint64_t tx_overflows = 0;
+  /** Time the wire was busy */
+  uint64_t busy_us = 0;
+  /** Longest time a frame waited for the wire */
+  uint32_t max_wait_us = 0;
+} Virtual_CAN_Statistics;
+
+// In-process CAN bus for host builds. While a bus is attached, the emulated comm_can functions register receivers
+// and transmitters with it and queue transmitted frames on it instead of dropping them. Frames go over the wire in
+// simulated time: a segment sends one frame at a time, the lowest arbitration field wins, and a frame is received
+// once its last bit is on the wire. Interfaces that are connected form one segment, so a battery and an inverter on
+// different interfaces can talk to each other. The sending interface does not receive its own frames.
+class VirtualCanBus {
+ public:
+  typedef std::function<void(const CAN_frame& frame, CAN_Interface from, uint64_t at_us)> Frame_Callback;
+
+  explicit VirtualCanBus(const Virtual_CAN_Config& config = Virtual_CAN_Config());
+  ~VirtualCanBus();
+
+  // Route the emulated comm_can functions to this bus, until detach() or destruction
+  void attach();
+  void detach();
+  static VirtualCanBus* active();
+
+  // Put two interfaces on the same wire. Every interface starts as a segment of its own.
+  void connect(CAN_Interface a, CAN_Interface b);
+
+  void add_receiver(CanReceiver* receiver, CAN_Interface interface, const CAN_ID_Filter& filter);
+  void add_transmitter(Transmitter* transmitter);
+
+  // Queue a frame sent by the emulator on an interface
+  void transmit(const CAN_frame& frame, CAN_Interface from);
+  // Queue a frame sent by another node on the segment of an interface, every interface of it receives the frame
+  void inject(const CAN_frame& frame, CAN_Interface on);
+
+  // Move the wire forward to now_us, delivering the frames that finish until then
+  void run_until(uint64_t now_us);
+  // Let the transmitters send, the way core_loop does every ms
+  void transmit_all(unsigned long currentMillis);
+
+  // Called for every frame that finished on the wire, lost frames excluded
+  void on_frame(Frame_Callback callback) { frame_callback = callback; }
+
+  uint64_t now_us() const { return clock_us; }
+  // Statistics of the segment the interface belongs to
+  const Virtual_CAN_Statistics& statistics(CAN_Interface interface) const;
+  // Time a frame takes on the wire, worst case bit stuffing and interframe space included
+  uint32_t frame_time_us(const CAN_frame& frame) const;
+
+ private:
+  typedef struct {
+    CAN_frame frame;
+    CAN_Interface from;  // NO_CAN_INTERFACE for injected frames
+    uint64_t queued_us;
+    uint64_t sequence;
+  } Pending;
+
+  typedef struct {
+    std::vector<Pending> pending;
+    bool busy = false;
+    Pending on_wire;
+    bool on_wire_lost = false;
+    uint64_t busy_until_us = 0;
+    Virtual_CAN_Statistics stats;
+  } Segment;
+
+  typedef struct {
+    CanReceiver* receiver;
+    CAN_Interface interface;
+    CAN_ID_Filter filter;
+  } Receiver;
+
+  void queue(const CAN_frame& frame, CAN_Interface from, CAN_Interface on);
+  // Returns the amount of frames that finished on the wire
+  uint32_t run_segment(uint8_t index, uint64_t now_us);
+  void deliver(uint8_t index, const Pending& pending);
+  bool lose_frame();
+
+  Virtual_CAN_Config config;
+  uint8_t segment_of[NO_CAN_INTERFACE];
+  Segment segments[NO_CAN_INTERFACE];
+  std::vector<Receiver> receivers;
+  std::vector<Transmitter*> transmitters;
+  Frame_Callback frame_callback;
+  uint64_t clock_us = 0;
+  uint64_t sequence = 0;
+  uint32_t rng_state;
+};
+
+#endif
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include <string.h>
+#include <vector>
+
+#include "../Software/src/devboard/utils/event_journal.h"
+#include "../Software/src/devboard/utils/events.h"
+
+// Flash in memory with the rules of NOR flash: writes only clear bits, erasing sets a sector back to 0xFF
+class MemoryJournalStorage : public EventJournalStorage {
+ public:
+  explicit MemoryJournalStorage(uint32_t sectors)
+      : bytes(sectors * EVENT_JOURNAL_SECTOR_SIZE, 0xFF), erases(sectors, 0) {}
+
+  uint32_t size() const override { return bytes.size(); }
+  bool read(uint32_t offset, void* out, size_t length) const override {
+    memcpy(out, bytes.data() + offset, length);
+    return true;
+  }
+  bool write(uint32_t offset, const void* data, size_t length) override {
+    const uint8_t* in = (const uint8_t*)data;
+    // A write cut short by a reset leaves only the first bytes behind
+    size_t written = length < torn_write_limit ? length : torn_write_limit;
+    for (size_t i = 0; i < written; i++) {
+      bytes[offset + i] &= in[i];
+    }
+    return written == length;
+  }
+  bool erase_sector(uint32_t offset) override {
+    memset(bytes.data() + offset, 0xFF, EVENT_JOURNAL_SECTOR_SIZE);
+    erases[offset / EVENT_JOURNAL_SECTOR_SIZE]++;
+    return true;
+  }
+
+  std::vector<uint8_t> bytes;
+  std::vector<uint32_t> erases;
+  size_t torn_write_limit = SIZE_MAX;
+};
+
+static Event_Journal_Record make_record(uint8_t event, uint8_t data) {
+  Event_Journal_Record record = {};
+  record.timestamp_ms = 1000 + event;
+  record.event = event;
+  record.data = data;
+  record.kind = EVENT_JOURNAL_SET;
+  record.level = EVENT_LEVEL_WARNING;
+  return record;
+}
+
+static std::vector<Event_Journal_Record> all_records(const EventJournal& journal) {
+  std::vector<Event_Journal_Record> records;
+  journal.visit(0, [&](const Event_Journal_Record& record) { records.push_back(record); });
+  return records;
+}
+
+static const uint32_t records_per_sector = EVENT_JOURNAL_SECTOR_SIZE / sizeof(Event_Journal_Record);
+
+TEST(EventJournal, KeepsRecordsOverRemount) {
+  MemoryJournalStorage flash(4);
+  {
+    EventJournal journal;
+    ASSERT_TRUE(journal.mount(&flash));
+    EXPECT_EQ(journal.boot(), 1);
+    EXPECT_EQ(journal.next_sequence(), 1u);
+    for (uint8_t i = 0; i < 10; i++) {
+      Event_Journal_Record record = make_record(i, i * 2);
+      record.boot = journal.boot();
+      ASSERT_TRUE(journal.append(record));
+    }
+  }
+
+  // A reboot mounts the same flash and continues after the last record
+  EventJournal journal;
+  ASSERT_TRUE(journal.mount(&flash));
+  EXPECT_EQ(journal.boot(), 2);
+  EXPECT_EQ(journal.next_sequence(), 11u);
+  std::vector<Event_Journal_Record> records = all_records(journal);
+  ASSERT_EQ(records.size(), 10u);
+  EXPECT_EQ(records[0].sequence, 1u);
+  EXPECT_EQ(records[9].sequence, 10u);
+  EXPECT_EQ(records[9].data, 18);
+  EXPECT_EQ(records[9].boot, 1);
+  EXPECT_EQ(records[9].timestamp_ms, 1009u);
+
+  Event_Journal_Record record = make_record(42, 1);
+  ASSERT_TRUE(journal.append(record));
+  EXPECT_EQ(record.sequence, 11u);
+
+  uint32_t visited = 0;
+  journal.visit(9, [&](const Event_Journal_Record& r) { visited++; });
+  EXPECT_EQ(visited, 3u);
+}
+
+TEST(EventJournal, WrapsAroundAndLevelsWear) {
+  MemoryJournalStorage flash(4);
+  EventJournal journal;
+  ASSERT_TRUE(journal.mount(&flash));
+  EXPECT_EQ(journal.capacity(), 4 * records_per_sector);
+
+  const uint32_t total = 20 * records_per_sector + 7;
+  for (uint32_t i = 0; i < total; i++) {
+    Event_Journal_Record record = make_record(i % 100, 0);
+    if (journal.full()) {
+      ASSERT_TRUE(journal.erase_ahead());
+    }
+    ASSERT_TRUE(journal.append(record));
+  }
+
+  // The oldest sector is erased for the newest records, the rest is kept in order
+  std::vector<Event_Journal_Record> records = all_records(journal);
+  ASSERT_EQ(records.size(), 3 * records_per_sector + 7);
+  for (size_t i = 1; i < records.size(); i++) {
+    ASSERT_EQ(records[i].sequence, records[i - 1].sequence + 1);
+  }
+  EXPECT_EQ(records.back().sequence, total);
+
+  uint32_t least = UINT32_MAX, most = 0;
+  for (uint32_t erases : flash.erases) {
+    least = std::min(least, erases);
+    most = std::max(most, erases);
+  }
+  EXPECT_LE(most - least, 1u);
+
+  EventJournal remounted;
+  ASSERT_TRUE(remounted.mount(&flash));
+  EXPECT_EQ(remounted.next_sequence(), total + 1);
+}
+
+TEST(EventJournal, AppendsOnlyIntoSectorsErasedAhead) {
+  MemoryJournalStorage flash(4);
+  memset(flash.bytes.data(), 0, flash.bytes.size());  // Left over from something else
+  EventJournal journal;
+  ASSERT_TRUE(journal.mount(&flash));
+  // The first sector and the reserve after it are erased at mount
+  EXPECT_EQ(flash.erases, std::vector<uint32_t>({1, 1, 1, 0}));
+  EXPECT_FALSE(journal.erase_ahead());  // Reserve complete
+
+  for (uint32_t i = 0; i < 3 * records_per_sector; i++) {
+    Event_Journal_Record record = make_record(1, 0);
+    ASSERT_TRUE(journal.append(record));
+  }
+  EXPECT_EQ(flash.erases, std::vector<uint32_t>({1, 1, 1, 0}));
+
+  // With the reserve used up the records wait in the queue instead of append() erasing
+  static Event_Journal_Pending pending;
+  EventJournalQueue queue(pending);
+  queue.recover();
+  Event_Journal_Record record = make_record(2, 0);
+  ASSERT_TRUE(queue.push(record));
+  EXPECT_TRUE(journal.full());
+  EXPECT_FALSE(journal.append(record));
+  EXPECT_EQ(queue.flush(journal, false), 0u);
+  EXPECT_EQ(queue.queued(), 1u);
+
+  EXPECT_TRUE(journal.erase_ahead());
+  EXPECT_EQ(flash.erases[3], 1u);
+  EXPECT_EQ(queue.flush(journal, false), 1u);
+  EXPECT_EQ(all_records(journal).size(), 3 * records_per_sector + 1);
+
+  // A reboot erases the rest of the reserve again, the sectors after the newest one hold the oldest records
+  EventJournal remounted;
+  ASSERT_TRUE(remounted.mount(&flash));
+  EXPECT_EQ(remounted.next_sequence(), 3 * records_per_sector + 2);
+  EXPECT_EQ(flash.erases, std::vector<uint32_t>({2, 2, 1, 1}));
+  EXPECT_EQ(all_records(remounted).size(), records_per_sector + 1);
+
+  // An erased reserve is kept as it is
+  EventJournal again;
+  ASSERT_TRUE(again.mount(&flash));
+  EXPECT_EQ(flash.erases, std::vector<uint32_t>({2, 2, 1, 1}));
+}
+
+TEST(EventJournal, SkipsTornRecord) {
+  MemoryJournalStorage flash(2);
+  EventJournal journal;
+  ASSERT_TRUE(journal.mount(&flash));
+  Event_Journal_Record first = make_record(1, 0);
+  ASSERT_TRUE(journal.append(first));
+
+  // Reset in the middle of writing the second record
+  flash.torn_write_limit = 10;
+  Event_Journal_Record torn = make_record(2, 0);
+  EXPECT_FALSE(journal.append(torn));
+  flash.torn_write_limit = SIZE_MAX;
+
+  EventJournal remounted;
+  ASSERT_TRUE(remounted.mount(&flash));
+  EXPECT_EQ(remounted.next_sequence(), 2u);
+  Event_Journal_Record third = make_record(3, 0);
+  ASSERT_TRUE(remounted.append(third));
+
+  std::vector<Event_Journal_Record> records = all_records(remounted);
+  ASSERT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[0].event, 1);
+  EXPECT_EQ(records[1].event, 3);
+  EXPECT_EQ(records[1].sequence, 2u);
+}
+
+TEST(EventJournal, QueueSurvivesReset) {
+  MemoryJournalStorage flash(2);
+  static Event_Journal_Pending pending;  // Stands in for the memory that survives the reset
+  memset((void*)&pending, 0x5A, sizeof(pending));
+
+  {
+    EventJournalQueue queue(pending);
+    EXPECT_EQ(queue.recover(), 0u);  // Left over from power-on
+    for (uint8_t i = 0; i < 5; i++) {
+      Event_Journal_Record record = make_record(i, 0);
+      record.boot = 7;
+      ASSERT_TRUE(queue.push(record));
+    }
+    // The writer of the last record is interrupted by the reset
+    pending.slots[4].stamp.store(0);
+    // Nothing reaches the flash before the reset
+  }
+
+  EventJournal journal;
+  ASSERT_TRUE(journal.mount(&flash));
+  EventJournalQueue queue(pending);
+  EXPECT_EQ(queue.recover(), 5u);
+  EXPECT_EQ(queue.flush(journal, true), 4u);
+  EXPECT_EQ(queue.queued(), 0u);
+
+  std::vector<Event_Journal_Record> records = all_records(journal);
+  ASSERT_EQ(records.size(), 4u);
+  EXPECT_EQ(records[3].event, 3);
+  EXPECT_EQ(records[3].boot, 7);  // Still the boot the event happened in
+}
+
+TEST(EventJournal, QueueWaitsForUnfinishedRecordsAndDropsWhenFull) {
+  MemoryJournalStorage flash(2);
+  static Event_Journal_Pending pending;
+  EventJournalQueue queue(pending);
+  queue.recover();
+  EventJournal journal;
+  ASSERT_TRUE(journal.mount(&flash));
+
+  for (uint32_t i = 0; i < EVENT_JOURNAL_PENDING_SLOTS; i++) {
+    ASSERT_TRUE(queue.push(make_record(i, 0)));
+  }
+  EXPECT_FALSE(queue.push(make_record(1, 0)));
+  EXPECT_EQ(queue.dropped(), 1u);
+
+  // A record still being written holds up the ones after it
+  pending.slots[10].stamp.store(0);
+  EXPECT_EQ(queue.flush(journal, false), 10u);
+  EXPECT_EQ(queue.queued(), EVENT_JOURNAL_PENDING_SLOTS - 10);
+  pending.slots[10].stamp.store(11);
+  EXPECT_EQ(queue.flush(journal, false), EVENT_JOURNAL_PENDING_SLOTS - 10);
+  EXPECT_EQ(journal.next_sequence(), EVENT_JOURNAL_PENDING_SLOTS + 1);
+}
+
+TEST(Events, LevelFollowsActiveEvents) {
+  init_events();
+  reset_all_events();
+  EXPECT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+
+  set_event(EVENT_CONTACTOR_OPEN, 0);  // Warning
+  EXPECT_EQ(get_event_level(), EVENT_LEVEL_WARNING);
+  set_event(EVENT_WATER_INGRESS, 0);  // Error
+  set_event(EVENT_WATER_INGRESS, 1);  // Again, still counted once
+  EXPECT_EQ(get_event_level(), EVENT_LEVEL_ERROR);
+  set_event_latched(EVENT_12V_LOW, 0);  // Warning
+  EXPECT_EQ(get_emulator_status(), STATUS_ERROR);
+
+  clear_event(EVENT_WATER_INGRESS);
+  EXPECT_EQ(get_event_level(), EVENT_LEVEL_WARNING);
+  clear_event(EVENT_WATER_INGRESS);  // Already cleared
+  clear_event(EVENT_CONTACTOR_OPEN);
+  // Latched events stay until all events are reset
+  clear_event(EVENT_12V_LOW);
+  EXPECT_EQ(get_event_level(), EVENT_LEVEL_WARNING);
+
+  reset_all_events();
+  EXPECT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+  set_event(EVENT_CONTACTOR_OPEN, 0);
+  clear_event(EVENT_CONTACTOR_OPEN);
+  EXPECT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+  reset_all_events();
+}
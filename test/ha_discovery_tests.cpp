@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../Software/src/devboard/mqtt/ha_discovery.h"
+
+// A broker that retains configs and an outbox that is drained between runs
+class FakeBroker {
+ public:
+  HaDiscoveryPublisher::Publish publish() {
+    return [this](const char* topic, const char* payload) {
+      if (fail_after == 0) {
+        return false;
+      }
+      fail_after--;
+      retained[topic] = payload;
+      sent.push_back(topic);
+      outbox += strlen(payload);
+      return true;
+    };
+  }
+  HaDiscoveryPublisher::OutboxSize outbox_size() {
+    return [this]() { return outbox; };
+  }
+
+  std::map<std::string, std::string> retained;
+  std::vector<std::string> sent;
+  size_t outbox = 0;
+  int fail_after = 1000000;
+};
+
+static void add_cells(HaDiscoveryPublisher& publisher, size_t* cells, uint32_t stored_digest, int* builds = nullptr) {
+  publisher.add_group(
+      "cells", [cells]() { return *cells; },
+      [builds](size_t index, std::string& topic, std::string& payload) {
+        if (builds) {
+          (*builds)++;
+        }
+        topic = "homeassistant/sensor/BE/cell" + std::to_string(index + 1) + "/config";
+        payload = "{\"name\":\"Cell " + std::to_string(index + 1) + "\"}";
+        return true;
+      },
+      stored_digest);
+}
+
+TEST(HaDiscoveryTests, PacedPublishing) {
+  FakeBroker broker;
+  size_t cells = 20;
+  HaDiscoveryPublisher publisher(1, 8, 32, 1000);
+  add_cells(publisher, &cells, 0);
+
+  EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+  EXPECT_EQ(broker.sent.size(), 8u);
+  EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+  EXPECT_EQ(broker.sent.size(), 16u);
+  EXPECT_TRUE(publisher.run(broker.publish(), broker.outbox_size()));
+  EXPECT_EQ(broker.sent.size(), 20u);
+  EXPECT_EQ(broker.sent.front(), "homeassistant/sensor/BE/cell1/config");
+  EXPECT_EQ(broker.sent.back(), "homeassistant/sensor/BE/cell20/config");
+  EXPECT_EQ(publisher.statistics().published, 20u);
+  EXPECT_TRUE(publisher.done());
+}
+
+TEST(HaDiscoveryTests, FullOutboxDefers) {
+  FakeBroker broker;
+  size_t cells = 20;
+  HaDiscoveryPublisher publisher(1, 100, 100, 100);
+  add_cells(publisher, &cells, 0);
+
+  // The first configs are 17 bytes, the run stops once the outbox is over the limit
+  EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+  EXPECT_EQ(broker.sent.size(), 6u);
+  EXPECT_EQ(publisher.statistics().deferred, 1u);
+  EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+  EXPECT_EQ(broker.sent.size(), 6u);
+
+  broker.outbox = 0;
+  EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+  EXPECT_EQ(broker.sent.size(), 12u);
+}
+
+TEST(HaDiscoveryTests, FailedPublishResumes) {
+  FakeBroker broker;
+  size_t cells = 10;
+  HaDiscoveryPublisher publisher(1, 100, 100, 100000);
+  add_cells(publisher, &cells, 0);
+
+  broker.fail_after = 4;
+  EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+  EXPECT_EQ(publisher.statistics().failed, 1u);
+  broker.fail_after = 1000;
+  EXPECT_TRUE(publisher.run(broker.publish(), broker.outbox_size()));
+
+  // Continued with cell 5 instead of starting over
+  ASSERT_EQ(broker.sent.size(), 10u);
+  EXPECT_EQ(broker.sent[4], "homeassistant/sensor/BE/cell5/config");
+}
+
+TEST(HaDiscoveryTests, WaitsForCount) {
+  FakeBroker broker;
+  size_t cells = 0, buttons = 2;
+  HaDiscoveryPublisher publisher(1, 100, 100, 100000);
+  add_cells(publisher, &cells, 0);
+  publisher.add_group(
+      "buttons", [&buttons]() { return buttons; },
+      [](size_t index, std::string& topic, std::string& payload) {
+        topic = "button" + std::to_string(index);
+        payload = "{}";
+        return index != 1;  // Second button does not apply
+      },
+      0);
+
+  // Later groups go ahead while the cell count is unknown
+  EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+  EXPECT_EQ(broker.sent, (std::vector<std::string>{"button0"}));
+
+  cells = 3;
+  EXPECT_TRUE(publisher.run(broker.publish(), broker.outbox_size()));
+  EXPECT_EQ(broker.sent.size(), 4u);
+}
+
+TEST(HaDiscoveryTests, UnchangedGroupIsSkippedAfterRestart) {
+  FakeBroker broker;
+  size_t cells = 20;
+  std::map<std::string, uint32_t> stored;
+  {
+    HaDiscoveryPublisher publisher(1, 100, 100, 100000);
+    publisher.on_group_published = [&stored](const char* name, uint32_t digest) { stored[name] = digest; };
+    add_cells(publisher, &cells, 0);
+    EXPECT_TRUE(publisher.run(broker.publish(), broker.outbox_size()));
+    ASSERT_NE(stored["cells"], 0u);
+  }
+  broker.sent.clear();
+
+  // Same configs: verified in budgeted steps without publishing
+  {
+    int builds = 0;
+    HaDiscoveryPublisher publisher(1, 100, 8, 100000);
+    add_cells(publisher, &cells, stored["cells"], &builds);
+    EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+    EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+    EXPECT_TRUE(publisher.run(broker.publish(), broker.outbox_size()));
+    EXPECT_EQ(builds, 20);
+    EXPECT_TRUE(broker.sent.empty());
+    EXPECT_EQ(publisher.statistics().skipped, 20u);
+
+    // Home Assistant came back online without the configs
+    publisher.restart();
+    EXPECT_FALSE(publisher.done());
+    EXPECT_FALSE(publisher.run(broker.publish(), broker.outbox_size()));
+    EXPECT_EQ(broker.sent.size(), 8u);
+  }
+  broker.sent.clear();
+
+  // More cells, or another broker, publish everything again
+  cells = 21;
+  {
+    HaDiscoveryPublisher publisher(1, 100, 100, 100000);
+    add_cells(publisher, &cells, stored["cells"]);
+    EXPECT_TRUE(publisher.run(broker.publish(), broker.outbox_size()));
+    EXPECT_EQ(broker.sent.size(), 21u);
+  }
+  broker.sent.clear();
+  cells = 20;
+  {
+    HaDiscoveryPublisher publisher(2, 100, 100, 100000);
+    add_cells(publisher, &cells, stored["cells"]);
+    EXPECT_TRUE(publisher.run(broker.publish(), broker.outbox_size()));
+    EXPECT_EQ(broker.sent.size(), 20u);
+  }
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "../Software/src/devboard/webserver/html_chunked_page.h"
+
+// Reads the whole page through a response buffer of the given size
+static std::string read_page(HtmlChunkedPage& page, size_t buffer_size) {
+  std::string result;
+  uint8_t buffer[512];
+  size_t length;
+  while ((length = page.fill(buffer, buffer_size)) > 0) {
+    EXPECT_LE(length, buffer_size);
+    result.append((const char*)buffer, length);
+  }
+  return result;
+}
+
+static void build_page(HtmlChunkedPage& page, int& renders) {
+  page.text("<html><body>")
+      .section([&renders](String& out) {
+        renders++;
+        out += "<h4>SOC: ";
+        out += String(55);
+        out += "</h4>";
+      })
+      .section([&renders](String& out) { renders++; })
+      .text("")
+      .section([&renders](String& out) {
+        renders++;
+        out += std::string(300, 'x');
+      })
+      .text("</body></html>");
+}
+
+TEST(HtmlChunkedPage, StreamsPartsInOrder) {
+  const std::string expected = "<html><body><h4>SOC: 55</h4>" + std::string(300, 'x') + "</body></html>";
+  for (size_t buffer_size : {1, 7, 64, 512}) {
+    HtmlChunkedPage page;
+    int renders = 0;
+    build_page(page, renders);
+    EXPECT_EQ(read_page(page, buffer_size), expected) << "buffer " << buffer_size;
+    EXPECT_EQ(renders, 3);
+  }
+}
+
+TEST(HtmlChunkedPage, RendersSectionsLazily) {
+  HtmlChunkedPage page;
+  int renders = 0;
+  build_page(page, renders);
+  EXPECT_EQ(renders, 0);
+
+  uint8_t buffer[8];
+  EXPECT_EQ(page.fill(buffer, sizeof(buffer)), 8u);
+  EXPECT_EQ(renders, 0);  // Still sending the first text
+  EXPECT_EQ(page.fill(buffer, sizeof(buffer)), 8u);
+  EXPECT_EQ(renders, 1);
+}
+
+TEST(HtmlChunkedPage, RecordsLargestSection) {
+  html_render_statistics = {};
+  HtmlChunkedPage page;
+  int renders = 0;
+  build_page(page, renders);
+  std::string result = read_page(page, 100);
+
+  EXPECT_EQ(html_render_statistics.pages, 1u);
+  EXPECT_EQ(html_render_statistics.bytes_last_page, result.size());
+  EXPECT_EQ(html_render_statistics.largest_section_last_page, 300u);
+  EXPECT_EQ(html_render_statistics.largest_section, 300u);
+
+  // Further calls after the end neither send anything nor count the page again
+  uint8_t buffer[8];
+  EXPECT_EQ(page.fill(buffer, sizeof(buffer)), 0u);
+  EXPECT_EQ(html_render_statistics.pages, 1u);
+
+  HtmlChunkedPage small;
+  small.section([](String& out) { out += "tiny"; });
+  EXPECT_EQ(read_page(small, 100), "tiny");
+  EXPECT_EQ(html_render_statistics.pages, 2u);
+  EXPECT_EQ(html_render_statistics.largest_section_last_page, 4u);
+  EXPECT_EQ(html_render_statistics.largest_section, 300u);
+}
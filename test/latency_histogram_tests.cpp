@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "../Software/src/devboard/utils/latency_histogram.h"
+
+class LatencyHistogramTests : public testing::Test {
+ protected:
+  void SetUp() override { latency_histogram_reset(histogram); }
+  Latency_Histogram histogram;
+};
+
+TEST_F(LatencyHistogramTests, BucketsArePowersOfTwo) {
+  EXPECT_EQ(latency_histogram_bucket(0), 0);
+  EXPECT_EQ(latency_histogram_bucket(1), 1);
+  EXPECT_EQ(latency_histogram_bucket(2), 2);
+  EXPECT_EQ(latency_histogram_bucket(3), 2);
+  EXPECT_EQ(latency_histogram_bucket(4), 3);
+  EXPECT_EQ(latency_histogram_bucket(1023), 10);
+  EXPECT_EQ(latency_histogram_bucket(1024), 11);
+  EXPECT_EQ(latency_histogram_bucket(UINT32_MAX), LATENCY_HISTOGRAM_BUCKETS - 1);
+
+  for (uint8_t bucket = 1; bucket < LATENCY_HISTOGRAM_BUCKETS - 1; bucket++) {
+    uint32_t limit = latency_histogram_bucket_limit_us(bucket);
+    EXPECT_EQ(latency_histogram_bucket(limit), bucket);
+    EXPECT_EQ(latency_histogram_bucket(limit + 1), bucket + 1);
+  }
+}
+
+TEST_F(LatencyHistogramTests, PercentilesFollowDistribution) {
+  EXPECT_EQ(latency_histogram_percentile(histogram, 50), 0u);
+
+  // 98 fast iterations, one slow and one very slow
+  for (int i = 0; i < 98; i++) {
+    latency_histogram_record(histogram, 20);
+  }
+  latency_histogram_record(histogram, 900);
+  latency_histogram_record(histogram, 5000);
+
+  EXPECT_EQ(latency_histogram_count(histogram), 100u);
+  EXPECT_EQ(latency_histogram_percentile(histogram, 50), 31u);
+  EXPECT_EQ(latency_histogram_percentile(histogram, 98), 31u);
+  EXPECT_EQ(latency_histogram_percentile(histogram, 99), 1023u);
+  EXPECT_EQ(latency_histogram_percentile(histogram, 100), 5000u);  // Capped at the maximum
+  EXPECT_EQ(histogram.max_us.load(), 5000u);
+}
+
+TEST_F(LatencyHistogramTests, NegativeAndHugeDurationsAreClamped) {
+  latency_histogram_record(histogram, -5);
+  latency_histogram_record(histogram, 1LL << 40);
+  EXPECT_EQ(histogram.buckets[0].load(), 1u);
+  EXPECT_EQ(histogram.buckets[LATENCY_HISTOGRAM_BUCKETS - 1].load(), 1u);
+  EXPECT_EQ(histogram.max_us.load(), UINT32_MAX);
+}
+
+TEST_F(LatencyHistogramTests, ConcurrentRecordingLosesNothing) {
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([this, t]() {
+      for (int i = 0; i < 100000; i++) {
+        latency_histogram_record(histogram, (i % 1000) + t);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(latency_histogram_count(histogram), 400000u);
+  EXPECT_EQ(histogram.max_us.load(), 1002u);
+}
+
+TEST_F(LatencyHistogramTests, JsonListsEveryStage) {
+  latency_histograms_reset();
+  latency_histogram_record(latency_histograms[LATENCY_CORE_COMM], 3);
+  latency_histogram_record(latency_histograms[LATENCY_CORE_COMM], 40);
+
+  JsonDocument doc;
+  latency_histograms_to_json(doc.to<JsonObject>());
+
+  EXPECT_EQ(doc["bucket_limit_us"].size(), (size_t)LATENCY_HISTOGRAM_BUCKETS - 1);
+  JsonObject comm = doc["stages"]["core_comm"];
+  EXPECT_EQ(comm["count"].as<uint32_t>(), 2u);
+  EXPECT_EQ(comm["max"].as<uint32_t>(), 40u);
+  EXPECT_EQ(comm["p50"].as<uint32_t>(), 3u);
+  EXPECT_EQ(comm["buckets"].size(), 7u);  // Up to the bucket holding 40 us
+  for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+    EXPECT_TRUE(doc["stages"][latency_stage_name((Latency_Stage)s)].is<JsonObject>());
+  }
+  EXPECT_EQ(doc["stages"]["mqtt_loop"]["count"].as<uint32_t>(), 0u);
+  latency_histograms_reset();
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Software/src/devboard/utils/log_ring.h"
+
+static std::vector<std::string> ring_lines(const LogRing& ring) {
+  std::vector<std::string> lines;
+  ring.visit([&lines](const char* line, size_t length) { lines.emplace_back(line, length); });
+  return lines;
+}
+
+class LogRingTests : public testing::Test {
+ protected:
+  static constexpr uint32_t slot_count = 16;
+  Log_Ring_Slot slots[slot_count] = {};
+  LogRing ring{slots, slot_count};
+};
+
+TEST_F(LogRingTests, StartsEmpty) {
+  EXPECT_TRUE(ring.empty());
+  EXPECT_TRUE(ring_lines(ring).empty());
+  EXPECT_EQ(ring.capacity(), slot_count * LOG_RING_SLOT_TEXT);
+}
+
+TEST_F(LogRingTests, LinesSpanningSeveralSlotsComeBackWhole) {
+  std::string short_line = "RX0 123 [2] 01 02";
+  std::string long_line(LOG_RING_SLOT_TEXT * 3 + 5, 'x');
+  ring.write_line(short_line.c_str(), short_line.size());
+  ring.write_line(long_line.c_str(), long_line.size());
+  ring.write_line("", 0);
+
+  EXPECT_FALSE(ring.empty());
+  EXPECT_EQ(ring_lines(ring), std::vector<std::string>({short_line, long_line, ""}));
+}
+
+TEST_F(LogRingTests, WrapsAroundKeepingNewestLines) {
+  for (int i = 0; i < 100; i++) {
+    std::string line = "line " + std::to_string(i) + std::string(i % 40, '.');
+    ring.write_line(line.c_str(), line.size());
+  }
+
+  auto lines = ring_lines(ring);
+  ASSERT_FALSE(lines.empty());
+  EXPECT_EQ(lines.back(), "line 99" + std::string(99 % 40, '.'));
+
+  // Lines are contiguous and in order, the oldest partially overwritten line is left out
+  int expected = 100 - (int)lines.size();
+  for (const auto& line : lines) {
+    EXPECT_EQ(line, "line " + std::to_string(expected) + std::string(expected % 40, '.'));
+    expected++;
+  }
+}
+
+TEST_F(LogRingTests, ClearDropsOlderLines) {
+  ring.write_line("old", 3);
+  ring.clear();
+  EXPECT_TRUE(ring.empty());
+  ring.write_line("new", 3);
+  EXPECT_EQ(ring_lines(ring), std::vector<std::string>({"new"}));
+}
+
+TEST_F(LogRingTests, AppendAssemblesLinesPerProducer) {
+  int task_a, task_b;
+  ring.append(&task_a, "Battery ", 8, 1234);
+  ring.append(&task_b, "MQTT connected\r\n", 16, 1500);
+  ring.append(&task_a, "voltage 400V\nsecond", 19, 2000);
+  ring.append(&task_a, " line\n", 6, 2001);
+
+  EXPECT_EQ(ring_lines(ring), std::vector<std::string>({"       1.500 MQTT connected", "       1.234 Battery voltage 400V",
+                                                        "       2.000 second line"}));
+}
+
+TEST_F(LogRingTests, AppendSplitsOverlongLines) {
+  int task;
+  std::string text(LOG_RING_LINE_MAX + 10, 'y');
+  text += '\n';
+  ring.append(&task, text.c_str(), text.size(), 0);
+
+  auto lines = ring_lines(ring);
+  ASSERT_EQ(lines.size(), 2u);
+  EXPECT_EQ(lines[0].size(), (size_t)LOG_RING_LINE_MAX);
+  EXPECT_EQ(lines[0].substr(0, 13), "       0.000 ");
+  EXPECT_EQ(lines[0].size() - 13 + lines[1].size() - 13, LOG_RING_LINE_MAX + 10u);
+}
+
+TEST_F(LogRingTests, AppendWithoutFreeProducerEntryStillLogs) {
+  int tasks[LOG_RING_PRODUCERS + 1];
+  for (auto& task : tasks) {
+    ring.append(&task, "partial", 7, 0);
+  }
+  // The last task found no free entry, so its fragment became a line right away
+  EXPECT_EQ(ring_lines(ring), std::vector<std::string>({"partial"}));
+}
+
+TEST_F(LogRingTests, FinishedLinesReleaseTheirProducerEntry) {
+  // Many short-lived tasks, each logging complete lines, never run out of entries
+  std::vector<int> tasks(LOG_RING_PRODUCERS * 4);
+  for (auto& task : tasks) {
+    ring.append(&task, "started\n", 8, 0);
+  }
+  int last_task;
+  ring.append(&last_task, "partial", 7, 0);
+  ring.append(&last_task, " line\n", 6, 0);
+  EXPECT_EQ(ring_lines(ring).back(), "       0.000 partial line");
+}
+
+// Writers on several threads keep overwriting the ring while a reader takes snapshots. Every line the reader
+// sees must be complete and each writer's lines must appear in the order they were written.
+TEST(LogRingStressTests, ConcurrentWritersNeverTearLines) {
+  static Log_Ring_Slot slots[64];
+  static LogRing ring(slots, 64);
+  constexpr int writers = 3;
+  constexpr int lines_per_writer = 20000;
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> threads;
+  for (int w = 0; w < writers; w++) {
+    threads.emplace_back([w]() {
+      for (int i = 0; i < lines_per_writer; i++) {
+        // Length varies so lines span a varying amount of slots
+        std::string line = std::to_string(w) + ":" + std::to_string(i) + ":" + std::string(i % 70, 'a' + w) + "#";
+        ring.write_line(line.c_str(), line.size());
+      }
+    });
+  }
+
+  int snapshots = 0;
+  int checked = 0;
+  std::thread reader([&]() {
+    while (!done.load()) {
+      int last_seen[writers] = {-1, -1, -1};
+      ring.visit([&](const char* text, size_t length) {
+        std::string line(text, length);
+        int w = -1, i = -1;
+        ASSERT_EQ(sscanf(line.c_str(), "%d:%d:", &w, &i), 2) << line;
+        ASSERT_TRUE(w >= 0 && w < writers) << line;
+        std::string expected = std::to_string(w) + ":" + std::to_string(i) + ":" + std::string(i % 70, 'a' + w) + "#";
+        ASSERT_EQ(line, expected);
+        ASSERT_GT(i, last_seen[w]);
+        last_seen[w] = i;
+        checked++;
+      });
+      snapshots++;
+    }
+  });
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  done = true;
+  reader.join();
+
+  EXPECT_GT(snapshots, 0);
+  auto lines = ring_lines(ring);
+  EXPECT_FALSE(lines.empty());
+  std::cout << "[ LOGRING  ] " << snapshots << " snapshots, " << checked << " lines verified" << std::endl;
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../Software/src/devboard/mqtt/mqtt_cells.h"
+#include "../Software/src/lib/bblanchon-ArduinoJson/ArduinoJson.h"
+
+static std::vector<uint16_t> pack_of(size_t cells) {
+  std::vector<uint16_t> values(cells);
+  for (size_t i = 0; i < cells; i++) {
+    values[i] = 3600 + (i * 37) % 250;
+  }
+  return values;
+}
+
+static std::string encode(MqttCellFormat format, const std::vector<uint16_t>& cells, size_t chunk) {
+  char out[MQTT_CELL_CHUNK_MAX_SIZE];
+  size_t size = mqtt_encode_cell_chunk(format, cells.data(), cells.size(), chunk, out, sizeof(out));
+  return std::string(out, size);
+}
+
+static std::vector<uint16_t> base64_decode(const std::string& text) {
+  static const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::vector<uint8_t> bytes;
+  uint32_t bits = 0;
+  int bit_count = 0;
+  for (char c : text) {
+    if (c == '=') {
+      break;
+    }
+    bits = (bits << 6) | alphabet.find(c);
+    bit_count += 6;
+    if (bit_count >= 8) {
+      bit_count -= 8;
+      bytes.push_back((bits >> bit_count) & 0xFF);
+    }
+  }
+  std::vector<uint16_t> values;
+  for (size_t i = 0; i + 1 < bytes.size(); i += 2) {
+    values.push_back((bytes[i] << 8) | bytes[i + 1]);
+  }
+  return values;
+}
+
+// Evaluates the "a.find(s[N]) // D % M * S + ..." expression of a base64 value template
+static uint32_t evaluate_base64_template(const std::string& value_template, const std::string& packed) {
+  static const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  size_t start = value_template.find("{{ (") + 4;
+  std::string expression = value_template.substr(start, value_template.find(") / 1000 }}") - start);
+  uint32_t value = 0;
+  size_t pos = 0;
+  while ((pos = expression.find("a.find(s[", pos)) != std::string::npos) {
+    pos += 9;
+    uint32_t term = alphabet.find(packed[std::stoul(expression.substr(pos))]);
+    pos = expression.find("])", pos) + 2;
+    while (pos < expression.size() && expression.compare(pos, 3, " + ") != 0) {
+      std::string op = expression.substr(pos + 1, expression.find(' ', pos + 1) - pos - 1);
+      pos += op.size() + 2;
+      uint32_t operand = std::stoul(expression.substr(pos));
+      pos = expression.find(' ', pos);
+      pos = pos == std::string::npos ? expression.size() : pos;
+      term = op == "//" ? term / operand : op == "%" ? term % operand : term * operand;
+    }
+    value += term;
+  }
+  return value;
+}
+
+TEST(MqttCellsTests, ChunkCount) {
+  EXPECT_EQ(mqtt_cell_chunk_count(0), 0u);
+  EXPECT_EQ(mqtt_cell_chunk_count(1), 1u);
+  EXPECT_EQ(mqtt_cell_chunk_count(MQTT_CELLS_PER_CHUNK), 1u);
+  EXPECT_EQ(mqtt_cell_chunk_count(MQTT_CELLS_PER_CHUNK + 1), 2u);
+  EXPECT_EQ(mqtt_cell_chunk_count(192), 4u);
+}
+
+TEST(MqttCellsTests, Millivolts) {
+  std::vector<uint16_t> cells = {3712, 3699, 3701};
+  EXPECT_EQ(encode(MqttCellFormat::Millivolts, cells, 0), "{\"first\":0,\"cell_voltages_mV\":[3712,3699,3701]}");
+  EXPECT_EQ(encode(MqttCellFormat::Millivolts, cells, 1), "");
+}
+
+TEST(MqttCellsTests, DeltaFromMin) {
+  std::vector<uint16_t> cells = {3712, 3699, 3701};
+  EXPECT_EQ(encode(MqttCellFormat::DeltaFromMin, cells, 0), "{\"first\":0,\"min_mV\":3699,\"delta_mV\":[13,0,2]}");
+}
+
+TEST(MqttCellsTests, Base64) {
+  std::vector<uint16_t> cells = {3712, 3699, 3701};
+  EXPECT_EQ(encode(MqttCellFormat::Base64, cells, 0), "{\"first\":0,\"count\":3,\"packed_mV\":\"DoAOcw51\"}");
+  cells.push_back(4200);
+  EXPECT_EQ(encode(MqttCellFormat::Base64, cells, 0), "{\"first\":0,\"count\":4,\"packed_mV\":\"DoAOcw51EGg=\"}");
+}
+
+TEST(MqttCellsTests, LargePackFitsInChunks) {
+  auto cells = pack_of(192);
+  for (auto format : {MqttCellFormat::Millivolts, MqttCellFormat::DeltaFromMin, MqttCellFormat::Base64}) {
+    std::vector<uint16_t> decoded;
+    for (size_t chunk = 0; chunk < mqtt_cell_chunk_count(cells.size()); chunk++) {
+      std::string payload = encode(format, cells, chunk);
+      ASSERT_FALSE(payload.empty()) << "chunk " << chunk;
+      JsonDocument doc;
+      ASSERT_EQ(deserializeJson(doc, payload), DeserializationError::Ok) << payload;
+      EXPECT_EQ(doc["first"].as<size_t>(), chunk * MQTT_CELLS_PER_CHUNK);
+      if (format == MqttCellFormat::Millivolts) {
+        for (JsonVariant value : doc["cell_voltages_mV"].as<JsonArray>()) {
+          decoded.push_back(value.as<uint16_t>());
+        }
+      } else if (format == MqttCellFormat::DeltaFromMin) {
+        for (JsonVariant value : doc["delta_mV"].as<JsonArray>()) {
+          decoded.push_back(doc["min_mV"].as<uint16_t>() + value.as<uint16_t>());
+        }
+      } else {
+        auto values = base64_decode(doc["packed_mV"].as<std::string>());
+        EXPECT_EQ(values.size(), doc["count"].as<size_t>());
+        decoded.insert(decoded.end(), values.begin(), values.end());
+      }
+    }
+    EXPECT_EQ(decoded, cells);
+  }
+}
+
+TEST(MqttCellsTests, TooSmallBuffer) {
+  auto cells = pack_of(48);
+  char out[64];
+  EXPECT_EQ(mqtt_encode_cell_chunk(MqttCellFormat::Millivolts, cells.data(), cells.size(), 0, out, sizeof(out)), 0u);
+  EXPECT_STREQ(out, "");
+}
+
+TEST(MqttCellsTests, ValueTemplates) {
+  EXPECT_EQ(mqtt_cell_value_template(MqttCellFormat::Float, 100), "{{ value_json.cell_voltages[100] }}");
+  EXPECT_EQ(mqtt_cell_value_template(MqttCellFormat::Millivolts, 50), "{{ value_json.cell_voltages_mV[2] / 1000 }}");
+  EXPECT_EQ(mqtt_cell_value_template(MqttCellFormat::DeltaFromMin, 1),
+            "{{ (value_json.min_mV + value_json.delta_mV[1]) / 1000 }}");
+  EXPECT_NE(mqtt_cell_value_template(MqttCellFormat::Base64, 0).find("{{ (a.find(s[0]) * 1024 + a.find(s[1]) * 16 + "
+                                                                     "a.find(s[2]) // 4) / 1000 }}"),
+            std::string::npos);
+}
+
+TEST(MqttCellsTests, Base64TemplateDecodesEveryCell) {
+  auto cells = pack_of(192);
+  for (size_t chunk = 0; chunk < mqtt_cell_chunk_count(cells.size()); chunk++) {
+    JsonDocument doc;
+    deserializeJson(doc, encode(MqttCellFormat::Base64, cells, chunk));
+    std::string packed = doc["packed_mV"].as<std::string>();
+    for (size_t i = 0; i < doc["count"].as<size_t>(); i++) {
+      size_t cell = chunk * MQTT_CELLS_PER_CHUNK + i;
+      EXPECT_EQ(evaluate_base64_template(mqtt_cell_value_template(MqttCellFormat::Base64, cell), packed), cells[cell])
+          << "cell " << cell;
+    }
+  }
+}
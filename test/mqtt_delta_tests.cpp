@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/devboard/mqtt/mqtt_delta.h"
+
+static const Mqtt_Deadband deadbands[] = {{"SOC", 0.1f, 0.0f}, {"stat_batt_power", 50.0f, 0.02f}};
+
+static MqttFieldDelta make_delta() {
+  return MqttFieldDelta(deadbands, sizeof(deadbands) / sizeof(deadbands[0]));
+}
+
+TEST(MqttDeltaTests, FirstMessageIsComplete) {
+  MqttFieldDelta delta = make_delta();
+  JsonDocument doc;
+  doc["SOC"] = 50.0f;
+  doc["bms_status"] = "ACTIVE";
+  doc["cpu_temp"] = 40;
+  EXPECT_TRUE(delta.filter(doc.as<JsonObject>(), false));
+  EXPECT_EQ(doc.size(), 3u);
+}
+
+TEST(MqttDeltaTests, UnchangedFieldsAreRemoved) {
+  MqttFieldDelta delta = make_delta();
+  JsonDocument doc;
+  doc["SOC"] = 50.0f;
+  doc["bms_status"] = "ACTIVE";
+  doc["cpu_temp"] = 40;
+  delta.filter(doc.as<JsonObject>(), false);
+
+  doc.clear();
+  doc["SOC"] = 50.05f;  // Within the deadband
+  doc["bms_status"] = "FAULT";
+  doc["cpu_temp"] = 40;  // No deadband, but unchanged
+  EXPECT_TRUE(delta.filter(doc.as<JsonObject>(), false));
+  EXPECT_EQ(doc.size(), 1u);
+  EXPECT_STREQ(doc["bms_status"], "FAULT");
+
+  doc.clear();
+  doc["SOC"] = 50.05f;
+  doc["bms_status"] = "FAULT";
+  doc["cpu_temp"] = 40;
+  EXPECT_FALSE(delta.filter(doc.as<JsonObject>(), false));
+  EXPECT_EQ(doc.size(), 0u);
+}
+
+TEST(MqttDeltaTests, DeadbandIsMeasuredFromLastPublishedValue) {
+  MqttFieldDelta delta = make_delta();
+  JsonDocument doc;
+  // Slow drift in small steps is published once the total moved beyond the deadband
+  float soc = 50.0f;
+  int published = 0;
+  for (int i = 0; i < 10; i++) {
+    doc.clear();
+    doc["SOC"] = soc;
+    if (delta.filter(doc.as<JsonObject>(), false)) {
+      published++;
+    }
+    soc += 0.04f;
+  }
+  EXPECT_EQ(published, 4);  // 50.00, 50.12, 50.24, 50.36
+}
+
+TEST(MqttDeltaTests, RelativeDeadbandAndSuffix) {
+  MqttFieldDelta delta = make_delta();
+  JsonDocument doc;
+  doc["stat_batt_power_2"] = 10000.0f;
+  delta.filter(doc.as<JsonObject>(), false);
+
+  // 2% of 10 kW is larger than the absolute 50 W
+  doc.clear();
+  doc["stat_batt_power_2"] = 10150.0f;
+  EXPECT_FALSE(delta.filter(doc.as<JsonObject>(), false));
+  doc.clear();
+  doc["stat_batt_power_2"] = 10250.0f;
+  EXPECT_TRUE(delta.filter(doc.as<JsonObject>(), false));
+
+  // Other suffixes do not match a deadband, so every change is published
+  delta.reset();
+  doc.clear();
+  doc["stat_batt_power_total"] = 100.0f;
+  delta.filter(doc.as<JsonObject>(), false);
+  doc.clear();
+  doc["stat_batt_power_total"] = 101.0f;
+  EXPECT_TRUE(delta.filter(doc.as<JsonObject>(), false));
+}
+
+TEST(MqttDeltaTests, FullRefreshKeepsEverything) {
+  MqttFieldDelta delta = make_delta();
+  JsonDocument doc;
+  doc["SOC"] = 50.0f;
+  doc["balancing"] = true;
+  delta.filter(doc.as<JsonObject>(), false);
+  EXPECT_FALSE(delta.filter(doc.as<JsonObject>(), false));
+
+  doc.clear();
+  doc["SOC"] = 50.0f;
+  doc["balancing"] = true;
+  EXPECT_TRUE(delta.filter(doc.as<JsonObject>(), true));
+  EXPECT_EQ(doc.size(), 2u);
+
+  doc["balancing"] = false;
+  EXPECT_TRUE(delta.filter(doc.as<JsonObject>(), false));
+  EXPECT_EQ(doc.size(), 1u);
+}
+
+TEST(MqttDeltaTests, ArrayPublishedWholeOnAnyChange) {
+  MqttArrayDelta delta;
+  uint16_t cells[4] = {3700, 3701, 3702, 3703};
+  EXPECT_TRUE(delta.changed(cells, 4, 5, false));
+  EXPECT_FALSE(delta.changed(cells, 4, 5, false));
+
+  cells[2] = 3707;  // 5 mV is within the deadband
+  EXPECT_FALSE(delta.changed(cells, 4, 5, false));
+  cells[2] = 3708;
+  EXPECT_TRUE(delta.changed(cells, 4, 5, false));
+  EXPECT_FALSE(delta.changed(cells, 4, 5, false));
+
+  EXPECT_TRUE(delta.changed(cells, 3, 5, false));  // Cell count changed
+  EXPECT_TRUE(delta.changed(cells, 3, 5, true));
+
+  bool balancing[3] = {false, true, false};
+  MqttArrayDelta flags;
+  EXPECT_TRUE(flags.changed(balancing, 3, false));
+  EXPECT_FALSE(flags.changed(balancing, 3, false));
+  balancing[0] = true;
+  EXPECT_TRUE(flags.changed(balancing, 3, false));
+}
+
+TEST(MqttDeltaTests, Statistics) {
+  mqtt_delta_statistics = {};
+  mqtt_delta_count(true, 100);
+  mqtt_delta_count(false, 80);
+  mqtt_delta_count(false, 20);
+  EXPECT_EQ(mqtt_delta_statistics.messages_published, 1u);
+  EXPECT_EQ(mqtt_delta_statistics.bytes_published, 100u);
+  EXPECT_EQ(mqtt_delta_statistics.messages_suppressed, 2u);
+  EXPECT_EQ(mqtt_delta_statistics.bytes_saved, 100u);
+}
@@ -0,0 +1,214 @@
+// Replays the CAN logs in can_log_based/can_logs through every CAN battery integration and measures the
+// per-frame receive path and update_values(). Results are printed and written as JSON, so they can be
+// compared between builds to catch regressions before they reach hardware.
+//
+// Usage: replay_benchmark [--iterations N] [--output FILE] [--filter NAME]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "utils/utils.h"
+
+#include "../Software/src/battery/BATTERIES.h"
+#include "../Software/src/devboard/utils/events.h"
+
+// Every operator new in the process is counted, so allocations made while handling a frame show up
+static std::atomic<uint64_t> allocation_count{0};
+
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+  std::free(p);
+}
+
+void store_settings_equipment_stop(void) {}
+
+typedef struct {
+  int type;
+  std::string name;
+  uint64_t frames;
+  uint64_t updates;
+  double rx_ns_per_frame;
+  double update_ns_per_call;
+  double rx_allocations_per_frame;
+  double update_allocations_per_call;
+} ReplayResult;
+
+static void setup_benchmark_battery(BatteryType type) {
+  datalayer = DataLayer();
+  reset_all_events();
+  init_hal();
+
+  // Same limits as the CAN log safety tests, for custom-BMS batteries
+  user_selected_max_pack_voltage_dV = 378 + 10;
+  user_selected_min_pack_voltage_dV = 261 - 10;
+  user_selected_max_cell_voltage_mV = 4200 + 20;
+  user_selected_min_cell_voltage_mV = 2900 - 20;
+
+  user_selected_battery_type = type;
+  setup_battery();
+}
+
+static void teardown_benchmark_battery() {
+  if (battery) {
+    delete battery;
+    battery = nullptr;
+  }
+}
+
+static bool is_can_battery(BatteryType type) {
+  if (type == BatteryType::TestFake) {
+    return false;
+  }
+  datalayer = DataLayer();
+  init_hal();
+  Battery* tmp_battery = create_battery(type);
+  bool can = dynamic_cast<CanBattery*>(tmp_battery) != nullptr;
+  delete tmp_battery;
+  return can;
+}
+
+static ReplayResult replay(BatteryType type, CanBattery* can_battery, const std::vector<CAN_frame>& frames,
+                           int iterations) {
+  using clock = std::chrono::steady_clock;
+  ReplayResult result = {.type = (int)type, .name = name_for_battery_type(type)};
+  clock::duration rx_time{}, update_time{};
+  uint64_t rx_allocations = 0, update_allocations = 0;
+
+  // Warm up caches and any lazily initialised state
+  for (const auto& frame : frames) {
+    can_battery->handle_incoming_can_frame(frame);
+  }
+  can_battery->update_values();
+
+  for (int i = 0; i < iterations; i++) {
+    uint64_t allocations = allocation_count.load(std::memory_order_relaxed);
+    auto start = clock::now();
+    for (const auto& frame : frames) {
+      can_battery->handle_incoming_can_frame(frame);
+    }
+    auto rx_done = clock::now();
+    rx_allocations += allocation_count.load(std::memory_order_relaxed) - allocations;
+
+    allocations = allocation_count.load(std::memory_order_relaxed);
+    can_battery->update_values();
+    update_time += clock::now() - rx_done;
+    update_allocations += allocation_count.load(std::memory_order_relaxed) - allocations;
+    rx_time += rx_done - start;
+  }
+
+  result.frames = (uint64_t)frames.size() * iterations;
+  result.updates = iterations;
+  result.rx_ns_per_frame = std::chrono::duration<double, std::nano>(rx_time).count() / result.frames;
+  result.update_ns_per_call = std::chrono::duration<double, std::nano>(update_time).count() / result.updates;
+  result.rx_allocations_per_frame = (double)rx_allocations / result.frames;
+  result.update_allocations_per_call = (double)update_allocations / result.updates;
+  return result;
+}
+
+static void write_json(const std::string& path, int iterations, size_t frames_per_iteration,
+                       const std::vector<ReplayResult>& results) {
+  std::ofstream out(path);
+  out << std::fixed << std::setprecision(3);
+  out << "{\n  \"iterations\": " << iterations << ",\n  \"frames_per_iteration\": " << frames_per_iteration
+      << ",\n  \"batteries\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& r = results[i];
+    out << "    {\"type\": " << r.type << ", \"name\": \"" << r.name << "\", \"frames\": " << r.frames
+        << ", \"rx_ns_per_frame\": " << r.rx_ns_per_frame << ", \"update_ns_per_call\": " << r.update_ns_per_call
+        << ", \"rx_allocations_per_frame\": " << r.rx_allocations_per_frame
+        << ", \"update_allocations_per_call\": " << r.update_allocations_per_call << "}"
+        << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+  int iterations = 10000;
+  std::string output = "replay_benchmark.json";
+  std::string filter;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+      iterations = std::max(1, atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "--output") && i + 1 < argc) {
+      output = argv[++i];
+    } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--iterations N] [--output FILE] [--filter NAME]" << std::endl;
+      return 1;
+    }
+  }
+
+  // All logs are replayed through every battery. The logs of other batteries exercise the paths for
+  // frames a battery does not handle, which on a shared bus are just as hot.
+  std::vector<CAN_frame> frames;
+  for (const auto& entry : fs::directory_iterator(TEST_CAN_LOG_DIR)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+      auto log = parse_can_log_file(entry.path());
+      frames.insert(frames.end(), log.begin(), log.end());
+    }
+  }
+  if (frames.empty()) {
+    std::cerr << "No CAN logs found in " << TEST_CAN_LOG_DIR << std::endl;
+    return 1;
+  }
+
+  std::vector<ReplayResult> results;
+  for (int i = 0; i < (int)BatteryType::Highest; i++) {
+    BatteryType type = (BatteryType)i;
+    if (!is_can_battery(type)) {
+      continue;
+    }
+    const char* name = name_for_battery_type(type);
+    if (!filter.empty() && std::string(name).find(filter) == std::string::npos) {
+      continue;
+    }
+
+    setup_benchmark_battery(type);
+    results.push_back(replay(type, dynamic_cast<CanBattery*>(battery), frames, iterations));
+    teardown_benchmark_battery();
+
+    const auto& r = results.back();
+    std::cout << std::fixed << std::setprecision(1) << "[ REPLAY   ] " << std::left << std::setw(40) << r.name
+              << std::right << std::setw(9) << r.rx_ns_per_frame << " ns/frame" << std::setw(11)
+              << r.update_ns_per_call << " ns/update" << std::setprecision(3) << std::setw(9)
+              << r.rx_allocations_per_frame << " allocs/frame" << std::setw(9) << r.update_allocations_per_call
+              << " allocs/update" << std::endl;
+  }
+
+  write_json(output, iterations, frames.size(), results);
+  std::cout << results.size() << " batteries, " << frames.size() << " frames x " << iterations
+            << " iterations, results written to " << output << std::endl;
+  return 0;
+}
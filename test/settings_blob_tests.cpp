@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+
+#include <Preferences.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Software/src/communication/nvm/comm_nvm.h"
+#include "../Software/src/communication/nvm/settings_blob.h"
+
+// Stands in for a reboot: the next store loads the settings from NVS again
+static void reboot() {
+  settings_blob = SettingsBlob();
+}
+
+static void erase_flash() {
+  Preferences::erase_all();
+  reboot();
+}
+
+// Settings as firmware before the blob saved them, one key each
+static void write_per_key_settings() {
+  Preferences prefs;
+  prefs.begin("batterySettings");
+  prefs.putUInt("BATTTYPE", 12);
+  prefs.putBool("WEBENABLED", true);
+  prefs.putInt("MINPERCENTAGE", -5);
+  prefs.putString("SSID", "garage");
+  prefs.end();
+}
+
+static std::vector<uint8_t> read_blob() {
+  Preferences prefs;
+  prefs.begin("batterySettings", true);
+  std::vector<uint8_t> data(prefs.getBytesLength(SETTINGS_BLOB_KEY));
+  prefs.getBytes(SETTINGS_BLOB_KEY, data.data(), data.size());
+  prefs.end();
+  return data;
+}
+
+static void write_blob(const std::vector<uint8_t>& data) {
+  Preferences prefs;
+  prefs.begin("batterySettings");
+  prefs.putBytes(SETTINGS_BLOB_KEY, data.data(), data.size());
+  prefs.end();
+}
+
+static void expect_per_key_settings(BatteryEmulatorSettingsStore& settings) {
+  EXPECT_EQ(settings.getUInt("BATTTYPE", 0), 12u);
+  EXPECT_TRUE(settings.getBool("WEBENABLED"));
+  EXPECT_EQ(settings.getInt("MINPERCENTAGE", 0), -5);
+  EXPECT_EQ(settings.getString("SSID").str(), "garage");
+  // Never saved, so the default of the caller
+  EXPECT_EQ(settings.getUInt("INVTYPE", 7), 7u);
+  EXPECT_EQ(settings.getString("HTTPUSER", "admin").str(), "admin");
+  EXPECT_FALSE(settings.settingExists("INVTYPE"));
+  EXPECT_TRUE(settings.settingExists("BATTTYPE"));
+}
+
+TEST(SettingsBlob, MigratesPerKeySettingsOnce) {
+  erase_flash();
+  write_per_key_settings();
+  {
+    BatteryEmulatorSettingsStore settings;
+    EXPECT_EQ(settings_blob.loaded_from(), SETTINGS_FROM_KEYS);
+    expect_per_key_settings(settings);
+  }
+
+  reboot();
+  Preferences::reads = 0;
+  {
+    BatteryEmulatorSettingsStore settings(true);
+    // The blob, its length and its contents, instead of a lookup or two per setting
+    EXPECT_EQ(settings_blob.loaded_from(), SETTINGS_FROM_BLOB);
+    EXPECT_EQ(Preferences::reads, 3u);
+    EXPECT_EQ(settings_blob.load_reads(), 3u);
+    expect_per_key_settings(settings);
+  }
+}
+
+TEST(SettingsBlob, SavesAllChangesWithOneWrite) {
+  erase_flash();
+  Preferences::writes = 0;
+  {
+    BatteryEmulatorSettingsStore settings;
+    settings.saveUInt("BATTTYPE", 3);
+    settings.saveBool("USBENABLED", true);
+    settings.saveInt("MINPERCENTAGE", 10);
+    settings.saveString("HOSTNAME", "emulator");
+    EXPECT_TRUE(settings.were_settings_updated());
+    EXPECT_EQ(Preferences::writes, 0u);
+  }
+  EXPECT_EQ(Preferences::writes, 1u);
+
+  // Saving the same values again writes nothing
+  {
+    BatteryEmulatorSettingsStore settings;
+    settings.saveUInt("BATTTYPE", 3);
+    settings.saveString("HOSTNAME", "emulator");
+    EXPECT_FALSE(settings.were_settings_updated());
+  }
+  EXPECT_EQ(Preferences::writes, 1u);
+
+  reboot();
+  BatteryEmulatorSettingsStore settings(true);
+  EXPECT_EQ(settings.getUInt("BATTTYPE", 0), 3u);
+  EXPECT_TRUE(settings.getBool("USBENABLED"));
+  EXPECT_EQ(settings.getInt("MINPERCENTAGE", 0), 10);
+  EXPECT_EQ(settings.getString("HOSTNAME").str(), "emulator");
+}
+
+TEST(SettingsBlob, KeepsLongStringsAndUnknownKeysInOwnKeys) {
+  erase_flash();
+  const std::string long_password(SETTINGS_STRING_MAX_LENGTH + 1, 'x');
+  {
+    BatteryEmulatorSettingsStore settings;
+    settings.saveString("MQTTPASSWORD", long_password.c_str());
+    settings.saveUInt("NOTINSCHEMA", 5);
+  }
+
+  reboot();
+  {
+    BatteryEmulatorSettingsStore settings;
+    EXPECT_EQ(settings_blob.loaded_from(), SETTINGS_FROM_BLOB);
+    EXPECT_EQ(settings.getString("MQTTPASSWORD").str(), long_password);
+    EXPECT_EQ(settings.getUInt("NOTINSCHEMA", 0), 5u);
+    // Short enough again, back into the blob
+    settings.saveString("MQTTPASSWORD", "short");
+  }
+
+  reboot();
+  BatteryEmulatorSettingsStore settings(true);
+  EXPECT_EQ(settings.getString("MQTTPASSWORD").str(), "short");
+}
+
+TEST(SettingsBlob, FallsBackToOwnKeysWhenBlobIsCorrupt) {
+  erase_flash();
+  write_per_key_settings();
+  { BatteryEmulatorSettingsStore settings; }
+  {
+    BatteryEmulatorSettingsStore settings;
+    settings.saveUInt("BATTTYPE", 20);
+  }
+
+  std::vector<uint8_t> data = read_blob();
+  ASSERT_GT(data.size(), sizeof(Settings_Blob_Header));
+  data.back() ^= 0x01;
+  write_blob(data);
+
+  // The last values saved one key each are used, and a valid blob is written again
+  reboot();
+  clear_event(EVENT_PERSISTENT_SAVE_INFO);
+  {
+    BatteryEmulatorSettingsStore settings;
+    EXPECT_EQ(settings_blob.loaded_from(), SETTINGS_FROM_KEYS);
+    expect_per_key_settings(settings);
+  }
+  EXPECT_EQ(get_event_pointer(EVENT_PERSISTENT_SAVE_INFO)->state, EVENT_STATE_ACTIVE);
+  EXPECT_EQ(get_event_pointer(EVENT_PERSISTENT_SAVE_INFO)->data, SETTINGS_BLOB_REJECTED);
+  clear_event(EVENT_PERSISTENT_SAVE_INFO);
+  reboot();
+  BatteryEmulatorSettingsStore settings(true);
+  EXPECT_EQ(settings_blob.loaded_from(), SETTINGS_FROM_BLOB);
+}
+
+TEST(SettingsBlob, ReadsFieldsMissingFromOlderBlobFromOwnKeys) {
+  erase_flash();
+  const Setting_Field& newest = settings_schema[settings_schema_fields - 1];
+  ASSERT_EQ(newest.type, SETTING_UINT);
+
+  // Firmware with one setting less wrote the blob, the newest setting was saved on its own by even older firmware
+  SettingsBlob older;
+  older.set_number(older.find("BATTTYPE"), 4);
+  std::vector<uint8_t> data;
+  older.serialize(data, settings_schema_fields - 1);
+  write_blob(data);
+  Preferences prefs;
+  prefs.begin("batterySettings");
+  prefs.putUInt(newest.key, 9);
+  prefs.end();
+
+  reboot();
+  Preferences::reads = 0;
+  {
+    BatteryEmulatorSettingsStore settings;
+    EXPECT_EQ(settings_blob.loaded_from(), SETTINGS_FROM_KEYS);
+    EXPECT_EQ(Preferences::reads, 5u);
+    EXPECT_EQ(settings.getUInt("BATTTYPE", 0), 4u);
+    EXPECT_EQ(settings.getUInt(newest.key, 0), 9u);
+  }
+  reboot();
+  BatteryEmulatorSettingsStore settings(true);
+  EXPECT_EQ(settings_blob.loaded_from(), SETTINGS_FROM_BLOB);
+  EXPECT_EQ(settings.getUInt(newest.key, 0), 9u);
+}
+
+TEST(SettingsBlob, RejectsTruncatedAndForeignBlobs) {
+  SettingsBlob blob;
+  blob.set_number(blob.find("BATTTYPE"), 4);
+  blob.set_text(blob.find("SSID"), "garage");
+  std::vector<uint8_t> data;
+  blob.serialize(data, settings_schema_fields);
+
+  SettingsBlob decoded;
+  EXPECT_EQ(decoded.deserialize(data.data(), data.size()), settings_schema_fields);
+  EXPECT_EQ(decoded.number(decoded.find("BATTTYPE")), 4u);
+  EXPECT_EQ(decoded.text(decoded.find("SSID")), "garage");
+  for (size_t length = 0; length < data.size(); length++) {
+    ASSERT_EQ(decoded.deserialize(data.data(), length), 0) << length;
+  }
+
+  Settings_Blob_Header header;
+  memcpy(&header, data.data(), sizeof(header));
+  header.version = SETTINGS_BLOB_VERSION + 1;
+  memcpy(data.data(), &header, sizeof(header));
+  EXPECT_EQ(decoded.deserialize(data.data(), data.size()), 0);
+}
+
+TEST(SettingsBlob, ClearAllForgetsEverything) {
+  erase_flash();
+  write_per_key_settings();
+  {
+    BatteryEmulatorSettingsStore settings;
+    settings.saveUInt("INVTYPE", 2);
+  }
+  {
+    BatteryEmulatorSettingsStore settings;
+    settings.clearAll();
+  }
+
+  reboot();
+  BatteryEmulatorSettingsStore settings(true);
+  EXPECT_FALSE(settings.settingExists("INVTYPE"));
+  EXPECT_FALSE(settings.settingExists("BATTTYPE"));
+  EXPECT_EQ(settings.getUInt("BATTTYPE", 1), 1u);
+}
+
+TEST(SettingsBlob, WritableStoreKeepsOtherTasksOutUntilCommitted) {
+  erase_flash();
+  std::atomic<bool> other_saved{false};
+  std::thread other;
+  {
+    BatteryEmulatorSettingsStore settings;
+    settings.saveUInt("BATTTYPE", 3);
+    other = std::thread([&]() {
+      BatteryEmulatorSettingsStore other_settings;
+      // Sees the first save completely, never half of it
+      EXPECT_EQ(other_settings.getUInt("BATTTYPE", 0), 5u);
+      EXPECT_EQ(other_settings.getString("HOSTNAME").str(), "emulator");
+      other_settings.saveBool("USBENABLED", true);
+      other_saved = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(other_saved);
+    settings.saveUInt("BATTTYPE", 5);
+    settings.saveString("HOSTNAME", "emulator");
+
+    // Reading from the same task while holding the store does not wait for itself
+    BatteryEmulatorSettingsStore nested(true);
+    EXPECT_EQ(nested.getUInt("BATTTYPE", 0), 5u);
+  }
+  other.join();
+  EXPECT_TRUE(other_saved);
+
+  reboot();
+  BatteryEmulatorSettingsStore settings(true);
+  EXPECT_EQ(settings.getUInt("BATTTYPE", 0), 5u);
+  EXPECT_TRUE(settings.getBool("USBENABLED"));
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "../Software/src/devboard/webserver/status_events.h"
+
+static int soc = 50;
+
+static void build_status(JsonObject root) {
+  root["system"]["uptime_s"] = 10;
+  root["battery"]["SOC"] = soc;
+  root["battery"]["battery_voltage"] = 370.0f;
+}
+
+// Everything the client sends at now_ms, through a buffer of buffer_size bytes
+static std::string read_events(StatusEventsClient& client, uint32_t now_ms, size_t buffer_size = 512) {
+  std::string result;
+  uint8_t buffer[512];
+  while (true) {
+    size_t length = client.fill(buffer, buffer_size, now_ms);
+    EXPECT_NE(length, 0u);
+    if (length == STATUS_EVENTS_TRY_AGAIN || length == 0) {
+      return result;
+    }
+    result.append((const char*)buffer, length);
+  }
+}
+
+TEST(StatusEvents, NewClientStartsWithAllFields) {
+  soc = 50;
+  StatusEvents events(build_status);
+  StatusEventsClient client(events, 0);
+
+  EXPECT_EQ(read_events(client, 0, 7),
+            "event: status\ndata: {\"system\":{\"uptime_s\":10},\"battery\":{\"SOC\":50,\"battery_voltage\":370}}\n\n");
+  // Nothing changed and the interval has not passed
+  EXPECT_EQ(read_events(client, 500), "");
+  EXPECT_EQ(read_events(client, 1000), "");
+
+  soc = 51;
+  EXPECT_EQ(read_events(client, 2000), "event: status\ndata: {\"battery\":{\"SOC\":51}}\n\n");
+  EXPECT_EQ(events.statistics().events, 2u);
+  EXPECT_EQ(events.statistics().full_events, 1u);
+  EXPECT_EQ(events.statistics().clients, 1u);
+}
+
+TEST(StatusEvents, ClientsShareEvents) {
+  soc = 50;
+  StatusEvents events(build_status);
+  StatusEventsClient first(events, 0);
+  read_events(first, 0);
+
+  soc = 52;
+  StatusEventsClient second(events, 1000);
+  EXPECT_EQ(events.statistics().clients, 2u);
+  // The second client asked for all fields, so both get them
+  std::string expected =
+      "event: status\ndata: {\"system\":{\"uptime_s\":10},\"battery\":{\"SOC\":52,\"battery_voltage\":370}}\n\n";
+  EXPECT_EQ(read_events(second, 1000), expected);
+  EXPECT_EQ(read_events(first, 1000), expected);
+
+  soc = 53;
+  EXPECT_EQ(read_events(first, 2000), "event: status\ndata: {\"battery\":{\"SOC\":53}}\n\n");
+  EXPECT_EQ(read_events(second, 2000), "event: status\ndata: {\"battery\":{\"SOC\":53}}\n\n");
+  // Built once for both clients
+  EXPECT_EQ(events.statistics().events, 3u);
+}
+
+TEST(StatusEvents, SlowClientResyncs) {
+  soc = 50;
+  StatusEvents events(build_status);
+  StatusEventsClient fast(events, 0);
+  StatusEventsClient slow(events, 0);
+  read_events(fast, 0);
+  read_events(slow, 0);
+
+  soc = 60;
+  read_events(fast, 1000);
+  soc = 61;
+  read_events(fast, 2000);
+
+  // The slow client missed the change to 60, so it waits for the next event with all fields
+  EXPECT_EQ(read_events(slow, 2000), "");
+  soc = 62;
+  std::string expected =
+      "event: status\ndata: {\"system\":{\"uptime_s\":10},\"battery\":{\"SOC\":62,\"battery_voltage\":370}}\n\n";
+  EXPECT_EQ(read_events(slow, 3000), expected);
+  EXPECT_EQ(read_events(fast, 3000), expected);
+}
+
+TEST(StatusEvents, ClientThatMissesTwoEventsInARowResyncs) {
+  soc = 50;
+  StatusEvents events(build_status);
+  StatusEventsClient fast(events, 0);
+  StatusEventsClient slow(events, 0);
+  read_events(fast, 0);
+  read_events(slow, 0);
+
+  soc = 60;
+  read_events(fast, 1000);
+  soc = 61;
+  read_events(fast, 2000);
+  EXPECT_EQ(read_events(slow, 2000), "");
+
+  // The slow client also misses the event with all fields it asked for, and then sees a change
+  soc = 62;
+  read_events(fast, 3000);
+  soc = 63;
+  EXPECT_EQ(read_events(fast, 4000), "event: status\ndata: {\"battery\":{\"SOC\":63}}\n\n");
+  EXPECT_EQ(read_events(slow, 4000), "");
+
+  soc = 64;
+  std::string expected =
+      "event: status\ndata: {\"system\":{\"uptime_s\":10},\"battery\":{\"SOC\":64,\"battery_voltage\":370}}\n\n";
+  EXPECT_EQ(read_events(slow, 5000), expected);
+  EXPECT_EQ(read_events(fast, 5000), expected);
+}
+
+TEST(StatusEvents, IdleClientGetsKeepalive) {
+  soc = 50;
+  StatusEvents events(build_status);
+  StatusEventsClient client(events, 0);
+  read_events(client, 0);
+  EXPECT_EQ(read_events(client, STATUS_EVENTS_KEEPALIVE_MS - 1), "");
+  EXPECT_EQ(read_events(client, STATUS_EVENTS_KEEPALIVE_MS), ":\n\n");
+  EXPECT_EQ(read_events(client, STATUS_EVENTS_KEEPALIVE_MS + 1), "");
+}
+
+TEST(StatusEvents, ClientCountFollowsConnections) {
+  StatusEvents events(build_status);
+  {
+    StatusEventsClient client(events, 0);
+    EXPECT_EQ(events.statistics().clients, 1u);
+  }
+  EXPECT_EQ(events.statistics().clients, 0u);
+}
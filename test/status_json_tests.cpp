@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "../Software/src/devboard/webserver/status_json.h"
+
+static std::unique_ptr<DataLayerSnapshot> make_snapshot() {
+  auto snapshot = std::make_unique<DataLayerSnapshot>();
+  snapshot->battery.status.reported_soc = 5012;
+  snapshot->battery.status.voltage_dV = 3702;
+  snapshot->battery.status.current_dA = -125;
+  snapshot->battery.status.active_power_W = -4627;
+  snapshot->battery.status.cell_max_voltage_mV = 3712;
+  snapshot->battery.status.cell_min_voltage_mV = 3698;
+  snapshot->battery.info.number_of_cells = 4;
+  for (int i = 0; i < 4; i++) {
+    snapshot->battery.status.cell_voltages_mV[i] = 3698 + i * 4;
+    snapshot->battery.status.cell_balancing_status[i] = i == 3;
+  }
+  update_cell_statistics(snapshot->battery);
+  snapshot->battery2 = snapshot->battery;
+  return snapshot;
+}
+
+TEST(StatusJson, ListsBatteriesInUse) {
+  auto snapshot = make_snapshot();
+  JsonDocument doc;
+  status_to_json(*snapshot, 1, doc.to<JsonObject>());
+
+  EXPECT_TRUE(doc["system"]["uptime_s"].is<uint64_t>());
+  EXPECT_FLOAT_EQ(doc["battery"]["SOC"].as<float>(), 50.12f);
+  EXPECT_FLOAT_EQ(doc["battery"]["battery_voltage"].as<float>(), 370.2f);
+  EXPECT_FLOAT_EQ(doc["battery"]["battery_current"].as<float>(), -12.5f);
+  EXPECT_EQ(doc["battery"]["stat_batt_power"].as<int>(), -4627);
+  EXPECT_FLOAT_EQ(doc["battery"]["cell_voltage_delta"].as<float>(), 0.014f);
+  EXPECT_FALSE(doc["battery2"].is<JsonObject>());
+
+  JsonDocument doc2;
+  status_to_json(*snapshot, 2, doc2.to<JsonObject>());
+  EXPECT_TRUE(doc2["battery2"].is<JsonObject>());
+  EXPECT_FALSE(doc2["battery3"].is<JsonObject>());
+}
+
+TEST(StatusJson, BatteryDetailsListCells) {
+  auto snapshot = make_snapshot();
+  JsonDocument doc;
+  status_battery_details_to_json(snapshot->battery, doc.to<JsonObject>());
+
+  EXPECT_FLOAT_EQ(doc["info"]["max_cell_voltage"].as<float>(), 4.3f);
+  EXPECT_FLOAT_EQ(doc["status"]["SOC"].as<float>(), 50.12f);
+  EXPECT_EQ(doc["cell_statistics"]["average_mV"].as<int>(), 3704);
+  EXPECT_EQ(doc["cell_statistics"]["max_index"].as<int>(), 3);
+  EXPECT_EQ(doc["cell_statistics"]["balancing_cells"].as<int>(), 1);
+  ASSERT_EQ(doc["cell_voltages_mV"].size(), 4u);
+  EXPECT_EQ(doc["cell_voltages_mV"][2].as<int>(), 3706);
+  ASSERT_EQ(doc["cell_balancing"].size(), 4u);
+  EXPECT_EQ(doc["cell_balancing"][0].as<int>(), 0);
+  EXPECT_EQ(doc["cell_balancing"][3].as<int>(), 1);
+}
+
+TEST(StatusJson, DeltaSendsOnlyChangedFields) {
+  auto snapshot = make_snapshot();
+  StatusDelta delta;
+
+  JsonDocument first;
+  status_to_json(*snapshot, 2, first.to<JsonObject>());
+  size_t battery_fields = first["battery"].size();
+  EXPECT_TRUE(delta.filter(first.as<JsonObject>(), false));
+  EXPECT_EQ(first["battery"].size(), battery_fields);
+
+  // Nothing changed, the uptime is within its deadband
+  JsonDocument same;
+  status_to_json(*snapshot, 2, same.to<JsonObject>());
+  EXPECT_FALSE(delta.filter(same.as<JsonObject>(), false));
+  EXPECT_EQ(same.size(), 0u);
+
+  // Within the voltage deadband, outside none for SOC
+  snapshot->battery2.status.voltage_dV = 3704;
+  snapshot->battery2.status.reported_soc = 5013;
+  JsonDocument changed;
+  status_to_json(*snapshot, 2, changed.to<JsonObject>());
+  EXPECT_TRUE(delta.filter(changed.as<JsonObject>(), false));
+  EXPECT_FALSE(changed["battery"].is<JsonObject>());
+  EXPECT_FALSE(changed["system"].is<JsonObject>());
+  ASSERT_EQ(changed["battery2"].size(), 1u);
+  EXPECT_FLOAT_EQ(changed["battery2"]["SOC"].as<float>(), 50.13f);
+
+  // A full refresh, for example after a client connected, sends everything
+  JsonDocument full;
+  status_to_json(*snapshot, 2, full.to<JsonObject>());
+  EXPECT_TRUE(delta.filter(full.as<JsonObject>(), true));
+  EXPECT_EQ(full["battery"].size(), battery_fields);
+  EXPECT_EQ(full["battery2"].size(), battery_fields);
+}
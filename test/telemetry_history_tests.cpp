@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Software/src/datalayer/telemetry_history.h"
+#include "../Software/src/devboard/webserver/history_response.h"
+#include "../Software/src/lib/bblanchon-ArduinoJson/ArduinoJson.h"
+
+static History_Config small_config(uint32_t fine, uint32_t minutes, uint32_t quarters, uint16_t cells) {
+  History_Config config = {};
+  config.entries[0] = fine;
+  config.entries[1] = minutes;
+  config.entries[2] = quarters;
+  config.cells = cells;
+  return config;
+}
+
+// Every field of the sample at time_s gets value
+static void record_constant(TelemetryHistory& history, uint32_t time_s, int16_t value) {
+  std::vector<int16_t> values(history.fields(), value);
+  history.record_values(values.data(), time_s);
+}
+
+static std::string read_response(HistoryResponse& response) {
+  std::string out;
+  uint8_t buffer[64];
+  size_t length;
+  while ((length = response.fill(buffer, sizeof(buffer))) > 0) {
+    out.append((const char*)buffer, length);
+  }
+  return out;
+}
+
+TEST(TelemetryHistory, ConfigFitsBudget) {
+  History_Config full = history_config_for_budget(SIZE_MAX, MAX_AMOUNT_CELLS);
+  EXPECT_EQ(full.entries[0], 900u);
+  EXPECT_EQ(full.entries[1], 1440u);
+  EXPECT_EQ(full.entries[2], 672u);
+
+  History_Config psram = history_config_for_budget(TELEMETRY_HISTORY_PSRAM_BUDGET, MAX_AMOUNT_CELLS);
+  EXPECT_LE(TelemetryHistory::bytes_for(psram), (size_t)TELEMETRY_HISTORY_PSRAM_BUDGET);
+  EXPECT_GT(psram.entries[2], 0u);
+
+  History_Config dram = history_config_for_budget(TELEMETRY_HISTORY_DRAM_FLOOR, 0);
+  EXPECT_LE(TelemetryHistory::bytes_for(dram), (size_t)TELEMETRY_HISTORY_DRAM_FLOOR);
+  EXPECT_GE(dram.entries[0], 30u);
+  EXPECT_GE(dram.entries[2], 24u);  // Six hours of 15 min entries
+
+  History_Config none = history_config_for_budget(16, MAX_AMOUNT_CELLS);
+  TelemetryHistory history;
+  EXPECT_FALSE(history.begin(none, false));
+  EXPECT_FALSE(history.enabled());
+  record_constant(history, 0, 1);  // Does nothing while disabled
+  EXPECT_EQ(history.end(0), 0u);
+}
+
+TEST(TelemetryHistory, DramBudgetLeavesRoomForOthers) {
+  EXPECT_EQ(history_dram_budget(0, 100 * 1024), 0u);
+  EXPECT_EQ(history_dram_budget(16 * 1024, 100 * 1024), 16u * 1024);
+  EXPECT_EQ(history_dram_budget(1024 * 1024, 1024 * 1024), (size_t)TELEMETRY_HISTORY_DRAM_MAX);
+  // A quarter of the largest free block
+  EXPECT_EQ(history_dram_budget(16 * 1024, 40 * 1024), 10u * 1024);
+  // Too fragmented to be worth it
+  EXPECT_EQ(history_dram_budget(16 * 1024, 30 * 1024), 0u);
+}
+
+TEST(TelemetryHistory, AggregatesMinMaxAverage) {
+  TelemetryHistory history;
+  ASSERT_TRUE(history.begin(small_config(10, 10, 10, 0), false));
+
+  // Two full minutes and a part of the third one
+  for (uint32_t t = 0; t < 150; t++) {
+    record_constant(history, t, t < 60 ? 100 + t : -(int16_t)t);
+  }
+  EXPECT_EQ(history.end(0), 150u);
+  EXPECT_EQ(history.oldest(0), 140u);
+  ASSERT_EQ(history.end(1), 2u);
+  EXPECT_EQ(history.end(2), 0u);
+
+  uint32_t time_s;
+  uint16_t samples;
+  History_Value values[HISTORY_PACK_FIELDS];
+  ASSERT_TRUE(history.read(1, 0, time_s, samples, values, 0, HISTORY_PACK_FIELDS));
+  EXPECT_EQ(time_s, 0u);
+  EXPECT_EQ(samples, 60);
+  EXPECT_EQ(values[HISTORY_VOLTAGE_DV].min, 100);
+  EXPECT_EQ(values[HISTORY_VOLTAGE_DV].max, 159);
+  EXPECT_EQ(values[HISTORY_VOLTAGE_DV].avg, 130);  // 129.5 rounds up
+
+  ASSERT_TRUE(history.read(1, 1, time_s, samples, values, 0, HISTORY_PACK_FIELDS));
+  EXPECT_EQ(time_s, 60u);
+  EXPECT_EQ(values[HISTORY_CURRENT_DA].min, -119);
+  EXPECT_EQ(values[HISTORY_CURRENT_DA].max, -60);
+  EXPECT_EQ(values[HISTORY_CURRENT_DA].avg, -90);  // -89.5 rounds away from zero
+
+  // The 1 s entries are the samples themselves
+  ASSERT_TRUE(history.read(0, 149, time_s, samples, values, 0, HISTORY_PACK_FIELDS));
+  EXPECT_EQ(time_s, 149u);
+  EXPECT_EQ(samples, 1);
+  EXPECT_EQ(values[HISTORY_SOC_PPTT].avg, -149);
+
+  // Overwritten and future entries are not readable
+  EXPECT_FALSE(history.read(0, 139, time_s, samples, values, 0, 1));
+  EXPECT_FALSE(history.read(0, 150, time_s, samples, values, 0, 1));
+}
+
+TEST(TelemetryHistory, QuarterHoursSkipGaps) {
+  TelemetryHistory history;
+  ASSERT_TRUE(history.begin(small_config(4, 4, 4, 0), false));
+  record_constant(history, 10, 5);
+  record_constant(history, 20, 7);
+  // Nothing recorded for the next 44 minutes
+  record_constant(history, 2700, 1);
+  record_constant(history, 3600, 1);
+
+  ASSERT_EQ(history.end(2), 2u);
+  uint32_t time_s;
+  uint16_t samples;
+  History_Value value;
+  ASSERT_TRUE(history.read(2, 0, time_s, samples, &value, 0, 1));
+  EXPECT_EQ(time_s, 0u);
+  EXPECT_EQ(samples, 2);
+  EXPECT_EQ(value.avg, 6);
+  ASSERT_TRUE(history.read(2, 1, time_s, samples, &value, 0, 1));
+  EXPECT_EQ(time_s, 2700u);
+  EXPECT_EQ(samples, 1);
+
+  EXPECT_EQ(history.find(2, 0), 0u);
+  EXPECT_EQ(history.find(2, 1), 1u);
+  EXPECT_EQ(history.find(2, 2700), 1u);
+  EXPECT_EQ(history.find(2, 2701), 2u);
+}
+
+TEST(TelemetryHistory, RecordsBatteryAndCells) {
+  TelemetryHistory history;
+  ASSERT_TRUE(history.begin(small_config(4, 2, 2, 8), false));
+  EXPECT_EQ(history.fields(), HISTORY_PACK_FIELDS + 8);
+
+  DATALAYER_BATTERY_TYPE battery = {};
+  battery.status.voltage_dV = 3712;
+  battery.status.current_dA = -153;
+  battery.status.real_soc = 8123;
+  battery.status.temperature_min_dC = -45;
+  battery.status.temperature_max_dC = 210;
+  battery.status.cell_min_voltage_mV = 3650;
+  battery.status.cell_max_voltage_mV = 3702;
+  battery.info.number_of_cells = 12;  // More than kept
+  for (int i = 0; i < 12; i++) {
+    battery.status.cell_voltages_mV[i] = 3650 + i;
+  }
+  history.record(battery, 5);
+
+  std::vector<History_Value> values(history.fields());
+  uint32_t time_s;
+  uint16_t samples;
+  ASSERT_TRUE(history.read(0, 0, time_s, samples, values.data(), 0, history.fields()));
+  EXPECT_EQ(values[HISTORY_VOLTAGE_DV].avg, 3712);
+  EXPECT_EQ(values[HISTORY_CURRENT_DA].avg, -153);
+  EXPECT_EQ(values[HISTORY_SOC_PPTT].avg, 8123);
+  EXPECT_EQ(values[HISTORY_TEMPERATURE_MIN_DC].avg, -45);
+  EXPECT_EQ(values[HISTORY_TEMPERATURE_MAX_DC].avg, 210);
+  EXPECT_EQ(values[HISTORY_CELL_MIN_MV].avg, 3650);
+  EXPECT_EQ(values[HISTORY_CELL_MAX_MV].avg, 3702);
+  EXPECT_EQ(values[HISTORY_PACK_FIELDS].avg, 3650);
+  EXPECT_EQ(values[HISTORY_PACK_FIELDS + 7].avg, 3657);
+
+  // Fewer cells than kept leaves the rest at 0
+  battery.info.number_of_cells = 2;
+  history.record(battery, 6);
+  ASSERT_TRUE(history.read(0, 1, time_s, samples, values.data(), 0, history.fields()));
+  EXPECT_EQ(values[HISTORY_PACK_FIELDS + 1].avg, 3651);
+  EXPECT_EQ(values[HISTORY_PACK_FIELDS + 2].avg, 0);
+}
+
+TEST(TelemetryHistory, ReaderNeverSeesTornEntries) {
+  TelemetryHistory history;
+  ASSERT_TRUE(history.begin(small_config(8, 4, 4, 64), false));
+  std::atomic<bool> started{false};
+  std::atomic<bool> done{false};
+  uint32_t torn = 0;
+  uint32_t read = 0;
+
+  std::thread reader([&]() {
+    std::vector<History_Value> values(history.fields());
+    started = true;
+    while (!done.load()) {
+      for (uint32_t sequence = history.oldest(0); sequence < history.end(0); sequence++) {
+        uint32_t time_s;
+        uint16_t samples;
+        if (!history.read(0, sequence, time_s, samples, values.data(), 0, history.fields())) {
+          continue;
+        }
+        read++;
+        for (const History_Value& v : values) {
+          torn += v.avg != (int16_t)time_s;
+        }
+      }
+    }
+  });
+  while (!started.load()) {
+  }
+  for (uint32_t t = 0; t < 200000; t++) {
+    record_constant(history, t, (int16_t)t);
+  }
+  done = true;
+  reader.join();
+  EXPECT_EQ(torn, 0u);
+  EXPECT_GT(read, 0u);
+}
+
+TEST(HistoryResponse, ParsesCellRanges) {
+  uint16_t first, cells;
+  EXPECT_TRUE(parse_history_cells("none", 96, first, cells));
+  EXPECT_EQ(cells, 0);
+  EXPECT_TRUE(parse_history_cells("all", 96, first, cells));
+  EXPECT_EQ(first, 0);
+  EXPECT_EQ(cells, 96);
+  EXPECT_TRUE(parse_history_cells("5-8", 96, first, cells));
+  EXPECT_EQ(first, 4);
+  EXPECT_EQ(cells, 4);
+  EXPECT_TRUE(parse_history_cells("12", 96, first, cells));
+  EXPECT_EQ(first, 11);
+  EXPECT_EQ(cells, 1);
+  EXPECT_TRUE(parse_history_cells("90-200", 96, first, cells));
+  EXPECT_EQ(first, 89);
+  EXPECT_EQ(cells, 7);
+  EXPECT_TRUE(parse_history_cells("1-16", 0, first, cells));  // No cells kept without PSRAM
+  EXPECT_EQ(cells, 0);
+
+  EXPECT_FALSE(parse_history_cells("0-4", 96, first, cells));
+  EXPECT_FALSE(parse_history_cells("8-4", 96, first, cells));
+  EXPECT_FALSE(parse_history_cells("4-", 96, first, cells));
+  EXPECT_FALSE(parse_history_cells("x", 96, first, cells));
+
+  uint8_t resolution;
+  EXPECT_TRUE(history_resolution_for_interval(900, resolution));
+  EXPECT_EQ(resolution, 2);
+  EXPECT_FALSE(history_resolution_for_interval(30, resolution));
+}
+
+TEST(HistoryResponse, StreamsJsonRange) {
+  TelemetryHistory history;
+  ASSERT_TRUE(history.begin(small_config(100, 4, 4, 4), false));
+  for (uint32_t t = 0; t < 100; t++) {
+    record_constant(history, t, (int16_t)(t * 10));
+  }
+
+  History_Query query = {};
+  query.resolution = 0;
+  query.from_s = 20;
+  query.to_s = 29;
+  query.first_cell = 2;
+  query.cells = 5;  // Clipped to the 4 kept cells
+  HistoryResponse response(history, query, 123);
+  std::string json = read_response(response);
+
+  JsonDocument doc;
+  ASSERT_EQ(deserializeJson(doc, json), DeserializationError::Ok) << json;
+  EXPECT_EQ(doc["interval_s"], 1);
+  EXPECT_EQ(doc["now_s"], 123);
+  JsonArray fields = doc["fields"];
+  ASSERT_EQ(fields.size(), HISTORY_PACK_FIELDS + 2u);
+  EXPECT_STREQ(fields[0], "voltage_dV");
+  EXPECT_STREQ(fields[(size_t)HISTORY_PACK_FIELDS], "cell_3_mV");
+  EXPECT_STREQ(fields[HISTORY_PACK_FIELDS + 1], "cell_4_mV");
+
+  JsonArray entries = doc["entries"];
+  ASSERT_EQ(entries.size(), 10u);
+  JsonArray first = entries[0];
+  EXPECT_EQ(first.size(), 2 + 3 * fields.size());
+  EXPECT_EQ(first[0], 20);
+  EXPECT_EQ(first[1], 1);
+  EXPECT_EQ(first[2], 200);
+  EXPECT_EQ(entries[9][0], 29);
+}
+
+TEST(HistoryResponse, StreamsBinaryRange) {
+  TelemetryHistory history;
+  ASSERT_TRUE(history.begin(small_config(4, 4, 4, 0), false));
+  for (uint32_t t = 0; t < 180; t++) {
+    record_constant(history, t, 7);
+  }
+
+  History_Query query = {};
+  query.resolution = 1;
+  query.to_s = UINT32_MAX;
+  query.binary = true;
+  HistoryResponse response(history, query, 180);
+  std::string data = read_response(response);
+
+  const size_t entry_bytes = sizeof(History_Binary_Entry) + HISTORY_PACK_FIELDS * sizeof(History_Value);
+  ASSERT_EQ(data.size(), sizeof(History_Binary_Header) + 2 * entry_bytes);
+  History_Binary_Header header;
+  memcpy(&header, data.data(), sizeof(header));
+  EXPECT_EQ(memcmp(header.magic, HISTORY_BINARY_MAGIC, 3), 0);
+  EXPECT_EQ(header.version, HISTORY_BINARY_VERSION);
+  EXPECT_EQ(header.interval_s, 60);
+  EXPECT_EQ(header.fields, HISTORY_PACK_FIELDS);
+
+  History_Binary_Entry entry;
+  memcpy(&entry, data.data() + sizeof(header) + entry_bytes, sizeof(entry));
+  EXPECT_EQ(entry.time_s, 60u);
+  EXPECT_EQ(entry.samples, 60);
+  History_Value value;
+  memcpy(&value, data.data() + sizeof(header) + entry_bytes + sizeof(entry), sizeof(value));
+  EXPECT_EQ(value.min, 7);
+  EXPECT_EQ(value.avg, 7);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../Software/src/battery/BATTERIES.h"
+#include "../Software/src/communication/Transmitter.h"
+#include "../Software/src/devboard/utils/latency_histogram.h"
+
+class TestTransmitter : public Transmitter {
+ public:
+  void transmit(unsigned long currentMillis) override { polled++; }
+  bool transmit_allowed() override { return allowed; }
+
+  void schedule(uint16_t period_ms, uint8_t frames, Tx_Callback callback) {
+    transmit_every(period_ms, frames, callback);
+  }
+
+  int polled = 0;
+  bool allowed = true;
+};
+
+class TxSchedulerTests : public testing::Test {
+ protected:
+  void SetUp() override { latency_histograms_reset(); }
+
+  // Run the scheduler once per ms and count the frames sent on every tick
+  std::vector<int> run_for(unsigned long from, unsigned long ms) {
+    std::vector<int> frames_per_tick;
+    for (unsigned long t = from; t < from + ms; t++) {
+      frames = 0;
+      scheduler.run(t);
+      frames_per_tick.push_back(frames);
+    }
+    return frames_per_tick;
+  }
+
+  Tx_Callback sends(int count, int* calls = nullptr) {
+    return [this, count, calls](unsigned long) {
+      frames += count;
+      if (calls) {
+        (*calls)++;
+      }
+    };
+  }
+
+  TxScheduler scheduler;
+  TestTransmitter owner;
+  int frames = 0;
+};
+
+TEST_F(TxSchedulerTests, JobsRunOncePerPeriod) {
+  int fast = 0, slow = 0;
+  ASSERT_TRUE(scheduler.add(&owner, 10, 1, sends(1, &fast)));
+  ASSERT_TRUE(scheduler.add(&owner, 1000, 1, sends(1, &slow)));
+
+  run_for(1, 2000);
+  EXPECT_EQ(fast, 200);
+  EXPECT_EQ(slow, 2);
+  EXPECT_EQ(latency_histogram_count(latency_histograms[LATENCY_TX_10MS]), 200u);
+  EXPECT_EQ(latency_histograms[LATENCY_TX_10MS].max_us.load(), 0u);  // Never late when run every ms
+}
+
+TEST_F(TxSchedulerTests, PhasesAreStaggered) {
+  // Every integration sends at 10 ms, 100 ms and 1 s. Without staggering all of it lands on one tick.
+  for (int i = 0; i < 4; i++) {
+    scheduler.add(&owner, 10, 2, sends(2));
+    scheduler.add(&owner, 100, 4, sends(4));
+    scheduler.add(&owner, 1000, 6, sends(6));
+  }
+  auto frames_per_tick = run_for(1, 1000);
+  int total = 0, peak = 0;
+  for (int f : frames_per_tick) {
+    total += f;
+    peak = std::max(peak, f);
+  }
+  EXPECT_EQ(total, 4 * (100 * 2 + 10 * 4 + 6));
+  EXPECT_EQ(peak, 6);  // One job per tick at most
+}
+
+TEST_F(TxSchedulerTests, StallSkipsMissedPeriodsAndRecordsLateness) {
+  int calls = 0;
+  scheduler.add(&owner, 100, 1, sends(1, &calls));
+  run_for(1, 100);
+  ASSERT_EQ(calls, 1);
+
+  // Nothing runs for 450 ms, the job runs once and then continues in its old phase
+  scheduler.run(550);
+  EXPECT_EQ(calls, 2);
+  EXPECT_GE(latency_histograms[LATENCY_TX_100MS].max_us.load(), 350000u);
+  run_for(551, 100);
+  EXPECT_EQ(calls, 3);
+}
+
+TEST_F(TxSchedulerTests, NotAllowedSkipsCallbacks) {
+  int calls = 0;
+  scheduler.add(&owner, 10, 1, sends(1, &calls));
+  owner.allowed = false;
+  run_for(1, 100);
+  EXPECT_EQ(calls, 0);
+  owner.allowed = true;
+  run_for(101, 100);
+  EXPECT_EQ(calls, 10);
+}
+
+TEST_F(TxSchedulerTests, RemovedJobsStop) {
+  int calls = 0;
+  TestTransmitter other;
+  scheduler.add(&owner, 10, 1, sends(1, &calls));
+  scheduler.add(&other, 10, 1, sends(1));
+  scheduler.remove(&owner);
+  EXPECT_EQ(scheduler.job_count(), 1);
+  run_for(1, 100);
+  EXPECT_EQ(calls, 0);
+}
+
+TEST_F(TxSchedulerTests, TableFull) {
+  for (int i = 0; i < TX_SCHEDULER_MAX_JOBS; i++) {
+    ASSERT_TRUE(scheduler.add(&owner, 1000, 1, sends(1)));
+  }
+  EXPECT_FALSE(scheduler.add(&owner, 1000, 1, sends(1)));
+  EXPECT_FALSE(scheduler.add(&owner, 0, 1, sends(1)));
+}
+
+TEST_F(TxSchedulerTests, ScheduledTransmittersLeaveWhenDestroyed) {
+  tx_scheduler.clear();
+  {
+    TestTransmitter scoped;
+    EXPECT_FALSE(scoped.scheduled());
+    scoped.schedule(100, 1, [](unsigned long) {});
+    EXPECT_TRUE(scoped.scheduled());
+    EXPECT_EQ(tx_scheduler.job_count(), 1);
+  }
+  EXPECT_EQ(tx_scheduler.job_count(), 0);
+}
+
+TEST_F(TxSchedulerTests, ConvertedBatteryRegistersJobs) {
+  tx_scheduler.clear();
+  datalayer = DataLayer();
+  user_selected_battery_type = BatteryType::JaguarIpace;
+  setup_battery();
+  EXPECT_EQ(tx_scheduler.job_count(), 1);
+  delete battery;
+  battery = nullptr;
+  EXPECT_EQ(tx_scheduler.job_count(), 0);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "emul/virtual_can_bus.h"
+
+#include "../Software/src/battery/BATTERIES.h"
+#include "../Software/src/devboard/safety/safety.h"
+
+class RecordingReceiver : public CanReceiver {
+ public:
+  void receive_can_frame(const CAN_frame& rx_frame) override { ids.push_back(rx_frame.ID); }
+  std::vector<uint32_t> ids;
+};
+
+static CAN_frame frame_with_id(uint32_t id, bool ext = false, uint8_t dlc = 8) {
+  CAN_frame frame = {.FD = false, .ext_ID = ext, .DLC = dlc, .ID = id, .data = {.u8 = {0}}};
+  return frame;
+}
+
+TEST(VirtualCanBusTests, FrameTime) {
+  VirtualCanBus bus;
+  // 8 data bytes: 98 bits before stuffing, 24 stuff bits worst case and 13 bits of trailer at 500 kbit/s
+  EXPECT_EQ(bus.frame_time_us(frame_with_id(0x100)), 270u);
+  EXPECT_EQ(bus.frame_time_us(frame_with_id(0x100, true)), 320u);
+  EXPECT_EQ(bus.frame_time_us(frame_with_id(0x100, false, 0)), 110u);
+}
+
+TEST(VirtualCanBusTests, LowestIdWinsArbitration) {
+  VirtualCanBus bus;
+  RecordingReceiver receiver;
+  bus.add_receiver(&receiver, CAN_NATIVE, {});
+
+  bus.inject(frame_with_id(0x500), CAN_NATIVE);
+  bus.inject(frame_with_id(0x0C000000, true), CAN_NATIVE);  // Base ID 0x300
+  bus.inject(frame_with_id(0x200), CAN_NATIVE);
+  bus.inject(frame_with_id(0x040), CAN_NATIVE);
+  // A standard frame beats an extended frame with the same base ID
+  bus.inject(frame_with_id(0x040 << 18, true), CAN_NATIVE);
+
+  bus.run_until(269);
+  EXPECT_TRUE(receiver.ids.empty());  // Still on the wire
+  bus.run_until(10000);
+  EXPECT_EQ(receiver.ids, (std::vector<uint32_t>{0x040, 0x040 << 18, 0x200, 0x0C000000, 0x500}));
+  EXPECT_GE(bus.statistics(CAN_NATIVE).max_wait_us, 4 * 270u);
+}
+
+TEST(VirtualCanBusTests, ConnectedInterfacesShareTheWire) {
+  VirtualCanBus bus;
+  RecordingReceiver native, addon, other;
+  bus.add_receiver(&native, CAN_NATIVE, {});
+  bus.add_receiver(&addon, CAN_ADDON_MCP2515, {});
+  bus.add_receiver(&other, CANFD_ADDON_MCP2518, {});
+  bus.connect(CAN_NATIVE, CAN_ADDON_MCP2515);
+
+  bus.transmit(frame_with_id(0x351), CAN_NATIVE);
+  bus.transmit(frame_with_id(0x4210), CAN_ADDON_MCP2515);
+  bus.run_until(1000);
+
+  // Nobody hears itself and unconnected interfaces hear nothing
+  EXPECT_EQ(native.ids, (std::vector<uint32_t>{0x4210}));
+  EXPECT_EQ(addon.ids, (std::vector<uint32_t>{0x351}));
+  EXPECT_TRUE(other.ids.empty());
+  EXPECT_EQ(bus.statistics(CAN_ADDON_MCP2515).frames_sent, 2u);
+  EXPECT_EQ(bus.statistics(CANFD_ADDON_MCP2518).frames_sent, 0u);
+}
+
+TEST(VirtualCanBusTests, ReceiverFilter) {
+  VirtualCanBus bus;
+  RecordingReceiver receiver;
+  bus.add_receiver(&receiver, CAN_NATIVE, {.code = 0x300, .mask = 0x700});
+  bus.inject(frame_with_id(0x351), CAN_NATIVE);
+  bus.inject(frame_with_id(0x451), CAN_NATIVE);
+  bus.run_until(1000);
+  EXPECT_EQ(receiver.ids, (std::vector<uint32_t>{0x351}));
+}
+
+TEST(VirtualCanBusTests, LossAndOverflow) {
+  VirtualCanBus bus({.bitrate = 500000, .loss = 0.25, .seed = 7, .tx_buffer = 1000});
+  RecordingReceiver receiver;
+  bus.add_receiver(&receiver, CAN_ADDON_MCP2515, {});
+  bus.connect(CAN_NATIVE, CAN_ADDON_MCP2515);
+  for (int i = 0; i < 1000; i++) {
+    bus.transmit(frame_with_id(0x100), CAN_NATIVE);
+  }
+  bus.run_until(1000000);
+  const auto& stats = bus.statistics(CAN_NATIVE);
+  EXPECT_EQ(stats.frames_sent, 1000u);
+  EXPECT_EQ(stats.frames_sent - stats.frames_lost, receiver.ids.size());
+  EXPECT_NEAR((double)stats.frames_lost, 250, 60);
+  EXPECT_EQ(stats.busy_us, 1000u * 270);
+
+  VirtualCanBus small({.tx_buffer = 4});
+  for (int i = 0; i < 6; i++) {
+    small.transmit(frame_with_id(0x100), CAN_NATIVE);
+  }
+  EXPECT_EQ(small.statistics(CAN_NATIVE).tx_overflows, 2u);
+}
+
+TEST(VirtualCanBusTests, AttachedBusCarriesIntegrationTraffic) {
+  datalayer = DataLayer();
+  allowed_to_send_CAN = true;
+  tx_scheduler.clear();
+  set_millis64(0);
+  {
+    VirtualCanBus bus;
+    RecordingReceiver inverter_side;
+    bus.add_receiver(&inverter_side, CAN_ADDON_MCP2515, {});
+    bus.connect(CAN_NATIVE, CAN_ADDON_MCP2515);
+    bus.attach();
+
+    can_config.battery = CAN_NATIVE;
+    user_selected_battery_type = BatteryType::JaguarIpace;
+    setup_battery();
+    for (unsigned long ms = 1; ms <= 1000; ms++) {
+      set_millis64(ms);
+      bus.run_until(ms * 1000);
+      bus.transmit_all(ms);
+    }
+    EXPECT_GT(inverter_side.ids.size(), 0u);
+    EXPECT_EQ(bus.statistics(CAN_NATIVE).frames_received, inverter_side.ids.size());
+
+    delete battery;
+    battery = nullptr;
+  }
+  EXPECT_EQ(VirtualCanBus::active(), nullptr);
+}
+
+TEST(VirtualCanBusTests, TeslaOnlyReceivesIdsItHandles) {
+  VirtualCanBus bus;
+  bus.attach();
+  TeslaBattery battery;
+
+  for (uint32_t id : battery.handled_can_ids()) {
+    bus.inject(frame_with_id(id), CAN_NATIVE);
+  }
+  bus.inject(frame_with_id(0x118), CAN_NATIVE);  // Drive system status of the vehicle
+  bus.inject(frame_with_id(0x7FF), CAN_NATIVE);
+  bus.inject(frame_with_id(0x18FF50E5, true), CAN_NATIVE);
+  bus.run_until(1000000);
+
+  EXPECT_EQ(bus.statistics(CAN_NATIVE).frames_received, battery.handled_can_ids().size());
+  bus.detach();
+}